@@ -127,11 +127,40 @@ typedef struct {
  */
 #define	PFC_HASH_PRIME		PFC_CONST_U(0x2)
 
+/*
+ * Grow the hash table automatically when the average length of bucket chains
+ * exceeds 1. Hash entries are moved to the new buckets incrementally by
+ * subsequent updates, so no single update pays the whole cost of rehashing.
+ */
+#define	PFC_HASH_AUTOGROW	PFC_CONST_U(0x4)
+
+/*
+ * Serialize updates by striped bucket locks instead of the table lock.
+ * Readers and writers that touch different lock stripes run concurrently.
+ * Number of hash buckets is rounded up to a multiple of the number of
+ * stripes. This flag is ignored if PFC_HASH_NOLOCK or PFC_HASH_PRIME is
+ * specified.
+ */
+#define	PFC_HASH_STRIPED	PFC_CONST_U(0x8)
+
 /*
  * Maximum number of hash buckets.
  */
 #define	PFC_HASH_MAX_NBUCKETS	PFC_CONST_U(0x1000000)
 
+/*
+ * Statistics of hash table.
+ */
+typedef struct {
+	size_t		phs_nelems;	/* number of entries */
+	double		phs_load;	/* load factor */
+	uint32_t	phs_nbuckets;	/* number of hash buckets */
+	uint32_t	phs_empty;	/* number of empty buckets */
+	uint32_t	phs_maxchain;	/* length of the longest chain */
+	uint32_t	phs_ngrows;	/* number of automatic growth */
+	uint32_t	phs_rehashing;	/* old buckets not yet rehashed */
+} pfc_hash_stats_t;
+
 /*
  * Prototypes.
  *
@@ -430,6 +459,8 @@ extern void	pfc_hash_report(pfc_hash_t PFC_RESTRICT hash,
 extern void	pfc_hash_report_summary(pfc_hash_t PFC_RESTRICT hash,
 					FILE *PFC_RESTRICT fp,
 					uint32_t nsummaries);
+extern int	pfc_hash_get_stats(pfc_hash_t PFC_RESTRICT hash,
+				   pfc_hash_stats_t *PFC_RESTRICT statsp);
 
 PFC_C_END_DECL
 
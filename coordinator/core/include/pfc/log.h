@@ -142,11 +142,23 @@ typedef struct {
 	pfc_log_facl_t	plc_facility;		/* config: facility */
 	uint32_t	plc_rcount;		/* config: rotation count */
 	size_t		plc_rsize;		/* config: rotation size */
+	pfc_bool_t	plc_async;		/* config: asynchronous logging */
+	pfc_bool_t	plc_async_block;	/* config: block on overflow */
+	uint32_t	plc_async_size;		/* config: async buffer size (KB) */
 	const char	*plc_logdir;		/* directory of log file */
 	const char	*plc_logpath;		/* path to log file */
 	const char	*plc_lvlpath;		/* path to log level file */
 } pfc_log_conf_t;
 
+/*
+ * Statistics of asynchronous logging.
+ */
+typedef struct {
+	uint64_t	plas_written;		/* number of logs written */
+	uint64_t	plas_dropped;		/* number of logs dropped */
+	uint64_t	plas_blocked;		/* number of waits for buffer */
+} pfc_log_async_stats_t;
+
 /*
  * Prototypes for PFC daemon.
  */
@@ -157,6 +169,7 @@ extern void	pfc_log_sysinit(pfc_log_conf_t *cfp);
 extern void	pfc_log_fini(void);
 
 extern pfc_bool_t	pfc_log_isfatal(void);
+extern void	pfc_log_async_getstats(pfc_log_async_stats_t *statsp);
 
 extern void	pfc_log_set_fatal_handler(pfc_log_fatal_t handler);
 extern int	pfc_log_set_level(pfc_log_level_t level);
@@ -191,6 +204,8 @@ extern void	pfc_logconf_setdeflevel(pfc_log_conf_t *cfp,
 					pfc_log_level_t lvl);
 extern void	pfc_logconf_setsyslog(pfc_log_conf_t *PFC_RESTRICT cfp,
 				      pfc_bool_t sysonly);
+extern void	pfc_logconf_setasync(pfc_log_conf_t *cfp, pfc_bool_t async,
+				     uint32_t size, pfc_bool_t block);
 extern void	pfc_logconf_setfacility(pfc_log_conf_t *cfp,
 					pfc_log_facl_t facility);
 
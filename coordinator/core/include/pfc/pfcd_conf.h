@@ -44,6 +44,11 @@
 #define	PFCD_CONF_LLDP_ETHTYPE_MIN		PFC_CONST_U(0x05dd)
 #define	PFCD_CONF_LLDP_ETHTYPE_MAX		PFC_CONST_U(0xffff)
 
+/*
+ * ipc_channel map.
+ */
+#define	PFCD_CONF_IPC_CHANNEL_WORKERS_MAX	PFC_CONST_U(1024)
+
 /*
  * ipc_event block.
  */
@@ -46,6 +46,16 @@ typedef void		(*pfc_taskdtor_t)(void *arg);
  */
 #define	PFC_TASKQ_JOINABLE	PFC_CONST_U(0x1)
 
+/*
+ * Flags for pfc_taskq_create_named_flags()
+ *
+ * PFC_TASKQ_CF_STEAL
+ *	Schedule tasks with per-worker queues and work stealing instead of
+ *	one shared task list. This flag is ignored if the concurrency of
+ *	the task queue is 1, so such a task queue always keeps FIFO order.
+ */
+#define	PFC_TASKQ_CF_STEAL	PFC_CONST_U(0x1)
+
 /*
  * Invalid ID number for taskq.
  */
@@ -58,6 +68,10 @@ typedef void		(*pfc_taskdtor_t)(void *arg);
 extern int	pfc_taskq_create_named(pfc_taskq_t *PFC_RESTRICT,
 				       const char *PFC_RESTRICT, uint32_t,
 				       const char *PFC_RESTRICT);
+extern int	pfc_taskq_create_named_flags(pfc_taskq_t *PFC_RESTRICT,
+					     const char *PFC_RESTRICT, uint32_t,
+					     uint32_t,
+					     const char *PFC_RESTRICT);
 extern int	pfc_taskq_destroy(pfc_taskq_t);
 extern int	pfc_taskq_dispatch(pfc_taskq_t, pfc_taskfunc_t,
 				   void *, uint32_t, pfc_task_t *PFC_RESTRICT);
@@ -76,6 +90,9 @@ extern int	pfc_taskq_clear(pfc_taskq_t,
 
 #define	pfc_taskq_create(tqidp, poolname, concurrency)	\
 	pfc_taskq_create_named(tqidp, poolname, concurrency, PFC_LOG_IDENT)
+#define	pfc_taskq_create_flags(tqidp, poolname, concurrency, flags)	\
+	pfc_taskq_create_named_flags(tqidp, poolname, concurrency, flags, \
+				     PFC_LOG_IDENT)
 
 PFC_C_END_DECL
 
@@ -42,6 +42,16 @@ typedef uint32_t	pfc_timeout_t;
  */
 #define	PFC_TIMER_MAXRES		PFC_CONST_U(0x1000000)
 
+/*
+ * Flags for pfc_timer_create_flags()
+ *
+ * PFC_TIMER_CF_WHEEL
+ *	Keep timeouts in a hierarchical timing wheel instead of red-black
+ *	trees. Posting and canceling a timeout take constant time, and
+ *	expired timeouts are dispatched to the task queue in a batch.
+ */
+#define	PFC_TIMER_CF_WHEEL		PFC_CONST_U(0x1)
+
 /*
  * Prototypes.
  */
@@ -49,6 +59,11 @@ extern int	pfc_timer_create(pfc_timer_t *PFC_RESTRICT tidp,
 				 const char *PFC_RESTRICT poolname,
 				 pfc_taskq_t tqid,
 				 const pfc_timespec_t *resolution);
+extern int	pfc_timer_create_flags(pfc_timer_t *PFC_RESTRICT tidp,
+				       const char *PFC_RESTRICT poolname,
+				       pfc_taskq_t tqid,
+				       const pfc_timespec_t *resolution,
+				       uint32_t flags);
 extern int	pfc_timer_destroy(pfc_timer_t tid);
 extern int	pfc_timer_post(pfc_timer_t tid, const pfc_timespec_t *timeout,
 			       pfc_taskfunc_t func, void *PFC_RESTRICT arg,
@@ -35,11 +35,28 @@ static const char	log_ident[] = "taskq";
 #include <pfc/refptr.h>
 #include "taskq_impl.h"
 
+/*
+ * Per-worker task queue used by the work-stealing scheduler.
+ * Each dispatcher thread owns one worker queue, and takes tasks from
+ * another worker queue when its own queue is empty.
+ */
+typedef struct taskq_wq {
+	pfc_mutex_t	wq_mutex;		/* mutex for this queue */
+	pfc_list_t	wq_tasks;		/* queued tasks */
+	uint32_t	wq_ntasks;		/* number of queued tasks */
+	pfc_bool_t	wq_owned;		/* owned by a dispatcher thread */
+} taskq_wq_t;
+
+#define	TASKQ_WQ_LOCK(wqp)	pfc_mutex_lock(&(wqp)->wq_mutex)
+#define	TASKQ_WQ_UNLOCK(wqp)	pfc_mutex_unlock(&(wqp)->wq_mutex)
+
 /*
  * Task on a task queue.
  */
 typedef struct task {
 	pfc_list_t	t_list;			/* link for queued task */
+	pfc_list_t	t_qlink;		/* link for worker queue */
+	taskq_wq_t	*t_wqueue;		/* worker queue */
 	pfc_task_t	t_id;			/* task ID */
 	uint16_t	t_state;		/* task state */
 	uint16_t	t_flags;		/* task flags */
@@ -51,6 +68,7 @@ typedef struct task {
 
 #define	TASK_LIST2PTR(list)	PFC_CAST_CONTAINER((list), task_t, t_list)
 #define	TASK_NODE2PTR(node)	PFC_CAST_CONTAINER((node), task_t, t_node)
+#define	TASK_QLINK2PTR(list)	PFC_CAST_CONTAINER((list), task_t, t_qlink)
 
 /*
  * Task flags.
@@ -90,6 +108,8 @@ typedef struct taskq {
 	size_t		tq_nnodes;		/* number of task nodes */
 	pfc_list_t	tq_running;		/* link for running task */
 	pfc_refptr_t	*tq_ownername;		/* name of owner (for debug) */
+	taskq_wq_t	*tq_wqueues;		/* per-worker queues */
+	uint32_t	tq_wqnext;		/* next worker queue to dispatch */
 } taskq_t;
 
 #define	TASKQ_NODE2PTR(node)	PFC_CAST_CONTAINER((node), taskq_t, tq_node)
@@ -98,6 +118,9 @@ typedef struct taskq {
  * Task queue flags.
  */
 #define	TASKQ_SHUTDOWN		0x0001
+#define	TASKQ_STEAL		0x0002		/* work-stealing scheduler */
+
+#define	TASKQ_IS_STEAL(tqp)	((tqp)->tq_flags & TASKQ_STEAL)
 
 /*
  * Lock/unlock for taskq instance.
@@ -105,6 +128,14 @@ typedef struct taskq {
 #define	TASKQ_LOCK(tqp)		pfc_mutex_lock(&(tqp)->tq_mutex)
 #define	TASKQ_UNLOCK(tqp)	pfc_mutex_unlock(&(tqp)->tq_mutex)
 
+/*
+ * Work-stealing taskq and worker queue index owned by the calling
+ * dispatcher thread. A task dispatched by a running task is queued on
+ * the worker queue of the calling thread.
+ */
+static __thread taskq_t		*taskq_worker_tqp;
+static __thread uint32_t	taskq_worker_index;
+
 /*
  * Taskq ID for the next allocation.
  */
@@ -170,13 +201,23 @@ static int	taskq_dispatch_sync(pfc_taskq_t tqid, pfc_task_t *tidp);
 static int	taskq_wait_sync(pfc_taskq_t tqid, pfc_task_t tid,
 				const pfc_timespec_t *PFC_RESTRICT timeout);
 static void	*taskq_main(void *);
+static void	*taskq_steal_main(void *);
 static void	*taskq_reserve_main(void *);
 static void	taskq_unexpected_exit(void *);
 static task_t	*taskq_prepare_calling(taskq_t *tqp);
 static void	taskq_call(task_t *tp);
 static void	taskq_dtor(pfc_taskdtor_t dtor, void *arg);
 static void	taskq_finish_calling(taskq_t *tqp, task_t *tp);
+static pfc_bool_t	taskq_sync_complete(taskq_t *tqp);
+static pfc_bool_t	taskq_steal_enqueue(taskq_t *PFC_RESTRICT tqp,
+					    task_t *PFC_RESTRICT tp);
+static task_t	*taskq_steal_pop(taskq_t *tqp, uint32_t index);
+static pfc_bool_t	taskq_unqueue(taskq_t *PFC_RESTRICT tqp,
+				      task_t *PFC_RESTRICT tp);
+static void	taskq_clear_queued(taskq_t *PFC_RESTRICT tqp, pfc_task_t tid,
+				   pfc_list_t *PFC_RESTRICT removed);
 static int	taskq_alloc(taskq_t **);
+static int	taskq_wq_alloc(taskq_t *tqp);
 static void	taskq_free(taskq_t *);
 static task_t	*taskq_task_alloc(pfc_taskfunc_t func, void *PFC_RESTRICT arg,
 				  pfc_taskdtor_t dtor, uint32_t flags);
@@ -415,13 +456,44 @@ int
 pfc_taskq_create_named(pfc_taskq_t *PFC_RESTRICT tqidp,
 		       const char *PFC_RESTRICT poolname, uint32_t concurrency,
 		       const char *PFC_RESTRICT owner)
+{
+	return pfc_taskq_create_named_flags(tqidp, poolname, concurrency, 0,
+					    owner);
+}
+
+/*
+ * int
+ * pfc_taskq_create_named_flags(pfc_taskq_t *PFC_RESTRICT tqidp,
+ *				const char *PFC_RESTRICT poolname,
+ *				uint32_t concurrency, uint32_t flags,
+ *				const char *PFC_RESTRICT owner)
+ *	Create a new task queue with specifying creation flags.
+ *
+ *	If PFC_TASKQ_CF_STEAL is set in `flags' and `concurrency' is greater
+ *	than 1, tasks are scheduled by the work-stealing scheduler.
+ *	Each dispatcher thread owns a worker queue, and takes tasks queued
+ *	on another worker queue when its own queue is empty. Tasks are
+ *	started in FIFO order within a worker queue, but not across worker
+ *	queues.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, task queue instance is set to *tqidp
+ *	and zero is returned.
+ *	Otherwise, error number which indicates the cause of error is returned.
+ */
+int
+pfc_taskq_create_named_flags(pfc_taskq_t *PFC_RESTRICT tqidp,
+			     const char *PFC_RESTRICT poolname,
+			     uint32_t concurrency, uint32_t flags,
+			     const char *PFC_RESTRICT owner)
 {
 	pfc_taskq_t	tqid;
 	taskq_t		*tqp = NULL;
 	int		err;
 	pfc_refptr_t	*rname, *oname;
 
-	if (concurrency < 1 || concurrency > taskq_max_concurrency) {
+	if (concurrency < 1 || concurrency > taskq_max_concurrency ||
+	    (flags & ~PFC_TASKQ_CF_STEAL) != 0) {
 		return EINVAL;
 	}
 	if (poolname != NULL) {
@@ -451,6 +523,14 @@ pfc_taskq_create_named(pfc_taskq_t *PFC_RESTRICT tqidp,
 	tqp->tq_poolname = rname;
 	tqp->tq_ownername = oname;
 
+	if ((flags & PFC_TASKQ_CF_STEAL) && concurrency > 1) {
+		err = taskq_wq_alloc(tqp);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			taskq_free(tqp);
+			return err;
+		}
+	}
+
 	while (1) {
 		/* Allocate a new taskq ID. */
 		tqid = pfc_taskq_new_id();
@@ -687,8 +767,15 @@ taskq_register(taskq_t *tqp, task_t *tp, pfc_task_t *tidp)
 	}
 
 	/* Enqueue task */
-	pfc_list_push_tail(&tqp->tq_tasklist, &tp->t_list);
-	tqp->tq_ntasks++;
+	*tidp = tp->t_id;
+	if (TASKQ_IS_STEAL(tqp)) {
+		if (!taskq_steal_enqueue(tqp, tp)) {
+			return 0;
+		}
+	} else {
+		pfc_list_push_tail(&tqp->tq_tasklist, &tp->t_list);
+		tqp->tq_ntasks++;
+	}
 
 	/* Notify to dispatcher thread */
 	if (tqp->tq_nfree != 0) {
@@ -698,10 +785,152 @@ taskq_register(taskq_t *tqp, task_t *tp, pfc_task_t *tidp)
 		taskq_create_dispatcher(tqp);
 	}
 
-	*tidp = tp->t_id;
 	return 0;
 }
 
+/*
+ * static pfc_bool_t
+ * taskq_steal_enqueue(taskq_t *PFC_RESTRICT tqp, task_t *PFC_RESTRICT tp)
+ *	Enqueue the task to a worker queue of the work-stealing taskq.
+ *
+ *	Every task is linked to tq_running in dispatching order until it
+ *	finishes. A sync task is linked only to tq_running, and it completes
+ *	when all tasks ahead of it have finished.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if the task has been queued on a worker queue.
+ *	PFC_FALSE is returned if the task is a sync task.
+ *	Note that a sync task may be completed and released by this call.
+ *
+ * Remarks:
+ *	This function must be called with holding taskq lock.
+ */
+static pfc_bool_t
+taskq_steal_enqueue(taskq_t *PFC_RESTRICT tqp, task_t *PFC_RESTRICT tp)
+{
+	taskq_wq_t	*wqp;
+	uint32_t	index;
+
+	pfc_list_push_tail(&tqp->tq_running, &tp->t_list);
+	if (tp->t_flags & TASK_FLAG_SYNC) {
+		if (taskq_sync_complete(tqp)) {
+			PFC_ASSERT_INT(pfc_cond_broadcast(&tqp->tq_joincond),0);
+		}
+
+		return PFC_FALSE;
+	}
+
+	if (taskq_worker_tqp == tqp) {
+		/* Keep the task on the worker queue of the calling thread. */
+		index = taskq_worker_index;
+	} else {
+		index = tqp->tq_wqnext;
+		if (++tqp->tq_wqnext >= tqp->tq_concurrency) {
+			tqp->tq_wqnext = 0;
+		}
+	}
+
+	wqp = &tqp->tq_wqueues[index];
+	tp->t_wqueue = wqp;
+	TASKQ_WQ_LOCK(wqp);
+	pfc_list_push_tail(&wqp->wq_tasks, &tp->t_qlink);
+	wqp->wq_ntasks++;
+	TASKQ_WQ_UNLOCK(wqp);
+	pfc_atomic_inc_uint32(&tqp->tq_ntasks);
+
+	return PFC_TRUE;
+}
+
+/*
+ * static task_t *
+ * taskq_steal_pop(taskq_t *tqp, uint32_t index)
+ *	Take a task from the worker queues of the work-stealing taskq.
+ *
+ *	The worker queue specified by `index' is scanned first. If it is
+ *	empty, a task is stolen from another worker queue.
+ *	NULL is returned if no task is queued.
+ *
+ * Remarks:
+ *	This function can be called with or without holding taskq lock.
+ */
+static task_t *
+taskq_steal_pop(taskq_t *tqp, uint32_t index)
+{
+	uint32_t	i;
+
+	for (i = 0; i < tqp->tq_concurrency; i++) {
+		taskq_wq_t	*wqp = &tqp->tq_wqueues[index];
+		pfc_list_t	*elem;
+
+		if (++index >= tqp->tq_concurrency) {
+			index = 0;
+		}
+		if (wqp->wq_ntasks == 0) {
+			continue;
+		}
+
+		TASKQ_WQ_LOCK(wqp);
+		elem = pfc_list_pop(&wqp->wq_tasks);
+		if (elem != NULL) {
+			task_t	*tp = TASK_QLINK2PTR(elem);
+
+			wqp->wq_ntasks--;
+			tp->t_state = TASK_STATE_INPROGRESS;
+			TASKQ_WQ_UNLOCK(wqp);
+			pfc_atomic_dec_uint32(&tqp->tq_ntasks);
+
+			return tp;
+		}
+		TASKQ_WQ_UNLOCK(wqp);
+	}
+
+	return NULL;
+}
+
+/*
+ * static pfc_bool_t
+ * taskq_unqueue(taskq_t *PFC_RESTRICT tqp, task_t *PFC_RESTRICT tp)
+ *	Remove the queued task specified by `tp' from the task queue.
+ *	The caller must check sync tasks by taskq_sync_complete() after
+ *	removing tasks from the work-stealing taskq.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if the task has been removed.
+ *	PFC_FALSE is returned if the task has already been taken by
+ *	a dispatcher thread.
+ *
+ * Remarks:
+ *	This function must be called with holding taskq lock.
+ */
+static pfc_bool_t
+taskq_unqueue(taskq_t *PFC_RESTRICT tqp, task_t *PFC_RESTRICT tp)
+{
+	taskq_wq_t	*wqp;
+
+	if (!TASKQ_IS_STEAL(tqp)) {
+		PFC_ASSERT(tp->t_state == TASK_STATE_QUEUED);
+		pfc_list_remove(&tp->t_list);
+		tqp->tq_ntasks--;
+
+		return PFC_TRUE;
+	}
+
+	wqp = tp->t_wqueue;
+	TASKQ_WQ_LOCK(wqp);
+	if (tp->t_state != TASK_STATE_QUEUED) {
+		TASKQ_WQ_UNLOCK(wqp);
+
+		return PFC_FALSE;
+	}
+	pfc_list_remove(&tp->t_qlink);
+	wqp->wq_ntasks--;
+	TASKQ_WQ_UNLOCK(wqp);
+	pfc_atomic_dec_uint32(&tqp->tq_ntasks);
+	pfc_list_remove(&tp->t_list);
+
+	return PFC_TRUE;
+}
+
 /*
  * static void
  * taskq_create_dispatcher(taskq_t *tqp)
@@ -724,7 +953,9 @@ taskq_create_dispatcher(taskq_t *tqp)
 	} else {
 		poolname = pfc_refptr_string_value(tqp->tq_poolname);
 	}
-	err = pfc_thread_createat(&thread, poolname, taskq_main,
+	err = pfc_thread_createat(&thread, poolname,
+				  (TASKQ_IS_STEAL(tqp))
+				  ? taskq_steal_main : taskq_main,
 				  (void *)tqp, PFC_THREAD_DETACHED);
 	if (PFC_EXPECT_TRUE(err == 0)) {
 		tqp->tq_nthreads++;
@@ -791,11 +1022,19 @@ pfc_taskq_cancel(pfc_taskq_t tqid, pfc_task_t tid)
 				err = ESRCH;
 				break;
 			case TASK_STATE_QUEUED:
+				if (!taskq_unqueue(tqp, tp)) {
+					/* Taken by a dispatcher thread. */
+					err = EBUSY;
+					break;
+				}
 				dtor = tp->t_dtor;
 				argp = tp->t_arg;
-				pfc_list_remove(&tp->t_list);
-				tqp->tq_ntasks--;
 				pfc_taskq_task_remove(tqp, tp);
+				if (TASKQ_IS_STEAL(tqp) &&
+				    taskq_sync_complete(tqp)) {
+					PFC_ASSERT_INT(pfc_cond_broadcast
+						       (&tqp->tq_joincond), 0);
+				}
 				break;
 			default:
 				PFC_ASSERT(0);
@@ -1031,31 +1270,8 @@ pfc_taskq_clear(pfc_taskq_t tqid,
 	pfc_rbtree_ex_rdlock(&taskq_tree);
 	err = pfc_taskq_lookup(tqid, &tqp);
 	if (PFC_EXPECT_FALSE(err == 0)) {
-		pfc_list_t	*elem, *next;
-
 		TASKQ_LOCK(tqp);
-
-		PFC_LIST_FOREACH_SAFE(&tqp->tq_tasklist, elem, next) {
-			task_t	*tmp = TASK_LIST2PTR(elem);
-
-			if (tmp->t_id == tid) {
-				/* Found the sync task. */
-				break;
-			}
-			if (tmp->t_flags &
-			    (TASK_FLAG_SYNC|TASK_FLAG_HASWAITER)) {
-				/* Skip the other sync task. */
-				/* Skip the task having joiner. */
-				continue;
-			}
-
-			PFC_ASSERT(tmp->t_state == TASK_STATE_QUEUED);
-			pfc_list_remove(&tmp->t_list);
-			tqp->tq_ntasks--;
-			pfc_taskq_task_unlink(tqp, tmp);
-			pfc_list_push_tail(&removed, &tmp->t_list);
-		}
-
+		taskq_clear_queued(tqp, tid, &removed);
 		TASKQ_UNLOCK(tqp);
 	}
 	pfc_rbtree_ex_unlock(&taskq_tree);
@@ -1069,6 +1285,63 @@ pfc_taskq_clear(pfc_taskq_t tqid,
 	return taskq_wait_sync(tqid, tid, timeout);
 }
 
+/*
+ * static void
+ * taskq_clear_queued(taskq_t *PFC_RESTRICT tqp, pfc_task_t tid,
+ *		      pfc_list_t *PFC_RESTRICT removed)
+ *	Unlink all queued tasks dispatched before the sync task specified by
+ *	`tid', and link them to `removed'. Running tasks, sync tasks, and
+ *	tasks having joiner are kept.
+ *
+ * Remarks:
+ *	This function must be called with holding taskq lock.
+ */
+static void
+taskq_clear_queued(taskq_t *PFC_RESTRICT tqp, pfc_task_t tid,
+		   pfc_list_t *PFC_RESTRICT removed)
+{
+	pfc_list_t	*elem, *next, *list;
+
+	if (pfc_rbtree_get(&tqp->tq_tasktree,
+			   (pfc_cptr_t)(uintptr_t)tid) == NULL) {
+		/*
+		 * The sync task has already been completed, so no task
+		 * dispatched before it remains.
+		 */
+		return;
+	}
+
+	/*
+	 * A work-stealing taskq keeps queued and running tasks on
+	 * tq_running in dispatching order.
+	 */
+	list = (TASKQ_IS_STEAL(tqp)) ? &tqp->tq_running : &tqp->tq_tasklist;
+	PFC_LIST_FOREACH_SAFE(list, elem, next) {
+		task_t	*tmp = TASK_LIST2PTR(elem);
+
+		if (tmp->t_id == tid) {
+			/* Found the sync task. */
+			break;
+		}
+		if (tmp->t_flags & (TASK_FLAG_SYNC|TASK_FLAG_HASWAITER)) {
+			/* Skip the other sync task. */
+			/* Skip the task having joiner. */
+			continue;
+		}
+		if (!taskq_unqueue(tqp, tmp)) {
+			/* Skip the running task. */
+			continue;
+		}
+
+		pfc_taskq_task_unlink(tqp, tmp);
+		pfc_list_push_tail(removed, &tmp->t_list);
+	}
+
+	if (TASKQ_IS_STEAL(tqp) && taskq_sync_complete(tqp)) {
+		PFC_ASSERT_INT(pfc_cond_broadcast(&tqp->tq_joincond), 0);
+	}
+}
+
 /*
  * static void *
  * taskq_main(void *arg)
@@ -1150,6 +1423,88 @@ taskq_main(void *arg)
 	return NULL;
 }
 
+/*
+ * static void *
+ * taskq_steal_main(void *arg)
+ *	Main routine for a dispatcher thread of the work-stealing taskq.
+ */
+static void *
+taskq_steal_main(void *arg)
+{
+	taskq_t		*tqp = (taskq_t *)arg;
+	task_t		*tp;
+	int		err;
+	uint32_t	index;
+
+	pthread_cleanup_push(taskq_unexpected_exit, arg);
+
+	TASKQ_LOCK(tqp);
+
+	/* Bind a worker queue which is not owned by any thread. */
+	for (index = 0; tqp->tq_wqueues[index].wq_owned; index++) {
+		PFC_ASSERT(index < tqp->tq_concurrency - 1);
+	}
+	tqp->tq_wqueues[index].wq_owned = PFC_TRUE;
+	taskq_worker_tqp = tqp;
+	taskq_worker_index = index;
+
+	while (1) {
+		if (tqp->tq_flags & TASKQ_SHUTDOWN) {
+			break;
+		}
+		if (tqp->tq_ntasks == 0) {
+			tqp->tq_nfree++;
+			if (tqp->tq_nfree <= tqp->tq_maxfree) {
+				err = pfc_cond_wait(&tqp->tq_dispcond,
+						    &tqp->tq_mutex);
+			} else {
+				err = pfc_cond_timedwait(&tqp->tq_dispcond,
+							 &tqp->tq_mutex,
+							 &taskq_stay_time);
+			}
+			tqp->tq_nfree--;
+			if (err == ETIMEDOUT && tqp->tq_ntasks == 0) {
+				break;
+			}
+			PFC_ASSERT(err == 0 || err == ETIMEDOUT);
+			continue;
+		}
+
+		TASKQ_UNLOCK(tqp);
+
+		/*
+		 * Worker queues are scanned without holding taskq lock.
+		 * NULL may be returned if another thread has taken the task.
+		 * Unlike taskq_main(), we never wake up another thread here
+		 * because taskq_register() does it for every task.
+		 */
+		tp = taskq_steal_pop(tqp, index);
+		if (tp != NULL) {
+			taskq_call(tp);
+		}
+
+		TASKQ_LOCK(tqp);
+		if (tp != NULL) {
+			taskq_finish_calling(tqp, tp);
+		}
+	}
+
+	tqp->tq_wqueues[index].wq_owned = PFC_FALSE;
+	taskq_worker_tqp = NULL;
+	tqp->tq_nthreads--;
+
+	if ((tqp->tq_flags & TASKQ_SHUTDOWN) && (tqp->tq_nthreads == 0)) {
+		/* Wakeup destroyer. */
+		PFC_ASSERT_INT(pfc_cond_broadcast(&tqp->tq_joincond), 0);
+	}
+
+	TASKQ_UNLOCK(tqp);
+
+	pthread_cleanup_pop(0);
+
+	return NULL;
+}
+
 /*
  * static void *
  * taskq_reserve_main(void *arg)
@@ -1251,6 +1606,11 @@ taskq_prepare_calling(taskq_t *tqp)
 {
 	task_t	*tp;
 
+	if (TASKQ_IS_STEAL(tqp)) {
+		/* Sync tasks are never queued on worker queues. */
+		return taskq_steal_pop(tqp, 0);
+	}
+
 	while (tqp->tq_ntasks != 0) {
 		tp = TASK_LIST2PTR(pfc_list_pop(&tqp->tq_tasklist));
 		tqp->tq_ntasks--;
@@ -1329,11 +1689,45 @@ taskq_dtor(pfc_taskdtor_t dtor, void *arg)
 static void
 taskq_finish_calling(taskq_t *tqp, task_t *tp)
 {
-	pfc_bool_t	syncdone = PFC_FALSE;
-	pfc_list_t	*elem, *next;
+	pfc_bool_t	syncdone;
 
 	tp->t_state = TASK_STATE_DONE;
 	pfc_list_remove(&tp->t_list);
+	syncdone = taskq_sync_complete(tqp);
+
+	/* Wakeup joiner if waiting. */
+	if (syncdone || (tp->t_flags & TASK_FLAG_HASWAITER)) {
+		PFC_ASSERT_INT(pfc_cond_broadcast(&tqp->tq_joincond), 0);
+	}
+	/* Remove the task instance if detached. */
+	if (tp->t_flags & TASK_FLAG_DETACHED) {
+		/*
+		 * Note that the t_dtor must be called without any locks.
+		 * So, t_dtor is called by taskq_call().
+		 */
+		pfc_taskq_task_remove(tqp, tp);
+	}
+}
+
+/*
+ * static pfc_bool_t
+ * taskq_sync_complete(taskq_t *tqp)
+ *	Complete sync tasks linked to the head of tq_running.
+ *	A sync task on the head of tq_running means that all tasks dispatched
+ *	before the sync task are finished.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if at least one sync task has been completed.
+ *	The caller must wake up joiner threads in that case.
+ *
+ * Remarks:
+ *	This function must be called with holding taskq lock.
+ */
+static pfc_bool_t
+taskq_sync_complete(taskq_t *tqp)
+{
+	pfc_bool_t	syncdone = PFC_FALSE;
+	pfc_list_t	*elem, *next;
 
 	/* Check whether a sync task is queued on the head of tq_running */
 	PFC_LIST_FOREACH_SAFE(&tqp->tq_running, elem, next) {
@@ -1356,18 +1750,7 @@ taskq_finish_calling(taskq_t *tqp, task_t *tp)
 		}
 	}
 
-	/* Wakeup joiner if waiting. */
-	if (syncdone || (tp->t_flags & TASK_FLAG_HASWAITER)) {
-		PFC_ASSERT_INT(pfc_cond_broadcast(&tqp->tq_joincond), 0);
-	}
-	/* Remove the task instance if detached. */
-	if (tp->t_flags & TASK_FLAG_DETACHED) {
-		/*
-		 * Note that the t_dtor must be called without any locks.
-		 * So, t_dtor is called by taskq_call().
-		 */
-		pfc_taskq_task_remove(tqp, tp);
-	}
+	return syncdone;
 }
 
 /*
@@ -1419,6 +1802,8 @@ taskq_alloc(taskq_t **tqpp)
 	tqp->tq_ntasks = 0;
 	tqp->tq_nnodes = 0;
 	tqp->tq_taskid_next = 1;
+	tqp->tq_wqueues = NULL;
+	tqp->tq_wqnext = 0;
 
 	*tqpp = tqp;
 	return 0;
@@ -1430,6 +1815,50 @@ error_alloc:
 	return err;
 }
 
+/*
+ * static int
+ * taskq_wq_alloc(taskq_t *tqp)
+ *	Allocate worker queues, and enable the work-stealing scheduler
+ *	on the specified task queue.
+ *	tq_concurrency must be initialized in advance.
+ */
+static int
+taskq_wq_alloc(taskq_t *tqp)
+{
+	taskq_wq_t	*wqueues;
+	uint32_t	i;
+	int		err;
+
+	wqueues = (taskq_wq_t *)malloc(sizeof(*wqueues) *
+				       tqp->tq_concurrency);
+	if (PFC_EXPECT_FALSE(wqueues == NULL)) {
+		return ENOMEM;
+	}
+
+	for (i = 0; i < tqp->tq_concurrency; i++) {
+		taskq_wq_t	*wqp = &wqueues[i];
+
+		err = PFC_MUTEX_INIT(&wqp->wq_mutex);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			while (i > 0) {
+				i--;
+				pfc_mutex_destroy(&wqueues[i].wq_mutex);
+			}
+			free(wqueues);
+
+			return err;
+		}
+		pfc_list_init(&wqp->wq_tasks);
+		wqp->wq_ntasks = 0;
+		wqp->wq_owned = PFC_FALSE;
+	}
+
+	tqp->tq_wqueues = wqueues;
+	tqp->tq_flags |= TASKQ_STEAL;
+
+	return 0;
+}
+
 /*
  * static void
  * taskq_free(taskq_t *tqp)
@@ -1444,6 +1873,14 @@ taskq_free(taskq_t *tqp)
 	pfc_mutex_destroy(&tqp->tq_mutex);
 	pfc_cond_destroy(&tqp->tq_dispcond);
 	pfc_cond_destroy(&tqp->tq_joincond);
+	if (tqp->tq_wqueues != NULL) {
+		uint32_t	i;
+
+		for (i = 0; i < tqp->tq_concurrency; i++) {
+			pfc_mutex_destroy(&tqp->tq_wqueues[i].wq_mutex);
+		}
+		free(tqp->tq_wqueues);
+	}
 	if (tqp->tq_poolname != NULL) {
 		pfc_refptr_put(tqp->tq_poolname);
 	}
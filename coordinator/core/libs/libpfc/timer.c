@@ -43,6 +43,62 @@ static const char	log_ident[] = "timer";
  */
 typedef	uint64_t	pfc_tick_t;
 
+/*
+ * Hierarchical timing wheel.
+ *
+ * Timeouts which expire within TIMER_WHEEL_ROOT_SIZE ticks are linked to
+ * the root wheel indexed by expiry tick. Others are linked to upper level
+ * wheels, and they are moved to lower level wheels when the lower bits of
+ * tw_base wrap around.
+ */
+#define	TIMER_WHEEL_ROOT_BITS	8U
+#define	TIMER_WHEEL_ROOT_SIZE	(1U << TIMER_WHEEL_ROOT_BITS)
+#define	TIMER_WHEEL_ROOT_MASK	(TIMER_WHEEL_ROOT_SIZE - 1)
+
+#define	TIMER_WHEEL_VEC_BITS	6U
+#define	TIMER_WHEEL_VEC_SIZE	(1U << TIMER_WHEEL_VEC_BITS)
+#define	TIMER_WHEEL_VEC_MASK	(TIMER_WHEEL_VEC_SIZE - 1)
+
+#define	TIMER_WHEEL_NVECS	4U
+
+/*
+ * Number of bits of tick covered by the wheel at the given level.
+ * Level 0 is the root wheel.
+ */
+#define	TIMER_WHEEL_SHIFT(level)					\
+	(TIMER_WHEEL_ROOT_BITS + (level) * TIMER_WHEEL_VEC_BITS)
+
+/*
+ * Upper level wheel index for the given tick.
+ */
+#define	TIMER_WHEEL_INDEX(tick, level)					\
+	((uint32_t)((tick) >> TIMER_WHEEL_SHIFT(level)) & TIMER_WHEEL_VEC_MASK)
+
+/*
+ * Maximum distance, in tick, between tw_base and expiry tick which can be
+ * represented by the wheel. Timeouts beyond it are linked to the last
+ * slot, and relinked when the slot is cascaded.
+ */
+#define	TIMER_WHEEL_MAXDELTA						\
+	(((pfc_tick_t)1 << TIMER_WHEEL_SHIFT(TIMER_WHEEL_NVECS)) - 1)
+
+/*
+ * Initial and maximum number of timeout ID hash buckets.
+ */
+#define	TIMER_WHEEL_HASH_MIN	64U
+#define	TIMER_WHEEL_HASH_MAX	0x100000U
+
+struct timeout;
+
+typedef struct {
+	pfc_tick_t	tw_base;		/* next tick to be processed */
+	struct timeout	**tw_idhash;		/* timeout ID hash */
+	uint32_t	tw_hashmask;		/* mask for ID hash index */
+	pfc_list_t	tw_root[TIMER_WHEEL_ROOT_SIZE];	/* root wheel */
+	pfc_list_t	tw_vec[TIMER_WHEEL_NVECS][TIMER_WHEEL_VEC_SIZE];
+						/* upper level wheels */
+} timer_wheel_t;
+
 /*
  * Timer instance.
  */
@@ -61,6 +117,7 @@ typedef struct timersys {
 	uint32_t	t_flags;		/* flags */
 	uint32_t	t_count;		/* number of timeout */
 	pfc_timeout_t	t_toid_next;		/* next timeout ID */
+	timer_wheel_t	*t_wheel;		/* timing wheel */
 } timersys_t;
 
 #define	TIMER_NODE2PTR(node)	PFC_CAST_CONTAINER((node), timersys_t, t_node)
@@ -70,6 +127,7 @@ typedef struct timersys {
  */
 typedef struct timeout {
 	pfc_list_t	to_list;		/* timeout list */
+	struct timeout	*to_hnext;		/* link for ID hash (wheel) */
 	pfc_timeout_t	to_id;			/* timeout ID */
 	pfc_timespec_t	to_time;		/* specified duration */
 	pfc_tick_t	to_tick;		/* run time */
@@ -170,6 +228,15 @@ static int	timer_register(timersys_t *tip, const pfc_timespec_t *timeout,
 			       void *PFC_RESTRICT arg, pfc_taskdtor_t dtor,
 			       pfc_timeout_t *toidp);
 static pfc_bool_t	timer_execute(timersys_t *tip, pfc_tick_t curtick);
+static int	timer_wheel_alloc(timersys_t *tip);
+static void	timer_wheel_free(timersys_t *tip);
+static void	timer_wheel_register(timersys_t *tip, timeout_t *top);
+static timeout_t	*timer_wheel_remove(timersys_t *tip, pfc_timeout_t toid);
+static void	timer_wheel_rehash(timer_wheel_t *twp);
+static void	timer_wheel_insert(timer_wheel_t *twp, timeout_t *top);
+static void	timer_wheel_cascade(timer_wheel_t *twp);
+static pfc_bool_t	timer_wheel_execute(timersys_t *tip,
+					    pfc_tick_t curtick);
 static void	timer_dtor(pfc_taskdtor_t dtor, pfc_ptr_t arg);
 static int	timer_alloc(timersys_t **);
 static void	timer_free(timersys_t *);
@@ -361,12 +428,39 @@ int
 pfc_timer_create(pfc_timer_t *PFC_RESTRICT tidp,
 		 const char *PFC_RESTRICT poolname, pfc_taskq_t tqid,
 		 const pfc_timespec_t *resolution)
+{
+	return pfc_timer_create_flags(tidp, poolname, tqid, resolution, 0);
+}
+
+/*
+ * int
+ * pfc_timer_create_flags(pfc_timer_t *PFC_RESTRICT tidp,
+ *			  const char *PFC_RESTRICT poolname, pfc_taskq_t tqid,
+ *			  const pfc_timespec_t *resolution, uint32_t flags)
+ *	Create a new timer with specifying timer flags.
+ *
+ *	If PFC_TIMER_CF_WHEEL is set in `flags', timeouts posted to the
+ *	timer are kept in a hierarchical timing wheel.
+ *
+ * Calling/Exit State:
+ *      Upon successful completion, timer instance is set to *tidp
+ *      and zero is returned.
+ *      Otherwise, error number which indicates the cause of error is returned.
+ */
+int
+pfc_timer_create_flags(pfc_timer_t *PFC_RESTRICT tidp,
+		       const char *PFC_RESTRICT poolname, pfc_taskq_t tqid,
+		       const pfc_timespec_t *resolution, uint32_t flags)
 {
 	timersys_t	*tip = NULL;
 	pfc_timer_t	tid;
 	int		err;
 	pfc_tick_t	restick;
 
+	if (PFC_EXPECT_FALSE(flags & ~PFC_TIMER_CF_WHEEL)) {
+		return EINVAL;
+	}
+
 	if (resolution == NULL) {
 		restick = TIMER_DEFAULT_RESOLUTION;
 	} else {
@@ -384,6 +478,14 @@ pfc_timer_create(pfc_timer_t *PFC_RESTRICT tidp,
 	if (PFC_EXPECT_FALSE(err != 0)) {
 		return err;
 	}
+	if (flags & PFC_TIMER_CF_WHEEL) {
+		err = timer_wheel_alloc(tip);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			tip->t_poolname = NULL;
+			timer_free(tip);
+			return err;
+		}
+	}
 	if (poolname == NULL) {
 		tip->t_poolname = NULL;
 	} else {
@@ -561,7 +663,7 @@ pfc_timer_post_dtor(pfc_timer_t tid, const pfc_timespec_t *timeout,
  *		  pfc_tick_t tick, pfc_taskfunc_t func, void *PFC_RESTRICT arg,
  *		  pfc_taskdtor_t dtor, pfc_timeout_t *toidp)
  *	Allocate timeout instance and register the instance to
- *	ID tree and tick tree.
+ *	ID tree and tick tree, or to the timing wheel.
  *	If the executor thread is in long term sleep, wake up thread.
  *
  * Calling/Exit State:
@@ -582,10 +684,18 @@ timer_register(timersys_t *tip, const pfc_timespec_t *timeout, pfc_tick_t tick,
 	pfc_rbnode_t	*node;
 	tick_list_t	*tlp;
 
-	/* Allocate timeout instance and register to ID tree. */
-	err = timer_timeout_alloc(tip, &top);
-	if (PFC_EXPECT_FALSE(err != 0)) {
-		return err;
+	if (tip->t_wheel != NULL) {
+		/* Timeout ID is assigned by timer_wheel_register(). */
+		top = (timeout_t *)malloc(sizeof(*top));
+		if (PFC_EXPECT_FALSE(top == NULL)) {
+			return ENOMEM;
+		}
+	} else {
+		/* Allocate timeout instance and register to ID tree. */
+		err = timer_timeout_alloc(tip, &top);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			return err;
+		}
 	}
 	top->to_time = *timeout;
 	top->to_tick = tick;
@@ -593,26 +703,35 @@ timer_register(timersys_t *tip, const pfc_timespec_t *timeout, pfc_tick_t tick,
 	top->to_arg = arg;
 	top->to_dtor = dtor;
 
-	/* Link timeout instance to the list associated with expiry tick. */
-	node = pfc_rbtree_get(&tip->t_ticktree, TICK_KEY(top->to_tick));
-	if (node == NULL) {
-		/* Allocate a new list head. */
-		tlp = (tick_list_t *)malloc(sizeof(*tlp));
-		if (PFC_EXPECT_FALSE(tlp == NULL)) {
-			err = ENOMEM;
-			goto error;
-		}
-		tlp->tl_tick = top->to_tick;
-		pfc_list_init(&tlp->tl_list);
-		err = pfc_rbtree_put(&tip->t_ticktree, &tlp->tl_node);
-		if (PFC_EXPECT_FALSE(err != 0)) {
-			free(tlp);
-			goto error;
-		}
+	if (tip->t_wheel != NULL) {
+		/* Link timeout instance to the timing wheel. */
+		timer_wheel_register(tip, top);
 	} else {
-		tlp = TICK_NODE2PTR(node);
+		/*
+		 * Link timeout instance to the list associated with expiry
+		 * tick.
+		 */
+		node = pfc_rbtree_get(&tip->t_ticktree,
+				      TICK_KEY(top->to_tick));
+		if (node == NULL) {
+			/* Allocate a new list head. */
+			tlp = (tick_list_t *)malloc(sizeof(*tlp));
+			if (PFC_EXPECT_FALSE(tlp == NULL)) {
+				err = ENOMEM;
+				goto error;
+			}
+			tlp->tl_tick = top->to_tick;
+			pfc_list_init(&tlp->tl_list);
+			err = pfc_rbtree_put(&tip->t_ticktree, &tlp->tl_node);
+			if (PFC_EXPECT_FALSE(err != 0)) {
+				free(tlp);
+				goto error;
+			}
+		} else {
+			tlp = TICK_NODE2PTR(node);
+		}
+		pfc_list_push_tail(&tlp->tl_list, &top->to_list);
 	}
-	pfc_list_push_tail(&tlp->tl_list, &top->to_list);
 
 	if (tip->t_count == 0 ||
 	    top->to_tick < (tip->t_nextrun - tip->t_resolution)) {
@@ -662,9 +781,29 @@ pfc_timer_cancel(pfc_timer_t tid, pfc_timeout_t toid)
 
 		TIMER_LOCK(tip);
 
-		/* Try to make specified timeout instance invisible. */
-		node = pfc_rbtree_remove(&tip->t_idtree, TIMER_IDKEY(toid));
-		if (PFC_EXPECT_TRUE(node != NULL)) {
+		if (tip->t_wheel != NULL) {
+			timeout_t	*top = timer_wheel_remove(tip, toid);
+
+			if (PFC_EXPECT_TRUE(top != NULL)) {
+				/* Unlink from the timing wheel. */
+				pfc_list_remove(&top->to_list);
+				dtor = top->to_dtor;
+				argp = top->to_arg;
+				tip->t_count--;
+				timer_timeout_free(top);
+			} else {
+				err = ESRCH;
+			}
+			node = NULL;
+		} else {
+			/* Try to make specified timeout instance invisible. */
+			node = pfc_rbtree_remove(&tip->t_idtree,
+						 TIMER_IDKEY(toid));
+			if (PFC_EXPECT_FALSE(node == NULL)) {
+				err = ESRCH;
+			}
+		}
+		if (node != NULL) {
 			timeout_t	*top = TIMEOUT_NODE2PTR(node);
 			pfc_rbnode_t	*tnode;
 			tick_list_t	*tlp;
@@ -687,8 +826,6 @@ pfc_timer_cancel(pfc_timer_t tid, pfc_timeout_t toid)
 
 			/* Destroy timeout instance. */
 			timer_timeout_free(top);
-		} else {
-			err = ESRCH;
 		}
 
 		TIMER_UNLOCK(tip);
@@ -777,6 +914,10 @@ timer_execute(timersys_t *tip, pfc_tick_t curtick)
 {
 	pfc_rbnode_t	*node;
 
+	if (tip->t_wheel != NULL) {
+		return timer_wheel_execute(tip, curtick);
+	}
+
 	/* Retrieve the least expiry tick. */
 	while ((node = pfc_rbtree_next(&tip->t_ticktree, NULL)) != NULL) {
 		tick_list_t	*tlp = TICK_NODE2PTR(node);
@@ -853,6 +994,364 @@ timer_execute(timersys_t *tip, pfc_tick_t curtick)
 	return PFC_TRUE;
 }
 
+/*
+ * static int
+ * timer_wheel_alloc(timersys_t *tip)
+ *	Allocate timing wheel for the specified timer instance.
+ */
+static int
+timer_wheel_alloc(timersys_t *tip)
+{
+	timer_wheel_t	*twp;
+	uint32_t	i, level;
+
+	twp = (timer_wheel_t *)malloc(sizeof(*twp));
+	if (PFC_EXPECT_FALSE(twp == NULL)) {
+		return ENOMEM;
+	}
+
+	twp->tw_idhash = (timeout_t **)calloc(TIMER_WHEEL_HASH_MIN,
+					      sizeof(timeout_t *));
+	if (PFC_EXPECT_FALSE(twp->tw_idhash == NULL)) {
+		free(twp);
+		return ENOMEM;
+	}
+	twp->tw_hashmask = TIMER_WHEEL_HASH_MIN - 1;
+	twp->tw_base = 0;
+
+	for (i = 0; i < TIMER_WHEEL_ROOT_SIZE; i++) {
+		pfc_list_init(&twp->tw_root[i]);
+	}
+	for (level = 0; level < TIMER_WHEEL_NVECS; level++) {
+		for (i = 0; i < TIMER_WHEEL_VEC_SIZE; i++) {
+			pfc_list_init(&twp->tw_vec[level][i]);
+		}
+	}
+
+	tip->t_wheel = twp;
+
+	return 0;
+}
+
+/*
+ * static void
+ * timer_wheel_free(timersys_t *tip)
+ *	Call destructor for all timeouts in the timing wheel, and free
+ *	the timing wheel.
+ */
+static void
+timer_wheel_free(timersys_t *tip)
+{
+	timer_wheel_t	*twp = tip->t_wheel;
+	uint32_t	i;
+
+	for (i = 0; i <= twp->tw_hashmask; i++) {
+		timeout_t	*top, *next;
+
+		for (top = twp->tw_idhash[i]; top != NULL; top = next) {
+			next = top->to_hnext;
+			timer_dtor(top->to_dtor, top->to_arg);
+			timer_timeout_free(top);
+		}
+	}
+
+	free(twp->tw_idhash);
+	free(twp);
+	tip->t_wheel = NULL;
+}
+
+/*
+ * static void
+ * timer_wheel_rehash(timer_wheel_t *twp)
+ *	Double the number of timeout ID hash buckets.
+ *	The hash table is left unchanged if memory allocation fails.
+ */
+static void
+timer_wheel_rehash(timer_wheel_t *twp)
+{
+	timeout_t	**hash;
+	uint32_t	i, nbuckets = (twp->tw_hashmask + 1) << 1;
+
+	hash = (timeout_t **)calloc(nbuckets, sizeof(timeout_t *));
+	if (PFC_EXPECT_FALSE(hash == NULL)) {
+		return;
+	}
+
+	for (i = 0; i <= twp->tw_hashmask; i++) {
+		timeout_t	*top, *next;
+
+		for (top = twp->tw_idhash[i]; top != NULL; top = next) {
+			timeout_t	**bucket = &hash[top->to_id &
+							 (nbuckets - 1)];
+
+			next = top->to_hnext;
+			top->to_hnext = *bucket;
+			*bucket = top;
+		}
+	}
+
+	free(twp->tw_idhash);
+	twp->tw_idhash = hash;
+	twp->tw_hashmask = nbuckets - 1;
+}
+
+/*
+ * static void
+ * timer_wheel_register(timersys_t *tip, timeout_t *top)
+ *	Assign a new timeout ID to the specified timeout instance, and
+ *	link it to the timing wheel.
+ *
+ * Remarks:
+ *	This function must be called with holding the timer lock.
+ */
+static void
+timer_wheel_register(timersys_t *tip, timeout_t *top)
+{
+	timer_wheel_t	*twp = tip->t_wheel;
+	timeout_t	**bucket;
+
+	if (tip->t_count == 0) {
+		/* No need to walk through ticks elapsed while idle. */
+		twp->tw_base = pfc_timer_curtick();
+	}
+
+	if (tip->t_count >= twp->tw_hashmask &&
+	    twp->tw_hashmask < TIMER_WHEEL_HASH_MAX - 1) {
+		timer_wheel_rehash(twp);
+	}
+
+	while (1) {
+		timeout_t	*tp;
+
+		/* Assign new timeout ID */
+		top->to_id = tip->t_toid_next++;
+		if (tip->t_toid_next == PFC_TIMER_INVALID_TIMEOUTID) {
+			tip->t_toid_next++;
+		}
+
+		bucket = &twp->tw_idhash[top->to_id & twp->tw_hashmask];
+		for (tp = *bucket; tp != NULL; tp = tp->to_hnext) {
+			if (tp->to_id == top->to_id) {
+				break;
+			}
+		}
+		if (PFC_EXPECT_TRUE(tp == NULL)) {
+			break;
+		}
+
+		/*
+		 * Assigned ID is not available.
+		 * We must assign another ID.
+		 */
+	}
+
+	top->to_hnext = *bucket;
+	*bucket = top;
+
+	timer_wheel_insert(twp, top);
+}
+
+/*
+ * static timeout_t *
+ * timer_wheel_remove(timersys_t *tip, pfc_timeout_t toid)
+ *	Remove the timeout instance associated with the given ID from the
+ *	timeout ID hash.
+ *
+ * Calling/Exit State:
+ *	A pointer to timeout instance is returned if found.
+ *	NULL is returned if not found.
+ *	The caller must unlink the returned instance from the timing wheel.
+ *
+ * Remarks:
+ *	This function must be called with holding the timer lock.
+ */
+static timeout_t *
+timer_wheel_remove(timersys_t *tip, pfc_timeout_t toid)
+{
+	timer_wheel_t	*twp = tip->t_wheel;
+	timeout_t	**prevp, *top;
+
+	prevp = &twp->tw_idhash[toid & twp->tw_hashmask];
+	for (top = *prevp; top != NULL; top = top->to_hnext) {
+		if (top->to_id == toid) {
+			*prevp = top->to_hnext;
+			break;
+		}
+		prevp = &top->to_hnext;
+	}
+
+	return top;
+}
+
+/*
+ * static void
+ * timer_wheel_insert(timer_wheel_t *twp, timeout_t *top)
+ *	Link the specified timeout instance to the wheel slot associated
+ *	with its expiry tick.
+ */
+static void
+timer_wheel_insert(timer_wheel_t *twp, timeout_t *top)
+{
+	pfc_tick_t	tick = top->to_tick, base = twp->tw_base, delta;
+	pfc_list_t	*head;
+	uint32_t	level;
+
+	if (tick < base) {
+		/* Already expired. This will be processed by the next run. */
+		head = &twp->tw_root[base & TIMER_WHEEL_ROOT_MASK];
+		goto out;
+	}
+
+	delta = tick - base;
+	if (delta < TIMER_WHEEL_ROOT_SIZE) {
+		head = &twp->tw_root[tick & TIMER_WHEEL_ROOT_MASK];
+		goto out;
+	}
+
+	if (PFC_EXPECT_FALSE(delta > TIMER_WHEEL_MAXDELTA)) {
+		/* Link to the farthest slot. */
+		tick = base + TIMER_WHEEL_MAXDELTA;
+		delta = TIMER_WHEEL_MAXDELTA;
+	}
+
+	for (level = 0; level < TIMER_WHEEL_NVECS - 1; level++) {
+		if (delta < ((pfc_tick_t)1 << TIMER_WHEEL_SHIFT(level + 1))) {
+			break;
+		}
+	}
+	head = &twp->tw_vec[level][TIMER_WHEEL_INDEX(tick, level)];
+
+out:
+	pfc_list_push_tail(head, &top->to_list);
+}
+
+/*
+ * static void
+ * timer_wheel_cascade(timer_wheel_t *twp)
+ *	Move timeouts in upper level wheels to lower level wheels.
+ *	This function must be called when the lower bits of tw_base for the
+ *	root wheel wrap around.
+ */
+static void
+timer_wheel_cascade(timer_wheel_t *twp)
+{
+	uint32_t	level;
+
+	for (level = 0; level < TIMER_WHEEL_NVECS; level++) {
+		uint32_t	index = TIMER_WHEEL_INDEX(twp->tw_base, level);
+		pfc_list_t	*head = &twp->tw_vec[level][index];
+		pfc_list_t	list, *elem;
+
+		pfc_list_move_all(head, &list);
+		pfc_list_init(head);
+		while ((elem = pfc_list_pop(&list)) != NULL) {
+			timer_wheel_insert(twp, TIMEOUT_LIST2PTR(elem));
+		}
+
+		if (index != 0) {
+			break;
+		}
+	}
+}
+
+/*
+ * static pfc_bool_t
+ * timer_wheel_execute(timersys_t *tip, pfc_tick_t curtick)
+ *	Execute expired timeout entries in the timing wheel.
+ *
+ *	All timeouts which expire at or before `curtick' are unlinked from
+ *	the timing wheel under the timer lock, and then they are dispatched
+ *	to the task queue in a batch without holding the timer lock.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if no timeout was dispatched.
+ *	PFC_FALSE is returned if the timer lock was released.
+ *	The caller must retry execution immediately.
+ *
+ * Remarks:
+ *	This function must be called with holding the timer lock.
+ */
+static pfc_bool_t
+timer_wheel_execute(timersys_t *tip, pfc_tick_t curtick)
+{
+	timer_wheel_t	*twp = tip->t_wheel;
+	pfc_list_t	expired, *elem;
+	pfc_tick_t	tick, limit, nextrun;
+
+	if (tip->t_count == 0) {
+		twp->tw_base = curtick + 1;
+
+		return PFC_TRUE;
+	}
+
+	pfc_list_init(&expired);
+	for (; twp->tw_base <= curtick; twp->tw_base++) {
+		uint32_t	index = twp->tw_base & TIMER_WHEEL_ROOT_MASK;
+		pfc_list_t	*head = &twp->tw_root[index];
+
+		if (index == 0) {
+			timer_wheel_cascade(twp);
+		}
+
+		while ((elem = pfc_list_pop(head)) != NULL) {
+			timeout_t	*top = TIMEOUT_LIST2PTR(elem);
+
+			/* Remove from ID hash. */
+			top = timer_wheel_remove(tip, top->to_id);
+			PFC_ASSERT(top == TIMEOUT_LIST2PTR(elem));
+			pfc_list_push_tail(&expired, elem);
+			tip->t_count--;
+		}
+	}
+
+	/* Update next time to run. */
+	if (tip->t_count != 0) {
+		tick = twp->tw_base;
+		limit = (tick | TIMER_WHEEL_ROOT_MASK) + 1;
+		for (; tick < limit; tick++) {
+			if (!pfc_list_is_empty(&twp->tw_root[tick &
+							     TIMER_WHEEL_ROOT_MASK])) {
+				break;
+			}
+		}
+		nextrun = curtick + tip->t_resolution;
+		tip->t_nextrun = (nextrun < tick) ? tick : nextrun;
+	}
+
+	if (pfc_list_is_empty(&expired)) {
+		return PFC_TRUE;
+	}
+
+	/* Dispatch expired timeouts without holding the timer lock. */
+	TIMER_UNLOCK(tip);
+
+	while ((elem = pfc_list_pop(&expired)) != NULL) {
+		timeout_t	*top = TIMEOUT_LIST2PTR(elem);
+		pfc_task_t	tid;
+		int		err;
+
+		err = pfc_taskq_dispatch_dtor(tip->t_taskq, top->to_func,
+					      top->to_arg, top->to_dtor, 0,
+					      &tid);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			/*
+			 * Failed to dispatch to the taskq
+			 * and lost this timeout entry.
+			 * dtor must be invoked here.
+			 */
+			pfc_log_error("dispatch failed: err=%d, "
+				      "tqid=%d, toid=%d",
+				      err, tip->t_taskq, top->to_id);
+			timer_dtor(top->to_dtor, top->to_arg);
+		}
+		timer_timeout_free(top);
+	}
+
+	TIMER_LOCK(tip);
+
+	return PFC_FALSE;
+}
+
 /*
  * static void
  * timer_dtor(pfc_taskdtor_t dtor, pfc_ptr_t arg)
@@ -901,6 +1400,7 @@ timer_alloc(timersys_t **tipp)
 	tip->t_flags = 0;
 	tip->t_count = 0;
 	tip->t_toid_next = 1;
+	tip->t_wheel = NULL;
 
 	*tipp = tip;
 	return 0;
@@ -926,6 +1426,9 @@ timer_free(timersys_t *tip)
 
 	/* Call destructor for all timeouts, and dispose timeouts. */
 	pfc_rbtree_clear(&tip->t_idtree, timer_timeout_dtor, NULL);
+	if (tip->t_wheel != NULL) {
+		timer_wheel_free(tip);
+	}
 
 	PFC_ASSERT_INT(pfc_cond_destroy(&tip->t_cond), 0);
 	PFC_ASSERT_INT(pfc_mutex_destroy(&tip->t_mutex), 0);
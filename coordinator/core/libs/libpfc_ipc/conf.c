@@ -14,6 +14,7 @@
 #include <pfc/util.h>
 #include <pfc/path.h>
 #include <pfc/synch.h>
+#include <pfc/conf.h>
 #include "ipc_impl.h"
 
 /*
@@ -40,6 +41,12 @@ static const char	ipc_channeldir[] =
 #define	IPC_CONF_CHECKDIR(name)					\
 	(ipc_conf_checkdir(ipc_##name, IPC_DIRPERM_##name))
 
+/*
+ * Name of the parameter map in PFC system configuration file, which keeps
+ * attributes for IPC channels. The name of IPC channel is used as map key.
+ */
+static const char	ipc_conf_chmap[] = "ipc_channel";
+
 /*
  * static inline int PFC_FATTR_ALWAYS_INLINE
  * ipc_conf_checkname(const char *channel)
@@ -161,6 +168,10 @@ pfc_ipc_conf_getpath(const char *PFC_RESTRICT channel,
  *	  - Value of "max_monitors" is set to icc_max_monitors.
  *	  - Value of "timeout" is set to icc_timeout
  *	  - Value of "permission" is set to icc_permission.
+ *	  - Value of "workers" is set to icc_workers.
+ *
+ *	"workers" is defined by "ipc_channel" map in PFC system configuration
+ *	file. Other parameters are fixed to default values.
  *
  * Calling/Exit State:
  *	Upon successful completion, zero is returned.
@@ -173,6 +184,8 @@ int
 pfc_ipc_conf_getsrvconf(const char *PFC_RESTRICT channel,
 			ipc_chconf_t *PFC_RESTRICT chcp)
 {
+	pfc_cfblk_t	cfblk;
+
 	PFC_ASSERT(channel != NULL);
 
 	chcp->icc_max_clients = IPC_CHANNEL_MAX_CLIENTS;
@@ -180,6 +193,10 @@ pfc_ipc_conf_getsrvconf(const char *PFC_RESTRICT channel,
 	chcp->icc_timeout = IPC_CHANNEL_TIMEOUT;
 	chcp->icc_permission = IPC_CHANNEL_PERMISSION;
 
+	cfblk = pfc_sysconf_get_map(ipc_conf_chmap, channel);
+	chcp->icc_workers = pfc_conf_get_uint32(cfblk, "workers",
+						IPC_CHANNEL_WORKERS);
+
 	return 0;
 }
 
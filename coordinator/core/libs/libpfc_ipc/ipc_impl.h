@@ -107,6 +107,7 @@ typedef const ipc_strinfo_t	ipc_cstrinfo_t;
 #define	IPC_CHANNEL_MAX_CLIENTS		PFC_CONST_U(64)
 #define	IPC_CHANNEL_MAX_SESSIONS	PFC_CONST_U(128)
 #define	IPC_CHANNEL_TIMEOUT		PFC_CONST_U(30)
+#define	IPC_CHANNEL_WORKERS		PFC_CONST_U(0)
 #define	IPC_CHANNEL_PERMISSION		(S_IRWXU | S_IRWXG | S_IRWXO)
 
 /*
@@ -169,6 +170,20 @@ typedef const ipc_strinfo_t	ipc_cstrinfo_t;
 #define	IPC_EPOLLEV_ONESHOT		(0)
 #endif	/* PFC_HAVE_EPOLLONESHOT */
 
+/*
+ * PDU data smaller than this size is always sent in STREAM mode, because
+ * setting up a shared memory file costs more than copying it.
+ */
+#define	IPC_SHM_THRESHOLD		PFC_CONST_U(0x10000)	/* 64K */
+
+/*
+ * Determine whether PDU data of the given size should be sent to the
+ * session in SHM mode.
+ */
+#define	IPC_SESS_USE_SHM(sess, size)				\
+	(((sess)->iss_xflags & IPC_SSXF_SHM) &&			\
+	 (size) >= IPC_SHM_THRESHOLD)
+
 /*
  * I/O buffer size for session stream.
  */
@@ -411,6 +426,7 @@ struct ipc_msg {
 	uint8_t		im_bflags;	/* bswap flags (IPC_SSF_) */
 	ipc_pduidx_t	*im_pdus;	/* PDU index */
 	const uint8_t	*im_data;	/* received data */
+	size_t		im_mapsize;	/* size of mapped data (SHM mode) */
 };
 
 /*
@@ -426,6 +442,7 @@ typedef struct {
 	uint32_t	icc_max_sessions;	/* max number of sessions */
 	uint32_t	icc_timeout;		/* session timeout (sec) */
 	uint32_t	icc_permission;		/* permission for socket */
+	uint32_t	icc_workers;		/* max number of pooled workers */
 } ipc_chconf_t;
 
 /*
@@ -790,6 +807,8 @@ extern int	pfc_ipc_sess_init(ipc_sess_t *PFC_RESTRICT sess,
 extern int	pfc_ipc_iostream_create(ipc_sess_t *PFC_RESTRICT sess,
 					int sock, int canceller,
 					ipc_coption_t *PFC_RESTRICT opts);
+extern int	pfc_ipc_sess_setxfer(ipc_sess_t *PFC_RESTRICT sess,
+				     const ipc_hshake_t *PFC_RESTRICT hshake);
 extern int	pfc_ipc_read(pfc_iostream_t PFC_RESTRICT stream,
 			     pfc_ptr_t PFC_RESTRICT buf, uint32_t size,
 			     ctimespec_t *PFC_RESTRICT abstime);
@@ -981,6 +1000,7 @@ pfc_ipcmsg_init(ipc_msg_t *msg, uint8_t bflags)
 	msg->im_count = 0;
 	msg->im_pdus = NULL;
 	msg->im_data = NULL;
+	msg->im_mapsize = 0;
 	pfc_ipcmsg_setbflags(msg, bflags);
 }
 
@@ -998,6 +1018,7 @@ pfc_ipcmsg_assert(ipc_msg_t *msg, uint8_t bflags)
 	PFC_ASSERT(msg->im_bflags == bflags);
 	PFC_ASSERT(msg->im_pdus == NULL);
 	PFC_ASSERT(msg->im_data == NULL);
+	PFC_ASSERT(msg->im_mapsize == 0);
 }
 
 /*
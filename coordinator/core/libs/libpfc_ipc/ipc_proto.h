@@ -14,6 +14,8 @@
  * Common definitions for PFC IPC protocol.
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <pfc/iostream.h>
 #include <pfc/hostaddr.h>
 #include <pfc/debug.h>
@@ -31,10 +33,34 @@ PFC_C_BEGIN_DECL
  */
 #define	IPC_PROTO_MAGIC_TOOMANY		PFC_CONST_U(0xea)
 
+/*
+ * SHM transfer mode requires memfd_create(2) and file sealing, because the
+ * receiver maps the file passed by the peer.
+ */
+#if	defined(MFD_CLOEXEC) && defined(F_ADD_SEALS)
+#define	IPC_HAVE_SHM			1
+#endif	/* defined(MFD_CLOEXEC) && defined(F_ADD_SEALS) */
+
+/*
+ * Seals which must be applied to the SHM file before the receiver maps it.
+ */
+#define	IPC_SHM_SEALS_REQUIRED		(F_SEAL_SHRINK | F_SEAL_WRITE)
+
 /*
  * Protocol version.
+ * Version 1 introduces SHM transfer mode, so it is advertised only if
+ * SHM transfer mode is supported.
  */
+#ifdef	IPC_HAVE_SHM
+#define	IPC_PROTO_VERSION		PFC_CONST_U(1)
+#else	/* !IPC_HAVE_SHM */
 #define	IPC_PROTO_VERSION		PFC_CONST_U(0)
+#endif	/* IPC_HAVE_SHM */
+
+/*
+ * The first protocol version which supports SHM transfer mode.
+ */
+#define	IPC_PROTO_VERSION_SHM		PFC_CONST_U(1)
 
 /*
  * Byte order.
@@ -88,6 +114,7 @@ typedef struct {
 	uint8_t		iss_flags;		/* flags */
 	uint16_t	iss_resv1;		/* used by upper layer */
 	uint8_t		iss_resv2[4];		/* used by upper layer */
+	uint32_t	iss_xflags;		/* transfer mode flags */
 } ipc_sess_t;
 
 /*
@@ -96,6 +123,11 @@ typedef struct {
 #define	IPC_SSF_BSWAP		PFC_CONST_U(0x01)	/* swap bytes */
 #define	IPC_SSF_BSWAP_FLOAT	PFC_CONST_U(0x02)	/* swap float bytes */
 
+/*
+ * Flags for iss_xflags.
+ */
+#define	IPC_SSXF_SHM		PFC_CONST_U(0x01)	/* SHM mode is usable */
+
 #define	IPC_NEED_BSWAP(flags)				\
 	(PFC_EXPECT_FALSE(flags & IPC_SSF_BSWAP))
 #define	IPC_NEED_BSWAP_FLOAT(flags)			\
@@ -109,6 +141,7 @@ typedef struct {
 #define	IPC_SESS_RESET_FLAGS(sess)				\
 	do {							\
 		(sess)->iss_flags = 0;				\
+		(sess)->iss_xflags = 0;				\
 	} while (0)
 
 /*
@@ -223,6 +256,15 @@ typedef struct {
  * This value is sent as uint8_t.
  */
 #define	IPC_XFERMODE_STREAM	PFC_CONST_U(0x00)	/* stream */
+#define	IPC_XFERMODE_SHM	PFC_CONST_U(0x01)	/* shared memory */
+
+/*
+ * In SHM mode, PDU tags are sent via the session stream, but PDU data is
+ * stored in a shared memory file. Its file descriptor is passed with the
+ * meta data of the IPC message, and the receiver maps it.
+ * SHM mode is used only if both peers support IPC_PROTO_VERSION_SHM
+ * and use the same byte order.
+ */
 
 /*
  * Response in IPC session protocol.
@@ -11,6 +11,7 @@
  * message.c - IPC message instance and accessor.
  */
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/mman.h>
@@ -36,6 +37,9 @@ static int	ipc_msg_getpdu(ipc_msg_t *PFC_RESTRICT msg, uint32_t index,
 static int	ipc_msg_recv_stream(pfc_iostream_t PFC_RESTRICT stream,
 				    ipc_msg_t *PFC_RESTRICT msg,
 				    ctimespec_t *PFC_RESTRICT abstime);
+#ifdef	IPC_HAVE_SHM
+static int	ipc_msg_recv_shm(int fd, ipc_msg_t *msg);
+#endif	/* IPC_HAVE_SHM */
 static int	ipc_msg_pdutype_check(uint8_t type);
 static int	ipc_msg_fetch_struct(ipc_msg_t *PFC_RESTRICT msg,
 				     ipc_pduidx_t *PFC_RESTRICT pdu,
@@ -616,7 +620,7 @@ pfc_ipcmsg_recv(ipc_sess_t *PFC_RESTRICT sess, ipc_msg_t *PFC_RESTRICT msg,
 	uint8_t		bflags = sess->iss_flags, mode;
 	uint32_t	off;
 	size_t		pdsz;
-	int		err;
+	int		err, shmfd = -1;
 
 	/* Receive PDU meta data. */
 	err = pfc_ipc_read(stream, &meta, sizeof(meta), abstime);
@@ -626,11 +630,33 @@ pfc_ipcmsg_recv(ipc_sess_t *PFC_RESTRICT sess, ipc_msg_t *PFC_RESTRICT msg,
 		return err;
 	}
 
+	mode = meta.imm_xfermode;
+	if (mode == IPC_XFERMODE_SHM) {
+		/*
+		 * The shared memory file has been passed with meta data.
+		 * It must be dequeued here so that the file descriptor queue
+		 * never gets out of sync with IPC messages.
+		 */
+		if (PFC_EXPECT_FALSE(!(sess->iss_xflags & IPC_SSXF_SHM))) {
+			IPC_LOG_ERROR("SHM mode is not negotiated.");
+
+			return EPROTO;
+		}
+
+		err = __pfc_iostream_recvfd(stream, &shmfd);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			IPC_LOG_ERROR("SHM file was not received: %s",
+				      strerror(err));
+
+			return EPROTO;
+		}
+	}
+
 	msg->im_count = meta.imm_count;
 	if (msg->im_count == 0) {
 		IPC_LOG_VERBOSE("Received empty IPC message.");
-
-		return 0;
+		err = 0;
+		goto out_shm;
 	}
 
 	msg->im_size = meta.imm_size;
@@ -651,8 +677,8 @@ pfc_ipcmsg_recv(ipc_sess_t *PFC_RESTRICT sess, ipc_msg_t *PFC_RESTRICT msg,
 	if (PFC_EXPECT_FALSE(pdarray == NULL)) {
 		IPC_LOG_ERROR("Failed to allocate PDU index: %u",
 			      msg->im_count);
-
-		return ENOMEM;
+		err = ENOMEM;
+		goto out_shm;
 	}
 
 	/*
@@ -703,7 +729,6 @@ pfc_ipcmsg_recv(ipc_sess_t *PFC_RESTRICT sess, ipc_msg_t *PFC_RESTRICT msg,
 		}
 	}
 
-	mode = meta.imm_xfermode;
 	if (PFC_EXPECT_TRUE(mode == IPC_XFERMODE_STREAM)) {
 		/* STREAM mode. */
 		if (msg->im_size == 0) {
@@ -714,6 +739,12 @@ pfc_ipcmsg_recv(ipc_sess_t *PFC_RESTRICT sess, ipc_msg_t *PFC_RESTRICT msg,
 			err = ipc_msg_recv_stream(stream, msg, abstime);
 		}
 	}
+#ifdef	IPC_HAVE_SHM
+	else if (mode == IPC_XFERMODE_SHM) {
+		/* SHM mode. */
+		err = ipc_msg_recv_shm(shmfd, msg);
+	}
+#endif	/* IPC_HAVE_SHM */
 	else {
 		IPC_LOG_ERROR("Unknown XFER mode: %u", mode);
 		err = EPROTO;
@@ -725,12 +756,17 @@ pfc_ipcmsg_recv(ipc_sess_t *PFC_RESTRICT sess, ipc_msg_t *PFC_RESTRICT msg,
 	}
 
 	msg->im_pdus = pdarray;
-
-	return 0;
+	err = 0;
+	goto out_shm;
 
 error:
 	free(pdarray);
 
+out_shm:
+	if (shmfd != -1) {
+		PFC_IPC_CLOSE(shmfd);
+	}
+
 	return err;
 }
 
@@ -783,6 +819,7 @@ pfc_ipcmsg_init_uint32(ipc_msg_t *PFC_RESTRICT msg, uint32_t data)
 	msg->im_bflags = 0;
 	msg->im_pdus = pdu;
 	msg->im_data = (const uint8_t *)datap;
+	msg->im_mapsize = 0;
 
 	return 0;
 }
@@ -881,7 +918,14 @@ static void
 ipc_msg_free(ipc_msg_t *msg)
 {
 	if (msg->im_data != NULL) {
-		free((void *)msg->im_data);
+		if (msg->im_mapsize != 0) {
+			/* PDU data was received in SHM mode. */
+			(void)munmap((void *)msg->im_data, msg->im_mapsize);
+			msg->im_mapsize = 0;
+		}
+		else {
+			free((void *)msg->im_data);
+		}
 		msg->im_data = NULL;
 	}
 
@@ -970,6 +1014,87 @@ ipc_msg_recv_stream(pfc_iostream_t PFC_RESTRICT stream,
 	return err;
 }
 
+#ifdef	IPC_HAVE_SHM
+
+/*
+ * static int
+ * ipc_msg_recv_shm(int fd, ipc_msg_t *msg)
+ *	Receive PDU data using SHM mode.
+ *
+ *	`fd' must be a file descriptor associated with the shared memory file
+ *	passed by the peer. PDU data in the file is mapped to the IPC message,
+ *	so it is read in place.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	Otherwise error number which indicates the cause of error is returned.
+ *
+ * Remarks:
+ *	`fd' is never closed by this function.
+ *
+ *	The file is rejected unless the peer has sealed it against shrink
+ *	and write. Otherwise the peer could truncate the file under the
+ *	mapping, or change PDU data after it has been verified.
+ */
+static int
+ipc_msg_recv_shm(int fd, ipc_msg_t *msg)
+{
+	struct stat	sbuf;
+	void		*addr;
+	size_t		size = msg->im_size;
+	int		seals;
+
+	seals = fcntl(fd, F_GET_SEALS);
+	if (PFC_EXPECT_FALSE(seals == -1)) {
+		int	err = errno;
+
+		IPC_LOG_ERROR("Failed to get seals of SHM file: %s",
+			      strerror(err));
+
+		return (err == EINVAL) ? EPROTO : err;
+	}
+
+	if (PFC_EXPECT_FALSE((seals & IPC_SHM_SEALS_REQUIRED) !=
+			     IPC_SHM_SEALS_REQUIRED)) {
+		IPC_LOG_ERROR("SHM file is not sealed: seals=0x%x", seals);
+
+		return EPROTO;
+	}
+
+	if (PFC_EXPECT_FALSE(fstat(fd, &sbuf) != 0)) {
+		int	err = errno;
+
+		IPC_LOG_ERROR("Failed to stat SHM file: %s", strerror(err));
+
+		return err;
+	}
+
+	if (PFC_EXPECT_FALSE(size == 0 || (uint64_t)sbuf.st_size < size)) {
+		IPC_LOG_ERROR("Invalid SHM file size: %" PFC_PFMT_u64
+			      ", expected=%u", (uint64_t)sbuf.st_size,
+			      msg->im_size);
+
+		return EPROTO;
+	}
+
+	addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	if (PFC_EXPECT_FALSE(addr == MAP_FAILED)) {
+		int	err = errno;
+
+		IPC_LOG_ERROR("Failed to map SHM file: size=%u: %s",
+			      msg->im_size, strerror(err));
+
+		return err;
+	}
+
+	msg->im_data = (const uint8_t *)addr;
+	msg->im_mapsize = size;
+
+	return 0;
+}
+
+#endif	/* IPC_HAVE_SHM */
+
 /*
  * static int
  * ipc_msg_pdutype_check(uint8_t type)
@@ -203,6 +203,7 @@ pfc_ipc_sess_init(ipc_sess_t *PFC_RESTRICT sess,
 	/* Initialize session flags. */
 	sess->iss_flags = 0;
 	sess->iss_version = 0;
+	sess->iss_xflags = 0;
 
 	return 0;
 }
@@ -283,6 +284,59 @@ pfc_ipc_iostream_create(ipc_sess_t *PFC_RESTRICT sess, int sock, int canceller,
 	return 0;
 }
 
+/*
+ * int
+ * pfc_ipc_sess_setxfer(ipc_sess_t *PFC_RESTRICT sess,
+ *			const ipc_hshake_t *PFC_RESTRICT hshake)
+ *	Determine PDU data transfer modes available on the IPC session
+ *	by the handshake message sent from the peer.
+ *
+ *	SHM mode is enabled if the peer supports it and no byte swapping is
+ *	required. In that case the session stream is set up to receive
+ *	file descriptors.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	Otherwise error number which indicates the cause of error is returned.
+ *
+ * Remarks:
+ *	- This function must be called after IPC_SESS_PROTO_INIT(), and
+ *	  before the first IPC message is received from the peer.
+ *
+ *	- Both peers must make the same decision, so only the handshake
+ *	  messages can be used to determine transfer modes.
+ */
+int
+pfc_ipc_sess_setxfer(ipc_sess_t *PFC_RESTRICT sess,
+		     const ipc_hshake_t *PFC_RESTRICT hshake)
+{
+#ifdef	IPC_HAVE_SHM
+	int	err;
+#endif	/* IPC_HAVE_SHM */
+
+	/* The session may be connected to another peer again. */
+	sess->iss_xflags = 0;
+
+#ifdef	IPC_HAVE_SHM
+	if (hshake->ih_version < IPC_PROTO_VERSION_SHM ||
+	    IPC_NEED_BSWAP_ANY(sess->iss_flags)) {
+		return 0;
+	}
+
+	err = __pfc_iostream_passfd(sess->iss_stream);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		IPC_LOG_ERROR("Unable to receive FDs via session stream: %s",
+			      strerror(err));
+
+		return err;
+	}
+
+	sess->iss_xflags |= IPC_SSXF_SHM;
+#endif	/* IPC_HAVE_SHM */
+
+	return 0;
+}
+
 /*
  * int
  * pfc_ipc_read(pfc_iostream_t PFC_RESTRICT stream, pfc_ptr_t PFC_RESTRICT buf,
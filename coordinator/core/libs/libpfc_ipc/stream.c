@@ -16,11 +16,13 @@
  */
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <pfc/util.h>
 #include <pfc/iostream.h>
+#include <iostream_impl.h>
 #include "ipc_impl.h"
 #include "ipc_struct_impl.h"
 
@@ -51,6 +53,10 @@ static int	ipc_stream_send_data(pfc_iostream_t PFC_RESTRICT stream,
 				     ipc_stream_t *PFC_RESTRICT stp,
 				     ctimespec_t *PFC_RESTRICT abstime);
 
+#ifdef	IPC_HAVE_SHM
+static int	ipc_stream_shm_create(ipc_stream_t *stp);
+#endif	/* IPC_HAVE_SHM */
+
 /*
  * void
  * pfc_ipcstream_destroy(ipc_stream_t *stp)
@@ -589,7 +595,7 @@ pfc_ipcstream_send(ipc_sess_t *PFC_RESTRICT sess,
 	pfc_bool_t	do_flush;
 	ipc_pdu_t	*pdu;
 	ipc_msgmeta_t	meta;
-	int		err;
+	int		err, shmfd = -1;
 
 	if (PFC_EXPECT_FALSE((stp->is_flags & (IPC_STRF_FIN | IPC_STRF_EVENT))
 			     == IPC_STRF_FIN)) {
@@ -603,17 +609,42 @@ pfc_ipcstream_send(ipc_sess_t *PFC_RESTRICT sess,
 	IPC_LOG_VERBOSE("Sending IPC message: count=%u, size=%u",
 			stp->is_count, stp->is_size);
 
+#ifdef	IPC_HAVE_SHM
+	if (IPC_SESS_USE_SHM(sess, stp->is_size)) {
+		/*
+		 * Copy PDU data to a shared memory file.
+		 * STREAM mode is used if it can not be created.
+		 */
+		shmfd = ipc_stream_shm_create(stp);
+	}
+#endif	/* IPC_HAVE_SHM */
+
 	/* Construct meta data. */
 	meta.imm_count = stp->is_count;
 	meta.imm_size = stp->is_size;
-	meta.imm_xfermode = IPC_XFERMODE_STREAM;
+	meta.imm_xfermode = (shmfd != -1)
+		? IPC_XFERMODE_SHM : IPC_XFERMODE_STREAM;
 	meta.imm_resv1 = 0;
 	meta.imm_resv2 = 0;
 
 	do_flush = (stp->is_count == 0) ? PFC_TRUE : PFC_FALSE;
 
 	/* Send meta data. */
-	err = pfc_ipc_write(stream, &meta, sizeof(meta), do_flush, abstime);
+	if (shmfd != -1) {
+		size_t	sz = sizeof(meta);
+
+		/* Pass the shared memory file with meta data. */
+		err = __pfc_iostream_sendfd_abs(stream, &meta, &sz, shmfd,
+						abstime);
+		PFC_IPC_CLOSE(shmfd);
+		if (PFC_EXPECT_TRUE(err == 0) && sz != sizeof(meta)) {
+			err = EPIPE;
+		}
+	}
+	else {
+		err = pfc_ipc_write(stream, &meta, sizeof(meta), do_flush,
+				    abstime);
+	}
 	if (PFC_EXPECT_FALSE(err != 0)) {
 		IPC_LOG_ERROR("Failed to send PDU meta data.");
 
@@ -638,6 +669,17 @@ pfc_ipcstream_send(ipc_sess_t *PFC_RESTRICT sess,
 		}
 	}
 
+	if (meta.imm_xfermode == IPC_XFERMODE_SHM) {
+		/* PDU data has already been passed to the peer. */
+		err = pfc_iostream_flush_abs(stream, abstime);
+		if (PFC_EXPECT_FALSE(err != 0 && err != ECANCELED)) {
+			IPC_LOG_ERROR("Failed to flush IPC session: %s",
+				      strerror(err));
+		}
+
+		return err;
+	}
+
 	/* Send PDU data via IPC session stream. */
 	return ipc_stream_send_data(stream, stp, abstime);
 }
@@ -800,3 +842,92 @@ ipc_stream_send_data(pfc_iostream_t PFC_RESTRICT stream,
 
 	return err;
 }
+
+#ifdef	IPC_HAVE_SHM
+
+/*
+ * static int
+ * ipc_stream_shm_create(ipc_stream_t *stp)
+ *	Create a shared memory file which contains all PDU data in the given
+ *	IPC stream.
+ *
+ *	PDU data is stored at the same offset as STREAM mode, so the receiver
+ *	can use the mapped file as PDU data buffer.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, a file descriptor associated with the
+ *	shared memory file is returned. The caller must close it.
+ *	-1 is returned on failure.
+ */
+static int
+ipc_stream_shm_create(ipc_stream_t *stp)
+{
+	ipc_pdu_t	*pdu;
+	uint8_t		*addr;
+	size_t		size = stp->is_size;
+	int		fd, flags = MFD_CLOEXEC;
+
+#ifdef	MFD_ALLOW_SEALING
+	flags |= MFD_ALLOW_SEALING;
+#endif	/* MFD_ALLOW_SEALING */
+
+	fd = memfd_create("pfc_ipc", flags);
+	if (PFC_EXPECT_FALSE(fd == -1)) {
+		IPC_LOG_VERBOSE("Unable to create SHM file: %s",
+				strerror(errno));
+
+		return -1;
+	}
+
+	if (PFC_EXPECT_FALSE(ftruncate(fd, size) != 0)) {
+		IPC_LOG_VERBOSE("Unable to resize SHM file: size=%u: %s",
+				stp->is_size, strerror(errno));
+		goto error;
+	}
+
+	addr = (uint8_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+			       fd, 0);
+	if (PFC_EXPECT_FALSE(addr == (uint8_t *)MAP_FAILED)) {
+		IPC_LOG_VERBOSE("Unable to map SHM file: size=%u: %s",
+				stp->is_size, strerror(errno));
+		goto error;
+	}
+
+	/* Copy PDU data. */
+	for (pdu = stp->is_pdus; pdu != NULL; pdu = pdu->ip_next) {
+		ipc_pdutag_t	*tag = &pdu->ip_tag;
+		pfc_cptr_t	src;
+
+		if (tag->ipt_size == 0) {
+			continue;
+		}
+
+		/* STRING, BINARY and STRUCT keep data in ip_data_POINTER. */
+		src = (tag->ipt_type >= PFC_IPCTYPE_STRING)
+			? pdu->ip_data_POINTER
+			: (pfc_cptr_t)&pdu->ip_data_UINT8;
+		PFC_ASSERT(tag->ipt_off + tag->ipt_size <= size);
+		memcpy(addr + tag->ipt_off, src, tag->ipt_size);
+	}
+
+	(void)munmap(addr, size);
+
+	/* The receiver may map the file, so it must never be changed. */
+	if (PFC_EXPECT_FALSE(fcntl(fd, F_ADD_SEALS, IPC_SHM_SEALS_REQUIRED |
+				   F_SEAL_GROW | F_SEAL_SEAL) != 0)) {
+		IPC_LOG_VERBOSE("Unable to seal SHM file: %s",
+				strerror(errno));
+		goto error;
+	}
+
+	IPC_LOG_VERBOSE("Use SHM mode: size=%u", stp->is_size);
+
+	return fd;
+
+error:
+	PFC_IPC_CLOSE(fd);
+
+	return -1;
+}
+
+#endif	/* IPC_HAVE_SHM */
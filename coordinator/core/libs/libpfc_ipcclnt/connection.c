@@ -2344,7 +2344,7 @@ ipcconn_handshake(ipc_sess_t *PFC_RESTRICT isp,
 
 	IPC_SESS_PROTO_INIT(isp, &hshake);
 
-	return 0;
+	return pfc_ipc_sess_setxfer(isp, &hshake);
 }
 
 /*
@@ -90,6 +90,8 @@ ipc_channel_t	ipc_channel PFC_ATTR_HIDDEN = {
 						       ich_sessions),
 	.ich_evqueues		= PFC_LIST_INITIALIZER(ipc_channel.
 						       ich_evqueues),
+	.ich_readyq		= PFC_LIST_INITIALIZER(ipc_channel.
+						       ich_readyq),
 	.ich_listener		= -1,
 	.ich_epfd		= -1,
 	.ich_shutfd		= -1,
@@ -464,6 +466,12 @@ ipcsrv_init(ipc_channel_t *PFC_RESTRICT chp, const char *PFC_RESTRICT channel,
 		goto error;
 	}
 
+	err = pfc_cond_init(&chp->ich_wcond);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		/* This should never happen. */
+		goto error;
+	}
+
 	/* Initialize shutdown notification FD. */
 	err = ipcsrv_shutfd_init(chp, shutfd);
 	if (PFC_EXPECT_FALSE(err != 0)) {
@@ -577,6 +585,13 @@ ipcsrv_apply(ipc_channel_t *PFC_RESTRICT chp, pfc_bool_t do_init,
 	chp->ich_max_sessions = chconf.icc_max_sessions;
 	chp->ich_timeout = chconf.icc_timeout;
 
+	/*
+	 * A non-zero workers value lets new sessions wait for commands on
+	 * the epoll instance, and a pool of at most `workers' threads
+	 * dispatches them. Existing sessions keep their own mode.
+	 */
+	chp->ich_workers = chconf.icc_workers;
+
 	/* max_clients must not exceed max_sessions. */
 	if (PFC_EXPECT_FALSE(chp->ich_max_sessions < chp->ich_max_clients)) {
 		IPCSRV_LOG_WARN("max_sessions(%u) must be greater than or "
@@ -585,10 +600,16 @@ ipcsrv_apply(ipc_channel_t *PFC_RESTRICT chp, pfc_bool_t do_init,
 		chp->ich_max_sessions = chp->ich_max_clients;
 	}
 
+	/* More workers than sessions never run. */
+	if (PFC_EXPECT_FALSE(chp->ich_workers > chp->ich_max_sessions)) {
+		chp->ich_workers = chp->ich_max_sessions;
+	}
+
 	IPCSRV_LOG_INFO("max_clients=%u, max_sessions=%u, timeout=%u, "
-			"perm=0%o",
+			"workers=%u, perm=0%o",
 			chp->ich_max_clients, chp->ich_max_sessions,
-			chp->ich_timeout, chconf.icc_permission);
+			chp->ich_timeout, chp->ich_workers,
+			chconf.icc_permission);
 
 	if (modep != NULL) {
 		*modep = chconf.icc_permission;
@@ -105,6 +105,8 @@ struct ipc_channel {
 	pfc_rbtree_t	ich_handlers;		/* service handlers */
 	pfc_list_t	ich_sessions;		/* list of active sessions */
 	pfc_list_t	ich_evqueues;		/* list of event queues */
+	pfc_list_t	ich_readyq;		/* sessions ready to dispatch */
+	pfc_cond_t	ich_wcond;		/* condvar for session workers */
 	pfc_ipcsrvops_t	ich_ops;		/* server operations */
 	pfc_ephdlr_t	ich_ep_listener;	/* listener event handler */
 	pfc_ephdlr_t	ich_ep_shutdown;	/* shutdown event handler */
@@ -120,6 +122,10 @@ struct ipc_channel {
 	uint32_t	ich_max_clients;	/* max number of clients */
 	uint32_t	ich_max_sessions;	/* max number of sessions */
 	uint32_t	ich_timeout;		/* session timeout (sec) */
+	uint32_t	ich_workers;		/* max number of session workers */
+	uint32_t	ich_nworkers;		/* number of session workers */
+	uint32_t	ich_widle;		/* number of idle session workers */
+	uint32_t	ich_nready;		/* number of sessions in readyq */
 	pfc_ipcevid_t	ich_evserial_next;	/* serial ID for IPC event */
 };
 
@@ -146,6 +152,10 @@ struct ipc_channel {
 	PFC_ASSERT_INT(pfc_rwlock_unlock(&(chp)->ich_hlock), 0)
 
 #define	IPCCH_SIGNAL(chp)	pfc_cond_signal(&(chp)->ich_cond)
+#define	IPCCH_WORKER_SIGNAL(chp)	pfc_cond_signal(&(chp)->ich_wcond)
+#define	IPCCH_WORKER_BROADCAST(chp)	pfc_cond_broadcast(&(chp)->ich_wcond)
+#define	IPCCH_WORKER_WAIT(chp)					\
+	pfc_cond_wait(&(chp)->ich_wcond, &(chp)->ich_mutex)
 #define	IPCCH_TIMEDWAIT_ABS(chp, abstime)				\
 	pfc_cond_timedwait_abs(&(chp)->ich_cond, &(chp)->ich_mutex, (abstime))
 
@@ -154,6 +164,13 @@ struct ipc_channel {
  */
 #define	IPCCHF_SHUTDOWN		PFC_CONST_U(0x1)	/* shutdown */
 #define	IPCCHF_SELFPIPE		PFC_CONST_U(0x2)	/* use self-pipe */
+#define	IPCCHF_WSTOP		PFC_CONST_U(0x4)	/* stop session workers */
+
+/*
+ * Event poll event bits to watch a pooled server session which waits for
+ * the next command.
+ */
+#define	IPCSRV_EPOLLEV_IDLE		(EPOLLIN | IPC_EPOLLEV_RESET)
 
 /*
  * IPC client information.
@@ -238,9 +255,18 @@ struct __pfc_ipcsrv {
 	ipc_stream_t	isv_output;	/* output stream */
 	pfc_timespec_t	isv_timeout;	/* server session timeout */
 	pfc_list_t	isv_list;	/* link for active session list */
+	pfc_list_t	isv_rqlist;	/* link for ready session queue */
 	pfc_ephdlr_t	isv_epoll;	/* connection reset event handler */
+	pfc_ephdlr_t	isv_ep_idle;	/* idle session event handler */
 	ipc_clinfo_t	isv_client;	/* client information */
 
+	/*
+	 * Session pool flags and the command being dispatched by a session
+	 * worker. isv_pflags must be serialized by the IPC channel lock.
+	 */
+	uint32_t	isv_pflags;
+	uint8_t		isv_command;
+
 	/* IPC server session callbacks. */
 	ipc_srvcb_t	*isv_callback[IPCSRV_NCBTYPES];
 
@@ -263,6 +289,10 @@ struct __pfc_ipcsrv {
 	PFC_CAST_CONTAINER((list), pfc_ipcsrv_t, isv_list)
 #define	IPCSRV_EP2PTR(ephp)					\
 	PFC_CAST_CONTAINER((ephp), pfc_ipcsrv_t, isv_epoll)
+#define	IPCSRV_IDLE_EP2PTR(ephp)				\
+	PFC_CAST_CONTAINER((ephp), pfc_ipcsrv_t, isv_ep_idle)
+#define	IPCSRV_RQ2PTR(list)					\
+	PFC_CAST_CONTAINER((list), pfc_ipcsrv_t, isv_rqlist)
 
 #define	IPCSRV_ACTIVE_ADD(chp, srv)					\
 	pfc_list_push_tail(&(chp)->ich_sessions, &(srv)->isv_list)
@@ -291,6 +321,13 @@ struct __pfc_ipcsrv {
 #define	IPCSRVF_EVQ_INPUT	PFC_CONST_U(0x0040)	/* input on eventQ */
 #define	IPCSRVF_EVQ_SHUTDOWN	PFC_CONST_U(0x0080)	/* eventQ shutdown */
 
+/*
+ * Flags for isv_pflags.
+ */
+#define	IPCSRVPF_POOLED		PFC_CONST_U(0x1)	/* dispatched by workers */
+#define	IPCSRVPF_STARTED	PFC_CONST_U(0x2)	/* handshake completed */
+#define	IPCSRVPF_PARKED		PFC_CONST_U(0x4)	/* waiting on epoll */
+
 /*
  * True if the specified server session is a pseudo session used to send
  * an IPC event.
@@ -46,6 +46,12 @@ typedef struct {
 	ipc_srvcbdtor_t	iscbds_dtor[IPCSRV_NCBTYPES];
 } ipc_srvcbdtorset_t;
 
+/*
+ * IPC protocol command operation.
+ */
+struct ipc_cmdops;
+typedef const struct ipc_cmdops	ipc_ccmdops_t;
+
 /*
  * Internal prototypes.
  */
@@ -63,6 +69,18 @@ static void	ipcsrv_sess_destroy(pfc_ipcsrv_t *srv);
 static void	*ipcsrv_sess_main(void *arg);
 static int	ipcsrv_sess_start(pfc_ipcsrv_t *srv);
 static int	ipcsrv_sess_dispatch(pfc_ipcsrv_t *srv);
+static int	ipcsrv_sess_getcmd(pfc_ipcsrv_t *PFC_RESTRICT srv,
+				   ipc_ccmdops_t **PFC_RESTRICT opsp);
+static int	ipcsrv_sess_exec(pfc_ipcsrv_t *PFC_RESTRICT srv,
+				 ipc_ccmdops_t *PFC_RESTRICT ops);
+static void	ipcsrv_sess_run(pfc_ipcsrv_t *srv, pfc_bool_t started);
+static int	ipcsrv_sess_park(pfc_ipcsrv_t *srv, uint32_t pflags);
+static void	ipcsrv_sess_unpark_l(ipc_channel_t *PFC_RESTRICT chp,
+				     pfc_ipcsrv_t *PFC_RESTRICT srv);
+static int	ipcsrv_sess_detach(pfc_ipcsrv_t *srv);
+static void	*ipcsrv_sess_detached(void *arg);
+static void	*ipcsrv_worker_main(void *arg);
+static void	ipcsrv_worker_kick(ipc_channel_t *chp);
 static int	ipcsrv_sess_ping(pfc_ipcsrv_t *PFC_RESTRICT srv,
 				 pfc_timespec_t *PFC_RESTRICT abstime);
 static int	ipcsrv_sess_invoke(pfc_ipcsrv_t *PFC_RESTRICT srv,
@@ -81,6 +99,8 @@ static int	ipcsrv_settimeout(pfc_ipcsrv_t *PFC_RESTRICT srv,
 				  const pfc_timespec_t *PFC_RESTRICT called);
 static int	ipcsrv_epoll_client(pfc_ephdlr_t *ephp, uint32_t events,
 				    void *arg);
+static int	ipcsrv_epoll_idle(pfc_ephdlr_t *ephp, uint32_t events,
+				  void *arg);
 static int	ipcsrv_log_econnreset(pfc_ipcsrv_t *srv, pfc_bool_t active,
 				      int sock)
 	PFC_FATTR_NOINLINE;
@@ -179,9 +199,9 @@ ipcsrv_cbdtorset_invoke(ipc_srvcbdtorset_t *dset)
 }
 
 /*
- * IPC protocol command operation.
+ * Entity of IPC protocol command operation.
  */
-typedef struct {
+typedef struct ipc_cmdops {
 	/*
 	 * int
 	 * icops_exec(pfc_ipcsrv_t *PFC_RESTRICT srv,
@@ -196,16 +216,22 @@ typedef struct {
 	 */
 	int	(*icops_exec)(pfc_ipcsrv_t *PFC_RESTRICT srv,
 			      pfc_timespec_t *PFC_RESTRICT abstime);
-} ipc_cmdops_t;
 
-typedef const ipc_cmdops_t	ipc_ccmdops_t;
+	/*
+	 * True if the command occupies the session until the session ends.
+	 * Such a command on a pooled session is executed on a dedicated
+	 * thread so that it never holds a session worker.
+	 */
+	pfc_bool_t	icops_dedicated;
+} ipc_cmdops_t;
 
 /*
  * IPC protocol command handlers.
  */
-#define	IPCSRV_CMD_DECL(cmd)					\
+#define	IPCSRV_CMD_DECL(cmd, dedicated)				\
 	{							\
-		.icops_exec	= ipcsrv_sess_cmd_##cmd,	\
+		.icops_exec		= ipcsrv_sess_cmd_##cmd,	\
+		.icops_dedicated	= (dedicated),		\
 	}
 
 #define	ipcsrv_sess_cmd_PING		ipcsrv_sess_ping
@@ -213,9 +239,9 @@ typedef const ipc_cmdops_t	ipc_ccmdops_t;
 #define	ipcsrv_sess_cmd_EVENT		pfc_ipcsrv_event_session
 
 static ipc_ccmdops_t	ipc_proto_commands[] = {
-	IPCSRV_CMD_DECL(PING),
-	IPCSRV_CMD_DECL(INVOKE),
-	IPCSRV_CMD_DECL(EVENT),
+	IPCSRV_CMD_DECL(PING, PFC_FALSE),
+	IPCSRV_CMD_DECL(INVOKE, PFC_FALSE),
+	IPCSRV_CMD_DECL(EVENT, PFC_TRUE),
 };
 
 /*
@@ -651,7 +677,10 @@ pfc_ipcsrv_sess_init(ipc_channel_t *PFC_RESTRICT chp,
 	srv->isv_magic = IPC_PROTO_MAGIC;
 	srv->isv_flags = 0;
 	srv->isv_procname = NULL;
+	srv->isv_pflags = 0;
+	srv->isv_command = 0;
 	pfc_epoll_handler_init(&srv->isv_epoll, ipcsrv_epoll_client);
+	pfc_epoll_handler_init(&srv->isv_ep_idle, ipcsrv_epoll_idle);
 
 	for (cbpp = srv->isv_callback;
 	     cbpp < PFC_ARRAY_LIMIT(srv->isv_callback); cbpp++) {
@@ -796,9 +825,26 @@ pfc_ipcsrv_epoll_shutdown(pfc_ephdlr_t *ephp, uint32_t events,
 
 		IPCSRV_SIGNAL(srv);
 		IPCSRV_UNLOCK(srv);
+
+		/*
+		 * A pooled session waiting for the next command is no longer
+		 * watched. Let a session worker close it.
+		 */
+		if (srv->isv_pflags & IPCSRVPF_PARKED) {
+			ipcsrv_sess_unpark_l(chp, srv);
+		}
 	}
 
-	IPCCH_UNLOCK(chp);
+	/* Session workers quit when the ready queue becomes empty. */
+	chp->ich_flags |= IPCCHF_WSTOP;
+	IPCCH_WORKER_BROADCAST(chp);
+
+	if (chp->ich_nready != 0) {
+		ipcsrv_worker_kick(chp);
+	}
+	else {
+		IPCCH_UNLOCK(chp);
+	}
 
 	return ECANCELED;
 }
@@ -810,7 +856,9 @@ pfc_ipcsrv_epoll_shutdown(pfc_ephdlr_t *ephp, uint32_t events,
  *	Handle an epoll event on the listener socket for the IPC channel.
  *
  *	This function creates a new thread for an IPC server session, and
- *	starts the session on the thread.
+ *	starts the session on the thread. If session workers are configured,
+ *	the new session is parked on the epoll instance instead, and a
+ *	session worker starts it when the handshake message arrives.
  *
  * Calling/Exit State:
  *	Zero is always returned.
@@ -845,14 +893,24 @@ pfc_ipcsrv_epoll_listener(pfc_ephdlr_t *ephp, uint32_t events,
 	PFC_ASSERT_INT(pfc_hostaddr_init_local(&haddr), 0);
 	if (PFC_EXPECT_TRUE(ipcsrv_sess_create(chp, sock, &haddr, opts, &srv)
 			    == 0)) {
-		/* Create a new thread for this session. */
-		err = chp->ich_ops.isvops_thread_create(ipcsrv_sess_main, srv);
-		if (PFC_EXPECT_TRUE(err == 0)) {
-			return 0;
+		if (srv->isv_pflags & IPCSRVPF_POOLED) {
+			/* Wait for the handshake message on the epoll. */
+			err = ipcsrv_sess_park(srv, 0);
+			if (PFC_EXPECT_TRUE(err == 0)) {
+				return 0;
+			}
 		}
+		else {
+			/* Create a new thread for this session. */
+			err = chp->ich_ops.isvops_thread_create
+				(ipcsrv_sess_main, srv);
+			if (PFC_EXPECT_TRUE(err == 0)) {
+				return 0;
+			}
 
-		IPCSRV_LOG_ERROR("Unable to create a new IPC server session "
-				 "thread: %s.", strerror(err));
+			IPCSRV_LOG_ERROR("Unable to create a new IPC server "
+					 "session thread: %s.", strerror(err));
+		}
 		ipcsrv_sess_close(srv, PFC_FALSE);
 	}
 
@@ -979,6 +1037,11 @@ ipcsrv_sess_create(ipc_channel_t *PFC_RESTRICT chp, int sock,
 		srv->isv_magic = IPC_PROTO_MAGIC_TOOMANY;
 	}
 
+	if (chp->ich_workers != 0) {
+		/* This session is dispatched by session workers. */
+		srv->isv_pflags = IPCSRVPF_POOLED;
+	}
+
 	IPCSRV_ACTIVE_ADD(chp, srv);
 	IPCCH_UNLOCK(chp);
 
@@ -1207,6 +1270,12 @@ ipcsrv_sess_start(pfc_ipcsrv_t *srv)
 
 	IPC_SESS_PROTO_INIT(sess, &hshake);
 
+	/* Determine transfer modes before the client sends a request. */
+	err = pfc_ipc_sess_setxfer(sess, &hshake);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		return err;
+	}
+
 	magic = srv->isv_magic;
 	if (PFC_EXPECT_FALSE(magic != IPC_PROTO_MAGIC)) {
 		/* Too many clients or session threads. */
@@ -1242,9 +1311,9 @@ ipcsrv_sess_start(pfc_ipcsrv_t *srv)
 	IPCSRV_UNLOCK(srv);
 
 	IPCSRV_LOG_INFO("New connection: srv=%p, sock=%d, client=%u, "
-			"uid=%d, gid=%d ver=%u, bflags=0x%x",
+			"uid=%d, gid=%d ver=%u, bflags=0x%x, xflags=0x%x",
 			srv, sock, credp->pid, credp->uid, credp->gid,
-			sess->iss_version, sess->iss_flags);
+			sess->iss_version, sess->iss_flags, sess->iss_xflags);
 
 	return 0;
 
@@ -1270,11 +1339,35 @@ error_hshake:
 static int
 ipcsrv_sess_dispatch(pfc_ipcsrv_t *srv)
 {
-	ipc_channel_t	*chp = srv->isv_channel;
-	ipc_sess_t	*sess = &srv->isv_session;
+	ipc_ccmdops_t	*ops = NULL;
+	int		err;
+
+	err = ipcsrv_sess_getcmd(srv, &ops);
+	if (PFC_EXPECT_TRUE(err == 0)) {
+		err = ipcsrv_sess_exec(srv, ops);
+	}
+
+	return err;
+}
+
+/*
+ * static int
+ * ipcsrv_sess_getcmd(pfc_ipcsrv_t *PFC_RESTRICT srv,
+ *		      ipc_ccmdops_t **PFC_RESTRICT opsp)
+ *	Receive a command on the IPC service session.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, the received command is set to
+ *	srv->isv_command, a pointer to its operation is set to `*opsp',
+ *	and zero is returned.
+ *	Otherwise error number which indicates the cause of error is returned.
+ */
+static int
+ipcsrv_sess_getcmd(pfc_ipcsrv_t *PFC_RESTRICT srv,
+		   ipc_ccmdops_t **PFC_RESTRICT opsp)
+{
 	ipc_ccmdops_t	*ops;
-	pfc_iostream_t	stream = sess->iss_stream;
-	pfc_timespec_t	*abstime, tsbuf;
+	pfc_iostream_t	stream = srv->isv_stream;
 	uint8_t		cmd;
 	size_t		sz;
 	int		err;
@@ -1306,8 +1399,32 @@ ipcsrv_sess_dispatch(pfc_ipcsrv_t *srv)
 		return EPROTO;
 	}
 
+	srv->isv_command = cmd;
+	*opsp = ops;
+
+	return 0;
+}
+
+/*
+ * static int
+ * ipcsrv_sess_exec(pfc_ipcsrv_t *PFC_RESTRICT srv,
+ *		    ipc_ccmdops_t *PFC_RESTRICT ops)
+ *	Execute the IPC protocol command specified by `ops' on the given
+ *	IPC server session.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	Otherwise error number which indicates the cause of error is returned.
+ */
+static int
+ipcsrv_sess_exec(pfc_ipcsrv_t *PFC_RESTRICT srv,
+		 ipc_ccmdops_t *PFC_RESTRICT ops)
+{
+	pfc_timespec_t	*abstime, tsbuf;
+	int		err;
+
 	/* Initialize session timeout. */
-	err = pfc_ipcsrv_timeout_init(chp, &abstime, &tsbuf);
+	err = pfc_ipcsrv_timeout_init(srv->isv_channel, &abstime, &tsbuf);
 	if (PFC_EXPECT_FALSE(err != 0)) {
 		return err;
 	}
@@ -1316,6 +1433,344 @@ ipcsrv_sess_dispatch(pfc_ipcsrv_t *srv)
 	return ops->icops_exec(srv, abstime);
 }
 
+/*
+ * static void
+ * ipcsrv_sess_run(pfc_ipcsrv_t *srv, pfc_bool_t started)
+ *	Dispatch commands on the pooled IPC server session specified by `srv'.
+ *	This function is called by a session worker when the session becomes
+ *	readable.
+ *
+ *	If `started' is PFC_FALSE, the session is established in advance.
+ *	Commands are dispatched as long as the input buffer keeps unread
+ *	data, and then the session is parked on the epoll instance again.
+ *
+ * Remarks:
+ *	The session is closed on error.
+ */
+static void
+ipcsrv_sess_run(pfc_ipcsrv_t *srv, pfc_bool_t started)
+{
+	ipc_ccmdops_t	*ops = NULL;
+	int		err;
+
+	if (!started) {
+		/* Establish a new IPC session. */
+		err = ipcsrv_sess_start(srv);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			goto close;
+		}
+	}
+
+	do {
+		err = ipcsrv_sess_getcmd(srv, &ops);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			goto close;
+		}
+
+		if (PFC_EXPECT_FALSE(ops->icops_dedicated)) {
+			/* Hand the session over to a dedicated thread. */
+			err = ipcsrv_sess_detach(srv);
+			if (PFC_EXPECT_TRUE(err == 0)) {
+				return;
+			}
+			goto close;
+		}
+
+		err = ipcsrv_sess_exec(srv, ops);
+		if (PFC_EXPECT_FALSE(err != 0)) {
+			goto close;
+		}
+	} while (__pfc_iostream_rdpending(srv->isv_stream));
+
+	/* Wait for the next command on the epoll instance. */
+	err = ipcsrv_sess_park(srv, IPCSRVPF_STARTED);
+	if (PFC_EXPECT_TRUE(err == 0)) {
+		return;
+	}
+
+close:
+	ipcsrv_sess_close(srv, PFC_TRUE);
+}
+
+/*
+ * static int
+ * ipcsrv_sess_park(pfc_ipcsrv_t *srv, uint32_t pflags)
+ *	Register the pooled IPC server session specified by `srv' to the
+ *	epoll instance in order to wait for the next command.
+ *
+ *	`pflags' is a set of session pool flags to be set to the session.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	ECANCELED is returned if the IPC server is going to shut down.
+ *	Otherwise error number which indicates the cause of error is returned.
+ *
+ * Remarks:
+ *	The session must not be touched on successful return because a
+ *	session worker may dispatch it immediately.
+ */
+static int
+ipcsrv_sess_park(pfc_ipcsrv_t *srv, uint32_t pflags)
+{
+	ipc_channel_t	*chp = srv->isv_channel;
+	pfc_iostream_t	stream;
+	int		err;
+
+	IPCCH_LOCK(chp);
+
+	if (PFC_EXPECT_FALSE(chp->ich_flags & IPCCHF_WSTOP)) {
+		/* The listener thread no longer watches any session. */
+		err = ECANCELED;
+		goto out;
+	}
+
+	IPCSRV_LOCK(srv);
+	stream = srv->isv_stream;
+	IPCSRV_UNLOCK(srv);
+
+	if (PFC_EXPECT_FALSE(stream == NULL)) {
+		/* Already reset. */
+		err = ECONNRESET;
+		goto out;
+	}
+
+	err = pfc_epoll_ctl(chp->ich_epfd, EPOLL_CTL_ADD,
+			    pfc_iostream_getfd(stream), IPCSRV_EPOLLEV_IDLE,
+			    &srv->isv_ep_idle);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		err = errno;
+		IPCSRV_LOG_ERROR("Failed to register idle session to the "
+				 "epoll instance: srv=%p: %s", srv,
+				 strerror(err));
+		if (PFC_EXPECT_FALSE(err == 0)) {
+			err = EIO;
+		}
+	}
+	else {
+		srv->isv_pflags |= (pflags | IPCSRVPF_PARKED);
+	}
+
+out:
+	IPCCH_UNLOCK(chp);
+
+	return err;
+}
+
+/*
+ * static void
+ * ipcsrv_sess_unpark_l(ipc_channel_t *PFC_RESTRICT chp,
+ *			pfc_ipcsrv_t *PFC_RESTRICT srv)
+ *	Remove the parked IPC server session specified by `srv' from the
+ *	epoll instance, and push it to the ready queue.
+ *
+ * Remarks:
+ *	This function must be called with holding the IPC channel lock.
+ *	The caller must call ipcsrv_worker_kick() afterwards.
+ */
+static void
+ipcsrv_sess_unpark_l(ipc_channel_t *PFC_RESTRICT chp,
+		     pfc_ipcsrv_t *PFC_RESTRICT srv)
+{
+	int	err;
+
+	PFC_ASSERT(srv->isv_pflags & IPCSRVPF_PARKED);
+	PFC_ASSERT(srv->isv_stream != NULL);
+
+	err = pfc_epoll_ctl(chp->ich_epfd, EPOLL_CTL_DEL,
+			    pfc_iostream_getfd(srv->isv_stream), 0, NULL);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		/* This should never happen. */
+		IPCSRV_LOG_ERROR("Failed to remove idle session from the "
+				 "epoll instance: srv=%p: %s", srv,
+				 strerror(errno));
+		/* FALLTHROUGH */
+	}
+
+	srv->isv_pflags &= ~IPCSRVPF_PARKED;
+	pfc_list_push_tail(&chp->ich_readyq, &srv->isv_rqlist);
+	chp->ich_nready++;
+}
+
+/*
+ * static int
+ * ipcsrv_sess_detach(pfc_ipcsrv_t *srv)
+ *	Detach the pooled IPC server session specified by `srv' from session
+ *	workers, and execute the command in srv->isv_command on a new thread.
+ *	The session keeps the thread until it ends, as if it were not pooled.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	Otherwise error number which indicates the cause of error is returned.
+ */
+static int
+ipcsrv_sess_detach(pfc_ipcsrv_t *srv)
+{
+	ipc_channel_t	*chp = srv->isv_channel;
+	int		err;
+
+	IPCCH_LOCK(chp);
+	srv->isv_pflags &= ~IPCSRVPF_POOLED;
+	IPCCH_UNLOCK(chp);
+
+	err = chp->ich_ops.isvops_thread_create(ipcsrv_sess_detached, srv);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		IPCSRV_LOG_ERROR("Unable to create a new IPC server session "
+				 "thread: %s.", strerror(err));
+	}
+
+	return err;
+}
+
+/*
+ * static void *
+ * ipcsrv_sess_detached(void *arg)
+ *	Start routine of IPC server session thread for a session detached
+ *	from session workers.
+ *
+ * Calling/Exit State:
+ *	NULL is always returned.
+ */
+static void *
+ipcsrv_sess_detached(void *arg)
+{
+	pfc_ipcsrv_t	*srv = (pfc_ipcsrv_t *)arg;
+	int		err;
+
+	err = ipcsrv_sess_exec(srv, &ipc_proto_commands[srv->isv_command]);
+	if (PFC_EXPECT_TRUE(err == 0)) {
+		/* Dispatch IPC protocol commands. */
+		while (ipcsrv_sess_dispatch(srv) == 0) {}
+	}
+
+	ipcsrv_sess_close(srv, PFC_TRUE);
+
+	return NULL;
+}
+
+/*
+ * static void *
+ * ipcsrv_worker_main(void *arg)
+ *	Start routine of IPC session worker thread.
+ *
+ *	A session worker dispatches pooled sessions in the ready queue.
+ *	It quits when the ready queue becomes empty after the listener thread
+ *	stopped watching sessions.
+ *
+ * Calling/Exit State:
+ *	NULL is always returned.
+ */
+static void *
+ipcsrv_worker_main(void *arg)
+{
+	ipc_channel_t	*chp = (ipc_channel_t *)arg;
+
+	IPCCH_LOCK(chp);
+
+	for (;;) {
+		pfc_ipcsrv_t	*srv;
+		pfc_list_t	*elem;
+		pfc_bool_t	started;
+
+		elem = pfc_list_pop(&chp->ich_readyq);
+		if (elem == NULL) {
+			if (chp->ich_flags & IPCCHF_WSTOP) {
+				break;
+			}
+
+			chp->ich_widle++;
+			IPCCH_WORKER_WAIT(chp);
+			chp->ich_widle--;
+			continue;
+		}
+
+		PFC_ASSERT(chp->ich_nready > 0);
+		chp->ich_nready--;
+
+		srv = IPCSRV_RQ2PTR(elem);
+		started = (srv->isv_pflags & IPCSRVPF_STARTED)
+			? PFC_TRUE : PFC_FALSE;
+		IPCCH_UNLOCK(chp);
+
+		ipcsrv_sess_run(srv, started);
+
+		IPCCH_LOCK(chp);
+	}
+
+	PFC_ASSERT(chp->ich_nworkers > 0);
+	chp->ich_nworkers--;
+
+	/* Release the IPC channel held by ipcsrv_worker_kick(). */
+	pfc_ipcsrv_channel_release_l(chp);
+
+	return NULL;
+}
+
+/*
+ * static void
+ * ipcsrv_worker_kick(ipc_channel_t *chp)
+ *	Let session workers dispatch sessions in the ready queue.
+ *
+ *	A new session worker is started if ready sessions outnumber idle
+ *	workers, unless the number of workers reaches the limit. If no
+ *	worker can be started, ready sessions are closed.
+ *
+ * Remarks:
+ *	This function must be called with holding the IPC channel lock.
+ *	It is always released on return.
+ */
+static void
+ipcsrv_worker_kick(ipc_channel_t *chp)
+{
+	pfc_list_t	head, *elem;
+	uint32_t	nworkers = chp->ich_nworkers;
+	int		err;
+
+	if (chp->ich_nready > chp->ich_widle &&
+	    (nworkers < chp->ich_workers || nworkers == 0)) {
+		/*
+		 * The new worker can not run until the IPC channel lock is
+		 * released.
+		 */
+		err = chp->ich_ops.isvops_thread_create(ipcsrv_worker_main,
+							chp);
+		if (PFC_EXPECT_TRUE(err == 0)) {
+			/* The worker holds the IPC channel until it quits. */
+			pfc_ipcsrv_channel_ref(chp);
+			chp->ich_nworkers = nworkers + 1;
+		}
+		else {
+			IPCSRV_LOG_ERROR("Unable to create a new IPC session "
+					 "worker: %s.", strerror(err));
+			if (nworkers == 0) {
+				goto abort;
+			}
+		}
+	}
+
+	if (chp->ich_widle != 0) {
+		IPCCH_WORKER_SIGNAL(chp);
+	}
+
+	IPCCH_UNLOCK(chp);
+
+	return;
+
+abort:
+	/* Nobody can dispatch ready sessions. */
+	pfc_list_move_all(&chp->ich_readyq, &head);
+	pfc_list_init(&chp->ich_readyq);
+	chp->ich_nready = 0;
+	IPCCH_UNLOCK(chp);
+
+	while ((elem = pfc_list_pop(&head)) != NULL) {
+		pfc_ipcsrv_t	*srv = IPCSRV_RQ2PTR(elem);
+
+		IPCSRV_LOG_ERROR("A request from IPC client was dropped: "
+				 "srv=%p", srv);
+		ipcsrv_sess_close(srv, PFC_TRUE);
+	}
+}
+
 /*
  * static int
  * ipcsrv_sess_ping(pfc_ipcsrv_t *PFC_RESTRICT srv, pfc_timespec_t *abstime)
@@ -1898,6 +2353,48 @@ ipcsrv_epoll_client(pfc_ephdlr_t *ephp, uint32_t events,
 	return 0;
 }
 
+/*
+ * static int
+ * ipcsrv_epoll_idle(pfc_ephdlr_t *ephp, uint32_t events,
+ *		     void *arg PFC_ATTR_UNUSED)
+ *	Handle an event on the client connection socket for the pooled IPC
+ *	server session which waits for the next command.
+ *
+ *	This function passes the session to session workers.
+ *
+ * Calling/Exit State:
+ *	Zero is always returned.
+ */
+static int
+ipcsrv_epoll_idle(pfc_ephdlr_t *ephp, uint32_t events,
+		  void *arg PFC_ATTR_UNUSED)
+{
+	pfc_ipcsrv_t	*srv = IPCSRV_IDLE_EP2PTR(ephp);
+	ipc_channel_t	*chp = srv->isv_channel;
+
+	PFC_ASSERT(chp == &ipc_channel);
+
+	if (PFC_EXPECT_FALSE(events == 0)) {
+		return 0;
+	}
+
+	IPCCH_LOCK(chp);
+
+	if (PFC_EXPECT_TRUE(srv->isv_pflags & IPCSRVPF_PARKED)) {
+		/*
+		 * Connection reset is also detected by a session worker
+		 * because it reads EOF.
+		 */
+		ipcsrv_sess_unpark_l(chp, srv);
+		ipcsrv_worker_kick(chp);
+	}
+	else {
+		IPCCH_UNLOCK(chp);
+	}
+
+	return 0;
+}
+
 /*
  * static int
  * ipcsrv_log_econnreset(pfc_ipcsrv_t *srv, pfc_bool_t active, int sock)
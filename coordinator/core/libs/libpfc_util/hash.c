@@ -37,6 +37,17 @@
 #define	ENTREF_IGNORE_KEY	0x1U		/* don't touch hash key */
 #define	ENTREF_IGNORE_VALUE	0x2U		/* don't touch hash value */
 
+/*
+ * Average length of bucket chains which triggers automatic growth of
+ * a table created with PFC_HASH_AUTOGROW.
+ */
+#define	HASH_AUTOGROW_LOAD	1U
+
+/*
+ * Number of old hash buckets to be rehashed by one update of a growing table.
+ */
+#define	HASH_REHASH_STEP	4U
+
 /*
  * Iterator of hash entries.
  */
@@ -68,11 +79,25 @@ static void	pfc_hash_entry_unref(pfc_hashtbl_t *PFC_RESTRICT hp,
 static pfc_hashent_t	*pfc_hash_entry_alloc(pfc_cptr_t key, pfc_cptr_t value,
 					      uint32_t flags);
 static pfc_hashent_t	**pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key,
-					  uint32_t index);
+					  uint32_t hval);
+static pfc_hashent_t	**pfc_hash_lookup_chain(pfc_hashtbl_t *hp,
+						pfc_hashent_t **entpp,
+						pfc_cptr_t key);
 static pfc_hashent_t	**pfc_hash_lookup_refptr(pfc_hashtbl_t *hp,
-						 pfc_refptr_t *key,
-						 uint32_t index);
+						 pfc_hashent_t **entpp,
+						 pfc_refptr_t *key);
 static size_t		pfc_hash_clear_l(pfc_hashtbl_t *hp);
+static void		pfc_hash_clear_buckets(pfc_hashtbl_t *PFC_RESTRICT hp,
+					       pfc_hashent_t **PFC_RESTRICT
+					       table, uint32_t nbuckets);
+static void		pfc_hash_grow(pfc_hashtbl_t *hp);
+static pfc_bool_t	pfc_hash_rehash_step(pfc_hashtbl_t *hp,
+					     pfc_bool_t striped);
+static void		pfc_hash_rehash_bucket(pfc_hashtbl_t *hp,
+					       uint32_t index);
+static void		pfc_hash_rehash_free_l(pfc_hashtbl_t *hp);
+static void		pfc_hash_rehash_finish_l(pfc_hashtbl_t *hp);
+static void		pfc_hash_rehash_end(pfc_hashtbl_t *hp);
 static int		pfc_hashiter_get_next(hash_iter_t *PFC_RESTRICT iter,
 					      pfc_hashtbl_t *PFC_RESTRICT hp,
 					      pfc_cptr_t *PFC_RESTRICT keyp,
@@ -178,6 +203,137 @@ pfc_hash_unlock(pfc_hashtbl_t *hp, int cookie)
 	}
 }
 
+/*
+ * static inline int
+ * pfc_hash_updlock(pfc_hashtbl_t *PFC_RESTRICT hp,
+ *		    pfc_bool_t *PFC_RESTRICT stripedp)
+ *	Acquire hash table lock in order to update a hash entry.
+ *	Returned value must be passed to pfc_hash_unlock().
+ *
+ *	If the table is updated with striped bucket locks, the table lock is
+ *	acquired in reader mode, and PFC_TRUE is set to `*stripedp'.
+ *	In that case the caller must hold the lock stripe associated with
+ *	the hash value in order to touch bucket chains.
+ *	Otherwise the table lock is acquired in writer mode, and PFC_FALSE is
+ *	set to `*stripedp'.
+ */
+static inline int
+pfc_hash_updlock(pfc_hashtbl_t *PFC_RESTRICT hp,
+		 pfc_bool_t *PFC_RESTRICT stripedp)
+{
+	if (hp->ph_stripes != NULL && pfc_hashsync_lookup(hp) == NULL) {
+		(void)pfc_rwlock_rdlock(&hp->ph_lock);
+		*stripedp = PFC_TRUE;
+
+		return 1;
+	}
+
+	*stripedp = PFC_FALSE;
+
+	return pfc_hash_wrlock(hp);
+}
+
+/*
+ * static inline int
+ * pfc_hash_scanlock(pfc_hashtbl_t *hp)
+ *	Acquire hash table lock in order to scan all hash buckets.
+ *	Returned value must be passed to pfc_hash_unlock().
+ */
+static inline int
+pfc_hash_scanlock(pfc_hashtbl_t *hp)
+{
+	if (hp->ph_stripes == NULL) {
+		return pfc_hash_rdlock(hp);
+	}
+
+	/*
+	 * Updaters of striped table hold the table lock in reader mode,
+	 * so writer mode is required to scan buckets. Synchronized block
+	 * on striped table always holds the table lock in writer mode.
+	 */
+	if (pfc_hashsync_lookup(hp) != NULL) {
+		return 0;
+	}
+
+	(void)pfc_rwlock_wrlock(&hp->ph_lock);
+
+	return 1;
+}
+
+/*
+ * static inline pfc_mutex_t *
+ * pfc_hash_stripe_lock(pfc_hashtbl_t *hp, uint32_t hval)
+ *	Acquire the lock stripe associated with the given hash value, or
+ *	hash bucket index.
+ *	A pointer to the acquired lock is returned.
+ */
+static inline pfc_mutex_t *
+pfc_hash_stripe_lock(pfc_hashtbl_t *hp, uint32_t hval)
+{
+	pfc_mutex_t	*mp = hp->ph_stripes + (hval % PFC_HASH_NSTRIPES);
+
+	pfc_mutex_lock(mp);
+
+	return mp;
+}
+
+/*
+ * static inline void
+ * pfc_hash_nelems_inc(pfc_hashtbl_t *hp, pfc_bool_t striped)
+ *	Increment number of hash entries in the given table.
+ *	`striped' must be a value set by pfc_hash_updlock().
+ */
+static inline void
+pfc_hash_nelems_inc(pfc_hashtbl_t *hp, pfc_bool_t striped)
+{
+	if (!striped) {
+		hp->ph_nelems++;
+	}
+	else if (PFC_IS_LP64_SYSTEM()) {
+		pfc_atomic_inc_uint64((uint64_t *)&hp->ph_nelems);
+	}
+	else {
+		pfc_atomic_inc_uint32((uint32_t *)&hp->ph_nelems);
+	}
+	PFC_ASSERT(hp->ph_nelems != 0);
+}
+
+/*
+ * static inline void
+ * pfc_hash_nelems_dec(pfc_hashtbl_t *hp, pfc_bool_t striped)
+ *	Decrement number of hash entries in the given table.
+ *	`striped' must be a value set by pfc_hash_updlock().
+ */
+static inline void
+pfc_hash_nelems_dec(pfc_hashtbl_t *hp, pfc_bool_t striped)
+{
+	PFC_ASSERT(hp->ph_nelems != 0);
+	if (!striped) {
+		hp->ph_nelems--;
+	}
+	else if (PFC_IS_LP64_SYSTEM()) {
+		pfc_atomic_dec_uint64((uint64_t *)&hp->ph_nelems);
+	}
+	else {
+		pfc_atomic_dec_uint32((uint32_t *)&hp->ph_nelems);
+	}
+}
+
+/*
+ * static inline pfc_bool_t
+ * pfc_hash_need_grow(pfc_hashtbl_t *hp)
+ *	Determine whether the given table should grow or not.
+ */
+static inline pfc_bool_t
+pfc_hash_need_grow(pfc_hashtbl_t *hp)
+{
+	return ((hp->ph_flags & PFC_HASH_AUTOGROW) &&
+		hp->ph_oldtable == NULL &&
+		hp->ph_nbuckets < PFC_HASH_MAX_NBUCKETS &&
+		hp->ph_nelems > (size_t)hp->ph_nbuckets * HASH_AUTOGROW_LOAD)
+		? PFC_TRUE : PFC_FALSE;
+}
+
 /*
  * static inline void
  * pfc_hash_ref(pfc_hashtbl_t *hp)
@@ -210,6 +366,7 @@ pfc_hash_unref(pfc_hashtbl_t *hp)
 #endif	/* PFC_VERBOSE_DEBUG */
 
 		if (!PFC_HASH_IS_LIST(hp)) {
+			free(hp->ph_stripes);
 			free(hp);
 		}
 	}
@@ -356,6 +513,24 @@ pfc_hash_gen_update(pfc_hashtbl_t *hp)
 	hp->ph_gen++;
 }
 
+/*
+ * static inline void
+ * pfc_hash_gen_update_striped(pfc_hashtbl_t *hp, pfc_bool_t striped)
+ *	Bump up generation number of the given hash table.
+ *	`striped' must be a value set by pfc_hash_updlock().
+ */
+static inline void
+pfc_hash_gen_update_striped(pfc_hashtbl_t *hp, pfc_bool_t striped)
+{
+	if (striped) {
+		/* Other threads may update other lock stripes. */
+		pfc_atomic_inc_uint32(&hp->ph_gen);
+	}
+	else {
+		pfc_hash_gen_update(hp);
+	}
+}
+
 /*
  * static inline void
  * pfc_hashiter_destroy(pfc_hashtbl_t *hp, hash_iter_t *iter, int cookie)
@@ -579,6 +754,7 @@ __pfc_hash_get(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 	pfc_hashtbl_t	*hp = (pfc_hashtbl_t *)hash;
 	pfc_hashent_t	**entpp, *entp;
 	pfc_refptr_t	rbuf;
+	pfc_mutex_t	*mp;
 	uint32_t	index;
 	const char	*strkey = NULL;
 	int	err = ENOENT, cookie;
@@ -635,6 +811,10 @@ __pfc_hash_get(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 		goto out;
 	}
 
+	/* Updaters of striped table may hold the table lock as reader. */
+	mp = (cookie && hp->ph_stripes != NULL)
+		? pfc_hash_stripe_lock(hp, index) : NULL;
+
 	/* Search for a key in the hash table. */
 	entpp = pfc_hash_lookup(hp, key, index);
 	if ((entp = *entpp) != NULL) {
@@ -645,6 +825,10 @@ __pfc_hash_get(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 		err = 0;
 	}
 
+	if (mp != NULL) {
+		pfc_mutex_unlock(mp);
+	}
+
 out:
 	pfc_hash_unlock(hp, cookie);
 
@@ -721,6 +905,8 @@ pfc_hash_get_capacity(pfc_hash_t hash)
  *	Change number of hash buckets.
  *	If PFC_HASH_PRIME attribute is set, number of hash buckets is adjusted
  *	to the largest prime number within the given number.
+ *	If the table is updated with striped bucket locks, number of hash
+ *	buckets is rounded up to a multiple of number of lock stripes.
  *
  * Calling/Exit State:
  *	Zero is returned on success.
@@ -737,6 +923,9 @@ pfc_hash_set_capacity(pfc_hash_t hash, uint32_t nbuckets)
 	if (hp->ph_flags & PFC_HASH_PRIME) {
 		nbuckets = pfc_hash_get_prime(nbuckets);
 	}
+	else if (hp->ph_stripes != NULL) {
+		nbuckets = PFC_POW2_ROUNDUP(nbuckets, PFC_HASH_NSTRIPES);
+	}
 	if (PFC_EXPECT_FALSE(nbuckets == 0 ||
 			     nbuckets > PFC_HASH_MAX_NBUCKETS)) {
 		return EINVAL;
@@ -754,17 +943,20 @@ pfc_hash_set_capacity(pfc_hash_t hash, uint32_t nbuckets)
 	/* Acquire writer lock if needed. */
 	cookie = pfc_hash_wrlock(hp);
 
-	if (nbuckets == hp->ph_nbuckets) {
-		/* Nothing to do. */
-		goto backout;
-	}
-
 	if (PFC_EXPECT_FALSE(hp->ph_table == NULL)) {
 		/* The table has been destroyed. */
 		err = EBADF;
 		goto backout;
 	}
 
+	/* Complete rehashing in progress. */
+	pfc_hash_rehash_finish_l(hp);
+
+	if (nbuckets == hp->ph_nbuckets) {
+		/* Nothing to do. */
+		goto backout;
+	}
+
 	/* Iterate current hash buckets. */
 	for (entpp = hp->ph_table; entpp < hp->ph_table + hp->ph_nbuckets;
 	     entpp++) {
@@ -826,8 +1018,12 @@ __pfc_hash_sync_begin(__pfc_syncblock_t *frame)
 	}
 
 	if (pfc_syncblock_enter(&hash_sync_frame, frame)) {
-		/* Acquire lock. */
-		if (PFC_SYNCBLOCK_IS_WRITE(frame)) {
+		/*
+		 * Acquire lock. Updaters of striped table hold the table lock
+		 * in reader mode, so reader block on striped table needs
+		 * writer mode.
+		 */
+		if (PFC_SYNCBLOCK_IS_WRITE(frame) || hp->ph_stripes != NULL) {
 			(void)pfc_rwlock_wrlock(&hp->ph_lock);
 		}
 		else {
@@ -897,6 +1093,9 @@ pfc_hashiter_get(pfc_hash_t hash)
 		return NULL;
 	}
 
+	/* Iterator walks only the current table. */
+	pfc_hash_rehash_finish_l(hp);
+
 	/* Initialize entry pointer. */
 	iter->phi_prev = NULL;
 	iter->phi_next = hp->ph_table;
@@ -1467,6 +1666,7 @@ pfc_hash_table_init(pfc_hash_t *PFC_RESTRICT hashp,
 {
 	pfc_hashtbl_t	*hp;
 	pfc_hashent_t	**table, **etable;
+	pfc_mutex_t	*stripes = NULL;
 	int	err;
 
 	PFC_ASSERT(hashp != NULL);
@@ -1476,6 +1676,15 @@ pfc_hash_table_init(pfc_hash_t *PFC_RESTRICT hashp,
 		nbuckets = pfc_hash_get_prime(nbuckets);
 	}
 
+	if (flags & (PFC_HASH_NOLOCK | PFC_HASH_PRIME | PFC_IHASH_LIST)) {
+		/* Striped bucket locks are not applicable. */
+		flags &= ~PFC_HASH_STRIPED;
+	}
+	else if (flags & PFC_HASH_STRIPED) {
+		/* The lock stripe must not depend on number of buckets. */
+		nbuckets = PFC_POW2_ROUNDUP(nbuckets, PFC_HASH_NSTRIPES);
+	}
+
 	if (PFC_EXPECT_FALSE(nbuckets == 0 ||
 			     nbuckets > PFC_HASH_MAX_NBUCKETS)) {
 		return EINVAL;
@@ -1505,6 +1714,26 @@ pfc_hash_table_init(pfc_hash_t *PFC_RESTRICT hashp,
 				goto error;
 			}
 		}
+
+		if (flags & PFC_HASH_STRIPED) {
+			pfc_mutex_t	*mp;
+
+			/* Initialize striped bucket locks. */
+			stripes = (pfc_mutex_t *)
+				malloc(sizeof(*stripes) * PFC_HASH_NSTRIPES);
+			if (PFC_EXPECT_FALSE(stripes == NULL)) {
+				err = ENOMEM;
+				goto error;
+			}
+
+			for (mp = stripes; mp < stripes + PFC_HASH_NSTRIPES;
+			     mp++) {
+				err = PFC_MUTEX_INIT(mp);
+				if (PFC_EXPECT_FALSE(err != 0)) {
+					goto error;
+				}
+			}
+		}
 	}
 
 	/* Allocate hash table. */
@@ -1520,10 +1749,16 @@ pfc_hash_table_init(pfc_hash_t *PFC_RESTRICT hashp,
 	}
 
 	hp->ph_table = table;
+	hp->ph_oldtable = NULL;
 	hp->ph_ops = ops;
 	hp->ph_kops = kops;
+	hp->ph_stripes = stripes;
 	hp->ph_nelems = 0;
 	hp->ph_nbuckets = nbuckets;
+	hp->ph_oldnbuckets = 0;
+	hp->ph_rehash_next = 0;
+	hp->ph_rehash_done = 0;
+	hp->ph_ngrows = 0;
 	hp->ph_flags = flags;
 	hp->ph_gen = 0;
 	hp->ph_refcnt = 1;
@@ -1540,6 +1775,7 @@ pfc_hash_table_init(pfc_hash_t *PFC_RESTRICT hashp,
 
 error:
 	if ((flags & PFC_IHASH_LIST) == 0) {
+		free(stripes);
 		free(hp);
 	}
 
@@ -1573,8 +1809,10 @@ pfc_hash_put_entry(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t key,
 {
 	pfc_hashtbl_t	*hp = (pfc_hashtbl_t *)hash;
 	pfc_hashent_t	**entpp, *newentp, *oldentp;
+	pfc_mutex_t	*mp = NULL;
 	uint32_t	index;
-	pfc_bool_t	replaced = PFC_FALSE;
+	pfc_bool_t	replaced = PFC_FALSE, striped, grow;
+	pfc_bool_t	finish = PFC_FALSE;
 	int	err = EEXIST, cookie;
 
 	if (hp->ph_kops != NULL) {
@@ -1602,7 +1840,7 @@ pfc_hash_put_entry(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t key,
 	index = pfc_hash_ops_hashfunc(hp, key);
 
 	/* Acquire writer lock if needed. */
-	cookie = pfc_hash_wrlock(hp);
+	cookie = pfc_hash_updlock(hp, &striped);
 
 	if (PFC_EXPECT_FALSE(hp->ph_table == NULL)) {
 		/* The table has been destroyed. */
@@ -1610,6 +1848,15 @@ pfc_hash_put_entry(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t key,
 		goto error;
 	}
 
+	if (hp->ph_oldtable != NULL) {
+		/* Move a few entries in old buckets to the current table. */
+		finish = pfc_hash_rehash_step(hp, striped);
+	}
+
+	if (striped) {
+		mp = pfc_hash_stripe_lock(hp, index);
+	}
+
 	/* Check to see whether the given key exists in the table. */
 	entpp = pfc_hash_lookup(hp, key, index);
 	if ((oldentp = *entpp) != NULL) {
@@ -1624,8 +1871,7 @@ pfc_hash_put_entry(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t key,
 		}
 	}
 	else {
-		hp->ph_nelems++;
-		PFC_ASSERT(hp->ph_nelems != 0);
+		pfc_hash_nelems_inc(hp, striped);
 	}
 
 	/* Enter new hash entry. */
@@ -1633,16 +1879,35 @@ pfc_hash_put_entry(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t key,
 	if (!replaced) {
 		pfc_hash_entry_ref(hp, newentp, 0);
 	}
-	pfc_hash_gen_update(hp);
+	pfc_hash_gen_update_striped(hp, striped);
+
+	if (mp != NULL) {
+		pfc_mutex_unlock(mp);
+	}
 
+	grow = pfc_hash_need_grow(hp);
 	pfc_hash_unlock(hp, cookie);
 
+	if (finish) {
+		pfc_hash_rehash_end(hp);
+	}
+	else if (grow) {
+		pfc_hash_grow(hp);
+	}
+
 	return 0;
 
 error:
+	if (mp != NULL) {
+		pfc_mutex_unlock(mp);
+	}
 	pfc_hash_unlock(hp, cookie);
 	free(newentp);
 
+	if (finish) {
+		pfc_hash_rehash_end(hp);
+	}
+
 	return err;
 }
 
@@ -1705,8 +1970,10 @@ pfc_hash_do_remove(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 	pfc_hashtbl_t	*hp = (pfc_hashtbl_t *)hash;
 	pfc_hashent_t	**entpp, *entp;
 	pfc_refptr_t	rbuf;
+	pfc_mutex_t	*mp;
 	uint32_t	index;
 	const char	*strkey = NULL;
+	pfc_bool_t	striped, finish = PFC_FALSE;
 	int	err = ENOENT, cookie;
 
 	if (hp->ph_kops != NULL) {
@@ -1753,7 +2020,7 @@ pfc_hash_do_remove(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 	}
 
 	/* Acquire writer lock if needed. */
-	cookie = pfc_hash_wrlock(hp);
+	cookie = pfc_hash_updlock(hp, &striped);
 
 	if (PFC_EXPECT_FALSE(hp->ph_table == NULL)) {
 		/* The table has been destroyed. */
@@ -1761,6 +2028,13 @@ pfc_hash_do_remove(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 		goto out;
 	}
 
+	if (hp->ph_oldtable != NULL) {
+		/* Move a few entries in old buckets to the current table. */
+		finish = pfc_hash_rehash_step(hp, striped);
+	}
+
+	mp = (striped) ? pfc_hash_stripe_lock(hp, index) : NULL;
+
 	/* Search for a key in the hash table. */
 	entpp = pfc_hash_lookup(hp, key, index);
 	if ((entp = *entpp) != NULL) {
@@ -1784,16 +2058,22 @@ pfc_hash_do_remove(pfc_hash_t PFC_RESTRICT hash, pfc_cptr_t PFC_RESTRICT key,
 		pfc_hash_entry_unref(hp, entp, options);
 		free(entp);
 
-		PFC_ASSERT(hp->ph_nelems != 0);
-		hp->ph_nelems--;
-
-		pfc_hash_gen_update(hp);
+		pfc_hash_nelems_dec(hp, striped);
+		pfc_hash_gen_update_striped(hp, striped);
 		err = 0;
 	}
 
+	if (mp != NULL) {
+		pfc_mutex_unlock(mp);
+	}
+
 out:
 	pfc_hash_unlock(hp, cookie);
 
+	if (finish) {
+		pfc_hash_rehash_end(hp);
+	}
+
 	return err;
 }
 
@@ -1892,14 +2172,18 @@ pfc_hash_entry_alloc(pfc_cptr_t key, pfc_cptr_t value, uint32_t opflags)
 
 /*
  * static pfc_hashent_t **
- * pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t index)
+ * pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t hval)
  *	Search for a hash entry that has the given key in the hash table.
- *	The caller must specify result of pfc_hash_ops_hashfunc() to `index'.
+ *	The caller must specify result of pfc_hash_ops_hashfunc() to `hval'.
+ *
+ *	If the table is being rehashed, the old bucket associated with
+ *	`hval' is also searched.
  *
  * Calling/Exit State:
  *	Pointer which contains pointer to hash entry is returned.
  *	If found, a valid pointer to hash entry is contained in returned
- *	address. If not found, NULL is contained in returned address.
+ *	address. If not found, NULL is contained in returned address, which
+ *	is the tail of the bucket chain in the current table.
  *	Modifying pointer in returned address affects the hash table.
  *
  * Remarks:
@@ -1907,23 +2191,48 @@ pfc_hash_entry_alloc(pfc_cptr_t key, pfc_cptr_t value, uint32_t opflags)
  *	by the caller.
  */
 static pfc_hashent_t **
-pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t index)
+pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t hval)
 {
-	pfc_hashent_t	**entpp;
+	pfc_hashent_t	**entpp, **oldpp;
+
+	entpp = pfc_hash_lookup_chain(hp, hp->ph_table +
+				      (hval % hp->ph_nbuckets), key);
+	if (*entpp == NULL && hp->ph_oldtable != NULL) {
+		oldpp = pfc_hash_lookup_chain(hp, hp->ph_oldtable +
+					      (hval % hp->ph_oldnbuckets),
+					      key);
+		if (*oldpp != NULL) {
+			return oldpp;
+		}
+	}
 
-	index %= hp->ph_nbuckets;
+	return entpp;
+}
 
+/*
+ * static pfc_hashent_t **
+ * pfc_hash_lookup_chain(pfc_hashtbl_t *hp, pfc_hashent_t **entpp,
+ *			 pfc_cptr_t key)
+ *	Search for a hash entry that has the given key in the bucket chain
+ *	specified by `entpp'.
+ *
+ * Calling/Exit State:
+ *	Pointer which contains pointer to hash entry is returned.
+ *	If not found, NULL is contained in returned address.
+ */
+static pfc_hashent_t **
+pfc_hash_lookup_chain(pfc_hashtbl_t *hp, pfc_hashent_t **entpp,
+		      pfc_cptr_t key)
+{
 	if (hp->ph_kops != NULL) {
-		return pfc_hash_lookup_refptr(hp, (pfc_refptr_t *)key, index);
+		return pfc_hash_lookup_refptr(hp, entpp, (pfc_refptr_t *)key);
 	}
-	else {
-		for (entpp = hp->ph_table + index; *entpp != NULL;
-		     entpp = &((*entpp)->phe_next)) {
-			pfc_hashent_t	*entp = *entpp;
 
-			if (pfc_hash_ops_equals(hp, key, entp->phe_key)) {
-				break;
-			}
+	for (; *entpp != NULL; entpp = &((*entpp)->phe_next)) {
+		pfc_hashent_t	*entp = *entpp;
+
+		if (pfc_hash_ops_equals(hp, key, entp->phe_key)) {
+			break;
 		}
 	}
 
@@ -1932,8 +2241,10 @@ pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t index)
 
 /*
  * static pfc_hashent_t **
- * pfc_hash_lookup_refptr(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t index)
- *	Search for a hash entry that has the given refptr key in the hash table.
+ * pfc_hash_lookup_refptr(pfc_hashtbl_t *hp, pfc_hashent_t **entpp,
+ *			  pfc_refptr_t *key)
+ *	Search for a hash entry that has the given refptr key in the bucket
+ *	chain specified by `entpp'.
  *
  * Calling/Exit State:
  *	Pointer which contains pointer to hash entry is returned.
@@ -1942,21 +2253,20 @@ pfc_hash_lookup(pfc_hashtbl_t *hp, pfc_cptr_t key, uint32_t index)
  *	Modifying pointer in returned address affects the hash table.
  *
  * Remarks:
- *	pfc_hash_lookup_refptr() is an internal function of pfc_hash_lookup(),
- *	and it is called if the hash table is refptr hash.
+ *	pfc_hash_lookup_refptr() is an internal function of
+ *	pfc_hash_lookup_chain(), and it is called if the hash table is
+ *	refptr hash.
  */
 static pfc_hashent_t **
-pfc_hash_lookup_refptr(pfc_hashtbl_t *hp, pfc_refptr_t *key, uint32_t index)
+pfc_hash_lookup_refptr(pfc_hashtbl_t *hp, pfc_hashent_t **entpp,
+		       pfc_refptr_t *key)
 {
-	pfc_hashent_t	**entpp;
-
 	if (key == NULL) {
 		/*
 		 * NULL key must be processed separately in order to
 		 * distinguish NULL key from NULL object in refptr.
 		 */
-		for (entpp = hp->ph_table + index; *entpp != NULL;
-		     entpp = &((*entpp)->phe_next)) {
+		for (; *entpp != NULL; entpp = &((*entpp)->phe_next)) {
 			pfc_hashent_t	*entp = *entpp;
 
 			if (entp->phe_key == NULL) {
@@ -1968,8 +2278,7 @@ pfc_hash_lookup_refptr(pfc_hashtbl_t *hp, pfc_refptr_t *key, uint32_t index)
 		pfc_cptr_t	k = PFC_REFPTR_VALUE(key, pfc_cptr_t);
 
 		/* We need to use hash function in refptr operation. */
-		for (entpp = hp->ph_table + index; *entpp != NULL;
-		     entpp = &((*entpp)->phe_next)) {
+		for (; *entpp != NULL; entpp = &((*entpp)->phe_next)) {
 			pfc_hashent_t	*entp = *entpp;
 			pfc_refptr_t	*r = (pfc_refptr_t *)entp->phe_key;
 			pfc_cptr_t	rk;
@@ -1996,7 +2305,6 @@ pfc_hash_lookup_refptr(pfc_hashtbl_t *hp, pfc_refptr_t *key, uint32_t index)
 static size_t
 pfc_hash_clear_l(pfc_hashtbl_t *hp)
 {
-	pfc_hashent_t	**entpp;
 	size_t		nelems;
 
 	if (PFC_EXPECT_FALSE(hp->ph_table == NULL)) {
@@ -2005,8 +2313,35 @@ pfc_hash_clear_l(pfc_hashtbl_t *hp)
 
 	/* Iterate hash buckets. */
 	nelems = hp->ph_nelems;
-	for (entpp = hp->ph_table; entpp < hp->ph_table + hp->ph_nbuckets;
-	     entpp++) {
+	pfc_hash_clear_buckets(hp, hp->ph_table, hp->ph_nbuckets);
+	if (hp->ph_oldtable != NULL) {
+		/* Entries in old buckets need to be removed too. */
+		pfc_hash_clear_buckets(hp, hp->ph_oldtable,
+				       hp->ph_oldnbuckets);
+		pfc_hash_rehash_free_l(hp);
+	}
+	pfc_hash_gen_update(hp);
+
+	hp->ph_nelems = 0;
+
+	return nelems;
+}
+
+/*
+ * static void
+ * pfc_hash_clear_buckets(pfc_hashtbl_t *PFC_RESTRICT hp,
+ *			  pfc_hashent_t **PFC_RESTRICT table,
+ *			  uint32_t nbuckets)
+ *	Remove all hash entries in the given hash buckets.
+ *	This is an internal function of pfc_hash_clear_l().
+ */
+static void
+pfc_hash_clear_buckets(pfc_hashtbl_t *PFC_RESTRICT hp,
+		       pfc_hashent_t **PFC_RESTRICT table, uint32_t nbuckets)
+{
+	pfc_hashent_t	**entpp;
+
+	for (entpp = table; entpp < table + nbuckets; entpp++) {
 		pfc_hashent_t	*entp, *next;
 
 		for (entp = *entpp; entp != NULL; entp = next) {
@@ -2022,11 +2357,220 @@ pfc_hash_clear_l(pfc_hashtbl_t *hp)
 		}
 		*entpp = NULL;
 	}
+}
+
+/*
+ * static void
+ * pfc_hash_grow(pfc_hashtbl_t *hp)
+ *	Start growth of the hash table created with PFC_HASH_AUTOGROW.
+ *
+ *	This function only installs a new bucket array. Entries in old buckets
+ *	are moved to the new buckets by subsequent updates of the table.
+ *
+ * Remarks:
+ *	This function must be called without holding the hash table lock.
+ */
+static void
+pfc_hash_grow(pfc_hashtbl_t *hp)
+{
+	pfc_hashent_t	**table;
+	uint32_t	nbuckets = hp->ph_nbuckets, newsize;
+	int		cookie;
+
+	newsize = (nbuckets > (PFC_HASH_MAX_NBUCKETS >> 1))
+		? PFC_HASH_MAX_NBUCKETS : (nbuckets << 1);
+	if (hp->ph_flags & PFC_HASH_PRIME) {
+		newsize = pfc_hash_get_prime(newsize);
+	}
+	if (newsize <= nbuckets) {
+		return;
+	}
+
+	/* Growth will be retried by the next insertion on failure. */
+	table = (pfc_hashent_t **)calloc(newsize, sizeof(pfc_hashent_t *));
+	if (PFC_EXPECT_FALSE(table == NULL)) {
+		return;
+	}
+
+	cookie = pfc_hash_wrlock(hp);
+
+	if (PFC_EXPECT_FALSE(hp->ph_table == NULL ||
+			     hp->ph_nbuckets != nbuckets ||
+			     !pfc_hash_need_grow(hp))) {
+		/* Another thread has changed the table. */
+		pfc_hash_unlock(hp, cookie);
+		free(table);
+
+		return;
+	}
+
+	hp->ph_oldtable = hp->ph_table;
+	hp->ph_oldnbuckets = nbuckets;
+	hp->ph_rehash_next = 0;
+	hp->ph_rehash_done = 0;
+	hp->ph_table = table;
+	hp->ph_nbuckets = newsize;
+	hp->ph_ngrows++;
 	pfc_hash_gen_update(hp);
 
-	hp->ph_nelems = 0;
+	pfc_hash_unlock(hp, cookie);
+}
 
-	return nelems;
+/*
+ * static pfc_bool_t
+ * pfc_hash_rehash_step(pfc_hashtbl_t *hp, pfc_bool_t striped)
+ *	Move entries in at most HASH_REHASH_STEP old buckets to the current
+ *	table. `striped' must be a value set by pfc_hash_updlock().
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if the caller has rehashed the last old bucket
+ *	with striped bucket locks. In that case the caller must call
+ *	pfc_hash_rehash_end() after releasing the hash table lock.
+ *	Otherwise PFC_FALSE is returned.
+ *
+ * Remarks:
+ *	This function must be called without holding any lock stripe.
+ */
+static pfc_bool_t
+pfc_hash_rehash_step(pfc_hashtbl_t *hp, pfc_bool_t striped)
+{
+	const uint32_t	oldnbuckets = hp->ph_oldnbuckets;
+	uint32_t	i, index;
+
+	if (!striped) {
+		for (i = 0; i < HASH_REHASH_STEP &&
+			     hp->ph_rehash_next < oldnbuckets; i++) {
+			pfc_hash_rehash_bucket(hp, hp->ph_rehash_next);
+			hp->ph_rehash_next++;
+		}
+
+		/*
+		 * No other thread rehashes old buckets while we hold the
+		 * table in writer mode.
+		 */
+		if (hp->ph_rehash_next >= oldnbuckets) {
+			pfc_hash_rehash_free_l(hp);
+		}
+		else {
+			hp->ph_rehash_done = hp->ph_rehash_next;
+		}
+
+		return PFC_FALSE;
+	}
+
+	for (i = 0; i < HASH_REHASH_STEP; i++) {
+		pfc_mutex_t	*mp;
+
+		if (hp->ph_rehash_next >= oldnbuckets) {
+			break;
+		}
+
+		/* Claim an old bucket. */
+		index = pfc_atomic_inc_uint32_old(&hp->ph_rehash_next);
+		if (index >= oldnbuckets) {
+			break;
+		}
+
+		/*
+		 * All entries in the old bucket and their new buckets are
+		 * protected by the same lock stripe.
+		 */
+		mp = pfc_hash_stripe_lock(hp, index);
+		pfc_hash_rehash_bucket(hp, index);
+		pfc_mutex_unlock(mp);
+
+		if (pfc_atomic_inc_uint32_old(&hp->ph_rehash_done) ==
+		    oldnbuckets - 1) {
+			return PFC_TRUE;
+		}
+	}
+
+	return PFC_FALSE;
+}
+
+/*
+ * static void
+ * pfc_hash_rehash_bucket(pfc_hashtbl_t *hp, uint32_t index)
+ *	Move all entries in the old bucket specified by `index' to the
+ *	current table.
+ */
+static void
+pfc_hash_rehash_bucket(pfc_hashtbl_t *hp, uint32_t index)
+{
+	pfc_hashent_t	**entpp = hp->ph_oldtable + index;
+	pfc_hashent_t	*entp, *next;
+
+	for (entp = *entpp; entp != NULL; entp = next) {
+		pfc_hashent_t	**newentpp;
+
+		next = entp->phe_next;
+		newentpp = hp->ph_table +
+			(pfc_hash_ops_hashfunc(hp, entp->phe_key) %
+			 hp->ph_nbuckets);
+		entp->phe_next = *newentpp;
+		*newentpp = entp;
+	}
+	*entpp = NULL;
+}
+
+/*
+ * static void
+ * pfc_hash_rehash_free_l(pfc_hashtbl_t *hp)
+ *	Release old buckets.
+ *	The caller must hold writer lock of the hash table if needed.
+ */
+static void
+pfc_hash_rehash_free_l(pfc_hashtbl_t *hp)
+{
+	free(hp->ph_oldtable);
+	hp->ph_oldtable = NULL;
+	hp->ph_oldnbuckets = 0;
+	hp->ph_rehash_next = 0;
+	hp->ph_rehash_done = 0;
+}
+
+/*
+ * static void
+ * pfc_hash_rehash_finish_l(pfc_hashtbl_t *hp)
+ *	Complete rehashing in progress.
+ *	The caller must hold writer lock of the hash table if needed.
+ */
+static void
+pfc_hash_rehash_finish_l(pfc_hashtbl_t *hp)
+{
+	uint32_t	index;
+
+	if (hp->ph_oldtable == NULL) {
+		return;
+	}
+
+	for (index = hp->ph_rehash_next; index < hp->ph_oldnbuckets;
+	     index++) {
+		pfc_hash_rehash_bucket(hp, index);
+	}
+	pfc_hash_rehash_free_l(hp);
+}
+
+/*
+ * static void
+ * pfc_hash_rehash_end(pfc_hashtbl_t *hp)
+ *	Release old buckets after all of them have been rehashed with
+ *	striped bucket locks.
+ *
+ * Remarks:
+ *	This function must be called without holding the hash table lock.
+ */
+static void
+pfc_hash_rehash_end(pfc_hashtbl_t *hp)
+{
+	int	cookie;
+
+	cookie = pfc_hash_wrlock(hp);
+	if (hp->ph_oldtable != NULL &&
+	    hp->ph_rehash_done == hp->ph_oldnbuckets) {
+		pfc_hash_rehash_free_l(hp);
+	}
+	pfc_hash_unlock(hp, cookie);
 }
 
 /*
@@ -2171,6 +2715,7 @@ static const char	str_ratio[] = "Ratio";
 static const char	str_nentries[] = "Number of Entries";
 static const char	str_index[] = "Index";
 static const char	str_sum_entries[] = "Sum of Entries";
+static const char	str_old_buckets[] = "Buckets Being Rehashed";
 
 /*
  * static void
@@ -2205,6 +2750,47 @@ hash_report_print_header(FILE *fp)
 	putc('\n', fp);
 }
 
+/*
+ * static uint32_t
+ * hash_report_print_buckets(FILE *PFC_RESTRICT fp,
+ *			     pfc_hashent_t **PFC_RESTRICT table,
+ *			     uint32_t nbuckets, uint32_t nelems, uint32_t sum)
+ *	Print length of all bucket chains in the given hash buckets.
+ *	`sum' is the number of entries printed so far.
+ *
+ * Calling/Exit State:
+ *	Number of entries printed so far is returned.
+ */
+static uint32_t
+hash_report_print_buckets(FILE *PFC_RESTRICT fp,
+			  pfc_hashent_t **PFC_RESTRICT table,
+			  uint32_t nbuckets, uint32_t nelems, uint32_t sum)
+{
+	pfc_hashent_t	**entpp;
+	uint32_t	index;
+
+	for (index = 0, entpp = table; entpp < table + nbuckets;
+	     index++, entpp++) {
+		pfc_hashent_t	*entp;
+		uint32_t	count;
+
+		for (count = 0, entp = *entpp; entp != NULL;
+		     count++, entp = entp->phe_next);
+		sum += count;
+		fprintf(fp, "%*s%*u %*u (%*.3f %%) %*u (%*.3f %%)\n",
+			HASH_REPCOL_INDENT, str_empty,
+			HASH_REPCOL_INDEX, index,
+			HASH_REPCOL_LENGTH, count,
+			HASH_REPCOL_RATE,
+			HASH_STATE_PERCENT(count, nelems),
+			HASH_REPCOL_SUM, sum,
+			HASH_REPCOL_RATE,
+			HASH_STATE_PERCENT(sum, nelems));
+	}
+
+	return sum;
+}
+
 /*
  * void
  * pfc_hash_report(pfc_hash_t hash)
@@ -2215,11 +2801,10 @@ void
 pfc_hash_report(pfc_hash_t PFC_RESTRICT hash, FILE *PFC_RESTRICT fp)
 {
 	pfc_hashtbl_t	*hp = (pfc_hashtbl_t *)hash;
-	pfc_hashent_t	**entpp;
-	uint32_t	index, nelems, sum;
+	uint32_t	nelems, sum;
 	int	cookie;
 
-	cookie = pfc_hash_rdlock(hp);
+	cookie = pfc_hash_scanlock(hp);
 
 	sum = 0;
 	nelems = (uint32_t)hp->ph_nelems;
@@ -2228,23 +2813,16 @@ pfc_hash_report(pfc_hash_t PFC_RESTRICT hash, FILE *PFC_RESTRICT fp)
 
 	if (nelems != 0) {
 		hash_report_print_header(fp);
-		for (index = 0, entpp = hp->ph_table;
-		     entpp < hp->ph_table + hp->ph_nbuckets; index++, entpp++) {
-			pfc_hashent_t	*entp;
-			uint32_t	count;
-
-			for (count = 0, entp = *entpp; entp != NULL;
-			     count++, entp = entp->phe_next);
-			sum += count;
-			fprintf(fp, "%*s%*u %*u (%*.3f %%) %*u (%*.3f %%)\n",
-				HASH_REPCOL_INDENT, str_empty,
-				HASH_REPCOL_INDEX, index,
-				HASH_REPCOL_LENGTH, count,
-				HASH_REPCOL_RATE,
-				HASH_STATE_PERCENT(count, nelems),
-				HASH_REPCOL_SUM, sum,
-				HASH_REPCOL_RATE,
-				HASH_STATE_PERCENT(sum, nelems));
+		sum = hash_report_print_buckets(fp, hp->ph_table,
+						hp->ph_nbuckets, nelems, sum);
+		if (hp->ph_oldtable != NULL) {
+			fprintf(fp, "\n%*s%s: %u\n", HASH_REPCOL_INDENT,
+				str_empty, str_old_buckets,
+				hp->ph_oldnbuckets);
+			hash_report_print_header(fp);
+			(void)hash_report_print_buckets(fp, hp->ph_oldtable,
+							hp->ph_oldnbuckets,
+							nelems, sum);
 		}
 	}
 
@@ -2500,7 +3078,7 @@ pfc_hash_report_summary(pfc_hash_t PFC_RESTRICT hash, FILE *PFC_RESTRICT fp,
 	uint32_t	nelems, empty, nbuckets;
 	int	cookie;
 
-	cookie = pfc_hash_rdlock(hp);
+	cookie = pfc_hash_scanlock(hp);
 
 	nelems = (uint32_t)hp->ph_nelems;
 	nbuckets = hp->ph_nbuckets;
@@ -2552,6 +3130,25 @@ pfc_hash_report_summary(pfc_hash_t PFC_RESTRICT hash, FILE *PFC_RESTRICT fp,
 		}
 	}
 
+	if (hp->ph_oldtable != NULL) {
+		pfc_hashent_t	**oldtable = hp->ph_oldtable;
+
+		/* Old buckets being rehashed are also summarized. */
+		for (entpp = oldtable;
+		     entpp < oldtable + hp->ph_oldnbuckets; entpp++) {
+			pfc_hashent_t	*entp;
+			uint32_t	count;
+
+			for (count = 0, entp = *entpp; entp != NULL;
+			     count++, entp = entp->phe_next);
+
+			if (count != 0) {
+				hash_summary_push(&larger, count, PFC_TRUE);
+				hash_summary_push(&smaller, count, PFC_FALSE);
+			}
+		}
+	}
+
 	fprintf(fp, "    - %*s:  %u (%7.3f %%)\n",
 		-HASH_SUMCOL_LABEL, "Empty Buckets",
 		empty, HASH_STATE_PERCENT(empty, nbuckets));
@@ -2608,3 +3205,80 @@ out:
 	hash_summary_free(&larger);
 	hash_summary_free(&smaller);
 }
+
+/*
+ * int
+ * pfc_hash_get_stats(pfc_hash_t PFC_RESTRICT hash,
+ *		      pfc_hash_stats_t *PFC_RESTRICT statsp)
+ *	Store statistics of the specified hash table to the buffer pointed
+ *	by `statsp'.
+ *
+ *	Bucket chains in old buckets being rehashed are also taken into
+ *	account of `phs_maxchain'.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	EBADF is returned if the table has been destroyed.
+ */
+int
+pfc_hash_get_stats(pfc_hash_t PFC_RESTRICT hash,
+		   pfc_hash_stats_t *PFC_RESTRICT statsp)
+{
+	pfc_hashtbl_t	*hp = (pfc_hashtbl_t *)hash;
+	pfc_hashent_t	**entpp, **table;
+	uint32_t	nbuckets, empty = 0, maxchain = 0;
+	int	cookie, err = 0;
+
+	cookie = pfc_hash_scanlock(hp);
+
+	if (PFC_EXPECT_FALSE(hp->ph_table == NULL)) {
+		/* The table has been destroyed. */
+		err = EBADF;
+		goto out;
+	}
+
+	table = hp->ph_table;
+	nbuckets = hp->ph_nbuckets;
+	for (entpp = table; entpp < table + nbuckets; entpp++) {
+		pfc_hashent_t	*entp;
+		uint32_t	count;
+
+		for (count = 0, entp = *entpp; entp != NULL;
+		     count++, entp = entp->phe_next);
+		if (count == 0) {
+			empty++;
+		}
+		else if (count > maxchain) {
+			maxchain = count;
+		}
+	}
+
+	statsp->phs_rehashing = 0;
+	if ((table = hp->ph_oldtable) != NULL) {
+		for (entpp = table; entpp < table + hp->ph_oldnbuckets;
+		     entpp++) {
+			pfc_hashent_t	*entp;
+			uint32_t	count;
+
+			for (count = 0, entp = *entpp; entp != NULL;
+			     count++, entp = entp->phe_next);
+			if (count > maxchain) {
+				maxchain = count;
+			}
+		}
+		statsp->phs_rehashing = hp->ph_oldnbuckets -
+			hp->ph_rehash_done;
+	}
+
+	statsp->phs_nelems = hp->ph_nelems;
+	statsp->phs_load = (double)hp->ph_nelems / (double)nbuckets;
+	statsp->phs_nbuckets = nbuckets;
+	statsp->phs_empty = empty;
+	statsp->phs_maxchain = maxchain;
+	statsp->phs_ngrows = hp->ph_ngrows;
+
+out:
+	pfc_hash_unlock(hp, cookie);
+
+	return err;
+}
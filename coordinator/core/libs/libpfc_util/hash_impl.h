@@ -48,17 +48,30 @@ struct pfc_hashent {
  */
 typedef struct {
 	pfc_hashent_t		**ph_table;	/* hash table */
+	pfc_hashent_t		**ph_oldtable;	/* table being rehashed */
 	const pfc_hash_ops_t	*ph_ops;	/* hash table operations */
 	const pfc_refptr_ops_t	*ph_kops;	/* refptr ops for hash key */
+	pfc_mutex_t		*ph_stripes;	/* striped bucket locks */
 	size_t			ph_nelems;	/* number of elements */
 	pfc_list_t		ph_iterator;	/* iterator list */
 	pfc_rwlock_t		ph_lock;	/* table lock */
 	uint32_t		ph_nbuckets;	/* number of hash buckets */
+	uint32_t		ph_oldnbuckets;	/* number of old buckets */
+	uint32_t		ph_rehash_next;	/* next old bucket to rehash */
+	uint32_t		ph_rehash_done;	/* number of rehashed buckets */
+	uint32_t		ph_ngrows;	/* number of automatic growth */
 	uint32_t		ph_flags;	/* hash table attributes */
 	uint32_t		ph_gen;		/* generation number */
 	uint32_t		ph_refcnt;	/* reference counter */
 } pfc_hashtbl_t;
 
+/*
+ * Number of striped bucket locks in a table created with PFC_HASH_STRIPED.
+ * Number of hash buckets in such table is always a multiple of this value,
+ * so the lock stripe of a hash value does not change on rehash.
+ */
+#define	PFC_HASH_NSTRIPES	PFC_CONST_U(16)
+
 /*
  * Element of the hash list.
  */
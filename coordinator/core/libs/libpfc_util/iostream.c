@@ -44,6 +44,12 @@ typedef struct {
  */
 #define	IOBUF_IS_EMPTY(bp)	((bp)->io_top == (bp)->io_bottom)
 
+/*
+ * Maximum number of file descriptors queued in a stream which passes
+ * file descriptors.
+ */
+#define	IOSTREAM_FDQ_SIZE	4U
+
 /*
  * Buffered input/output stream.
  */
@@ -59,6 +65,9 @@ struct __pfc_iostream {
 	int			s_cancel;	/* cancel event FD */
 	uint32_t		s_flags;	/* flags */
 	volatile pfc_bool_t	s_busy;		/* busy flag */
+	uint32_t		s_fdhead;	/* head of s_fdq */
+	uint32_t		s_fdcount;	/* number of FDs in s_fdq */
+	int			s_fdq[IOSTREAM_FDQ_SIZE];	/* received FDs */
 };
 
 #define	IOSTREAM_LOCK(stream)		pfc_mutex_lock(&(stream)->s_mutex)
@@ -81,6 +90,7 @@ struct __pfc_iostream {
 #define	IOSTRF_SHUT_WR	PFC_CONST_U(0x8)	/* write shut down */
 #define	IOSTRF_DESROYED	PFC_CONST_U(0x10)	/* destroyed */
 #define	IOSTRF_SOCKET	PFC_CONST_U(0x20)	/* socket based stream */
+#define	IOSTRF_PASSFD	PFC_CONST_U(0x40)	/* receive FDs */
 
 #define	IOSTREAM_IS_RD_SHUTDOWN(stream)				\
 	((stream)->s_flags & (IOSTRF_EOF | IOSTRF_SHUT_RD))
@@ -251,6 +261,24 @@ typedef struct {
 #define	CMSG_CTX_CREDCTX(ctx)					\
 	PFC_CAST_CONTAINER((ctx), cmsg_credctx_t, cmc_context)
 
+/*
+ * Context to send a file descriptor.
+ */
+typedef struct {
+	cmsg_ctx_t	cmf_context;		/* control message context */
+	int		cmf_fd;			/* file descriptor to be sent */
+} cmsg_fdctx_t;
+
+#define	CMSG_FDCTX_INIT(fctx, stream, buf, sizep, fd, abstime)		\
+	do {								\
+		CMSG_CTX_INIT(&(fctx)->cmf_context, stream, buf,	\
+			      sizep, abstime, &iostream_cmfd_ops, 0);	\
+		(fctx)->cmf_fd = (fd);					\
+	} while (0)
+
+#define	CMSG_CTX_FDCTX(ctx)					\
+	PFC_CAST_CONTAINER((ctx), cmsg_fdctx_t, cmf_context)
+
 /*
  * Determine whether the internal logging is enabled or not.
  */
@@ -320,6 +348,11 @@ static void	iostream_cmcred_setup(cmsg_ctx_t *ctx);
 static void	iostream_cmcred_fetch(cmsg_ctx_t *ctx);
 static int	iostream_cmcred_fetch_prepare(cmsg_ctx_t *ctx);
 static int	iostream_cmcred_fetch_cleanup(cmsg_ctx_t *ctx);
+static size_t	iostream_cmfd_size(cmsg_ctx_t *ctx);
+static void	iostream_cmfd_setup(cmsg_ctx_t *ctx);
+static ssize_t	iostream_recv_passfd(pfc_iostream_t PFC_RESTRICT stream,
+				     uint8_t *PFC_RESTRICT buf, size_t size);
+static void	iostream_fdq_clear(pfc_iostream_t stream);
 static int	iostream_getpollerr(pfc_iostream_t stream, int fd,
 				    short events, short revents);
 static int	iostream_getsockerr(int sock);
@@ -335,6 +368,16 @@ static cmsg_cops_t		iostream_cmcred_ops = {
 	.cmops_fetch_cleanup	= iostream_cmcred_fetch_cleanup,
 };
 
+/*
+ * Operations to send a file descriptor via control message.
+ * File descriptors are received by the stream which passes file descriptors,
+ * so no fetch operation is defined.
+ */
+static cmsg_cops_t		iostream_cmfd_ops = {
+	.cmops_size		= iostream_cmfd_size,
+	.cmops_setup		= iostream_cmfd_setup,
+};
+
 /*
  * static inline void PFC_FATTR_ALWAYS_INLINE
  * iostream_close_fd(int fd, const char *label)
@@ -650,6 +693,8 @@ pfc_iostream_create(pfc_iostream_t *PFC_RESTRICT streamp, int fd,
 	iop->s_fd = fd;
 	iop->s_cancel = -1;
 	iop->s_busy = PFC_FALSE;
+	iop->s_fdhead = 0;
+	iop->s_fdcount = 0;
 	*streamp = iop;
 
 	return 0;
@@ -715,6 +760,7 @@ pfc_iostream_destroy(pfc_iostream_t stream)
 	IOSTREAM_BROADCAST(stream);
 	IOSTREAM_UNLOCK(stream);
 
+	iostream_fdq_clear(stream);
 	iostream_buffer_free(&stream->s_input);
 	iostream_buffer_free(&stream->s_output);
 	free((void *)stream->s_sigmask);
@@ -752,6 +798,7 @@ void
 __pfc_iostream_dispose(pfc_iostream_t stream)
 {
 	(void)iostream_close(stream, "dispose");
+	iostream_fdq_clear(stream);
 	iostream_buffer_free(&stream->s_input);
 	iostream_buffer_free(&stream->s_output);
 	free((void *)stream->s_sigmask);
@@ -1443,6 +1490,8 @@ __pfc_iostream_setfd(pfc_iostream_t stream, int newfd)
 	IOSTREAM_LOCK(stream);
 
 	if (PFC_EXPECT_TRUE(!stream->s_busy)) {
+		/* Received FDs belong to the old connection. */
+		iostream_fdq_clear(stream);
 		stream->s_fd = newfd;
 		err = 0;
 	}
@@ -1764,6 +1813,155 @@ __pfc_iostream_recvcred_abs(pfc_iostream_t PFC_RESTRICT stream,
 	return iostream_recvmsg(&crctx.cmc_context);
 }
 
+/*
+ * int
+ * __pfc_iostream_passfd(pfc_iostream_t stream)
+ *	Let the specified stream receive file descriptors.
+ *
+ *	Once this function succeeds, file descriptors sent by
+ *	__pfc_iostream_sendfd_abs() are kept in the stream when the data
+ *	which carries them is read, instead of being discarded.
+ *	They can be fetched by __pfc_iostream_recvfd() in the order they
+ *	were sent.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	ENOTSOCK is returned if the stream is not associated with a socket.
+ *
+ * Remarks:
+ *	This is not public interface.
+ */
+int
+__pfc_iostream_passfd(pfc_iostream_t stream)
+{
+	int	err;
+
+	IOSTREAM_LOCK(stream);
+
+	if (PFC_EXPECT_TRUE(IOSTREAM_IS_SOCKET(stream))) {
+		stream->s_flags |= IOSTRF_PASSFD;
+		err = 0;
+	}
+	else {
+		err = ENOTSOCK;
+	}
+
+	IOSTREAM_UNLOCK(stream);
+
+	return err;
+}
+
+/*
+ * int
+ * __pfc_iostream_sendfd_abs(pfc_iostream_t PFC_RESTRICT stream,
+ *			     const void *PFC_RESTRICT buf,
+ *			     size_t *PFC_RESTRICT sizep, int fd,
+ *			     const pfc_timespec_t *PFC_RESTRICT abstime)
+ *	Write arbitrary data to the specified output stream, and send the
+ *	file descriptor specified by `fd' with it.
+ *
+ *	A file descriptor associated with `stream' must be an UNIX domain
+ *	stream socket, which is already connected. The other side of the
+ *	socket must enable file descriptor passing by
+ *	__pfc_iostream_passfd().
+ *
+ *	If `abstime' is not NULL, ETIMEDOUT is returned if the absolute time
+ *	specified by `abstime' passes. NULL means an infinite timeout.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, zero is returned.
+ *	Otherwise error number which indicates the cause of error is returned.
+ *
+ *	Irrespective of the result, `*sizep' contains the number of bytes
+ *	actually written.
+ *
+ * Remarks:
+ *	- `fd' is never closed by this function.
+ *
+ *	- This function may flush any data in output buffer before sending
+ *	  data and file descriptor.
+ */
+int
+__pfc_iostream_sendfd_abs(pfc_iostream_t PFC_RESTRICT stream,
+			  const void *PFC_RESTRICT buf,
+			  size_t *PFC_RESTRICT sizep, int fd,
+			  const pfc_timespec_t *PFC_RESTRICT abstime)
+{
+	cmsg_fdctx_t	fctx;
+
+	CMSG_FDCTX_INIT(&fctx, stream, buf, sizep, fd, abstime);
+
+	return iostream_sendmsg(&fctx.cmf_context);
+}
+
+/*
+ * int
+ * __pfc_iostream_recvfd(pfc_iostream_t PFC_RESTRICT stream,
+ *			 int *PFC_RESTRICT fdp)
+ *	Fetch the oldest file descriptor received by the specified stream.
+ *
+ *	The data which carried the file descriptor must be read in advance.
+ *
+ * Calling/Exit State:
+ *	Upon successful completion, the file descriptor is set to `*fdp',
+ *	and zero is returned. The caller must close it.
+ *	ENOENT is returned if no file descriptor has been received.
+ *
+ * Remarks:
+ *	This is not public interface.
+ */
+int
+__pfc_iostream_recvfd(pfc_iostream_t PFC_RESTRICT stream,
+		      int *PFC_RESTRICT fdp)
+{
+	int	err;
+
+	IOSTREAM_LOCK(stream);
+
+	if (PFC_EXPECT_TRUE(stream->s_fdcount != 0)) {
+		*fdp = stream->s_fdq[stream->s_fdhead];
+		stream->s_fdhead = (stream->s_fdhead + 1) % IOSTREAM_FDQ_SIZE;
+		stream->s_fdcount--;
+		err = 0;
+	}
+	else {
+		err = ENOENT;
+	}
+
+	IOSTREAM_UNLOCK(stream);
+
+	return err;
+}
+
+/*
+ * pfc_bool_t
+ * __pfc_iostream_rdpending(pfc_iostream_t stream)
+ *	Determine whether the input buffer of the specified stream keeps
+ *	data which is not yet read.
+ *
+ *	Such data is never reported by poll(2) or epoll(7) on the file
+ *	descriptor, so the caller which waits for input by itself must
+ *	consume it in advance.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if unread data exists in the input buffer.
+ *	Otherwise PFC_FALSE is returned.
+ *
+ * Remarks:
+ *	This is not public interface.
+ */
+pfc_bool_t
+__pfc_iostream_rdpending(pfc_iostream_t stream)
+{
+	pfc_bool_t	ret;
+
+	IOSTREAM_LOCK(stream);
+	ret = (IOBUF_IS_EMPTY(&stream->s_input)) ? PFC_FALSE : PFC_TRUE;
+	IOSTREAM_UNLOCK(stream);
+
+	return ret;
+}
+
 /*
  * static int
  * iostream_buffer_init(iobuf_t *bp, uint32_t size)
@@ -2034,7 +2232,12 @@ iostream_read(pfc_iostream_t PFC_RESTRICT stream, uint8_t *PFC_RESTRICT buf,
 		}
 
 		/* Read data into the specified buffer. */
-		nbytes = read(fd, buf, size);
+		if (stream->s_flags & IOSTRF_PASSFD) {
+			nbytes = iostream_recv_passfd(stream, buf, size);
+		}
+		else {
+			nbytes = read(fd, buf, size);
+		}
 		if (nbytes == 0) {
 			/* EOF has been detected. */
 			stream->s_flags |= IOSTRF_EOF;
@@ -2883,6 +3086,137 @@ iostream_cmcred_fetch_cleanup(cmsg_ctx_t *ctx)
 	return 0;
 }
 
+/*
+ * static size_t
+ * iostream_cmfd_size(cmsg_ctx_t *ctx)
+ *	Return the size of control message which sends a file descriptor.
+ */
+static size_t
+iostream_cmfd_size(cmsg_ctx_t *ctx)
+{
+	return sizeof(int);
+}
+
+/*
+ * static void
+ * iostream_cmfd_setup(cmsg_ctx_t *ctx)
+ *	Set up control message to send a file descriptor.
+ */
+static void
+iostream_cmfd_setup(cmsg_ctx_t *ctx)
+{
+	cmsg_fdctx_t	*fctx = CMSG_CTX_FDCTX(ctx);
+	struct msghdr	*msg = &ctx->cm_header;
+	struct cmsghdr	*cmsg;
+
+	cmsg = CMSG_FIRSTHDR(msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	msg->msg_controllen = cmsg->cmsg_len;
+	*((int *)CMSG_DATA(cmsg)) = fctx->cmf_fd;
+}
+
+/*
+ * static ssize_t
+ * iostream_recv_passfd(pfc_iostream_t PFC_RESTRICT stream,
+ *			uint8_t *PFC_RESTRICT buf, size_t size)
+ *	Read data from the stream which passes file descriptors.
+ *	File descriptors carried by the data are appended to the FD queue
+ *	in the stream.
+ *
+ * Calling/Exit State:
+ *	The same value as read(2) is returned.
+ *
+ * Remarks:
+ *	The caller must call this function with holding the stream lock.
+ */
+static ssize_t
+iostream_recv_passfd(pfc_iostream_t PFC_RESTRICT stream,
+		     uint8_t *PFC_RESTRICT buf, size_t size)
+{
+	union {
+		struct cmsghdr	cm_align;
+		char		cm_buf[CMSG_SPACE(sizeof(int) *
+						  IOSTREAM_FDQ_SIZE)];
+	} cbuf;
+	struct msghdr	msg;
+	struct cmsghdr	*cmsg;
+	struct iovec	iov;
+	ssize_t		nbytes;
+	int		mflags = 0;
+
+#ifdef	MSG_CMSG_CLOEXEC
+	mflags |= MSG_CMSG_CLOEXEC;
+#endif	/* MSG_CMSG_CLOEXEC */
+
+	iov.iov_base = buf;
+	iov.iov_len = size;
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = cbuf.cm_buf;
+	msg.msg_controllen = sizeof(cbuf.cm_buf);
+	msg.msg_flags = 0;
+
+	nbytes = recvmsg(stream->s_fd, &msg, mflags);
+	if (nbytes <= 0) {
+		return nbytes;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+	     cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		int	*src, *limit;
+
+		if (PFC_EXPECT_FALSE(cmsg->cmsg_level != SOL_SOCKET ||
+				     cmsg->cmsg_type != SCM_RIGHTS)) {
+			continue;
+		}
+
+		src = (int *)CMSG_DATA(cmsg);
+		limit = src + (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		for (; src < limit; src++) {
+			uint32_t	tail;
+
+			if (PFC_EXPECT_FALSE(stream->s_fdcount ==
+					     IOSTREAM_FDQ_SIZE)) {
+				IOSTREAM_LOG_ERROR("FD queue is full: "
+						   "stream=%p", stream);
+				iostream_close_fd(*src, "passfd");
+				continue;
+			}
+
+			tail = (stream->s_fdhead + stream->s_fdcount) %
+				IOSTREAM_FDQ_SIZE;
+			stream->s_fdq[tail] = *src;
+			stream->s_fdcount++;
+		}
+	}
+
+	if (PFC_EXPECT_FALSE(msg.msg_flags & MSG_CTRUNC)) {
+		IOSTREAM_LOG_ERROR("Received FDs were truncated: stream=%p",
+				   stream);
+	}
+
+	return nbytes;
+}
+
+/*
+ * static void
+ * iostream_fdq_clear(pfc_iostream_t stream)
+ *	Close all file descriptors left in the FD queue.
+ */
+static void
+iostream_fdq_clear(pfc_iostream_t stream)
+{
+	while (stream->s_fdcount != 0) {
+		iostream_close_fd(stream->s_fdq[stream->s_fdhead], "fdq");
+		stream->s_fdhead = (stream->s_fdhead + 1) % IOSTREAM_FDQ_SIZE;
+		stream->s_fdcount--;
+	}
+}
+
 /*
  * static int
  * iostream_getsockerr(int sock)
@@ -60,6 +60,16 @@ extern int	__pfc_iostream_recvcred_abs(pfc_iostream_t PFC_RESTRICT stream,
 					    const pfc_timespec_t *PFC_RESTRICT
 					    abstime);
 
+extern int	__pfc_iostream_passfd(pfc_iostream_t stream);
+extern int	__pfc_iostream_sendfd_abs(pfc_iostream_t PFC_RESTRICT stream,
+					  const void *PFC_RESTRICT buf,
+					  size_t *PFC_RESTRICT sizep, int fd,
+					  const pfc_timespec_t *PFC_RESTRICT
+					  abstime);
+extern int	__pfc_iostream_recvfd(pfc_iostream_t PFC_RESTRICT stream,
+				      int *PFC_RESTRICT fdp);
+extern pfc_bool_t	__pfc_iostream_rdpending(pfc_iostream_t stream);
+
 PFC_C_END_DECL
 
 #endif	/* !_PFC_LIBPFC_UTIL_IOSTREAM_IMPL_H */
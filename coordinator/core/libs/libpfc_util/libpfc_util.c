@@ -31,6 +31,7 @@ static const char	valgrind_keyword[] = "vgpreload";
 pfc_bool_t	pfc_valgrind_mode PFC_ATTR_HIDDEN;
 
 extern void	pfc_log_libinit(void);
+extern void	pfc_log_fork_child(void);
 
 /*
  * Internal prototypes.
@@ -166,6 +167,7 @@ static void
 libpfc_util_fork_child(void)
 {
 	libpfc_tid_fork_child();
+	pfc_log_fork_child();
 	pfc_refptr_fork_child();
 	pfc_conf_fork_child();
 }
@@ -27,6 +27,9 @@ static const char	conf_log_syslog[] = "log_syslog";
 static const char	conf_log_facility[] = "log_facility";
 static const char	conf_message_rotate[] = "message_rotate";
 static const char	conf_message_size[] = "message_size";
+static const char	conf_log_async[] = "log_async";
+static const char	conf_log_async_size[] = "log_async_size";
+static const char	conf_log_async_overflow[] = "log_async_overflow";
 
 /*
  * Default log facility.
@@ -43,6 +46,16 @@ static const char	conf_message_size[] = "message_size";
  */
 #define LOG_MSG_SIZE_DEFAULT		10000000U	/* 10MB */
 
+/*
+ * Default value of log_async_size, in kilobytes.
+ */
+#define LOG_ASYNC_SIZE_DEFAULT		1024U		/* 1MB */
+
+/*
+ * log_async_overflow value which discards logs on overflow.
+ */
+#define LOG_ASYNC_OVERFLOW_DROP		"drop"
+
 /*
  * Internal prototypes.
  */
@@ -68,6 +81,9 @@ static char	*logconf_alloc_path(const char *PFC_RESTRICT base, size_t blen,
  *		- log_facility
  *		- message_rotate
  *		- message_size
+ *		- log_async
+ *		- log_async_size
+ *		- log_async_overflow
  *		- log_level
  */
 void
@@ -75,6 +91,7 @@ pfc_logconf_init(pfc_log_conf_t *PFC_RESTRICT cfp, pfc_cfblk_t blk,
 		 const char *PFC_RESTRICT ident, pfc_log_fatal_t handler)
 {
 	pfc_bool_t	log_syslog;
+	const char	*overflow;
 
 	/*
 	 * Determine whether to use only the syslog for recording logs.
@@ -94,6 +111,18 @@ pfc_logconf_init(pfc_log_conf_t *PFC_RESTRICT cfp, pfc_cfblk_t blk,
 					      LOG_MSG_ROTATE_DEFAULT);
 	cfp->plc_rsize = (size_t)pfc_conf_get_uint32(blk, conf_message_size,
 						     LOG_MSG_SIZE_DEFAULT);
+
+	/*
+	 * Determine whether logs are recorded by the log writer thread.
+	 * The calling thread blocks on buffer overflow unless
+	 * "log_async_overflow" is "drop".
+	 */
+	cfp->plc_async = pfc_conf_get_bool(blk, conf_log_async, PFC_FALSE);
+	cfp->plc_async_size = pfc_conf_get_uint32(blk, conf_log_async_size,
+						  LOG_ASYNC_SIZE_DEFAULT);
+	overflow = pfc_conf_get_string(blk, conf_log_async_overflow, NULL);
+	cfp->plc_async_block = (overflow == NULL ||
+				strcmp(overflow, LOG_ASYNC_OVERFLOW_DROP) != 0);
 	logconf_init_common(cfp, blk, ident, handler);
 }
 
@@ -116,6 +145,9 @@ pfc_logconf_early(pfc_log_conf_t *PFC_RESTRICT cfp, pfc_cfblk_t blk,
 	cfp->plc_level.plvc_level = (pfc_log_level_is_valid(level) == 0)
 		? level : PFC_LOGLVL_NONE;
 	cfp->plc_output = out;
+	cfp->plc_async = PFC_FALSE;
+	cfp->plc_async_size = LOG_ASYNC_SIZE_DEFAULT;
+	cfp->plc_async_block = PFC_TRUE;
 	logconf_init_common(cfp, blk, ident, handler);
 }
 
@@ -163,6 +195,24 @@ pfc_logconf_setsyslog(pfc_log_conf_t *PFC_RESTRICT cfp, pfc_bool_t sysonly)
 	}
 }
 
+/*
+ * void
+ * pfc_logconf_setasync(pfc_log_conf_t *cfp, pfc_bool_t async, uint32_t size,
+ *			pfc_bool_t block)
+ *	Set asynchronous logging parameters.
+ *	`size' is the size of the log buffer in kilobytes. If `block' is
+ *	true, the logging thread waits for free space on buffer overflow.
+ *	Otherwise the log is dropped.
+ */
+void
+pfc_logconf_setasync(pfc_log_conf_t *cfp, pfc_bool_t async, uint32_t size,
+		     pfc_bool_t block)
+{
+	cfp->plc_async = async;
+	cfp->plc_async_size = size;
+	cfp->plc_async_block = block;
+}
+
 /*
  * void
  * pfc_logconf_setrotate(pfc_log_conf_t *PFC_RESTRICT cfp,
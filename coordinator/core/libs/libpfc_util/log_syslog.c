@@ -13,7 +13,10 @@
 
 #include <syslog.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <stdarg.h>
+#include <pthread.h>
+#include <signal.h>
 #include <string.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -258,6 +261,93 @@ typedef struct {
  */
 static pfc_bool_t	log_isfatal = PFC_FALSE;
 
+/*
+ * Asynchronous logging.
+ *
+ * If enabled, logs other than FATAL are formatted by the calling thread and
+ * queued to a bounded lock-free ring buffer shared by all threads. One writer
+ * thread records the queued logs to the log file by writev(2) in batches,
+ * and takes the PFC log system lock only once per batch. FATAL logs are
+ * recorded synchronously after all logs queued before are recorded.
+ *
+ * The buffer is divided into slots of LOG_ASYNC_SLOTSIZE bytes, and a record
+ * occupies one or more consecutive slots. A producer claims slots by
+ * advancing la_head with CAS, and publishes the record by updating the
+ * sequence number of its first slot. The sequence number of a slot is equal
+ * to the position of the slot while it is free, and position + 1 while it
+ * keeps a published record.
+ */
+#define	LOG_ASYNC_SLOTSIZE	256U
+#define	LOG_ASYNC_MAXSLOTS	16U
+
+/*
+ * Maximum length of a queued record. Longer logs are truncated.
+ */
+#define	LOG_ASYNC_MAXRECORD	(LOG_ASYNC_SLOTSIZE * LOG_ASYNC_MAXSLOTS)
+
+/*
+ * Number of slots used by a record of `len' bytes.
+ */
+#define	LOG_ASYNC_NSLOTS(len)						\
+	(((len) + LOG_ASYNC_SLOTSIZE - 1) / LOG_ASYNC_SLOTSIZE)
+
+#define	LOG_ASYNC_MIN(a, b)	(((a) < (b)) ? (a) : (b))
+
+/*
+ * Maximum number of records written by one writev(2) call.
+ */
+#define	LOG_ASYNC_BATCH		64U
+
+/*
+ * How long, in milliseconds, the idle writer thread sleeps at most.
+ */
+#define	LOG_ASYNC_IDLE_TIMEOUT	1000U
+
+typedef struct {
+	volatile uint32_t	las_seq;	/* sequence number */
+	uint32_t		las_len;	/* length of record */
+} log_aslot_t;
+
+typedef struct {
+	log_aslot_t	*la_slots;	/* slot headers */
+	char		*la_data;	/* record data */
+	uint32_t	la_nslots;	/* number of slots, power of 2 */
+	pfc_bool_t	la_block;	/* wait for free slots if true */
+	uint32_t	la_enabled;	/* non-zero while the writer runs */
+	uint32_t	la_users;	/* threads accessing the buffer */
+	uint32_t	la_head;	/* next position to be claimed */
+	uint32_t	la_tail;	/* next position to be written */
+	uint32_t	la_idle;	/* non-zero if the writer is sleeping */
+	uint32_t	la_waiters;	/* threads waiting on la_cond */
+	uint32_t	la_stop;	/* non-zero if the writer must quit */
+	pthread_t	la_thread;	/* writer thread */
+	pfc_mutex_t	la_mutex;	/* mutex for condition variables */
+	pfc_cond_t	la_wcond;	/* wakes up the writer */
+	pfc_cond_t	la_cond;	/* broadcasted when la_tail advances */
+	uint64_t	la_written;	/* number of records written */
+	uint64_t	la_dropped;	/* number of records dropped */
+	uint64_t	la_blocked;	/* number of waits for free slots */
+	uint64_t	la_reported;	/* dropped records already reported */
+} log_async_t;
+
+static log_async_t	log_async = {
+	.la_mutex	= PFC_MUTEX_INITIALIZER,
+};
+
+/*
+ * Read a field of log_async which is updated by other threads.
+ */
+#define	LOG_ASYNC_READ(field)		(*(volatile typeof(log_async.field) *) \
+					 &log_async.field)
+
+#define	LOG_ASYNC_LOCK()	pfc_mutex_lock(&log_async.la_mutex)
+#define	LOG_ASYNC_UNLOCK()	pfc_mutex_unlock(&log_async.la_mutex)
+
+/*
+ * Buffer to format a record to be queued.
+ */
+static __thread char	log_async_buffer[LOG_ASYNC_MAXRECORD];
+
 /*
  * Internal prototypes.
  */
@@ -268,7 +358,8 @@ static void	pfc_log_common_impl(pfc_log_level_t level, const char *modname,
 static void	pfc_log_file(int pri, const char *format, va_list ap);
 static void	pfc_log_file_rotate(void);
 static void	pfc_log_file_close(void);
-static const char	*pfc_log_create_format(const log_lvl_t *lvl,
+static const char	*pfc_log_create_format(char *buffer,
+					       const log_lvl_t *lvl,
 					       const char *modname,
 					       const char *format);
 static const char	 *pfc_log_timestamp(char *buffer, size_t bufsize);
@@ -280,6 +371,19 @@ static int	log_file_rotation_init(const char *path,
 				       uint32_t rcount, size_t rsize);
 static void	log_file_rotation_fini(void);
 
+static void	log_async_start(const pfc_log_conf_t *cfp);
+static void	log_async_stop(void);
+static pfc_bool_t	log_async_record(const log_lvl_t *lvl,
+					 const char *modname,
+					 const char *format, va_list ap);
+static void	log_async_put(const char *record, uint32_t len);
+static void	log_async_wait(uint32_t nslots);
+static void	log_async_flush(void);
+static void	*log_async_writer(void *arg);
+static pfc_bool_t	log_async_idle(void);
+static int	log_async_iov(uint32_t pos, uint32_t len, struct iovec *iov);
+static void	log_async_write(struct iovec *iov, int niov);
+
 static pfc_log_level_t	log_level_name_is_valid(log_cattr_t *lattr,
 						const char *name);
 
@@ -460,6 +564,23 @@ void PFC_ATTR_HIDDEN
 pfc_log_libinit(void)
 {
 	log_output = stderr;
+	PFC_ASSERT_INT(pfc_cond_init(&log_async.la_wcond), 0);
+	PFC_ASSERT_INT(pfc_cond_init(&log_async.la_cond), 0);
+}
+
+/*
+ * void PFC_ATTR_HIDDEN
+ * pfc_log_fork_child(void)
+ *	fork(2) handler which will be called on child process.
+ *	The log writer thread does not exist in the child process, so logs
+ *	are always recorded synchronously.
+ */
+void PFC_ATTR_HIDDEN
+pfc_log_fork_child(void)
+{
+	log_async.la_enabled = 0;
+	log_async.la_users = 0;
+	log_async.la_waiters = 0;
 }
 
 /*
@@ -620,6 +741,9 @@ pfc_log_init_impl(const pfc_log_conf_t *PFC_RESTRICT cfp)
 			log_function = vsyslog;
 			log_close = closelog;
 		}
+		else if (cfp->plc_async && log_output != NULL) {
+			log_async_start(cfp);
+		}
 	}
 
 	PFC_LOG_UNLOCK();
@@ -642,6 +766,9 @@ pfc_log_init_impl(const pfc_log_conf_t *PFC_RESTRICT cfp)
 void
 pfc_log_fini(void)
 {
+	/* Record all queued logs, and stop the log writer thread. */
+	log_async_stop();
+
 	PFC_LOG_LOCK();
 
 	/* Close logging output files. */
@@ -743,6 +870,21 @@ pfc_log_isfatal(void)
 	return log_isfatal;
 }
 
+/*
+ * void
+ * pfc_log_async_getstats(pfc_log_async_stats_t *statsp)
+ *	Copy statistics of asynchronous logging to the buffer pointed by
+ *	`statsp'. All counters are reset when the logging system is
+ *	initialized.
+ */
+void
+pfc_log_async_getstats(pfc_log_async_stats_t *statsp)
+{
+	statsp->plas_written = LOG_ASYNC_READ(la_written);
+	statsp->plas_dropped = LOG_ASYNC_READ(la_dropped);
+	statsp->plas_blocked = LOG_ASYNC_READ(la_blocked);
+}
+
 /*
  * void
  * pfc_log_set_fatal_handler(pfc_log_fatal_t handler)
@@ -1101,8 +1243,18 @@ pfc_log_common_impl(pfc_log_level_t level, const char *modname,
 
 	lvl = &log_level_attr[level];
 
+	if (level != PFC_LOGLVL_FATAL) {
+		if (log_async_record(lvl, modname, format, ap)) {
+			return;
+		}
+	}
+	else {
+		/* Record logs queued before the fatal log. */
+		log_async_flush();
+	}
+
 	PFC_LOG_LOCK();
-	fmt = pfc_log_create_format(lvl, modname, format);
+	fmt = pfc_log_create_format(log_buffer, lvl, modname, format);
 	(*log_function)(lvl->l_priority, fmt, ap);
 
 	if (level == PFC_LOGLVL_FATAL) {
@@ -1228,26 +1380,532 @@ pfc_log_file_close(void)
 }
 
 /*
- * static const char *
- * pfc_log_create_format(const log_lvl_t *lvl, const char *modname,
- *			 const char *format)
- *	Create format string of the log message.
+ * static void
+ * log_async_start(const pfc_log_conf_t *cfp)
+ *	Start asynchronous logging to the log file.
+ *	Logs are recorded synchronously if the log writer thread could not
+ *	be started.
  *
  * Remarks:
  *	This function must be called with holding the PFC log system lock.
  */
+static void
+log_async_start(const pfc_log_conf_t *cfp)
+{
+	log_async_t	*lap = &log_async;
+	uint64_t	want;
+	uint32_t	nslots, i;
+	sigset_t	mask, omask;
+	int		err;
+
+	PFC_ASSERT(lap->la_enabled == 0);
+
+	want = (uint64_t)cfp->plc_async_size * 1024 / LOG_ASYNC_SLOTSIZE;
+	for (nslots = LOG_ASYNC_MAXSLOTS * 2; nslots < want; nslots <<= 1);
+
+	lap->la_slots = (log_aslot_t *)malloc(sizeof(log_aslot_t) * nslots);
+	lap->la_data = (char *)malloc((size_t)LOG_ASYNC_SLOTSIZE * nslots);
+	if (PFC_EXPECT_FALSE(lap->la_slots == NULL || lap->la_data == NULL)) {
+		err = ENOMEM;
+		goto error;
+	}
+
+	for (i = 0; i < nslots; i++) {
+		lap->la_slots[i].las_seq = i;
+		lap->la_slots[i].las_len = 0;
+	}
+	lap->la_nslots = nslots;
+	lap->la_block = cfp->plc_async_block;
+	lap->la_head = 0;
+	lap->la_tail = 0;
+	lap->la_idle = 0;
+	lap->la_stop = 0;
+	lap->la_written = 0;
+	lap->la_dropped = 0;
+	lap->la_blocked = 0;
+	lap->la_reported = 0;
+
+	/* The writer thread must not receive any signal. */
+	sigfillset(&mask);
+	PFC_ASSERT_INT(pthread_sigmask(SIG_SETMASK, &mask, &omask), 0);
+	err = pthread_create(&lap->la_thread, NULL, log_async_writer, NULL);
+	PFC_ASSERT_INT(pthread_sigmask(SIG_SETMASK, &omask, NULL), 0);
+	if (PFC_EXPECT_FALSE(err != 0)) {
+		goto error;
+	}
+
+	(void)pfc_atomic_swap_uint32(&lap->la_enabled, 1);
+
+	return;
+
+error:
+	free(lap->la_slots);
+	free(lap->la_data);
+	lap->la_slots = NULL;
+	lap->la_data = NULL;
+	fprintf(stderr, "Failed to start asynchronous logging: %s\n",
+		strerror(err));
+}
+
+/*
+ * static void
+ * log_async_stop(void)
+ *	Stop asynchronous logging.
+ *	This function returns after all the queued logs are recorded.
+ *
+ * Remarks:
+ *	This function must be called without holding the PFC log system lock.
+ */
+static void
+log_async_stop(void)
+{
+	log_async_t	*lap = &log_async;
+	uint64_t	written, dropped, blocked;
+
+	if (lap->la_enabled == 0) {
+		return;
+	}
+
+	/* New logs are recorded synchronously from now on. */
+	(void)pfc_atomic_swap_uint32(&lap->la_enabled, 0);
+
+	LOG_ASYNC_LOCK();
+	(void)pfc_atomic_swap_uint32(&lap->la_stop, 1);
+	pfc_cond_signal(&lap->la_wcond);
+	LOG_ASYNC_UNLOCK();
+
+	PFC_ASSERT_INT(pthread_join(lap->la_thread, NULL), 0);
+
+	free(lap->la_slots);
+	free(lap->la_data);
+	lap->la_slots = NULL;
+	lap->la_data = NULL;
+
+	written = lap->la_written;
+	dropped = lap->la_dropped;
+	blocked = lap->la_blocked;
+	pfc_log_info("Asynchronous logging stopped: written=%" PFC_PFMT_u64
+		     ", dropped=%" PFC_PFMT_u64 ", blocked=%" PFC_PFMT_u64,
+		     written, dropped, blocked);
+}
+
+/*
+ * static pfc_bool_t
+ * log_async_record(const log_lvl_t *lvl, const char *modname,
+ *		    const char *format, va_list ap)
+ *	Format a log record, and queue it to the log writer thread.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if the log was queued or dropped.
+ *	PFC_FALSE is returned if asynchronous logging is disabled.
+ *	In that case `ap' is not accessed.
+ */
+static pfc_bool_t
+log_async_record(const log_lvl_t *lvl, const char *modname,
+		 const char *format, va_list ap)
+{
+	log_async_t	*lap = &log_async;
+	char		datebuf[PFC_TIME_STRING_LENGTH];
+	char		fmtbuf[PFC_LOG_MAX_SIZE + 1];
+	char		*buffer = log_async_buffer;
+	const char	*fmt;
+	size_t		len, limit = LOG_ASYNC_MAXRECORD - 1;
+	int		ret;
+
+	/* Keep the writer thread running until this log is queued. */
+	pfc_atomic_inc_uint32(&lap->la_users);
+	if (LOG_ASYNC_READ(la_enabled) == 0) {
+		pfc_atomic_dec_uint32(&lap->la_users);
+
+		return PFC_FALSE;
+	}
+
+	ret = snprintf(buffer, limit, "%s: ",
+		       pfc_log_timestamp(datebuf, sizeof(datebuf)));
+	len = (ret > 0) ? LOG_ASYNC_MIN((size_t)ret, limit - 1) : 0;
+
+#ifdef	PFC_TIDLOG_ENABLED
+	/* Print system thread ID for the calling thread. */
+	ret = snprintf(buffer + len, limit - len, "[%u]: ", pfc_gettid());
+	if (ret > 0) {
+		len = LOG_ASYNC_MIN(len + ret, limit - 1);
+	}
+#endif	/* PFC_TIDLOG_ENABLED */
+
+	fmt = pfc_log_create_format(fmtbuf, lvl, modname, format);
+	ret = vsnprintf(buffer + len, limit - len, fmt, ap);
+	if (ret > 0) {
+		len = LOG_ASYNC_MIN(len + ret, limit - 1);
+	}
+	buffer[len] = '\n';
+	len++;
+
+	log_async_put(buffer, len);
+	pfc_atomic_dec_uint32(&lap->la_users);
+
+	return PFC_TRUE;
+}
+
+/*
+ * static void
+ * log_async_put(const char *record, uint32_t len)
+ *	Queue the log record to the log writer thread.
+ *	If the buffer is full, the record is dropped or the calling thread
+ *	waits for free slots according to the configuration.
+ *
+ * Remarks:
+ *	The caller must hold a reference to la_users.
+ */
+static void
+log_async_put(const char *record, uint32_t len)
+{
+	log_async_t	*lap = &log_async;
+	log_aslot_t	*asp;
+	uint32_t	nslots = LOG_ASYNC_NSLOTS(len);
+	uint32_t	mask = lap->la_nslots - 1;
+	uint32_t	pos, last, off, size;
+	int32_t		diff;
+
+	PFC_ASSERT(nslots <= LOG_ASYNC_MAXSLOTS);
+
+	for (;;) {
+		pos = LOG_ASYNC_READ(la_head);
+		last = pos + nslots - 1;
+		diff = (int32_t)(lap->la_slots[last & mask].las_seq - last);
+		if (diff == 0) {
+			/*
+			 * Slots are freed in order, so all the slots up to
+			 * the last one are free.
+			 */
+			if (pfc_atomic_cas_uint32(&lap->la_head, pos + nslots,
+						  pos) == pos) {
+				break;
+			}
+		}
+		else if (diff < 0) {
+			/* The buffer is full. */
+			if (!lap->la_block) {
+				pfc_atomic_inc_uint64(&lap->la_dropped);
+
+				return;
+			}
+			log_async_wait(nslots);
+		}
+	}
+
+	/* Copy the record. It may wrap around the end of the buffer. */
+	off = (pos & mask) * LOG_ASYNC_SLOTSIZE;
+	size = lap->la_nslots * LOG_ASYNC_SLOTSIZE - off;
+	if (len <= size) {
+		memcpy(lap->la_data + off, record, len);
+	}
+	else {
+		memcpy(lap->la_data + off, record, size);
+		memcpy(lap->la_data, record + size, len - size);
+	}
+
+	/* Publish the record. */
+	asp = &lap->la_slots[pos & mask];
+	asp->las_len = len;
+	pfc_atomic_write_barrier();
+	asp->las_seq = pos + 1;
+
+	pfc_atomic_memory_barrier();
+	if (LOG_ASYNC_READ(la_idle)) {
+		LOG_ASYNC_LOCK();
+		pfc_cond_signal(&lap->la_wcond);
+		LOG_ASYNC_UNLOCK();
+	}
+}
+
+/*
+ * static void
+ * log_async_wait(uint32_t nslots)
+ *	Block the calling thread until `nslots' slots may be claimed.
+ */
+static void
+log_async_wait(uint32_t nslots)
+{
+	log_async_t	*lap = &log_async;
+	uint32_t	mask = lap->la_nslots - 1;
+
+	pfc_atomic_inc_uint64(&lap->la_blocked);
+
+	LOG_ASYNC_LOCK();
+
+	/*
+	 * The writer thread checks la_waiters after it frees slots, so
+	 * la_waiters must be updated before the slots are checked.
+	 */
+	pfc_atomic_inc_uint32(&lap->la_waiters);
+	for (;;) {
+		uint32_t	last = LOG_ASYNC_READ(la_head) + nslots - 1;
+
+		if ((int32_t)(lap->la_slots[last & mask].las_seq - last) >= 0) {
+			break;
+		}
+		pfc_cond_wait(&lap->la_cond, &lap->la_mutex);
+	}
+	pfc_atomic_dec_uint32(&lap->la_waiters);
+
+	LOG_ASYNC_UNLOCK();
+}
+
+/*
+ * static void
+ * log_async_flush(void)
+ *	Wait for the log writer thread to record all logs queued before.
+ */
+static void
+log_async_flush(void)
+{
+	log_async_t	*lap = &log_async;
+	uint32_t	head;
+
+	pfc_atomic_inc_uint32(&lap->la_users);
+	if (LOG_ASYNC_READ(la_enabled) == 0) {
+		pfc_atomic_dec_uint32(&lap->la_users);
+
+		return;
+	}
+
+	head = LOG_ASYNC_READ(la_head);
+
+	LOG_ASYNC_LOCK();
+	pfc_atomic_inc_uint32(&lap->la_waiters);
+	while ((int32_t)(LOG_ASYNC_READ(la_tail) - head) < 0) {
+		pfc_cond_wait(&lap->la_cond, &lap->la_mutex);
+	}
+	pfc_atomic_dec_uint32(&lap->la_waiters);
+	LOG_ASYNC_UNLOCK();
+
+	pfc_atomic_dec_uint32(&lap->la_users);
+}
+
+/*
+ * static void *
+ * log_async_writer(void *arg)
+ *	Start routine of the log writer thread.
+ */
+static void *
+log_async_writer(void *PFC_ATTR_UNUSED arg)
+{
+	log_async_t	*lap = &log_async;
+	uint32_t	mask = lap->la_nslots - 1;
+	struct iovec	iov[LOG_ASYNC_BATCH * 2 + 1];
+	char		dropbuf[PFC_LOG_MAX_SIZE];
+
+	for (;;) {
+		uint32_t	tail = lap->la_tail, pos = tail, nrecs = 0;
+		uint64_t	dropped = LOG_ASYNC_READ(la_dropped);
+		int		niov = 0;
+
+		if (PFC_EXPECT_FALSE(dropped != lap->la_reported)) {
+			char	datebuf[PFC_TIME_STRING_LENGTH];
+			int	ret;
+
+			ret = snprintf(dropbuf, sizeof(dropbuf),
+				       "%s: WARNING: %" PFC_PFMT_u64
+				       " logs were dropped.\n",
+				       pfc_log_timestamp(datebuf,
+							 sizeof(datebuf)),
+				       dropped - lap->la_reported);
+			lap->la_reported = dropped;
+			if (ret > 0) {
+				iov[0].iov_base = dropbuf;
+				iov[0].iov_len = LOG_ASYNC_MIN((size_t)ret,
+							 sizeof(dropbuf) - 1);
+				niov = 1;
+			}
+		}
+
+		while (nrecs < LOG_ASYNC_BATCH) {
+			log_aslot_t	*asp = &lap->la_slots[pos & mask];
+			uint32_t	len;
+
+			if ((int32_t)(asp->las_seq - (pos + 1)) < 0) {
+				/* Not yet published. */
+				break;
+			}
+			pfc_atomic_read_barrier();
+
+			len = asp->las_len;
+			niov += log_async_iov(pos, len, &iov[niov]);
+			pos += LOG_ASYNC_NSLOTS(len);
+			nrecs++;
+		}
+
+		if (niov == 0) {
+			if (log_async_idle()) {
+				break;
+			}
+			continue;
+		}
+
+		log_async_write(iov, niov);
+
+		/* Free slots of records written. */
+		pfc_atomic_memory_barrier();
+		for (; tail != pos; tail++) {
+			lap->la_slots[tail & mask].las_seq = tail + lap->la_nslots;
+		}
+		lap->la_tail = pos;
+		lap->la_written += nrecs;
+
+		pfc_atomic_memory_barrier();
+		if (LOG_ASYNC_READ(la_waiters) != 0) {
+			LOG_ASYNC_LOCK();
+			pfc_cond_broadcast(&lap->la_cond);
+			LOG_ASYNC_UNLOCK();
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * static pfc_bool_t
+ * log_async_idle(void)
+ *	Wait for a new record to be queued.
+ *
+ * Calling/Exit State:
+ *	PFC_TRUE is returned if the log writer thread must quit.
+ *	Otherwise PFC_FALSE is returned.
+ */
+static pfc_bool_t
+log_async_idle(void)
+{
+	log_async_t	*lap = &log_async;
+	uint32_t	tail = lap->la_tail;
+	log_aslot_t	*asp = &lap->la_slots[tail & (lap->la_nslots - 1)];
+	pfc_timespec_t	timeout;
+	pfc_bool_t	quit = PFC_FALSE;
+
+	LOG_ASYNC_LOCK();
+
+	/*
+	 * Producers check la_idle after they publish a record, so la_idle
+	 * must be updated before the slot is checked.
+	 */
+	(void)pfc_atomic_swap_uint32(&lap->la_idle, 1);
+	if (asp->las_seq != tail + 1) {
+		if (LOG_ASYNC_READ(la_stop) && LOG_ASYNC_READ(la_users) == 0) {
+			quit = PFC_TRUE;
+		}
+		else {
+			pfc_clock_msec2time(&timeout, LOG_ASYNC_IDLE_TIMEOUT);
+			(void)pfc_cond_timedwait(&lap->la_wcond,
+						 &lap->la_mutex, &timeout);
+		}
+	}
+	(void)pfc_atomic_swap_uint32(&lap->la_idle, 0);
+
+	LOG_ASYNC_UNLOCK();
+
+	return quit;
+}
+
+/*
+ * static int
+ * log_async_iov(uint32_t pos, uint32_t len, struct iovec *iov)
+ *	Set up I/O vectors for the record at the position `pos'.
+ *
+ * Calling/Exit State:
+ *	The number of I/O vectors set up, 1 or 2, is returned.
+ */
+static int
+log_async_iov(uint32_t pos, uint32_t len, struct iovec *iov)
+{
+	log_async_t	*lap = &log_async;
+	uint32_t	off = (pos & (lap->la_nslots - 1)) * LOG_ASYNC_SLOTSIZE;
+	uint32_t	size = lap->la_nslots * LOG_ASYNC_SLOTSIZE - off;
+
+	iov->iov_base = lap->la_data + off;
+	if (len <= size) {
+		iov->iov_len = len;
+
+		return 1;
+	}
+
+	iov->iov_len = size;
+	iov++;
+	iov->iov_base = lap->la_data;
+	iov->iov_len = len - size;
+
+	return 2;
+}
+
+/*
+ * static void
+ * log_async_write(struct iovec *iov, int niov)
+ *	Write records to the system log file, and rotate the file if needed.
+ *	Note that contents of `iov' are broken.
+ */
+static void
+log_async_write(struct iovec *iov, int niov)
+{
+	FILE	*out;
+	size_t	sz = 0;
+
+	PFC_LOG_LOCK();
+
+	out = log_output;
+	if (out != NULL) {
+		int	fd = fileno(out);
+
+		while (niov > 0) {
+			ssize_t	ret = writev(fd, iov, niov);
+
+			if (PFC_EXPECT_FALSE(ret < 0)) {
+				if (errno == EINTR) {
+					continue;
+				}
+				break;
+			}
+
+			sz += ret;
+			while (niov > 0 && (size_t)ret >= iov->iov_len) {
+				ret -= iov->iov_len;
+				iov++;
+				niov--;
+			}
+			if (niov > 0) {
+				iov->iov_base = (char *)iov->iov_base + ret;
+				iov->iov_len -= ret;
+			}
+		}
+
+		log_dump_size += sz;
+		if (log_rotate != NULL && log_dump_size >= log_rotate->r_size) {
+			pfc_log_file_rotate();
+			log_dump_size = 0;
+		}
+	}
+
+	PFC_LOG_UNLOCK();
+}
+
+/*
+ * static const char *
+ * pfc_log_create_format(char *buffer, const log_lvl_t *lvl,
+ *			 const char *modname, const char *format)
+ *	Create format string of the log message into `buffer', which must
+ *	have PFC_LOG_MAX_SIZE + 1 bytes.
+ *
+ * Remarks:
+ *	If `buffer' is log_buffer, this function must be called with holding
+ *	the PFC log system lock.
+ */
 static const char *
-pfc_log_create_format(const log_lvl_t *lvl, const char *modname,
+pfc_log_create_format(char *buffer, const log_lvl_t *lvl, const char *modname,
 		      const char *format)
 {
-	char	*buffer = log_buffer;
-
 	if (modname != NULL) {
-		snprintf(buffer, sizeof(log_buffer), "%s: %s: %s",
+		snprintf(buffer, PFC_LOG_MAX_SIZE + 1, "%s: %s: %s",
 			 lvl->l_name, modname, format);
 	}
 	else {
-		snprintf(buffer, sizeof(log_buffer), "%s: %s",
+		snprintf(buffer, PFC_LOG_MAX_SIZE + 1, "%s: %s",
 			 lvl->l_name, format);
 	}
 
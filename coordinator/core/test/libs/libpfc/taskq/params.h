@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2010-2014 NEC Corporation
+ * All rights reserved.
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+// The number of tasks dispatched by functional tests
+#define TASKQ_NTASKS 10000
+
+// The number of tasks dispatched per benchmark run
+#define BENCH_NTASKS 20000
+
+// Timeout value for tests of some APIs [milliseconds]
+#define TIMEOUT  3000
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * Benchmark of task dispatching.
+ *
+ * Dispatch latency and throughput are measured for the shared task list
+ * scheduler and the work-stealing scheduler at each concurrency level.
+ *   - Latency is the time from pfc_taskq_dispatch() to the start of
+ *     the task function.
+ *   - Throughput is the number of tasks completed per second, including
+ *     the time to flush the task queue.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_taskq_common.h"
+
+typedef struct bench_arg {
+	uint64_t	dispatched;
+	uint64_t	latency;
+} bench_arg_t;
+
+typedef struct bench_result {
+	uint64_t	elapsed;
+	uint64_t	lat_avg;
+	uint64_t	lat_p99;
+	uint64_t	lat_max;
+} bench_result_t;
+
+static void
+task_bench(void *arg)
+{
+	bench_arg_t	*bap = (bench_arg_t *)arg;
+
+	bap->latency = taskq_now_nsec() - bap->dispatched;
+}
+
+static int
+latency_compare(const void *a, const void *b)
+{
+	uint64_t	la = *(const uint64_t *)a;
+	uint64_t	lb = *(const uint64_t *)b;
+
+	return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+}
+
+static void
+bench_run(uint32_t concurrency, uint32_t flags, bench_result_t *resp)
+{
+	static bench_arg_t	args[BENCH_NTASKS];
+	static uint64_t		latency[BENCH_NTASKS];
+	pfc_taskq_t		tq;
+	pfc_task_t		tid;
+	uint64_t		start, sum;
+	uint32_t		i;
+
+	ASSERT_EQ(0, pfc_taskq_create_flags(&tq, NULL, concurrency, flags));
+	ASSERT_EQ(0, pfc_taskq_set_free(tq, concurrency));
+
+	// Warm up dispatcher threads.
+	for (i = 0; i < concurrency; i++) {
+		args[i].dispatched = taskq_now_nsec();
+		ASSERT_EQ(0, pfc_taskq_dispatch(tq, task_bench, &args[i], 0,
+						&tid));
+	}
+	ASSERT_EQ(0, pfc_taskq_flush(tq, NULL));
+
+	start = taskq_now_nsec();
+	for (i = 0; i < BENCH_NTASKS; i++) {
+		args[i].dispatched = taskq_now_nsec();
+		ASSERT_EQ(0, pfc_taskq_dispatch(tq, task_bench, &args[i], 0,
+						&tid));
+	}
+	ASSERT_EQ(0, pfc_taskq_flush(tq, NULL));
+	resp->elapsed = taskq_now_nsec() - start;
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+
+	sum = 0;
+	for (i = 0; i < BENCH_NTASKS; i++) {
+		latency[i] = args[i].latency;
+		sum += latency[i];
+	}
+	qsort(latency, BENCH_NTASKS, sizeof(latency[0]), latency_compare);
+	resp->lat_avg = sum / BENCH_NTASKS;
+	resp->lat_p99 = latency[(BENCH_NTASKS * 99) / 100];
+	resp->lat_max = latency[BENCH_NTASKS - 1];
+}
+
+TEST(pfc_taskq_bench, dispatch)
+{
+	static const uint32_t	concurrency[] = {1, 4, 16, 64};
+	static const struct {
+		const char	*name;
+		uint32_t	flags;
+	} sched[] = {
+		{ "shared", 0 },
+		{ "steal", PFC_TASKQ_CF_STEAL },
+	};
+	uint32_t		c, s;
+
+	printf("%-8s %7s %12s %10s %10s %10s\n", "sched", "threads",
+	       "tasks/sec", "avg(us)", "p99(us)", "max(us)");
+	for (c = 0; c < PFC_ARRAY_CAPACITY(concurrency); c++) {
+		for (s = 0; s < PFC_ARRAY_CAPACITY(sched); s++) {
+			bench_result_t	res;
+			double		tput;
+
+			memset(&res, 0, sizeof(res));
+			bench_run(concurrency[c], sched[s].flags, &res);
+			if (HasFatalFailure()) {
+				return;
+			}
+
+			tput = (double)BENCH_NTASKS * PFC_CLOCK_NANOSEC /
+				(double)res.elapsed;
+			printf("%-8s %7u %12.0f %10.1f %10.1f %10.1f\n",
+			       sched[s].name, concurrency[c], tput,
+			       res.lat_avg / 1000.0, res.lat_p99 / 1000.0,
+			       res.lat_max / 1000.0);
+		}
+	}
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2010-2014 NEC Corporation
+ * All rights reserved.
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include "test_taskq_common.h"
+
+extern "C" {
+extern void libpfc_init();
+extern void libpfc_fini();
+}
+
+const pfc_timespec_t	timeout_taskq_ = {
+	TIMEOUT / PFC_CLOCK_MILLISEC,
+	(TIMEOUT % PFC_CLOCK_MILLISEC) * (PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC)
+};
+
+/*
+ * Global test environment.
+ */
+class TestEnvironment : public ::testing::Environment {
+    protected:
+	virtual void SetUp() {
+		pfc_log_init("gtest", stderr, PFC_LOGLVL_NOTICE, NULL);
+		libpfc_init();
+	}
+	virtual void TearDown() {
+		pfc_log_fini();
+		libpfc_fini();
+	}
+};
+
+::testing::Environment  *global_env =
+	  ::testing::AddGlobalTestEnvironment(new TestEnvironment());
+
+void
+gate_init(taskq_gate_t *gp)
+{
+	ASSERT_EQ(0, PFC_MUTEX_INIT(&gp->mutex));
+	ASSERT_EQ(0, pfc_cond_init(&gp->cond));
+	gp->opened = PFC_FALSE;
+	gp->nwaiting = 0;
+}
+
+void
+gate_destroy(taskq_gate_t *gp)
+{
+	ASSERT_EQ(0, pfc_cond_destroy(&gp->cond));
+	ASSERT_EQ(0, pfc_mutex_destroy(&gp->mutex));
+}
+
+void
+gate_open(taskq_gate_t *gp)
+{
+	pfc_mutex_lock(&gp->mutex);
+	gp->opened = PFC_TRUE;
+	pfc_cond_broadcast(&gp->cond);
+	pfc_mutex_unlock(&gp->mutex);
+}
+
+void
+gate_pass(taskq_gate_t *gp)
+{
+	pfc_mutex_lock(&gp->mutex);
+	gp->nwaiting++;
+	pfc_cond_broadcast(&gp->cond);
+	while (!gp->opened) {
+		pfc_cond_wait(&gp->cond, &gp->mutex);
+	}
+	gp->nwaiting--;
+	pfc_mutex_unlock(&gp->mutex);
+}
+
+void
+gate_wait_blocked(taskq_gate_t *gp, uint32_t count)
+{
+	pfc_mutex_lock(&gp->mutex);
+	while (gp->nwaiting < count) {
+		int err = pfc_cond_timedwait(&gp->cond, &gp->mutex,
+					     &timeout_taskq_);
+		EXPECT_EQ(0, err);
+		if (err != 0) {
+			break;
+		}
+	}
+	pfc_mutex_unlock(&gp->mutex);
+}
+
+void
+task_gate(void *arg)
+{
+	gate_pass((taskq_gate_t *)arg);
+}
+
+uint64_t
+taskq_now_nsec(void)
+{
+	pfc_timespec_t	ts;
+
+	PFC_ASSERT_INT(pfc_clock_gettime(&ts), 0);
+
+	return (uint64_t)ts.tv_sec * PFC_CLOCK_NANOSEC + ts.tv_nsec;
+}
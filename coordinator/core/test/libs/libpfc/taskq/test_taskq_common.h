@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2010-2014 NEC Corporation
+ * All rights reserved.
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#ifndef _TEST_TASKQ_COMMON_H
+#define _TEST_TASKQ_COMMON_H
+
+#include <pfc/base.h>
+#include <pfc/clock.h>
+#include <pfc/taskq.h>
+#include <pfc/synch.h>
+#include <pfc/atomic.h>
+#include <pfc/log.h>
+
+#include "params.h"
+
+// Timeout value for flush, clear and join
+extern const pfc_timespec_t timeout_taskq_;
+
+// Gate which blocks running tasks until it is opened.
+typedef struct taskq_gate {
+	pfc_mutex_t	mutex;
+	pfc_cond_t	cond;
+	pfc_bool_t	opened;
+	uint32_t	nwaiting;
+} taskq_gate_t;
+
+extern void gate_init(taskq_gate_t *);
+extern void gate_destroy(taskq_gate_t *);
+extern void gate_open(taskq_gate_t *);
+
+// Block the calling task until the gate is opened.
+extern void gate_pass(taskq_gate_t *);
+
+// Wait for the specified number of tasks to be blocked at the gate.
+extern void gate_wait_blocked(taskq_gate_t *, uint32_t);
+
+// Task function that blocks on the gate passed as argument.
+extern void task_gate(void *);
+
+// Return the current monotonic time in nanoseconds.
+extern uint64_t taskq_now_nsec(void);
+
+#endif	// !_TEST_TASKQ_COMMON_H
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2010-2014 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * Tests for the work-stealing scheduler of task queue.
+ */
+
+#include <gtest/gtest.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "test_taskq_common.h"
+
+/*
+ * Per-test context passed to task functions.
+ */
+typedef struct steal_ctx {
+	pfc_taskq_t	tq;
+	uint32_t	ncalled;
+	uint32_t	ndtor;
+	uint32_t	norder;
+	uint32_t	order[TASKQ_NTASKS];
+	uint32_t	nchildren;
+} steal_ctx_t;
+
+typedef struct steal_arg {
+	steal_ctx_t	*ctx;
+	uint32_t	index;
+	uint32_t	called;
+} steal_arg_t;
+
+static void
+task_count(void *arg)
+{
+	steal_ctx_t	*ctx = (steal_ctx_t *)arg;
+
+	pfc_atomic_inc_uint32(&ctx->ncalled);
+}
+
+static void
+task_record(void *arg)
+{
+	steal_arg_t	*sap = (steal_arg_t *)arg;
+	steal_ctx_t	*ctx = sap->ctx;
+	uint32_t	pos;
+
+	pos = pfc_atomic_inc_uint32_old(&ctx->norder);
+	ctx->order[pos] = sap->index;
+	sap->called++;
+	pfc_atomic_inc_uint32(&ctx->ncalled);
+}
+
+static void
+dtor_record(void *arg)
+{
+	steal_arg_t	*sap = (steal_arg_t *)arg;
+
+	pfc_atomic_inc_uint32(&sap->ctx->ndtor);
+}
+
+static void
+task_spawn(void *arg)
+{
+	steal_ctx_t	*ctx = (steal_ctx_t *)arg;
+	pfc_task_t	tid;
+	uint32_t	i;
+
+	for (i = 0; i < ctx->nchildren; i++) {
+		EXPECT_EQ(0, pfc_taskq_dispatch(ctx->tq, task_count, ctx, 0,
+						&tid));
+	}
+}
+
+static void
+ctx_init(steal_ctx_t *ctx)
+{
+	memset(ctx, 0, sizeof(*ctx));
+}
+
+static void
+wait_ncalled(steal_ctx_t *ctx, uint32_t count)
+{
+	uint64_t	limit = taskq_now_nsec() +
+		(uint64_t)TIMEOUT * (PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC);
+
+	while (ctx->ncalled < count && taskq_now_nsec() < limit) {
+		usleep(1000);
+	}
+	EXPECT_EQ(count, ctx->ncalled);
+}
+
+TEST(pfc_taskq_create_flags, error)
+{
+	pfc_taskq_t	tq;
+
+	EXPECT_EQ(EINVAL, pfc_taskq_create_flags(&tq, NULL, 4, 0x80));
+	EXPECT_EQ(EINVAL, pfc_taskq_create_flags(&tq, NULL, 0,
+						 PFC_TASKQ_CF_STEAL));
+	EXPECT_EQ(EINVAL, pfc_taskq_create_flags(&tq, NULL, 100000,
+						 PFC_TASKQ_CF_STEAL));
+
+	ASSERT_EQ(0, pfc_taskq_create_flags(&tq, NULL, 1, 0));
+	EXPECT_EQ(0, pfc_taskq_destroy(tq));
+	ASSERT_EQ(0, pfc_taskq_create_flags(&tq, NULL, 1,
+					    PFC_TASKQ_CF_STEAL));
+	EXPECT_EQ(0, pfc_taskq_destroy(tq));
+}
+
+/*
+ * A work-stealing taskq with concurrency 1 must keep FIFO order.
+ */
+TEST(pfc_taskq_steal, fifo)
+{
+	static steal_ctx_t	ctx;
+	static steal_arg_t	args[TASKQ_NTASKS];
+	pfc_task_t		tid;
+	uint32_t		i;
+
+	ctx_init(&ctx);
+	ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL, 1,
+					    PFC_TASKQ_CF_STEAL));
+	for (i = 0; i < TASKQ_NTASKS; i++) {
+		args[i].ctx = &ctx;
+		args[i].index = i;
+		args[i].called = 0;
+		ASSERT_EQ(0, pfc_taskq_dispatch(ctx.tq, task_record, &args[i],
+						0, &tid));
+	}
+
+	ASSERT_EQ(0, pfc_taskq_flush(ctx.tq, &timeout_taskq_));
+	ASSERT_EQ(static_cast<uint32_t>(TASKQ_NTASKS), ctx.ncalled);
+	for (i = 0; i < TASKQ_NTASKS; i++) {
+		ASSERT_EQ(i, ctx.order[i]);
+	}
+	EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+}
+
+/*
+ * All tasks dispatched before flush must be executed exactly once.
+ */
+TEST(pfc_taskq_steal, flush)
+{
+	static steal_ctx_t	ctx;
+	static steal_arg_t	args[TASKQ_NTASKS];
+	static const uint32_t	concurrency[] = {2, 4, 16};
+	pfc_task_t		tid;
+	uint32_t		c, i;
+
+	for (c = 0; c < PFC_ARRAY_CAPACITY(concurrency); c++) {
+		ctx_init(&ctx);
+		ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL,
+						    concurrency[c],
+						    PFC_TASKQ_CF_STEAL));
+		for (i = 0; i < TASKQ_NTASKS; i++) {
+			args[i].ctx = &ctx;
+			args[i].index = i;
+			args[i].called = 0;
+			ASSERT_EQ(0, pfc_taskq_dispatch_dtor(ctx.tq,
+							     task_record,
+							     &args[i],
+							     dtor_record, 0,
+							     &tid));
+		}
+
+		ASSERT_EQ(0, pfc_taskq_flush(ctx.tq, &timeout_taskq_));
+		ASSERT_EQ(static_cast<uint32_t>(TASKQ_NTASKS), ctx.ncalled);
+		ASSERT_EQ(static_cast<uint32_t>(TASKQ_NTASKS), ctx.ndtor);
+		for (i = 0; i < TASKQ_NTASKS; i++) {
+			ASSERT_EQ(1U, args[i].called);
+		}
+
+		// Flush on an empty taskq.
+		ASSERT_EQ(0, pfc_taskq_flush(ctx.tq, &timeout_taskq_));
+		EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+	}
+}
+
+TEST(pfc_taskq_steal, join)
+{
+	static steal_ctx_t	ctx;
+	static steal_arg_t	args[TASKQ_NTASKS];
+	static pfc_task_t	tids[TASKQ_NTASKS];
+	uint32_t		i;
+
+	ctx_init(&ctx);
+	ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL, 4,
+					    PFC_TASKQ_CF_STEAL));
+	for (i = 0; i < TASKQ_NTASKS; i++) {
+		args[i].ctx = &ctx;
+		args[i].index = i;
+		args[i].called = 0;
+		ASSERT_EQ(0, pfc_taskq_dispatch_dtor(ctx.tq, task_record,
+						     &args[i], dtor_record,
+						     PFC_TASKQ_JOINABLE,
+						     &tids[i]));
+	}
+
+	for (i = 0; i < TASKQ_NTASKS; i++) {
+		ASSERT_EQ(0, pfc_taskq_timedjoin(ctx.tq, tids[i],
+						 &timeout_taskq_));
+		ASSERT_EQ(1U, args[i].called);
+	}
+	EXPECT_EQ(static_cast<uint32_t>(TASKQ_NTASKS), ctx.ndtor);
+
+	// Joined task no longer exists.
+	EXPECT_EQ(ESRCH, pfc_taskq_join(ctx.tq, tids[0]));
+	EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+}
+
+TEST(pfc_taskq_steal, cancel)
+{
+	static steal_ctx_t	ctx;
+	static steal_arg_t	args[TASKQ_NTASKS];
+	static pfc_task_t	tids[TASKQ_NTASKS];
+	taskq_gate_t		gate;
+	pfc_task_t		gtids[2];
+	const uint32_t		ntasks = 100;
+	uint32_t		i, ncanceled = 0;
+
+	ctx_init(&ctx);
+	gate_init(&gate);
+	ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL, 2,
+					    PFC_TASKQ_CF_STEAL));
+
+	// Block all dispatcher threads.
+	for (i = 0; i < 2; i++) {
+		ASSERT_EQ(0, pfc_taskq_dispatch(ctx.tq, task_gate, &gate,
+						PFC_TASKQ_JOINABLE,
+						&gtids[i]));
+	}
+	gate_wait_blocked(&gate, 2);
+
+	for (i = 0; i < ntasks; i++) {
+		args[i].ctx = &ctx;
+		args[i].index = i;
+		args[i].called = 0;
+		ASSERT_EQ(0, pfc_taskq_dispatch_dtor(ctx.tq, task_record,
+						     &args[i], dtor_record, 0,
+						     &tids[i]));
+	}
+
+	// Running task can not be canceled.
+	EXPECT_EQ(EBUSY, pfc_taskq_cancel(ctx.tq, gtids[0]));
+
+	for (i = 0; i < ntasks; i += 2) {
+		ASSERT_EQ(0, pfc_taskq_cancel(ctx.tq, tids[i]));
+		ncanceled++;
+	}
+	EXPECT_EQ(ncanceled, ctx.ndtor);
+
+	gate_open(&gate);
+	ASSERT_EQ(0, pfc_taskq_flush(ctx.tq, &timeout_taskq_));
+	for (i = 0; i < ntasks; i++) {
+		ASSERT_EQ((i & 1) ? 1U : 0U, args[i].called);
+	}
+	EXPECT_EQ(ntasks - ncanceled, ctx.ncalled);
+	EXPECT_EQ(ntasks, ctx.ndtor);
+
+	for (i = 0; i < 2; i++) {
+		EXPECT_EQ(0, pfc_taskq_join(ctx.tq, gtids[i]));
+	}
+	EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+	gate_destroy(&gate);
+}
+
+static void *
+gate_opener(void *arg)
+{
+	usleep(100000);
+	gate_open((taskq_gate_t *)arg);
+
+	return NULL;
+}
+
+TEST(pfc_taskq_steal, clear)
+{
+	static steal_ctx_t	ctx;
+	static steal_arg_t	args[TASKQ_NTASKS];
+	taskq_gate_t		gate;
+	pfc_task_t		tid;
+	pthread_t		thread;
+	const uint32_t		ntasks = 100;
+	uint32_t		i;
+
+	ctx_init(&ctx);
+	gate_init(&gate);
+	ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL, 4,
+					    PFC_TASKQ_CF_STEAL));
+
+	// Block all dispatcher threads.
+	for (i = 0; i < 4; i++) {
+		ASSERT_EQ(0, pfc_taskq_dispatch(ctx.tq, task_gate, &gate, 0,
+						&tid));
+	}
+	gate_wait_blocked(&gate, 4);
+
+	for (i = 0; i < ntasks; i++) {
+		args[i].ctx = &ctx;
+		args[i].index = i;
+		args[i].called = 0;
+		ASSERT_EQ(0, pfc_taskq_dispatch_dtor(ctx.tq, task_record,
+						     &args[i], dtor_record, 0,
+						     &tid));
+	}
+
+	// pfc_taskq_clear() waits for running tasks.
+	ASSERT_EQ(0, pthread_create(&thread, NULL, gate_opener, &gate));
+	ASSERT_EQ(0, pfc_taskq_clear(ctx.tq, &timeout_taskq_));
+	ASSERT_EQ(0, pthread_join(thread, NULL));
+
+	EXPECT_EQ(0U, ctx.ncalled);
+	EXPECT_EQ(ntasks, ctx.ndtor);
+
+	// The taskq is still available.
+	ASSERT_EQ(0, pfc_taskq_dispatch(ctx.tq, task_count, &ctx, 0, &tid));
+	ASSERT_EQ(0, pfc_taskq_flush(ctx.tq, &timeout_taskq_));
+	EXPECT_EQ(1U, ctx.ncalled);
+
+	EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+	gate_destroy(&gate);
+}
+
+/*
+ * Tasks dispatched by a running task are queued on the worker queue of
+ * the calling thread, and must be taken by other threads.
+ */
+TEST(pfc_taskq_steal, nested)
+{
+	static steal_ctx_t	ctx;
+	pfc_task_t		tid;
+	const uint32_t		nparents = 8;
+	uint32_t		i;
+
+	ctx_init(&ctx);
+	ctx.nchildren = TASKQ_NTASKS / nparents;
+	ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL, 4,
+					    PFC_TASKQ_CF_STEAL));
+	for (i = 0; i < nparents; i++) {
+		ASSERT_EQ(0, pfc_taskq_dispatch(ctx.tq, task_spawn, &ctx, 0,
+						&tid));
+	}
+
+	wait_ncalled(&ctx, nparents * ctx.nchildren);
+	EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+}
+
+/*
+ * Destroying a taskq must release queued tasks.
+ */
+TEST(pfc_taskq_steal, destroy)
+{
+	static steal_ctx_t	ctx;
+	static steal_arg_t	args[TASKQ_NTASKS];
+	taskq_gate_t		gate;
+	pfc_task_t		tid;
+	pthread_t		thread;
+	const uint32_t		ntasks = 100;
+	uint32_t		i;
+
+	ctx_init(&ctx);
+	gate_init(&gate);
+	ASSERT_EQ(0, pfc_taskq_create_flags(&ctx.tq, NULL, 2,
+					    PFC_TASKQ_CF_STEAL));
+	for (i = 0; i < 2; i++) {
+		ASSERT_EQ(0, pfc_taskq_dispatch(ctx.tq, task_gate, &gate, 0,
+						&tid));
+	}
+	gate_wait_blocked(&gate, 2);
+
+	for (i = 0; i < ntasks; i++) {
+		args[i].ctx = &ctx;
+		args[i].index = i;
+		args[i].called = 0;
+		ASSERT_EQ(0, pfc_taskq_dispatch_dtor(ctx.tq, task_record,
+						     &args[i], dtor_record, 0,
+						     &tid));
+	}
+
+	ASSERT_EQ(0, pthread_create(&thread, NULL, gate_opener, &gate));
+	EXPECT_EQ(0, pfc_taskq_destroy(ctx.tq));
+	ASSERT_EQ(0, pthread_join(thread, NULL));
+
+	// Destructor is called for both executed and discarded tasks.
+	EXPECT_GE(ntasks, ctx.ncalled);
+	EXPECT_EQ(ntasks, ctx.ndtor);
+	gate_destroy(&gate);
+}
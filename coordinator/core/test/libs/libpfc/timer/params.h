@@ -15,3 +15,7 @@
 
 // Timeout value for tests of some APIs [milliseconds]
 #define TIMEOUT  300
+
+// The number of concurrent timeouts posted by wheel tests and benchmarks
+#define WHEEL_NTIMEOUTS 1000
+#define BENCH_NTIMEOUTS 100000
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * Benchmark of timer with BENCH_NTIMEOUTS concurrent timeouts.
+ *
+ * The red-black tree timer and the timing wheel timer are compared.
+ *   - arm and cancel are the average cost of pfc_timer_post() and
+ *     pfc_timer_cancel() while all timeouts are pending.
+ *   - Lateness is the time from the expiry of a timeout to the start of
+ *     its task function.
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pfc/atomic.h>
+#include "test_timer_common.h"
+
+typedef struct bench_timeout {
+	uint64_t	deadline;
+	uint64_t	lateness;
+	pfc_timeout_t	toid;
+} bench_timeout_t;
+
+typedef struct bench_result {
+	uint64_t	arm;
+	uint64_t	cancel;
+	uint64_t	late_avg;
+	uint64_t	late_p99;
+	uint64_t	late_max;
+} bench_result_t;
+
+static bench_timeout_t	bench_timeouts[BENCH_NTIMEOUTS];
+static uint32_t		bench_index[BENCH_NTIMEOUTS];
+static uint64_t		bench_lateness[BENCH_NTIMEOUTS];
+static uint32_t		bench_called;
+
+static uint64_t
+bench_now_nsec(void)
+{
+	pfc_timespec_t	ts;
+
+	PFC_ASSERT_INT(pfc_clock_gettime(&ts), 0);
+
+	return (uint64_t)ts.tv_sec * PFC_CLOCK_NANOSEC + ts.tv_nsec;
+}
+
+static void
+bench_callback(void *arg)
+{
+	bench_timeout_t	*btp = (bench_timeout_t *)arg;
+	uint64_t	now = bench_now_nsec();
+
+	btp->lateness = (now > btp->deadline) ? now - btp->deadline : 0;
+	pfc_atomic_inc_uint32(&bench_called);
+}
+
+static int
+lateness_compare(const void *a, const void *b)
+{
+	uint64_t	la = *(const uint64_t *)a;
+	uint64_t	lb = *(const uint64_t *)b;
+
+	return (la < lb) ? -1 : (la > lb) ? 1 : 0;
+}
+
+static void
+bench_post(pfc_timer_t tid, bench_timeout_t *btp, uint64_t msec)
+{
+	pfc_timespec_t	tout;
+
+	tout.tv_sec = msec / PFC_CLOCK_MILLISEC;
+	tout.tv_nsec = (msec % PFC_CLOCK_MILLISEC) *
+		(PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC);
+	btp->deadline = bench_now_nsec() + msec *
+		(PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC);
+	ASSERT_EQ(0, pfc_timer_post(tid, &tout, bench_callback, btp,
+				    &btp->toid));
+}
+
+static void
+bench_run(uint32_t flags, bench_result_t *resp)
+{
+	pfc_taskq_t	tq;
+	pfc_timer_t	tid;
+	uint64_t	start, sum, limit;
+	uint32_t	i, seed = 1;
+
+	ASSERT_EQ(0, pfc_taskq_create(&tq, NULL, TASKQ_THREADS));
+	ASSERT_EQ(0, pfc_timer_create_flags(&tid, NULL, tq, NULL, flags));
+
+	// Arm timeouts which never expire during the measurement, and
+	// cancel them in random order.
+	start = bench_now_nsec();
+	for (i = 0; i < BENCH_NTIMEOUTS; i++) {
+		bench_post(tid, &bench_timeouts[i],
+			   10000 + rand_r(&seed) % 3600000);
+	}
+	resp->arm = (bench_now_nsec() - start) / BENCH_NTIMEOUTS;
+
+	for (i = 0; i < BENCH_NTIMEOUTS; i++) {
+		bench_index[i] = i;
+	}
+	for (i = BENCH_NTIMEOUTS - 1; i > 0; i--) {
+		uint32_t	j = rand_r(&seed) % (i + 1);
+		uint32_t	tmp = bench_index[i];
+
+		bench_index[i] = bench_index[j];
+		bench_index[j] = tmp;
+	}
+
+	start = bench_now_nsec();
+	for (i = 0; i < BENCH_NTIMEOUTS; i++) {
+		bench_timeout_t	*btp = &bench_timeouts[bench_index[i]];
+
+		ASSERT_EQ(0, pfc_timer_cancel(tid, btp->toid));
+	}
+	resp->cancel = (bench_now_nsec() - start) / BENCH_NTIMEOUTS;
+
+	// Let timeouts expire within one second.
+	bench_called = 0;
+	for (i = 0; i < BENCH_NTIMEOUTS; i++) {
+		bench_post(tid, &bench_timeouts[i], 200 + i % 1000);
+	}
+
+	limit = bench_now_nsec() + (uint64_t)TIMEOUT * 100 *
+		(PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC);
+	while (bench_called < BENCH_NTIMEOUTS) {
+		ASSERT_LT(bench_now_nsec(), limit);
+		usleep(10000);
+	}
+
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+
+	sum = 0;
+	for (i = 0; i < BENCH_NTIMEOUTS; i++) {
+		bench_lateness[i] = bench_timeouts[i].lateness;
+		sum += bench_lateness[i];
+	}
+	qsort(bench_lateness, BENCH_NTIMEOUTS, sizeof(bench_lateness[0]),
+	      lateness_compare);
+	resp->late_avg = sum / BENCH_NTIMEOUTS;
+	resp->late_p99 = bench_lateness[(BENCH_NTIMEOUTS * 99) / 100];
+	resp->late_max = bench_lateness[BENCH_NTIMEOUTS - 1];
+}
+
+TEST(pfc_timer_bench, timeout)
+{
+	static const struct {
+		const char	*name;
+		uint32_t	flags;
+	} sched[] = {
+		{ "rbtree", 0 },
+		{ "wheel", PFC_TIMER_CF_WHEEL },
+	};
+	uint32_t	s;
+
+	printf("%-8s %10s %10s %12s %12s %12s\n", "timer", "arm(ns)",
+	       "cancel(ns)", "late-avg(ms)", "late-p99(ms)", "late-max(ms)");
+	for (s = 0; s < PFC_ARRAY_CAPACITY(sched); s++) {
+		bench_result_t	res;
+
+		memset(&res, 0, sizeof(res));
+		bench_run(sched[s].flags, &res);
+		if (HasFatalFailure()) {
+			return;
+		}
+
+		printf("%-8s %10llu %10llu %12.1f %12.1f %12.1f\n",
+		       sched[s].name, (unsigned long long)res.arm,
+		       (unsigned long long)res.cancel,
+		       res.late_avg / 1000000.0, res.late_p99 / 1000000.0,
+		       res.late_max / 1000000.0);
+	}
+}
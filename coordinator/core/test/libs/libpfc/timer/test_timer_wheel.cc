@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2010-2014 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * Tests for the timer created with PFC_TIMER_CF_WHEEL.
+ */
+
+#include <gtest/gtest.h>
+#include <pfc/atomic.h>
+#include "test_timer_common.h"
+
+// Timer granularity [nanoseconds]
+#define WHEEL_TICK_NSEC		(100 * (PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC))
+
+// Maximum time to wait for timeouts [seconds]
+#define WHEEL_WAIT_SEC		60
+
+typedef struct wheel_count {
+	uint32_t	called;
+	uint32_t	destroyed;
+	uint32_t	early;
+} wheel_count_t;
+
+typedef struct wheel_timeout {
+	wheel_count_t	*count;
+	uint64_t	deadline;
+	pfc_timeout_t	toid;
+} wheel_timeout_t;
+
+static uint64_t
+wheel_now_nsec(void)
+{
+	pfc_timespec_t	ts;
+
+	PFC_ASSERT_INT(pfc_clock_gettime(&ts), 0);
+
+	return (uint64_t)ts.tv_sec * PFC_CLOCK_NANOSEC + ts.tv_nsec;
+}
+
+static void
+wheel_callback(void *arg)
+{
+	wheel_timeout_t	*wtp = (wheel_timeout_t *)arg;
+
+	// Expiry tick is rounded down to the timer granularity.
+	if (wheel_now_nsec() + WHEEL_TICK_NSEC < wtp->deadline) {
+		pfc_atomic_inc_uint32(&wtp->count->early);
+	}
+	pfc_atomic_inc_uint32(&wtp->count->called);
+}
+
+static void
+wheel_dtor(void *arg)
+{
+	wheel_timeout_t	*wtp = (wheel_timeout_t *)arg;
+
+	pfc_atomic_inc_uint32(&wtp->count->destroyed);
+}
+
+static void
+wheel_create(pfc_taskq_t *tqp, pfc_timer_t *tidp)
+{
+	ASSERT_EQ(0, pfc_taskq_create(tqp, NULL, TASKQ_THREADS));
+	ASSERT_EQ(0, pfc_timer_create_flags(tidp, NULL, *tqp, NULL,
+					    PFC_TIMER_CF_WHEEL));
+}
+
+static void
+wheel_post(pfc_timer_t tid, wheel_timeout_t *wtp, wheel_count_t *count,
+	   uint64_t msec)
+{
+	pfc_timespec_t	tout;
+
+	tout.tv_sec = msec / PFC_CLOCK_MILLISEC;
+	tout.tv_nsec = (msec % PFC_CLOCK_MILLISEC) *
+		(PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC);
+	wtp->count = count;
+	wtp->deadline = wheel_now_nsec() + msec *
+		(PFC_CLOCK_NANOSEC / PFC_CLOCK_MILLISEC);
+	ASSERT_EQ(0, pfc_timer_post_dtor(tid, &tout, wheel_callback, wtp,
+					 wheel_dtor, &wtp->toid));
+}
+
+static void
+wheel_wait(wheel_count_t *count, uint32_t called, uint32_t destroyed)
+{
+	uint64_t	limit;
+
+	limit = wheel_now_nsec() + (uint64_t)WHEEL_WAIT_SEC * PFC_CLOCK_NANOSEC;
+	while (count->called < called || count->destroyed < destroyed) {
+		ASSERT_LT(wheel_now_nsec(), limit);
+		usleep(10000);
+	}
+}
+
+TEST(pfc_timer_wheel, create)
+{
+	pfc_taskq_t	tq;
+	pfc_timer_t	tid;
+
+	ASSERT_EQ(0, pfc_taskq_create(&tq, NULL, TASKQ_THREADS));
+
+	// Invalid flags.
+	ASSERT_EQ(EINVAL, pfc_timer_create_flags(&tid, NULL, tq, NULL, 0x2));
+	ASSERT_EQ(EINVAL, pfc_timer_create_flags(&tid, NULL, tq, &ts_invalid,
+						 PFC_TIMER_CF_WHEEL));
+
+	ASSERT_EQ(0, pfc_timer_create_flags(&tid, NULL, tq, &ts_100msec,
+					    PFC_TIMER_CF_WHEEL));
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+	ASSERT_EQ(0, pfc_timer_create_flags(&tid, NULL, tq, NULL, 0));
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+}
+
+TEST(pfc_timer_wheel, expire)
+{
+	static wheel_timeout_t	wt[WHEEL_NTIMEOUTS];
+	wheel_count_t	count = {0, 0, 0};
+	pfc_taskq_t	tq;
+	pfc_timer_t	tid;
+	uint32_t	i;
+
+	wheel_create(&tq, &tid);
+	for (i = 0; i < WHEEL_NTIMEOUTS; i++) {
+		wheel_post(tid, &wt[i], &count, (i % 10) * 100);
+	}
+
+	wheel_wait(&count, WHEEL_NTIMEOUTS, WHEEL_NTIMEOUTS);
+	ASSERT_EQ(0U, count.early);
+
+	// Expired timeouts can not be canceled.
+	for (i = 0; i < WHEEL_NTIMEOUTS; i++) {
+		ASSERT_EQ(ESRCH, pfc_timer_cancel(tid, wt[i].toid));
+	}
+
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+	ASSERT_EQ((uint32_t)WHEEL_NTIMEOUTS, count.called);
+	ASSERT_EQ((uint32_t)WHEEL_NTIMEOUTS, count.destroyed);
+}
+
+TEST(pfc_timer_wheel, cancel)
+{
+	static wheel_timeout_t	wt[WHEEL_NTIMEOUTS];
+	wheel_count_t	count = {0, 0, 0};
+	pfc_taskq_t	tq;
+	pfc_timer_t	tid;
+	uint32_t	i;
+
+	wheel_create(&tq, &tid);
+	for (i = 0; i < WHEEL_NTIMEOUTS; i++) {
+		wheel_post(tid, &wt[i], &count, 1000 + (i % 10) * 100);
+	}
+
+	// Cancel even timeouts. Destructor is called synchronously.
+	for (i = 0; i < WHEEL_NTIMEOUTS; i += 2) {
+		ASSERT_EQ(0, pfc_timer_cancel(tid, wt[i].toid));
+	}
+	ASSERT_EQ((uint32_t)WHEEL_NTIMEOUTS / 2, count.destroyed);
+	for (i = 0; i < WHEEL_NTIMEOUTS; i += 2) {
+		ASSERT_EQ(ESRCH, pfc_timer_cancel(tid, wt[i].toid));
+	}
+	ASSERT_EQ(ESRCH, pfc_timer_cancel(tid, PFC_TIMER_INVALID_TIMEOUTID));
+
+	wheel_wait(&count, WHEEL_NTIMEOUTS / 2, WHEEL_NTIMEOUTS);
+	ASSERT_EQ(0U, count.early);
+
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+	ASSERT_EQ((uint32_t)WHEEL_NTIMEOUTS / 2, count.called);
+	ASSERT_EQ((uint32_t)WHEEL_NTIMEOUTS, count.destroyed);
+}
+
+TEST(pfc_timer_wheel, destroy)
+{
+	static wheel_timeout_t	wt[WHEEL_NTIMEOUTS];
+	wheel_count_t	count = {0, 0, 0};
+	pfc_taskq_t	tq;
+	pfc_timer_t	tid;
+	uint32_t	i;
+
+	wheel_create(&tq, &tid);
+
+	// Timeouts linked to the root wheel, upper level wheels, and the
+	// farthest slot.
+	for (i = 0; i < WHEEL_NTIMEOUTS; i++) {
+		uint64_t	msec;
+
+		switch (i % 3) {
+		case 0:
+			msec = 10000;
+			break;
+		case 1:
+			msec = 3600 * PFC_CLOCK_MILLISEC;
+			break;
+		default:
+			msec = (uint64_t)20 * 365 * 86400 * PFC_CLOCK_MILLISEC;
+			break;
+		}
+		wheel_post(tid, &wt[i], &count, msec);
+	}
+
+	// Destructors are called by pfc_timer_destroy().
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+	ASSERT_EQ(0U, count.called);
+	ASSERT_EQ((uint32_t)WHEEL_NTIMEOUTS, count.destroyed);
+
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+}
+
+TEST(pfc_timer_wheel, cascade)
+{
+	static wheel_timeout_t	wt[3];
+	wheel_count_t	count = {0, 0, 0};
+	pfc_taskq_t	tq;
+	pfc_timer_t	tid;
+
+	wheel_create(&tq, &tid);
+
+	// The last timeout is beyond the root wheel, and it must be moved
+	// to the root wheel before it expires.
+	wheel_post(tid, &wt[0], &count, 0);
+	wheel_post(tid, &wt[1], &count, 500);
+	wheel_post(tid, &wt[2], &count, 26000);
+
+	wheel_wait(&count, 3, 3);
+	ASSERT_EQ(0U, count.early);
+
+	ASSERT_EQ(0, pfc_timer_destroy(tid));
+	ASSERT_EQ(0, pfc_taskq_destroy(tq));
+}
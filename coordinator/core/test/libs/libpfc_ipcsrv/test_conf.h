@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2010-2013 NEC Corporation
+ * All rights reserved.
+ * 
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <pfc/base.h>
+#include <pfc/refptr.h>
+#include <pfc/conf.h>
+
+#include "conf_impl.h"
+
+PFC_C_BEGIN_DECL
+
+extern int test_sysconf_init(const char *conffile);
+
+PFC_C_END_DECL
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * test_session_pool.cc - Test for IPC server sessions dispatched by
+ *			  the pool of session workers.
+ */
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <set>
+#include <pfc/log.h>
+#include <pfc/synch.h>
+#include <pfc/clock.h>
+#include <pfc/ipc_server.h>
+#include <pfc/ipc_client.h>
+#include "test_conf.h"
+
+/*
+ * IPC channel name. "workers" for this channel is defined in pfcd.conf.
+ */
+#define	POOL_CHANNEL		"ipcsrv_test"
+#define	POOL_WORKERS		2U
+
+/*
+ * IPC service name.
+ */
+#define	POOL_SERVICE		"pool"
+
+/*
+ * IPC service IDs.
+ */
+#define	POOL_SVID_ECHO		0U	/* return argument + 1 */
+#define	POOL_SVID_SLEEP		1U	/* sleep a while */
+#define	POOL_NSERVICES		2U
+
+/*
+ * Time to sleep in POOL_SVID_SLEEP, in milliseconds.
+ */
+#define	POOL_SLEEP_MSEC		50U
+
+/*
+ * Client session timeout, in seconds.
+ */
+#define	POOL_TIMEOUT		10
+
+extern "C" {
+extern void libpfc_init();
+extern void libpfc_fini();
+}
+
+class TestEnvironment : public ::testing::Environment {
+    protected:
+	virtual void SetUp() {
+		pfc_log_init("gtest", stderr, PFC_LOGLVL_NOTICE, NULL);
+		test_sysconf_init("./pfcd.conf");
+		libpfc_init();
+	}
+	virtual void TearDown() {
+		pfc_log_fini();
+		libpfc_fini();
+	}
+};
+
+::testing::Environment  *global_env =
+	  ::testing::AddGlobalTestEnvironment(new TestEnvironment());
+
+/*
+ * Statistics of IPC service handler calls.
+ */
+static pfc_mutex_t	pool_mutex = PFC_MUTEX_INITIALIZER;
+static uint32_t		pool_running;
+static uint32_t		pool_max_running;
+static std::set<pthread_t>	pool_threads;
+
+static void
+pool_stat_reset(void)
+{
+	pfc_mutex_lock(&pool_mutex);
+	pool_running = 0;
+	pool_max_running = 0;
+	pool_threads.clear();
+	pfc_mutex_unlock(&pool_mutex);
+}
+
+static pfc_ipcresp_t
+pool_handler(pfc_ipcsrv_t *srv, pfc_ipcid_t service, pfc_ptr_t arg)
+{
+	pfc_mutex_lock(&pool_mutex);
+	pool_running++;
+	if (pool_running > pool_max_running) {
+		pool_max_running = pool_running;
+	}
+	pool_threads.insert(pthread_self());
+	pfc_mutex_unlock(&pool_mutex);
+
+	pfc_ipcresp_t	resp(0);
+	if (service == POOL_SVID_ECHO) {
+		uint32_t	value;
+
+		if (pfc_ipcsrv_getarg_uint32(srv, 0, &value) != 0 ||
+		    pfc_ipcsrv_output_uint32(srv, value + 1) != 0) {
+			resp = -1;
+		}
+	}
+	else {
+		(void)usleep(POOL_SLEEP_MSEC * 1000);
+	}
+
+	pfc_mutex_lock(&pool_mutex);
+	pool_running--;
+	pfc_mutex_unlock(&pool_mutex);
+
+	return resp;
+}
+
+/*
+ * Test fixture which runs the IPC server in a background thread.
+ * The IPC channel can not be initialized twice in a process, so it is
+ * shared by all tests.
+ */
+class IpcSrvPoolTest : public ::testing::Test {
+    protected:
+	static void SetUpTestCase() {
+		if (geteuid() != 0) {
+			return;
+		}
+
+		ASSERT_EQ(0, pfc_ipcsrv_init(POOL_CHANNEL, NULL));
+		ASSERT_EQ(0, pfc_ipcsrv_add_handler(POOL_SERVICE,
+						    POOL_NSERVICES,
+						    pool_handler, NULL));
+		ASSERT_EQ(0, pthread_create(&server_thread, NULL,
+					    server_main, NULL));
+		server_started = true;
+	}
+
+	static void TearDownTestCase() {
+		if (server_started) {
+			EXPECT_EQ(0, pfc_ipcsrv_fini());
+			EXPECT_EQ(0, pthread_join(server_thread, NULL));
+			server_started = false;
+		}
+	}
+
+	virtual void SetUp() {
+		pool_stat_reset();
+	}
+
+	static void *server_main(void *arg) {
+		(void)pfc_ipcsrv_main();
+		return NULL;
+	}
+
+	/*
+	 * Create a client session on the given connection.
+	 */
+	static pfc_ipcsess_t *createSession(pfc_ipcconn_t conn,
+					    pfc_ipcid_t service) {
+		pfc_ipcsess_t	*sess;
+		pfc_timespec_t	timeout = {POOL_TIMEOUT, 0};
+
+		if (pfc_ipcclnt_sess_altcreate(&sess, conn, POOL_SERVICE,
+					       service) != 0) {
+			return NULL;
+		}
+		if (pfc_ipcclnt_sess_settimeout(sess, &timeout) != 0) {
+			(void)pfc_ipcclnt_sess_destroy(sess);
+			return NULL;
+		}
+
+		return sess;
+	}
+
+	static pthread_t	server_thread;
+	static bool		server_started;
+};
+
+pthread_t	IpcSrvPoolTest::server_thread;
+bool		IpcSrvPoolTest::server_started;
+
+#define	SKIP_UNLESS_ROOT()						\
+	do {								\
+		if (geteuid() != 0) {					\
+			fprintf(stderr, "*** This test requires root "	\
+				"privilege.\n");			\
+			return;						\
+		}							\
+		ASSERT_TRUE(server_started);				\
+	} while (0)
+
+/*
+ * Client thread which invokes POOL_SVID_SLEEP on its own connection.
+ */
+#define	POOL_NCLIENTS		8U
+#define	POOL_NINVOKES		4U
+
+static void *
+pool_client_main(void *arg)
+{
+	uint32_t	*nerrors = reinterpret_cast<uint32_t *>(arg);
+	pfc_ipcconn_t	conn;
+
+	if (pfc_ipcclnt_altopen(POOL_CHANNEL, &conn) != 0) {
+		pfc_mutex_lock(&pool_mutex);
+		(*nerrors)++;
+		pfc_mutex_unlock(&pool_mutex);
+		return NULL;
+	}
+
+	pfc_ipcsess_t	*sess;
+	pfc_timespec_t	timeout = {POOL_TIMEOUT, 0};
+	uint32_t	errs(0);
+	if (pfc_ipcclnt_sess_altcreate(&sess, conn, POOL_SERVICE,
+				       POOL_SVID_SLEEP) != 0) {
+		errs++;
+	}
+	else {
+		if (pfc_ipcclnt_sess_settimeout(sess, &timeout) != 0) {
+			errs++;
+		}
+		for (uint32_t i = 0; errs == 0 && i < POOL_NINVOKES; i++) {
+			pfc_ipcresp_t	resp;
+
+			if (pfc_ipcclnt_sess_reset(sess, POOL_SERVICE,
+						   POOL_SVID_SLEEP) != 0 ||
+			    pfc_ipcclnt_sess_invoke(sess, &resp) != 0 ||
+			    resp != 0) {
+				errs++;
+			}
+		}
+		(void)pfc_ipcclnt_sess_destroy(sess);
+	}
+	(void)pfc_ipcclnt_altclose(conn);
+
+	if (errs != 0) {
+		pfc_mutex_lock(&pool_mutex);
+		(*nerrors) += errs;
+		pfc_mutex_unlock(&pool_mutex);
+	}
+
+	return NULL;
+}
+
+/*
+ * Commands on many sessions must be dispatched by at most "workers"
+ * threads at a time.
+ */
+TEST_F(IpcSrvPoolTest, workers_bounded)
+{
+	SKIP_UNLESS_ROOT();
+
+	pthread_t	threads[POOL_NCLIENTS];
+	uint32_t	nerrors(0);
+
+	for (uint32_t i = 0; i < POOL_NCLIENTS; i++) {
+		ASSERT_EQ(0, pthread_create(&threads[i], NULL,
+					    pool_client_main, &nerrors));
+	}
+	for (uint32_t i = 0; i < POOL_NCLIENTS; i++) {
+		ASSERT_EQ(0, pthread_join(threads[i], NULL));
+	}
+
+	ASSERT_EQ(0U, nerrors);
+	ASSERT_LE(1U, pool_max_running);
+	ASSERT_GE(POOL_WORKERS, pool_max_running);
+	ASSERT_EQ(0U, pool_running);
+}
+
+/*
+ * Idle sessions do not occupy workers, so a session created after more
+ * than "workers" idle sessions must be served.
+ */
+TEST_F(IpcSrvPoolTest, idle_sessions)
+{
+	SKIP_UNLESS_ROOT();
+
+	const uint32_t	nidle(POOL_WORKERS * 3);
+	pfc_ipcconn_t	conns[POOL_WORKERS * 3];
+	pfc_ipcsess_t	*sessions[POOL_WORKERS * 3];
+
+	for (uint32_t i = 0; i < nidle; i++) {
+		pfc_ipcresp_t	resp;
+
+		ASSERT_EQ(0, pfc_ipcclnt_altopen(POOL_CHANNEL, &conns[i]));
+		sessions[i] = createSession(conns[i], POOL_SVID_SLEEP);
+		ASSERT_TRUE(sessions[i] != NULL);
+		ASSERT_EQ(0, pfc_ipcclnt_sess_invoke(sessions[i], &resp));
+		ASSERT_EQ(0, resp);
+	}
+
+	// All the above sessions are still connected, and waiting for
+	// the next command.
+	pfc_ipcconn_t	conn;
+	ASSERT_EQ(0, pfc_ipcclnt_altopen(POOL_CHANNEL, &conn));
+	pfc_ipcsess_t	*sess(createSession(conn, POOL_SVID_ECHO));
+	ASSERT_TRUE(sess != NULL);
+
+	pfc_ipcresp_t	resp;
+	uint32_t	value;
+	ASSERT_EQ(0, pfc_ipcclnt_output_uint32(sess, 10));
+	ASSERT_EQ(0, pfc_ipcclnt_sess_invoke(sess, &resp));
+	ASSERT_EQ(0, resp);
+	ASSERT_EQ(0, pfc_ipcclnt_getres_uint32(sess, 0, &value));
+	ASSERT_EQ(11U, value);
+
+	// Idle sessions are still available.
+	for (uint32_t i = 0; i < nidle; i++) {
+		ASSERT_EQ(0, pfc_ipcclnt_sess_reset(sessions[i], POOL_SERVICE,
+						    POOL_SVID_SLEEP));
+		ASSERT_EQ(0, pfc_ipcclnt_sess_invoke(sessions[i], &resp));
+		ASSERT_EQ(0, resp);
+	}
+	ASSERT_GE(POOL_WORKERS, pool_max_running);
+
+	ASSERT_EQ(0, pfc_ipcclnt_sess_destroy(sess));
+	ASSERT_EQ(0, pfc_ipcclnt_altclose(conn));
+	for (uint32_t i = 0; i < nidle; i++) {
+		ASSERT_EQ(0, pfc_ipcclnt_sess_destroy(sessions[i]));
+		ASSERT_EQ(0, pfc_ipcclnt_altclose(conns[i]));
+	}
+}
+
+/*
+ * A pooled session must be re-armed after each command.
+ */
+TEST_F(IpcSrvPoolTest, multiple_invokes)
+{
+	SKIP_UNLESS_ROOT();
+
+	pfc_ipcconn_t	conn;
+	ASSERT_EQ(0, pfc_ipcclnt_altopen(POOL_CHANNEL, &conn));
+	pfc_ipcsess_t	*sess(createSession(conn, POOL_SVID_ECHO));
+	ASSERT_TRUE(sess != NULL);
+
+	for (uint32_t i = 0; i < 32; i++) {
+		pfc_ipcresp_t	resp;
+		uint32_t	value;
+
+		ASSERT_EQ(0, pfc_ipcclnt_sess_reset(sess, POOL_SERVICE,
+						    POOL_SVID_ECHO));
+		ASSERT_EQ(0, pfc_ipcclnt_output_uint32(sess, i));
+		ASSERT_EQ(0, pfc_ipcclnt_sess_invoke(sess, &resp));
+		ASSERT_EQ(0, resp);
+		ASSERT_EQ(0, pfc_ipcclnt_getres_uint32(sess, 0, &value));
+		ASSERT_EQ(i + 1, value);
+	}
+
+	// Only session workers dispatch pooled sessions.
+	ASSERT_GE(POOL_WORKERS, static_cast<uint32_t>(pool_threads.size()));
+
+	ASSERT_EQ(0, pfc_ipcclnt_sess_destroy(sess));
+	ASSERT_EQ(0, pfc_ipcclnt_altclose(conn));
+}
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2016 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * tests for hash that's created with PFC_HASH_AUTOGROW and/or
+ * PFC_HASH_STRIPED flag
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pfc/hash.h>
+#include <pfc/thread.h>
+#include "test_hash.hh"
+
+
+/*
+ * Constants
+ */
+const uint32_t  nstripes = 16;
+const uint64_t  nentries = 10000;
+const int       mt_nthrs = 8;
+const uint64_t  mt_nentries = 4000;
+
+/*
+ * Value associated with the given key.
+ */
+#define KEY2VAL(key)    ((pfc_cptr_t)(uintptr_t)((key) * 3 + 1))
+
+/*
+ * Verify that all keys in [0, count) are in the hash, except keys which
+ * satisfy key % skip == 0 if skip is not zero.
+ */
+static void
+verify_entries (pfc_hash_t hash, uint64_t count, uint64_t skip)
+{
+    for (uint64_t key = 0; key < count; key++) {
+        pfc_cptr_t value;
+        int err = pfc_u64hash_get(hash, key, &value);
+        if (skip != 0 && (key % skip) == 0) {
+            ASSERT_EQ(ENOENT, err) << "key=" << key;
+        } else {
+            ASSERT_EQ(0, err) << "key=" << key;
+            ASSERT_EQ(KEY2VAL(key), value) << "key=" << key;
+        }
+    }
+}
+
+
+/*
+ * Test cases
+ */
+
+TEST(hash, opt_autogrow_put_get)
+{
+    pfc_hash_t hash;
+    pfc_hash_stats_t stats;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 31, PFC_HASH_AUTOGROW));
+    EXPECT_EQ(31U, pfc_hash_get_capacity(hash));
+
+    for (uint64_t key = 0; key < nentries; key++) {
+        ASSERT_EQ(0, pfc_u64hash_put(hash, key, KEY2VAL(key), 0));
+        ASSERT_EQ(EEXIST, pfc_u64hash_put(hash, key, KEY2VAL(key), 0));
+    }
+    EXPECT_EQ(nentries, pfc_hash_get_size(hash));
+
+    // The table must have grown, and keys must be reachable even if
+    // some buckets are not yet rehashed.
+    ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    EXPECT_EQ(nentries, stats.phs_nelems);
+    EXPECT_EQ(pfc_hash_get_capacity(hash), stats.phs_nbuckets);
+    EXPECT_GE(stats.phs_nbuckets * 2, nentries);
+    EXPECT_NE(0U, stats.phs_ngrows);
+    EXPECT_LE(stats.phs_load, 2.0);
+    EXPECT_NE(0U, stats.phs_maxchain);
+    verify_entries(hash, nentries, 0);
+
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_autogrow_remove_update)
+{
+    pfc_hash_t hash;
+    pfc_hash_stats_t stats;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 1, PFC_HASH_AUTOGROW));
+
+    for (uint64_t key = 0; key < nentries; key++) {
+        ASSERT_EQ(0, pfc_u64hash_update(hash, key, KEY2VAL(key + 1), 0));
+        ASSERT_EQ(0, pfc_u64hash_update(hash, key, KEY2VAL(key), 0));
+        if (key >= 7 && (key % 7) == 0) {
+            // Remove an entry which may still be in an old bucket.
+            ASSERT_EQ(0, pfc_u64hash_remove(hash, key - 7));
+            ASSERT_EQ(0, pfc_u64hash_put(hash, key - 7, KEY2VAL(key - 7), 0));
+        }
+    }
+    EXPECT_EQ(nentries, pfc_hash_get_size(hash));
+
+    for (uint64_t key = 0; key < nentries; key += 5) {
+        pfc_cptr_t value;
+        ASSERT_EQ(0, pfc_u64hash_delete(hash, key, &value));
+        ASSERT_EQ(KEY2VAL(key), value);
+    }
+    verify_entries(hash, nentries, 5);
+
+    // Removal never shrinks the table.
+    uint32_t capacity = pfc_hash_get_capacity(hash);
+    EXPECT_EQ(nentries - nentries / 5, pfc_hash_get_size(hash));
+    ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    EXPECT_EQ(capacity, stats.phs_nbuckets);
+
+    EXPECT_EQ(nentries - nentries / 5, pfc_hash_clear(hash));
+    EXPECT_EQ(0U, pfc_hash_get_size(hash));
+    ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    EXPECT_EQ(0U, stats.phs_rehashing);
+    EXPECT_EQ(0U, stats.phs_maxchain);
+    EXPECT_EQ(stats.phs_nbuckets, stats.phs_empty);
+
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_autogrow_iterator)
+{
+    pfc_hash_t hash;
+    pfc_hash_stats_t stats;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 7, PFC_HASH_AUTOGROW));
+
+    // Stop while rehashing is in progress.
+    uint64_t count = 0;
+    do {
+        ASSERT_EQ(0, pfc_u64hash_put(hash, count, KEY2VAL(count), 0));
+        count++;
+        ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    } while (stats.phs_rehashing == 0 && count < nentries);
+    ASSERT_NE(0U, stats.phs_rehashing);
+
+    // Iterator must see all entries exactly once.
+    uint8_t *seen = new uint8_t[count];
+    memset(seen, 0, count);
+    pfc_hashiter_t it = pfc_hashiter_get(hash);
+    ASSERT_TRUE(it != NULL);
+
+    uint64_t key, nseen = 0;
+    pfc_cptr_t value;
+    while (pfc_hashiter_uint64_next(it, &key, &value) == 0) {
+        ASSERT_LT(key, count);
+        ASSERT_EQ(0U, seen[key]);
+        ASSERT_EQ(KEY2VAL(key), value);
+        seen[key] = 1;
+        nseen++;
+    }
+    EXPECT_EQ(count, nseen);
+    delete[] seen;
+
+    ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    EXPECT_EQ(0U, stats.phs_rehashing);
+
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_autogrow_set_capacity)
+{
+    pfc_hash_t hash;
+    pfc_hash_stats_t stats;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 3, PFC_HASH_AUTOGROW));
+    for (uint64_t key = 0; key < 100; key++) {
+        ASSERT_EQ(0, pfc_u64hash_put(hash, key, KEY2VAL(key), 0));
+    }
+
+    ASSERT_EQ(0, pfc_hash_set_capacity(hash, 1000));
+    EXPECT_EQ(1000U, pfc_hash_get_capacity(hash));
+    ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    EXPECT_EQ(0U, stats.phs_rehashing);
+    verify_entries(hash, 100, 0);
+
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_autogrow_prime)
+{
+    pfc_hash_t hash;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 10,
+                                    PFC_HASH_AUTOGROW | PFC_HASH_PRIME));
+    EXPECT_EQ(7U, pfc_hash_get_capacity(hash));
+    for (uint64_t key = 0; key < 1000; key++) {
+        ASSERT_EQ(0, pfc_u64hash_put(hash, key, KEY2VAL(key), 0));
+    }
+
+    uint32_t capacity = pfc_hash_get_capacity(hash);
+    EXPECT_LT(7U, capacity);
+    for (uint32_t i = 2; i * i <= capacity; i++) {
+        ASSERT_NE(0U, capacity % i);
+    }
+    verify_entries(hash, 1000, 0);
+
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_autogrow_strhash)
+{
+    pfc_hash_t hash;
+    char key[32];
+
+    ASSERT_EQ(0, pfc_strhash_create(&hash, NULL, 1,
+                                    PFC_HASH_AUTOGROW | PFC_HASH_STRIPED));
+    EXPECT_EQ(nstripes, pfc_hash_get_capacity(hash));
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        snprintf(key, sizeof(key), "key-%u", i);
+        ASSERT_EQ(0, pfc_strhash_put(hash, key, KEY2VAL(i), 0));
+    }
+    EXPECT_LT(nstripes, pfc_hash_get_capacity(hash));
+    EXPECT_EQ(0U, pfc_hash_get_capacity(hash) % nstripes);
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        pfc_cptr_t value;
+        snprintf(key, sizeof(key), "key-%u", i);
+        ASSERT_EQ(0, pfc_strhash_get(hash, key, &value));
+        ASSERT_EQ(KEY2VAL(i), value);
+        if ((i & 1) == 0) {
+            ASSERT_EQ(0, pfc_strhash_remove(hash, key));
+        }
+    }
+    EXPECT_EQ(500U, pfc_hash_get_size(hash));
+
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_striped_capacity)
+{
+    pfc_hash_t hash;
+
+    // Number of buckets is rounded up to a multiple of lock stripes.
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 31, PFC_HASH_STRIPED));
+    EXPECT_EQ(32U, pfc_hash_get_capacity(hash));
+    ASSERT_EQ(0, pfc_hash_set_capacity(hash, 33));
+    EXPECT_EQ(48U, pfc_hash_get_capacity(hash));
+    EXPECT_EQ(EINVAL, pfc_hash_set_capacity(hash, PFC_HASH_MAX_NBUCKETS + 1));
+    pfc_hash_destroy(hash);
+
+    // PFC_HASH_STRIPED is ignored if PFC_HASH_NOLOCK or PFC_HASH_PRIME
+    // is specified.
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 31,
+                                    PFC_HASH_STRIPED | PFC_HASH_NOLOCK));
+    EXPECT_EQ(31U, pfc_hash_get_capacity(hash));
+    pfc_hash_destroy(hash);
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 32,
+                                    PFC_HASH_STRIPED | PFC_HASH_PRIME));
+    EXPECT_EQ(31U, pfc_hash_get_capacity(hash));
+    pfc_hash_destroy(hash);
+}
+
+TEST(hash, opt_striped_sync)
+{
+    pfc_hash_t hash;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 1,
+                                    PFC_HASH_STRIPED | PFC_HASH_AUTOGROW));
+
+    pfc_hash_wsync_begin(hash) {
+        for (uint64_t key = 0; key < 1000; key++) {
+            ASSERT_EQ(0, pfc_u64hash_put(hash, key, KEY2VAL(key), 0));
+        }
+    } pfc_hash_sync_end();
+
+    pfc_hash_rsync_begin(hash) {
+        pfc_hash_stats_t stats;
+
+        verify_entries(hash, 1000, 0);
+        ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+        EXPECT_EQ(1000U, stats.phs_nelems);
+    } pfc_hash_sync_end();
+
+    pfc_hash_destroy(hash);
+}
+
+
+/*
+ * Multi-thread test
+ */
+
+typedef struct {
+    pfc_hash_t  hash;
+    uint64_t    base;
+} mt_arg_t;
+
+static void *
+striped_mt_main (void *arg)
+{
+    mt_arg_t *mt = (mt_arg_t *)arg;
+    uintptr_t nerrors = 0;
+
+    for (uint64_t i = 0; i < mt_nentries; i++) {
+        uint64_t key = mt->base + i;
+        pfc_cptr_t value;
+
+        if (pfc_u64hash_put(mt->hash, key, KEY2VAL(key), 0) != 0) {
+            nerrors++;
+        }
+        if (pfc_u64hash_get(mt->hash, key, &value) != 0 ||
+            value != KEY2VAL(key)) {
+            nerrors++;
+        }
+        if ((i % 3) == 0 && i != 0) {
+            if (pfc_u64hash_remove(mt->hash, key - 3) != 0) {
+                nerrors++;
+            }
+        }
+    }
+
+    return (void *)nerrors;
+}
+
+TEST(hash, opt_striped_autogrow_mt)
+{
+    pfc_hash_t hash;
+    pfc_thread_t thr[mt_nthrs];
+    mt_arg_t args[mt_nthrs];
+    pfc_hash_stats_t stats;
+
+    ASSERT_EQ(0, pfc_u64hash_create(&hash, NULL, 1,
+                                    PFC_HASH_STRIPED | PFC_HASH_AUTOGROW));
+
+    for (int i = 0; i < mt_nthrs; i++) {
+        args[i].hash = hash;
+        args[i].base = mt_nentries * i;
+        ASSERT_EQ(0, pfc_thread_create(&thr[i], striped_mt_main,
+                                       &args[i], 0));
+    }
+    for (int i = 0; i < mt_nthrs; i++) {
+        void *status;
+        ASSERT_EQ(0, pfc_thread_join(thr[i], &status));
+        EXPECT_EQ((void *)0, status);
+    }
+
+    // Keys base + 3n (n < (mt_nentries - 1) / 3) have been removed.
+    uint64_t nremoved = (mt_nentries - 1) / 3;
+    EXPECT_EQ((mt_nentries - nremoved) * mt_nthrs, pfc_hash_get_size(hash));
+    for (int i = 0; i < mt_nthrs; i++) {
+        for (uint64_t n = 0; n < mt_nentries; n++) {
+            uint64_t key = args[i].base + n;
+            pfc_cptr_t value;
+            int err = pfc_u64hash_get(hash, key, &value);
+
+            if ((n % 3) == 0 && n < nremoved * 3) {
+                ASSERT_EQ(ENOENT, err) << "key=" << key;
+            } else {
+                ASSERT_EQ(0, err) << "key=" << key;
+                ASSERT_EQ(KEY2VAL(key), value);
+            }
+        }
+    }
+
+    ASSERT_EQ(0, pfc_hash_get_stats(hash, &stats));
+    EXPECT_EQ(pfc_hash_get_size(hash), stats.phs_nelems);
+    EXPECT_EQ(0U, stats.phs_nbuckets % nstripes);
+    EXPECT_NE(0U, stats.phs_ngrows);
+
+    pfc_hash_destroy(hash);
+}
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * test_iostream_passfd.cc - Test for file descriptor passing via
+ *			     pfc_iostream_t.
+ */
+
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <pfc/iostream.h>
+#include "iostream_impl.h"
+#include "misc.hh"
+
+/*
+ * Size of stream buffers.
+ */
+#define	PASSFD_BUFSIZE		64U
+
+/*
+ * Number of FDs kept by a stream. This must be the same as
+ * IOSTREAM_FDQ_SIZE in iostream.c.
+ */
+#define	PASSFD_FDQ_SIZE		4U
+
+/*
+ * Connected pair of streams. Data written to _sender is read from
+ * _receiver.
+ */
+class StreamPair
+{
+public:
+    StreamPair() : _sender(NULL), _receiver(NULL), _error(0)
+    {
+        int	sock[2];
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sock) != 0) {
+            _error = errno;
+            return;
+        }
+
+        _error = pfc_iostream_create(&_sender, sock[0], 0, PASSFD_BUFSIZE,
+                                     NULL);
+        if (_error != 0) {
+            (void)close(sock[0]);
+            (void)close(sock[1]);
+            return;
+        }
+
+        _error = pfc_iostream_create(&_receiver, sock[1], PASSFD_BUFSIZE, 0,
+                                     NULL);
+        if (_error != 0) {
+            (void)close(sock[1]);
+        }
+    }
+
+    ~StreamPair()
+    {
+        if (_sender != NULL) {
+            (void)pfc_iostream_destroy(_sender);
+        }
+        if (_receiver != NULL) {
+            (void)pfc_iostream_destroy(_receiver);
+        }
+    }
+
+    inline int
+    getError(void) const
+    {
+        return _error;
+    }
+
+    inline pfc_iostream_t
+    sender(void) const
+    {
+        return _sender;
+    }
+
+    inline pfc_iostream_t
+    receiver(void) const
+    {
+        return _receiver;
+    }
+
+    /*
+     * Send one byte `c' with the file descriptor `fd'.
+     */
+    int
+    sendfd(char c, int fd)
+    {
+        size_t	size(1);
+
+        return __pfc_iostream_sendfd_abs(_sender, &c, &size, fd, NULL);
+    }
+
+    /*
+     * Read exactly `size' bytes from the receiver stream.
+     */
+    int
+    readAll(char *buf, size_t size)
+    {
+        while (size > 0) {
+            size_t	sz(size);
+            int		err(pfc_iostream_read(_receiver, buf, &sz, NULL));
+
+            if (err != 0) {
+                return err;
+            }
+            if (sz == 0) {
+                return EPIPE;
+            }
+            buf += sz;
+            size -= sz;
+        }
+
+        return 0;
+    }
+
+private:
+    pfc_iostream_t	_sender;
+    pfc_iostream_t	_receiver;
+    int			_error;
+};
+
+/*
+ * Pipe which is closed by destructor.
+ */
+class Pipe
+{
+public:
+    Pipe()
+    {
+        if (pipe(_fd) != 0) {
+            _fd[0] = _fd[1] = -1;
+        }
+    }
+
+    ~Pipe()
+    {
+        closeReader();
+        closeWriter();
+    }
+
+    inline bool
+    isOpen(void) const
+    {
+        return (_fd[0] != -1);
+    }
+
+    inline int
+    reader(void) const
+    {
+        return _fd[0];
+    }
+
+    inline int
+    writer(void) const
+    {
+        return _fd[1];
+    }
+
+    inline void
+    closeReader(void)
+    {
+        if (_fd[0] != -1) {
+            (void)close(_fd[0]);
+            _fd[0] = -1;
+        }
+    }
+
+    inline int
+    closeWriter(void)
+    {
+        int	ret(0);
+
+        if (_fd[1] != -1) {
+            ret = close(_fd[1]);
+            _fd[1] = -1;
+        }
+
+        return ret;
+    }
+
+    /*
+     * Return true if no one keeps the write end of the pipe.
+     */
+    bool
+    isWriterClosed(void)
+    {
+        char	c;
+
+        return (closeWriter() == 0 && read(_fd[0], &c, 1) == 0);
+    }
+
+private:
+    int		_fd[2];
+};
+
+/*
+ * Return true if the given two file descriptors refer the same file.
+ */
+static bool
+is_same_file(int fd1, int fd2)
+{
+    struct stat	st1, st2;
+
+    if (fstat(fd1, &st1) != 0 || fstat(fd2, &st2) != 0) {
+        return false;
+    }
+
+    return (st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino);
+}
+
+/*
+ * Enabling FD passing on a stream which is not a socket.
+ */
+TEST(iostream, passfd_notsock)
+{
+    int	pfd[2];
+
+    ASSERT_EQ(0, pipe(pfd));
+    FdRef	wr(pfd[1]);
+
+    // The stream closes the read end.
+    pfc_iostream_t	stream;
+    ASSERT_EQ(0, pfc_iostream_create(&stream, pfd[0], PASSFD_BUFSIZE, 0,
+                                     NULL));
+    ASSERT_EQ(ENOTSOCK, __pfc_iostream_passfd(stream));
+
+    int	fd;
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(stream, &fd));
+    ASSERT_EQ(0, pfc_iostream_destroy(stream));
+}
+
+/*
+ * Send a file descriptor, and use it on the receiver side.
+ */
+TEST(iostream, passfd_sendfd_recvfd)
+{
+    StreamPair	sp;
+    ASSERT_EQ(0, sp.getError());
+    ASSERT_EQ(0, __pfc_iostream_passfd(sp.receiver()));
+
+    int	fd;
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(sp.receiver(), &fd));
+
+    Pipe	p;
+    ASSERT_TRUE(p.isOpen());
+
+    const char	*data("passfd");
+    size_t	size(strlen(data));
+    ASSERT_EQ(0, __pfc_iostream_sendfd_abs(sp.sender(), data, &size,
+                                           p.writer(), NULL));
+    ASSERT_EQ(strlen(data), size);
+
+    // The FD is queued when the data which carries it is read.
+    char	buf[PASSFD_BUFSIZE];
+    ASSERT_EQ(0, sp.readAll(buf, strlen(data)));
+    ASSERT_EQ(0, memcmp(data, buf, strlen(data)));
+
+    ASSERT_EQ(0, __pfc_iostream_recvfd(sp.receiver(), &fd));
+    FdRef	received(fd);
+    ASSERT_NE(p.writer(), fd);
+    ASSERT_TRUE(is_same_file(p.writer(), fd));
+    ASSERT_NE(0, fcntl(fd, F_GETFD) & FD_CLOEXEC);
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(sp.receiver(), &fd));
+
+    // Write to the pipe via received FD.
+    ASSERT_EQ(1, write(fd, "x", 1));
+    char	c;
+    ASSERT_EQ(1, read(p.reader(), &c, 1));
+    ASSERT_EQ('x', c);
+}
+
+/*
+ * File descriptors must be fetched in the order they were sent.
+ */
+TEST(iostream, passfd_order)
+{
+    StreamPair	sp;
+    ASSERT_EQ(0, sp.getError());
+    ASSERT_EQ(0, __pfc_iostream_passfd(sp.receiver()));
+
+    Pipe	p[PASSFD_FDQ_SIZE];
+    for (uint32_t i = 0; i < PASSFD_FDQ_SIZE; i++) {
+        ASSERT_TRUE(p[i].isOpen());
+        ASSERT_EQ(0, sp.sendfd('a' + i, p[i].reader()));
+    }
+
+    // Read all the data before fetching FDs.
+    char	buf[PASSFD_FDQ_SIZE];
+    ASSERT_EQ(0, sp.readAll(buf, sizeof(buf)));
+    for (uint32_t i = 0; i < PASSFD_FDQ_SIZE; i++) {
+        ASSERT_EQ('a' + (int)i, buf[i]);
+    }
+
+    for (uint32_t i = 0; i < PASSFD_FDQ_SIZE; i++) {
+        int	fd;
+
+        ASSERT_EQ(0, __pfc_iostream_recvfd(sp.receiver(), &fd));
+        FdRef	received(fd);
+        ASSERT_TRUE(is_same_file(p[i].reader(), fd));
+    }
+
+    int	fd;
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(sp.receiver(), &fd));
+}
+
+/*
+ * File descriptors which overflow the FD queue are closed.
+ */
+TEST(iostream, passfd_overflow)
+{
+    StreamPair	sp;
+    ASSERT_EQ(0, sp.getError());
+    ASSERT_EQ(0, __pfc_iostream_passfd(sp.receiver()));
+
+    Pipe	p;
+    ASSERT_TRUE(p.isOpen());
+
+    const uint32_t	nsent(PASSFD_FDQ_SIZE + 2);
+    for (uint32_t i = 0; i < nsent; i++) {
+        ASSERT_EQ(0, sp.sendfd('0' + i, p.writer()));
+    }
+
+    char	buf[PASSFD_FDQ_SIZE + 2];
+    ASSERT_EQ(0, sp.readAll(buf, nsent));
+
+    for (uint32_t i = 0; i < PASSFD_FDQ_SIZE; i++) {
+        int	fd;
+
+        ASSERT_EQ(0, __pfc_iostream_recvfd(sp.receiver(), &fd));
+        FdRef	received(fd);
+        ASSERT_TRUE(is_same_file(p.writer(), fd));
+    }
+
+    int	fd;
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(sp.receiver(), &fd));
+
+    // Received FDs which did not fit in the queue must not be leaked.
+    ASSERT_TRUE(p.isWriterClosed());
+}
+
+/*
+ * A stream which does not pass FDs discards received FDs.
+ */
+TEST(iostream, passfd_disabled)
+{
+    StreamPair	sp;
+    ASSERT_EQ(0, sp.getError());
+
+    Pipe	p;
+    ASSERT_TRUE(p.isOpen());
+
+    ASSERT_EQ(0, sp.sendfd('z', p.writer()));
+    char	c;
+    ASSERT_EQ(0, sp.readAll(&c, 1));
+    ASSERT_EQ('z', c);
+
+    int	fd;
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(sp.receiver(), &fd));
+    ASSERT_TRUE(p.isWriterClosed());
+}
+
+/*
+ * FDs queued in a stream are discarded when the stream is bound to
+ * another socket.
+ */
+TEST(iostream, passfd_setfd)
+{
+    StreamPair	sp;
+    ASSERT_EQ(0, sp.getError());
+    ASSERT_EQ(0, __pfc_iostream_passfd(sp.receiver()));
+
+    Pipe	p;
+    ASSERT_TRUE(p.isOpen());
+
+    ASSERT_EQ(0, sp.sendfd('s', p.writer()));
+    char	c;
+    ASSERT_EQ(0, sp.readAll(&c, 1));
+
+    int	sock[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sock));
+    FdRef	peer(sock[1]);
+
+    int	oldfd(pfc_iostream_getfd(sp.receiver()));
+    ASSERT_EQ(0, __pfc_iostream_setfd(sp.receiver(), sock[0]));
+    FdRef	old(oldfd);
+
+    int	fd;
+    ASSERT_EQ(ENOENT, __pfc_iostream_recvfd(sp.receiver(), &fd));
+    ASSERT_TRUE(p.isWriterClosed());
+}
@@ -22,6 +22,7 @@
 #include <dirent.h>
 #include <sys/stat.h>
 #include <sys/resource.h>
+#include <pthread.h>
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
 #include <pfc/log.h>
@@ -1429,6 +1430,121 @@ check_rotate(uint32_t nrotate)
     }
 }
 
+/*
+ * Number of threads and logs per thread used by asynchronous logging tests.
+ */
+#define ASYNC_NTHREADS          8U
+#define ASYNC_NLOGS             5000U
+
+/*
+ * static uint32_t
+ * count_async_logs(LogFile &file)
+ *      Return the number of logs recorded by async_log_thread() in the
+ *      log file.
+ */
+static uint32_t
+count_async_logs(LogFile &file)
+{
+    std::string  path;
+    file.getPath(path);
+
+    FILE  *fp(pfc_fopen_cloexec(path.c_str(), "r"));
+    if (fp == NULL) {
+        return 0;
+    }
+    StdioRef fpref(fp);
+
+    uint32_t  count(0);
+    char      line[1024];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (strstr(line, "INFO: async log: ") != NULL) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*
+ * static void *
+ * async_log_thread(void *arg)
+ *      Record ASYNC_NLOGS logs.
+ */
+static void *
+async_log_thread(void *arg)
+{
+    uintptr_t  id(reinterpret_cast<uintptr_t>(arg));
+
+    for (uint32_t i(0); i < ASYNC_NLOGS; i++) {
+        pfc_log_info("async log: %u: %u", static_cast<uint32_t>(id), i);
+    }
+
+    return NULL;
+}
+
+/*
+ * static void
+ * check_async(pfc_bool_t block)
+ *      Record logs from multiple threads using asynchronous logging with
+ *      the minimum buffer, and verify the log file and statistics.
+ */
+static void
+check_async(pfc_bool_t block)
+{
+    LogFile         file;
+    pfc_log_conf_t  conf;
+
+    pfc_logconf_init(&conf, PFC_CFBLK_INVALID, TEST_LOG_IDENT, NULL);
+    pfc_logconf_setasync(&conf, PFC_TRUE, 16, block);
+    file.setPath(conf);
+    pfc_log_sysinit(&conf);
+
+    pthread_t  threads[ASYNC_NTHREADS];
+    for (uintptr_t i(0); i < ASYNC_NTHREADS; i++) {
+        ASSERT_EQ(0, pthread_create(&threads[i], NULL, async_log_thread,
+                                    reinterpret_cast<void *>(i)));
+    }
+    for (uint32_t i(0); i < ASYNC_NTHREADS; i++) {
+        ASSERT_EQ(0, pthread_join(threads[i], NULL));
+    }
+
+    // pfc_log_fini() records all queued logs.
+    pfc_log_fini();
+
+    pfc_log_async_stats_t  stats;
+    pfc_log_async_getstats(&stats);
+
+    const uint64_t  total(ASYNC_NTHREADS * ASYNC_NLOGS);
+    uint32_t        count(count_async_logs(file));
+    ASSERT_EQ(stats.plas_written, static_cast<uint64_t>(count));
+    ASSERT_EQ(total, stats.plas_written + stats.plas_dropped);
+    if (block) {
+        ASSERT_EQ(0U, stats.plas_dropped);
+    }
+    else {
+        ASSERT_EQ(0U, stats.plas_blocked);
+    }
+}
+
+/*
+ * Log file used by async_fatal_handler().
+ */
+static LogFile  *async_fatal_file;
+static uint32_t async_fatal_count;
+static bool     async_fatal_found;
+
+/*
+ * static void
+ * async_fatal_handler(void)
+ *      Fatal log handler which verifies the log file.
+ */
+static void
+async_fatal_handler(void)
+{
+    async_fatal_count = count_async_logs(*async_fatal_file);
+    async_fatal_file->search("FATAL: async fatal", async_fatal_found);
+}
+
 /*
  * Test fixture.
  */
@@ -2367,3 +2483,46 @@ TEST_F(log, modlevel)
         ASSERT_EQ(level, __pfc_log_current_modlevel("new_mod2"));
     }
 }
+
+/*
+ * Ensure that asynchronous logging records all logs if the logging thread
+ * blocks on buffer overflow.
+ */
+TEST_F(log, async_block)
+{
+    check_async(PFC_TRUE);
+}
+
+/*
+ * Ensure that asynchronous logging counts dropped logs.
+ */
+TEST_F(log, async_drop)
+{
+    check_async(PFC_FALSE);
+}
+
+/*
+ * Ensure that a fatal log is recorded synchronously, after all logs queued
+ * before.
+ */
+TEST_F(log, async_fatal)
+{
+    LogFile         file;
+    pfc_log_conf_t  conf;
+
+    pfc_logconf_init(&conf, PFC_CFBLK_INVALID, TEST_LOG_IDENT,
+                     async_fatal_handler);
+    pfc_logconf_setasync(&conf, PFC_TRUE, 1024, PFC_TRUE);
+    file.setPath(conf);
+    pfc_log_sysinit(&conf);
+
+    async_fatal_file = &file;
+    async_fatal_count = 0;
+    async_fatal_found = false;
+    async_log_thread(NULL);
+    pfc_log_fatal("async fatal");
+
+    ASSERT_EQ(ASYNC_NLOGS, async_fatal_count);
+    ASSERT_TRUE(async_fatal_found);
+    async_fatal_file = NULL;
+}
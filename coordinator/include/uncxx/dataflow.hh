@@ -91,6 +91,37 @@ class DataflowDummy : public pfc::core::Module {
   static DataflowDummy* dataflow_dummy_;
 };
 
+/*
+ * Flat copy of the matches compared when a flow is stitched to the output
+ * matches of the flow of the previous controller. The values of the
+ * compared fields are packed in one array, and a value without a mask
+ * carries an all ones mask, so each field is compared as
+ * (value1 ^ value2) & mask1 & mask2. A field which is absent, or has no
+ * value, matches any value.
+ */
+class DataflowMatch {
+ public:
+  DataflowMatch();
+  explicit DataflowMatch(const map<UncDataflowFlowMatchType, void *> &matches);
+  // check these matches against the output matches 'prev'
+  bool Matches(const DataflowMatch &prev) const;
+  // check whether the field has a value without a mask
+  bool IsStrict(UncDataflowFlowMatchType type) const;
+  // hash of the value of the field
+  uint64_t Hash(UncDataflowFlowMatchType type) const;
+
+  static const uint32_t kMaxLenValue = 56;
+
+ private:
+  void SetField(UncDataflowFlowMatchType type, const void *value,
+                const void *mask);
+
+  uint32_t present_;
+  uint32_t masked_;
+  uint8_t value_[kMaxLenValue];
+  uint8_t mask_[kMaxLenValue];
+};
+
 class DataflowCmn;
 
 class DataflowDetail {
@@ -186,6 +217,34 @@ class DataflowCmn {
 
 };
 
+/*
+ * Index of the flows read from a controller or domain, to find the flows
+ * which may follow the output matches of a flow of the previous controller
+ * without checking all of them. For each compared field, flows with a
+ * value without a mask are bucketed by the hash of the value, and flows
+ * without the field, or with a masked value, are kept as wildcards.
+ * Lookup returns the smallest candidate set in the order of the flows,
+ * and each candidate is checked by Matches.
+ */
+class DataflowFlowIndex {
+ public:
+  explicit DataflowFlowIndex(const vector<DataflowDetail *> &flows);
+  // Get the positions of the flows which may match 'prev'
+  void Lookup(const DataflowMatch &prev, vector<uint32_t> *positions) const;
+  // check the flow at 'position' against the output matches 'prev'
+  bool Matches(uint32_t position, const DataflowMatch &prev) const {
+    return matches_[position].Matches(prev);
+  }
+
+ private:
+  struct FieldIndex {
+    map<uint64_t, vector<uint32_t> > buckets;
+    vector<uint32_t> wildcards;
+  };
+  vector<DataflowMatch> matches_;
+  map<UncDataflowFlowMatchType, FieldIndex> fields_;
+};
+
 struct KeyDataflowCmp {
   bool operator()(const key_dataflow_t& lhs, const key_dataflow_t& rhs);
 };
@@ -244,6 +303,8 @@ class DataflowUtil {
   std::map<std::string, uint32_t>* get_ctrlr_dom_count_map() {
     return &ctrlr_dom_count_map;
   };
+  // Get the index of flows stored in pfc_flows or upll_pfc_flows
+  DataflowFlowIndex* get_flow_index(const vector<DataflowDetail *> &flows);
   std::map<key_dataflow_t, vector<DataflowDetail *>, KeyDataflowCmp > pfc_flows;
   std::map<key_vtn_ctrlr_dataflow, vector<DataflowDetail *>, KeyVtnDataflowCmp  > upll_pfc_flows;
   std::map<std::string, uint32_t> ctrlr_dom_count_map;
@@ -252,6 +313,7 @@ class DataflowUtil {
   std::map<std::string, std::string> vnode_rename_map;
  private:
   vector<DataflowCmn* > firstCtrlrFlows;
+  std::map<const vector<DataflowDetail *> *, DataflowFlowIndex *> flow_indexes_;
 };
 
 }  // namespace dataflow
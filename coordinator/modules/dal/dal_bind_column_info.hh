@@ -206,6 +206,35 @@ class DalBindColumnInfo {
 
     static std::string DalIoCodeToStr(const DalIoCode io_code);
 
+    /**
+     * GetDalBufferSize
+     *   Size of the DAL input/output/match buffer of the given column
+     *   Used by DAL layer to build parameter arrays for bulk operations
+     *
+     * @param[in] table_index     - Valid Table index
+     * @param[in] column_index    - Valid Column index of the table
+     * @return size_t             - Size of the DAL buffer in bytes
+     */
+    static size_t GetDalBufferSize(const DalTableIndex table_index,
+                                   const DalColumnIndex column_index) {
+      return CalculateDalBufferSize(
+          schema::ColumnDalDataTypeId(table_index, column_index),
+          schema::ColumnDbArraySize(table_index, column_index));
+    }
+
+    /**
+     * GetDalOutBufferSize
+     *   Size of the DAL buffers allocated for this column binding
+     *
+     * @param[in] table_index     - Valid Table index
+     * @return size_t             - Size of the DAL buffer in bytes
+     */
+    size_t GetDalOutBufferSize(const DalTableIndex table_index) const {
+      return CalculateDalBufferSize(
+          schema::ColumnDalDataTypeId(table_index, column_index_),
+          app_array_size_);
+    }
+
   private:
     /**
      * AllocateAndCopy
@@ -12,6 +12,7 @@
  *   Implementation of methods in DalCursor
  */ 
 
+#include <string.h>
 #include "uncxx/upll_log.hh"
 #include "dal_error_handler.hh"
 #include "dal_cursor.hh"
@@ -36,7 +37,7 @@ DalCursor::GetNextRecord() const {
     return kDalRcGeneralError;
   }
 
-  dal_rc = GetNextRecordFromStmt(stmt_handle_1_, bind_info_1_);
+  dal_rc = GetNextRecordFromStmt(stmt_handle_1_, bind_info_1_, &block_1_);
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. Error Fetching record from Stmt Handle 1(%p)",
                    dal_rc, stmt_handle_1_);
@@ -53,7 +54,7 @@ DalCursor::GetNextRecord() const {
       return kDalRcGeneralError;
     }
 
-    dal_rc = GetNextRecordFromStmt(stmt_handle_2_, bind_info_2_);
+    dal_rc = GetNextRecordFromStmt(stmt_handle_2_, bind_info_2_, &block_2_);
     if (dal_rc != kDalRcSuccess) {
       UPLL_LOG_DEBUG("Err - %d. Error Fetching record from Stmt Handle 2(%p)",
                      dal_rc, stmt_handle_2_);
@@ -89,6 +90,10 @@ DalCursor::CloseCursor(bool delete_bind) {
   }
   if (delete_bind == true)
     delete bind_info_1_;
+  delete block_1_;
+  delete block_2_;
+  block_1_ = NULL;
+  block_2_ = NULL;
   if (stmt_handle_1_ == SQL_NULL_HANDLE) {
     UPLL_LOG_DEBUG("NULL Statement Handle 1");
     return kDalRcGeneralError;
@@ -113,7 +118,8 @@ DalCursor::CloseCursor(bool delete_bind) {
 // GetNextRecord from the specific Stmt Handle
 DalResultCode
 DalCursor::GetNextRecordFromStmt(const SQLHANDLE stmt_handle,
-                                 const DalBindInfo *bind_info) {
+                                 const DalBindInfo *bind_info,
+                                 DalCursorBlock **block) const {
   SQLRETURN     sql_rc;
   DalResultCode dal_rc;
 
@@ -127,6 +133,18 @@ DalCursor::GetNextRecordFromStmt(const SQLHANDLE stmt_handle,
     return kDalRcGeneralError;
   }
 
+  // Block cursor is set up on the first fetch from the handle
+  if (*block == NULL && row_array_size_ > 1) {
+    *block = CreateBlock(stmt_handle, bind_info, row_array_size_);
+    if (*block == NULL) {
+      UPLL_LOG_DEBUG("Block cursor not available. Fetching row by row");
+      row_array_size_ = 1;
+    }
+  }
+  if (*block != NULL) {
+    return GetNextRecordFromBlock(stmt_handle, bind_info, *block);
+  }
+
   // Resetting Dal Out Buffer Space to avoid overwirting of data
   if (const_cast<DalBindInfo*>(bind_info)->ResetDalOutBuffer() != true) {
     UPLL_LOG_DEBUG("Error resetting Dal Out Buffer");
@@ -158,6 +176,167 @@ DalCursor::GetNextRecordFromStmt(const SQLHANDLE stmt_handle,
   return kDalRcSuccess;
 }  // DalCursor::GetNextRecordFromStmt
 
+// Bind the output columns to arrays for block fetch
+DalCursorBlock *
+DalCursor::CreateBlock(const SQLHANDLE stmt_handle,
+                       const DalBindInfo *bind_info,
+                       const uint32_t row_array_size) {
+  SQLRETURN     sql_rc;
+  DalResultCode dal_rc;
+  DalTableIndex table_index = bind_info->get_table_index();
+  DalBindList bind_list = bind_info->get_bind_list();
+  DalCursorBlock *block = new DalCursorBlock;
+
+  block->rows_fetched = 0;
+  block->next_row = 0;
+  block->row_status.resize(row_array_size);
+  for (DalBindList::iterator iter = bind_list.begin();
+       iter != bind_list.end(); ++iter) {
+    DalBindColumnInfo *col_info = *iter;
+    if (col_info == NULL) {
+      UPLL_LOG_DEBUG("Invalid column Info");
+      delete block;
+      return NULL;
+    }
+    if (col_info->get_io_type() != kDalIoOutputOnly &&
+        col_info->get_io_type() != kDalIoOutputAndMatch) {
+      continue;
+    }
+    size_t elem_size = DalBindColumnInfo::GetDalBufferSize(
+        table_index, col_info->get_column_index());
+    block->columns.push_back(col_info);
+    block->elem_sizes.push_back(elem_size);
+    block->data.push_back(std::vector<uint8_t>(elem_size * row_array_size));
+    block->lens.push_back(std::vector<SQLLEN>(row_array_size));
+  }
+
+  sql_rc = SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROW_BIND_TYPE,
+                          reinterpret_cast<SQLPOINTER>(SQL_BIND_BY_COLUMN),
+                          0);
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO) {
+    sql_rc = SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROW_ARRAY_SIZE,
+                            reinterpret_cast<SQLPOINTER>(row_array_size), 0);
+  }
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO) {
+    sql_rc = SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROW_STATUS_PTR,
+                            &(block->row_status[0]), 0);
+  }
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO) {
+    sql_rc = SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROWS_FETCHED_PTR,
+                            &(block->rows_fetched), 0);
+  }
+  for (size_t col = 0; col < block->columns.size() &&
+       (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO); col++) {
+    sql_rc = SQLBindCol(stmt_handle, static_cast<SQLUSMALLINT>(col + 1),
+                        schema::ColumnDalDataTypeId(
+                            table_index,
+                            block->columns[col]->get_column_index()),
+                        &(block->data[col][0]),
+                        block->elem_sizes[col],
+                        &(block->lens[col][0]));
+  }
+  DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                     stmt_handle,
+                                     sql_rc, &dal_rc);
+  if (dal_rc == kDalRcSuccess) {
+    UPLL_LOG_TRACE("Block cursor of %u rows set for Table(%s)",
+                   row_array_size, schema::TableName(table_index));
+    return block;
+  }
+
+  // Restore the bindings done by BindOutputToQuery
+  UPLL_LOG_DEBUG("Err - %d. Failed to set block cursor for Table(%s)",
+                 dal_rc, schema::TableName(table_index));
+  SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROW_ARRAY_SIZE,
+                 reinterpret_cast<SQLPOINTER>(1), 0);
+  SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROW_STATUS_PTR, NULL, 0);
+  SQLSetStmtAttr(stmt_handle, SQL_ATTR_ROWS_FETCHED_PTR, NULL, 0);
+  for (size_t col = 0; col < block->columns.size(); col++) {
+    DalBindColumnInfo *col_info = block->columns[col];
+    SQLBindCol(stmt_handle, static_cast<SQLUSMALLINT>(col + 1),
+               schema::ColumnDalDataTypeId(table_index,
+                                           col_info->get_column_index()),
+               col_info->get_db_in_out_addr(),
+               schema::ColumnDbArraySize(table_index,
+                                         col_info->get_column_index()),
+               col_info->get_buff_len_ptr());
+  }
+  delete block;
+  return NULL;
+}  // DalCursor::CreateBlock
+
+// GetNextRecord served from the block buffer
+DalResultCode
+DalCursor::GetNextRecordFromBlock(const SQLHANDLE stmt_handle,
+                                  const DalBindInfo *bind_info,
+                                  DalCursorBlock *block) {
+  SQLRETURN     sql_rc;
+  DalResultCode dal_rc;
+  DalTableIndex table_index = bind_info->get_table_index();
+
+  // Resetting Dal Out Buffer Space to avoid overwirting of data
+  if (const_cast<DalBindInfo*>(bind_info)->ResetDalOutBuffer() != true) {
+    UPLL_LOG_DEBUG("Error resetting Dal Out Buffer");
+    return kDalRcGeneralError;
+  }
+
+  // Fetching next block of results from the resultset
+  if (block->next_row >= block->rows_fetched) {
+    block->rows_fetched = 0;
+    block->next_row = 0;
+    sql_rc = SQLFetch(stmt_handle);
+    DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                       stmt_handle,
+                                       sql_rc, &dal_rc);
+    if (dal_rc == kDalRcSuccess && block->rows_fetched == 0) {
+      dal_rc = kDalRcRecordNotFound;
+    }
+    if (dal_rc != kDalRcSuccess) {
+      if (dal_rc == kDalRcRecordNotFound) {
+        dal_rc = kDalRcRecordNoMore;
+        UPLL_LOG_TRACE("Err - %d. No more result", dal_rc);
+      } else {
+        UPLL_LOG_INFO("Err - %d. Failed to Fetch result", dal_rc);
+      }
+      return dal_rc;
+    }
+    UPLL_LOG_TRACE("Fetched block of %u rows",
+                   static_cast<uint32_t>(block->rows_fetched));
+  }
+
+  SQLULEN row = block->next_row++;
+  if (block->row_status[row] == SQL_ROW_ERROR) {
+    UPLL_LOG_INFO("Failed to Fetch result row %u",
+                  static_cast<uint32_t>(row));
+    return kDalRcGeneralError;
+  }
+
+  // Copy the row to the DAL output buffers as SQLFetch of one row would
+  for (size_t col = 0; col < block->columns.size(); col++) {
+    DalBindColumnInfo *col_info = block->columns[col];
+    SQLLEN len = block->lens[col][row];
+    if (len != SQL_NULL_DATA) {
+      size_t copy_size = block->elem_sizes[col];
+      size_t dal_size = col_info->GetDalOutBufferSize(table_index);
+      if (dal_size < copy_size) {
+        copy_size = dal_size;
+      }
+      memcpy(col_info->get_db_in_out_addr(),
+             &(block->data[col][row * block->elem_sizes[col]]), copy_size);
+    }
+    *(col_info->get_buff_len_ptr()) = len;
+  }
+
+  if (const_cast<DalBindInfo*>(bind_info)->CopyResultToApp() != true) {
+    UPLL_LOG_DEBUG("Failed to copy result");
+    return kDalRcGeneralError;
+  }
+  UPLL_LOG_TRACE("%s",
+      ((const_cast<DalBindInfo *>(bind_info))->BindListResultToStr()).c_str());
+  UPLL_LOG_TRACE("Success Fetching record from block of Stmt Handle");
+  return kDalRcSuccess;
+}  // DalCursor::GetNextRecordFromBlock
+
 // Close specific Statement Handle
 DalResultCode
 DalCursor::CloseStmtHandle(SQLHANDLE stmt_handle) {
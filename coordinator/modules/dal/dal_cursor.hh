@@ -16,6 +16,8 @@
 #define __DAL_CURSOR_HH__
 
 #include <sql.h>
+#include <stdint.h>
+#include <vector>
 #include "dal_defines.hh"
 #include "dal_bind_info.hh"
 
@@ -23,6 +25,25 @@ namespace unc {
 namespace upll {
 namespace dal {
 
+/**
+ * DalCursorBlock
+ *   Column-wise result buffer of a block cursor. One SQLFetch fills up to
+ *   row array size rows, which are handed out one by one by GetNextRecord.
+ */
+struct DalCursorBlock {
+  // Output columns of the bind info, in the order bound to the result set
+  std::vector<DalBindColumnInfo *> columns;
+  // Size of one element of each column array
+  std::vector<size_t> elem_sizes;
+  // Column arrays and their length/indicator arrays
+  std::vector<std::vector<uint8_t> > data;
+  std::vector<std::vector<SQLLEN> > lens;
+  std::vector<SQLUSMALLINT> row_status;
+  // Rows filled by the last SQLFetch and the next row to be served
+  SQLULEN rows_fetched;
+  SQLULEN next_row;
+};
+
 /**
  * DalCursor
  *   Contains cursor information and related methods
@@ -39,15 +60,22 @@ class DalCursor {
      *                            records in the resultset of Database
      * @param[in] bind_addr     - Valid bind information bound to the
      *                            corresponding handle
+     * @param[in] row_array_size
+     *                          - Number of rows fetched from the database
+     *                            at once. 1 fetches row by row.
      * @return void             - None
      */
     explicit DalCursor(const SQLHANDLE stmt_handle,
-                       const DalBindInfo *bind_info) {
+                       const DalBindInfo *bind_info,
+                       const uint32_t row_array_size = 1) {
       stmt_handle_1_ = const_cast<SQLHANDLE>(stmt_handle);
       bind_info_1_ = const_cast<DalBindInfo *>(bind_info);
       stmt_handle_2_ = SQL_NULL_HANDLE;
       bind_info_2_ = NULL;
       has_two_handles_ = false;
+      row_array_size_ = row_array_size;
+      block_1_ = NULL;
+      block_2_ = NULL;
     }
 
     /**
@@ -62,17 +90,24 @@ class DalCursor {
      *                            records in the resultset of Database
      * @param[in] bind_ptr_2    - Valid bind information bound to the
      *                            corresponding handle
+     * @param[in] row_array_size
+     *                          - Number of rows fetched from the database
+     *                            at once. 1 fetches row by row.
      * @return void             - None
      */
     explicit DalCursor(const SQLHANDLE handle_1,
                        const DalBindInfo *bind_ptr_1,
                        const SQLHANDLE handle_2,
-                       const DalBindInfo *bind_ptr_2) {
+                       const DalBindInfo *bind_ptr_2,
+                       const uint32_t row_array_size = 1) {
       stmt_handle_1_ = const_cast<SQLHANDLE>(handle_1);
       bind_info_1_ = const_cast<DalBindInfo *>(bind_ptr_1);
       stmt_handle_2_ = const_cast<SQLHANDLE>(handle_2);
       bind_info_2_ = const_cast<DalBindInfo *>(bind_ptr_2);
       has_two_handles_ = true;
+      row_array_size_ = row_array_size;
+      block_1_ = NULL;
+      block_2_ = NULL;
     }
 
     /**
@@ -88,6 +123,8 @@ class DalCursor {
       if (stmt_handle_2_ != NULL) {
         SQLFreeHandle(SQL_HANDLE_STMT, stmt_handle_2_);
       }
+      delete block_1_;
+      delete block_2_;
     }
 
     /**
@@ -114,6 +151,8 @@ class DalCursor {
      *   If failed for 2nd handle, return error from 2nd handle
      *   If success for 1st handle, store the results in the corresponding 
      *   bind info.
+     * If row array size is more than 1, the rows are fetched from the
+     * database in blocks and served from the buffer of the cursor.
      */
     DalResultCode GetNextRecord() const;
 
@@ -157,8 +196,39 @@ class DalCursor {
      * @return DalResultCode    - kDalRcSuccess in case of success
      *                          - Valid errorcode otherwise
      */
-    static DalResultCode GetNextRecordFromStmt(const SQLHANDLE stmt_handle,
-                                               const DalBindInfo *bind_info);
+    DalResultCode GetNextRecordFromStmt(const SQLHANDLE stmt_handle,
+                                        const DalBindInfo *bind_info,
+                                        DalCursorBlock **block) const;
+
+    /**
+     * CreateBlock
+     *   Rebinds the output columns of the statement handle to column arrays
+     *   of row_array_size rows
+     *
+     * @param[in] stmt_handle   - Executed statement handle
+     * @param[in] bind_info     - Bind information bound to the handle
+     * @param[in] row_array_size
+     *                          - Number of rows fetched at once
+     *
+     * @return DalCursorBlock*  - Block buffer bound to the handle
+     *                          - NULL on failure, the handle is left bound
+     *                            for row by row fetch
+     */
+    static DalCursorBlock *CreateBlock(const SQLHANDLE stmt_handle,
+                                       const DalBindInfo *bind_info,
+                                       const uint32_t row_array_size);
+
+    /**
+     * GetNextRecordFromBlock
+     *   Copies the next row of the block to the bind_info, fetching the
+     *   next block of rows when the current one is consumed
+     *
+     * @return DalResultCode    - kDalRcSuccess in case of success
+     *                          - Valid errorcode otherwise
+     */
+    static DalResultCode GetNextRecordFromBlock(const SQLHANDLE stmt_handle,
+                                                const DalBindInfo *bind_info,
+                                                DalCursorBlock *block);
     /**
      * CloseStmtHandle
      *   Wrapper for CloseCursor for the specific statement handle
@@ -174,6 +244,11 @@ class DalCursor {
     DalBindInfo *bind_info_2_;
 
     bool has_two_handles_;
+
+    // Rows per SQLFetch; reset to 1 if block cursor cannot be set up
+    mutable uint32_t row_array_size_;
+    mutable DalCursorBlock *block_1_;
+    mutable DalCursorBlock *block_2_;
 };  // class DalCursor
 
 }  // namespace dal
@@ -67,6 +67,17 @@ enum DalResultCode {
   kDalRcGeneralError          // For DCI and DMI interfaces
 };  // enum DalResultCode
 
+/**
+ * Enumeration for the change of a record returned by GetChangedRecords
+ */
+enum DalChangeType {
+  kDalChangeDeleted = 1,  // Record of cfg_type_2 deleted in cfg_type_1
+  kDalChangeCreated,      // Record of cfg_type_1 not in cfg_type_2
+  kDalChangeUpdated,      // Record of cfg_type_1 updated in cfg_type_1
+  kDalChangeUpdatedOld    // Record of cfg_type_2 of the previous
+                          // kDalChangeUpdated record
+};  // enum DalChangeType
+
 }  // namespace dal
 }  // namespace upll
 }  // namespace unc
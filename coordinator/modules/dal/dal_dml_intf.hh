@@ -20,6 +20,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include "dal_defines.hh"
 #include "dal_bind_info.hh"
 #include "dal_schema.hh"
@@ -444,6 +445,68 @@ class DalDmlIntf {
                     const CfgModeType cfg_mode,
                     const uint8_t* vtn_name) const = 0;
 
+    /**
+     * CreateRecords
+     *   Creates the records in table with the given input data for
+     *   the given cfg_type. All the records are sent to the database in a
+     *   single execution using arrays of parameters.
+     *
+     * @param[in] cfg_type        - Configuration Type for which the records
+     *                              have to be created
+     * @param[in] table_index     - Valid Index of the table
+     * @param[in] input_attr_infos
+     *                            - Bind Information for each record
+     * @param[out] results        - Result code of each record, in the order
+     *                              of input_attr_infos
+     *
+     * @return DalResultCode      - kDalRcSuccess if all records are created
+     *                            - Errorcode of the first failed record
+     *                              otherwise
+     *
+     * Note:
+     * Information on usage of DalBindInfo
+     *  1. Same as CreateRecord for each DalBindInfo
+     *  2. All DalBindInfo instances must bind the same set of columns.
+     */
+    virtual DalResultCode CreateRecords(
+                    const UpllCfgType cfg_type,
+                    const DalTableIndex table_index,
+                    const std::vector<const DalBindInfo *> &input_attr_infos,
+                    std::vector<DalResultCode> *results,
+                    const CfgModeType cfg_mode,
+                    const uint8_t* vtn_name) const = 0;
+
+    /**
+     * UpdateRecords
+     *   Updates the records of table with the given input data for
+     *   the given cfg_type. All the updates are sent to the database in a
+     *   single execution using arrays of parameters.
+     *
+     * @param[in] cfg_type        - Configuration Type for which the records
+     *                              have to be updated
+     * @param[in] table_index     - Valid Index of the table
+     * @param[in] input_and_matching_attr_infos
+     *                            - Bind Information for each update
+     * @param[out] results        - Result code of each update, in the order
+     *                              of input_and_matching_attr_infos
+     *
+     * @return DalResultCode      - kDalRcSuccess if all updates succeed
+     *                            - Errorcode of the first failed update
+     *                              otherwise
+     *
+     * Note:
+     * Information on usage of DalBindInfo
+     *  1. Same as UpdateRecords for each DalBindInfo
+     *  2. All DalBindInfo instances must bind the same set of columns.
+     */
+    virtual DalResultCode UpdateRecords(
+        const UpllCfgType cfg_type,
+        const DalTableIndex table_index,
+        const std::vector<const DalBindInfo *> &input_and_matching_attr_infos,
+        std::vector<DalResultCode> *results,
+        const CfgModeType cfg_mode,
+        const uint8_t* vtn_name) const = 0;
+
     /**
      * ExecuteAppQuery
      *   Updates(create/update/delete) the records of table with the given sql query.
@@ -641,6 +704,55 @@ class DalDmlIntf {
                     const CfgModeType cfg_mode,
                     const uint8_t* vtn_name) const = 0;
 
+    /**
+     * GetChangedRecords
+     *   Fetches the records deleted, created and updated in cfg_type_1 as
+     *   compared to cfg_type_2 with one query, in the order of deleted,
+     *   created and updated records, each by primary key. Each updated
+     *   record of cfg_type_1 is followed by the record of cfg_type_2.
+     *
+     * @param[in] cfg_type_1      - UPLL_DT_CANDIDATE
+     * @param[in] cfg_type_2      - UPLL_DT_RUNNING
+     * @param[in] table_index     - Valid Index of the table
+     * @param[in] max_record_count- Will be filled later. Under discussion
+     * @param[in] output_attr_info
+     *                            - Bind Information for output records
+     * @param[in] change          - Filled with the DalChangeType of the
+     *                              record by GetNextRecord
+     * @param[in/out] cursor      - reference to the unallocated DalCursor
+     *                              pointer
+     *                            - Output - cursor pointer with valid instance
+     *                              of DalCursor
+     * @param[in] cfg_mode        - Configuration mode other than
+     *                              TC_CONFIG_VTN
+     * @param[in] vtn_name        - Not used
+     *
+     * @return DalResultCode      - kDalRcSuccess in case of success
+     *                            - kDalRcRecordNotFound if the table is not
+     *                              dirty
+     *                            - Valid errorcode otherwise
+     *
+     * Note:
+     * Information on usage of DalBindInfo
+     *  1. Valid instance of DalBindInfo with same table_index used in this API
+     *  2. BindInput if used for any attributes, ignored.
+     *  3. BindMatch if used for any attributes, ignored.
+     *  4. BindOutput is mandatory for the primary key and the interested
+     *     attributes.
+     *
+     * Information on usage of cursor
+     *  Same as GetDeletedRecords
+     */
+    virtual DalResultCode GetChangedRecords(const UpllCfgType cfg_type_1,
+                                    const UpllCfgType cfg_type_2,
+                                    const DalTableIndex table_index,
+                                    const size_t max_record_count,
+                                    const DalBindInfo *output_attr_info,
+                                    int16_t *change,
+                                    DalCursor **cursor,
+                                    const CfgModeType cfg_mode,
+                                    const uint8_t* vtn_name) const = 0;
+
     /**
      * CopyEntireRecords
      *   Copies the entire records of table from source configuration to
@@ -12,7 +12,9 @@
  *   Contains implementation of DalOdbcMgr class
  */
 
+#include <string.h>
 #include <time.h>
+#include <algorithm>
 #include <sstream>
 
 #include "pfcxx/module.hh"
@@ -40,6 +42,9 @@ uint32_t DalOdbcMgr::default_max_session_;
 bool DalOdbcMgr::max_cache_reached_cr_;
 bool DalOdbcMgr::max_cache_reached_up_;
 bool DalOdbcMgr::max_cache_reached_dl_;
+uint32_t DalOdbcMgr::stmt_cache_size_ = DalOdbcMgr::default_stmt_cache_size_;
+uint32_t DalOdbcMgr::cursor_row_array_size_ =
+    DalOdbcMgr::default_cursor_row_array_size_;
 
 // Constructor
 DalOdbcMgr::DalOdbcMgr() {
@@ -48,6 +53,7 @@ DalOdbcMgr::DalOdbcMgr() {
   conn_type_ = kDalConnReadOnly;
   conn_state_ = kDalDbDisconnected;
   write_count_ = 0;
+  write_generation_ = 0;
   wr_exclusion_on_runn_ = false;
   wr_exclusion_runn_mutex_acqd_ = false;
   default_max_session_ = 64;
@@ -58,6 +64,7 @@ DalOdbcMgr::DalOdbcMgr() {
 
 /* Desctructor */
 DalOdbcMgr::~DalOdbcMgr() {
+  ClearStmtCache();
   if (dal_conn_handle_ != SQL_NULL_HANDLE)
     FreeHandle(SQL_HANDLE_DBC, dal_conn_handle_);
   if (dal_env_handle_ != SQL_NULL_HANDLE)
@@ -153,8 +160,10 @@ DalOdbcMgr::Init() {
   UPLL_LOG_TRACE("Allocated Connection handle(%p)", dal_conn_handle_);
 
   static bool bfirst = true;
-  if (!bfirst)
+  if (!bfirst) {
+    stmt_cache_.set_capacity(stmt_cache_size_);
     return kDalRcSuccess;
+  }
 
   // Read max_session (configure) from dal.conf
   uint32_t max_sessions = GetMaxcfgSession();
@@ -165,6 +174,13 @@ DalOdbcMgr::Init() {
   // Based on the max_sessions calculate the vtn dirty table cache limit
   max_cache_limit_ = max_sessions * 2 * (schema::table::kDalNumTables);
   UPLL_LOG_INFO("Max vtn dirty cache limit is %d", max_cache_limit_);
+
+  // Read prepared statement cache size from dal.conf
+  stmt_cache_size_ = GetStmtCacheSize();
+  stmt_cache_.set_capacity(stmt_cache_size_);
+
+  // Read block cursor row array size from dal.conf
+  cursor_row_array_size_ = GetCursorRowArraySize();
   bfirst = false;
 
   return kDalRcSuccess;
@@ -198,6 +214,9 @@ DalOdbcMgr::ConnectToDb(const DalConnType conn_type) const {
     return kDalRcGeneralError;
   }
 
+  // Statements prepared on an earlier connection are not valid anymore
+  ClearStmtCache();
+
   // Set Connection Attributes
   dal_rc = SetConnAttributes(dal_conn_handle_, conn_type);
   if (dal_rc != kDalRcSuccess) {
@@ -245,6 +264,12 @@ DalOdbcMgr::DisconnectFromDb() const {
     return kDalRcGeneralError;
   }
 
+  UPLL_LOG_INFO("Statement cache of handle(%p): hits=%" PFC_PFMT_u64
+                " misses=%" PFC_PFMT_u64 " evictions=%" PFC_PFMT_u64,
+                dal_conn_handle_, stmt_cache_.get_hits(),
+                stmt_cache_.get_misses(), stmt_cache_.get_evictions());
+  ClearStmtCache();
+
   sql_rc = SQLDisconnect(dal_conn_handle_);
   DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_DBC,
                                      dal_conn_handle_,
@@ -277,6 +302,8 @@ DalOdbcMgr::CommitTransaction(void) const {
                                      sql_rc, &dal_rc);
   SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
 
+  pfc_atomic_inc_uint64(&write_generation_);
+
   if (wr_exclusion_on_runn_) {
     wr_exclusion_var_mutex_.lock();
     if (wr_exclusion_runn_mutex_acqd_) {
@@ -316,6 +343,8 @@ DalOdbcMgr::RollbackTransaction(void) const {
                                      sql_rc, &dal_rc);
   SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
 
+  pfc_atomic_inc_uint64(&write_generation_);
+
   if (wr_exclusion_on_runn_) {
     wr_exclusion_var_mutex_.lock();
     if (wr_exclusion_runn_mutex_acqd_) {
@@ -383,14 +412,15 @@ DalOdbcMgr::GetSingleRecord(const UpllCfgType cfg_type,
   }
 
   // Allocate Stmt Handle, Bind and Execute the Query Statement
-  dal_rc = ExecuteQuery(&dal_stmt_handle,
-                        &query_stmt,
-                        bind_info);
+  dal_rc = ExecuteCachedQuery(kDalGetSingleRecQT, cfg_type, table_index,
+                              &dal_stmt_handle,
+                              &query_stmt,
+                              bind_info);
 
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_INFO("Err - %d. Failed executing query stmt - %s",
                    dal_rc, query_stmt.c_str());
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
   UPLL_LOG_TRACE("Completed executing query stmt - %s", query_stmt.c_str());
@@ -409,21 +439,21 @@ DalOdbcMgr::GetSingleRecord(const UpllCfgType cfg_type,
       UPLL_LOG_TRACE("%d - Failed to Fetch result, query stmt - %s",
                      dal_rc, query_stmt.c_str());
     }
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, (dal_rc == kDalRcRecordNotFound));
     return dal_rc;
   }
   UPLL_LOG_TRACE("Result fetched from DB");
 
   if (const_cast<DalBindInfo*>(bind_info)->CopyResultToApp() != true) {
     UPLL_LOG_INFO("Failed to Copy result to the DAL User Buffer");
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, true);
     return kDalRcGeneralError;
   }
   UPLL_LOG_TRACE("Copied result to the DAL User Buffer");
   UPLL_LOG_TRACE("%s",
       ((const_cast<DalBindInfo *>(bind_info))->BindListResultToStr()).c_str());
 
-  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  ReleaseCachedStmt(dal_stmt_handle, true);
   return kDalRcSuccess;
 }  // DalOdbcMgr::GetSingleRecord
 
@@ -490,7 +520,8 @@ DalOdbcMgr::GetMultipleRecords(const UpllCfgType cfg_type,
                 query_stmt.c_str());
 
   *cursor = new DalCursor(dal_stmt_handle,
-                          bind_info);
+                          bind_info,
+                          CursorRowArraySize(max_record_count));
   // PFC_ASSERT(*cursor)
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor handle for the result");
@@ -600,13 +631,14 @@ DalOdbcMgr::RecordExists(const UpllCfgType cfg_type,
   }
 
   // Allocate Stmt Handle, Bind and Execute the Query Statement
-  dal_rc = ExecuteQuery(&dal_stmt_handle,
-                        &query_stmt,
-                        bind_info);
+  dal_rc = ExecuteCachedQuery(kDalRecExistsQT, cfg_type, table_index,
+                              &dal_stmt_handle,
+                              &query_stmt,
+                              bind_info);
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. XXXXX - Failed executing query stmt - %s",
                    dal_rc, query_stmt.c_str());
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
   UPLL_LOG_TRACE("Completed executing query stmt - %s",
@@ -622,14 +654,14 @@ DalOdbcMgr::RecordExists(const UpllCfgType cfg_type,
 
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. XXXXX - Failed to fetch result from DB", dal_rc);
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
 
   *existence = (row_count > 0) ? true : false;
   UPLL_LOG_TRACE("Completed executing RecordExists and result of"
                 " existence is %d",  *existence);
-  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  ReleaseCachedStmt(dal_stmt_handle, true);
   return kDalRcSuccess;
 }
 
@@ -692,7 +724,8 @@ DalOdbcMgr::GetSiblingBegin(const UpllCfgType cfg_type,
     return dal_rc;
   }
 
-  *cursor = new DalCursor(dal_stmt_handle, bind_info);
+  *cursor = new DalCursor(dal_stmt_handle, bind_info,
+                          CursorRowArraySize(max_record_count));
   // PFC_ASSERT(*cursor)
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor for the result");
@@ -762,7 +795,8 @@ DalOdbcMgr::GetSiblingRecords(const UpllCfgType cfg_type,
     return dal_rc;
   }
 
-  *cursor = new DalCursor(dal_stmt_handle, bind_info);
+  *cursor = new DalCursor(dal_stmt_handle, bind_info,
+                          CursorRowArraySize(max_record_count));
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor for the result");
     FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
@@ -906,13 +940,14 @@ DalOdbcMgr::GetRecordCount(const UpllCfgType cfg_type,
   }
 
   // Allocate Stmt Handle, Bind and Execute the Query Statement
-  dal_rc = ExecuteQuery(&dal_stmt_handle,
-                        &query_stmt,
-                        bind_info);
+  dal_rc = ExecuteCachedQuery(kDalGetRecCountQT, cfg_type, table_index,
+                              &dal_stmt_handle,
+                              &query_stmt,
+                              bind_info);
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. Failed executing query stmt - %s",
                    dal_rc, query_stmt.c_str());
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
   UPLL_LOG_TRACE("Completed executing query stmt - %s",
@@ -925,7 +960,7 @@ DalOdbcMgr::GetRecordCount(const UpllCfgType cfg_type,
                                      sql_rc, &dal_rc);
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. Failed to Bind Column for count", dal_rc);
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
   UPLL_LOG_TRACE("Count variable bound to query");
@@ -939,12 +974,12 @@ DalOdbcMgr::GetRecordCount(const UpllCfgType cfg_type,
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_INFO("Err - %d. Failed to fetch result from DB, query stmt - %s",
                   dal_rc, query_stmt.c_str());
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
 
   UPLL_LOG_TRACE("Count of records - %d", *count);
-  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  ReleaseCachedStmt(dal_stmt_handle, true);
   return kDalRcSuccess;
 }   // DalOdbcMgr::GetRecordCount
 
@@ -1025,14 +1060,15 @@ DalOdbcMgr::DeleteRecords(const UpllCfgType cfg_type,
   }
 
   // Allocate Stmt Handle, Bind and Execute the Query Statement
-  dal_rc = ExecuteQuery(&dal_stmt_handle,
-                        &query_stmt,
-                        bind_info);
+  dal_rc = ExecuteCachedQuery(query_template, cfg_type, table_index,
+                              &dal_stmt_handle,
+                              &query_stmt,
+                              bind_info);
 
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. Failed executing query stmt - %s",
                    dal_rc, query_stmt.c_str());
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     if (dal_rc == kDalRcParentNotFound) {
       UPLL_LOG_DEBUG("Foreign Key Violation error."
                      " Returning kDalRcGeneralError");
@@ -1042,7 +1078,7 @@ DalOdbcMgr::DeleteRecords(const UpllCfgType cfg_type,
   }
   UPLL_LOG_TRACE("Completed executing query stmt - %s",
                 query_stmt.c_str());
-  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  ReleaseCachedStmt(dal_stmt_handle, true);
 
   if (cfg_type == UPLL_DT_CANDIDATE) {
     // Storing dirty table list for skipping unmodified tables during commit
@@ -1305,10 +1341,11 @@ DalOdbcMgr::CreateRecord(const UpllCfgType cfg_type,
   }
 
   // Allocate Stmt Handle, Bind and Execute the Query Statement
-  dal_rc = ExecuteQuery(&dal_stmt_handle,
-                        &query_stmt,
-                        bind_info);
-  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  dal_rc = ExecuteCachedQuery(query_template, cfg_type, table_index,
+                              &dal_stmt_handle,
+                              &query_stmt,
+                              bind_info);
+  ReleaseCachedStmt(dal_stmt_handle, (dal_rc == kDalRcSuccess));
   // Diagnose GeneralError for ParentCheck and InstanceCheck
   if (dal_rc == kDalRcGeneralError) {
     UPLL_LOG_DEBUG("Err - %d. Failed executing query stmt - %s",
@@ -1458,9 +1495,10 @@ DalOdbcMgr::UpdateRecords(const UpllCfgType cfg_type,
   }
 
   // Allocate Stmt Handle, Bind and Execute the Query Statement
-  dal_rc = ExecuteQuery(&dal_stmt_handle,
-                        &query_stmt,
-                        bind_info);
+  dal_rc = ExecuteCachedQuery(query_template, cfg_type, table_index,
+                              &dal_stmt_handle,
+                              &query_stmt,
+                              bind_info);
 
   if (dal_rc != kDalRcSuccess) {
     UPLL_LOG_DEBUG("Err - %d. Failed executing query stmt - %s",
@@ -1470,12 +1508,12 @@ DalOdbcMgr::UpdateRecords(const UpllCfgType cfg_type,
                      "Returning kDalRcGeneralError");
       dal_rc = kDalRcGeneralError;
     }
-    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    ReleaseCachedStmt(dal_stmt_handle, false);
     return dal_rc;
   }
   UPLL_LOG_TRACE("Completed executing query stmt - %s",
                 query_stmt.c_str());
-  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  ReleaseCachedStmt(dal_stmt_handle, true);
 
   // Storing dirty table list for skip unmodified tables during commit
   if (cfg_type == UPLL_DT_CANDIDATE) {
@@ -1489,6 +1527,274 @@ DalOdbcMgr::UpdateRecords(const UpllCfgType cfg_type,
   return kDalRcSuccess;
 }   // DalOdbcMgr::UpdateRecords
 
+// Creates the records with the given data using arrays of parameters
+DalResultCode
+DalOdbcMgr::CreateRecords(
+    const UpllCfgType cfg_type,
+    const DalTableIndex table_index,
+    const std::vector<const DalBindInfo *> &input_attr_infos,
+    std::vector<DalResultCode> *results,
+    const CfgModeType cfg_mode,
+    const uint8_t* vtn_name) const {
+  DalResultCode dal_rc;
+  DalQueryBuilder  qbldr;
+  std::string query_stmt;
+  std::vector<size_t> bulk_rows;
+  std::vector<size_t> single_rows;
+  size_t created = 0;
+
+  // Validating Inputs
+  dal_rc = ValidateBulkInput(cfg_type, table_index, input_attr_infos,
+                             results, cfg_mode, vtn_name);
+  if (dal_rc != kDalRcSuccess) {
+    return dal_rc;
+  }
+
+  DalApiNum query_template = kDalCreateRecQT;
+  bool bulk_allowed = true;
+  if (cfg_type == UPLL_DT_CANDIDATE) {
+    // If delete dirty is set, the records may exist in CANDIDATE_DEL and
+    // have to be created with u_flag=1. CreateRecord handles them.
+    dal_rc = IsTblDirty(UNC_OP_DELETE, table_index, cfg_mode, vtn_name);
+    if (dal_rc == kDalRcSuccess) {
+      bulk_allowed = false;
+    } else if (dal_rc != kDalRcRecordNotFound) {
+      UPLL_LOG_INFO("Err - %d. IsTblDirty failed for %s in cfg_mode:%d",
+                    dal_rc, schema::TableName(table_index), cfg_mode);
+      return dal_rc;
+    }
+    query_template = kDalCreateCandRecQT;
+  }
+
+  for (size_t row = 0; row < input_attr_infos.size(); row++) {
+    if (!bulk_allowed || input_attr_infos.size() == 1) {
+      single_rows.push_back(row);
+      continue;
+    }
+    // Parent Existence Check for Import Datatype
+    if (cfg_type == UPLL_DT_IMPORT &&
+        schema::TableNumFkCols(table_index) > 0) {
+      dal_rc = CheckParentInstance(cfg_type, table_index,
+                                   input_attr_infos[row]);
+      if (dal_rc == kDalRcRecordNotFound) {
+        UPLL_LOG_DEBUG("Parent Does not Exist");
+        (*results)[row] = kDalRcParentNotFound;
+        continue;
+      } else if (dal_rc != kDalRcRecordAlreadyExists) {
+        UPLL_LOG_DEBUG("Error during Parent Existence Check");
+        (*results)[row] = dal_rc;
+        continue;
+      }
+    }
+    bulk_rows.push_back(row);
+  }
+
+  if (!bulk_rows.empty()) {
+    // Build Query Statement
+    if (qbldr.get_sql_statement(query_template,
+                                input_attr_infos[bulk_rows[0]],
+                                query_stmt, table_index, cfg_type) != true) {
+      UPLL_LOG_DEBUG("Failed building query stmt");
+      return kDalRcGeneralError;
+    }
+    UPLL_LOG_TRACE("Query stmt - %s", query_stmt.c_str());
+  }
+
+  for (size_t start = 0; start < bulk_rows.size(); start += kDalMaxBulkRows) {
+    size_t end = start + kDalMaxBulkRows;
+    if (end > bulk_rows.size()) {
+      end = bulk_rows.size();
+    }
+    std::vector<size_t> chunk(bulk_rows.begin() + start,
+                              bulk_rows.begin() + end);
+    std::vector<SQLUSMALLINT> row_status;
+    SQLLEN affected_rows = 0;
+
+    dal_rc = ExecuteBulkQuery(&query_stmt, input_attr_infos, chunk,
+                              &row_status, &affected_rows);
+    if (conn_state_ == kDalDbDisconnected) {
+      UPLL_LOG_INFO("Err - %d. Connection lost during bulk create", dal_rc);
+      for (size_t i = start; i < bulk_rows.size(); i++) {
+        (*results)[bulk_rows[i]] = dal_rc;
+      }
+      break;
+    }
+    bool chunk_failed = false;
+    for (size_t i = 0; i < chunk.size(); i++) {
+      if (row_status[i] != SQL_PARAM_SUCCESS &&
+          row_status[i] != SQL_PARAM_SUCCESS_WITH_INFO) {
+        chunk_failed = true;
+        break;
+      }
+    }
+    if (chunk_failed) {
+      // The rows reported as created may be rolled back with the failed
+      // one, so the whole chunk is created again one by one to get the
+      // exact error code
+      single_rows.insert(single_rows.end(), chunk.begin(), chunk.end());
+      continue;
+    }
+    for (size_t i = 0; i < chunk.size(); i++) {
+      (*results)[chunk[i]] = kDalRcSuccess;
+    }
+    created += chunk.size();
+  }
+
+  if (created > 0) {
+    UPLL_LOG_TRACE("Created %" PFC_PFMT_SIZE_T " records in table %s in bulk",
+                   created, schema::TableName(table_index));
+    write_count_ += created;
+    // Storing dirty table list for skip unmodified tables during commit
+    if (cfg_type == UPLL_DT_CANDIDATE) {
+      if ((dal_rc = SetTableDirty(cfg_type, table_index, UNC_OP_CREATE,
+                                  cfg_mode, vtn_name)) != kDalRcSuccess) {
+        UPLL_LOG_ERROR("SetTableDirty failed with rc=%d", dal_rc);
+        return kDalRcGeneralError;
+      }
+    }
+  }
+
+  // Keep the order of the records for the ones created one by one
+  std::sort(single_rows.begin(), single_rows.end());
+  for (std::vector<size_t>::iterator it = single_rows.begin();
+       it != single_rows.end(); ++it) {
+    if (conn_state_ == kDalDbDisconnected) {
+      (*results)[*it] = kDalRcConnNotAvailable;
+      continue;
+    }
+    (*results)[*it] = CreateRecord(cfg_type, table_index,
+                                   input_attr_infos[*it],
+                                   cfg_mode, vtn_name);
+  }
+
+  for (size_t row = 0; row < results->size(); row++) {
+    if ((*results)[row] != kDalRcSuccess) {
+      return (*results)[row];
+    }
+  }
+  return kDalRcSuccess;
+}   // DalOdbcMgr::CreateRecords
+
+// Updates the records with the given data using arrays of parameters
+DalResultCode
+DalOdbcMgr::UpdateRecords(
+    const UpllCfgType cfg_type,
+    const DalTableIndex table_index,
+    const std::vector<const DalBindInfo *> &input_and_matching_attr_infos,
+    std::vector<DalResultCode> *results,
+    const CfgModeType cfg_mode,
+    const uint8_t* vtn_name) const {
+  DalResultCode dal_rc;
+  DalQueryBuilder  qbldr;
+  std::string query_stmt;
+  std::vector<size_t> single_rows;
+  size_t updated = 0;
+  const std::vector<const DalBindInfo *> &bind_infos =
+      input_and_matching_attr_infos;
+
+  // Validating Inputs
+  dal_rc = ValidateBulkInput(cfg_type, table_index, bind_infos,
+                             results, cfg_mode, vtn_name);
+  if (dal_rc != kDalRcSuccess) {
+    return dal_rc;
+  }
+
+  DalApiNum query_template;
+  /* Perf: Build query with u_flag when cfg_type is candidate */
+  if (cfg_type == UPLL_DT_CANDIDATE) {
+    query_template = kDalUpdateCandRecQT;
+  } else {
+    query_template = kDalUpdateRecQT;
+  }
+
+  if (bind_infos.size() > 1) {
+    // Build Query Statement
+    if (qbldr.get_sql_statement(query_template, bind_infos[0], query_stmt,
+                                table_index, cfg_type) != true) {
+      UPLL_LOG_DEBUG("Failed building query stmt");
+      return kDalRcGeneralError;
+    }
+    UPLL_LOG_TRACE("Query stmt - %s", query_stmt.c_str());
+  } else {
+    single_rows.push_back(0);
+  }
+
+  for (size_t start = 0; bind_infos.size() > 1 && start < bind_infos.size();
+       start += kDalMaxBulkRows) {
+    size_t end = start + kDalMaxBulkRows;
+    if (end > bind_infos.size()) {
+      end = bind_infos.size();
+    }
+    std::vector<size_t> chunk;
+    for (size_t row = start; row < end; row++) {
+      chunk.push_back(row);
+    }
+    std::vector<SQLUSMALLINT> row_status;
+    SQLLEN affected_rows = 0;
+
+    dal_rc = ExecuteBulkQuery(&query_stmt, bind_infos, chunk,
+                              &row_status, &affected_rows);
+    if (conn_state_ == kDalDbDisconnected) {
+      UPLL_LOG_INFO("Err - %d. Connection lost during bulk update", dal_rc);
+      for (size_t row = start; row < bind_infos.size(); row++) {
+        (*results)[row] = dal_rc;
+      }
+      break;
+    }
+    size_t succeeded = 0;
+    for (size_t i = 0; i < chunk.size(); i++) {
+      if (row_status[i] == SQL_PARAM_SUCCESS ||
+          row_status[i] == SQL_PARAM_SUCCESS_WITH_INFO) {
+        succeeded++;
+      }
+    }
+    // The updates reported as successful may be rolled back with a failed
+    // one, and the status array does not tell which updates matched no
+    // record. In either case the whole chunk is updated again one by one;
+    // applying the same update again is harmless.
+    if (succeeded != chunk.size() ||
+        affected_rows < static_cast<SQLLEN>(succeeded)) {
+      single_rows.insert(single_rows.end(), chunk.begin(), chunk.end());
+      continue;
+    }
+    for (size_t i = 0; i < chunk.size(); i++) {
+      (*results)[chunk[i]] = kDalRcSuccess;
+    }
+    updated += chunk.size();
+  }
+
+  if (updated > 0) {
+    UPLL_LOG_TRACE("Updated %" PFC_PFMT_SIZE_T " records in table %s in bulk",
+                   updated, schema::TableName(table_index));
+    write_count_ += updated;
+    // Storing dirty table list for skip unmodified tables during commit
+    if (cfg_type == UPLL_DT_CANDIDATE) {
+      if ((dal_rc = SetTableDirty(cfg_type, table_index, UNC_OP_UPDATE,
+                                  cfg_mode, vtn_name)) != kDalRcSuccess) {
+        UPLL_LOG_ERROR("SetTableDirty failed with rc=%d", dal_rc);
+        return kDalRcGeneralError;
+      }
+    }
+  }
+
+  for (std::vector<size_t>::iterator it = single_rows.begin();
+       it != single_rows.end(); ++it) {
+    if (conn_state_ == kDalDbDisconnected) {
+      (*results)[*it] = kDalRcConnNotAvailable;
+      continue;
+    }
+    (*results)[*it] = UpdateRecords(cfg_type, table_index, bind_infos[*it],
+                                    cfg_mode, vtn_name);
+  }
+
+  for (size_t row = 0; row < results->size(); row++) {
+    if ((*results)[row] != kDalRcSuccess) {
+      return (*results)[row];
+    }
+  }
+  return kDalRcSuccess;
+}   // DalOdbcMgr::UpdateRecords
+
 // Executes the user given query
 DalResultCode
 DalOdbcMgr::ExecuteAppQuery(std::string query_stmt,
@@ -1688,7 +1994,8 @@ DalOdbcMgr::GetDeletedRecords(const UpllCfgType cfg_type_1,
                 query_stmt.c_str());
 
   *cursor = new DalCursor(dal_stmt_handle,
-                           bind_info);
+                           bind_info,
+                           CursorRowArraySize(0));
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor for the result");
     FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
@@ -1939,7 +2246,8 @@ DalOdbcMgr::GetCreatedRecords(const UpllCfgType cfg_type_1,
   UPLL_LOG_TRACE("Completed executing query stmt - %s",
                 query_stmt.c_str());
   *cursor = new DalCursor(dal_stmt_handle,
-                           bind_info);
+                           bind_info,
+                           CursorRowArraySize(0));
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor for the result");
     FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
@@ -2156,7 +2464,8 @@ DalOdbcMgr::GetUpdatedRecords(const UpllCfgType cfg_type_1,
   *cursor = new DalCursor(cfg_1_stmt_handle,
                           cfg_1_bind_info,
                           cfg_2_stmt_handle,
-                          cfg_2_bind_info);
+                          cfg_2_bind_info,
+                          CursorRowArraySize(0));
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor for the result");
     FreeHandle(SQL_HANDLE_STMT, cfg_1_stmt_handle);
@@ -2167,7 +2476,164 @@ DalOdbcMgr::GetUpdatedRecords(const UpllCfgType cfg_type_1,
   UPLL_LOG_TRACE("Allocated cursor for the result for both the config"
                "(%d, %d)",  cfg_type_1, cfg_type_2);
   return kDalRcSuccess;
-}  // DalOdbcMgr::GetUpdatedRecords
+}  // DalOdbcMgr::GetUpdatedRecords
+
+// Gets the deleted, created and updated records of cfg_type_1 in one query
+DalResultCode
+DalOdbcMgr::GetChangedRecords(const UpllCfgType cfg_type_1,
+                              const UpllCfgType cfg_type_2,
+                              const DalTableIndex table_index,
+                              const size_t max_record_count,
+                              const DalBindInfo *bind_info,
+                              int16_t *change,
+                              DalCursor **cursor,
+                              const CfgModeType cfg_mode,
+                              const uint8_t* vtn_name) const {
+  SQLHANDLE     dal_stmt_handle = SQL_NULL_HANDLE;
+  SQLRETURN     sql_rc;
+  DalResultCode dal_rc;
+  DalQueryBuilder  qbldr;
+  std::string query_stmt;
+  *cursor = NULL;
+
+  // Validating Inputs
+  if (cfg_type_1 != UPLL_DT_CANDIDATE || cfg_type_2 != UPLL_DT_RUNNING) {
+    UPLL_LOG_DEBUG("Invalid config type - (%d, %d)", cfg_type_1, cfg_type_2);
+    return kDalRcGeneralError;
+  }
+
+  if (table_index >= schema::table::kDalNumTables) {
+    UPLL_LOG_DEBUG("Invalid table index - %d", table_index);
+    return kDalRcGeneralError;
+  }
+
+  // The vtn_name match of each part is not supported
+  if (cfg_mode >= TC_CONFIG_VTN) {
+    UPLL_LOG_ERROR("Invalid cfg_mode - %d", cfg_mode);
+    return kDalRcGeneralError;
+  }
+
+  if (bind_info == NULL || change == NULL) {
+    UPLL_LOG_DEBUG("NULL Bind Info or change for Table(%s)",
+                   schema::TableName(table_index));
+    return kDalRcGeneralError;
+  }
+
+  if (table_index != bind_info->get_table_index()) {
+    UPLL_LOG_DEBUG("Table index mismatch with bind info "
+                   "Query - %s; Bind - %s",
+                   schema::TableName(table_index),
+                   schema::TableName(bind_info->get_table_index()));
+    return kDalRcGeneralError;
+  }
+
+  // The parts are ordered by primary key, so it must be in the output.
+  // dal_change is the column after the output columns and dal_change_grp.
+  DalBindList bind_list = bind_info->get_bind_list();
+  size_t num_pk_out = 0;
+  SQLUSMALLINT change_col = 2;
+  for (DalBindList::iterator bl_it = bind_list.begin();
+       bl_it != bind_list.end(); ++bl_it) {
+    if ((*bl_it)->get_io_type() != kDalIoOutputOnly &&
+        (*bl_it)->get_io_type() != kDalIoOutputAndMatch) {
+      continue;
+    }
+    change_col++;
+    if (schema::ColumnIsPKeyIndex(table_index,
+                                  (*bl_it)->get_column_index())) {
+      num_pk_out++;
+    }
+  }
+  if (num_pk_out != schema::TableNumPkCols(table_index)) {
+    UPLL_LOG_DEBUG("Primary key of Table(%s) is not bound for output",
+                   schema::TableName(table_index));
+    return kDalRcGeneralError;
+  }
+
+  // Only the parts of the dirty operations are read
+  const struct {
+    unc_keytype_operation_t op;
+    DalApiNum query_template;
+  } parts[] = {
+    { UNC_OP_DELETE, kDalGetChangedDelRecQT },
+    { UNC_OP_CREATE, kDalGetChangedCreatedRecQT },
+    { UNC_OP_UPDATE, kDalGetChangedUpdatedRecQT },
+    { UNC_OP_UPDATE, kDalGetChangedUpdatedOldRecQT } };
+  for (size_t i = 0; i < sizeof(parts)/sizeof(parts[0]); i++) {
+    dal_rc = IsTblDirty(parts[i].op, table_index, cfg_mode, vtn_name);
+    if (kDalRcRecordNotFound == dal_rc) {
+      continue;
+    }
+    if (kDalRcSuccess != dal_rc) {
+      UPLL_LOG_INFO("Err - %d. IsTblDirty failed for %s in cfg_mode:%d",
+                    dal_rc, schema::TableName(table_index), cfg_mode);
+      return dal_rc;
+    }
+    std::string part_stmt;
+    if (qbldr.get_sql_statement(parts[i].query_template, bind_info,
+                                part_stmt, table_index, cfg_type_1,
+                                cfg_type_2) != true) {
+      UPLL_LOG_TRACE("Failed building query stmt");
+      return kDalRcGeneralError;
+    }
+    if (!query_stmt.empty()) {
+      query_stmt += " UNION ALL ";
+    }
+    query_stmt += part_stmt;
+  }
+  if (query_stmt.empty()) {
+    UPLL_LOG_DEBUG("Skipping GetChangedRecords for %s",
+                   schema::TableName(table_index));
+    return kDalRcRecordNotFound;
+  }
+  std::string order_stmt;
+  if (qbldr.get_sql_statement(kDalGetChangedRecOrderQT, bind_info,
+                              order_stmt, table_index, cfg_type_1,
+                              cfg_type_2) != true) {
+    UPLL_LOG_TRACE("Failed building query stmt");
+    return kDalRcGeneralError;
+  }
+  query_stmt += order_stmt;
+  UPLL_LOG_DEBUG("Query stmt - %s", query_stmt.c_str());
+
+  // Allocate Stmt Handle, Bind and Execute the Query Statement
+  dal_rc = ExecuteQuery(&dal_stmt_handle,
+                        &query_stmt,
+                        bind_info,
+                        max_record_count);
+  if (dal_rc != kDalRcSuccess) {
+    UPLL_LOG_DEBUG("Err - %d. Failed executing query stmt - %s",
+                   dal_rc, query_stmt.c_str());
+    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    return dal_rc;
+  }
+
+  // dal_change is not in the bind info, so the cursor fetches row by row
+  // into change
+  sql_rc = SQLBindCol(dal_stmt_handle, change_col, SQL_C_SHORT,
+                      change, sizeof(*change), NULL);
+  DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                     dal_stmt_handle,
+                                     sql_rc, &dal_rc);
+  SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+  if (dal_rc != kDalRcSuccess) {
+    UPLL_LOG_INFO("Err - %d. Failed to Bind dal_change of Table(%s)",
+                  dal_rc, schema::TableName(table_index));
+    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    return dal_rc;
+  }
+  UPLL_LOG_TRACE("Completed executing query stmt - %s",
+                query_stmt.c_str());
+
+  *cursor = new DalCursor(dal_stmt_handle, bind_info);
+  if (*cursor == NULL) {
+    UPLL_LOG_DEBUG("Failed to allocate cursor for the result");
+    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    return kDalRcGeneralError;
+  }
+  UPLL_LOG_TRACE("Allocated cursor for the result");
+  return kDalRcSuccess;
+}  // DalOdbcMgr::GetChangedRecords
 
 // Copies the entire records of dest to src cfg_type
 DalResultCode
@@ -2763,7 +3229,8 @@ DalOdbcMgr::ExecuteAppQueryMultipleRecords(
                 query_stmt.c_str());
 
   *cursor = new DalCursor(dal_stmt_handle,
-                          bind_info);
+                          bind_info,
+                          CursorRowArraySize(max_record_count));
   // PFC_ASSERT(*cursor)
   if (*cursor == NULL) {
     UPLL_LOG_DEBUG("Failed to allocate cursor handle for the result");
@@ -2903,6 +3370,8 @@ DalOdbcMgr::SetStmtAttributes(const SQLHANDLE stmt_handle) const {
 #endif
   // SQL_ATTR_ROW_ARRAY_SIZE - 1 (default)
   //   Number of records to be fetched using SQLFetch
+  //   DalCursor sets it on its handles to fetch in blocks
+  //   (row_array_size in dal.conf)
 
   // SQL_ATTR_PARAM_BIND_TYPE - SQL_PARAM_BIND_BY_COLUMN (default)
   //   Binding column by column
@@ -3284,15 +3753,8 @@ DalOdbcMgr::ExecuteQuery(SQLHANDLE *dal_stmt_handle,
     UPLL_LOG_VERBOSE("Success Binding parameters to Query");
   }
 
-  if (wr_exclusion_on_runn_) {
-    wr_exclusion_var_mutex_.lock();
-    if (!wr_exclusion_runn_mutex_acqd_ && CheckRunnUpdateQuery(query_stmt)) {
-      UPLL_LOG_TRACE("Trying to acquire running exclusive lock for update");
-      DalOdbcMgr::AcquireRunnExclusiveLock();
-      UPLL_LOG_TRACE("Acquired running exclusive lock for update");
-    }
-    wr_exclusion_var_mutex_.unlock();
-  }
+  CheckAndAcquireRunnExclusiveLock(query_stmt);
+  CountWriteGeneration(query_stmt);
 
   // Executing the Query Statement
   sql_rc = SQLExecDirect(*dal_stmt_handle,
@@ -3319,6 +3781,398 @@ DalOdbcMgr::ExecuteQuery(SQLHANDLE *dal_stmt_handle,
   return kDalRcSuccess;
 }   // DalOdbcMgr::ExecuteQuery
 
+// Reuses or Prepares Stmt Handle, Bind Parameters and Execute the Query
+DalResultCode
+DalOdbcMgr::ExecuteCachedQuery(const DalApiNum api_num,
+                               const UpllCfgType cfg_type,
+                               const DalTableIndex table_index,
+                               SQLHANDLE *dal_stmt_handle,
+                               const std::string *query_stmt,
+                               const DalBindInfo *bind_info,
+                               const uint32_t max_count) const {
+  SQLRETURN     sql_rc;
+  DalResultCode dal_rc;
+
+  if (dal_stmt_handle == SQL_NULL_HANDLE) {
+    UPLL_LOG_ERROR("NULL Statement Handle Reference");
+    return kDalRcGeneralError;
+  }
+
+  if (query_stmt == NULL) {
+    UPLL_LOG_ERROR("NULL Query stmt");
+    return kDalRcGeneralError;
+  }
+
+  if (!stmt_cache_.is_enabled()) {
+    return ExecuteQuery(dal_stmt_handle, query_stmt, bind_info, max_count);
+  }
+
+  DalStmtCacheKey cache_key;
+  DalStmtCache::MakeKey(api_num, table_index, cfg_type, bind_info,
+                        &cache_key);
+  *dal_stmt_handle = stmt_cache_.Acquire(cache_key, *query_stmt);
+
+  if (*dal_stmt_handle == SQL_NULL_HANDLE) {
+    // Allocate and Prepare Statement Handle
+    sql_rc = SQLAllocHandle(SQL_HANDLE_STMT,
+                            dal_conn_handle_,
+                            dal_stmt_handle);
+    DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                       *dal_stmt_handle,
+                                       sql_rc, &dal_rc);
+    SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+    if (dal_rc != kDalRcSuccess) {
+      UPLL_LOG_DEBUG("Err - %d. Failed to Allocate Statement handle",
+                     dal_rc);
+      return dal_rc;
+    }
+    if (*dal_stmt_handle == SQL_NULL_HANDLE) {
+      UPLL_LOG_ERROR("Err - %d. Failed to Allocate Statement handle",
+                     dal_rc);
+      return kDalRcGeneralError;
+    }
+
+    SetStmtAttributes(*dal_stmt_handle);
+
+    sql_rc = SQLPrepare(*dal_stmt_handle,
+                        (unsigned char*)(query_stmt->c_str()),
+                        SQL_NTS);
+    DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                       *dal_stmt_handle,
+                                       sql_rc, &dal_rc);
+    SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+    if (dal_rc != kDalRcSuccess) {
+      UPLL_LOG_INFO("Err - %d. Failed to Prepare Query %s",
+                    dal_rc, query_stmt->c_str());
+      return dal_rc;
+    }
+
+    SQLHANDLE evicted = SQL_NULL_HANDLE;
+    if (stmt_cache_.Insert(cache_key, *query_stmt, *dal_stmt_handle,
+                           &evicted)) {
+      UPLL_LOG_TRACE("Statement Handle(%p) Prepared and Cached",
+                     *dal_stmt_handle);
+    }
+    FreeHandle(SQL_HANDLE_STMT, evicted);
+  } else {
+    // Drop the buffers of the previous DAL call before rebinding
+    SQLFreeStmt(*dal_stmt_handle, SQL_UNBIND);
+    SQLFreeStmt(*dal_stmt_handle, SQL_RESET_PARAMS);
+    UPLL_LOG_TRACE("Statement Handle(%p) Reused", *dal_stmt_handle);
+  }
+
+  // Setting Cursor Attributes
+  SetCursorAttributes(*dal_stmt_handle, max_count);
+
+  // Bind attributes to query statement only if available
+  if (bind_info != NULL) {
+    dal_rc = BindToQuery(dal_stmt_handle, bind_info);
+    SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+    if (dal_rc != kDalRcSuccess) {
+      UPLL_LOG_INFO("Err - %d. Failed to Bind parameters to Query", dal_rc);
+      return dal_rc;
+    }
+    UPLL_LOG_VERBOSE("Success Binding parameters to Query");
+  }
+
+  CheckAndAcquireRunnExclusiveLock(query_stmt);
+  CountWriteGeneration(query_stmt);
+
+  // Executing the Prepared Statement
+  sql_rc = SQLExecute(*dal_stmt_handle);
+  DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                     *dal_stmt_handle,
+                                     sql_rc, &dal_rc);
+  SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+  if (dal_rc != kDalRcSuccess) {
+    if (dal_rc != kDalRcRecordNotFound &&
+        dal_rc != kDalRcRecordAlreadyExists) {
+      UPLL_LOG_INFO("Err - %d. Failed to Execute Query %s",
+                    dal_rc, query_stmt->c_str());
+    } else {
+      UPLL_LOG_DEBUG("Err - %d. Failed to Execute Query %s",
+                     dal_rc, query_stmt->c_str());
+    }
+    return dal_rc;
+  }
+
+  UPLL_LOG_VERBOSE("Query Successfully Executed %s",
+                query_stmt->c_str());
+  return kDalRcSuccess;
+}   // DalOdbcMgr::ExecuteCachedQuery
+
+// Binds the rows as arrays of parameters and executes the query once
+DalResultCode
+DalOdbcMgr::ExecuteBulkQuery(
+    const std::string *query_stmt,
+    const std::vector<const DalBindInfo *> &bind_infos,
+    const std::vector<size_t> &rows,
+    std::vector<SQLUSMALLINT> *row_status,
+    SQLLEN *affected_rows) const {
+  SQLHANDLE     dal_stmt_handle = SQL_NULL_HANDLE;
+  SQLRETURN     sql_rc;
+  DalResultCode dal_rc;
+  const size_t  num_rows = rows.size();
+
+  // Rows not reported by the driver are retried by the caller
+  row_status->assign(num_rows, SQL_PARAM_UNUSED);
+  *affected_rows = 0;
+
+  if (query_stmt == NULL || num_rows == 0) {
+    UPLL_LOG_ERROR("NULL Query stmt or no rows");
+    return kDalRcGeneralError;
+  }
+
+  const DalTableIndex table_index = bind_infos[rows[0]]->get_table_index();
+
+  // All rows must bind the same columns to share the query statement
+  DalStmtCacheKey first_shape, row_shape;
+  DalStmtCache::MakeKey(kDalCreateRecQT, table_index, UPLL_DT_INVALID,
+                        bind_infos[rows[0]], &first_shape);
+  std::vector<DalBindList> row_lists(num_rows);
+  for (size_t r = 0; r < num_rows; r++) {
+    DalStmtCache::MakeKey(kDalCreateRecQT, table_index,
+                          UPLL_DT_INVALID, bind_infos[rows[r]], &row_shape);
+    if (row_shape.bind_shape != first_shape.bind_shape) {
+      UPLL_LOG_DEBUG("Bind shape of row %" PFC_PFMT_SIZE_T
+                     " differs for Table(%s)", r,
+                     schema::TableName(table_index));
+      return kDalRcGeneralError;
+    }
+    row_lists[r] = bind_infos[rows[r]]->get_bind_list();
+  }
+
+  // Parameter positions in the order of BindToQuery: inputs, then matches
+  std::vector<size_t> param_pos;
+  std::vector<bool> param_match;
+  const DalBindList &first_list = row_lists[0];
+  for (size_t pos = 0; pos < first_list.size(); pos++) {
+    DalIoType io_type = first_list[pos]->get_io_type();
+    if (io_type == kDalIoInputOnly || io_type == kDalIoInputAndMatch) {
+      param_pos.push_back(pos);
+      param_match.push_back(false);
+    }
+  }
+  for (size_t pos = 0; pos < first_list.size(); pos++) {
+    DalIoType io_type = first_list[pos]->get_io_type();
+    if (io_type == kDalIoMatchOnly || io_type == kDalIoInputAndMatch ||
+        io_type == kDalIoOutputAndMatch) {
+      param_pos.push_back(pos);
+      param_match.push_back(true);
+    }
+  }
+
+  // Copy the bound values of each row into column-wise arrays
+  std::vector<std::vector<uint8_t> > param_data(param_pos.size());
+  std::vector<std::vector<SQLLEN> > param_len(param_pos.size());
+  std::vector<size_t> param_size(param_pos.size());
+  for (size_t p = 0; p < param_pos.size(); p++) {
+    DalColumnIndex column_index =
+        first_list[param_pos[p]]->get_column_index();
+    param_size[p] = DalBindColumnInfo::GetDalBufferSize(table_index,
+                                                        column_index);
+    param_data[p].resize(param_size[p] * num_rows);
+    param_len[p].resize(num_rows);
+    for (size_t r = 0; r < num_rows; r++) {
+      DalBindColumnInfo *col_info = row_lists[r][param_pos[p]];
+      const void *src = (param_match[p] ? col_info->get_db_match_addr() :
+                         col_info->get_db_in_out_addr());
+      if (src == NULL || col_info->get_buff_len_ptr() == NULL) {
+        UPLL_LOG_DEBUG("NULL DB buffer for Column(%s) in Table(%s)",
+                       schema::ColumnName(table_index, column_index),
+                       schema::TableName(table_index));
+        return kDalRcGeneralError;
+      }
+      size_t copy_size = col_info->GetDalOutBufferSize(table_index);
+      if (copy_size > param_size[p]) {
+        copy_size = param_size[p];
+      }
+      memcpy(&param_data[p][r * param_size[p]], src, copy_size);
+      param_len[p][r] = *(col_info->get_buff_len_ptr());
+    }
+  }
+
+  // Allocate Statement Handle
+  sql_rc = SQLAllocHandle(SQL_HANDLE_STMT,
+                          dal_conn_handle_,
+                          &dal_stmt_handle);
+  DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                     dal_stmt_handle,
+                                     sql_rc, &dal_rc);
+  SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+  if (dal_rc != kDalRcSuccess || dal_stmt_handle == SQL_NULL_HANDLE) {
+    UPLL_LOG_DEBUG("Err - %d. Failed to Allocate Statement handle",
+                   dal_rc);
+    return (dal_rc != kDalRcSuccess) ? dal_rc : kDalRcGeneralError;
+  }
+
+  // Setting Statement Attributes
+  SetStmtAttributes(dal_stmt_handle);
+
+  // Setting Parameter Array Attributes
+  SQLULEN params_processed = 0;
+  sql_rc = SQLSetStmtAttr(dal_stmt_handle, SQL_ATTR_PARAM_BIND_TYPE,
+                          reinterpret_cast<SQLPOINTER>(
+                              SQL_PARAM_BIND_BY_COLUMN), 0);
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO) {
+    sql_rc = SQLSetStmtAttr(dal_stmt_handle, SQL_ATTR_PARAMSET_SIZE,
+                            reinterpret_cast<SQLPOINTER>(num_rows), 0);
+  }
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO) {
+    sql_rc = SQLSetStmtAttr(dal_stmt_handle, SQL_ATTR_PARAM_STATUS_PTR,
+                            &(*row_status)[0], 0);
+  }
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO) {
+    sql_rc = SQLSetStmtAttr(dal_stmt_handle, SQL_ATTR_PARAMS_PROCESSED_PTR,
+                            &params_processed, 0);
+  }
+  DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                     dal_stmt_handle,
+                                     sql_rc, &dal_rc);
+  if (dal_rc != kDalRcSuccess) {
+    UPLL_LOG_INFO("Err - %d. Failed to set parameter array attributes",
+                  dal_rc);
+    FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+    return dal_rc;
+  }
+
+  // Bind the arrays
+  for (size_t p = 0; p < param_pos.size(); p++) {
+    DalBindColumnInfo *col_info = first_list[param_pos[p]];
+    DalColumnIndex column_index = col_info->get_column_index();
+    sql_rc = SQLBindParameter(
+        dal_stmt_handle,
+        static_cast<SQLUSMALLINT>(p + 1),
+        SQL_PARAM_INPUT,
+        schema::ColumnDalDataTypeId(table_index, column_index),
+        schema::ColumnDbDataTypeId(table_index, column_index),
+        *(col_info->get_buff_len_ptr()),
+        0,
+        &param_data[p][0],
+        param_size[p],
+        &param_len[p][0]);
+    DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                       dal_stmt_handle,
+                                       sql_rc, &dal_rc);
+    SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+    if (dal_rc != kDalRcSuccess) {
+      UPLL_LOG_INFO("Err - %d. Failed to Bind Column(%s) array in Table(%s)",
+                    dal_rc, schema::ColumnName(table_index, column_index),
+                    schema::TableName(table_index));
+      FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+      return dal_rc;
+    }
+  }
+
+  CheckAndAcquireRunnExclusiveLock(query_stmt);
+  CountWriteGeneration(query_stmt);
+
+  // Executing the Query Statement for all the rows
+  sql_rc = SQLExecDirect(dal_stmt_handle,
+                         (unsigned char*)(query_stmt->c_str()),
+                         SQL_NTS);
+  DalErrorHandler::ProcessOdbcErrors(SQL_HANDLE_STMT,
+                                     dal_stmt_handle,
+                                     sql_rc, &dal_rc);
+  SET_DB_STATE_DISCONNECT(dal_rc, conn_state_);
+  if (sql_rc == SQL_SUCCESS || sql_rc == SQL_SUCCESS_WITH_INFO ||
+      sql_rc == SQL_ERROR) {
+    SQLRowCount(dal_stmt_handle, affected_rows);
+  }
+  if (dal_rc != kDalRcSuccess) {
+    UPLL_LOG_DEBUG("Err - %d. Bulk execution of %" PFC_PFMT_SIZE_T
+                   " rows processed %" PFC_PFMT_SIZE_T " rows. Query %s",
+                   dal_rc, num_rows, static_cast<size_t>(params_processed),
+                   query_stmt->c_str());
+  } else {
+    UPLL_LOG_VERBOSE("Bulk Query Successfully Executed for %" PFC_PFMT_SIZE_T
+                     " rows %s", num_rows, query_stmt->c_str());
+  }
+  FreeHandle(SQL_HANDLE_STMT, dal_stmt_handle);
+  return dal_rc;
+}   // DalOdbcMgr::ExecuteBulkQuery
+
+// Validates the inputs of bulk create and update
+DalResultCode
+DalOdbcMgr::ValidateBulkInput(
+    const UpllCfgType cfg_type,
+    const DalTableIndex table_index,
+    const std::vector<const DalBindInfo *> &bind_infos,
+    std::vector<DalResultCode> *results,
+    const CfgModeType cfg_mode,
+    const uint8_t* vtn_name) const {
+  if (results == NULL) {
+    UPLL_LOG_DEBUG("NULL results reference");
+    return kDalRcGeneralError;
+  }
+  results->assign(bind_infos.size(), kDalRcGeneralError);
+
+  if (cfg_type == UPLL_DT_INVALID) {
+    UPLL_LOG_DEBUG("Invalid config type - %d", cfg_type);
+    return kDalRcGeneralError;
+  }
+
+  if (table_index >= schema::table::kDalNumTables) {
+    UPLL_LOG_DEBUG("Invalid table index - %d", table_index);
+    return kDalRcGeneralError;
+  }
+
+  if (bind_infos.empty()) {
+    UPLL_LOG_DEBUG("No Bind Info for Table(%s)",
+                   schema::TableName(table_index));
+    return kDalRcGeneralError;
+  }
+
+  for (size_t row = 0; row < bind_infos.size(); row++) {
+    if (bind_infos[row] == NULL) {
+      UPLL_LOG_DEBUG("NULL Bind Info for Table(%s)",
+                     schema::TableName(table_index));
+      return kDalRcGeneralError;
+    }
+    if (table_index != bind_infos[row]->get_table_index()) {
+      UPLL_LOG_DEBUG("Table index mismatch with bind info "
+                     "Query - %s; Bind - %s",
+                     schema::TableName(table_index),
+                     schema::TableName(bind_infos[row]->get_table_index()));
+      return kDalRcGeneralError;
+    }
+  }
+
+  if (cfg_mode > TC_CONFIG_VTN) {
+    UPLL_LOG_ERROR("Invalid cfg_mode - %d", cfg_mode);
+    return kDalRcGeneralError;
+  }
+
+  if (cfg_mode == TC_CONFIG_VTN && vtn_name == NULL) {
+    UPLL_LOG_ERROR("Invalid vtn_name in cfg_mode - %d", cfg_mode);
+    return kDalRcGeneralError;
+  }
+  return kDalRcSuccess;
+}   // DalOdbcMgr::ValidateBulkInput
+
+// Acquires running exclusive lock for the queries updating running
+void
+DalOdbcMgr::CheckAndAcquireRunnExclusiveLock(
+    const std::string *query_stmt) const {
+  if (wr_exclusion_on_runn_) {
+    wr_exclusion_var_mutex_.lock();
+    if (!wr_exclusion_runn_mutex_acqd_ && CheckRunnUpdateQuery(query_stmt)) {
+      UPLL_LOG_TRACE("Trying to acquire running exclusive lock for update");
+      DalOdbcMgr::AcquireRunnExclusiveLock();
+      UPLL_LOG_TRACE("Acquired running exclusive lock for update");
+    }
+    wr_exclusion_var_mutex_.unlock();
+  }
+}
+
+// Writes, including the failed ones, may change the rows read so far
+void
+DalOdbcMgr::CountWriteGeneration(const std::string *query_stmt) const {
+  if (query_stmt->compare(0, 6, "SELECT") != 0) {
+    pfc_atomic_inc_uint64(&write_generation_);
+  }
+}
+
 // Frees the handle passed
 inline DalResultCode
 DalOdbcMgr::FreeHandle(const SQLSMALLINT handle_type,
@@ -3344,6 +4198,32 @@ DalOdbcMgr::FreeHandle(const SQLSMALLINT handle_type,
   return kDalRcSuccess;
 }
 
+// Gives back the handle returned by ExecuteCachedQuery
+void
+DalOdbcMgr::ReleaseCachedStmt(SQLHANDLE stmt_handle, const bool reuse) const {
+  if (stmt_handle == SQL_NULL_HANDLE) {
+    return;
+  }
+  if (reuse && stmt_cache_.Release(stmt_handle)) {
+    // Close the result set, the prepared statement is kept
+    SQLFreeStmt(stmt_handle, SQL_CLOSE);
+    return;
+  }
+  stmt_cache_.Erase(stmt_handle);
+  FreeHandle(SQL_HANDLE_STMT, stmt_handle);
+}
+
+// Frees all the cached statement handles
+void
+DalOdbcMgr::ClearStmtCache() const {
+  std::vector<SQLHANDLE> handles;
+  stmt_cache_.Clear(&handles);
+  for (std::vector<SQLHANDLE>::iterator it = handles.begin();
+       it != handles.end(); ++it) {
+    FreeHandle(SQL_HANDLE_STMT, *it);
+  }
+}
+
 // Derives the Database Connection String from Conf file - dal.conf
 std::string
 DalOdbcMgr::GetConnString(const DalConnType conn_type) const {
@@ -4660,6 +5540,66 @@ DalOdbcMgr::GetMaxcfgSession() const {
   return max_sessions;
 }
 
+// Read prepared statement cache size from dal.conf file
+uint32_t
+DalOdbcMgr::GetStmtCacheSize() const {
+  UPLL_FUNC_TRACE
+  std::string dal_cf_str = DAL_CONF_FILE;
+  uint32_t max_stmts = 0;
+
+  pfc::core::ConfHandle dal_cf_handle(dal_cf_str, &dal_cfdef);
+  int32_t cf_err = dal_cf_handle.getError();
+  if (cf_err != 0) {
+    UPLL_LOG_ERROR("Err - %d. Error while reading conf file = %s ",
+                  cf_err, dal_cf_str.c_str());
+    return default_stmt_cache_size_;
+  }
+
+  pfc::core::ConfBlock dal_cfb(dal_cf_handle, "stmt_cache_params",
+                               "stmt_cache");
+
+  max_stmts = dal_cfb.getUint32("max_stmts", default_stmt_cache_size_);
+  UPLL_LOG_INFO("max_stmts configured in dal.conf is %d", max_stmts);
+  return max_stmts;
+}
+
+// Read block cursor row array size from dal.conf file
+uint32_t
+DalOdbcMgr::GetCursorRowArraySize() const {
+  UPLL_FUNC_TRACE
+  std::string dal_cf_str = DAL_CONF_FILE;
+  uint32_t row_array_size = 0;
+
+  pfc::core::ConfHandle dal_cf_handle(dal_cf_str, &dal_cfdef);
+  int32_t cf_err = dal_cf_handle.getError();
+  if (cf_err != 0) {
+    UPLL_LOG_ERROR("Err - %d. Error while reading conf file = %s ",
+                  cf_err, dal_cf_str.c_str());
+    return default_cursor_row_array_size_;
+  }
+
+  pfc::core::ConfBlock dal_cfb(dal_cf_handle, "cursor_params",
+                               "block_cursor");
+
+  row_array_size = dal_cfb.getUint32("row_array_size",
+                                     default_cursor_row_array_size_);
+  if (row_array_size == 0) {
+    row_array_size = 1;
+  }
+  UPLL_LOG_INFO("row_array_size configured in dal.conf is %d",
+                row_array_size);
+  return row_array_size;
+}
+
+// Rows per fetch for a cursor returning at most max_count records
+uint32_t
+DalOdbcMgr::CursorRowArraySize(const size_t max_count) const {
+  if (max_count != 0 && max_count < cursor_row_array_size_) {
+    return static_cast<uint32_t>(max_count);
+  }
+  return cursor_row_array_size_;
+}
+
 DalResultCode
 DalOdbcMgr::ClearDirtyTblCache(const CfgModeType cfg_mode,
                                const uint8_t* vtn_name) const {
@@ -19,12 +19,15 @@
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 #include <utility>
+#include "pfc/atomic.h"
 #include "pfcxx/module.hh"
 #include "unc/config.h"
 #include "dal_defines.hh"
 #include "dal_conn_intf.hh"
 #include "dal_dml_intf.hh"
+#include "dal_stmt_cache.hh"
 #include "uncxx/upll_log.hh"
 #include "cxx/pfcxx/synch.hh"
 
@@ -94,6 +97,23 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
     inline DalConnState get_conn_state() { return conn_state_; }
     inline uint32_t get_write_count() { return write_count_; }
     inline void reset_write_count() { write_count_ = 0; }
+    // Changes whenever the data seen by this connection or by the other
+    // connections may change: on every executed write, commit and
+    // rollback. Unlike the write count it is never reset.
+    inline uint64_t get_write_generation() const {
+      return pfc_atomic_read_uint64(&write_generation_);
+    }
+
+    // Prepared statement cache statistics of this connection
+    inline uint64_t get_stmt_cache_hits() const {
+      return stmt_cache_.get_hits();
+    }
+    inline uint64_t get_stmt_cache_misses() const {
+      return stmt_cache_.get_misses();
+    }
+    inline uint64_t get_stmt_cache_evictions() const {
+      return stmt_cache_.get_evictions();
+    }
 
     /**
      * CommitTransaction
@@ -522,6 +542,78 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
                     const CfgModeType cfg_mode,
                     const uint8_t* vtn_name) const;
 
+    /**
+     * CreateRecords
+     *   Creates the records in table with the given input data for the
+     *   given cfg_type using arrays of parameters, so that the records are
+     *   sent to the database in one round trip per kDalMaxBulkRows records.
+     *   Records which cannot be created in bulk (all the records of a
+     *   chunk having a record failed in the array execution, or candidate
+     *   records which may exist in CANDIDATE_DEL) are created one by one
+     *   with CreateRecord to get proper error codes.
+     *   Increments the write count for each created record.
+     *
+     * @param[in] cfg_type        - Configuration Type for which the records
+     *                              have to be created
+     * @param[in] table_index     - Valid Index of the table
+     * @param[in] input_attr_infos
+     *                            - Bind Information for each record
+     * @param[out] results        - Result code of each record
+     * @param[in] cfg_mode        - Configuration mode
+     * @param[in] vtn_name        - VTN name of corresponding VTN config mode
+     *
+     * @return DalResultCode      - kDalRcSuccess if all records are created
+     *                            - Errorcode of the first failed record
+     *                              otherwise
+     *
+     * Note:
+     * Information on usage of DalBindInfo
+     *  1. Same as CreateRecord for each DalBindInfo
+     *  2. All DalBindInfo instances must bind the same set of columns.
+     */
+    DalResultCode CreateRecords(
+                    const UpllCfgType cfg_type,
+                    const DalTableIndex table_index,
+                    const std::vector<const DalBindInfo *> &input_attr_infos,
+                    std::vector<DalResultCode> *results,
+                    const CfgModeType cfg_mode,
+                    const uint8_t* vtn_name) const;
+
+    /**
+     * UpdateRecords
+     *   Updates the records of table with the given input data for the
+     *   given cfg_type using arrays of parameters.
+     *   When an update of a chunk fails or matches no record in the array
+     *   execution, all the updates of the chunk are retried one by one
+     *   with UpdateRecords to get proper error codes.
+     *   Increments the write count for each successful update.
+     *
+     * @param[in] cfg_type        - Configuration Type for which the records
+     *                              have to be updated
+     * @param[in] table_index     - Valid Index of the table
+     * @param[in] input_and_matching_attr_infos
+     *                            - Bind Information for each update
+     * @param[out] results        - Result code of each update
+     * @param[in] cfg_mode        - Configuration mode
+     * @param[in] vtn_name        - VTN name of corresponding VTN config mode
+     *
+     * @return DalResultCode      - kDalRcSuccess if all updates succeed
+     *                            - Errorcode of the first failed update
+     *                              otherwise
+     *
+     * Note:
+     * Information on usage of DalBindInfo
+     *  1. Same as UpdateRecords for each DalBindInfo
+     *  2. All DalBindInfo instances must bind the same set of columns.
+     */
+    DalResultCode UpdateRecords(
+        const UpllCfgType cfg_type,
+        const DalTableIndex table_index,
+        const std::vector<const DalBindInfo *> &input_and_matching_attr_infos,
+        std::vector<DalResultCode> *results,
+        const CfgModeType cfg_mode,
+        const uint8_t* vtn_name) const;
+
     /**
      * ExecuteAppQuery
      *   Updates(create/update/delete) the records of table with the given
@@ -734,6 +826,55 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
                     const CfgModeType cfg_mode,
                     const uint8_t* vtn_name) const;
 
+    /**
+     * GetChangedRecords
+     *   Fetches the records deleted, created and updated in cfg_type_1 as
+     *   compared to cfg_type_2 with one query, in the order of deleted,
+     *   created and updated records, each by primary key. Each updated
+     *   record of cfg_type_1 is followed by the record of cfg_type_2.
+     *
+     * @param[in] cfg_type_1      - UPLL_DT_CANDIDATE
+     * @param[in] cfg_type_2      - UPLL_DT_RUNNING
+     * @param[in] table_index     - Valid Index of the table
+     * @param[in] max_record_count- Will be filled later. Under discussion
+     * @param[in] output_attr_info
+     *                            - Bind Information for output records
+     * @param[in] change          - Filled with the DalChangeType of the
+     *                              record by GetNextRecord
+     * @param[in/out] cursor      - reference to the unallocated DalCursor
+     *                              pointer
+     *                            - Output - cursor pointer with valid instance
+     *                              of DalCursor
+     * @param[in] cfg_mode        - Configuration mode other than
+     *                              TC_CONFIG_VTN
+     * @param[in] vtn_name        - Not used
+     *
+     * @return DalResultCode      - kDalRcSuccess in case of success
+     *                            - kDalRcRecordNotFound if the table is not
+     *                              dirty
+     *                            - Valid errorcode otherwise
+     *
+     * Note:
+     * Information on usage of DalBindInfo
+     *  1. Valid instance of DalBindInfo with same table_index used in this API
+     *  2. BindInput if used for any attributes, ignored.
+     *  3. BindMatch if used for any attributes, ignored.
+     *  4. BindOutput is mandatory for the primary key and the interested
+     *     attributes.
+     *
+     * Information on usage of cursor
+     *  Same as GetDeletedRecords
+     */
+    DalResultCode GetChangedRecords(const UpllCfgType cfg_type_1,
+                                    const UpllCfgType cfg_type_2,
+                                    const DalTableIndex table_index,
+                                    const size_t max_record_count,
+                                    const DalBindInfo *output_attr_info,
+                                    int16_t *change,
+                                    DalCursor **cursor,
+                                    const CfgModeType cfg_mode,
+                                    const uint8_t* vtn_name) const;
+
     /**
      * CopyEntireRecords
      *   Copies the entire records of table from source configuration to
@@ -1167,6 +1308,90 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
                                const DalBindInfo *bind_info = NULL,
                                const uint32_t max_count = 1) const;
 
+    /**
+     * ExecuteCachedQuery
+     *   Same as ExecuteQuery, but reuses a prepared statement handle from
+     *   the statement cache of this connection. The parameters of
+     *   bind_info are rebound to the handle before execution.
+     *   The handle must be given back with ReleaseCachedStmt and must not
+     *   be freed by the caller.
+     *
+     * @param[in] api_num         - Query template of query_stmt
+     * @param[in] cfg_type        - Configuration type of query_stmt
+     * @param[in] table_index     - Table index of query_stmt
+     * @param[out] dal_stmt_handle - Statement Handle
+     * @param[in] query_stmt      - Corresponding query statement to execute
+     * @param[in] bind_info       - Corresponding bind information of the API
+     * @param[in] max_count       - Corresponding max_count from the API input
+     *
+     * @return DalResultCode      - kDalRcSuccess in case of success
+     *                            - Valid errorcode otherwise
+     */
+    DalResultCode ExecuteCachedQuery(const DalApiNum api_num,
+                                     const UpllCfgType cfg_type,
+                                     const DalTableIndex table_index,
+                                     SQLHANDLE *dal_stmt_handle,
+                                     const std::string *query_stmt,
+                                     const DalBindInfo *bind_info = NULL,
+                                     const uint32_t max_count = 1) const;
+
+    /**
+     * ReleaseCachedStmt
+     *   Gives back a statement handle returned by ExecuteCachedQuery.
+     *   Cached handles are closed and kept prepared for reuse; other
+     *   handles are freed.
+     *
+     * @param[in] stmt_handle     - Statement handle
+     * @param[in] reuse           - false, if the handle is in an unknown
+     *                              state after an error and must be freed
+     */
+    void ReleaseCachedStmt(SQLHANDLE stmt_handle, const bool reuse) const;
+
+    /**
+     * ClearStmtCache
+     *   Frees all the prepared statement handles of this connection
+     */
+    void ClearStmtCache() const;
+
+    // Acquires the running exclusive lock if query_stmt updates running
+    void CheckAndAcquireRunnExclusiveLock(const std::string *query_stmt) const;
+
+    // Moves to the next write generation if query_stmt is not a SELECT
+    void CountWriteGeneration(const std::string *query_stmt) const;
+
+    /**
+     * ExecuteBulkQuery
+     *   Executes the query statement once for each of the given rows using
+     *   column-wise arrays of parameters (SQL_ATTR_PARAMSET_SIZE).
+     *   All bind_infos must have the same bind shape; input and match
+     *   columns are bound in the same order as BindToQuery.
+     *
+     * @param[in] query_stmt      - Query statement built from any of the rows
+     * @param[in] bind_infos      - Bind information of all the rows
+     * @param[in] rows            - Indices in bind_infos to execute
+     * @param[out] row_status     - SQL_PARAM_* status of each row in rows
+     * @param[out] affected_rows  - Total number of rows affected
+     *
+     * @return DalResultCode      - kDalRcSuccess if all rows are executed
+     *                            - Valid errorcode otherwise, row_status has
+     *                              the status of the individual rows
+     */
+    DalResultCode ExecuteBulkQuery(
+        const std::string *query_stmt,
+        const std::vector<const DalBindInfo *> &bind_infos,
+        const std::vector<size_t> &rows,
+        std::vector<SQLUSMALLINT> *row_status,
+        SQLLEN *affected_rows) const;
+
+    // Validates the inputs of CreateRecords and UpdateRecords
+    DalResultCode ValidateBulkInput(
+        const UpllCfgType cfg_type,
+        const DalTableIndex table_index,
+        const std::vector<const DalBindInfo *> &bind_infos,
+        std::vector<DalResultCode> *results,
+        const CfgModeType cfg_mode,
+        const uint8_t* vtn_name) const;
+
     /**
      * CheckParentInstance
      *   Checks the parent of the given instance with parent key values from
@@ -1325,6 +1550,13 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
                               const uint8_t* vtn_name) const;
     // Get maximum configuration session possible from dal.conf
     uint32_t GetMaxcfgSession() const;
+    // Get size of the prepared statement cache from dal.conf
+    uint32_t GetStmtCacheSize() const;
+    // Get number of rows fetched at once by cursors from dal.conf
+    uint32_t GetCursorRowArraySize() const;
+    // Rows fetched at once for a cursor returning at most max_count records
+    // (0 for all records)
+    uint32_t CursorRowArraySize(const size_t max_count) const;
 
     mutable std::set<uint32_t> create_dirty;
        // List of tables modified by candidate create operation
@@ -1337,6 +1569,7 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
     mutable DalConnType conn_type_;  // Connection Type
     mutable DalConnState conn_state_;  // Connection State
     mutable uint32_t write_count_;
+    mutable uint64_t write_generation_;
     typedef std::pair<DalTableIndex, std::string> TblVtnNamePair;
     mutable std::set<TblVtnNamePair> create_vtn_dirty;
     mutable std::set<TblVtnNamePair> delete_vtn_dirty;
@@ -1364,6 +1597,18 @@ class DalOdbcMgr:public DalConnIntf, public DalDmlIntf {
     static bool max_cache_reached_cr_;
     static bool max_cache_reached_up_;
     static bool max_cache_reached_dl_;
+    // Prepared statement cache size per connection, 0 disables the cache
+    static uint32_t stmt_cache_size_;
+    // Default prepared statement cache size(64)
+    static const uint32_t default_stmt_cache_size_ = 64;
+    // Prepared statement handles of this connection
+    mutable DalStmtCache stmt_cache_;
+    // Number of rows fetched at once by cursors, 1 disables block cursor
+    static uint32_t cursor_row_array_size_;
+    // Default block cursor row array size(64)
+    static const uint32_t default_cursor_row_array_size_ = 64;
+    // Maximum number of rows sent in one bulk execution
+    static const size_t kDalMaxBulkRows = 1000;
 
     DalResultCode print_vtn_cache(const unc_keytype_operation_t op) const;
 };  // class DalOdbcMgr
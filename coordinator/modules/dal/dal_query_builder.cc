@@ -317,6 +317,32 @@ const char * DalQueryBuilder::DalCopyModRecUpdateAbortVtnQT =
       " ) AS temp WHERE {match_dst_primary_key_columns_eq_with_temp} AND"
         " ({dst_table_name}.c_flag = 1 OR {dst_table_name}.u_flag = 1) AND"
           " {dst_table_name}.vtn_name = ?";
+
+// Parts of GetChangedRecords, joined by UNION ALL. dal_change is the
+// DalChangeType of the row, dal_change_grp keeps the updated rows of
+// CAND and RUNN together when ordered.
+const char * DalQueryBuilder::DalGetChangedDelRecQT =
+  "SELECT {mand_out_columns}, 1 AS dal_change_grp, 1 AS dal_change"
+    " FROM {ca_del_table_name}";
+
+const char * DalQueryBuilder::DalGetChangedCreatedRecQT =
+  "SELECT {mand_out_columns}, 2 AS dal_change_grp, 2 AS dal_change"
+    " FROM {config1_table_name} WHERE c_flag = 1";
+
+const char * DalQueryBuilder::DalGetChangedUpdatedRecQT =
+  "SELECT {mand_out_columns}, 3 AS dal_change_grp, 3 AS dal_change"
+    " FROM {config1_table_name} WHERE u_flag = 1";
+
+const char * DalQueryBuilder::DalGetChangedUpdatedOldRecQT =
+  "SELECT {mand_out_columns}, 3 AS dal_change_grp, 4 AS dal_change"
+    " FROM {config2_table_name} as temp WHERE EXISTS"
+      " ( SELECT {primary_key_columns} FROM {config1_table_name}"
+        " WHERE u_flag = 1 AND {match_dst_primary_key_columns_eq_with_temp}"
+      " )";
+
+const char * DalQueryBuilder::DalGetChangedRecOrderQT =
+  " ORDER BY dal_change_grp, {primary_key_columns}, dal_change";
+
 /* sql templates mapping with enum constants */
 static const struct SqlTemplates {
   const DalApiNum api_num;
@@ -390,6 +416,13 @@ static const struct SqlTemplates {
   // In vtn mode, copy updated records during abort
   { kDalCopyModRecUpdateAbortVtnModeQT,
     DalQueryBuilder::DalCopyModRecUpdateAbortVtnQT},
+  // Parts of the records changed in CAND, read at once during commit
+  { kDalGetChangedDelRecQT, DalQueryBuilder::DalGetChangedDelRecQT},
+  { kDalGetChangedCreatedRecQT, DalQueryBuilder::DalGetChangedCreatedRecQT},
+  { kDalGetChangedUpdatedRecQT, DalQueryBuilder::DalGetChangedUpdatedRecQT},
+  { kDalGetChangedUpdatedOldRecQT,
+    DalQueryBuilder::DalGetChangedUpdatedOldRecQT},
+  { kDalGetChangedRecOrderQT, DalQueryBuilder::DalGetChangedRecOrderQT},
 };
 
 /* replacement token definitions*/
@@ -74,7 +74,12 @@ enum DalApiNum {
   kDalGetUpdatedRecInVtnMode2QT,  // Get updated records from RUNN in vtn mode
   kDalCopyModRecDelVtnModeQT,    // Copy mod records for delete op in vtn mode
   kDalCopyModRecCreateVtnModeQT,  // Copy mod records for create op in vtn mode
-  kDalCopyModRecUpdateAbortVtnModeQT  // Copymodrec abort(update) in vtn mode
+  kDalCopyModRecUpdateAbortVtnModeQT,  // Copymodrec abort(update) in vtn mode
+  kDalGetChangedDelRecQT,         // Deleted part of GetChangedRecords
+  kDalGetChangedCreatedRecQT,     // Created part of GetChangedRecords
+  kDalGetChangedUpdatedRecQT,     // CAND updated part of GetChangedRecords
+  kDalGetChangedUpdatedOldRecQT,  // RUNN updated part of GetChangedRecords
+  kDalGetChangedRecOrderQT        // Order of the GetChangedRecords parts
 };
 
 /* sql template tokens */
@@ -194,6 +199,11 @@ class DalQueryBuilder {
     static const char * DalCopyModRecDelVtnQT;
     static const char * DalCopyModRecCreateVtnQT;
     static const char * DalCopyModRecUpdateAbortVtnQT;
+    static const char * DalGetChangedDelRecQT;
+    static const char * DalGetChangedCreatedRecQT;
+    static const char * DalGetChangedUpdatedRecQT;
+    static const char * DalGetChangedUpdatedOldRecQT;
+    static const char * DalGetChangedRecOrderQT;
 
     /* replacement tokens */
     // Input Related Tokens
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * dal_stmt_cache.cc
+ *   Implementation of methods in DalStmtCache
+ */
+
+#include "uncxx/upll_log.hh"
+#include "dal_stmt_cache.hh"
+
+namespace unc {
+namespace upll {
+namespace dal {
+
+// Builds the cache key from the bound column shape of the DAL call
+void
+DalStmtCache::MakeKey(const DalApiNum api_num,
+                      const DalTableIndex table_index,
+                      const UpllCfgType cfg_type,
+                      const DalBindInfo *bind_info,
+                      DalStmtCacheKey *key) {
+  key->api_num = api_num;
+  key->table_index = table_index;
+  key->cfg_type = cfg_type;
+  key->bind_shape.clear();
+
+  if (bind_info == NULL)
+    return;
+
+  DalBindList bind_list = bind_info->get_bind_list();
+  for (DalBindList::iterator iter = bind_list.begin();
+       iter != bind_list.end(); ++iter) {
+    DalBindColumnInfo *col_info = *iter;
+    if (col_info == NULL || col_info->get_io_type() == kDalIoNone)
+      continue;
+    key->bind_shape.push_back(static_cast<uint16_t>(
+        (col_info->get_column_index() << 3) | col_info->get_io_type()));
+  }
+}
+
+// Looks up a prepared handle and marks it in use
+SQLHANDLE
+DalStmtCache::Acquire(const DalStmtCacheKey &key,
+                      const std::string &query_stmt) {
+  KeyMap::iterator it = key_map_.find(key);
+  if (it == key_map_.end()) {
+    misses_++;
+    return SQL_NULL_HANDLE;
+  }
+
+  DalStmtCacheList::iterator entry = it->second;
+  // Handle is busy with an outer DAL call, or the key is ambiguous
+  if (entry->in_use || entry->query_stmt != query_stmt) {
+    misses_++;
+    return SQL_NULL_HANDLE;
+  }
+
+  entry->in_use = true;
+  lru_list_.splice(lru_list_.begin(), lru_list_, entry);
+  hits_++;
+  return entry->stmt_handle;
+}
+
+// Adds a freshly prepared handle in the in-use state
+bool
+DalStmtCache::Insert(const DalStmtCacheKey &key,
+                     const std::string &query_stmt,
+                     const SQLHANDLE stmt_handle,
+                     SQLHANDLE *evicted) {
+  *evicted = SQL_NULL_HANDLE;
+
+  if (capacity_ == 0 || stmt_handle == SQL_NULL_HANDLE)
+    return false;
+
+  KeyMap::iterator it = key_map_.find(key);
+  if (it != key_map_.end()) {
+    // Keep the handle which is being used by the outer DAL call
+    if (it->second->in_use)
+      return false;
+    *evicted = it->second->stmt_handle;
+    EraseEntry(it->second);
+  } else if (lru_list_.size() >= capacity_) {
+    // Evict the least recently used handle which is not in use
+    DalStmtCacheList::iterator victim = lru_list_.end();
+    while (victim != lru_list_.begin()) {
+      --victim;
+      if (!victim->in_use)
+        break;
+    }
+    if (victim == lru_list_.end() || victim->in_use) {
+      UPLL_LOG_TRACE("All %u cached statements are in use", capacity_);
+      return false;
+    }
+    *evicted = victim->stmt_handle;
+    EraseEntry(victim);
+    evictions_++;
+  }
+
+  DalStmtCacheEntry entry;
+  entry.key = key;
+  entry.query_stmt = query_stmt;
+  entry.stmt_handle = stmt_handle;
+  entry.in_use = true;
+  lru_list_.push_front(entry);
+  key_map_[key] = lru_list_.begin();
+  handle_map_[stmt_handle] = lru_list_.begin();
+  return true;
+}
+
+// Marks a cached handle as no longer in use
+bool
+DalStmtCache::Release(const SQLHANDLE stmt_handle) {
+  HandleMap::iterator it = handle_map_.find(stmt_handle);
+  if (it == handle_map_.end())
+    return false;
+  it->second->in_use = false;
+  return true;
+}
+
+// Removes a handle from the cache without freeing it
+bool
+DalStmtCache::Erase(const SQLHANDLE stmt_handle) {
+  HandleMap::iterator it = handle_map_.find(stmt_handle);
+  if (it == handle_map_.end())
+    return false;
+  EraseEntry(it->second);
+  return true;
+}
+
+// Removes all handles from the cache
+void
+DalStmtCache::Clear(std::vector<SQLHANDLE> *handles) {
+  for (DalStmtCacheList::iterator it = lru_list_.begin();
+       it != lru_list_.end(); ++it) {
+    handles->push_back(it->stmt_handle);
+  }
+  lru_list_.clear();
+  key_map_.clear();
+  handle_map_.clear();
+}
+
+void
+DalStmtCache::EraseEntry(DalStmtCacheList::iterator entry) {
+  key_map_.erase(entry->key);
+  handle_map_.erase(entry->stmt_handle);
+  lru_list_.erase(entry);
+}
+
+}  // namespace dal
+}  // namespace upll
+}  // namespace unc
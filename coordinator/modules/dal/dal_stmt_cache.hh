@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * dal_stmt_cache.hh
+ *   Contains definitions of DalStmtCache
+ */
+
+#ifndef __DAL_STMT_CACHE_HH__
+#define __DAL_STMT_CACHE_HH__
+
+#include <stdint.h>
+#include <sql.h>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "dal_defines.hh"
+#include "dal_bind_info.hh"
+#include "dal_query_builder.hh"
+
+namespace unc {
+namespace upll {
+namespace dal {
+
+/**
+ * DalStmtCacheKey
+ *   Identifies a prepared statement. Two DAL calls with the same query
+ *   template, table, config type and bound column shape produce the same
+ *   query text and can share a prepared statement handle.
+ */
+struct DalStmtCacheKey {
+  DalApiNum api_num;
+  DalTableIndex table_index;
+  UpllCfgType cfg_type;
+  // (column_index << 3 | io_type) of every column bound by the DAL user
+  std::vector<uint16_t> bind_shape;
+
+  bool operator<(const DalStmtCacheKey &rhs) const {
+    if (api_num != rhs.api_num)
+      return (api_num < rhs.api_num);
+    if (table_index != rhs.table_index)
+      return (table_index < rhs.table_index);
+    if (cfg_type != rhs.cfg_type)
+      return (cfg_type < rhs.cfg_type);
+    return (bind_shape < rhs.bind_shape);
+  }
+};
+
+/**
+ * DalStmtCache
+ *   LRU cache of prepared statement handles for a single DB connection.
+ *   The cache only keeps track of the handles; allocating, preparing and
+ *   freeing them with ODBC is left to DalOdbcMgr.
+ */
+class DalStmtCache {
+  public:
+    /**
+     * DalStmtCache - Constructor
+     *
+     * @param[in] capacity      - Maximum number of cached handles.
+     *                            0 disables the cache.
+     */
+    explicit DalStmtCache(const uint32_t capacity = 0)
+        : capacity_(capacity), hits_(0), misses_(0), evictions_(0) {}
+
+    /**
+     * MakeKey
+     *   Builds the cache key of a DAL call from its bind information
+     *
+     * @param[in] api_num       - Query template of the DAL call
+     * @param[in] table_index   - Valid table index
+     * @param[in] cfg_type      - Configuration type of the DAL call
+     * @param[in] bind_info     - Bind information of the DAL call (or NULL)
+     * @param[out] key          - Filled cache key
+     */
+    static void MakeKey(const DalApiNum api_num,
+                        const DalTableIndex table_index,
+                        const UpllCfgType cfg_type,
+                        const DalBindInfo *bind_info,
+                        DalStmtCacheKey *key);
+
+    /**
+     * Acquire
+     *   Looks up a prepared handle for the key and marks it in use
+     *
+     * @param[in] key           - Cache key of the DAL call
+     * @param[in] query_stmt    - Query text of the DAL call; must match the
+     *                            text the cached handle was prepared with
+     * @return SQLHANDLE        - Cached handle on hit
+     *                            SQL_NULL_HANDLE on miss
+     */
+    SQLHANDLE Acquire(const DalStmtCacheKey &key,
+                      const std::string &query_stmt);
+
+    /**
+     * Insert
+     *   Adds a freshly prepared handle to the cache in the in-use state
+     *
+     * @param[in] key           - Cache key of the DAL call
+     * @param[in] query_stmt    - Query text the handle was prepared with
+     * @param[in] stmt_handle   - Prepared statement handle
+     * @param[out] evicted      - Least recently used handle removed to make
+     *                            room, SQL_NULL_HANDLE if none. The caller
+     *                            must free it.
+     * @return bool             - true, if the handle is now owned by cache
+     *                            false, if not cached (caller owns it)
+     */
+    bool Insert(const DalStmtCacheKey &key,
+                const std::string &query_stmt,
+                const SQLHANDLE stmt_handle,
+                SQLHANDLE *evicted);
+
+    /**
+     * Release
+     *   Marks a cached handle as no longer in use
+     *
+     * @param[in] stmt_handle   - Statement handle
+     * @return bool             - true, if the handle is owned by the cache
+     *                            false, otherwise (caller must free it)
+     */
+    bool Release(const SQLHANDLE stmt_handle);
+
+    /**
+     * Erase
+     *   Removes a handle from the cache without freeing it
+     *
+     * @param[in] stmt_handle   - Statement handle
+     * @return bool             - true, if the handle was cached
+     */
+    bool Erase(const SQLHANDLE stmt_handle);
+
+    /**
+     * Clear
+     *   Removes all handles from the cache
+     *
+     * @param[out] handles      - Removed handles. The caller must free them.
+     */
+    void Clear(std::vector<SQLHANDLE> *handles);
+
+    inline bool is_enabled() const { return (capacity_ > 0); }
+    inline void set_capacity(const uint32_t capacity) { capacity_ = capacity; }
+    inline uint32_t get_capacity() const { return capacity_; }
+    inline uint32_t get_size() const {
+      return static_cast<uint32_t>(lru_list_.size());
+    }
+    inline uint64_t get_hits() const { return hits_; }
+    inline uint64_t get_misses() const { return misses_; }
+    inline uint64_t get_evictions() const { return evictions_; }
+
+  private:
+    struct DalStmtCacheEntry {
+      DalStmtCacheKey key;
+      std::string query_stmt;
+      SQLHANDLE stmt_handle;
+      bool in_use;
+    };
+    // Most recently used entry is at the front
+    typedef std::list<DalStmtCacheEntry> DalStmtCacheList;
+    typedef std::map<DalStmtCacheKey, DalStmtCacheList::iterator> KeyMap;
+    typedef std::map<SQLHANDLE, DalStmtCacheList::iterator> HandleMap;
+
+    void EraseEntry(DalStmtCacheList::iterator entry);
+
+    DalStmtCacheList lru_list_;
+    KeyMap key_map_;
+    HandleMap handle_map_;
+    uint32_t capacity_;
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t evictions_;
+};  // class DalStmtCache
+
+}  // namespace dal
+}  // namespace upll
+}  // namespace unc
+#endif  // __DAL_STMT_CACHE_HH__
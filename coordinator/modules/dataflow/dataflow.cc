@@ -17,6 +17,8 @@
 #include <arpa/inet.h>
 #include <sstream>
 #include <bitset>
+#include <algorithm>
+#include <iterator>
 #include "unc/keytype.h"
 #include "ipc_util.hh"
 
@@ -962,291 +964,11 @@ int DataflowCmn::sessOutDataflow(ServerSession& sess, int& putresp_pos) {
  **/
 bool DataflowCmn::check_match_condition(map<UncDataflowFlowMatchType,
                                  void *> prev_output_matches) {
-  bool ret_value = true;
-  map<UncDataflowFlowMatchType, void *>::iterator iter_out_match =
-        prev_output_matches.begin();
   pfc_log_debug("Size of prev_output_matches:%" PFC_PFMT_SIZE_T,
                prev_output_matches.size());
   pfc_log_debug("Size of curr matches:%" PFC_PFMT_SIZE_T, df_segment->matches.size());
-  while (iter_out_match != prev_output_matches.end()) {
-    switch (iter_out_match->first) {
-      case UNC_MATCH_IN_PORT:
-        break;
-      case UNC_MATCH_DL_SRC:
-        break;
-      case UNC_MATCH_DL_DST:
-      {
-        pfc_log_debug("check match for mac src/dst %d", iter_out_match->first);
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_dl_addr_t *curr =
-              reinterpret_cast<val_df_flow_match_dl_addr_t *>(iter_mch->second);
-          val_df_flow_match_dl_addr_t *prev = reinterpret_cast<val_df_flow_match_dl_addr_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          if (curr->v_mask == UNC_MATCH_MASK_VALID) {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 9.RANGE - RANGE
-              if (!DataflowUtil::checkMacAddress(curr->dl_addr, curr->dl_addr_mask, prev->dl_addr, prev->dl_addr_mask)) {
-                pfc_log_debug("check match failed for mac addr range1 range2");
-                ret_value &= false;
-              }
-            } else {
-              // 3.STRICT - RANGE
-              if (!DataflowUtil::checkMacAddress(curr->dl_addr, curr->dl_addr_mask, prev->dl_addr)) {
-                pfc_log_debug("check match failed for mac addr strict1 range2");
-                ret_value &= false;
-              }
-            }
-          } else {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 7.RANGE - STRICT
-              if (!DataflowUtil::checkMacAddress(prev->dl_addr, prev->dl_addr_mask, curr->dl_addr)) {
-                pfc_log_debug("check match failed for mac addr range1 strict2");
-                ret_value &= false;
-              }
-            } else {
-              // 1.STRICT - STRICT
-              if (memcmp(curr->dl_addr, prev->dl_addr, sizeof(prev->dl_addr)) != 0) {
-                pfc_log_debug("check match failed for mac addr strict1 strict2");
-                ret_value &= false;
-              }
-            }
-          }
-        } // else {
-          // 2.STRICT - ANY //8.RANGE - ANY // This is OK. Do nothing.
-        // }
-        break;
-      }
-      case UNC_MATCH_DL_TYPE:
-      {
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_dl_type_t *curr =
-              reinterpret_cast<val_df_flow_match_dl_type_t *>(iter_mch->second);
-          val_df_flow_match_dl_type_t *prev = reinterpret_cast<val_df_flow_match_dl_type_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          // 1.STRICT - STRICT
-          if (curr->dl_type != prev->dl_type) {
-            pfc_log_info("check match failed for dl_type");
-            ret_value &= false;
-          }
-        }
-        break;
-      }
-      case UNC_MATCH_VLAN_ID:
-        break;
-      case UNC_MATCH_VLAN_PCP:
-      {
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_vlan_pcp_t *curr =
-              reinterpret_cast<val_df_flow_match_vlan_pcp_t *>(iter_mch->second);
-          val_df_flow_match_vlan_pcp_t *prev = reinterpret_cast<val_df_flow_match_vlan_pcp_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          // 1.STRICT - STRICT
-          if (curr->vlan_pcp != prev->vlan_pcp) {
-            pfc_log_info("check match failed for vlan pcp");
-            ret_value &= false;
-          }
-        }
-        break;
-      }
-      case UNC_MATCH_IP_TOS:
-      {
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_ip_tos_t *curr =
-              reinterpret_cast<val_df_flow_match_ip_tos_t *>(iter_mch->second);
-          val_df_flow_match_ip_tos_t *prev = reinterpret_cast<val_df_flow_match_ip_tos_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          // 1.STRICT - STRICT
-          if (curr->ip_tos != prev->ip_tos) {
-            pfc_log_info("check match failed for ip tos");
-            ret_value &= false;
-          }
-        }
-        break;
-      }
-      case UNC_MATCH_IP_PROTO:
-      {
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_ip_proto_t *curr =
-              reinterpret_cast<val_df_flow_match_ip_proto_t *>(iter_mch->second);
-          val_df_flow_match_ip_proto_t *prev = reinterpret_cast<val_df_flow_match_ip_proto_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          // 1.STRICT - STRICT
-          if (curr->ip_proto != prev->ip_proto) {
-            pfc_log_info("check match failed for ip_proto");
-            ret_value &= false;
-          }
-        }
-        break;
-      }
-      case UNC_MATCH_IPV4_SRC:
-      case UNC_MATCH_IPV4_DST:
-      {
-        pfc_log_debug("check match for ipv4 src/dst %d", iter_out_match->first);
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_ipv4_addr_t *curr =
-              reinterpret_cast<val_df_flow_match_ipv4_addr_t *>(iter_mch->second);
-          val_df_flow_match_ipv4_addr_t *prev = reinterpret_cast<val_df_flow_match_ipv4_addr_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          if (curr->v_mask == UNC_MATCH_MASK_VALID) {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 9.RANGE - RANGE
-              if (!DataflowUtil::checkIPv4Address(curr->ipv4_addr, curr->ipv4_addr_mask, prev->ipv4_addr, prev->ipv4_addr_mask)) {
-                pfc_log_debug("check match failed for ipv4 addr range1 range2");
-                ret_value &= false;
-              }
-            } else {
-              // 3.STRICT - RANGE
-              if (!DataflowUtil::checkIPv4Address(curr->ipv4_addr, curr->ipv4_addr_mask, prev->ipv4_addr)) {
-                pfc_log_debug("check match failed for ipv4 addr strict1 range2");
-                ret_value &= false;
-              }
-            }
-          } else {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 7.RANGE - STRICT
-              if (!DataflowUtil::checkIPv4Address(prev->ipv4_addr, prev->ipv4_addr_mask, curr->ipv4_addr)) {
-                pfc_log_debug("check match failed for ipv4 addr range1 strict2");
-                ret_value &= false;
-              }
-            } else {
-              // 1.STRICT - STRICT
-              if (curr->ipv4_addr.s_addr != prev->ipv4_addr.s_addr) {
-                pfc_log_debug("check match failed for ipv4 addr strict1 strict2");
-                ret_value &= false;
-              }
-            }
-          }
-        } // else {
-          // 2.STRICT - ANY  //8.RANGE - ANY  // This is OK. Do nothing.
-        // }
-        break;
-      }
-      case UNC_MATCH_IPV6_SRC:
-      case UNC_MATCH_IPV6_DST:
-      {
-        pfc_log_debug("check match for ipv6 src/dst %d", iter_out_match->first);
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_ipv6_addr_t *curr =
-              reinterpret_cast<val_df_flow_match_ipv6_addr_t *>(iter_mch->second);
-          val_df_flow_match_ipv6_addr_t *prev = reinterpret_cast<val_df_flow_match_ipv6_addr_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          if (curr->v_mask == UNC_MATCH_MASK_VALID) {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 9.RANGE - RANGE
-              if (!DataflowUtil::checkIPv6Address(curr->ipv6_addr, curr->ipv6_addr_mask, prev->ipv6_addr, prev->ipv6_addr_mask)) {
-                pfc_log_debug("check match failed for ipv6 addr range1 range2");
-                ret_value &= false;
-              }
-            } else {
-              // 3.STRICT - RANGE
-              if (!DataflowUtil::checkIPv6Address(curr->ipv6_addr, curr->ipv6_addr_mask, prev->ipv6_addr)) {
-                pfc_log_debug("check match failed for ipv6 addr strict1 range2");
-                ret_value &= false;
-              }
-            }
-          } else {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 7.RANGE - STRICT
-              if (!DataflowUtil::checkIPv6Address(prev->ipv6_addr, prev->ipv6_addr_mask, curr->ipv6_addr)) {
-                pfc_log_debug("check match failed for ipv6 addr range1 strict2");
-                ret_value &= false;
-              }
-            } else {
-              // 1.STRICT - STRICT
-              if (memcmp(curr->ipv6_addr.s6_addr, prev->ipv6_addr.s6_addr, sizeof(prev->ipv6_addr.s6_addr)) != 0) {
-                pfc_log_debug("check match failed for ipv6 addr strict1 strict2");
-                ret_value &= false;
-              }
-            }
-          }
-        } // else {
-          // 2.STRICT - ANY  //8.RANGE - ANY  // This is OK. Do nothing.
-        // }
-        break;
-      }
-      case UNC_MATCH_TP_SRC:
-      case UNC_MATCH_TP_DST:
-      {
-        pfc_log_debug("check match for tp port src/dst %d", iter_out_match->first);
-        map<UncDataflowFlowMatchType, void *>::iterator iter_mch = df_segment->matches.find(iter_out_match->first);
-        if (iter_mch !=  df_segment->matches.end()) {
-          val_df_flow_match_tp_port_t *curr =
-              reinterpret_cast<val_df_flow_match_tp_port_t *>(iter_mch->second);
-          val_df_flow_match_tp_port_t *prev = reinterpret_cast<val_df_flow_match_tp_port_t *>((*iter_out_match).second);
-          if (prev == NULL) {
-            //(strict or masked) and ANY
-            break;
-          }
-          if (curr->v_mask == UNC_MATCH_MASK_VALID) {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 9.RANGE - RANGE
-              if (!DataflowUtil::checkIPv4Address(curr->tp_port, curr->tp_port_mask, prev->tp_port, prev->tp_port_mask)) {
-                pfc_log_debug("check match failed for tp port range1 range2");
-                ret_value &= false;
-              }
-            } else {
-              // 3.STRICT - RANGE
-              if (!DataflowUtil::checkIPv4Address(curr->tp_port, curr->tp_port_mask, prev->tp_port)) {
-                pfc_log_debug("check match failed for tp port strict1 range2");
-                ret_value &= false;
-              }
-            }
-          } else {
-            if (prev->v_mask == UNC_MATCH_MASK_VALID) {
-              // 7.RANGE - STRICT
-              if (!DataflowUtil::checkIPv4Address(prev->tp_port, prev->tp_port_mask, curr->tp_port)) {
-                pfc_log_debug("check match failed for tp port range1 strict2");
-                ret_value &= false;
-              }
-            } else {
-              // 1.STRICT - STRICT
-              if (curr->tp_port != prev->tp_port) {
-                pfc_log_debug("check match failed for tp port strict1 strict2");
-                ret_value &= false;
-              }
-            }
-          }
-        } // else {
-          // 2.STRICT - ANY  //8.RANGE - ANY  // This is OK. Do nothing.
-        // }
-        break;
-      }
-      default:
-        pfc_log_warn("check_match_condition Ignoring %d ", iter_out_match->first);
-	break;
-    }
-    if (ret_value == false)
-      break;
-    iter_out_match++;
-  }
+  DataflowMatch curr(df_segment->matches);
+  bool ret_value = curr.Matches(DataflowMatch(prev_output_matches));
   pfc_log_debug("check_match_condition returns %d", ret_value);
   return ret_value;
 }
@@ -1624,6 +1346,14 @@ DataflowUtil::~DataflowUtil() {
     }
     vext_info_map.clear();
   }
+  if (flow_indexes_.size() > 0) {
+    std::map<const vector<DataflowDetail *> *, DataflowFlowIndex *>::iterator
+        it = flow_indexes_.begin();
+    for (; it != flow_indexes_.end(); ++it) {
+      delete it->second;
+    }
+    flow_indexes_.clear();
+  }
   if (vnode_rename_map.size() > 0)
     vnode_rename_map.clear();
   if (bypass_dom_set.size() > 0)
@@ -1677,6 +1407,21 @@ uint32_t DataflowUtil::appendFlow(DataflowCmn* firstCtrlrFlow) {
   return 0;
 }
 
+/** get_flow_index
+ * * @Description : This function gets the index of the flows, and builds
+ * *               it at the first call for the flows
+ * * @param[in]   : flows - flows stored in pfc_flows or upll_pfc_flows
+ * * @return      : DataflowFlowIndex*
+ **/
+DataflowFlowIndex* DataflowUtil::get_flow_index(
+    const vector<DataflowDetail *> &flows) {
+  DataflowFlowIndex *&index = flow_indexes_[&flows];
+  if (index == NULL) {
+    index = new DataflowFlowIndex(flows);
+  }
+  return index;
+}
+
 int DataflowUtil::sessOutDataflowsFromDriver(ServerSession& sess) {
   int err = 0;
   int putresp_pos = 12;
@@ -1831,130 +1576,6 @@ int DataflowUtil::sessOutDataflows(ServerSession& sess) {
   return err;
 }
 
-bool DataflowUtil::checkMacAddress(uint8_t macaddr[6], uint8_t macaddr_mask[6],
-                       uint8_t checkmacaddr[6]) {
-  bool retval = false;
-  for (int i = 0; i < 6; i++) {
-    retval = checkByte(macaddr[i], macaddr_mask[i], checkmacaddr[i]);
-    if (retval == false)
-      break;
-  }
-  return retval;
-}
-
-bool DataflowUtil::checkMacAddress(uint8_t macaddr[6], uint8_t macaddr_mask[6],
-                       uint8_t checkmacaddr[6], uint8_t checkmacaddr_mask[6]) {
-  bool retval = false;
-  for (int i = 0; i < 6; i++) {
-    retval = checkByte(macaddr[i], macaddr_mask[i], checkmacaddr[i],
-                       checkmacaddr_mask[i]);
-    if (retval == false)
-      break;
-  }
-  return retval;
-}
-
-bool DataflowUtil::checkIPv4Address(in_addr ipaddr, in_addr ip_mask,
-                        in_addr checkipaddr) {
-  return checkIPv4Address(ipaddr.s_addr, ip_mask.s_addr, checkipaddr.s_addr);
-}
-
-bool DataflowUtil::checkByte(uint8_t ipaddr, uint8_t ip_mask,
-                         uint8_t checkipaddr) {
-  // stringstream ss;
-  // ss << "1FRIP-" << getipstring(ipaddr, 2) << " " << getipstring(ipaddr, 16) <<endl;
-  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16) <<endl;
-  // ss << "1TOIP:" << getipstring(checkipaddr, 2) << " " << getipstring(checkipaddr, 16) <<endl;
-  uint8_t anded1 = ipaddr & ip_mask;
-  // ss << "1AND :" << getipstring(anded1, 2) << " " << getipstring(anded1, 16) <<endl;
-  uint8_t anded2 = checkipaddr & ip_mask;
-  // ss << "2AND :" << getipstring(anded2, 2) << " " << getipstring(anded2, 16) <<endl;
-  // pfc_log_debug("\n%s", ss.str().c_str());
-  if (anded1 == anded2) return true;
-  return false;
-}
-bool DataflowUtil::checkByte(uint8_t ipaddr, uint8_t ip_mask,
-                           uint8_t checkipaddr, uint8_t chk_ip_mask) {
-  // stringstream ss;
-  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16) <<endl;
-  // ss << "2MASK:" << getipstring(chk_ip_mask, 2) << " " << getipstring(chk_ip_mask, 16) <<endl;
-  uint8_t and_mask = ip_mask & chk_ip_mask;
-  // ss << "&MASK:" << getipstring(and_mask, 2) << " " << getipstring(and_mask, 16) <<endl;
-  // pfc_log_debug("\n%s", ss.str().c_str());
-  return checkByte(ipaddr, and_mask, checkipaddr);
-}
-
-bool DataflowUtil::checkIPv4Address(uint32_t ipaddr, uint32_t ip_mask,
-                            uint32_t checkipaddr) {
-  // stringstream ss;
-  // ss << "1FRIP-" << getipstring(ipaddr, 2) << " " << getipstring(ipaddr, 16) <<endl;
-  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16) <<endl;
-  // ss << "2TOIP:" << getipstring(checkipaddr, 2) << " " << getipstring(checkipaddr, 16) <<endl;
-  uint32_t anded1 = ipaddr & ip_mask;
-  // ss << "1AND :" << getipstring(anded1, 2) << " " << getipstring(anded1, 16) <<endl;
-  uint32_t anded2 = checkipaddr & ip_mask;
-  // ss << "2AND :" << getipstring(anded2, 2) << " " << getipstring(anded2, 16) <<endl;
-  // pfc_log_debug("\n%s", ss.str().c_str());
-  if (anded1 == anded2) return true;
-  return false;
-}
-
-
-
-bool DataflowUtil::checkIPv6Address(in6_addr ipv6addr, in6_addr ipv6_mask,
-                             in6_addr checkipv6addr) {
-  bool ret = false;
-  for (int index = 0; index < 4; index ++) {
-    uint32_t ipv4_addr = ipv6addr.s6_addr32[index];
-    uint32_t ipv4_mask = ipv6_mask.s6_addr32[index];
-    uint32_t checkipv4_addr = checkipv6addr.s6_addr32[index];
-    ret = checkIPv4Address(ipv4_addr, ipv4_mask, checkipv4_addr);
-    if (ret == false)
-      break;
-  }
-  return ret;
-}
-
-
-bool DataflowUtil::checkIPv6Address(in6_addr ipv6addr, in6_addr ipv6_mask,
-                            in6_addr checkipv6addr, in6_addr chk_ipv6_mask) {
-  bool ret = false;
-  for (int index = 0; index < 4; index ++) {
-    in_addr ipv4_addr, ipv4_mask, checkipv4_addr, checkipv4_mask;
-    ipv4_addr.s_addr =  ipv6addr.s6_addr32[index];
-    ipv4_mask.s_addr = ipv6_mask.s6_addr32[index];
-    checkipv4_addr.s_addr = checkipv6addr.s6_addr32[index];
-    checkipv4_mask.s_addr = chk_ipv6_mask.s6_addr32[index];
-    ret = checkIPv4Address(ipv4_addr, ipv4_mask, checkipv4_addr,
-                             checkipv4_mask);
-    if (ret == false)
-      break;
-  }
-  return ret;
-}
-
-
-
-bool DataflowUtil::checkIPv4Address(in_addr ipaddr, in_addr ip_mask,
-                             in_addr checkipaddr, in_addr chk_ip_mask) {
-  return checkIPv4Address(ipaddr.s_addr, ip_mask.s_addr, checkipaddr.s_addr,
-                             chk_ip_mask.s_addr);
-}
-
-bool DataflowUtil::checkIPv4Address(uint32_t ipaddr, uint32_t ip_mask,
-                             uint32_t checkipaddr, uint32_t chk_ip_mask) {
-  // stringstream ss;
-  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16)
-  //                            <<endl;
-  // ss << "2MASK:" << getipstring(chk_ip_mask, 2) << " "
-  //                            << getipstring(chk_ip_mask, 16) <<endl;
-  uint32_t and_mask = ip_mask & chk_ip_mask;
-  // ss << "&MASK:" << getipstring(and_mask, 2) << " " << getipstring(and_mask, 16)
-  //                            <<endl;
-  // pfc_log_info("\n%s", ss.str().c_str());
-  return checkIPv4Address(ipaddr, and_mask, checkipaddr);
-}
-
 string DataflowUtil::getipstring(in_addr ipnaddr, int radix) {
   uint32_t ipaddr = ipnaddr.s_addr;
   return getipstring(ipaddr, radix);
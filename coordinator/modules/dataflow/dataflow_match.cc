@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/**
+ * @file    dataflow_match.cc
+ *
+ * Comparison of the matches of the flows stitched across controllers
+ */
+
+#include "uncxx/dataflow.hh"
+#include <string.h>
+#include <algorithm>
+#include <iterator>
+
+using namespace unc::dataflow;
+
+/*
+ * Offset and length of the compared fields in DataflowMatch::value_,
+ * indexed by UncDataflowFlowMatchType. In port, source MAC address and
+ * VLAN ID are not compared.
+ */
+static const struct {
+  uint8_t offset;
+  uint8_t len;
+} df_match_fields[] = {
+  {0, 0},     // UNC_MATCH_IN_PORT
+  {0, 0},     // UNC_MATCH_DL_SRC
+  {0, 6},     // UNC_MATCH_DL_DST
+  {6, 2},     // UNC_MATCH_DL_TYPE
+  {0, 0},     // UNC_MATCH_VLAN_ID
+  {8, 1},     // UNC_MATCH_VLAN_PCP
+  {9, 1},     // UNC_MATCH_IP_TOS
+  {10, 1},    // UNC_MATCH_IP_PROTO
+  {11, 4},    // UNC_MATCH_IPV4_SRC
+  {15, 4},    // UNC_MATCH_IPV4_DST
+  {19, 16},   // UNC_MATCH_IPV6_SRC
+  {35, 16},   // UNC_MATCH_IPV6_DST
+  {51, 2},    // UNC_MATCH_TP_SRC
+  {53, 2},    // UNC_MATCH_TP_DST
+};
+
+#define DF_MATCH_FIELD_COUNT  PFC_ARRAY_CAPACITY(df_match_fields)
+
+DataflowMatch::DataflowMatch() : present_(0), masked_(0) {
+  memset(value_, 0, sizeof(value_));
+  memset(mask_, 0, sizeof(mask_));
+}
+
+/** DataflowMatch
+ * * @Description : This function packs the compared fields of matches
+ * * @param[in]   : matches - matches or output_matches of a flow
+ * * @return      : None
+ **/
+DataflowMatch::DataflowMatch(
+    const map<UncDataflowFlowMatchType, void *> &matches)
+    : present_(0), masked_(0) {
+  memset(value_, 0, sizeof(value_));
+  memset(mask_, 0, sizeof(mask_));
+  map<UncDataflowFlowMatchType, void *>::const_iterator iter;
+  for (iter = matches.begin(); iter != matches.end(); iter++) {
+    if (iter->second == NULL) {
+      // ANY
+      continue;
+    }
+    switch (iter->first) {
+      case UNC_MATCH_IN_PORT:
+      case UNC_MATCH_DL_SRC:
+      case UNC_MATCH_VLAN_ID:
+        break;
+      case UNC_MATCH_DL_DST:
+      {
+        val_df_flow_match_dl_addr_t *st =
+            reinterpret_cast<val_df_flow_match_dl_addr_t *>(iter->second);
+        SetField(iter->first, st->dl_addr,
+                 (st->v_mask == UNC_MATCH_MASK_VALID) ? st->dl_addr_mask :
+                 NULL);
+        break;
+      }
+      case UNC_MATCH_DL_TYPE:
+      {
+        val_df_flow_match_dl_type_t *st =
+            reinterpret_cast<val_df_flow_match_dl_type_t *>(iter->second);
+        SetField(iter->first, &st->dl_type, NULL);
+        break;
+      }
+      case UNC_MATCH_VLAN_PCP:
+      {
+        val_df_flow_match_vlan_pcp_t *st =
+            reinterpret_cast<val_df_flow_match_vlan_pcp_t *>(iter->second);
+        SetField(iter->first, &st->vlan_pcp, NULL);
+        break;
+      }
+      case UNC_MATCH_IP_TOS:
+      {
+        val_df_flow_match_ip_tos_t *st =
+            reinterpret_cast<val_df_flow_match_ip_tos_t *>(iter->second);
+        SetField(iter->first, &st->ip_tos, NULL);
+        break;
+      }
+      case UNC_MATCH_IP_PROTO:
+      {
+        val_df_flow_match_ip_proto_t *st =
+            reinterpret_cast<val_df_flow_match_ip_proto_t *>(iter->second);
+        SetField(iter->first, &st->ip_proto, NULL);
+        break;
+      }
+      case UNC_MATCH_IPV4_SRC:
+      case UNC_MATCH_IPV4_DST:
+      {
+        val_df_flow_match_ipv4_addr_t *st =
+            reinterpret_cast<val_df_flow_match_ipv4_addr_t *>(iter->second);
+        SetField(iter->first, &st->ipv4_addr,
+                 (st->v_mask == UNC_MATCH_MASK_VALID) ? &st->ipv4_addr_mask :
+                 NULL);
+        break;
+      }
+      case UNC_MATCH_IPV6_SRC:
+      case UNC_MATCH_IPV6_DST:
+      {
+        val_df_flow_match_ipv6_addr_t *st =
+            reinterpret_cast<val_df_flow_match_ipv6_addr_t *>(iter->second);
+        SetField(iter->first, st->ipv6_addr.s6_addr,
+                 (st->v_mask == UNC_MATCH_MASK_VALID) ?
+                 st->ipv6_addr_mask.s6_addr : NULL);
+        break;
+      }
+      case UNC_MATCH_TP_SRC:
+      case UNC_MATCH_TP_DST:
+      {
+        val_df_flow_match_tp_port_t *st =
+            reinterpret_cast<val_df_flow_match_tp_port_t *>(iter->second);
+        SetField(iter->first, &st->tp_port,
+                 (st->v_mask == UNC_MATCH_MASK_VALID) ? &st->tp_port_mask :
+                 NULL);
+        break;
+      }
+      default:
+        pfc_log_warn("DataflowMatch Ignoring %d ", iter->first);
+        break;
+    }
+  }
+}
+
+void DataflowMatch::SetField(UncDataflowFlowMatchType type,
+                             const void *value, const void *mask) {
+  uint8_t offset = df_match_fields[type].offset;
+  uint8_t len = df_match_fields[type].len;
+  memcpy(&value_[offset], value, len);
+  if (mask != NULL) {
+    memcpy(&mask_[offset], mask, len);
+    masked_ |= (1U << type);
+  } else {
+    memset(&mask_[offset], 0xFF, len);
+  }
+  present_ |= (1U << type);
+}
+
+/** Matches
+ * * @Description : This function checks the fields present in both matches.
+ * *               Strict and masked values are compared as
+ * *               check_match_condition did with checkMacAddress,
+ * *               checkIPv4Address and checkIPv6Address.
+ * * @param[in]   : prev - output_matches of the previous flow
+ * * @return      : bool
+ **/
+bool DataflowMatch::Matches(const DataflowMatch &prev) const {
+  uint32_t both = present_ & prev.present_;
+  for (uint32_t type = 0; both != 0; type++, both >>= 1) {
+    if ((both & 1) == 0)
+      continue;
+    uint32_t end = df_match_fields[type].offset + df_match_fields[type].len;
+    for (uint32_t i = df_match_fields[type].offset; i < end; i++) {
+      if (((value_[i] ^ prev.value_[i]) & mask_[i] & prev.mask_[i]) != 0) {
+        pfc_log_debug("check match failed for %d", type);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool DataflowMatch::IsStrict(UncDataflowFlowMatchType type) const {
+  return ((present_ & ~masked_) & (1U << type)) != 0;
+}
+
+uint64_t DataflowMatch::Hash(UncDataflowFlowMatchType type) const {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  uint32_t end = df_match_fields[type].offset + df_match_fields[type].len;
+  for (uint32_t i = df_match_fields[type].offset; i < end; i++) {
+    hash ^= value_[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/** DataflowFlowIndex
+ * * @Description : This function indexes the compared fields of the flows
+ * * @param[in]   : flows - flows read from a controller or domain
+ * * @return      : None
+ **/
+DataflowFlowIndex::DataflowFlowIndex(const vector<DataflowDetail *> &flows) {
+  matches_.reserve(flows.size());
+  for (uint32_t pos = 0; pos < flows.size(); pos++) {
+    matches_.push_back(DataflowMatch(flows[pos]->matches));
+  }
+  for (uint32_t type = 0; type < DF_MATCH_FIELD_COUNT; type++) {
+    if (df_match_fields[type].len == 0)
+      continue;
+    UncDataflowFlowMatchType mtype = static_cast<UncDataflowFlowMatchType>(type);
+    FieldIndex &index = fields_[mtype];
+    for (uint32_t pos = 0; pos < matches_.size(); pos++) {
+      if (matches_[pos].IsStrict(mtype)) {
+        index.buckets[matches_[pos].Hash(mtype)].push_back(pos);
+      } else {
+        index.wildcards.push_back(pos);
+      }
+    }
+  }
+  pfc_log_debug("DataflowFlowIndex indexed %" PFC_PFMT_SIZE_T " flows",
+                matches_.size());
+}
+
+/** Lookup
+ * * @Description : This function gets the candidates of the field with the
+ * *               fewest candidates among the strict fields of 'prev'.
+ * *               All flows are candidates if 'prev' has no strict field.
+ * * @param[in]   : prev - output_matches of the previous flow
+ * * @param[out]  : positions - positions of the candidates, in ascending
+ * *               order
+ * * @return      : None
+ **/
+void DataflowFlowIndex::Lookup(const DataflowMatch &prev,
+                               vector<uint32_t> *positions) const {
+  const vector<uint32_t> *best_bucket = NULL;
+  const vector<uint32_t> *best_wildcards = NULL;
+  size_t best_count = matches_.size();
+  map<UncDataflowFlowMatchType, FieldIndex>::const_iterator iter;
+  for (iter = fields_.begin(); iter != fields_.end(); iter++) {
+    if (!prev.IsStrict(iter->first))
+      continue;
+    const FieldIndex &index = iter->second;
+    map<uint64_t, vector<uint32_t> >::const_iterator bucket =
+        index.buckets.find(prev.Hash(iter->first));
+    size_t count = index.wildcards.size();
+    if (bucket != index.buckets.end())
+      count += bucket->second.size();
+    if (count < best_count) {
+      best_count = count;
+      best_bucket = (bucket != index.buckets.end()) ? &bucket->second : NULL;
+      best_wildcards = &index.wildcards;
+    }
+  }
+  positions->clear();
+  if (best_wildcards == NULL) {
+    for (uint32_t pos = 0; pos < matches_.size(); pos++) {
+      positions->push_back(pos);
+    }
+    return;
+  }
+  positions->reserve(best_count);
+  if (best_bucket == NULL) {
+    positions->assign(best_wildcards->begin(), best_wildcards->end());
+  } else {
+    std::merge(best_bucket->begin(), best_bucket->end(),
+               best_wildcards->begin(), best_wildcards->end(),
+               std::back_inserter(*positions));
+  }
+  pfc_log_debug("Lookup found %" PFC_PFMT_SIZE_T " of %" PFC_PFMT_SIZE_T
+                " flows", positions->size(), matches_.size());
+}
+
+bool DataflowUtil::checkMacAddress(uint8_t macaddr[6], uint8_t macaddr_mask[6],
+                       uint8_t checkmacaddr[6]) {
+  bool retval = false;
+  for (int i = 0; i < 6; i++) {
+    retval = checkByte(macaddr[i], macaddr_mask[i], checkmacaddr[i]);
+    if (retval == false)
+      break;
+  }
+  return retval;
+}
+
+bool DataflowUtil::checkMacAddress(uint8_t macaddr[6], uint8_t macaddr_mask[6],
+                       uint8_t checkmacaddr[6], uint8_t checkmacaddr_mask[6]) {
+  bool retval = false;
+  for (int i = 0; i < 6; i++) {
+    retval = checkByte(macaddr[i], macaddr_mask[i], checkmacaddr[i],
+                       checkmacaddr_mask[i]);
+    if (retval == false)
+      break;
+  }
+  return retval;
+}
+
+bool DataflowUtil::checkIPv4Address(in_addr ipaddr, in_addr ip_mask,
+                        in_addr checkipaddr) {
+  return checkIPv4Address(ipaddr.s_addr, ip_mask.s_addr, checkipaddr.s_addr);
+}
+
+bool DataflowUtil::checkByte(uint8_t ipaddr, uint8_t ip_mask,
+                         uint8_t checkipaddr) {
+  // stringstream ss;
+  // ss << "1FRIP-" << getipstring(ipaddr, 2) << " " << getipstring(ipaddr, 16) <<endl;
+  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16) <<endl;
+  // ss << "1TOIP:" << getipstring(checkipaddr, 2) << " " << getipstring(checkipaddr, 16) <<endl;
+  uint8_t anded1 = ipaddr & ip_mask;
+  // ss << "1AND :" << getipstring(anded1, 2) << " " << getipstring(anded1, 16) <<endl;
+  uint8_t anded2 = checkipaddr & ip_mask;
+  // ss << "2AND :" << getipstring(anded2, 2) << " " << getipstring(anded2, 16) <<endl;
+  // pfc_log_debug("\n%s", ss.str().c_str());
+  if (anded1 == anded2) return true;
+  return false;
+}
+bool DataflowUtil::checkByte(uint8_t ipaddr, uint8_t ip_mask,
+                           uint8_t checkipaddr, uint8_t chk_ip_mask) {
+  // stringstream ss;
+  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16) <<endl;
+  // ss << "2MASK:" << getipstring(chk_ip_mask, 2) << " " << getipstring(chk_ip_mask, 16) <<endl;
+  uint8_t and_mask = ip_mask & chk_ip_mask;
+  // ss << "&MASK:" << getipstring(and_mask, 2) << " " << getipstring(and_mask, 16) <<endl;
+  // pfc_log_debug("\n%s", ss.str().c_str());
+  return checkByte(ipaddr, and_mask, checkipaddr);
+}
+
+bool DataflowUtil::checkIPv4Address(uint32_t ipaddr, uint32_t ip_mask,
+                            uint32_t checkipaddr) {
+  // stringstream ss;
+  // ss << "1FRIP-" << getipstring(ipaddr, 2) << " " << getipstring(ipaddr, 16) <<endl;
+  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16) <<endl;
+  // ss << "2TOIP:" << getipstring(checkipaddr, 2) << " " << getipstring(checkipaddr, 16) <<endl;
+  uint32_t anded1 = ipaddr & ip_mask;
+  // ss << "1AND :" << getipstring(anded1, 2) << " " << getipstring(anded1, 16) <<endl;
+  uint32_t anded2 = checkipaddr & ip_mask;
+  // ss << "2AND :" << getipstring(anded2, 2) << " " << getipstring(anded2, 16) <<endl;
+  // pfc_log_debug("\n%s", ss.str().c_str());
+  if (anded1 == anded2) return true;
+  return false;
+}
+
+bool DataflowUtil::checkIPv6Address(in6_addr ipv6addr, in6_addr ipv6_mask,
+                             in6_addr checkipv6addr) {
+  bool ret = false;
+  for (int index = 0; index < 4; index ++) {
+    uint32_t ipv4_addr = ipv6addr.s6_addr32[index];
+    uint32_t ipv4_mask = ipv6_mask.s6_addr32[index];
+    uint32_t checkipv4_addr = checkipv6addr.s6_addr32[index];
+    ret = checkIPv4Address(ipv4_addr, ipv4_mask, checkipv4_addr);
+    if (ret == false)
+      break;
+  }
+  return ret;
+}
+
+bool DataflowUtil::checkIPv6Address(in6_addr ipv6addr, in6_addr ipv6_mask,
+                            in6_addr checkipv6addr, in6_addr chk_ipv6_mask) {
+  bool ret = false;
+  for (int index = 0; index < 4; index ++) {
+    in_addr ipv4_addr, ipv4_mask, checkipv4_addr, checkipv4_mask;
+    ipv4_addr.s_addr =  ipv6addr.s6_addr32[index];
+    ipv4_mask.s_addr = ipv6_mask.s6_addr32[index];
+    checkipv4_addr.s_addr = checkipv6addr.s6_addr32[index];
+    checkipv4_mask.s_addr = chk_ipv6_mask.s6_addr32[index];
+    ret = checkIPv4Address(ipv4_addr, ipv4_mask, checkipv4_addr,
+                             checkipv4_mask);
+    if (ret == false)
+      break;
+  }
+  return ret;
+}
+
+bool DataflowUtil::checkIPv4Address(in_addr ipaddr, in_addr ip_mask,
+                             in_addr checkipaddr, in_addr chk_ip_mask) {
+  return checkIPv4Address(ipaddr.s_addr, ip_mask.s_addr, checkipaddr.s_addr,
+                             chk_ip_mask.s_addr);
+}
+
+bool DataflowUtil::checkIPv4Address(uint32_t ipaddr, uint32_t ip_mask,
+                             uint32_t checkipaddr, uint32_t chk_ip_mask) {
+  // stringstream ss;
+  // ss << "1MASK:" << getipstring(ip_mask, 2) << " " << getipstring(ip_mask, 16)
+  //                            <<endl;
+  // ss << "2MASK:" << getipstring(chk_ip_mask, 2) << " "
+  //                            << getipstring(chk_ip_mask, 16) <<endl;
+  uint32_t and_mask = ip_mask & chk_ip_mask;
+  // ss << "&MASK:" << getipstring(and_mask, 2) << " " << getipstring(and_mask, 16)
+  //                            <<endl;
+  // pfc_log_info("\n%s", ss.str().c_str());
+  return checkIPv4Address(ipaddr, and_mask, checkipaddr);
+}
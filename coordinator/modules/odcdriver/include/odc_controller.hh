@@ -17,6 +17,7 @@
 #include <rest_util.hh>
 #include <string>
 #include <vector>
+#include <map>
 #include <sstream>
 
 namespace unc {
@@ -101,6 +102,37 @@ class OdcController: public unc::driver::controller {
    */
   std::string frame_openflow_switchid(std::string &node_id);
 
+  /**
+   * @brief                     - Gets the fingerprint of the ports of a
+   *                              switch stored by the last topology poll
+   * @param[in] switch_id       - switch id
+   * @param[out] fingerprint    - stored fingerprint
+   * @return pfc_bool_t         - PFC_FALSE if no fingerprint is stored
+   */
+  pfc_bool_t get_port_fingerprint(const std::string &switch_id,
+                                  uint64_t *fingerprint);
+
+  /**
+   * @brief                     - Stores the fingerprint of the ports of a
+   *                              switch once they are in physical_port_cache
+   * @param[in] switch_id       - switch id
+   * @param[in] fingerprint     - fingerprint of the port attributes
+   */
+  void set_port_fingerprint(const std::string &switch_id,
+                            uint64_t fingerprint);
+
+  /**
+   * @brief                     - Forgets the fingerprint of a switch, so its
+   *                              ports are compared on the next poll
+   * @param[in] switch_id       - switch id
+   */
+  void clear_port_fingerprint(const std::string &switch_id);
+
+  /**
+   * @brief                     - Forgets the fingerprints of all switches
+   */
+  void clear_port_fingerprints();
+
   /**
    * @brief     - Vector to hold vlan-ids for verification purpose
    */
@@ -115,6 +147,8 @@ class OdcController: public unc::driver::controller {
   std::string pass_word_;
   pfc_bool_t audit_;
   unc::restjson::ConfFileValues_t conf_file_values_;
+  // Port fingerprint of each switch in physical_port_cache
+  std::map<std::string, uint64_t> port_fingerprint_map_;
 };
 }  // namespace odcdriver
 }  // namespace unc
@@ -44,6 +44,13 @@ const std::string VTN_TOPO_URL          = "/vtn-topology:vtn-topology";
 const std::string VTN_SW_NODES          = "/vtn-inventory:vtn-nodes";
 const std::string VTN_PORT              = "/vtn-inventory:vtn-node";
 const std::string ODL_PORT              = "/opendaylight-inventory:nodes";
+// Keys leading to the arrays streamed from the topology responses
+const char * const VTN_NODES_STREAM_PATH[] = { "vtn-nodes", "vtn-node" };
+const char * const VTN_PORT_STREAM_PATH[]  = { "vtn-node", "vtn-port" };
+const char * const VTN_LINK_STREAM_PATH[]  = { "vtn-topology", "vtn-link" };
+// 64-bit FNV-1a parameters of the port fingerprint of a switch
+const uint64_t ODC_FNV64_OFFSET_BASIS   = 14695981039346656037ULL;
+const uint64_t ODC_FNV64_PRIME          = 1099511628211ULL;
 
 // Configuration block to read from odcdriver.conf
 const std::string DRV_CONF_BLK          = "param";
@@ -53,6 +60,8 @@ const std::string CONF_PASSWORD         = "password";
 const std::string CONF_ODC_PORT         = "odc_port";
 const std::string CONF_CONNECT_TIME_OUT = "connect_time_out";
 const std::string CONF_REQ_TIME_OUT     = "request_time_out";
+const std::string CONF_MAX_POOLED_CONN  = "max_pooled_connections";
+const std::string CONF_COMMIT_CONCURRENCY = "commit_concurrency";
 const std::string CONF_PING_INTERVAL    = "odcdrv_ping_interval";
 
 const std::string NODE_TYPE_OF          = "OF-";
@@ -73,6 +82,8 @@ const std::string SWITCH_HEX            = "0000000000000000";
 const uint32_t DEFAULT_ODC_PORT         = 8181;
 const uint32_t DEFAULT_CONNECT_TIME_OUT = 30;
 const uint32_t DEFAULT_REQ_TIME_OUT     = 30;
+const uint32_t DEFAULT_MAX_POOLED_CONN  = 8;
+const uint32_t DEFAULT_COMMIT_CONCURRENCY = 8;
 const uint32_t PING_INTERVAL            = 10;
 const uint32_t PING_RETRY_COUNT         = 5;
 const uint32_t DEFAULT_AGE_INTERVAL     = 600;
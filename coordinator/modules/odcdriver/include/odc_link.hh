@@ -18,6 +18,7 @@
 #include <vtndrvintf_defs.h>
 #include <vtn_drv_module.hh>
 #include <topo.hh>
+#include <odc_rest.hh>
 #include <string>
 #include <list>
 #include <vector>
@@ -28,6 +29,8 @@ namespace unc {
 namespace odcdriver {
 
 class OdcLink {
+  friend class OdcLinkStreamHandler;
+
  public:
   /**
    * @brief Parametrised Constructor
@@ -184,17 +187,6 @@ class OdcLink {
   pfc_bool_t is_link_modified(val_link_st_t *val_link_ctr,
                               val_link_st_t *val_link_cache);
 
-  /**
-   * @brief                           - parse the response from controller
-   * @param[in] ctr_ptr               - Controller pointer
-   * @param[in] link                  - data to be parsed
-   * @param[out] cfgnode_vector       - to be filled with the response
-   * return UncRespCode               - return UNC_RC_SUCCESS/ UNC_DRV_RC_ERR_GENERIC
-   */
-  UncRespCode parse_link_response(
-      unc::driver::controller *ctr_ptr,
-      std::list<vtn_link> &link_detail,
-      std::vector< unc::vtndrvcache::ConfigNode *> &cfgnode_vector);
   /**
    * @brief                           -  parse the link details from
                                          connection string
@@ -227,6 +219,37 @@ class OdcLink {
   unc::restjson::ConfFileValues_t conf_file_values_;
   std::map<std::string, std::string> link_map_;
 };
+
+/*
+ * Converts each vtn-link of the vtn-topology response to a link config node
+ * while the response is received
+ */
+class OdcLinkStreamHandler : public unc::restjson::JsonStreamRecordHandler {
+ public:
+  /**
+   * @brief                          - Constructor
+   * @param[in] odc_link             - OdcLink filling the config nodes
+   * @param[in] ctr_ptr              - Controller pointer
+   * @param[out] cfgnode_vector      - vector to which config nodes are pushed
+   */
+  OdcLinkStreamHandler(
+      OdcLink *odc_link,
+      unc::driver::controller *ctr_ptr,
+      std::vector<unc::vtndrvcache::ConfigNode *> &cfgnode_vector);
+
+  /**
+   * @brief                          - Fills the config node of one vtn-link
+   * @param[in] record               - members of the vtn-link
+   * @return rest_resp_code_t        - REST_OP_FAILURE stops the parse
+   */
+  unc::restjson::rest_resp_code_t record(
+      const unc::restjson::JsonStreamRecord_t &record);
+
+ private:
+  OdcLink *odc_link_;
+  unc::driver::controller *ctr_ptr_;
+  std::vector<unc::vtndrvcache::ConfigNode *> &cfgnode_vector_;
+};
 }  // namespace odcdriver
 }  // namespace unc
 #endif
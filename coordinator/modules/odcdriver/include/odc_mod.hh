@@ -47,6 +47,7 @@ class ODCModule: public pfc::core::Module, public unc::driver::driver {
   explicit ODCModule(const pfc_modattr_t*& obj)
       : Module(obj),
         ping_interval(0),
+        commit_concurrency(1),
         conf_file_values_() { }
   /**
    * @brief     - Gets the controller type
@@ -168,6 +169,12 @@ class ODCModule: public pfc::core::Module, public unc::driver::driver {
    */
   uint32_t get_ping_fail_retry_count();
 
+  /**
+   * @brief  - Gets the number of config nodes sent in parallel on commit
+   * @return - returns the commit concurrency
+   */
+  uint32_t get_commit_concurrency();
+
   /**
    * @brief     - ping controller available or not
    * @param[in] - Controller pointer
@@ -209,6 +216,7 @@ class ODCModule: public pfc::core::Module, public unc::driver::driver {
 
  private:
   uint32_t ping_interval;  // in seconds
+  uint32_t commit_concurrency;
   unc::restjson::ConfFileValues_t conf_file_values_;
 };
 }  //  namespace odcdriver
@@ -19,6 +19,7 @@
 #include <vtndrvintf_defs.h>
 #include <driver/driver_command.hh>
 #include <port.hh>
+#include <odc_rest.hh>
 #include <string>
 #include <list>
 #include <vector>
@@ -27,6 +28,14 @@
 namespace unc {
 namespace odcdriver {
 
+// Attributes of one vtn-port of the vtn-node response
+typedef struct {
+  std::string cost;
+  std::string id;
+  std::string name;
+  int enabled;
+} OdcPortRecord_t;
+
 class OdcPort : public unc::driver::vtn_driver_read_command {
  public:
   /**
@@ -100,6 +109,16 @@ class OdcPort : public unc::driver::vtn_driver_read_command {
       uint enabled,
       std::vector<unc::vtndrvcache::ConfigNode *> &cfg_node_vector);
 
+  /**
+   * @brief                          - adds a port of parent_switch_ to the
+   *                                   link map given to OdcLink
+   * @param[in] id                   - node connector id of the port
+   * @param[in] name                 - port name
+   * @param[in] enabled              - admin status of the port
+   */
+  void update_link_map(const std::string &id, const std::string &name,
+                       uint enabled);
+
   /**
    * @brief                          - parses the port properties values from
    *                                   the json object
@@ -211,18 +230,6 @@ class OdcPort : public unc::driver::vtn_driver_read_command {
   pfc_bool_t is_port_modified(val_port_st_t *val_port_ctr,
                               val_port_st_t *val_port_cache);
 
-  /**
-   * @brief                           - parse the response from controller
-   * @param[in] ctr_ptr               - Controller pointer
-   * @param[in] list                  - data to be parsed
-   * @param[out] cfgnode_vector       - to be filled with the response
-   * return UncRespCode               - return UNC_RC_SUCCESS/ UNC_DRV_RC_ERR_GENERIC
-   */
-  UncRespCode parse_port_response(
-      unc::driver::controller *ctr_ptr,
-      std::list<vtn_port> &port_detail,
-      std::vector< unc::vtndrvcache::ConfigNode *> &cfgnode_vector);
-
   /**
    * @brief                           - parse the response from controller
    * @param[in] ctr_ptr               - Controller pointer
@@ -286,6 +293,42 @@ class OdcPort : public unc::driver::vtn_driver_read_command {
   std::map <std::string, std::string> link_map_;
   std::string parent_switch_;
 };
+
+/*
+ * Collects the attributes of each vtn-port of the vtn-node response while
+ * the response is received, and folds them into a fingerprint of the port
+ * set of the switch. The fingerprint does not depend on the order of the
+ * ports, so an unchanged switch is recognised without building its
+ * config nodes.
+ */
+class OdcPortStreamHandler : public unc::restjson::JsonStreamRecordHandler {
+ public:
+  /**
+   * @brief                          - Constructor
+   * @param[out] port_records        - vector to which the ports are pushed
+   */
+  explicit OdcPortStreamHandler(std::vector<OdcPortRecord_t> &port_records);
+
+  /**
+   * @brief                          - Validates and stores one vtn-port
+   * @param[in] record               - members of the vtn-port
+   * @return rest_resp_code_t        - REST_OP_FAILURE stops the parse
+   */
+  unc::restjson::rest_resp_code_t record(
+      const unc::restjson::JsonStreamRecord_t &record);
+
+  /**
+   * @brief                          - Gets the fingerprint of the ports
+   *                                   received so far
+   * @return uint64_t                - fingerprint
+   */
+  uint64_t get_fingerprint() const;
+
+ private:
+  std::vector<OdcPortRecord_t> &port_records_;
+  // Sum of the hashes of the ports
+  uint64_t hash_sum_;
+};
 }  // namespace odcdriver
 }  // namespace unc
 #endif
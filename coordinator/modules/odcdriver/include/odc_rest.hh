@@ -14,6 +14,8 @@
 #include <json_read_util.hh>
 #include <driver/driver_interface.hh>
 #include <rest_util.hh>
+#include <json_stream_parser.hh>
+#include <odc_driver_common_defs.hh>
 #include <unc/upll_ipc_enum.h>
 #include <unc/unc_base.h>
 #include <vector>
@@ -86,6 +88,15 @@ class odl_http_request {
                              unc::odcdriver::OdcDriverOps Op,
                              unc::odcdriver::odl_http_rest_intf*,
                              unc::restjson::ConfFileValues_t conf_values);
+
+  // Sends a GET request and feeds the response body to stream_parser
+  // while it is received, without keeping the whole body in memory
+  UncRespCode handle_stream_request(unc::driver::controller *ctr_ptr,
+                                    const std::string &url,
+                                    unc::restjson::JsonStreamParser
+                                    *stream_parser,
+                                    unc::restjson::ConfFileValues_t
+                                    conf_values);
 };
 }  // namespace odcdriver
 }  // namespace unc
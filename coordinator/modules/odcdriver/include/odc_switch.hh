@@ -14,6 +14,7 @@
 #include <odc_driver_common_defs.hh>
 #include <odc_controller.hh>
 #include <odc_port.hh>
+#include <odc_rest.hh>
 #include <unc/upll_ipc_enum.h>
 #include <vtndrvintf_defs.h>
 #include <vtn_drv_module.hh>
@@ -27,6 +28,8 @@ namespace unc {
 namespace odcdriver {
 
 class OdcSwitch {
+  friend class OdcSwitchStreamHandler;
+
  public:
   /**
    * @brief Parametrised Constructor
@@ -158,18 +161,6 @@ class OdcSwitch {
   pfc_bool_t is_switch_modified(val_switch_st_t *val_switch_ctr,
                                 val_switch_st_t *val_switch_cache);
 
-  /**
-   * @brief                           - parse the response from controller
-   * @param[in] ctr_ptr               - Controller pointer
-   * @param[in] list                  - data to be parsed
-   * @param[out] cfgnode_vector       - to be filled with the response
-   * return UncRespCode               - return UNC_RC_SUCCESS/ UNC_DRV_RC_ERR_GENERIC
-   */
-  UncRespCode parse_node_response(
-      unc::driver::controller *ctr_ptr,
-      std::list<vtn_node> &node_deatil,
-      std::vector< unc::vtndrvcache::ConfigNode *> &cfgnode_vector);
-
   /**
    * @brief                          - delete_logical_port
    * @param[in] ctr                  - Controller pointer
@@ -203,6 +194,36 @@ class OdcSwitch {
  private:
   unc::restjson::ConfFileValues_t conf_file_values_;
 };
+/*
+ * Converts each vtn-node of the vtn-nodes response to a switch config node
+ * while the response is received
+ */
+class OdcSwitchStreamHandler : public unc::restjson::JsonStreamRecordHandler {
+ public:
+  /**
+   * @brief                          - Constructor
+   * @param[in] odc_switch           - OdcSwitch filling the config nodes
+   * @param[in] ctr_ptr              - Controller pointer
+   * @param[out] cfgnode_vector      - vector to which config nodes are pushed
+   */
+  OdcSwitchStreamHandler(
+      OdcSwitch *odc_switch,
+      unc::driver::controller *ctr_ptr,
+      std::vector<unc::vtndrvcache::ConfigNode *> &cfgnode_vector);
+
+  /**
+   * @brief                          - Fills the config node of one vtn-node
+   * @param[in] record               - members of the vtn-node
+   * @return rest_resp_code_t        - REST_OP_FAILURE stops the parse
+   */
+  unc::restjson::rest_resp_code_t record(
+      const unc::restjson::JsonStreamRecord_t &record);
+
+ private:
+  OdcSwitch *odc_switch_;
+  unc::driver::controller *ctr_ptr_;
+  std::vector<unc::vtndrvcache::ConfigNode *> &cfgnode_vector_;
+};
 }  // namespace odcdriver
 }  // namespace unc
 #endif
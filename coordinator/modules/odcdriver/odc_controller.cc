@@ -111,5 +111,38 @@ unc::restjson::ConfFileValues_t OdcController::get_conf_value() {
   ODC_FUNC_TRACE;
   return conf_file_values_;
 }
+
+// Gets the stored port fingerprint of the switch
+pfc_bool_t OdcController::get_port_fingerprint(const std::string &switch_id,
+                                               uint64_t *fingerprint) {
+  ODC_FUNC_TRACE;
+  PFC_ASSERT(fingerprint != NULL);
+  std::map<std::string, uint64_t>::iterator it =
+      port_fingerprint_map_.find(switch_id);
+  if (it == port_fingerprint_map_.end()) {
+    return PFC_FALSE;
+  }
+  *fingerprint = it->second;
+  return PFC_TRUE;
+}
+
+// Stores the port fingerprint of the switch
+void OdcController::set_port_fingerprint(const std::string &switch_id,
+                                         uint64_t fingerprint) {
+  ODC_FUNC_TRACE;
+  port_fingerprint_map_[switch_id] = fingerprint;
+}
+
+// Removes the port fingerprint of the switch
+void OdcController::clear_port_fingerprint(const std::string &switch_id) {
+  ODC_FUNC_TRACE;
+  port_fingerprint_map_.erase(switch_id);
+}
+
+// Removes the port fingerprints of all switches
+void OdcController::clear_port_fingerprints() {
+  ODC_FUNC_TRACE;
+  port_fingerprint_map_.clear();
+}
 }  //  namespace odcdriver
 }  //  namespace unc
@@ -32,35 +32,32 @@ UncRespCode OdcLink::fetch_config(
   ODC_FUNC_TRACE;
   PFC_VERIFY(ctr_ptr != NULL);
   std::vector<unc::vtndrvcache::ConfigNode *> cfgnode_vector;
-  vtntopology_request *req_obj = new vtntopology_request(ctr_ptr);
-  std::string url =  req_obj->get_url();
+  vtntopology_request req_obj(ctr_ptr);
+  std::string url =  req_obj.get_url();
   pfc_log_info("URL:%s",url.c_str());
-  vtntopology_parser *parse_obj = new vtntopology_parser();
-  UncRespCode ret_val = req_obj->get_response(parse_obj);
-  if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("Get response error");
-    delete req_obj;
-    delete parse_obj;
-    return UNC_DRV_RC_ERR_GENERIC;
+  // Links are converted while the response is received
+  OdcLinkStreamHandler handler(this, ctr_ptr, cfgnode_vector);
+  unc::restjson::JsonStreamParser stream_parser(&handler);
+  unc::odcdriver::OdcController *odc_ctr =
+      reinterpret_cast<unc::odcdriver::OdcController *>(ctr_ptr);
+  odl_http_request odl_req;
+  UncRespCode ret_val = odl_req.handle_stream_request(
+      ctr_ptr, url, &stream_parser, odc_ctr->get_conf_value());
+  if ((UNC_RC_SUCCESS == ret_val) && (0 == handler.get_matched_keys())) {
+    pfc_log_error("vtn-topology not present in response");
+    ret_val = UNC_DRV_RC_ERR_GENERIC;
   }
-  ret_val = parse_obj->set_vtn_link(parse_obj->jobj);
   if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("set vtn-link error");
-    delete req_obj;
-    delete parse_obj;
+    pfc_log_error("Get response error");
+    std::vector<unc::vtndrvcache::ConfigNode *>::iterator it;
+    for (it = cfgnode_vector.begin(); it != cfgnode_vector.end(); ++it) {
+      delete_config_node(*it);
+    }
     return UNC_DRV_RC_ERR_GENERIC;
   }
-  ret_val =  parse_link_response(ctr_ptr, parse_obj->vtn_link_, cfgnode_vector);
-  if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("Error occured while parsing");
-    delete req_obj;
-    delete parse_obj;
-    return ret_val;
-  }
+  pfc_log_debug("%u links in response", handler.get_record_count());
   ret_val = compare_with_cache(ctr_ptr, cache_empty, cfgnode_vector);
   pfc_log_debug("Response from compare_with_cache is %d", ret_val);
-  delete req_obj;
-  delete parse_obj;
   return ret_val;
 }
 
@@ -550,23 +547,42 @@ void OdcLink::parse_properties(std::string conn, std::string &switch_id,
 }
 
 // parsing function for converting controller response to driver format
-UncRespCode OdcLink::parse_link_response(
+// Constructor
+OdcLinkStreamHandler::OdcLinkStreamHandler(
+    OdcLink *odc_link,
     unc::driver::controller *ctr_ptr,
-    std::list<vtn_link> &link_detail,
-    std::vector< unc::vtndrvcache::ConfigNode *> &cfgnode_vector) {
+    std::vector<unc::vtndrvcache::ConfigNode *> &cfgnode_vector)
+: unc::restjson::JsonStreamRecordHandler(
+    std::vector<std::string>(VTN_LINK_STREAM_PATH,
+                             VTN_LINK_STREAM_PATH +
+                             PFC_ARRAY_CAPACITY(VTN_LINK_STREAM_PATH))),
+  odc_link_(odc_link),
+  ctr_ptr_(ctr_ptr),
+  cfgnode_vector_(cfgnode_vector) {
+}
+
+// Converts one vtn-link to a config node
+unc::restjson::rest_resp_code_t OdcLinkStreamHandler::record(
+    const unc::restjson::JsonStreamRecord_t &record) {
   ODC_FUNC_TRACE;
-  std::list<vtn_link>::iterator it;
-  for (it = link_detail.begin(); it != link_detail.end(); it++) {
-    std::string source = it->source;
-    std::string dst = it->destination;
-    UncRespCode ret_val = fill_edge_value_map(
-        source, dst, ctr_ptr, cfgnode_vector);
-    if (UNC_RC_SUCCESS != ret_val) {
-      pfc_log_error("Error return from fill map failure");
-      return ret_val;
+  const char *mandatory[] = { "source", "link-id", "destination" };
+  std::string values[PFC_ARRAY_CAPACITY(mandatory)];
+  for (uint32_t i = 0; i < PFC_ARRAY_CAPACITY(mandatory); i++) {
+    unc::restjson::JsonStreamRecord_t::const_iterator it =
+        record.find(mandatory[i]);
+    if ((it == record.end()) || (it->second.empty())) {
+      pfc_log_error(" Error while parsing %s", mandatory[i]);
+      return unc::restjson::REST_OP_FAILURE;
     }
+    values[i] = it->second;
   }
-  return UNC_RC_SUCCESS;
+  UncRespCode ret_val = odc_link_->fill_edge_value_map(
+      values[0], values[2], ctr_ptr_, cfgnode_vector_);
+  if (UNC_RC_SUCCESS != ret_val) {
+    pfc_log_error("Error return from fill map failure");
+    return unc::restjson::REST_OP_FAILURE;
+  }
+  return unc::restjson::REST_OP_SUCCESS;
 }
 }  // namespace odcdriver
 }  // namespace unc
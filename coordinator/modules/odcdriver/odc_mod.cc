@@ -89,6 +89,11 @@ pfc_bool_t ODCModule::update_controller(const key_ctr_t& key_ctr,
   ctrl_info_update_type_t change_type = compare_ctr_info(ctr_ptr,
                                                          val_ctr);
   pfc_log_debug(" change type, %d" , change_type);
+  if ((change_type == CTRLINFO_IP_CHANGED) ||
+      (change_type == CTRLINFO_IP_REMOVED)) {
+    // Drop the pooled connections to the old address
+    unc::restjson::RestUtil::flush_connections(ctr_ptr->get_host_address());
+  }
 
   ctr_ptr->update_ctr(key_ctr, val_ctr);
  // If audit status is disable and IP address Added or updated,
@@ -112,6 +117,7 @@ pfc_bool_t ODCModule::update_controller(const key_ctr_t& key_ctr,
 pfc_bool_t ODCModule::delete_controller(unc::driver::controller* ctr_ptr) {
   ODC_FUNC_TRACE;
   if (NULL != ctr_ptr) {
+    unc::restjson::RestUtil::flush_connections(ctr_ptr->get_host_address());
     delete ctr_ptr;
     ctr_ptr = NULL;
     return PFC_TRUE;
@@ -278,6 +284,12 @@ uint32_t ODCModule::get_ping_fail_retry_count() {
   return PING_RETRY_COUNT;
 }
 
+// Gets the number of config nodes sent in parallel on commit
+uint32_t ODCModule::get_commit_concurrency() {
+  ODC_FUNC_TRACE;
+  return commit_concurrency;
+}
+
 // Is ping need or not
 pfc_bool_t ODCModule::is_ping_needed() {
   ODC_FUNC_TRACE;
@@ -342,6 +354,7 @@ pfc_bool_t ODCModule::get_physical_port_details(
        delete ctr_ptr->physical_port_cache;
        ctr_ptr->physical_port_cache = NULL;
     }
+    reinterpret_cast<OdcController *>(ctr_ptr)->clear_port_fingerprints();
     return PFC_FALSE;
   }
   if (NULL == ctr_ptr->physical_port_cache) {
@@ -365,6 +378,7 @@ pfc_bool_t ODCModule::get_physical_port_details(
       pfc_log_error("cfgnode is NULL before get_type");
       delete ctr_ptr->physical_port_cache;
       ctr_ptr->physical_port_cache = NULL;
+      reinterpret_cast<OdcController *>(ctr_ptr)->clear_port_fingerprints();
       return PFC_FALSE;
     }
 
@@ -455,6 +469,10 @@ void ODCModule::read_conf_file() {
 
     conf_file_values_.connection_time_out = drv_block.getUint32(
         CONF_CONNECT_TIME_OUT, DEFAULT_CONNECT_TIME_OUT);
+    conf_file_values_.max_pooled_connections = drv_block.getUint32(
+        CONF_MAX_POOLED_CONN, DEFAULT_MAX_POOLED_CONN);
+    commit_concurrency = drv_block.getUint32(CONF_COMMIT_CONCURRENCY,
+                                             DEFAULT_COMMIT_CONCURRENCY);
     conf_file_values_.user_name = drv_block.getString(
         CONF_USER_NAME, DEFAULT_USER_NAME.c_str());
 
@@ -467,6 +485,8 @@ void ODCModule::read_conf_file() {
     conf_file_values_.odc_port   =  DEFAULT_ODC_PORT;
     conf_file_values_.connection_time_out = DEFAULT_CONNECT_TIME_OUT;
     conf_file_values_.request_time_out = DEFAULT_REQ_TIME_OUT;
+    conf_file_values_.max_pooled_connections = DEFAULT_MAX_POOLED_CONN;
+    commit_concurrency = DEFAULT_COMMIT_CONCURRENCY;
     conf_file_values_.user_name = DEFAULT_USER_NAME;
     conf_file_values_.password  = DEFAULT_PASSWORD;
     pfc_log_debug("%s: Block Handle is Invalid,set default Value %d",
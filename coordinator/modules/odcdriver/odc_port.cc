@@ -46,35 +46,59 @@ UncRespCode OdcPort::fetch_config(
     pfc_log_error("Switch id is empty");
     return UNC_DRV_RC_ERR_GENERIC;
   }
-  vtnport_request *req_obj = new vtnport_request(ctr_ptr,parent_switch_);
-  vtnport_parser *parse_obj = new vtnport_parser();
-  UncRespCode ret_val = req_obj->get_response(parse_obj);
-  if (UNC_RC_SUCCESS != ret_val) {
-     pfc_log_error("get_response error");
-    delete req_obj;
-    delete parse_obj;
-    return UNC_DRV_RC_ERR_GENERIC;
+  vtnport_request req_obj(ctr_ptr, parent_switch_);
+  std::string url = req_obj.get_url();
+  // Ports are collected and fingerprinted while the response is received
+  std::vector<OdcPortRecord_t> port_records;
+  OdcPortStreamHandler handler(port_records);
+  unc::restjson::JsonStreamParser stream_parser(&handler);
+  unc::odcdriver::OdcController *odc_ctr =
+      reinterpret_cast<unc::odcdriver::OdcController *>(ctr_ptr);
+  odl_http_request odl_req;
+  UncRespCode ret_val = odl_req.handle_stream_request(
+      ctr_ptr, url, &stream_parser, odc_ctr->get_conf_value());
+  if ((UNC_RC_SUCCESS == ret_val) &&
+      (0 == handler.get_path_element_count())) {
+    pfc_log_error("vtn-node not present in response");
+    ret_val = UNC_DRV_RC_ERR_GENERIC;
   }
-  ret_val = parse_obj->set_vtn_port(parse_obj->jobj);
   if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("set_vtn_port error");
-    delete req_obj;
-    delete parse_obj;
+    pfc_log_error("get_response error");
     return UNC_DRV_RC_ERR_GENERIC;
   }
-  parse_port_response(ctr_ptr, parse_obj->vtn_port_, cfgnode_vector);
-  if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("Error occured while parsing");
-    delete req_obj;
-    delete parse_obj;
-    return ret_val;
+  pfc_log_debug("%u ports in response", handler.get_record_count());
+
+  // The oper status of the ports follows the connection status
+  uint64_t fingerprint = handler.get_fingerprint() +
+      static_cast<uint64_t>(ctr_ptr->get_connection_status());
+  uint64_t cache_fingerprint = 0;
+  std::vector<OdcPortRecord_t>::iterator rec;
+  if ((PFC_FALSE == cache_empty) &&
+      (PFC_TRUE == odc_ctr->get_port_fingerprint(parent_switch_,
+                                                  &cache_fingerprint)) &&
+      (cache_fingerprint == fingerprint)) {
+    // The cache already holds exactly these ports, only the link map
+    // needs them
+    pfc_log_debug("Ports of %s not changed", parent_switch_.c_str());
+    for (rec = port_records.begin(); rec != port_records.end(); ++rec) {
+      update_link_map(rec->id, rec->name, rec->enabled);
+    }
+    return UNC_RC_SUCCESS;
+  }
+
+  // The fingerprint is stored again only if the cache is brought in sync
+  odc_ctr->clear_port_fingerprint(parent_switch_);
+  for (rec = port_records.begin(); rec != port_records.end(); ++rec) {
+    fill_config_node_vector(ctr_ptr, rec->cost, rec->id, rec->name,
+                            rec->enabled, cfgnode_vector);
   }
   // compare with cahe
   ret_val = compare_with_cache(ctr_ptr,
       cfgnode_vector, parent_switch_, cache_empty);
   pfc_log_debug("Response from compare_with_cache is %d", ret_val);
-  delete req_obj;
-  delete parse_obj;
+  if (UNC_RC_SUCCESS == ret_val) {
+    odc_ctr->set_port_fingerprint(parent_switch_, fingerprint);
+  }
   return ret_val;
 }
 
@@ -111,22 +135,8 @@ UncRespCode OdcPort::fill_config_node_vector(
   lp_id.append(HYPHEN);
   lp_id.append(name);
   pfc_log_debug("Port id formed in logical port : %s", lp_id.c_str());
-  // Fill link map
-  // linkmap contains port_id as key
-  // switchid|status|portname value
-  // <openflow:3:3,s3-eth3|status|openflow:3>
-  std::string head_conn = id;
-  std::string port_value = name;
-  port_value.append(PIPE_SEPARATOR);
-  std::ostringstream str_state_val;
-  str_state_val << enabled;
-  port_value.append(str_state_val.str());
-  port_value.append(PIPE_SEPARATOR);
-  port_value.append(parent_switch_);
-  link_map_[head_conn] = port_value;
+  update_link_map(id, name, enabled);
 
-  pfc_log_debug("link details framed %s | %s", head_conn.c_str(),
-                port_value.c_str());
   strncpy(reinterpret_cast<char*> (val_port.logical_port_id), lp_id.c_str(),
           strlen(lp_id.c_str()));
   val_port.valid[kIdxPortLogicalPortId] = UNC_VF_VALID;
@@ -172,6 +182,26 @@ UncRespCode OdcPort::fill_config_node_vector(
   return UNC_RC_SUCCESS;
 }
 
+// Fill link map
+// linkmap contains port_id as key
+// switchid|status|portname value
+// <openflow:3:3,s3-eth3|status|openflow:3>
+void OdcPort::update_link_map(const std::string &id, const std::string &name,
+                              uint enabled) {
+  ODC_FUNC_TRACE;
+  std::string port_value = name;
+  port_value.append(PIPE_SEPARATOR);
+  std::ostringstream str_state_val;
+  str_state_val << enabled;
+  port_value.append(str_state_val.str());
+  port_value.append(PIPE_SEPARATOR);
+  port_value.append(parent_switch_);
+  link_map_[id] = port_value;
+
+  pfc_log_debug("link details framed %s | %s", id.c_str(),
+                port_value.c_str());
+}
+
 // parse the port properties vale
 UncRespCode OdcPort::parse_port_properties_value(
     int arr_idx,
@@ -732,72 +762,6 @@ pfc_bool_t OdcPort::is_port_modified(val_port_st_t *val_port_ctr,
 }
 
 // parsing function for converting controller response to driver format
-UncRespCode OdcPort::parse_port_response(
-    unc::driver::controller *ctr_ptr,
-    std::list<vtn_port> &port_detail,
-    std::vector< unc::vtndrvcache::ConfigNode *> &cfgnode_vector) {
-  ODC_FUNC_TRACE;
-#if 0
-  json_object* jobj = restjson::JsonBuildParse::get_json_object(data);
-  if (json_object_is_type(jobj, json_type_null)) {
-    pfc_log_error("json_object_is_type error");
-    return UNC_DRV_RC_ERR_GENERIC;
-  }
-  uint32_t array_length =0;
-  json_object *json_obj_node_conn_prop = NULL;
-  uint32_t ret_val = restjson::JsonBuildParse::parse(jobj,
-                                                     "vtn-node",
-                                                     -1,
-                                                     json_obj_node_conn_prop);
-  if ((restjson::REST_OP_SUCCESS != ret_val) ||
-      (json_object_is_type(json_obj_node_conn_prop, json_type_null))) {
-    json_object_put(jobj);
-    pfc_log_error("Parsing Error json_obj_node_conn_prop is null");
-    return UNC_DRV_RC_ERR_GENERIC;
-  }
-  json_object *json_obj_port_conn_prop = NULL;
-  ret_val = restjson::JsonBuildParse::parse(json_obj_node_conn_prop,
-                                            "vtn-port",
-                                            0,
-                                            json_obj_port_conn_prop);
-  if ((restjson::REST_OP_SUCCESS != ret_val) ||
-      (json_object_is_type(json_obj_port_conn_prop, json_type_null))) {
-    json_object_put(jobj);
-    pfc_log_error("Parsing Error json_obj_node_conn_prop is null");
-    return UNC_DRV_RC_ERR_GENERIC;
-  }
-  if (json_object_is_type(json_obj_port_conn_prop, json_type_array)) {
-    array_length = restjson::JsonBuildParse::get_array_length(
-        json_obj_port_conn_prop);
-    pfc_log_error("jobj array lenth:%d", array_length);
-  }
-  if (0 == array_length) {
-    pfc_log_debug("No nodes port present");
-    json_object_put(jobj);
-    return UNC_RC_SUCCESS;
-  }
-  pfc_log_info("vtn-port PROPERTY :%s",
-               restjson::JsonBuildParse::get_json_string
-               (json_obj_port_conn_prop));
-  for (uint32_t arr_idx = 0; arr_idx < array_length; arr_idx++) {
-#endif
-    std::list<vtn_port>::iterator it;
-    for (it = port_detail.begin(); it != port_detail.end(); it++) {
-      UncRespCode ret_val = fill_config_node_vector(ctr_ptr,
-          it->cost,
-          it->id,
-          it->name,
-          it->enabled,
-          cfgnode_vector);
-    if (UNC_RC_SUCCESS != ret_val) {
-      pfc_log_error("Error return from parse_node_append_vector failure");
-      return ret_val;
-    }
-  }
-  return UNC_RC_SUCCESS;
-}
-
-
 UncRespCode OdcPort::read_cmd(unc::driver::controller *ctr_ptr,
                               unc::vtnreadutil::driver_read_util* read_util) {
   ODC_FUNC_TRACE;
@@ -1336,5 +1300,70 @@ UncRespCode OdcPort::parse_port_stat_response(
   return UNC_RC_SUCCESS;
 }
 
+// Constructor
+OdcPortStreamHandler::OdcPortStreamHandler(
+    std::vector<OdcPortRecord_t> &port_records)
+: unc::restjson::JsonStreamRecordHandler(
+    std::vector<std::string>(VTN_PORT_STREAM_PATH,
+                             VTN_PORT_STREAM_PATH +
+                             PFC_ARRAY_CAPACITY(VTN_PORT_STREAM_PATH))),
+  port_records_(port_records),
+  hash_sum_(0) {
+}
+
+// Stores one vtn-port and adds its hash to the fingerprint
+unc::restjson::rest_resp_code_t OdcPortStreamHandler::record(
+    const unc::restjson::JsonStreamRecord_t &record) {
+  ODC_FUNC_TRACE;
+  // enabled is mandatory in port.rest as well
+  const char *mandatory[] = { "cost", "enabled", "id", "name" };
+  std::string values[PFC_ARRAY_CAPACITY(mandatory)];
+  for (uint32_t i = 0; i < PFC_ARRAY_CAPACITY(mandatory); i++) {
+    unc::restjson::JsonStreamRecord_t::const_iterator it =
+        record.find(mandatory[i]);
+    if ((it == record.end()) || (it->second.empty())) {
+      pfc_log_error(" Error while parsing %s", mandatory[i]);
+      return unc::restjson::REST_OP_FAILURE;
+    }
+    values[i] = it->second;
+  }
+  // enabled is a json boolean
+  int enabled;
+  if (values[1] == "true") {
+    enabled = 1;
+  } else if (values[1] == "false") {
+    enabled = 0;
+  } else {
+    enabled = atoi(values[1].c_str());
+  }
+  OdcPortRecord_t port_record;
+  port_record.cost = values[0];
+  port_record.id = values[2];
+  port_record.name = values[3];
+  port_record.enabled = enabled;
+  port_records_.push_back(port_record);
+
+  // 64-bit FNV-1a over the attributes which make up the port config node,
+  // each followed by a separator so that "ab","c" and "a","bc" differ
+  uint64_t hash = ODC_FNV64_OFFSET_BASIS;
+  const std::string *attrs[] = { &port_record.id, &port_record.name };
+  for (uint32_t i = 0; i < PFC_ARRAY_CAPACITY(attrs); i++) {
+    const std::string &attr = *attrs[i];
+    for (std::string::size_type c = 0; c <= attr.size(); c++) {
+      hash ^= (c < attr.size()) ? static_cast<uint8_t>(attr[c]) : 0;
+      hash *= ODC_FNV64_PRIME;
+    }
+  }
+  hash ^= static_cast<uint32_t>(enabled);
+  hash *= ODC_FNV64_PRIME;
+  hash_sum_ += hash;
+  return unc::restjson::REST_OP_SUCCESS;
+}
+
+// Sum of the port hashes with the number of ports mixed in
+uint64_t OdcPortStreamHandler::get_fingerprint() const {
+  return hash_sum_ ^ (static_cast<uint64_t>(port_records_.size()) *
+                      ODC_FNV64_PRIME);
+}
 }  // namespace odcdriver
 }  // namespace unc
@@ -126,6 +126,34 @@ UncRespCode odl_http_request::handle_request(
   return UNC_RC_SUCCESS;
 }
 
+UncRespCode odl_http_request::handle_stream_request(
+    unc::driver::controller *ctr_ptr,
+    const std::string &url,
+    unc::restjson::JsonStreamParser *stream_parser,
+    unc::restjson::ConfFileValues_t conf_values) {
+  ODC_FUNC_TRACE;
+  PFC_VERIFY(stream_parser != NULL);
+  unc::restjson::RestUtil rest_util_obj(ctr_ptr->get_host_address(),
+                                        ctr_ptr->get_user_name(),
+                                        ctr_ptr->get_pass_word());
+  pfc_log_debug("the URL is %s", url.c_str());
+
+  unc::restjson::HttpResponse_t* response =
+      rest_util_obj.send_http_request(url, restjson::HTTP_METHOD_GET, NULL,
+                                      conf_values, stream_parser);
+  if (NULL == response) {
+    pfc_log_error("Error Occured while getting httpresponse");
+    return UNC_DRV_RC_ERR_GENERIC;
+  }
+  int resp_code = response->code;
+  if (HTTP_200_RESP_OK != resp_code) {
+    pfc_log_error("Response code is not OK , resp : %d", resp_code);
+    return UNC_DRV_RC_ERR_GENERIC;
+  }
+  pfc_log_debug("Streamed %" PFC_PFMT_u64 " bytes of response",
+                stream_parser->get_bytes_parsed());
+  return UNC_RC_SUCCESS;
+}
 
 }  //  namespace odcdriver
 }  //  namespace unc
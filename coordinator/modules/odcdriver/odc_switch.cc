@@ -30,35 +30,33 @@ UncRespCode OdcSwitch::fetch_config(unc::driver::controller *ctr_ptr,
   PFC_VERIFY(ctr_ptr != NULL);
   std::vector<unc::vtndrvcache::ConfigNode *> cfgnode_vector;
 
-  vtn_nodes_request *req_obj = new vtn_nodes_request(ctr_ptr);
-  std::string url =  req_obj->get_url();
+  vtn_nodes_request req_obj(ctr_ptr);
+  std::string url =  req_obj.get_url();
   pfc_log_info("URL:%s",url.c_str());
-  vtn_nodes_parser *parse_obj = new vtn_nodes_parser();
-  UncRespCode ret_val = req_obj->get_response(parse_obj);
+  // Switches are converted while the response is received, so a large
+  // topology is never held as a whole json object tree
+  OdcSwitchStreamHandler handler(this, ctr_ptr, cfgnode_vector);
+  unc::restjson::JsonStreamParser stream_parser(&handler);
+  unc::odcdriver::OdcController *odc_ctr =
+      reinterpret_cast<unc::odcdriver::OdcController *>(ctr_ptr);
+  odl_http_request odl_req;
+  UncRespCode ret_val = odl_req.handle_stream_request(
+      ctr_ptr, url, &stream_parser, odc_ctr->get_conf_value());
+  if ((UNC_RC_SUCCESS == ret_val) && (0 == handler.get_matched_keys())) {
+    pfc_log_error("vtn-nodes not present in response");
+    ret_val = UNC_DRV_RC_ERR_GENERIC;
+  }
   if (UNC_RC_SUCCESS != ret_val) {
     pfc_log_error("Get response Error");
-    delete req_obj;
-    delete parse_obj;
-    return UNC_DRV_RC_ERR_GENERIC;
-}
-  ret_val = parse_obj->set_vtn_node(parse_obj->jobj);
-  if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("set-node error");
-    delete req_obj;
-    delete parse_obj;
+    std::vector<unc::vtndrvcache::ConfigNode *>::iterator it;
+    for (it = cfgnode_vector.begin(); it != cfgnode_vector.end(); ++it) {
+      delete_config_node(*it);
+    }
     return UNC_DRV_RC_ERR_GENERIC;
   }
-  ret_val =  parse_node_response(ctr_ptr, parse_obj->vtn_node_, cfgnode_vector);
-  if (UNC_RC_SUCCESS != ret_val) {
-    pfc_log_error("Error occured while parsing");
-    delete req_obj;
-    delete parse_obj;
-    return ret_val;
-  }
+  pfc_log_debug("%u switches in response", handler.get_record_count());
   ret_val = compare_with_cache(ctr_ptr, cfgnode_vector, cache_empty);
   pfc_log_debug("Response from compare with cache is %d", ret_val);
-  delete req_obj;
-  delete parse_obj;
   return ret_val;
 }
 
@@ -383,6 +381,11 @@ UncRespCode OdcSwitch::delete_switch(
       notify_physical(unc::driver::VTN_SWITCH_DELETE, key_switch,
                       val_switch, NULL);
 
+      // The ports go with the switch, a switch coming back must not
+      // match their fingerprint
+      reinterpret_cast<unc::odcdriver::OdcController *>(ctr)->
+          clear_port_fingerprint(reinterpret_cast<const char*>(
+              key_switch->switch_id));
       // Delete from cache
       UncRespCode  ret_val =
           ctr->physical_port_cache->delete_physical_attribute_node(cfg_node);
@@ -497,24 +500,36 @@ pfc_bool_t OdcSwitch::is_switch_modified(val_switch_st_t *val_switch_ctr,
   }
 }
 
-// parsing function for converting controller response to driver format
-UncRespCode OdcSwitch::parse_node_response(
+// Constructor
+OdcSwitchStreamHandler::OdcSwitchStreamHandler(
+    OdcSwitch *odc_switch,
     unc::driver::controller *ctr_ptr,
-    std::list<vtn_node> &node_detail,
-    std::vector< unc::vtndrvcache::ConfigNode *> &cfgnode_vector) {
+    std::vector<unc::vtndrvcache::ConfigNode *> &cfgnode_vector)
+: unc::restjson::JsonStreamRecordHandler(
+    std::vector<std::string>(VTN_NODES_STREAM_PATH,
+                             VTN_NODES_STREAM_PATH +
+                             PFC_ARRAY_CAPACITY(VTN_NODES_STREAM_PATH))),
+  odc_switch_(odc_switch),
+  ctr_ptr_(ctr_ptr),
+  cfgnode_vector_(cfgnode_vector) {
+}
+
+// Converts one vtn-node to a config node
+unc::restjson::rest_resp_code_t OdcSwitchStreamHandler::record(
+    const unc::restjson::JsonStreamRecord_t &record) {
   ODC_FUNC_TRACE;
-  std::list<vtn_node>::iterator it;
-  for (it = node_detail.begin(); it != node_detail.end(); it++) {
-    std::string id = it->id;
-    UncRespCode ret_val = fill_config_node_vector(
-      ctr_ptr, id, cfgnode_vector);
-
-    if (UNC_RC_SUCCESS != ret_val) {
-      pfc_log_error("Error return from fill map failure");
-      return ret_val;
-    }
+  std::string id = "";
+  unc::restjson::JsonStreamRecord_t::const_iterator it = record.find("id");
+  if (it != record.end()) {
+    id = it->second;
   }
-  return UNC_RC_SUCCESS;
+  UncRespCode ret_val = odc_switch_->fill_config_node_vector(
+      ctr_ptr_, id, cfgnode_vector_);
+  if (UNC_RC_SUCCESS != ret_val) {
+    pfc_log_error("Error return from fill map failure");
+    return unc::restjson::REST_OP_FAILURE;
+  }
+  return unc::restjson::REST_OP_SUCCESS;
 }
 }  // namespace odcdriver
 }  // namespace unc
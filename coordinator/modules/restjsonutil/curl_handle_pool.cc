@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <string.h>
+#include <curl_handle_pool.hh>
+#include <rest_common_defs.hh>
+#include <sstream>
+
+namespace unc {
+namespace restjson {
+
+// Returns the process wide pool; it lives until the process exits
+CurlHandlePool* CurlHandlePool::get_instance() {
+  static CurlHandlePool *pool_instance = new CurlHandlePool();
+  return pool_instance;
+}
+
+// Destructor
+CurlHandlePool::~CurlHandlePool() {
+  clear();
+}
+
+// Builds the pool key from ip address and port of the controller
+std::string CurlHandlePool::make_key(const std::string &host,
+                                     const uint32_t port) {
+  std::ostringstream pool_key;
+  pool_key << host << COLON << port;
+  return pool_key.str();
+}
+
+// Gets an idle handle of the pool or creates a new one
+CURL* CurlHandlePool::get_handle(const std::string &pool_key) {
+  ODC_FUNC_TRACE;
+  pfc::core::ScopedMutex m(pool_mutex_);
+  HandleList_t &handles = pools_[pool_key];
+  if (!handles.idle_list.empty()) {
+    CURL *handle = handles.idle_list.front();
+    handles.idle_list.pop_front();
+    handles.stats.reused++;
+    handles.stats.idle = handles.idle_list.size();
+    pfc_log_debug("Reusing curl handle of %s, idle %u", pool_key.c_str(),
+                  handles.stats.idle);
+    return handle;
+  }
+
+  CURL *handle = curl_easy_init();
+  if (NULL == handle) {
+    pfc_log_error("curl_easy_init failed for %s", pool_key.c_str());
+    return NULL;
+  }
+  handles.stats.created++;
+  pfc_log_debug("New curl handle for %s", pool_key.c_str());
+  return handle;
+}
+
+// Puts the handle back to the pool or cleans it up
+void CurlHandlePool::release_handle(const std::string &pool_key,
+                                    CURL *handle,
+                                    const uint32_t max_idle,
+                                    const pfc_bool_t reusable) {
+  ODC_FUNC_TRACE;
+  if (NULL == handle) {
+    return;
+  }
+  pfc::core::ScopedMutex m(pool_mutex_);
+  HandleList_t &handles = pools_[pool_key];
+  if ((reusable != PFC_TRUE) || (handles.idle_list.size() >= max_idle)) {
+    handles.stats.discarded++;
+    curl_easy_cleanup(handle);
+    return;
+  }
+  // Reset the options of the previous request; the live connection and
+  // the DNS cache stay with the handle
+  curl_easy_reset(handle);
+  handles.idle_list.push_back(handle);
+  handles.stats.released++;
+  handles.stats.idle = handles.idle_list.size();
+}
+
+// Cleans up the idle handles of all pools of the host
+void CurlHandlePool::flush(const std::string &host) {
+  ODC_FUNC_TRACE;
+  std::string prefix = host;
+  prefix.append(COLON);
+  pfc::core::ScopedMutex m(pool_mutex_);
+  std::map<std::string, HandleList_t>::iterator it = pools_.begin();
+  for (; it != pools_.end(); ++it) {
+    if (it->first.compare(0, prefix.length(), prefix) == 0) {
+      pfc_log_debug("Flushing %" PFC_PFMT_SIZE_T " idle handles of %s",
+                    it->second.idle_list.size(), it->first.c_str());
+      cleanup_idle(&it->second);
+    }
+  }
+}
+
+// Cleans up the idle handles of all pools
+void CurlHandlePool::clear() {
+  ODC_FUNC_TRACE;
+  pfc::core::ScopedMutex m(pool_mutex_);
+  std::map<std::string, HandleList_t>::iterator it = pools_.begin();
+  for (; it != pools_.end(); ++it) {
+    cleanup_idle(&it->second);
+  }
+}
+
+// Gets the statistics of a pool
+pfc_bool_t CurlHandlePool::get_stats(const std::string &pool_key,
+                                     CurlHandlePoolStats_t *stats) {
+  PFC_ASSERT(NULL != stats);
+  pfc::core::ScopedMutex m(pool_mutex_);
+  std::map<std::string, HandleList_t>::iterator it = pools_.find(pool_key);
+  if (it == pools_.end()) {
+    return PFC_FALSE;
+  }
+  *stats = it->second.stats;
+  return PFC_TRUE;
+}
+
+// Logs the statistics of all pools
+void CurlHandlePool::log_stats() {
+  pfc::core::ScopedMutex m(pool_mutex_);
+  std::map<std::string, HandleList_t>::iterator it = pools_.begin();
+  for (; it != pools_.end(); ++it) {
+    const CurlHandlePoolStats_t &stats = it->second.stats;
+    pfc_log_info("curl handle pool %s: created %" PFC_PFMT_u64
+                 ", reused %" PFC_PFMT_u64 ", released %" PFC_PFMT_u64
+                 ", discarded %" PFC_PFMT_u64 ", idle %u",
+                 it->first.c_str(), stats.created, stats.reused,
+                 stats.released, stats.discarded, stats.idle);
+  }
+}
+
+void CurlHandlePool::cleanup_idle(HandleList_t *handles) {
+  std::list<CURL*>::iterator it = handles->idle_list.begin();
+  for (; it != handles->idle_list.end(); ++it) {
+    curl_easy_cleanup(*it);
+  }
+  handles->stats.discarded += handles->idle_list.size();
+  handles->idle_list.clear();
+  handles->stats.idle = 0;
+}
+}  // namespace restjson
+}  // namespace unc
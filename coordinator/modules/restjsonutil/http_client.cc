@@ -16,7 +16,10 @@ namespace restjson {
 HttpClient::HttpClient()
 : handle_(NULL),
   response_(NULL),
-  slist_(NULL) {
+  slist_(NULL),
+  pool_size_(0),
+  handle_reusable_(PFC_TRUE),
+  stream_parser_(NULL) {
   ODC_FUNC_TRACE;
 }
 
@@ -30,7 +33,26 @@ void HttpClient::init() {
 
   handle_ = curl_easy_init();
   PFC_ASSERT(NULL != handle_);
+  init_response();
+}
+
+// Init Method taking the Curl handle from the pool of the controller
+void HttpClient::init(const std::string &pool_key, const uint32_t pool_size) {
+  ODC_FUNC_TRACE;
+  if (0 == pool_size) {
+    init();
+    return;
+  }
+  pool_key_ = pool_key;
+  pool_size_ = pool_size;
+  handle_reusable_ = PFC_TRUE;
+  handle_ = CurlHandlePool::get_instance()->get_handle(pool_key_);
+  PFC_ASSERT(NULL != handle_);
+  init_response();
+}
 
+// Allocates the response structure filled by write_call_back
+void HttpClient::init_response() {
   response_ = new HttpResponse_t;
   PFC_ASSERT(NULL != response_);
 
@@ -46,7 +68,13 @@ void HttpClient::init() {
 void HttpClient::fini() {
   ODC_FUNC_TRACE;
   if (NULL != handle_) {
-    curl_easy_cleanup(handle_);
+    if (0 != pool_size_) {
+      CurlHandlePool::get_instance()->release_handle(pool_key_, handle_,
+                                                     pool_size_,
+                                                     handle_reusable_);
+    } else {
+      curl_easy_cleanup(handle_);
+    }
     handle_ = NULL;
   }
   if (NULL != slist_) {
@@ -186,6 +214,12 @@ rest_resp_code_t HttpClient::set_request_body(const char* request_body) {
   return REST_OP_SUCCESS;
 }
 
+// Sets the parser fed with the body of a successful response
+void HttpClient::set_stream_parser(JsonStreamParser *stream_parser) {
+  ODC_FUNC_TRACE;
+  stream_parser_ = stream_parser;
+}
+
 // Sets Common Values to the CURL hanlde, Post the handle and writes the reponse
 rest_resp_code_t HttpClient::send_request() {
   ODC_FUNC_TRACE;
@@ -286,6 +320,18 @@ rest_resp_code_t HttpClient::set_opt_common() {
                   curl_ret_code);
     return REST_OP_FAILURE;
   }
+#if defined(LIBCURL_VERSION_NUM) && (LIBCURL_VERSION_NUM >= 0x071900)
+  if (0 != pool_size_) {
+    // Probe idle pooled connections so that dead ones are detected
+    curl_ret_code = curl_easy_setopt(handle_, CURLOPT_TCP_KEEPALIVE,
+                                     CURLOPT_ENABLE);
+    if (CURLE_OK != curl_ret_code) {
+      pfc_log_error("Set tcp keepalive failed with curl error code %d",
+                    curl_ret_code);
+      return REST_OP_FAILURE;
+    }
+  }
+#endif
   return REST_OP_SUCCESS;
 }
 
@@ -294,8 +340,24 @@ rest_resp_code_t HttpClient::set_opt_write_data() {
   ODC_FUNC_TRACE;
   PFC_ASSERT(handle_ != NULL);
 
-  CURLcode curl_ret_code = curl_easy_setopt(handle_, CURLOPT_WRITEFUNCTION,
-                                            write_call_back);
+  CURLcode curl_ret_code = CURLE_OK;
+  if (NULL != stream_parser_) {
+    curl_ret_code = curl_easy_setopt(handle_, CURLOPT_WRITEFUNCTION,
+                                     stream_call_back);
+    if (CURLE_OK == curl_ret_code) {
+      curl_ret_code = curl_easy_setopt(handle_, CURLOPT_WRITEDATA,
+                                       reinterpret_cast<void *>(this));
+    }
+    if (CURLE_OK != curl_ret_code) {
+      pfc_log_error(" Set stream write failed with curl error code %d",
+                    curl_ret_code);
+      return REST_OP_FAILURE;
+    }
+    return REST_OP_SUCCESS;
+  }
+
+  curl_ret_code = curl_easy_setopt(handle_, CURLOPT_WRITEFUNCTION,
+                                   write_call_back);
   if (CURLE_OK != curl_ret_code) {
     pfc_log_error(" Set write function failed with curl error code %d",
                   curl_ret_code);
@@ -322,6 +384,8 @@ rest_resp_code_t HttpClient::perform_http_req() {
 
   if (CURLE_OK != curl_ret_code) {
     pfc_log_error("%d Perform failed with error code", curl_ret_code);
+    // Do not put a handle with a broken transfer back to the pool
+    handle_reusable_ = PFC_FALSE;
     return REST_OP_FAILURE;
   }
 
@@ -333,6 +397,15 @@ rest_resp_code_t HttpClient::perform_http_req() {
                       curl_ret_code);
     return REST_OP_FAILURE;
   }
+
+  // The body of a successful response went to the stream parser
+  if ((NULL != stream_parser_) && (HTTP_2XX_RESP_CLASS ==
+                                   response_->code / HTTP_RESP_CLASS_DIV)) {
+    if (REST_OP_SUCCESS != stream_parser_->finish()) {
+      pfc_log_error("Streamed response body is incomplete");
+      return REST_OP_FAILURE;
+    }
+  }
   return REST_OP_SUCCESS;
 }
 
@@ -395,5 +468,38 @@ size_t HttpClient::write_call_back(void *ptr, size_t size, size_t nmemb,
   mem->size += realsize;
   return realsize;
 }
+
+// Call back to feed the response from the CURL to the stream parser;
+// bodies of error responses are collected as usual for the caller
+size_t HttpClient::stream_call_back(void *ptr, size_t size, size_t nmemb,
+                                    void *data) {
+  ODC_FUNC_TRACE;
+  HttpClient *client = reinterpret_cast<HttpClient*>(data);
+
+  if ((NULL == ptr) || (NULL == client) || (NULL == client->response_)) {
+    pfc_log_error("stream response data or client is NULL");
+    return SIZE_NULL;
+  }
+
+  // Headers are complete when the first byte of the body arrives
+  long code = 0;
+  if (CURLE_OK != curl_easy_getinfo(client->handle_,
+                                    CURLINFO_RESPONSE_CODE, &code)) {
+    pfc_log_error("get response code failed in stream call back");
+    return SIZE_NULL;
+  }
+  if (HTTP_2XX_RESP_CLASS != code / HTTP_RESP_CLASS_DIV) {
+    return write_call_back(ptr, size, nmemb, client->response_->write_data);
+  }
+
+  size_t realsize = size * nmemb;
+  if (REST_OP_SUCCESS !=
+      client->stream_parser_->feed(reinterpret_cast<const char*>(ptr),
+                                   realsize)) {
+    pfc_log_error("stream parse of response failed");
+    return SIZE_NULL;
+  }
+  return realsize;
+}
 }  // namespace restjson
 }  // namespace unc
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#ifndef RESTJSON_CURL_HANDLE_POOL_H_
+#define RESTJSON_CURL_HANDLE_POOL_H_
+
+#include <curl/curl.h>
+#include <pfc/debug.h>
+#include <pfc/log.h>
+#include <pfcxx/synch.hh>
+#include <uncxx/odc_log.hh>
+#include <list>
+#include <map>
+#include <string>
+
+namespace unc {
+namespace restjson {
+
+typedef struct {
+  uint64_t created;      // handles created by curl_easy_init
+  uint64_t reused;       // handles taken from the idle list
+  uint64_t released;     // handles put back to the idle list
+  uint64_t discarded;    // handles cleaned up instead of being put back
+  uint32_t idle;         // handles currently in the idle list
+} CurlHandlePoolStats_t;
+
+/*
+ * Keeps idle curl easy handles per controller so that the live connection
+ * cached in a handle is reused by the next request to the same controller
+ * instead of setting up a new TCP connection for every REST call.
+ */
+class CurlHandlePool {
+ public:
+  /**
+   * @brief  - Returns the process wide pool
+   */
+  static CurlHandlePool* get_instance();
+
+  /**
+   * @brief      - Builds the pool key of a controller
+   * @param[in]  - host - ip address of the controller
+   * @param[in]  - port - REST port of the controller
+   * @retval     - std::string - pool key
+   */
+  static std::string make_key(const std::string &host, const uint32_t port);
+
+  /**
+   * @brief      - Gets an idle handle of the pool or creates a new one
+   * @param[in]  - pool_key - key built by make_key
+   * @retval     - CURL* - handle with default options, NULL on failure
+   */
+  CURL* get_handle(const std::string &pool_key);
+
+  /**
+   * @brief      - Puts the handle back to the pool. The handle is cleaned
+   *               up if it is not reusable or the pool is full.
+   * @param[in]  - pool_key - key given to get_handle
+   * @param[in]  - handle - handle given by get_handle
+   * @param[in]  - max_idle - maximum number of idle handles of the pool
+   * @param[in]  - reusable - PFC_FALSE if the last transfer failed
+   */
+  void release_handle(const std::string &pool_key, CURL *handle,
+                      const uint32_t max_idle, const pfc_bool_t reusable);
+
+  /**
+   * @brief      - Cleans up the idle handles of all pools of the host
+   * @param[in]  - host - ip address of the controller
+   */
+  void flush(const std::string &host);
+
+  /**
+   * @brief      - Cleans up the idle handles of all pools
+   */
+  void clear();
+
+  /**
+   * @brief      - Gets the statistics of a pool
+   * @param[in]  - pool_key - key built by make_key
+   * @param[out] - stats - statistics of the pool
+   * @retval     - PFC_TRUE if the pool exists
+   */
+  pfc_bool_t get_stats(const std::string &pool_key,
+                       CurlHandlePoolStats_t *stats);
+
+  /**
+   * @brief      - Logs the statistics of all pools
+   */
+  void log_stats();
+
+ private:
+  typedef struct {
+    std::list<CURL*> idle_list;
+    CurlHandlePoolStats_t stats;
+  } HandleList_t;
+
+  CurlHandlePool() {}
+  ~CurlHandlePool();
+
+  void cleanup_idle(HandleList_t *handles);
+
+  std::map<std::string, HandleList_t> pools_;
+  pfc::core::Mutex pool_mutex_;
+};
+}  // namespace restjson
+}  // namespace unc
+#endif  // RESTJSON_CURL_HANDLE_POOL_H_
@@ -14,7 +14,9 @@
 #include <pfc/debug.h>
 #include <pfc/log.h>
 #include <rest_common_defs.hh>
+#include <curl_handle_pool.hh>
 #include <json_build_parse.hh>
+#include <json_stream_parser.hh>
 #include <uncxx/odc_log.hh>
 #include <string>
 
@@ -40,6 +42,16 @@ class HttpClient {
    */
   void init();
 
+  /**
+   * @brief      - Initialises curl handle taken from the pool of the
+   *               controller, so that its connection is kept alive
+   * @param[in]  - pool_key - key built by CurlHandlePool::make_key
+   * @param[in]  - pool_size - maximum idle handles kept for the controller,
+   *               0 disables the pool
+   * @retval     - None
+   */
+  void init(const std::string &pool_key, const uint32_t pool_size);
+
   /**
    * @brief  - Fini Method to release handle
    * @retval - None
@@ -96,6 +108,15 @@ class HttpClient {
    */
   rest_resp_code_t set_request_body(const char* req_body);
 
+  /**
+   * @brief      - Method to parse a successful response body while it is
+   *               received instead of collecting it in the response
+   *               structure. Bodies of other responses are still collected.
+   * @param[in]  - stream_parser - parser fed with the body, not owned
+   * @retval     - None
+   */
+  void set_stream_parser(JsonStreamParser *stream_parser);
+
   /**
    * @brief - Gets the response from the controller
    * return - HttpResponse_t structure which contains code and response body
@@ -116,6 +137,12 @@ class HttpClient {
    */
   rest_resp_code_t set_opt_common();
 
+  /**
+   * @brief  - Allocates the response structure
+   * @retval - None
+   */
+  void init_response();
+
   /**
    * @brief  - Method to send http Request
    * @retval - rest_resp_code_t - 0 for REST_OP_SUCCESS, 1 for REST_OP_FAILURE
@@ -139,10 +166,27 @@ class HttpClient {
   static size_t write_call_back(void* ptr, size_t size, size_t nmemb,
                                 void* data);
 
+  /**
+   * @brief      - Callback Method used to feed the response data of a
+   *               successful response to the stream parser
+   * @param[in]  - ptr, - void pointer which contains the response from
+   * controller
+   * @param[in]  - size*nmemb -  values give the size of data pointed by ptr
+   * @param[in]  - data - HttpClient which set the callback
+   * @retval     - size_t - number of bytes used, SIZE_NULL aborts the
+   *               transfer
+   */
+  static size_t stream_call_back(void* ptr, size_t size, size_t nmemb,
+                                 void* data);
+
  private:
   CURL* handle_;
   HttpResponse_t *response_;
   curl_slist *slist_;
+  std::string pool_key_;
+  uint32_t pool_size_;
+  pfc_bool_t handle_reusable_;
+  JsonStreamParser *stream_parser_;
 };
 }  // namespace restjson
 }  // namespace unc
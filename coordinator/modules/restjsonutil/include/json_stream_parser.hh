@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#ifndef RESTJSON_JSON_STREAM_PARSER_H_
+#define RESTJSON_JSON_STREAM_PARSER_H_
+
+#include <pfc/log.h>
+#include <rest_common_defs.hh>
+#include <uncxx/odc_log.hh>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace unc {
+namespace restjson {
+
+// Longest string, number or literal accepted by JsonStreamParser
+const size_t JSON_STREAM_MAX_TOKEN_LEN = 65536;
+// Deepest nesting of objects and arrays accepted by JsonStreamParser
+const uint32_t JSON_STREAM_MAX_DEPTH = 64;
+
+typedef enum {
+  JSON_STREAM_STRING = 0,
+  JSON_STREAM_NUMBER,
+  JSON_STREAM_BOOLEAN,
+  JSON_STREAM_NULL
+} JsonStreamValueType;
+
+/*
+ * Receives the events of JsonStreamParser in document order. Returning
+ * REST_OP_FAILURE from any event stops the parse.
+ */
+class JsonStreamHandler {
+ public:
+  virtual ~JsonStreamHandler() {}
+
+  virtual rest_resp_code_t start_object() = 0;
+  virtual rest_resp_code_t end_object() = 0;
+  virtual rest_resp_code_t start_array() = 0;
+  virtual rest_resp_code_t end_array() = 0;
+
+  /**
+   * @brief      - Called for the key of each member of an object
+   * @param[in]  - key - unescaped key
+   */
+  virtual rest_resp_code_t object_key(const std::string &key) = 0;
+
+  /**
+   * @brief      - Called for each string, number, boolean and null value
+   * @param[in]  - value - unescaped string, or the text of the number or
+   *               literal as it appears in the document
+   * @param[in]  - type - type of the value
+   */
+  virtual rest_resp_code_t scalar_value(const std::string &value,
+                                        JsonStreamValueType type) = 0;
+};
+
+/*
+ * Incremental (SAX style) JSON parser. The document is given in arbitrary
+ * chunks, e.g. straight from the curl write callback, and reported to a
+ * JsonStreamHandler without building a json-c object tree. Memory use is
+ * bounded by the longest token and the nesting depth, not by the size of
+ * the document.
+ */
+class JsonStreamParser {
+ public:
+  /**
+   * @brief      - Constructor
+   * @param[in]  - handler - receives the parse events, not owned
+   */
+  explicit JsonStreamParser(JsonStreamHandler *handler);
+
+  /**
+   * @brief      - Parses the next chunk of the document
+   * @param[in]  - data - chunk, need not end at a token boundary
+   * @param[in]  - len - length of the chunk
+   * @retval     - REST_OP_SUCCESS/REST_OP_FAILURE on a syntax error or
+   *               when the handler stopped the parse
+   */
+  rest_resp_code_t feed(const char *data, size_t len);
+
+  /**
+   * @brief      - Completes the parse after the last chunk
+   * @retval     - REST_OP_SUCCESS if exactly one complete document was fed
+   */
+  rest_resp_code_t finish();
+
+  /**
+   * @brief      - Resets the parser for a new document
+   */
+  void reset();
+
+  /**
+   * @brief      - Gets the number of bytes fed so far
+   */
+  uint64_t get_bytes_parsed() const {
+    return bytes_parsed_;
+  }
+
+ private:
+  typedef enum {
+    EXPECT_VALUE = 0,
+    EXPECT_VALUE_OR_END,
+    EXPECT_KEY,
+    EXPECT_KEY_OR_END,
+    EXPECT_COLON,
+    EXPECT_COMMA_OR_END,
+    EXPECT_NOTHING
+  } ParseState;
+
+  typedef enum {
+    LEX_NONE = 0,
+    LEX_STRING,
+    LEX_ESCAPE,
+    LEX_UNICODE,
+    LEX_LITERAL
+  } LexState;
+
+  rest_resp_code_t parse_char(char c);
+  rest_resp_code_t parse_structural(char c);
+  rest_resp_code_t parse_unicode_digit(char c);
+  rest_resp_code_t open_container(char type);
+  rest_resp_code_t close_container(char type);
+  rest_resp_code_t complete_string();
+  rest_resp_code_t complete_literal();
+  rest_resp_code_t append_token(char c);
+  void append_utf8(uint32_t code_point);
+  void value_done();
+  rest_resp_code_t fail(const char *reason);
+
+  JsonStreamHandler *handler_;
+  ParseState state_;
+  LexState lex_;
+  std::vector<char> stack_;
+  std::string token_;
+  pfc_bool_t token_is_key_;
+  uint32_t unicode_;
+  uint32_t unicode_digits_;
+  uint32_t high_surrogate_;
+  pfc_bool_t failed_;
+  uint64_t bytes_parsed_;
+};
+
+typedef std::map<std::string, std::string> JsonStreamRecord_t;
+
+/*
+ * Handler which reports the objects of one array of the document as flat
+ * records. The array is located by the keys leading to it, e.g.
+ * "vtn-nodes", "vtn-node" for {"vtn-nodes": {"vtn-node": [{...}, ...]}};
+ * arrays on the way are entered element by element. Scalar members of each
+ * element are collected as strings, nested objects and arrays are skipped.
+ */
+class JsonStreamRecordHandler : public JsonStreamHandler {
+ public:
+  /**
+   * @brief      - Constructor
+   * @param[in]  - path - keys leading to the array of records
+   */
+  explicit JsonStreamRecordHandler(const std::vector<std::string> &path);
+  virtual ~JsonStreamRecordHandler() {}
+
+  /**
+   * @brief      - Called for each element of the array
+   * @param[in]  - record - scalar members of the element by key
+   * @retval     - REST_OP_FAILURE stops the parse
+   */
+  virtual rest_resp_code_t record(const JsonStreamRecord_t &record) = 0;
+
+  /**
+   * @brief      - Checks if the array of records was found in the document
+   */
+  pfc_bool_t is_path_found() const {
+    return path_found_;
+  }
+
+  /**
+   * @brief      - Gets the number of leading keys of the path found in the
+   *               document with an object or array value
+   */
+  uint32_t get_matched_keys() const {
+    return matched_keys_;
+  }
+
+  /**
+   * @brief      - Gets the number of objects in the arrays on the way to
+   *               the array of records
+   */
+  uint32_t get_path_element_count() const {
+    return path_element_count_;
+  }
+
+  /**
+   * @brief      - Gets the number of records reported
+   */
+  uint32_t get_record_count() const {
+    return record_count_;
+  }
+
+  rest_resp_code_t start_object();
+  rest_resp_code_t end_object();
+  rest_resp_code_t start_array();
+  rest_resp_code_t end_array();
+  rest_resp_code_t object_key(const std::string &key);
+  rest_resp_code_t scalar_value(const std::string &value,
+                                JsonStreamValueType type);
+
+ private:
+  void open_container(char type);
+  void close_container();
+
+  const std::vector<std::string> path_;
+  std::vector<char> type_stack_;
+  // Number of leading entries of path_ matched by the named containers
+  std::vector<uint32_t> matched_stack_;
+  std::string pending_key_;
+  JsonStreamRecord_t fields_;
+  uint32_t record_depth_;
+  pfc_bool_t path_found_;
+  uint32_t matched_keys_;
+  uint32_t path_element_count_;
+  uint32_t record_count_;
+};
+}  // namespace restjson
+}  // namespace unc
+#endif  // RESTJSON_JSON_STREAM_PARSER_H_
@@ -25,9 +25,12 @@ class RestClient {
    * @brief      - Constructor get ipaddress in string format
    *               as input
    *               Allocates memory for httpclient object
+   * @param[in]  - pool_size - maximum idle connections kept for the
+   *               controller, 0 opens a new connection for every request
    */
   RestClient(const std::string &ipaddress, const std::string url,
-                      const uint32_t port, const HttpMethod method);
+                      const uint32_t port, const HttpMethod method,
+                      const uint32_t pool_size = 0);
 
   /**
    * @brief      - Destructor
@@ -46,6 +49,13 @@ class RestClient {
   HttpResponse_t* send_http_request(std::string username, std::string password,
                               uint32_t connect_timeout, uint32_t req_time_out,
                               const char* request_body);
+  /**
+   * @brief      - Parses the body of a successful response while it is
+   *               received, see HttpClient::set_stream_parser
+   * @param[in]  - stream_parser - parser fed with the body, not owned
+   */
+  void set_stream_parser(JsonStreamParser *stream_parser);
+
   /**
    * @brief - clears the http response memory allocated
    */
@@ -24,6 +24,9 @@ const size_t SIZE_NULL = 0;
 const int ZERO_ARRAY_LENGTH = 0;
 const int CURLOPT_ENABLE = 1;
 const int CURLOPT_DISABLE = 0;
+// Response code / HTTP_RESP_CLASS_DIV gives the class of the response
+const int HTTP_RESP_CLASS_DIV = 100;
+const int HTTP_2XX_RESP_CLASS = 2;
 
 typedef enum {
   HTTP_METHOD_POST = 1,
@@ -51,6 +54,7 @@ typedef struct {
   uint32_t odc_port;
   uint32_t request_time_out;
   uint32_t connection_time_out;
+  uint32_t max_pooled_connections;
   std::string user_name;
   std::string password;
 } ConfFileValues_t;
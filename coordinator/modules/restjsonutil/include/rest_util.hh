@@ -33,17 +33,28 @@ class RestUtil {
    *               HTTP_METHOD_DELETE/HTTP_METHOD_GET
    * @param[in]  - request body
    * @param[in]  - conf_file values read from conf file
+   * @param[in]  - stream_parser - if not NULL, the body of a successful
+   *               response is fed to it while it is received and is not
+   *               kept in the response structure
    * @return     - HttpResponse_t response structure
    */
   unc::restjson::HttpResponse_t* send_http_request(const std::string &url,
                                    const unc::restjson::HttpMethod method,
-                   const char* request, const ConfFileValues_t &conf_file);
+                   const char* request, const ConfFileValues_t &conf_file,
+                   JsonStreamParser *stream_parser = NULL);
 
   /**
    * @brief     - Default Destructor
    */
   ~RestUtil();
 
+  /**
+   * @brief      - Closes the idle pooled connections to the controller,
+   *               e.g. when it is deleted or its ip address is changed
+   * @param[in]  - ipaddress in string
+   */
+  static void flush_connections(const std::string &ipaddress);
+
  private:
   /**
    * @brief      - Gets user name pass word from controller or conf file
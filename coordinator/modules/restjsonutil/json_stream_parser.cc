@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <stdlib.h>
+#include <json_stream_parser.hh>
+
+namespace unc {
+namespace restjson {
+
+// matched_stack_ value of containers off the path of the records
+static const uint32_t PATH_MISMATCH = 0xFFFFFFFFU;
+
+// Constructor
+JsonStreamParser::JsonStreamParser(JsonStreamHandler *handler)
+: handler_(handler) {
+  PFC_ASSERT(NULL != handler_);
+  reset();
+}
+
+// Resets the parser for a new document
+void JsonStreamParser::reset() {
+  state_ = EXPECT_VALUE;
+  lex_ = LEX_NONE;
+  stack_.clear();
+  token_.clear();
+  token_is_key_ = PFC_FALSE;
+  unicode_ = 0;
+  unicode_digits_ = 0;
+  high_surrogate_ = 0;
+  failed_ = PFC_FALSE;
+  bytes_parsed_ = 0;
+}
+
+// Parses the next chunk of the document
+rest_resp_code_t JsonStreamParser::feed(const char *data, size_t len) {
+  if (PFC_TRUE == failed_) {
+    return REST_OP_FAILURE;
+  }
+  if ((NULL == data) && (0 != len)) {
+    return fail("NULL data");
+  }
+  for (size_t i = 0; i < len; i++) {
+    if (REST_OP_SUCCESS != parse_char(data[i])) {
+      failed_ = PFC_TRUE;
+      pfc_log_error("json stream parse failed at byte %" PFC_PFMT_u64,
+                    bytes_parsed_ + i);
+      return REST_OP_FAILURE;
+    }
+  }
+  bytes_parsed_ += len;
+  return REST_OP_SUCCESS;
+}
+
+// Completes the parse after the last chunk
+rest_resp_code_t JsonStreamParser::finish() {
+  if (PFC_TRUE == failed_) {
+    return REST_OP_FAILURE;
+  }
+  // A number at the top level has no delimiter after it
+  if (LEX_LITERAL == lex_) {
+    if (REST_OP_SUCCESS != complete_literal()) {
+      failed_ = PFC_TRUE;
+      return REST_OP_FAILURE;
+    }
+  }
+  if ((LEX_NONE != lex_) || (EXPECT_NOTHING != state_)) {
+    return fail("incomplete document");
+  }
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamParser::parse_char(char c) {
+  switch (lex_) {
+    case LEX_STRING:
+      if ('"' == c) {
+        lex_ = LEX_NONE;
+        return complete_string();
+      }
+      if ('\\' == c) {
+        lex_ = LEX_ESCAPE;
+        return REST_OP_SUCCESS;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return fail("control character in string");
+      }
+      if (0 != high_surrogate_) {
+        return fail("unpaired surrogate");
+      }
+      return append_token(c);
+
+    case LEX_ESCAPE:
+      lex_ = LEX_STRING;
+      if ('u' == c) {
+        lex_ = LEX_UNICODE;
+        unicode_ = 0;
+        unicode_digits_ = 0;
+        return REST_OP_SUCCESS;
+      }
+      if (0 != high_surrogate_) {
+        return fail("unpaired surrogate");
+      }
+      switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+          return append_token(c);
+        case 'b':
+          return append_token('\b');
+        case 'f':
+          return append_token('\f');
+        case 'n':
+          return append_token('\n');
+        case 'r':
+          return append_token('\r');
+        case 't':
+          return append_token('\t');
+        default:
+          return fail("invalid escape");
+      }
+
+    case LEX_UNICODE:
+      return parse_unicode_digit(c);
+
+    case LEX_LITERAL:
+      if (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z')) ||
+          ((c >= 'A') && (c <= 'Z')) || ('-' == c) || ('+' == c) ||
+          ('.' == c)) {
+        return append_token(c);
+      }
+      // The delimiter after a literal is parsed as structural character
+      if (REST_OP_SUCCESS != complete_literal()) {
+        return REST_OP_FAILURE;
+      }
+      return parse_structural(c);
+
+    case LEX_NONE:
+    default:
+      return parse_structural(c);
+  }
+}
+
+rest_resp_code_t JsonStreamParser::parse_structural(char c) {
+  switch (c) {
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+      return REST_OP_SUCCESS;
+    case '{':
+    case '[':
+      return open_container(c);
+    case '}':
+    case ']':
+      return close_container(c);
+    case ':':
+      if (EXPECT_COLON != state_) {
+        return fail("unexpected ':'");
+      }
+      state_ = EXPECT_VALUE;
+      return REST_OP_SUCCESS;
+    case ',':
+      if (EXPECT_COMMA_OR_END != state_) {
+        return fail("unexpected ','");
+      }
+      state_ = ('{' == stack_.back()) ? EXPECT_KEY : EXPECT_VALUE;
+      return REST_OP_SUCCESS;
+    case '"':
+      if ((EXPECT_KEY == state_) || (EXPECT_KEY_OR_END == state_)) {
+        token_is_key_ = PFC_TRUE;
+      } else if ((EXPECT_VALUE == state_) ||
+                 (EXPECT_VALUE_OR_END == state_)) {
+        token_is_key_ = PFC_FALSE;
+      } else {
+        return fail("unexpected string");
+      }
+      token_.clear();
+      lex_ = LEX_STRING;
+      return REST_OP_SUCCESS;
+    default:
+      if ((EXPECT_VALUE != state_) && (EXPECT_VALUE_OR_END != state_)) {
+        return fail("unexpected character");
+      }
+      if (!(((c >= '0') && (c <= '9')) || ('-' == c) || ('t' == c) ||
+            ('f' == c) || ('n' == c))) {
+        return fail("invalid value");
+      }
+      token_.clear();
+      token_.push_back(c);
+      lex_ = LEX_LITERAL;
+      return REST_OP_SUCCESS;
+  }
+}
+
+rest_resp_code_t JsonStreamParser::parse_unicode_digit(char c) {
+  uint32_t digit = 0;
+  if ((c >= '0') && (c <= '9')) {
+    digit = c - '0';
+  } else if ((c >= 'a') && (c <= 'f')) {
+    digit = c - 'a' + 10;
+  } else if ((c >= 'A') && (c <= 'F')) {
+    digit = c - 'A' + 10;
+  } else {
+    return fail("invalid unicode escape");
+  }
+  unicode_ = (unicode_ << 4) | digit;
+  if (++unicode_digits_ < 4) {
+    return REST_OP_SUCCESS;
+  }
+
+  lex_ = LEX_STRING;
+  if ((unicode_ >= 0xD800) && (unicode_ <= 0xDBFF)) {
+    if (0 != high_surrogate_) {
+      return fail("unpaired surrogate");
+    }
+    high_surrogate_ = unicode_;
+    return REST_OP_SUCCESS;
+  }
+  if ((unicode_ >= 0xDC00) && (unicode_ <= 0xDFFF)) {
+    if (0 == high_surrogate_) {
+      return fail("unpaired surrogate");
+    }
+    uint32_t code_point = 0x10000 + ((high_surrogate_ - 0xD800) << 10) +
+        (unicode_ - 0xDC00);
+    high_surrogate_ = 0;
+    append_utf8(code_point);
+  } else {
+    if (0 != high_surrogate_) {
+      return fail("unpaired surrogate");
+    }
+    append_utf8(unicode_);
+  }
+  if (token_.length() > JSON_STREAM_MAX_TOKEN_LEN) {
+    return fail("token too long");
+  }
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamParser::open_container(char type) {
+  if ((EXPECT_VALUE != state_) && (EXPECT_VALUE_OR_END != state_)) {
+    return fail("unexpected container");
+  }
+  if (stack_.size() >= JSON_STREAM_MAX_DEPTH) {
+    return fail("nested too deep");
+  }
+  stack_.push_back(type);
+  if ('{' == type) {
+    state_ = EXPECT_KEY_OR_END;
+    return handler_->start_object();
+  }
+  state_ = EXPECT_VALUE_OR_END;
+  return handler_->start_array();
+}
+
+rest_resp_code_t JsonStreamParser::close_container(char type) {
+  char open = ('}' == type) ? '{' : '[';
+  if (stack_.empty() || (open != stack_.back())) {
+    return fail("unbalanced container");
+  }
+  if ('{' == open) {
+    if ((EXPECT_KEY_OR_END != state_) && (EXPECT_COMMA_OR_END != state_)) {
+      return fail("unexpected '}'");
+    }
+  } else {
+    if ((EXPECT_VALUE_OR_END != state_) && (EXPECT_COMMA_OR_END != state_)) {
+      return fail("unexpected ']'");
+    }
+  }
+  stack_.pop_back();
+  value_done();
+  return ('{' == open) ? handler_->end_object() : handler_->end_array();
+}
+
+rest_resp_code_t JsonStreamParser::complete_string() {
+  if (0 != high_surrogate_) {
+    return fail("unpaired surrogate");
+  }
+  if (PFC_TRUE == token_is_key_) {
+    state_ = EXPECT_COLON;
+    return handler_->object_key(token_);
+  }
+  value_done();
+  return handler_->scalar_value(token_, JSON_STREAM_STRING);
+}
+
+rest_resp_code_t JsonStreamParser::complete_literal() {
+  lex_ = LEX_NONE;
+  JsonStreamValueType type = JSON_STREAM_NUMBER;
+  if ((token_ == "true") || (token_ == "false")) {
+    type = JSON_STREAM_BOOLEAN;
+  } else if (token_ == "null") {
+    type = JSON_STREAM_NULL;
+  } else {
+    // strtod also takes hex, inf and nan which are not JSON numbers
+    char *end = NULL;
+    if (std::string::npos != token_.find_first_not_of("0123456789+-.eE")) {
+      return fail("invalid literal");
+    }
+    strtod(token_.c_str(), &end);
+    if ((NULL == end) || ('\0' != *end)) {
+      return fail("invalid literal");
+    }
+  }
+  value_done();
+  return handler_->scalar_value(token_, type);
+}
+
+rest_resp_code_t JsonStreamParser::append_token(char c) {
+  if (token_.length() >= JSON_STREAM_MAX_TOKEN_LEN) {
+    return fail("token too long");
+  }
+  token_.push_back(c);
+  return REST_OP_SUCCESS;
+}
+
+void JsonStreamParser::append_utf8(uint32_t code_point) {
+  if (code_point < 0x80) {
+    token_.push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    token_.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+    token_.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    token_.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+    token_.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    token_.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else {
+    token_.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+    token_.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+    token_.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    token_.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+}
+
+// Moves to the state after a complete value
+void JsonStreamParser::value_done() {
+  state_ = stack_.empty() ? EXPECT_NOTHING : EXPECT_COMMA_OR_END;
+}
+
+rest_resp_code_t JsonStreamParser::fail(const char *reason) {
+  pfc_log_error("json stream parse error: %s", reason);
+  failed_ = PFC_TRUE;
+  return REST_OP_FAILURE;
+}
+
+// Constructor
+JsonStreamRecordHandler::JsonStreamRecordHandler(
+    const std::vector<std::string> &path)
+: path_(path),
+  record_depth_(0),
+  path_found_(PFC_FALSE),
+  matched_keys_(0),
+  path_element_count_(0),
+  record_count_(0) {
+}
+
+rest_resp_code_t JsonStreamRecordHandler::start_object() {
+  // An element of the array of records starts a new record
+  if ((0 == record_depth_) && (!type_stack_.empty()) &&
+      ('[' == type_stack_.back()) &&
+      (path_.size() == matched_stack_.back())) {
+    open_container('{');
+    record_depth_ = type_stack_.size();
+    fields_.clear();
+    return REST_OP_SUCCESS;
+  }
+  // Element of an array leading to the array of records
+  if ((0 == record_depth_) && (!type_stack_.empty()) &&
+      ('[' == type_stack_.back()) && (0 != matched_stack_.back()) &&
+      (PATH_MISMATCH != matched_stack_.back())) {
+    path_element_count_++;
+  }
+  open_container('{');
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamRecordHandler::end_object() {
+  pfc_bool_t record_end = (0 != record_depth_) &&
+      (type_stack_.size() == record_depth_) ? PFC_TRUE : PFC_FALSE;
+  close_container();
+  if (PFC_TRUE == record_end) {
+    record_depth_ = 0;
+    record_count_++;
+    return record(fields_);
+  }
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamRecordHandler::start_array() {
+  open_container('[');
+  if ((0 == record_depth_) && (path_.size() == matched_stack_.back())) {
+    path_found_ = PFC_TRUE;
+  }
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamRecordHandler::end_array() {
+  close_container();
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamRecordHandler::object_key(const std::string &key) {
+  pending_key_ = key;
+  return REST_OP_SUCCESS;
+}
+
+rest_resp_code_t JsonStreamRecordHandler::scalar_value(
+    const std::string &value,
+    JsonStreamValueType type) {
+  // Only the direct members of a record are collected
+  if ((0 != record_depth_) && (type_stack_.size() == record_depth_) &&
+      (JSON_STREAM_NULL != type)) {
+    fields_[pending_key_] = value;
+  }
+  pending_key_.clear();
+  return REST_OP_SUCCESS;
+}
+
+void JsonStreamRecordHandler::open_container(char type) {
+  uint32_t matched = matched_stack_.empty() ? 0 : matched_stack_.back();
+  if (!pending_key_.empty() && (PATH_MISMATCH != matched)) {
+    if ((matched < path_.size()) && (path_[matched] == pending_key_)) {
+      matched++;
+    } else {
+      matched = PATH_MISMATCH;
+    }
+  }
+  if ((PATH_MISMATCH != matched) && (matched > matched_keys_)) {
+    matched_keys_ = matched;
+  }
+  type_stack_.push_back(type);
+  matched_stack_.push_back(matched);
+  pending_key_.clear();
+}
+
+void JsonStreamRecordHandler::close_container() {
+  type_stack_.pop_back();
+  matched_stack_.pop_back();
+  pending_key_.clear();
+}
+}  // namespace restjson
+}  // namespace unc
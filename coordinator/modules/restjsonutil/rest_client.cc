@@ -17,7 +17,8 @@ namespace restjson {
 RestClient::RestClient(const std::string &ipaddress,
                        const std::string url,
                        const uint32_t port,
-                       const HttpMethod method)
+                       const HttpMethod method,
+                       const uint32_t pool_size)
 : m_ip_address_(ipaddress),
   m_url_(url),
   m_port_(port),
@@ -25,7 +26,8 @@ RestClient::RestClient(const std::string &ipaddress,
   ODC_FUNC_TRACE;
   http_client_obj_ = new HttpClient();
   PFC_ASSERT(http_client_obj_ != NULL);
-  http_client_obj_->init();
+  http_client_obj_->init(CurlHandlePool::make_key(m_ip_address_, m_port_),
+                         pool_size);
 }
 
 // Destructor
@@ -174,6 +176,13 @@ rest_resp_code_t RestClient::set_request_body(const char* req_body) {
   return ret_val;
 }
 
+// Invokes HttpClient Class set_stream_parser Method
+void RestClient::set_stream_parser(JsonStreamParser *stream_parser) {
+  ODC_FUNC_TRACE;
+  PFC_ASSERT(NULL != http_client_obj_);
+  http_client_obj_->set_stream_parser(stream_parser);
+}
+
 // Clears http response memory allocated
 void RestClient::clear_http_response() {
   ODC_FUNC_TRACE;
@@ -8,6 +8,7 @@
  */
 
 #include <pfcxx/module.hh>
+#include <curl_handle_pool.hh>
 
 namespace unc {
 namespace restjson {
@@ -34,6 +35,9 @@ class RestJsonMod: public pfc::core::Module {
    * @retval- pfc_bool_t
    */
   pfc_bool_t fini() {
+    CurlHandlePool *pool = CurlHandlePool::get_instance();
+    pool->log_stats();
+    pool->clear();
     return PFC_TRUE;
   }
 };
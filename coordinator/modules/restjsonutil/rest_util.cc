@@ -35,7 +35,8 @@ RestUtil::~RestUtil() {
 //  Sends request to restjson module, which sends to VTN Manager
 unc::restjson::HttpResponse_t* RestUtil::send_http_request(
             const std::string &url, const unc::restjson::HttpMethod method,
-          const char* request, const ConfFileValues_t &conf_file_values_) {
+          const char* request, const ConfFileValues_t &conf_file_values_,
+          JsonStreamParser *stream_parser) {
   ODC_FUNC_TRACE;
   std::string user_name = "";
   std::string password = "";
@@ -47,8 +48,12 @@ unc::restjson::HttpResponse_t* RestUtil::send_http_request(
     rest_client_obj_ = NULL;
   }
   rest_client_obj_ = new unc::restjson::RestClient(
-      ipaddress_, url, conf_file_values_.odc_port, method);
+      ipaddress_, url, conf_file_values_.odc_port, method,
+      conf_file_values_.max_pooled_connections);
   PFC_ASSERT(rest_client_obj_ != NULL);
+  if (NULL != stream_parser) {
+    rest_client_obj_->set_stream_parser(stream_parser);
+  }
   unc::restjson::HttpResponse_t* response =
       rest_client_obj_->send_http_request(user_name, password,
                                 conf_file_values_.connection_time_out,
@@ -56,6 +61,12 @@ unc::restjson::HttpResponse_t* RestUtil::send_http_request(
   return response;
 }
 
+//  Closes the idle pooled connections to the controller
+void RestUtil::flush_connections(const std::string &ipaddress) {
+  ODC_FUNC_TRACE;
+  CurlHandlePool::get_instance()->flush(ipaddress);
+}
+
 //  Gets user name password from controller , if it is empty then conf file
 //  values are taken
 void RestUtil::get_username_password(
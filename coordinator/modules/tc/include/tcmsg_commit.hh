@@ -11,8 +11,10 @@
 #define UNC_TC_TCMSG_COMMIT_H_
 #include "tcmsg.hh"
 #include <uncxx/tclib/tclib_defs.hh>
+#include <pfcxx/synch.hh>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace unc {
 namespace tc {
@@ -69,6 +71,29 @@ class TwoPhaseCommit : public TcMsgCommit {
   TcOperRet GetControllerInfo(pfc::core::ipc::ClientSession* sess);
   /*method to send vote request to driver*/
   TcOperRet SendRequestToDriver();
+
+  /*vote/global commit request to a driver module and its response*/
+  struct DriverRequest {
+    unc_keytype_ctrtype_t driver_type;
+    TcDaemonName tc_driverid;
+    std::string channel_name;
+    pfc::core::ipc::ClientSession* sess;
+    pfc_ipcconn_t conn;
+    pfc_ipcresp_t resp;
+    TcUtilRet util_resp;
+  };
+  /*method to create the session of a driver request*/
+  TcOperRet CreateDriverSession(DriverRequest* request,
+                                tclib::TcMsgOperType oper,
+                                ControllerList& clist);
+  /*method to invoke the sessions of driver requests concurrently*/
+  void InvokeDriverSessions(std::vector<DriverRequest>& requests);
+  static void InvokeDriverSession(DriverRequest* request,
+                                  pfc::core::Semaphore* done);
+  static void CloseDriverSessions(std::vector<DriverRequest>& requests);
+  /*methods to abort the drivers that voted successfully*/
+  void AddVotedDriversToAbort(const std::vector<DriverRequest>& requests);
+  TcOperRet AbortDriverVote(const std::vector<DriverRequest>& requests);
   /*methods to create and set driver result notification header*/
   TcOperRet CreateSessionsToForwardDriverResult();
   TcOperRet SetSessionToForwardDriverResult(pfc::core::ipc::ClientSession*
@@ -8,6 +8,9 @@
  */
 
 #include "tcmsg_commit.hh"
+#include <algorithm>
+#include <pfcxx/task_queue.hh>
+#include <boost/bind.hpp>
 
 namespace unc {
 namespace tc {
@@ -716,25 +719,210 @@ TwoPhaseCommit::GetControllerInfo(pfc::core::ipc::ClientSession* sess_) {
   return TCOPER_RET_SUCCESS;
 }
 
-/*!\brief method to send vote/global commit to driver modules with controller
- * info collected from UPLL/UPPL
- * @param[in] channelname - recipient channel name
+/*!\brief method to create the vote/global commit session of a driver module
+ * with controller info collected from UPLL/UPPL
+ * @param[in] request - driver request with the recipient channel name
+ * @param[in] oper - driver vote/global commit operation
  * @param[in] clist - list of controllers corresponding to the driver module.
- * @param[in] dummy_sess_ - dummy client session to collect driver response.
+ *@result TcOperRet - TCOPER_RET_SUCCESS/TCOPER_RET_FAILURE/TCOPER_RET_FATAL
+ **/
+TcOperRet
+TwoPhaseCommit::CreateDriverSession(DriverRequest* request,
+                                    tclib::TcMsgOperType oper,
+                                    ControllerList& clist) {
+  TcUtilRet util_resp = TCUTIL_RET_SUCCESS;
+  ControllerList::iterator cntrl_it;
+
+  /*Create session for the given module name and service id*/
+  request->sess = TcClientSessionUtils::create_tc_client_session(
+      request->channel_name, tclib::TCLIB_COMMIT_DRV_VOTE_GLOBAL,
+      request->conn);
+  if (NULL == request->sess) {
+    pfc_log_error("SendRequestToDriver: Session creation failed");
+    return TCOPER_RET_FATAL;
+  }
+
+  /*append data to channel */
+  util_resp = TcClientSessionUtils::set_uint8(request->sess, oper);
+  if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
+    pfc_log_error("SendRequestToDriver: Set oper failed");
+    TcClientSessionUtils::tc_session_close(&request->sess, request->conn);
+    return ReturnUtilResp(util_resp);
+  }
+  /*validate session_id_ and config_id_*/
+  if (PFC_EXPECT_TRUE(session_id_ > 0) &&
+      PFC_EXPECT_TRUE(config_id_ > 0)) {
+    util_resp = TcClientSessionUtils::set_uint32(request->sess, session_id_);
+    if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
+      pfc_log_error("SendRequestToDriver: Set sess_id failed");
+      TcClientSessionUtils::tc_session_close(&request->sess, request->conn);
+      return ReturnUtilResp(util_resp);
+    }
+    util_resp = TcClientSessionUtils::set_uint32(request->sess, config_id_);
+    if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
+      pfc_log_error("SendRequestToDriver: Set config_id failed");
+      TcClientSessionUtils::tc_session_close(&request->sess, request->conn);
+      return ReturnUtilResp(util_resp);
+    }
+  } else {
+    pfc_log_error("Invalid Session/Config ID");
+    TcClientSessionUtils::tc_session_close(&request->sess, request->conn);
+    return TCOPER_RET_FAILURE;
+  }
+  /*add controller info*/
+  uint8_t controller_count = clist.size();
+  util_resp = TcClientSessionUtils::set_uint8(request->sess, controller_count);
+  if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
+    pfc_log_error("SendRequestToDriver: Set ctrl_count failed");
+    TcClientSessionUtils::tc_session_close(&request->sess, request->conn);
+    return ReturnUtilResp(util_resp);
+  }
+  for (cntrl_it = clist.begin(); cntrl_it != clist.end(); cntrl_it++) {
+    util_resp = TcClientSessionUtils::set_string(request->sess, *cntrl_it);
+    if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
+      pfc_log_error("SendRequestToDriver: Set ctrl_id failed");
+      TcClientSessionUtils::tc_session_close(&request->sess, request->conn);
+      return ReturnUtilResp(util_resp);
+    }
+  }
+  pfc_log_info("notify %s - controller_count:%d",
+               request->channel_name.c_str(), controller_count);
+  return TCOPER_RET_SUCCESS;
+}
+
+/*!\brief task method to invoke the session of a driver request.
+ * @param[in] request - driver request to be invoked
+ * @param[in] done - semaphore posted on completion, NULL if called inline
+ **/
+void
+TwoPhaseCommit::InvokeDriverSession(DriverRequest* request,
+                                    pfc::core::Semaphore* done) {
+  request->util_resp = TcClientSessionUtils::tc_session_invoke(request->sess,
+                                                               request->resp);
+  if (done != NULL) {
+    done->post();
+  }
+}
+
+/*!\brief method to invoke the sessions of driver requests.
+ * Drivers of different controller types handle vote/global commit
+ * independently, so their sessions are invoked concurrently and the
+ * responses are gathered before any of them is processed.
+ * @param[in] requests - driver requests, sessions of absent drivers are NULL
+ **/
+void
+TwoPhaseCommit::InvokeDriverSessions(std::vector<DriverRequest>& requests) {
+  std::vector<DriverRequest>::iterator req;
+  uint32_t count = 0, dispatched = 0;
+
+  for (req = requests.begin(); req != requests.end(); req++) {
+    if (req->sess != NULL) {
+      count++;
+    }
+  }
+  if (count <= 1) {
+    for (req = requests.begin(); req != requests.end(); req++) {
+      if (req->sess != NULL) {
+        InvokeDriverSession(&(*req), NULL);
+      }
+    }
+    return;
+  }
+
+  pfc::core::Semaphore done(0);
+  pfc::core::TaskQueue* taskq = pfc::core::TaskQueue::create(count);
+  for (req = requests.begin(); req != requests.end(); req++) {
+    if (req->sess == NULL) {
+      continue;
+    }
+    if (taskq != NULL &&
+        taskq->dispatch(boost::bind(&TwoPhaseCommit::InvokeDriverSession,
+                                    &(*req), &done)) == 0) {
+      dispatched++;
+    } else {
+      pfc_log_warn("dispatch to %s failed; invoking inline",
+                   req->channel_name.c_str());
+      InvokeDriverSession(&(*req), NULL);
+    }
+  }
+  /*wait for the responses of all dispatched requests*/
+  for (; dispatched > 0; dispatched--) {
+    done.wait();
+  }
+  if (taskq != NULL) {
+    delete taskq;
+  }
+}
+
+/*!\brief method to close the sessions of driver requests.
+ * @param[in] requests - driver requests
+ **/
+void
+TwoPhaseCommit::CloseDriverSessions(std::vector<DriverRequest>& requests) {
+  std::vector<DriverRequest>::iterator req;
+  for (req = requests.begin(); req != requests.end(); req++) {
+    if (req->sess != NULL) {
+      TcClientSessionUtils::tc_session_close(&req->sess, req->conn);
+    }
+  }
+}
+
+/*!\brief method to add the drivers that voted successfully to the abort
+ * list. All the driver requests are invoked before any response is
+ * processed, so the drivers after a failed one have voted too.
+ * @param[in] requests - driver requests
+ **/
+void
+TwoPhaseCommit::AddVotedDriversToAbort(
+    const std::vector<DriverRequest>& requests) {
+  std::vector<DriverRequest>::const_iterator req;
+  for (req = requests.begin(); req != requests.end(); req++) {
+    if (req->sess != NULL &&
+        req->util_resp == TCUTIL_RET_SUCCESS &&
+        req->resp == tclib::TC_SUCCESS &&
+        std::find(abort_on_fail_.begin(), abort_on_fail_.end(),
+                  req->tc_driverid) == abort_on_fail_.end()) {
+      abort_on_fail_.push_back(req->tc_driverid);
+    }
+  }
+}
+
+/*!\brief method to abort the vote of the recipients that voted successfully,
+ * including all the drivers that did, on failure of a driver vote.
+ * @param[in] requests - driver requests
+ *@result TcOperRet - TCOPER_RET_ABORT/TCOPER_RET_FATAL
+ **/
+TcOperRet
+TwoPhaseCommit::AbortDriverVote(const std::vector<DriverRequest>& requests) {
+  TcOperRet ret_val = TCOPER_RET_ABORT;
+
+  trans_result_ = tclib::TRANS_END_FAILURE;
+  AddVotedDriversToAbort(requests);
+  if (PFC_EXPECT_TRUE(TCOPER_RET_SUCCESS ==
+                      SendAbortRequest(abort_on_fail_))) {
+    driverinfo_map_.clear();
+  } else {
+    pfc_log_error("SendAbortRequest failed");
+    ret_val = TCOPER_RET_FATAL;
+  }
+  abort_on_fail_.clear();
+  return ret_val;
+}
+
+/*!\brief method to send vote/global commit to driver modules with controller
+ * info collected from UPLL/UPPL. Requests are sent to all driver modules
+ * at once, and the responses are forwarded to UPLL/UPPL in the order of
+ * driver types as before.
  *@result TcOperRet - TCOPER_RET_SUCCESS/TCOPER_RET_FAILURE
  **/
 TcOperRet
 TwoPhaseCommit::SendRequestToDriver() {
   pfc_log_debug("TwoPhaseCommit::SendRequestToDriver entry");
-  pfc_ipcresp_t resp = 0;
-  std::string channel_name;
-  TcUtilRet util_resp = TCUTIL_RET_SUCCESS;
   TcOperRet ret_val = TCOPER_RET_SUCCESS;
   tclib::TcMsgOperType oper = tclib::MSG_NONE;
   TcDriverInfoMap::iterator it;
-  ControllerList clist;
-  ControllerList::iterator cntrl_it;
-  TcDaemonName tc_driverid;
+  std::vector<DriverRequest> requests;
+  std::vector<DriverRequest>::iterator req;
 
   if (PFC_EXPECT_TRUE(opertype_ ==  tclib::MSG_COMMIT_VOTE)) {
     pfc_log_info("*** VOTE to Driver ***");
@@ -750,107 +938,97 @@ TwoPhaseCommit::SendRequestToDriver() {
     pfc_log_error("creating UPLL/UPPL sessions to forward DriverResult failed");
     return TCOPER_RET_FAILURE;
   }
-  /*send controller info to driver modules*/
+  /*create sessions with controller info to all driver modules*/
   for (it = driverinfo_map_.begin(); it != driverinfo_map_.end(); it++) {
+    DriverRequest request;
+    request.driver_type = (*it).first;
+    request.sess = NULL;
+    request.conn = 0;
+    request.resp = 0;
+    request.util_resp = TCUTIL_RET_SUCCESS;
     /*map the driver type and get the channel name*/
-    tc_driverid = MapTcDriverId((*it).first);
-    if (tc_driverid != TC_NONE) {
-      TcChannelNameMap::iterator chname = channel_names_.find(tc_driverid);
+    request.tc_driverid = MapTcDriverId((*it).first);
+    if (request.tc_driverid != TC_NONE) {
+      TcChannelNameMap::iterator chname =
+          channel_names_.find(request.tc_driverid);
       if (chname != channel_names_.end()) {
-        channel_name = chname->second;
+        request.channel_name = chname->second;
         pfc_log_debug("tc_driverid:%d channel_name:%s",
-                      tc_driverid, channel_name.c_str());
+                      request.tc_driverid, request.channel_name.c_str());
       } else {
-        pfc_log_error("Channel not available for driver:%u", tc_driverid);
-        channel_name.clear();
+        pfc_log_error("Channel not available for driver:%u",
+                      request.tc_driverid);
       }
     } else {
       pfc_log_error("Driver daemon %d does not exist", (*it).first);
+      CloseDriverSessions(requests);
       return TCOPER_RET_FATAL;
     }
-    if (channel_name.empty()) {
-      pfc_log_error("Driver not present; Adding dummy response");
-      ret_val = HandleDriverNotPresent(it->first);
-      if (PFC_EXPECT_TRUE(ret_val != TCOPER_RET_SUCCESS)) {
-        pfc_log_error("HandleDriverNotPresent not successful");
-        return TCOPER_RET_FATAL;
+    if (!request.channel_name.empty()) {
+      ret_val = CreateDriverSession(&request, oper, (*it).second);
+      if (ret_val != TCOPER_RET_SUCCESS) {
+        CloseDriverSessions(requests);
+        return ret_val;
       }
-      continue;
     }
+    requests.push_back(request);
+  }
 
-    /*Create session for the given module name and service id*/
-    sess_ = TcClientSessionUtils::create_tc_client_session(channel_name,
-                                  tclib::TCLIB_COMMIT_DRV_VOTE_GLOBAL, conn_);
-    if (NULL == sess_) {
-      pfc_log_error("SendRequestToDriver: Session creation failed");
-      return TCOPER_RET_FATAL;
-    }
+  InvokeDriverSessions(requests);
 
-    /*append data to channel */
-    util_resp = TcClientSessionUtils::set_uint8(sess_, oper);
-    if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
-      pfc_log_error("SendRequestToDriver: Set oper failed");
-      return ReturnUtilResp(util_resp);
-    }
-    /*validate session_id_ and config_id_*/
-    if (PFC_EXPECT_TRUE(session_id_ > 0) &&
-        PFC_EXPECT_TRUE(config_id_ > 0)) {
-      util_resp = TcClientSessionUtils::set_uint32(sess_, session_id_);
-      if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
-        pfc_log_error("SendRequestToDriver: Set sess_id failed");
-        return ReturnUtilResp(util_resp);
-      }
-      util_resp = TcClientSessionUtils::set_uint32(sess_, config_id_);
-      if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
-        pfc_log_error("SendRequestToDriver: Set config_id failed");
-        return ReturnUtilResp(util_resp);
+  /*a driver not reached fails the vote; the drivers that voted before or
+   *after it are aborted, as they cannot be sent the driver result*/
+  if (PFC_EXPECT_TRUE(opertype_ ==  tclib::MSG_COMMIT_VOTE)) {
+    for (req = requests.begin(); req != requests.end(); req++) {
+      if (req->sess != NULL && req->util_resp != TCUTIL_RET_SUCCESS) {
+        pfc_log_error("SendRequestToDriver: Session invoke of %s failed",
+                      req->channel_name.c_str());
+        ret_val = AbortDriverVote(requests);
+        CloseDriverSessions(requests);
+        return (ret_val == TCOPER_RET_ABORT) ?
+            ReturnUtilResp(req->util_resp) : ret_val;
       }
-    } else {
-      pfc_log_error("Invalid Session/Config ID");
-      return TCOPER_RET_FAILURE;
     }
-    /*add controller info*/
-    clist = (*it).second;
-    uint8_t controller_count = clist.size();
-    util_resp = TcClientSessionUtils::set_uint8(sess_, controller_count);
-    if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
-      pfc_log_error("SendRequestToDriver: Set ctrl_count failed");
-      return ReturnUtilResp(util_resp);
-    }
-    for (cntrl_it = clist.begin(); cntrl_it != clist.end(); cntrl_it++) {
-      util_resp = TcClientSessionUtils::set_string(sess_, *cntrl_it);
-      if (PFC_EXPECT_TRUE(util_resp != TCUTIL_RET_SUCCESS)) {
-        pfc_log_error("SendRequestToDriver: Set ctrl_id failed");
-        return ReturnUtilResp(util_resp);
+  }
+
+  for (req = requests.begin(); req != requests.end(); req++) {
+    if (req->sess == NULL) {
+      pfc_log_error("Driver not present; Adding dummy response");
+      ret_val = HandleDriverNotPresent(req->driver_type);
+      if (PFC_EXPECT_TRUE(ret_val != TCOPER_RET_SUCCESS)) {
+        pfc_log_error("HandleDriverNotPresent not successful");
+        CloseDriverSessions(requests);
+        return TCOPER_RET_FATAL;
       }
+      continue;
     }
-    pfc_log_info("notify %s - controller_count:%d",
-                 channel_name.c_str(), controller_count);
-    /*Invoke the session */
-    util_resp = TcClientSessionUtils::tc_session_invoke(sess_, resp);
-    if (util_resp != TCUTIL_RET_SUCCESS) {
+    if (req->util_resp != TCUTIL_RET_SUCCESS) {
       pfc_log_error("SendRequestToDriver: Session invoke failed");
-      return ReturnUtilResp(util_resp);
+      CloseDriverSessions(requests);
+      return ReturnUtilResp(req->util_resp);
     }
 
-    if (PFC_EXPECT_TRUE(tclib::TC_SUCCESS == resp)) {
-      pfc_log_info("success response from %s", channel_name.c_str());
+    if (PFC_EXPECT_TRUE(tclib::TC_SUCCESS == req->resp)) {
+      pfc_log_info("success response from %s", req->channel_name.c_str());
       /*accumulate respective driver response in client sessions*/
       DriverSet dmndrvinfo = driverset_map_[TC_UPLL];
       /*validate the driver_id saved from UPLL controllerinfo*/
-      if (PFC_EXPECT_TRUE(dmndrvinfo.find((*it).first) != dmndrvinfo.end())) {
+      if (PFC_EXPECT_TRUE(dmndrvinfo.find(req->driver_type) !=
+                          dmndrvinfo.end())) {
         pfc_log_debug("forward response to UPLL session");
 
-        int32_t ipc_ret = upll_sess_->forward(*sess_, 0, UINT32_MAX);
+        int32_t ipc_ret = upll_sess_->forward(*req->sess, 0, UINT32_MAX);
         if (ipc_ret == ESHUTDOWN ||
             ipc_ret == ECANCELED ||
             ipc_ret == ECONNABORTED) {
           pfc_log_error("%s forward upll_sess_ failed; ipc_ret=%d",
                         __FUNCTION__, ipc_ret);
+          CloseDriverSessions(requests);
           return TCOPER_RET_FATAL;
         } else if (ipc_ret != TCOPER_RET_SUCCESS) {
           pfc_log_fatal("%s forward upll_sess_ failed; ipc_ret=%d",
                         __FUNCTION__, ipc_ret);
+          CloseDriverSessions(requests);
           return TCOPER_RET_FATAL;
         }
       }
@@ -859,55 +1037,51 @@ TwoPhaseCommit::SendRequestToDriver() {
        *controller list from UPPL is always empty during VOTE/COMMIT phase*/
       dmndrvinfo = driverset_map_[TC_UPLL];
       /*validate the driver_id saved from UPPL controllerinfo*/
-      if (PFC_EXPECT_TRUE(dmndrvinfo.find((*it).first) != dmndrvinfo.end())) {
+      if (PFC_EXPECT_TRUE(dmndrvinfo.find(req->driver_type) !=
+                          dmndrvinfo.end())) {
         pfc_log_debug("forward response to UPPL session");
 
-        int32_t ipc_ret = uppl_sess_->forward(*sess_, 0, UINT32_MAX);
+        int32_t ipc_ret = uppl_sess_->forward(*req->sess, 0, UINT32_MAX);
         if (ipc_ret == ESHUTDOWN ||
             ipc_ret == ECANCELED ||
             ipc_ret == ECONNABORTED) {
           pfc_log_error("%s forward uppl_sess_ failed; ipc_ret=%d",
                         __FUNCTION__, ipc_ret);
+          CloseDriverSessions(requests);
           return TCOPER_RET_FATAL;
         } else if (ipc_ret != TCOPER_RET_SUCCESS) {
           pfc_log_fatal("%s forward uppl_sess_ failed; ipc_ret=%d",
                         __FUNCTION__, ipc_ret);
+          CloseDriverSessions(requests);
           return TCOPER_RET_FATAL;
         }
       }
       /*append channelname to handle failure*/
-      abort_on_fail_.push_back(tc_driverid);
-      ret_val = TCOPER_RET_SUCCESS;
-    } else if (PFC_EXPECT_TRUE(tclib::TC_FAILURE == resp) &&
-               PFC_EXPECT_TRUE(opertype_ ==  tclib::MSG_COMMIT_VOTE)) {
-      pfc_log_info("Failure response from %s", channel_name.c_str());
-      trans_result_ = tclib::TRANS_END_FAILURE;
-
-      if (PFC_EXPECT_TRUE(abort_on_fail_.empty())) {
-        ret_val = TCOPER_RET_ABORT;
-      }
-      if (PFC_EXPECT_TRUE(TCOPER_RET_SUCCESS ==
-                          SendAbortRequest(abort_on_fail_))) {
-        abort_on_fail_.clear();
-        driverinfo_map_.clear();
-        ret_val = TCOPER_RET_ABORT;
-      } else {
-        pfc_log_error("SendAbortRequest failed");
-        abort_on_fail_.clear();
-        ret_val = TCOPER_RET_FATAL;
-      }
-    } else if (PFC_EXPECT_TRUE(tclib::TC_FAILURE == resp) &&
-               PFC_EXPECT_TRUE(opertype_ ==  tclib::MSG_COMMIT_GLOBAL)) {
-      pfc_log_error("Failure response from %s", channel_name.c_str());
-      ret_val = TCOPER_RET_FATAL;
+      abort_on_fail_.push_back(req->tc_driverid);
+      continue;
+    }
+    if (PFC_EXPECT_FALSE(tclib::TC_FAILURE != req->resp)) {
+      continue;
     }
 
-    if (ret_val == TCOPER_RET_SUCCESS) {
-      TcClientSessionUtils::tc_session_close(&sess_, conn_);
+    if (PFC_EXPECT_TRUE(opertype_ ==  tclib::MSG_COMMIT_VOTE)) {
+      pfc_log_info("Failure response from %s", req->channel_name.c_str());
+      /*drivers that voted along with the failed one are aborted too*/
+      ret_val = AbortDriverVote(requests);
     } else {
-      return ret_val;
+      pfc_log_error("Failure response from %s", req->channel_name.c_str());
+      ret_val = TCOPER_RET_FATAL;
     }
+    /*session of the failed driver is not closed as
+     * its contents are forwarded to VTN*/
+    sess_ = req->sess;
+    conn_ = req->conn;
+    req->sess = NULL;
+    CloseDriverSessions(requests);
+    return ret_val;
   }
+  CloseDriverSessions(requests);
+  ret_val = TCOPER_RET_SUCCESS;
 
   /*forward driver result to UPLL and UPPL*/
   pfc_log_info("Forwarding DRIVER RESULT to UPLL");
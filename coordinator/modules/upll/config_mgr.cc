@@ -91,6 +91,8 @@ const uint32_t default_batch_timeout = 10;  // in seconds
 const uint32_t default_batch_commit_limit = 1000;
 const char * const tx_update_taskq_conf_blk = "concurrent_req_to_ctrlrs";
 const uint32_t default_tx_update_taskqs = 4;
+const char * const transaction_conf_blk = "transaction";
+const uint32_t default_tx_update_db_conns = 4;
 const char * const oper_status_setting_conf_blk = "oper_status_setting";
 const bool default_map_physical_resource_status = true;
 }
@@ -149,6 +151,8 @@ UpllConfigMgr::UpllConfigMgr()
       current_import_type = UPLL_IMPORT_TYPE_FULL;
       import_type = UPLL_IMPORT_TYPE_FULL;
       tx_util_ = NULL;
+      tx_update_conns_ = 1;
+      tx_update_taskq_ = NULL;
       fifo_scheduler_ = NULL;
 }
 
@@ -163,6 +167,7 @@ UpllConfigMgr::~UpllConfigMgr(void) {
     pfc::alarm::pfc_alarm_close(alarm_fd);
   }
   delete tx_util_;
+  delete tx_update_taskq_;
 }
 
 /*
@@ -231,6 +236,15 @@ bool UpllConfigMgr::Init(void) {
 
   tx_util_ = new TxUpdateUtil(GetTxUpdateTaskqParamsFrmConfFile());
   tx_util_->Init();
+
+  tx_update_conns_ = GetTxUpdateConnsFrmConfFile();
+  if (tx_update_conns_ > 1) {
+    tx_update_taskq_ = pfc::core::TaskQueue::create(tx_update_conns_ - 1);
+    if (tx_update_taskq_ == NULL) {
+      UPLL_LOG_ERROR("TxUpdate TaskQ creation failed");
+      return false;
+    }
+  }
   pfc_sem_init(&sem_alarm_commit_syc_, 1);
 
   // Get Import Mode from unclib
@@ -695,6 +709,71 @@ bool UpllConfigMgr::BuildKeyTree() {
 
   cktt_.PrepareOrderedList();
 
+  // Dependencies other than the parent, used when the TxUpdateController
+  // of the independent key types run concurrently. The required key type
+  // must come before in the preorder list.
+  if (cktt_.AddSubtreeDependency(UNC_KT_UNW_SPINE_DOMAIN, UNC_KT_UNW_LABEL) &&
+      cktt_.AddDependency(UNC_KT_POLICING_PROFILE_ENTRY,
+                          UNC_KT_FLOWLIST_ENTRY) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VTN_UNIFIED,
+                                 UNC_KT_UNIFIED_NETWORK) &&
+      cktt_.AddDependency(UNC_KT_VBR_PORTMAP, UNC_KT_VTN_UNIFIED) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VBR_PORTMAP,
+                                 UNC_KT_UNIFIED_NETWORK) &&
+      // policing maps refer to the policing profiles
+      cktt_.AddDependency(UNC_KT_VBR_POLICINGMAP,
+                          UNC_KT_POLICING_PROFILE_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VBRIF_POLICINGMAP,
+                          UNC_KT_POLICING_PROFILE_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VTERMIF_POLICINGMAP,
+                          UNC_KT_POLICING_PROFILE_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VTN_POLICINGMAP,
+                          UNC_KT_POLICING_PROFILE_ENTRY) &&
+      // flowfilter entries refer to the flowlists, the network monitors
+      // and the redirect destination interfaces
+      cktt_.AddDependency(UNC_KT_VBR_FLOWFILTER_ENTRY,
+                          UNC_KT_FLOWLIST_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VBR_FLOWFILTER_ENTRY,
+                          UNC_KT_VBR_NWMONITOR) &&
+      cktt_.AddDependency(UNC_KT_VBRIF_FLOWFILTER_ENTRY,
+                          UNC_KT_FLOWLIST_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VBRIF_FLOWFILTER_ENTRY,
+                          UNC_KT_VBR_NWMONITOR) &&
+      cktt_.AddDependency(UNC_KT_VRTIF_FLOWFILTER_ENTRY,
+                          UNC_KT_FLOWLIST_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VRTIF_FLOWFILTER_ENTRY,
+                          UNC_KT_VBR_NWMONITOR) &&
+      cktt_.AddDependency(UNC_KT_VRTIF_FLOWFILTER_ENTRY, UNC_KT_VBR_IF) &&
+      cktt_.AddDependency(UNC_KT_VTERMIF_FLOWFILTER_ENTRY,
+                          UNC_KT_FLOWLIST_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VTERMIF_FLOWFILTER_ENTRY,
+                          UNC_KT_VBR_NWMONITOR) &&
+      cktt_.AddDependency(UNC_KT_VTERMIF_FLOWFILTER_ENTRY, UNC_KT_VBR_IF) &&
+      cktt_.AddDependency(UNC_KT_VTERMIF_FLOWFILTER_ENTRY, UNC_KT_VRT_IF) &&
+      cktt_.AddDependency(UNC_KT_VTN_FLOWFILTER_ENTRY,
+                          UNC_KT_FLOWLIST_ENTRY) &&
+      cktt_.AddDependency(UNC_KT_VRT_IPROUTE, UNC_KT_VBR_NWMONITOR) &&
+      cktt_.AddDependency(UNC_KT_DHCPRELAY_IF, UNC_KT_VRT_IF) &&
+      cktt_.AddDependency(UNC_KT_VTEP_GRP_MEMBER, UNC_KT_VTEP) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VTUNNEL, UNC_KT_VTEP) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VTUNNEL, UNC_KT_VTEP_GRP) &&
+      // vlinks connect the interfaces of any vnode
+      cktt_.AddDependency(UNC_KT_VLINK, UNC_KT_VTN_UNIFIED) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VBRIDGE) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VROUTER) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VTERMINAL) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VUNKNOWN) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VTEP) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VTEP_GRP) &&
+      cktt_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VTUNNEL) &&
+      // VTN level policing map and flowfilter are sent to the controllers
+      // of the vnodes
+      cktt_.AddDependency(UNC_KT_VTN_POLICINGMAP, UNC_KT_VLINK) &&
+      cktt_.AddDependency(UNC_KT_VTN_FLOWFILTER, UNC_KT_VLINK)) {
+  } else {
+    return false;
+  }
+
   // Init Import KeyType Tree
   if (iktt_.AddKeyType(UNC_KT_ROOT, UNC_KT_FLOWLIST) &&
       iktt_.AddKeyType(UNC_KT_ROOT, UNC_KT_POLICING_PROFILE) &&
@@ -3213,6 +3292,28 @@ uint32_t UpllConfigMgr::GetTxUpdateTaskqParamsFrmConfFile() {
   return no_of_tx_taskqs;
 }
 
+// TxUpdate takes at most half of the RO connections, the others are left
+// to the read requests during commit
+uint32_t UpllConfigMgr::GetTxUpdateConnsFrmConfFile() {
+  UPLL_FUNC_TRACE;
+  uint32_t db_conns = default_tx_update_db_conns;
+
+  pfc::core::ModuleConfBlock tx_block(transaction_conf_blk);
+  if (tx_block.getBlock() != PFC_CFBLK_INVALID) {
+    db_conns = tx_block.getUint32("tx_update_db_conns",
+                                  default_tx_update_db_conns);
+  }
+  uint32_t max_conns = (dbcm_->get_ro_conn_limit() / 2) + 1;
+  if (db_conns > max_conns) {
+    db_conns = max_conns;
+  }
+  if (db_conns == 0) {
+    db_conns = 1;
+  }
+  UPLL_LOG_INFO("TxUpdate DB connections are %u", db_conns);
+  return db_conns;
+}
+
 upll_rc_t UpllConfigMgr::GetVtnName(const IpcReqRespHeader &msghdr,
                                     const ConfigKeyVal &ckv,
                                     char **vtn_id) {
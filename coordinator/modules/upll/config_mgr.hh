@@ -631,6 +631,29 @@ class UpllConfigMgr {
 
   upll_rc_t ValidateCommit(const char *caller);
   upll_rc_t ValidateAudit(const char *caller, const char *ctrlr_id);
+
+  // Arguments of TxUpdateKt() shared by all the key types of a phase
+  struct TxUpdateKtArgs {
+    TxUpdateKtArgs(uint32_t sess_id, uint32_t cfg_id,
+                   const std::vector<DalOdbcMgr *> *dbconns,
+                   TcConfigMode mode, const std::string &vtn)
+        : session_id(sess_id), config_id(cfg_id), phase(kUpllUcpInit),
+          conns(dbconns), config_mode(mode), vtn_name(vtn) {}
+    uint32_t session_id;
+    uint32_t config_id;
+    UpdateCtrlrPhase phase;
+    const std::vector<DalOdbcMgr *> *conns;
+    // Controllers affected by the key types run on each connection
+    std::vector<std::set<std::string> > ctrlr_sets;
+    TcConfigMode config_mode;
+    std::string vtn_name;
+  };
+  void AcquireTxUpdateConns(std::vector<DalOdbcMgr *> *conns);
+  void ReleaseTxUpdateConns(std::vector<DalOdbcMgr *> *conns);
+  upll_rc_t TxUpdateControllerByDag(TxUpdateKtArgs *args,
+                                    ConfigKeyVal **err_ckv);
+  upll_rc_t TxUpdateKt(TxUpdateKtArgs *args, unc_key_type_t kt,
+                       uint32_t conn_idx, ConfigKeyVal **err_ckv);
   upll_rc_t ValidateImport(uint32_t session_id, uint32_t config_id,
                            const char *ctrlr_id, uint32_t operation,
                            upll_import_type import_type);
@@ -734,6 +757,12 @@ class UpllConfigMgr {
   uint32_t GetTxUpdateTaskqParamsFrmConfFile();
   TxUpdateUtil *tx_util_;
 
+  // Connections used by TxUpdateDag, including the config RW connection
+  uint32_t tx_update_conns_;
+  uint32_t GetTxUpdateConnsFrmConfFile();
+  // Runs the key types of TxUpdateDag on the RO connections
+  pfc::core::TaskQueue* tx_update_taskq_;
+
   // import-mode options from uncd.conf file
   UncImportMode import_err_behavior_;
 };
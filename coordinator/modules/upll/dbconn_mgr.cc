@@ -13,6 +13,7 @@
 
 // #include <iostream>
 #include <sstream>
+#include "pfc/clock.h"
 #include "upll_util.hh"
 #include "dbconn_mgr.hh"
 
@@ -60,8 +61,9 @@ void UpllDbConnMgr::ConvertConnInfoToStr() const {
 #ifdef PFC_VERBOSE_DEBUG
   std::stringstream ss;
   ss << " Max No. Of Connections:" << max_ro_conns_
-     << " No. Of Connections In Use:" << active_ro_conns_cnt_
-     << " No. Of Free Connections:" << (max_ro_conns_ - active_ro_conns_cnt_);
+     << " No. Of Open Connections:" << active_ro_conns_cnt_
+     << " No. Of Unopened Connections:"
+     << (max_ro_conns_ - active_ro_conns_cnt_);
   UPLL_LOG_DEBUG("DbConn: %s", ss.str().c_str());
 #endif
 }
@@ -330,6 +332,7 @@ void UpllDbConnMgr::TerminateAndInitializeDbConns(bool active) {
       "All DB connections are being closed and initialized "
       "based on cluster state");
   pfc::core::ScopedMutex lock(conn_mutex_);
+  LogRoConnStats();
   TerminateAllDbConnsNoLock();
   if (active) {
     InitializeDbConnectionsNoLock();
@@ -339,94 +342,231 @@ void UpllDbConnMgr::TerminateAndInitializeDbConns(bool active) {
 upll_rc_t UpllDbConnMgr::TerminateAllRoConns_NoLock() {
   UPLL_FUNC_TRACE;
   UPLL_LOG_DEBUG("All DB RO connections are being closed");
-  std::list<DbConn*>::iterator iter = ro_conn_pool_.begin();
-  while (iter != ro_conn_pool_.end()) {
-    TerminateDbConn(*iter);
-    if ((*iter)->close_on_finish == true) {
-      iter++;
-    } else {
-      std::list<DbConn*>::iterator tmp_iter = iter;
-      iter++;
-      DbConn *dbc = *tmp_iter;
-      delete dbc;
-      ro_conn_pool_.erase(tmp_iter);
-      active_ro_conns_cnt_--;
-      ro_conn_sem_.post();
-    }
-  }
+  // Connections in use are closed by their owner on release
+  pfc_atomic_inc_uint32(&ro_conn_gen_);
+  CheckRoConnHealth();
   ConvertConnInfoToStr();
   return UPLL_RC_SUCCESS;
 }
 
-upll_rc_t UpllDbConnMgr::AcquireRoConn(DalOdbcMgr **dom) {
-  UPLL_FUNC_TRACE;
-  UPLL_LOG_DEBUG("Acquiring RO Connection");
-  ro_conn_sem_.wait();
-  pfc::core::ScopedMutex lock(conn_mutex_);
+// Returns the slot which the calling worker thread tries first. Each thread
+// is given its own slot round robin, so while there are no more workers than
+// slots the acquisitions of different workers do not touch the same slot.
+uint32_t UpllDbConnMgr::GetRoHomeSlot() {
+  static __thread uint32_t home_slot_plus1 = 0;
+  if (home_slot_plus1 == 0) {
+    home_slot_plus1 = pfc_atomic_inc_uint32_old(&ro_next_home_) + 1;
+  }
+  return (home_slot_plus1 - 1) % ro_slots_.size();
+}
 
-  // First check if there is a not-in-use connection available
-  for (std::list<DbConn*>::iterator iter = ro_conn_pool_.begin();
-       iter != ro_conn_pool_.end(); iter++) {
-    if ((*iter)->in_use_cnt == 0) {
-      (*iter)->in_use_cnt = 1;
-      *dom = &(*iter)->dom;
-      return UPLL_RC_SUCCESS;
+bool UpllDbConnMgr::ClaimRoSlot(uint32_t home, uint32_t *index) {
+  uint32_t nslots = ro_slots_.size();
+  uint32_t idx = home;
+  for (uint32_t i = 0; i < nslots; i++) {
+    uint32_t *state = &ro_slots_[idx].state;
+    if (*state == kRoSlotFree &&
+        pfc_atomic_cas_acq_uint32(state, kRoSlotBusy, kRoSlotFree) ==
+        kRoSlotFree) {
+      *index = idx;
+      return true;
+    }
+    if (++idx == nslots) {
+      idx = 0;
+    }
+  }
+  return false;
+}
+
+// Slow path of AcquireRoConn() when all the slots are busy
+void UpllDbConnMgr::WaitRoSlot(uint32_t home, uint32_t *index) {
+  pfc_timespec_t start, end;
+  pfc_clock_gettime(&start);
+  {
+    pfc::core::ScopedMutex lock(ro_wait_mutex_);
+    // ro_waiters_ is raised before the slots are scanned again, so a slot
+    // freed after the scan is always followed by a signal.
+    pfc_atomic_inc_uint32(&ro_waiters_);
+    while (!ClaimRoSlot(home, index)) {
+      ro_wait_cond_.wait(ro_wait_mutex_);
+    }
+    pfc_atomic_dec_uint32(&ro_waiters_);
+  }
+  pfc_clock_gettime(&end);
+
+  static const uint64_t bounds_usec[kRoWaitHistBuckets - 2] = {
+    100, 1000, 10000, 100000, 1000000
+  };
+  uint64_t wait_usec =
+      static_cast<uint64_t>(end.tv_sec - start.tv_sec) * 1000000 +
+      (end.tv_nsec - start.tv_nsec) / 1000;
+  uint32_t bucket = 1;
+  while (bucket < (kRoWaitHistBuckets - 1) &&
+         wait_usec >= bounds_usec[bucket - 1]) {
+    bucket++;
+  }
+  pfc_atomic_inc_uint64(&ro_wait_hist_[bucket]);
+}
+
+void UpllDbConnMgr::ReleaseRoSlot(uint32_t index) {
+  pfc_atomic_swap_uint32(&ro_slots_[index].state, kRoSlotFree);
+  if (ro_waiters_ != 0) {
+    pfc::core::ScopedMutex lock(ro_wait_mutex_);
+    ro_wait_cond_.signal();
+  }
+}
+
+// Only the owner of a busy slot changes its conn, the connection released by
+// this thread is therefore found reliably even while other slots change.
+uint32_t UpllDbConnMgr::FindRoSlot(const DalOdbcMgr *dom) {
+  uint32_t nslots = ro_slots_.size();
+  if (nslots == 0) {
+    return nslots;
+  }
+  uint32_t idx = GetRoHomeSlot();
+  for (uint32_t i = 0; i < nslots; i++) {
+    const RoConnSlot &slot = ro_slots_[idx];
+    if (slot.state == kRoSlotBusy && slot.conn != NULL &&
+        &slot.conn->dom == dom) {
+      return idx;
+    }
+    if (++idx == nslots) {
+      idx = 0;
+    }
+  }
+  return nslots;
+}
+
+// Caller owns the slot
+void UpllDbConnMgr::CloseRoConn(RoConnSlot *slot) {
+  DbConn *dbc = slot->conn;
+  if (dbc == NULL) {
+    return;
+  }
+  dbc->in_use_cnt = 0;
+  TerminateDbConn(dbc);
+  delete dbc;
+  slot->conn = NULL;
+  pfc_atomic_dec_uint32(&active_ro_conns_cnt_);
+}
+
+void UpllDbConnMgr::CheckRoConnHealth() {
+  UPLL_FUNC_TRACE;
+  uint32_t closed = 0;
+  for (uint32_t idx = 0; idx < ro_slots_.size(); idx++) {
+    RoConnSlot &slot = ro_slots_[idx];
+    if (slot.state != kRoSlotFree ||
+        pfc_atomic_cas_acq_uint32(&slot.state, kRoSlotBusy, kRoSlotFree) !=
+        kRoSlotFree) {
+      continue;
+    }
+    if (slot.conn != NULL &&
+        (slot.conn_gen != ro_conn_gen_ ||
+         slot.conn->dom.get_conn_state() == uudal::kDalDbDisconnected)) {
+      CloseRoConn(&slot);
+      closed++;
     }
+    ReleaseRoSlot(idx);
   }
-  if (active_ro_conns_cnt_ >= max_ro_conns_) {
-    UPLL_LOG_INFO("Error: Could not find a not-in-use connection");
+  if (closed > 0) {
+    UPLL_LOG_DEBUG("Closed %u idle DB RO connections", closed);
+  }
+}
+
+upll_rc_t UpllDbConnMgr::AcquireRoConn(DalOdbcMgr **dom) {
+  UPLL_FUNC_TRACE;
+  UPLL_LOG_DEBUG("Acquiring RO Connection");
+  if (ro_slots_.empty()) {
+    UPLL_LOG_INFO("Error: No RO connection is allowed");
     return UPLL_RC_ERR_GENERIC;
   }
 
-  // Create a new connection
-  upll_rc_t urc = UPLL_RC_SUCCESS;
-  DbConn *ro_conn = new DbConn(kRoConn);
-  if (UPLL_RC_SUCCESS != (urc = DalOpen(&ro_conn->dom, false))) {
-    delete ro_conn;
-    TerminateAllRoConns_NoLock();
-    return urc;
+  uint32_t home = GetRoHomeSlot();
+  uint32_t idx;
+  if (ClaimRoSlot(home, &idx)) {
+    pfc_atomic_inc_uint64(&ro_wait_hist_[0]);
+  } else {
+    WaitRoSlot(home, &idx);
+  }
+  pfc_atomic_inc_uint64(&ro_acquired_);
+  if (idx == home) {
+    pfc_atomic_inc_uint64(&ro_home_hits_);
   }
 
-  ro_conn_pool_.push_back(ro_conn);
-  active_ro_conns_cnt_++;
+  RoConnSlot &slot = ro_slots_[idx];
+  if (slot.conn != NULL && slot.conn_gen != ro_conn_gen_) {
+    UPLL_LOG_TRACE("Reopening stale RO connection of slot %u", idx);
+    CloseRoConn(&slot);
+  }
+  if (slot.conn == NULL) {
+    uint32_t gen = ro_conn_gen_;
+    DbConn *ro_conn = new DbConn(kRoConn);
+    upll_rc_t urc = DalOpen(&ro_conn->dom, false);
+    if (urc != UPLL_RC_SUCCESS) {
+      delete ro_conn;
+      ReleaseRoSlot(idx);
+      TerminateAllRoConns_NoLock();
+      return urc;
+    }
+    slot.conn = ro_conn;
+    slot.conn_gen = gen;
+    pfc_atomic_inc_uint32(&active_ro_conns_cnt_);
+    pfc_atomic_inc_uint64(&ro_reconnects_);
+  }
 
-  ro_conn->in_use_cnt = 1;
-  *dom = &ro_conn->dom;
+  slot.conn->in_use_cnt = 1;
+  *dom = &slot.conn->dom;
   return UPLL_RC_SUCCESS;
 }
 
 upll_rc_t UpllDbConnMgr::ReleaseRoConn(DalOdbcMgr *dom) {
   UPLL_FUNC_TRACE;
   UPLL_LOG_DEBUG("Releasing RO Connection");
-  pfc::core::ScopedMutex lock(conn_mutex_);
-  ConvertConnInfoToStr();
-  for (std::list<DbConn*>::iterator iter = ro_conn_pool_.begin();
-       iter != ro_conn_pool_.end(); iter++) {
-    if (&(*iter)->dom == dom) {
-      (*iter)->in_use_cnt = 0;
-      if ((*iter)->close_on_finish == true) {
-        TerminateDbConn(*iter);
-        DbConn *dbc = *iter;
-        delete dbc;
-        ro_conn_pool_.erase(iter);
-        active_ro_conns_cnt_--;
-        ro_conn_sem_.post();
-      } else {
-        // If dom had encountered connection error, close all RO connections
-        if (dom->get_conn_state() == uudal::kDalDbDisconnected) {
-          UPLL_LOG_TRACE("DB RO connection error, closing all RO connections");
-          TerminateAllRoConns_NoLock();
-        } else {
-          ro_conn_sem_.post();
-        }
-      }
-      ConvertConnInfoToStr();
-      return UPLL_RC_SUCCESS;
-    }
+  uint32_t idx = FindRoSlot(dom);
+  if (idx == ro_slots_.size()) {
+    ConvertConnInfoToStr();
+    UPLL_LOG_INFO("Error: connection not found");
+    return UPLL_RC_ERR_GENERIC;
+  }
+
+  RoConnSlot &slot = ro_slots_[idx];
+  slot.conn->in_use_cnt = 0;
+  // If dom had encountered connection error, close all RO connections
+  bool conn_error = (dom->get_conn_state() == uudal::kDalDbDisconnected);
+  if (conn_error || slot.conn_gen != ro_conn_gen_) {
+    CloseRoConn(&slot);
+  }
+  ReleaseRoSlot(idx);
+  if (conn_error) {
+    UPLL_LOG_TRACE("DB RO connection error, closing all RO connections");
+    TerminateAllRoConns_NoLock();
   }
   ConvertConnInfoToStr();
-  UPLL_LOG_INFO("Error: connection not found");
-  return UPLL_RC_ERR_GENERIC;
+  return UPLL_RC_SUCCESS;
+}
+
+void UpllDbConnMgr::GetRoConnStats(RoConnStats *stats) const {
+  stats->acquired = ro_acquired_;
+  stats->home_hits = ro_home_hits_;
+  stats->reconnects = ro_reconnects_;
+  for (uint32_t i = 0; i < kRoWaitHistBuckets; i++) {
+    stats->wait_hist[i] = ro_wait_hist_[i];
+  }
+}
+
+void UpllDbConnMgr::LogRoConnStats() const {
+  RoConnStats stats;
+  GetRoConnStats(&stats);
+  UPLL_LOG_INFO("DB RO connections: acquired=%" PFC_PFMT_u64
+                " home=%" PFC_PFMT_u64 " opened=%" PFC_PFMT_u64
+                " wait(none/<100us/<1ms/<10ms/<100ms/<1s/>=1s)="
+                "%" PFC_PFMT_u64 "/%" PFC_PFMT_u64 "/%" PFC_PFMT_u64
+                "/%" PFC_PFMT_u64 "/%" PFC_PFMT_u64 "/%" PFC_PFMT_u64
+                "/%" PFC_PFMT_u64,
+                stats.acquired, stats.home_hits, stats.reconnects,
+                stats.wait_hist[0], stats.wait_hist[1], stats.wait_hist[2],
+                stats.wait_hist[3], stats.wait_hist[4], stats.wait_hist[5],
+                stats.wait_hist[6]);
 }
                                                                        // NOLINT
 }  // namespace config_momgr
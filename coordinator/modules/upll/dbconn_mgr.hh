@@ -11,7 +11,9 @@
 #define UPLL_DBCONN_MGR_HH_
 
 #include <list>
+#include <vector>
 
+#include "pfc/atomic.h"
 #include "cxx/pfcxx/synch.hh"
 
 #include "unc/upll_errno.h"
@@ -26,12 +28,32 @@ namespace config_momgr {
 using unc::upll::dal::DalOdbcMgr;
 namespace uudal = unc::upll::dal;
 
+// Number of buckets of the RO connection acquire wait histogram
+const uint32_t kRoWaitHistBuckets = 7;
+
 class UpllDbConnMgr {
  public:
-  explicit UpllDbConnMgr(size_t max_ro_conns) : ro_conn_sem_(max_ro_conns) {
+  // RO connection statistics. wait_hist[0] counts the acquisitions which got
+  // a slot without waiting, the other buckets count the waits by duration:
+  // <100us, <1ms, <10ms, <100ms, <1s and longer.
+  struct RoConnStats {
+    uint64_t acquired;    // RO connections handed out
+    uint64_t home_hits;   // of which were taken from the worker's own slot
+    uint64_t reconnects;  // RO connections opened
+    uint64_t wait_hist[kRoWaitHistBuckets];
+  };
+
+  explicit UpllDbConnMgr(size_t max_ro_conns) : ro_slots_(max_ro_conns) {
     config_rw_conn_ = alarm_rw_conn_ = audit_rw_conn_ = NULL;
     max_ro_conns_ = max_ro_conns;
     active_ro_conns_cnt_= 0;
+    ro_conn_gen_ = 0;
+    ro_next_home_ = 0;
+    ro_waiters_ = 0;
+    ro_acquired_ = ro_home_hits_ = ro_reconnects_ = 0;
+    for (uint32_t i = 0; i < kRoWaitHistBuckets; i++) {
+      ro_wait_hist_[i] = 0;
+    }
   }
   void TerminateAndInitializeDbConns(bool active);
   // GetConfigRwConn() should be called after InitializeDbConnections()
@@ -48,6 +70,12 @@ class UpllDbConnMgr {
   inline size_t get_ro_conn_limit() const { return max_ro_conns_; }
   upll_rc_t AcquireRoConn(DalOdbcMgr **dom);
   upll_rc_t ReleaseRoConn(DalOdbcMgr *dom);
+  // Closes the idle RO connections which lost the database or were opened
+  // before the last reset. Busy slots are not waited for, their connections
+  // are checked by the owner on release.
+  void CheckRoConnHealth();
+  void GetRoConnStats(RoConnStats *stats) const;
+  void LogRoConnStats() const;
   // void DestroyRoConns();
   upll_rc_t DalOpen(DalOdbcMgr *dom, bool read_write_conn);
   upll_rc_t DalTxClose(DalOdbcMgr *dom, bool commit);
@@ -84,18 +112,52 @@ class UpllDbConnMgr {
   // at a time alarm_rw_conn_mutex_ is used.
   pfc::core::Mutex alarm_rw_conn_mutex_;
 
+  enum RoSlotState {
+    kRoSlotFree = 0,
+    kRoSlotBusy
+  };
+  // RO connection slot. A worker owns the slot, and may open or close its
+  // connection without any lock, from the time it moves state from
+  // kRoSlotFree to kRoSlotBusy until it stores kRoSlotFree again.
+  struct RoConnSlot {
+    RoConnSlot() : state(kRoSlotFree), conn_gen(0), conn(NULL) {}
+    uint32_t state;
+    uint32_t conn_gen;  // ro_conn_gen_ when conn was opened
+    DbConn *conn;       // not shared connection
+    // Keeps the slots of different workers on different cache lines
+    uint8_t pad[64 - (sizeof(uint32_t) * 2) - sizeof(DbConn *)];
+  };
+
   size_t max_ro_conns_;
-  size_t active_ro_conns_cnt_;
-  std::list<DbConn*> ro_conn_pool_;  // not shared connection
+  uint32_t active_ro_conns_cnt_;  // open RO connections
+  // Fixed at construction, one slot per allowed RO connection
+  std::vector<RoConnSlot> ro_slots_;
+  // Bumped to retire all the RO connections, a slot whose conn_gen differs
+  // reopens its connection on the next acquisition
+  uint32_t ro_conn_gen_;
+  uint32_t ro_next_home_;  // next home slot given to a worker thread
+  // Workers sleeping on ro_wait_cond_ because all the slots are busy
+  uint32_t ro_waiters_;
+  pfc::core::Mutex ro_wait_mutex_;
+  pfc::core::Condition ro_wait_cond_;
+  uint64_t ro_acquired_;
+  uint64_t ro_home_hits_;
+  uint64_t ro_reconnects_;
+  uint64_t ro_wait_hist_[kRoWaitHistBuckets];
   // stale_rw_conn_pool_: rw connections that need to be closed and destroyed
   std::list<DbConn*> stale_rw_conn_pool_;
   pfc::core::Mutex conn_mutex_;
-  pfc::core::Semaphore ro_conn_sem_;
 
   upll_rc_t InitializeDbConnectionsNoLock();
   upll_rc_t TerminateAllDbConnsNoLock();
   upll_rc_t TerminateDbConn(DbConn *dbc);
   upll_rc_t TerminateAllRoConns_NoLock();
+  uint32_t GetRoHomeSlot();
+  bool ClaimRoSlot(uint32_t home, uint32_t *index);
+  void WaitRoSlot(uint32_t home, uint32_t *index);
+  void ReleaseRoSlot(uint32_t index);
+  uint32_t FindRoSlot(const DalOdbcMgr *dom);
+  void CloseRoConn(RoConnSlot *slot);
 };
 
 }  // namespace config_momgr
@@ -82,27 +82,52 @@ ConfigKeyVal *ConfigKeyVal::FindNext(unc_key_type_t keytype) {
   return NULL;
 }
 
+size_t ConfigVal::GetStructSize(IpctSt::IpcStructNum st_num) {
+  const pfc_ipcstdef_t *st_def = IpctSt::GetIpcStdef(st_num);
+  if (st_def == NULL) {
+    if (st_num == IpctSt::kIpcStValConvertVbr)
+      return sizeof(val_convert_vbr_t);
+    return 0;
+  }
+  return st_def->ist_size;
+}
+
 // Note: shallow Dup
 ConfigVal *ConfigVal::DupVal() const {
+  return DupVal(NULL);
+}
+
+// Note: shallow Dup
+ConfigVal *ConfigVal::DupVal(ConfigKeyValArena *arena) const {
   ConfigVal *dup = new ConfigVal(st_num_, NULL);
   if (val_ != NULL) {
-    const pfc_ipcstdef_t *st_def = IpctSt::GetIpcStdef(st_num_);
-    if (st_def == NULL) {
-      if (st_num_ == IpctSt::kIpcStValConvertVbr) {
-        dup->val_ = ConfigKeyVal::Malloc(sizeof(val_convert_vbr_t));
-        memcpy(dup->val_, val_, sizeof(val_convert_vbr_t));
-        return dup;
-      }
+    size_t size = GetStructSize(st_num_);
+    if (size == 0) {
       UPLL_LOG_DEBUG("Unknown structure %d ", st_num_);
       delete dup;
       return NULL;
     }
-    dup->val_ = ConfigKeyVal::Malloc(st_def->ist_size);
-    memcpy(dup->val_, val_, st_def->ist_size);
+    if (arena != NULL) {
+      dup->val_ = arena->Alloc(size);
+      dup->arena_val_ = true;
+    } else {
+      dup->val_ = ConfigKeyVal::Malloc(size);
+    }
+    memcpy(dup->val_, val_, size);
   }
   return dup;
 }
 
+void ConfigVal::DetachFromArena() {
+  if (val_ != NULL) {
+    size_t size = GetStructSize(st_num_);
+    void *val = ConfigKeyVal::Malloc(size);
+    memcpy(val, val_, size);
+    val_ = val;
+  }
+  arena_val_ = false;
+}
+
 // Note: shallow Dup
 ConfigKeyVal *ConfigKeyVal::DupKey() const {
   return DupKeyVal(true, false);
@@ -132,6 +157,77 @@ ConfigKeyVal *ConfigKeyVal::DupKeyVal(bool dup_key, bool dup_val) const {
   return dup;
 }
 
+// Note: shallow Dup
+ConfigKeyVal *ConfigKeyVal::DupKeyVal(ConfigKeyValArena *arena) const {
+  if (arena == NULL)
+    return DupKeyVal(true, true);
+  ConfigKeyVal *dup = new ConfigKeyVal(key_type_, st_num_, NULL, NULL);
+  if (key_ != NULL) {
+    const pfc_ipcstdef_t *st_def = IpctSt::GetIpcStdef(st_num_);
+    if (st_def == NULL) {
+      UPLL_LOG_DEBUG("Unknown structure %d ", st_num_);
+      delete dup;
+      return NULL;
+    }
+    dup->key_ = arena->Alloc(st_def->ist_size);
+    dup->arena_key_ = true;
+    memcpy(dup->key_, key_, st_def->ist_size);
+  }
+  // Only the first val is dupped, as DupKeyVal(true, true) does
+  if (cfg_val_ != NULL) {
+    dup->cfg_val_ = cfg_val_->DupVal(arena);
+  }
+  return dup;
+}
+
+void *ConfigKeyValArena::Alloc(size_t size) throw(std::bad_alloc) {
+  // Keep the structures 8 byte aligned
+  size = (size + 7) & ~static_cast<size_t>(7);
+  if (size > left_) {
+    size_t block_size = (size > block_size_) ? size : block_size_;
+    char *block = reinterpret_cast<char *>(malloc(block_size));
+    if (block == NULL) {
+      throw new std::bad_alloc;
+    }
+    blocks_.push_back(block);
+    cur_ = block;
+    left_ = block_size;
+  }
+  void *ptr = cur_;
+  memset(ptr, 0, size);
+  cur_ += size;
+  left_ -= size;
+  allocated_ += size;
+  return ptr;
+}
+
+void ConfigKeyValArena::Clear() {
+  for (std::vector<char *>::iterator it = blocks_.begin();
+       it != blocks_.end(); ++it) {
+    free(*it);
+  }
+  blocks_.clear();
+  cur_ = NULL;
+  left_ = 0;
+  allocated_ = 0;
+}
+
+void ConfigKeyValChain::Append(ConfigKeyVal *ckv) {
+  if (ckv == NULL)
+    return;
+  if (tail_ == NULL) {
+    head_ = ckv;
+  } else {
+    tail_->set_next_cfg_key_val(ckv);
+  }
+  // Only the appended chain is walked to find the new tail
+  tail_ = ckv;
+  size_++;
+  while (tail_->get_next_cfg_key_val() != NULL) {
+    tail_ = tail_->get_next_cfg_key_val();
+    size_++;
+  }
+}
 
 std::string ConfigKeyVal::ToStr() const {
   std::stringstream ss;
@@ -13,6 +13,7 @@
 #include <string>
 #include <map>
 #include <list>
+#include <vector>
 
 #include "pfcxx/synch.hh"
 
@@ -57,6 +58,37 @@ typedef struct key_user_data {
   uint8_t flags;
 } key_user_data_t;
 
+// Bump allocator for the key and val structures of short lived ConfigKeyVals,
+// e.g. the ones built for a single read response. All the memory is released
+// at once when the arena is destroyed.
+// ConfigKeyVal and ConfigVal created by DupKeyVal(arena) and DupVal(arena) do
+// not free their key and val structures, and the arena must outlive them.
+class ConfigKeyValArena {
+ public:
+  static const size_t kDefaultBlockSize = 64 * 1024;
+
+  explicit ConfigKeyValArena(size_t block_size = kDefaultBlockSize)
+      : block_size_(block_size), cur_(NULL), left_(0), allocated_(0) {}
+  ~ConfigKeyValArena() { Clear(); }
+
+  // Returns zeroed memory of the given size. Throws std::bad_alloc as
+  // ConfigKeyVal::Malloc does.
+  void *Alloc(size_t size) throw(std::bad_alloc);
+  // Frees all the memory given by the arena
+  void Clear();
+
+  inline size_t get_allocated_bytes() const { return allocated_; }
+  inline size_t get_num_blocks() const { return blocks_.size(); }
+
+ private:
+  size_t block_size_;
+  std::vector<char *> blocks_;
+  char *cur_;
+  size_t left_;
+  size_t allocated_;
+  DISALLOW_COPY_AND_ASSIGN(ConfigKeyValArena);
+};
+
 // NOTE: ConfigVal assumes the pointers passed in to this class are allocated
 // with Malloc() function and calls free() for freeing the memory.
 // ConfigVal does not make duplicate memory for the pointers passed.
@@ -68,9 +100,10 @@ class ConfigVal {
     val_ = val;
     next_cfg_val_ = NULL;
     user_data_ = NULL;
+    arena_val_ = false;
   }
   inline virtual ~ConfigVal() {
-    if (val_)
+    if (val_ && !arena_val_)
       free(val_);
     val_ = NULL;
     if (user_data_)
@@ -81,14 +114,18 @@ class ConfigVal {
   inline IpctSt::IpcStructNum get_st_num() const { return st_num_; }
   inline void *get_val() const { return val_; }
   inline void *GetValAndUnlink() {
+    // Caller frees the val; arena memory cannot be handed over
+    if (arena_val_)
+      DetachFromArena();
     void *t = val_;
     val_ = NULL;
     return t;
   }
   inline void SetVal(IpctSt::IpcStructNum st_num, void *val) {
     st_num_ = st_num;
-    if (val_) free(val_);
+    if (val_ && !arena_val_) free(val_);
     val_ = val;
+    arena_val_ = false;
   }
   inline ConfigVal *get_next_cfg_val() const { return next_cfg_val_; }
   inline void AppendCfgVal(IpctSt::IpcStructNum st_num, void *val) {
@@ -115,16 +152,25 @@ class ConfigVal {
   // Only dups val structure, nothing else.
   // Note: shallow Dup
   ConfigVal *DupVal() const;
+  // Same as DupVal, val structure is allocated from the arena
+  ConfigVal *DupVal(ConfigKeyValArena *arena) const;
 
   std::string ToStr() const;
   std::string ToStrAll() const;
 
+  // Size of the key or val structure of the given number, 0 if unknown
+  static size_t GetStructSize(IpctSt::IpcStructNum st_num);
+
  private:
+  // Replaces val structure in arena by a copy allocated with Malloc
+  void DetachFromArena();
+
   // std::string ipc_struct_name_;
   IpctSt::IpcStructNum st_num_;
   void *val_;  // { allocated with new operator and points to ipc_struct }
   ConfigVal *next_cfg_val_;  // { allocated with new operator }
   void *user_data_;    // Any data that user wants to store; user manages it
+  bool arena_val_;     // val_ is owned by a ConfigKeyValArena
   DISALLOW_COPY_AND_ASSIGN(ConfigVal);
 };
 
@@ -142,9 +188,10 @@ class ConfigKeyVal {
     cfg_val_ = cv;
     next_ckv_ = NULL;
     user_data_ = NULL;
+    arena_key_ = false;
   }
   virtual ~ConfigKeyVal() {
-    if (key_)
+    if (key_ && !arena_key_)
       free(key_);
     key_ = NULL;
     DeleteCfgVal();
@@ -160,8 +207,9 @@ class ConfigKeyVal {
 
   inline void SetKey(IpctSt::IpcStructNum st_num, void *key) {
     st_num_ = st_num;
-    if (key_) free(key_);
+    if (key_ && !arena_key_) free(key_);
     key_ = key;
+    arena_key_ = false;
   }
 
   inline void SetUserData(void *user_data) {
@@ -254,6 +302,9 @@ class ConfigKeyVal {
   ConfigKeyVal *DupKeyVal() const;
   // Note: shallow Dup
   ConfigKeyVal *DupKeyVal(bool dup_key, bool dup_val) const;
+  // Same as DupKeyVal, key and val structures are allocated from the arena.
+  // Note: shallow Dup
+  ConfigKeyVal *DupKeyVal(ConfigKeyValArena *arena) const;
 
   /**
    * Moves data from the argumnent to this instance
@@ -261,6 +312,7 @@ class ConfigKeyVal {
   void ResetWith(ConfigKeyVal *from) {
     this->key_type_ = from->key_type_;
     SetKey(from->st_num_, from->key_);
+    arena_key_ = from->arena_key_;
     from->key_ = NULL;
     SetUserData(from->user_data_);
     from->user_data_ = NULL;
@@ -277,6 +329,7 @@ class ConfigKeyVal {
   void ResetWithoutNextCkv(ConfigKeyVal *from) {
     this->key_type_ = from->key_type_;
     SetKey(from->st_num_, from->key_);
+    arena_key_ = from->arena_key_;
     from->key_ = NULL;
     SetUserData(from->user_data_);
     from->user_data_ = NULL;
@@ -309,9 +362,46 @@ class ConfigKeyVal {
   ConfigVal *cfg_val_;  // { allocated with new operator }
   ConfigKeyVal *next_ckv_;  // { allocated with new operator }
   void *user_data_;    // Any data that user wants to store; user manages it
+  bool arena_key_;     // key_ is owned by a ConfigKeyValArena
   DISALLOW_COPY_AND_ASSIGN(ConfigKeyVal);
 };
 
+// Builds a ConfigKeyVal chain with O(1) append at the tail.
+// The chain still held by the builder is deleted with it; use Release() to
+// hand it over.
+class ConfigKeyValChain {
+ public:
+  ConfigKeyValChain() : head_(NULL), tail_(NULL), size_(0) {}
+  ~ConfigKeyValChain() { Clear(); }
+
+  // Appends ckv and the chain following it, if any
+  void Append(ConfigKeyVal *ckv);
+
+  inline ConfigKeyVal *head() const { return head_; }
+  inline ConfigKeyVal *tail() const { return tail_; }
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return (head_ == NULL); }
+
+  inline ConfigKeyVal *Release() {
+    ConfigKeyVal *head = head_;
+    head_ = tail_ = NULL;
+    size_ = 0;
+    return head;
+  }
+  inline void Clear() {
+    if (head_)
+      delete head_;
+    head_ = tail_ = NULL;
+    size_ = 0;
+  }
+
+ private:
+  ConfigKeyVal *head_;
+  ConfigKeyVal *tail_;
+  size_t size_;
+  DISALLOW_COPY_AND_ASSIGN(ConfigKeyValChain);
+};
+
 class ConfigNotification {
  public:
   // {New and old(optional) values can be given in keyval}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2014 NEC Corporation
+ * Copyright (c) 2012-2015 NEC Corporation
  * All rights reserved.
  *
  * This program and the accompanying materials are made available under the
@@ -145,15 +145,65 @@ void KeyTree::PrepareOrderedList() {
   unc_key_type_t kt;
   preorder_list_.clear();
   reverse_preorder_list_.clear();
+  dependencies_.clear();
   KeyTree::PreorderIterator *it = GetPreorderIterator();
   while (it->Next(&kt)) {
     UPLL_LOG_VERBOSE("pushing kt %d", static_cast<int>(kt));
     preorder_list_.push_back(kt);
     reverse_preorder_list_.push_front(kt);
+    std::set<unc_key_type_t> &deps = dependencies_[kt];
+    KeyTreeNode *parent = GetNode(kt)->parent;
+    if (parent != GetRoot()) {
+      deps.insert(parent->key_type);
+    }
   }
   delete it;
 }
 
+bool KeyTree::AddDependency(unc_key_type_t kt, unc_key_type_t required_kt) {
+  std::map<unc_key_type_t, std::set<unc_key_type_t> >::iterator it =
+      dependencies_.find(kt);
+  if (it == dependencies_.end() ||
+      dependencies_.find(required_kt) == dependencies_.end()) {
+    UPLL_LOG_DEBUG("KT %d or %d is not in the ordered list", kt, required_kt);
+    return false;
+  }
+  for (list<unc_key_type_t>::const_iterator lit = preorder_list_.begin();
+       lit != preorder_list_.end(); ++lit) {
+    if (*lit == kt) {
+      break;
+    }
+    if (*lit == required_kt) {
+      it->second.insert(required_kt);
+      return true;
+    }
+  }
+  UPLL_LOG_DEBUG("KT %d does not come before %d", required_kt, kt);
+  return false;
+}
+
+bool KeyTree::AddSubtreeDependency(unc_key_type_t kt,
+                                   unc_key_type_t required_kt) {
+  if (!AddDependency(kt, required_kt)) {
+    return false;
+  }
+  const KeyTreeNode *node = GetNode(required_kt);
+  for (list<KeyTreeNode*>::const_iterator it = node->children.begin();
+       it != node->children.end(); ++it) {
+    if (!AddSubtreeDependency(kt, (*it)->key_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const std::set<unc_key_type_t> *KeyTree::get_dependencies(
+    unc_key_type_t kt) const {
+  std::map<unc_key_type_t, std::set<unc_key_type_t> >::const_iterator it =
+      dependencies_.find(kt);
+  return (it != dependencies_.end()) ? &it->second : NULL;
+}
+
 // This function does not traverse root node
 bool KeyTree::PreorderIterator::Next(unc_key_type_t *next_key_type) {
   if (next_key_type == NULL)
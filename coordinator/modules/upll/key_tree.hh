@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2014 NEC Corporation
+ * Copyright (c) 2012-2015 NEC Corporation
  * All rights reserved.
  *
  * This program and the accompanying materials are made available under the
@@ -13,6 +13,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <set>
 
 #include "unc/keytype.h"
 
@@ -78,6 +79,16 @@ class KeyTree {
   const std::list<unc_key_type_t> *get_reverse_postorder_list() {
     return &reverse_preorder_list_;
   }
+  // Makes the instances of kt depend on the instances of required_kt,
+  // besides their parent, e.g. when kt refers to required_kt by name.
+  // required_kt must come before kt in the preorder list, so the
+  // dependencies never form a cycle. Call after PrepareOrderedList().
+  bool AddDependency(unc_key_type_t kt, unc_key_type_t required_kt);
+  // Same as AddDependency() for required_kt and all its descendants
+  bool AddSubtreeDependency(unc_key_type_t kt, unc_key_type_t required_kt);
+  // Key types which kt depends on: its parent, unless it is the root, and
+  // the ones added by AddDependency()
+  const std::set<unc_key_type_t> *get_dependencies(unc_key_type_t kt) const;
   bool GetFirstChild(unc_key_type_t parent_kt, unc_key_type_t *child_kt) const;
   bool GetNextSibling(unc_key_type_t kt, unc_key_type_t *next_sibling_kt) const;
   bool GetParent(unc_key_type_t kt, unc_key_type_t *parent_kt);
@@ -99,6 +110,7 @@ class KeyTree {
   std::map<unc_key_type_t, KeyTreeNode*> all_kt_map_;
   std::list<unc_key_type_t> preorder_list_;
   std::list<unc_key_type_t> reverse_preorder_list_;
+  std::map<unc_key_type_t, std::set<unc_key_type_t> > dependencies_;
 };
 
 }  // namespace keytree
@@ -39,6 +39,15 @@ namespace kt_momgr {
 std::map<std::string, std::string> MoMgrImpl::auto_rename_;
 std::map<std::string, std::string> MoMgrImpl::audit_auto_rename_;
 bool MoMgrImpl::import_unified_exists_;
+pfc::core::Mutex MoMgrImpl::rename_cache_lock_;
+std::vector<uud::DalOdbcMgr *> MoMgrImpl::rename_cache_conns_;
+std::vector<uint64_t> MoMgrImpl::rename_cache_generations_;
+bool MoMgrImpl::rename_cache_shared_ = false;
+uint64_t MoMgrImpl::rename_cache_epoch_ = 0;
+std::map<std::string, MoMgrImpl::RenameCacheEntry> MoMgrImpl::rename_cache_;
+pfc::core::Mutex MoMgrImpl::tx_change_log_lock_;
+bool MoMgrImpl::tx_change_log_enabled_ = false;
+std::map<unc_key_type_t, MoMgrImpl::TxChangeLog *> MoMgrImpl::tx_change_logs_;
 
 #define SET_FLAG_NO_VLINK_PORTMAP 0x9F
 #define KEY_TYPE_BIND_CS(key_type)\
@@ -846,8 +855,10 @@ upll_rc_t MoMgrImpl::ReadSiblingMo(IpcReqRespHeader *header,
         if (header->option1 == UNC_OPT1_NORMAL) {
           if (end_resp_ckv == NULL) {
             end_resp_ckv = ikey;
+            end_resp_ckv_tail = end_resp_ckv;
           } else {
-            end_resp_ckv->AppendCfgKeyVal(one_ckv);
+            end_resp_ckv_tail->AppendCfgKeyVal(one_ckv);
+            end_resp_ckv_tail = one_ckv;
           }
           continue;
         }
@@ -1692,6 +1703,175 @@ upll_rc_t MoMgrImpl::TxClearCreateUpdateFlag(unc_key_type_t keytype,
   return UPLL_RC_SUCCESS;
 }
 
+int MoMgrImpl::TxChangeLogIndex(unc_keytype_operation_t op) {
+  return (op == UNC_OP_DELETE) ? 0 : ((op == UNC_OP_CREATE) ? 1 : 2);
+}
+
+void MoMgrImpl::StartTxChangeLog() {
+  pfc::core::ScopedMutex lock(tx_change_log_lock_);
+  tx_change_log_enabled_ = true;
+}
+
+void MoMgrImpl::StopTxChangeLog() {
+  pfc::core::ScopedMutex lock(tx_change_log_lock_);
+  tx_change_log_enabled_ = false;
+  for (std::map<unc_key_type_t, TxChangeLog *>::iterator it =
+       tx_change_logs_.begin(); it != tx_change_logs_.end(); ++it) {
+    DeleteTxChangeLog(it->second);
+  }
+  tx_change_logs_.clear();
+}
+
+void MoMgrImpl::DeleteTxChangeLog(TxChangeLog *log) {
+  if (log == NULL)
+    return;
+  for (int i = 0; i < 3; i++) {
+    std::list<std::pair<ConfigKeyVal *, ConfigKeyVal *> >::iterator it;
+    for (it = log->changes[i].begin(); it != log->changes[i].end(); ++it) {
+      DELETE_IF_NOT_NULL(it->first);
+      DELETE_IF_NOT_NULL(it->second);
+    }
+  }
+  delete log;
+}
+
+upll_rc_t MoMgrImpl::ReadTxChangeLog(DalDmlIntf *dmi, TxChangeLog *log) {
+  UPLL_FUNC_TRACE;
+  const uudst::kDalTableIndex tbl_index = GetTable(MAINTBL,
+                                                   UPLL_DT_CANDIDATE);
+  if (tbl_index >= uudst::kDalNumTables) {
+    UPLL_LOG_DEBUG(" Invalid Table index - %d", tbl_index);
+    return UPLL_RC_ERR_GENERIC;
+  }
+  ConfigKeyVal *req = NULL;
+  upll_rc_t result_code = GetChildConfigKey(req, NULL);
+  if (result_code != UPLL_RC_SUCCESS) {
+    UPLL_LOG_ERROR("Error from GetGetChildConfigKey for table(%d)", tbl_index);
+    return result_code;
+  }
+  // Same columns as DiffConfigDB() reads, for both candidate and running
+  DbSubOp dbop = { kOpReadDiff, kOpMatchNone,
+                   kOpInOutFlag | kOpInOutCtrlr | kOpInOutDomain };
+  DalBindInfo *binfo = new DalBindInfo(tbl_index);
+  result_code = BindAttr(binfo, req, UNC_OP_READ, UPLL_DT_CANDIDATE, dbop,
+                         MAINTBL);
+  if (result_code != UPLL_RC_SUCCESS) {
+    UPLL_LOG_DEBUG("Error from BindAttr for table(%d)", tbl_index);
+    delete binfo;
+    DELETE_IF_NOT_NULL(req);
+    return result_code;
+  }
+  int16_t change = 0;
+  DalCursor *cursor = NULL;
+  result_code = DalToUpllResCode(dmi->GetChangedRecords(
+          UPLL_DT_CANDIDATE, UPLL_DT_RUNNING, tbl_index, 0, binfo, &change,
+          &cursor, TC_CONFIG_GLOBAL, NULL));
+  if (result_code != UPLL_RC_SUCCESS) {
+    delete binfo;
+    DELETE_IF_NOT_NULL(req);
+    // Nothing changed in the table
+    return (result_code == UPLL_RC_ERR_NO_SUCH_INSTANCE) ?
+        UPLL_RC_SUCCESS : result_code;
+  }
+  std::list<std::pair<ConfigKeyVal *, ConfigKeyVal *> > &updated =
+      log->changes[TxChangeLogIndex(UNC_OP_UPDATE)];
+  while ((result_code = DalToUpllResCode(dmi->GetNextRecord(cursor))) ==
+         UPLL_RC_SUCCESS) {
+    ConfigKeyVal *ckv = NULL;
+    result_code = DupConfigKeyVal(ckv, req);
+    if (result_code != UPLL_RC_SUCCESS) {
+      UPLL_LOG_INFO("DupConfigKeyVal failed %d", result_code);
+      break;
+    }
+    if (change == uud::kDalChangeUpdatedOld) {
+      // Running row following the candidate row of the same key
+      if (updated.empty() || updated.back().second != NULL) {
+        UPLL_LOG_INFO("Running row without updated row in table(%d)",
+                      tbl_index);
+        delete ckv;
+        result_code = UPLL_RC_ERR_GENERIC;
+        break;
+      }
+      updated.back().second = ckv;
+      continue;
+    }
+    unc_keytype_operation_t op = (change == uud::kDalChangeDeleted) ?
+        UNC_OP_DELETE : ((change == uud::kDalChangeCreated) ?
+                         UNC_OP_CREATE : UNC_OP_UPDATE);
+    log->changes[TxChangeLogIndex(op)].push_back(
+        std::make_pair(ckv, static_cast<ConfigKeyVal *>(NULL)));
+  }
+  dmi->CloseCursor(cursor, true);
+  DELETE_IF_NOT_NULL(req);
+  if (result_code != UPLL_RC_ERR_NO_SUCH_INSTANCE) {
+    return result_code;
+  }
+  // Every updated row is sent with the running row it replaces
+  std::list<std::pair<ConfigKeyVal *, ConfigKeyVal *> >::iterator it;
+  for (it = updated.begin(); it != updated.end(); ++it) {
+    if (it->second == NULL) {
+      UPLL_LOG_INFO("Updated row without running row in table(%d)",
+                    tbl_index);
+      return UPLL_RC_ERR_GENERIC;
+    }
+  }
+  UPLL_LOG_DEBUG("Table(%d) changes: %" PFC_PFMT_SIZE_T " deleted, %"
+                 PFC_PFMT_SIZE_T " created, %" PFC_PFMT_SIZE_T " updated",
+                 tbl_index, log->changes[0].size(), log->changes[1].size(),
+                 updated.size());
+  return UPLL_RC_SUCCESS;
+}
+
+MoMgrImpl::TxChangeLog *MoMgrImpl::GetTxChangeLog(unc_key_type_t keytype,
+                                                  DalDmlIntf *dmi) {
+  UPLL_FUNC_TRACE;
+  {
+    pfc::core::ScopedMutex lock(tx_change_log_lock_);
+    if (!tx_change_log_enabled_) {
+      return NULL;
+    }
+    std::map<unc_key_type_t, TxChangeLog *>::iterator it =
+        tx_change_logs_.find(keytype);
+    if (it != tx_change_logs_.end()) {
+      return it->second;
+    }
+  }
+  // The phases of a key type run one after another, so only one of them
+  // reads the log, without holding the lock
+  TxChangeLog *log = new TxChangeLog;
+  upll_rc_t result_code = ReadTxChangeLog(dmi, log);
+  if (result_code != UPLL_RC_SUCCESS) {
+    // e.g. the table cannot be read by one query, DiffConfigDB() reads it
+    UPLL_LOG_INFO("Change log of keytype %d not read %d, using diff",
+                  keytype, result_code);
+    DeleteTxChangeLog(log);
+    log = NULL;
+  }
+  pfc::core::ScopedMutex lock(tx_change_log_lock_);
+  if (!tx_change_log_enabled_) {
+    DeleteTxChangeLog(log);
+    return NULL;
+  }
+  tx_change_logs_[keytype] = log;
+  return log;
+}
+
+upll_rc_t MoMgrImpl::NextTxChange(TxChangeLog *log,
+                                  unc_keytype_operation_t op,
+                                  ConfigKeyVal *&req, ConfigKeyVal *&nreq) {
+  std::list<std::pair<ConfigKeyVal *, ConfigKeyVal *> > &changes =
+      log->changes[TxChangeLogIndex(op)];
+  DELETE_IF_NOT_NULL(req);
+  DELETE_IF_NOT_NULL(nreq);
+  if (changes.empty()) {
+    return UPLL_RC_ERR_NO_SUCH_INSTANCE;
+  }
+  req = changes.front().first;
+  nreq = changes.front().second;
+  changes.pop_front();
+  return UPLL_RC_SUCCESS;
+}
+
 upll_rc_t MoMgrImpl::TxUpdateController(unc_key_type_t keytype,
                                         uint32_t session_id,
                                         uint32_t config_id,
@@ -1767,9 +1947,18 @@ upll_rc_t MoMgrImpl::TxUpdateController(unc_key_type_t keytype,
   // candidate configuration and running configuration where 'req' parameter
   // contains the candidate information and
   // the 'nreq' parameter contains the running configuration.
-  result_code = DiffConfigDB(UPLL_DT_CANDIDATE, UPLL_DT_RUNNING,
-                             op, req, nreq, &dal_cursor_handle, dmi,
-                             config_mode, vtn_name, MAINTBL);
+  // In the global mode they are read once for all the phases.
+  TxChangeLog *change_log = (config_mode == TC_CONFIG_GLOBAL) ?
+      GetTxChangeLog(keytype, dmi) : NULL;
+  // op may be changed for the driver below
+  const unc_keytype_operation_t phase_op = op;
+  if (change_log) {
+    result_code = UPLL_RC_SUCCESS;
+  } else {
+    result_code = DiffConfigDB(UPLL_DT_CANDIDATE, UPLL_DT_RUNNING,
+                               op, req, nreq, &dal_cursor_handle, dmi,
+                               config_mode, vtn_name, MAINTBL);
+  }
   while (result_code == UPLL_RC_SUCCESS) {
     if (tx_util->GetErrCount() > 0) {
       UPLL_LOG_ERROR("TxUpdateUtil says exit the loop.");
@@ -1780,8 +1969,12 @@ upll_rc_t MoMgrImpl::TxUpdateController(unc_key_type_t keytype,
     }
 
     // Iterate loop to get next record
-    db_result = dmi->GetNextRecord(dal_cursor_handle);
-    result_code = DalToUpllResCode(db_result);
+    if (change_log) {
+      result_code = NextTxChange(change_log, phase_op, req, nreq);
+    } else {
+      db_result = dmi->GetNextRecord(dal_cursor_handle);
+      result_code = DalToUpllResCode(db_result);
+    }
     if (result_code != UPLL_RC_SUCCESS) {
       UPLL_LOG_DEBUG(" GetNextRecord failed err code(%d)", result_code);
       break;
@@ -10070,19 +10263,20 @@ upll_rc_t MoMgrImpl::ResetPortMapVlinkFlag(ConfigKeyVal *ikey,
     GET_USER_DATA_FLAGS(temp_okey, flag);
     flag &= SET_FLAG_NO_VLINK_PORTMAP;
     SET_USER_DATA_FLAGS(temp_okey, flag);
-    DbSubOp dbop1 = { kOpNotRead, kOpMatchNone, kOpInOutFlag };
-    std::string temp_vtn_name = "";
-    result_code = UpdateConfigDB(temp_okey, dt_type, UNC_OP_UPDATE,
-                                 dmi, &dbop1, TC_CONFIG_GLOBAL,
-                                 temp_vtn_name, MAINTBL);
-    if (UPLL_RC_SUCCESS != result_code) {
-      UPLL_LOG_ERROR("ResetPortMapVlinkFlag UpdateConfigDB failed %d",
-                     result_code);
-      DELETE_IF_NOT_NULL(okey);
-      return result_code;
-    }
     temp_okey = temp_okey->get_next_cfg_key_val();
   }
+  // All the rows read above are updated with a single bulk DAL call
+  DbSubOp dbop1 = { kOpNotRead, kOpMatchNone, kOpInOutFlag };
+  std::string temp_vtn_name = "";
+  result_code = UpdateConfigDBBulk(okey, dt_type, UNC_OP_UPDATE,
+                                   dmi, &dbop1, TC_CONFIG_GLOBAL,
+                                   temp_vtn_name, MAINTBL);
+  if (UPLL_RC_SUCCESS != result_code) {
+    UPLL_LOG_ERROR("ResetPortMapVlinkFlag UpdateConfigDB failed %d",
+                   result_code);
+    DELETE_IF_NOT_NULL(okey);
+    return result_code;
+  }
   DELETE_IF_NOT_NULL(okey);
   return UPLL_RC_SUCCESS;
 }
@@ -18,6 +18,8 @@
 #include <cstring>
 #include <list>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "unc/keytype.h"
 #include "unc/pfcdriver_include.h"
@@ -707,6 +709,57 @@ class Table {
 
 class MoMgrImpl : public MoManager {
  private:
+  // Result of IsRenamed() cached by StartRenameCache()
+  struct RenameCacheEntry {
+    bool has_user_data;
+    key_user_data_t user_data;
+  };
+  // Builds the id of the IsRenamed() read, returns false if not cached
+  bool GetRenameCacheId(ConfigKeyVal *ikey, upll_keytype_datatype_t dt_type,
+                        DalDmlIntf *dmi, std::string *id);
+  // On a miss *epoch is set for StoreRenameCache(), which drops the result
+  // if the cache was invalidated in between
+  static bool LookupRenameCache(const std::string &id, ConfigKeyVal *ikey,
+                                uint8_t &rename, uint64_t *epoch);
+  static void StoreRenameCache(const std::string &id, ConfigKeyVal *okey,
+                               uint64_t epoch);
+
+  // Drops the cached results if a connection wrote since they were read
+  static bool CheckRenameCacheGenerations();
+
+  static pfc::core::Mutex rename_cache_lock_;
+  // Connections of the commit and their write generations when the cached
+  // results were read
+  static std::vector<uud::DalOdbcMgr *> rename_cache_conns_;
+  static std::vector<uint64_t> rename_cache_generations_;
+  // Whether the first connection sees the same rows as the other ones
+  static bool rename_cache_shared_;
+  // Incremented whenever the cached results are dropped
+  static uint64_t rename_cache_epoch_;
+  static std::map<std::string, RenameCacheEntry> rename_cache_;
+
+  // Rows of a key type changed by the commit, read by ReadTxChangeLog(),
+  // per operation in the order of TxChangeLogIndex()
+  struct TxChangeLog {
+    // Candidate row and, on update, the running row it replaces
+    std::list<std::pair<ConfigKeyVal *, ConfigKeyVal *> > changes[3];
+  };
+  static int TxChangeLogIndex(unc_keytype_operation_t op);
+  // Reads the deleted, created and updated rows of MAINTBL in one query
+  upll_rc_t ReadTxChangeLog(DalDmlIntf *dmi, TxChangeLog *log);
+  // Returns the change log of keytype, read at the first call of the
+  // commit, or NULL if the changes are read by DiffConfigDB()
+  TxChangeLog *GetTxChangeLog(unc_key_type_t keytype, DalDmlIntf *dmi);
+  // Moves the next change of op from log to req and nreq, like
+  // GetNextRecord() on the cursor of DiffConfigDB()
+  static upll_rc_t NextTxChange(TxChangeLog *log, unc_keytype_operation_t op,
+                                ConfigKeyVal *&req, ConfigKeyVal *&nreq);
+  static void DeleteTxChangeLog(TxChangeLog *log);
+
+  static pfc::core::Mutex tx_change_log_lock_;
+  static bool tx_change_log_enabled_;
+  static std::map<unc_key_type_t, TxChangeLog *> tx_change_logs_;
+
   upll_rc_t CreateImportMoImpl(IpcReqRespHeader *req,
                            ConfigKeyVal *ikey,
                            DalDmlIntf *dmi,
@@ -1311,6 +1364,33 @@ class MoMgrImpl : public MoManager {
                       upll_keytype_datatype_t dt_type,
                       DalDmlIntf *dmi,
                       uint8_t &rename);
+  /**
+   * @brief      Starts caching the results of IsRenamed() read on conns.
+   * The rows of a key type sent to the controllers share a few parents,
+   * so TxUpdateController() reads the same parent for each of them.
+   * Cached results are dropped whenever a connection writes to the
+   * database, commits or rolls back. Results read on the first connection
+   * are shared with the other ones only if it has no pending writes.
+   *
+   * @param[in]      conns    config RW connection of the commit, followed
+   *                          by the RO connections of TxUpdateController()
+   */
+  static void StartRenameCache(const std::vector<uud::DalOdbcMgr *> &conns);
+  /**
+   * @brief      Stops caching the results of IsRenamed().
+   */
+  static void StopRenameCache();
+  /**
+   * @brief      Makes TxUpdateController() read all the changes of a key
+   * type with one query at its first phase and keep them for the next
+   * phases, instead of diffing candidate and running for every phase.
+   * Only the global config mode uses it.
+   */
+  static void StartTxChangeLog();
+  /**
+   * @brief      Releases the changes kept since StartTxChangeLog().
+   */
+  static void StopTxChangeLog();
   upll_rc_t UpdateConfigDB(ConfigKeyVal *ikey,
                            upll_keytype_datatype_t dt_type,
                            unc_keytype_operation_t op,
@@ -1337,6 +1417,45 @@ class MoMgrImpl : public MoManager {
                            TcConfigMode cfg_mode,
                            string vtn_name,
                            MoMgrTables tbl = MAINTBL);
+  /**
+   * @brief      Creates or updates all the keys chained through
+   *             get_next_cfg_key_val with a single bulk DAL call.
+   *             Callers with many keys of the same shape (import, merge)
+   *             can use it in place of calling UpdateConfigDB per key.
+   *
+   * @param[in]  ikey      head of the ConfigKeyVal chain
+   * @param[in]  dt_type   specifies the configuration type
+   * @param[in]  op        UNC_OP_CREATE or UNC_OP_UPDATE
+   * @param[in]  dmi       specifies the db connection info
+   * @param[in]  pdbop     db operation, NULL for the UpdateConfigDB default
+   * @param[in]  cfg_mode  configuration mode
+   * @param[in]  vtn_name  vtn name in vtn config mode
+   * @param[in]  tbl       specifies the table
+   *
+   * @retval     UPLL_RC_SUCCESS   all the keys are written
+   * @retval     result code of the first key which failed otherwise
+   */
+  upll_rc_t UpdateConfigDBBulk(ConfigKeyVal *ikey,
+                               upll_keytype_datatype_t dt_type,
+                               unc_keytype_operation_t op,
+                               DalDmlIntf *dmi,
+                               DbSubOp *pdbop,
+                               TcConfigMode cfg_mode,
+                               string vtn_name,
+                               MoMgrTables tbl = MAINTBL);
+  /**
+   * @brief      Fills the DbSubOp used by UpdateConfigDB when the caller
+   *             does not pass one.
+   *
+   * @param[in]  op        UNC_OP_CREATE, UNC_OP_UPDATE or UNC_OP_DELETE
+   * @param[in]  dt_type   specifies the configuration type
+   * @param[in]  tbl       specifies the table
+   * @param[out] dbop      default db operation
+   */
+  static void GetDefaultUpdateDbop(unc_keytype_operation_t op,
+                                   upll_keytype_datatype_t dt_type,
+                                   MoMgrTables tbl,
+                                   DbSubOp *dbop);
   upll_rc_t DiffConfigDB(upll_keytype_datatype_t dt_cfg1,
                          upll_keytype_datatype_t dt_cfg2,
                          unc_keytype_operation_t op,
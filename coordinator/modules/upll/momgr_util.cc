@@ -10,6 +10,7 @@
 #include <map>
 #include <string>
 #include <list>
+#include <vector>
 #include "momgr_impl.hh"
 #include "vtn_momgr.hh"
 #include "vbr_momgr.hh"
@@ -82,11 +83,17 @@ upll_rc_t MoMgrImpl::IsRenamed(ConfigKeyVal *ikey,
    * operaton is delete and ikey has to be populated with
    * val from db.
    */
+  std::string cache_id;
+  uint64_t cache_epoch = 0;
   if (rename &&
      ((dt_type == UPLL_DT_RUNNING) ||
       (dt_type == UPLL_DT_AUDIT))) {
     okey = ikey;
   } else  {
+    if (GetRenameCacheId(ikey, dt_type, dmi, &cache_id) &&
+        LookupRenameCache(cache_id, ikey, rename, &cache_epoch)) {
+      return UPLL_RC_SUCCESS;
+    }
     result_code = GetChildConfigKey(okey, ikey);
     if (result_code != UPLL_RC_SUCCESS) {
        UPLL_LOG_TRACE("Returning error %d", result_code);
@@ -117,6 +124,8 @@ upll_rc_t MoMgrImpl::IsRenamed(ConfigKeyVal *ikey,
     if (okey != ikey) delete okey;
     return result_code;
   }
+  if (result_code == UPLL_RC_SUCCESS && !cache_id.empty())
+    StoreRenameCache(cache_id, okey, cache_epoch);
   if (okey != ikey)
     SET_USER_DATA(ikey, okey);
   GET_USER_DATA_FLAGS(okey, rename);
@@ -129,6 +138,152 @@ upll_rc_t MoMgrImpl::IsRenamed(ConfigKeyVal *ikey,
   return UPLL_RC_SUCCESS;
 }
 
+void MoMgrImpl::StartRenameCache(
+    const std::vector<uud::DalOdbcMgr *> &conns) {
+  pfc::core::ScopedMutex lock(rename_cache_lock_);
+  rename_cache_.clear();
+  rename_cache_epoch_++;
+  rename_cache_conns_ = conns;
+  rename_cache_generations_.clear();
+  for (size_t i = 0; i < conns.size(); i++) {
+    rename_cache_generations_.push_back(conns[i]->get_write_generation());
+  }
+  // The RO connections do not see the uncommitted writes of the first one
+  rename_cache_shared_ = (!conns.empty() &&
+                          conns[0]->get_write_count() == 0);
+}
+
+void MoMgrImpl::StopRenameCache() {
+  pfc::core::ScopedMutex lock(rename_cache_lock_);
+  UPLL_LOG_DEBUG("Rename cache entries %" PFC_PFMT_SIZE_T,
+                 rename_cache_.size());
+  rename_cache_.clear();
+  rename_cache_conns_.clear();
+  rename_cache_generations_.clear();
+  rename_cache_shared_ = false;
+}
+
+// Called with rename_cache_lock_ held
+bool MoMgrImpl::CheckRenameCacheGenerations() {
+  bool valid = true;
+  for (size_t i = 0; i < rename_cache_conns_.size(); i++) {
+    uint64_t generation = rename_cache_conns_[i]->get_write_generation();
+    if (generation != rename_cache_generations_[i]) {
+      rename_cache_generations_[i] = generation;
+      valid = false;
+    }
+  }
+  if (!valid) {
+    rename_cache_.clear();
+    rename_cache_epoch_++;
+  }
+  return valid;
+}
+
+bool MoMgrImpl::GetRenameCacheId(ConfigKeyVal *ikey,
+                                 upll_keytype_datatype_t dt_type,
+                                 DalDmlIntf *dmi,
+                                 std::string *id) {
+  if (ikey == NULL || ikey->get_key() == NULL || table[MAINTBL] == NULL) {
+    return false;
+  }
+  // Connections seeing the same rows share the cached results
+  uint32_t view = 0;
+  {
+    pfc::core::ScopedMutex lock(rename_cache_lock_);
+    size_t i = 0;
+    while (i < rename_cache_conns_.size() &&
+           static_cast<DalDmlIntf *>(rename_cache_conns_[i]) != dmi) {
+      i++;
+    }
+    if (i == rename_cache_conns_.size()) {
+      return false;
+    }
+    view = (i == 0 && !rename_cache_shared_) ? 0 : 1;
+  }
+  const pfc_ipcstdef_t *st_def = IpctSt::GetIpcStdef(ikey->get_st_num());
+  if (st_def == NULL) {
+    return false;
+  }
+  // The read depends on the key, its user data and the table read
+  uint32_t header[4] = {
+    view,
+    static_cast<uint32_t>(table[MAINTBL]->get_key_type()),
+    static_cast<uint32_t>(ikey->get_key_type()),
+    static_cast<uint32_t>(dt_type) };
+  id->assign(reinterpret_cast<const char *>(header), sizeof(header));
+  id->append(reinterpret_cast<const char *>(ikey->get_key()),
+             st_def->ist_size);
+  key_user_data_t *user_data =
+      reinterpret_cast<key_user_data_t *>(ikey->get_user_data());
+  if (user_data) {
+    id->push_back('\1');
+    id->append(reinterpret_cast<const char *>(user_data),
+               sizeof(key_user_data_t));
+  } else {
+    id->push_back('\0');
+  }
+  return true;
+}
+
+bool MoMgrImpl::LookupRenameCache(const std::string &id, ConfigKeyVal *ikey,
+                                  uint8_t &rename, uint64_t *epoch) {
+  RenameCacheEntry entry;
+  {
+    pfc::core::ScopedMutex lock(rename_cache_lock_);
+    // Any write, commit or rollback on a connection may change the rows read
+    if (rename_cache_conns_.empty()) {
+      return false;
+    }
+    bool valid = CheckRenameCacheGenerations();
+    *epoch = rename_cache_epoch_;
+    if (!valid) {
+      return false;
+    }
+    std::map<std::string, RenameCacheEntry>::iterator it =
+        rename_cache_.find(id);
+    if (it == rename_cache_.end()) {
+      return false;
+    }
+    entry = it->second;
+  }
+  if (entry.has_user_data) {
+    GET_USER_DATA(ikey)
+    key_user_data_t *user_data =
+        reinterpret_cast<key_user_data_t *>(ikey->get_user_data());
+    if (user_data == NULL) {
+      return false;
+    }
+    uuu::upll_strncpy(user_data->ctrlr_id, entry.user_data.ctrlr_id,
+                      (kMaxLenCtrlrId+1));
+    uuu::upll_strncpy(user_data->domain_id, entry.user_data.domain_id,
+                      (kMaxLenDomainId+1));
+    user_data->flags = entry.user_data.flags;
+    rename = entry.user_data.flags;
+  }
+  GET_RENAME_FLAG(rename, ikey->get_key_type())
+  return true;
+}
+
+void MoMgrImpl::StoreRenameCache(const std::string &id, ConfigKeyVal *okey,
+                                 uint64_t epoch) {
+  RenameCacheEntry entry;
+  key_user_data_t *user_data =
+      reinterpret_cast<key_user_data_t *>(okey->get_user_data());
+  entry.has_user_data = (user_data != NULL);
+  if (user_data) {
+    memcpy(&entry.user_data, user_data, sizeof(key_user_data_t));
+  } else {
+    memset(&entry.user_data, 0, sizeof(key_user_data_t));
+  }
+  pfc::core::ScopedMutex lock(rename_cache_lock_);
+  if (rename_cache_conns_.empty() || !CheckRenameCacheGenerations() ||
+      epoch != rename_cache_epoch_) {
+    return;
+  }
+  rename_cache_[id] = entry;
+}
+
 upll_rc_t MoMgrImpl::DeleteChildren(ConfigKeyVal *ikey,
                                     ConfigKeyVal *pkey,
                                     upll_keytype_datatype_t dt_type,
@@ -750,8 +905,7 @@ upll_rc_t MoMgrImpl::UpdateConfigDB(ConfigKeyVal *ikey,
 
   DalBindInfo *dal_bind_info = new DalBindInfo(tbl_index);
   upll_rc_t result_code;
-  DbSubOp dbop = { kOpReadExist, kOpMatchNone, kOpInOutFlag | kOpInOutCtrlr
-                       | kOpInOutDomain };
+  DbSubOp dbop;
   if (op == UNC_OP_READ) {
     UPLL_LOG_ERROR("Invalid operation - %d", op);
     if (dal_bind_info) delete dal_bind_info;
@@ -759,26 +913,7 @@ upll_rc_t MoMgrImpl::UpdateConfigDB(ConfigKeyVal *ikey,
   }
 
   if (pdbop == NULL) {
-    if (op == UNC_OP_DELETE) dbop.inoutop = kOpInOutNone;
-    if (op != UNC_OP_CREATE) {
-      if ((tbl == RENAMETBL) || (tbl == CTRLRTBL)) {
-        dbop.matchop = kOpMatchCtrlr | kOpMatchDomain;
-        dbop.inoutop = kOpInOutFlag | kOpInOutCs;
-      }
-      if (op == UNC_OP_UPDATE) {
-        if  (dt_type == UPLL_DT_CANDIDATE) {
-          dbop.inoutop = kOpInOutCs;
-        } else if (dt_type == UPLL_DT_RUNNING) {
-          dbop.inoutop |= kOpInOutCs;
-        } else if (dt_type == UPLL_DT_AUDIT) {
-          dbop.inoutop = kOpInOutFlag;
-        }
-      }
-    } else {
-      if (dt_type != UPLL_DT_CANDIDATE || tbl == CTRLRTBL)
-        if (dt_type != UPLL_DT_AUDIT)
-          dbop.inoutop |= kOpInOutCs;
-    }
+    GetDefaultUpdateDbop(op, dt_type, tbl, &dbop);
     pdbop = &dbop;
   }
   result_code = BindAttr(dal_bind_info, ikey, op, dt_type, *pdbop, tbl);
@@ -824,6 +959,110 @@ upll_rc_t MoMgrImpl::UpdateConfigDB(ConfigKeyVal *ikey,
   return result_code;
 }
 
+void MoMgrImpl::GetDefaultUpdateDbop(unc_keytype_operation_t op,
+                                     upll_keytype_datatype_t dt_type,
+                                     MoMgrTables tbl,
+                                     DbSubOp *dbop) {
+  dbop->readop = kOpReadExist;
+  dbop->matchop = kOpMatchNone;
+  dbop->inoutop = kOpInOutFlag | kOpInOutCtrlr | kOpInOutDomain;
+  if (op == UNC_OP_DELETE) dbop->inoutop = kOpInOutNone;
+  if (op != UNC_OP_CREATE) {
+    if ((tbl == RENAMETBL) || (tbl == CTRLRTBL)) {
+      dbop->matchop = kOpMatchCtrlr | kOpMatchDomain;
+      dbop->inoutop = kOpInOutFlag | kOpInOutCs;
+    }
+    if (op == UNC_OP_UPDATE) {
+      if  (dt_type == UPLL_DT_CANDIDATE) {
+        dbop->inoutop = kOpInOutCs;
+      } else if (dt_type == UPLL_DT_RUNNING) {
+        dbop->inoutop |= kOpInOutCs;
+      } else if (dt_type == UPLL_DT_AUDIT) {
+        dbop->inoutop = kOpInOutFlag;
+      }
+    }
+  } else {
+    if (dt_type != UPLL_DT_CANDIDATE || tbl == CTRLRTBL)
+      if (dt_type != UPLL_DT_AUDIT)
+        dbop->inoutop |= kOpInOutCs;
+  }
+}
+
+upll_rc_t MoMgrImpl::UpdateConfigDBBulk(ConfigKeyVal *ikey,
+                                        upll_keytype_datatype_t dt_type,
+                                        unc_keytype_operation_t op,
+                                        DalDmlIntf *dmi,
+                                        DbSubOp *pdbop,
+                                        TcConfigMode cfg_mode,
+                                        string vtn_name,
+                                        MoMgrTables tbl) {
+  UPLL_FUNC_TRACE;
+  if (ikey == NULL || dmi == NULL) {
+    UPLL_LOG_DEBUG("Invalid input");
+    return UPLL_RC_ERR_GENERIC;
+  }
+  if (op != UNC_OP_CREATE && op != UNC_OP_UPDATE) {
+    UPLL_LOG_ERROR("Invalid operation - %d", op);
+    return UPLL_RC_ERR_GENERIC;
+  }
+  // A single key gains nothing from the bulk path
+  if (ikey->get_next_cfg_key_val() == NULL) {
+    return UpdateConfigDB(ikey, dt_type, op, dmi, pdbop, cfg_mode,
+                          vtn_name, tbl);
+  }
+  const uudst::kDalTableIndex tbl_index = GetTable(tbl, dt_type);
+  if (tbl_index >= uudst::kDalNumTables) {
+    UPLL_LOG_DEBUG(" Invalid Table index - %d", tbl_index);
+    return UPLL_RC_ERR_GENERIC;
+  }
+
+  upll_rc_t result_code = UPLL_RC_SUCCESS;
+  DbSubOp dbop;
+  if (pdbop == NULL) {
+    GetDefaultUpdateDbop(op, dt_type, tbl, &dbop);
+    pdbop = &dbop;
+  }
+
+  std::vector<const DalBindInfo *> bind_infos;
+  for (ConfigKeyVal *ck = ikey; ck != NULL; ck = ck->get_next_cfg_key_val()) {
+    DalBindInfo *dal_bind_info = new DalBindInfo(tbl_index);
+    bind_infos.push_back(dal_bind_info);
+    result_code = BindAttr(dal_bind_info, ck, op, dt_type, *pdbop, tbl);
+    if (result_code != UPLL_RC_SUCCESS) {
+      UPLL_LOG_DEBUG("BindAttr failed for %s", (ck->ToStrAll()).c_str());
+      break;
+    }
+  }
+
+  if (result_code == UPLL_RC_SUCCESS) {
+    dt_type = (dt_type == UPLL_DT_STATE) ? UPLL_DT_RUNNING : dt_type;
+    uint8_t *vtnname = NULL;
+    if (!vtn_name.empty()) {
+      vtnname = reinterpret_cast<uint8_t *>(
+        const_cast<char *>(vtn_name.c_str()));
+    }
+    std::vector<DalResultCode> results;
+    UPLL_LOG_TRACE("Dbop bulk %s of %" PFC_PFMT_SIZE_T " keys dt_type %d "
+                   "tbl %d", (op == UNC_OP_CREATE) ? "CREATE" : "UPD",
+                   bind_infos.size(), dt_type, tbl_index);
+    if (op == UNC_OP_CREATE) {
+      result_code = DalToUpllResCode(
+          dmi->CreateRecords(dt_type, tbl_index, bind_infos, &results,
+                             cfg_mode, vtnname));
+    } else {
+      result_code = DalToUpllResCode(
+          dmi->UpdateRecords(dt_type, tbl_index, bind_infos, &results,
+                             cfg_mode, vtnname));
+    }
+  }
+
+  for (std::vector<const DalBindInfo *>::iterator it = bind_infos.begin();
+       it != bind_infos.end(); ++it) {
+    delete *it;
+  }
+  return result_code;
+}
+
 upll_rc_t MoMgrImpl::BindAttr(DalBindInfo *db_info,
                               ConfigKeyVal *&req,
                               unc_keytype_operation_t op,
@@ -242,6 +242,9 @@ upll_rc_t UpllConfigMgr::ReadBulkGetSubtree(const KeyTree &kt_tree,
   }
 
   *user_resp_ckv = NULL;
+  // Response is built here and handed over to user_resp_ckv on success,
+  // failure paths leave it to the destructor
+  ConfigKeyValChain resp_chain;
 
   unc_key_type_t curr_kt = user_req_ckv->get_key_type();
   unc_key_type_t child_kt;
@@ -257,10 +260,6 @@ upll_rc_t UpllConfigMgr::ReadBulkGetSubtree(const KeyTree &kt_tree,
     ConfigKeyVal *curr_req_ckv = GetCkvFromParent(curr_kt, user_req_ckv);
     if (curr_req_ckv == NULL) {
       UPLL_LOG_INFO("Could not initialize CKV for %u", curr_kt);
-      if (*user_resp_ckv != NULL) {
-        delete *user_resp_ckv;
-        *user_resp_ckv = NULL;
-      }
       return UPLL_RC_ERR_GENERIC;
     }
     upll_rc_t curr_urc;
@@ -273,23 +272,18 @@ upll_rc_t UpllConfigMgr::ReadBulkGetSubtree(const KeyTree &kt_tree,
       delete curr_req_ckv;
       curr_req_ckv = curr_resp_ckv->DupKey();  // prepare for loop
       if (curr_req_ckv == NULL) {
-        if (*user_resp_ckv != NULL) {
+        if (!resp_chain.empty()) {
           UPLL_LOG_INFO("DupKey failed for %u", curr_resp_ckv->get_key_type());
-          delete *user_resp_ckv;
-          *user_resp_ckv = NULL;
         }
         return UPLL_RC_ERR_GENERIC;
       }
 
-      if (*user_resp_ckv == NULL) {
-        *user_resp_ckv = curr_resp_ckv;   // init user_resp_ckv
-      } else {
-        (*user_resp_ckv)->AppendCfgKeyVal(curr_resp_ckv);
-      }
+      resp_chain.Append(curr_resp_ckv);
 
       (*added_cnt)++;
       if ((*added_cnt) == requested_cnt) {
         delete curr_req_ckv;
+        *user_resp_ckv = resp_chain.Release();
         return UPLL_RC_SUCCESS;
       }
 
@@ -304,16 +298,13 @@ upll_rc_t UpllConfigMgr::ReadBulkGetSubtree(const KeyTree &kt_tree,
       delete local_bulk_ckv_req;
       if (new_urc == UPLL_RC_SUCCESS) {
         (*added_cnt) += new_cnt;
-        (*user_resp_ckv)->AppendCfgKeyVal(local_bulk_ckv_resp);
+        resp_chain.Append(local_bulk_ckv_resp);
         if ((*added_cnt) == requested_cnt) {
           delete curr_req_ckv;
+          *user_resp_ckv = resp_chain.Release();
           return UPLL_RC_SUCCESS;
         }
       } else {
-        if (*user_resp_ckv != NULL) {
-          delete *user_resp_ckv;
-          *user_resp_ckv = NULL;
-        }
         delete curr_req_ckv;
         return new_urc;
       }
@@ -324,14 +315,11 @@ upll_rc_t UpllConfigMgr::ReadBulkGetSubtree(const KeyTree &kt_tree,
 
     if ((curr_urc != UPLL_RC_ERR_NO_SUCH_INSTANCE) &&
         (curr_urc != UPLL_RC_SUCCESS)) {
-      if (*user_resp_ckv != NULL) {
-        delete *user_resp_ckv;
-        *user_resp_ckv = NULL;
-      }
       return curr_urc;
     }
   }  // For all children KT
 
+  *user_resp_ckv = resp_chain.Release();
   UPLL_LOG_DEBUG("KT: %u Requested: %u, Got %u",
                  user_req_ckv->get_key_type(), requested_cnt, (*added_cnt));
   UPLL_LOG_TRACE("Req:%s\nResponse: %s", user_req_ckv->ToStr().c_str(),
@@ -434,6 +422,9 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
     return UPLL_RC_ERR_GENERIC;
   }
   upll_rc_t urc;
+  // Response is built here and handed over to user_resp_ckv on success,
+  // failure paths leave it to the destructor
+  ConfigKeyValChain resp_chain;
   while (pending_cnt > 0) {
     ConfigKeyVal *step_resp_ckv = NULL;
     if (retrieve_user_req_mo) {   // execute only once
@@ -464,10 +455,6 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
         default:
           UPLL_LOG_INFO("Failed to read. Urc=%d", urc);
           msghdr->result_code = urc;
-          if (*user_resp_ckv) {
-            delete *user_resp_ckv;
-            *user_resp_ckv = NULL;
-          }
           delete step_req_ckv;
           return urc;
       }
@@ -491,11 +478,7 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
             // Add the node;
             added_cnt++;
             pending_cnt--;
-            if (*user_resp_ckv == NULL) {
-              *user_resp_ckv = step_resp_ckv;
-            } else {
-              (*user_resp_ckv)->AppendCfgKeyVal(step_resp_ckv);
-            }
+            resp_chain.Append(step_resp_ckv);
           }
 
           begin = false;
@@ -509,21 +492,13 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
             UPLL_LOG_INFO("ReadBulkGetSubtree failed. Urc=%d", urc);
             delete subtree_req_ckv;
             subtree_req_ckv = NULL;
-            if (*user_resp_ckv) {
-              delete *user_resp_ckv;
-              *user_resp_ckv = NULL;
-            }
             msghdr->result_code = urc;
             return urc;
           }
           if (step_added_cnt != 0) {
             added_cnt += step_added_cnt;
             pending_cnt -= step_added_cnt;
-            if (*user_resp_ckv == NULL) {
-              *user_resp_ckv = subtree_resp_ckv;   // init user_resp_ckv
-            } else {
-              (*user_resp_ckv)->AppendCfgKeyVal(subtree_resp_ckv);
-            }
+            resp_chain.Append(subtree_resp_ckv);
           }
           if (pending_cnt > 0) {
             // continue; and fetch more
@@ -538,6 +513,7 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
             subtree_req_ckv = NULL;
             msghdr->result_code = UPLL_RC_SUCCESS;
             msghdr->rep_count = added_cnt;
+            *user_resp_ckv = resp_chain.Release();
             UPLL_LOG_TRACE("Returning from %s", __FUNCTION__);
             return UPLL_RC_SUCCESS;
           }
@@ -563,10 +539,6 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
               // Something wrong?
               UPLL_LOG_INFO("Could not initialize next sibling ckv for %u",
                             next_sibling_kt);
-              if (*user_resp_ckv) {
-                delete *user_resp_ckv;
-                *user_resp_ckv = NULL;
-              }
               msghdr->result_code = UPLL_RC_ERR_GENERIC;
               UPLL_LOG_TRACE("Returning from %s", __FUNCTION__);
               return msghdr->result_code;
@@ -606,11 +578,9 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
               delete step_req_ckv;
               step_req_ckv = NULL;
 
-              if ((msghdr->result_code != UPLL_RC_SUCCESS &&
-                   msghdr->result_code != UPLL_RC_ERR_NO_SUCH_INSTANCE) &&
-                  (*user_resp_ckv != NULL)) {
-                delete *user_resp_ckv;
-                *user_resp_ckv = NULL;
+              if (msghdr->result_code == UPLL_RC_SUCCESS ||
+                  msghdr->result_code == UPLL_RC_ERR_NO_SUCH_INSTANCE) {
+                *user_resp_ckv = resp_chain.Release();
               }
               return msghdr->result_code;
             }
@@ -619,10 +589,6 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
         continue;
         break;
       default:  // all other error codes
-        if (*user_resp_ckv) {
-          delete *user_resp_ckv;
-          *user_resp_ckv = NULL;
-        }
         if (step_req_ckv) {
           delete step_req_ckv;
         }
@@ -632,10 +598,6 @@ upll_rc_t UpllConfigMgr::ReadBulkMo(IpcReqRespHeader *msghdr,
     }
   }
 
-  if (*user_resp_ckv) {
-    delete *user_resp_ckv;
-    *user_resp_ckv = NULL;
-  }
   if (step_req_ckv) {
     delete step_req_ckv;
   }
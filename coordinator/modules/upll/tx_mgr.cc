@@ -7,6 +7,8 @@
  * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
  */
 
+#include <boost/bind.hpp>
+#include <vector>
 #include "pfc/debug.h"
 #include "cxx/pfcxx/synch.hh"
 #include "unc/component.h"
@@ -20,6 +22,8 @@ namespace upll {
 namespace config_momgr {
 
 using unc::upll::dal::DalOdbcMgr;
+using unc::upll::kt_momgr::MoMgrImpl;
+using unc::upll::tx_update_util::TxUpdateDag;
 namespace uud = unc::upll::dal;
 namespace uuds = unc::upll::dal::schema;
 namespace uudst = unc::upll::dal::schema::table;
@@ -203,24 +207,38 @@ upll_rc_t UpllConfigMgr::OnTxStart(uint32_t session_id, uint32_t config_id,
 
 
 
+  // The delete, create and update phases run the key types concurrently on
+  // the config RW connection and a few RO connections
+  std::vector<DalOdbcMgr *> conns(1, dbinst);
   if (urc == UPLL_RC_SUCCESS) {
-    CALL_MOMGRS_REVERSE_ORDER(TxUpdateController, session_id, config_id,
-                              kUpllUcpDelete, &affected_ctrlr_set_, dbinst,
-                              err_ckv, tx_util_, config_mode, vtn_name);
+    AcquireTxUpdateConns(&conns);
   }
 
+  // Parent lookups of the rows sent to the controllers are cached
+  // till the delete2 phase, and the changes of each key type are read once
+  // for the three phases
+  MoMgrImpl::StartRenameCache(conns);
+  MoMgrImpl::StartTxChangeLog();
+
+  TxUpdateKtArgs args(session_id, config_id, &conns, config_mode, vtn_name);
   if (urc == UPLL_RC_SUCCESS) {
-    CALL_MOMGRS_PREORDER(TxUpdateController, session_id, config_id,
-                         kUpllUcpCreate, &affected_ctrlr_set_, dbinst, err_ckv,
-                         tx_util_, config_mode, vtn_name);
+    args.phase = kUpllUcpDelete;
+    urc = TxUpdateControllerByDag(&args, err_ckv);
   }
 
   if (urc == UPLL_RC_SUCCESS) {
-    CALL_MOMGRS_PREORDER(TxUpdateController, session_id, config_id,
-                         kUpllUcpUpdate, &affected_ctrlr_set_, dbinst, err_ckv,
-                         tx_util_, config_mode, vtn_name);
+    args.phase = kUpllUcpCreate;
+    urc = TxUpdateControllerByDag(&args, err_ckv);
   }
 
+  if (urc == UPLL_RC_SUCCESS) {
+    args.phase = kUpllUcpUpdate;
+    urc = TxUpdateControllerByDag(&args, err_ckv);
+  }
+
+  MoMgrImpl::StopTxChangeLog();
+  MoMgrImpl::StopRenameCache();
+
   if (urc == UPLL_RC_SUCCESS) {
     unc_key_type_t phase2_kts[] = { UNC_KT_POLICING_PROFILE_ENTRY,
                                     UNC_KT_POLICING_PROFILE,
@@ -257,6 +275,9 @@ upll_rc_t UpllConfigMgr::OnTxStart(uint32_t session_id, uint32_t config_id,
   tx_util_->Deactivate();
   tx_util_->ReInitializeTaskQParams();
 
+  // The queued requests keep the connections till they are completed
+  ReleaseTxUpdateConns(&conns);
+
   upll_rc_t db_urc = dbcm_->DalTxClose(dbinst, false);
   dbcm_->ReleaseRwConn(dbinst);
   if (urc == UPLL_RC_SUCCESS) {
@@ -266,6 +287,96 @@ upll_rc_t UpllConfigMgr::OnTxStart(uint32_t session_id, uint32_t config_id,
   return urc;
 }
 
+// Connections 1 and later are RO connections. They see the same candidate
+// and running as the config RW connection, since the candidate is write
+// locked and already committed, except the controller tables updated by the
+// init phase, which are read only by the global key types.
+void UpllConfigMgr::AcquireTxUpdateConns(std::vector<DalOdbcMgr *> *conns) {
+  UPLL_FUNC_TRACE;
+  while (conns->size() < tx_update_conns_) {
+    DalOdbcMgr *dbinst = NULL;
+    upll_rc_t urc = dbcm_->AcquireRoConn(&dbinst);
+    if (urc != UPLL_RC_SUCCESS) {
+      UPLL_LOG_WARN("Failed to get RO connection for TxUpdate %d", urc);
+      break;
+    }
+    conns->push_back(dbinst);
+  }
+  UPLL_LOG_DEBUG("TxUpdate uses %" PFC_PFMT_SIZE_T " connections",
+                 conns->size());
+}
+
+void UpllConfigMgr::ReleaseTxUpdateConns(std::vector<DalOdbcMgr *> *conns) {
+  UPLL_FUNC_TRACE;
+  while (conns->size() > 1) {
+    DalOdbcMgr *dbinst = conns->back();
+    dbcm_->DalTxClose(dbinst, false);
+    dbcm_->ReleaseRoConn(dbinst);
+    conns->pop_back();
+  }
+}
+
+// Runs TxUpdateController of all the key types for args->phase. The global
+// key types read the controller tables computed by the init phase, so they
+// run on the config RW connection.
+upll_rc_t UpllConfigMgr::TxUpdateControllerByDag(TxUpdateKtArgs *args,
+                                                 ConfigKeyVal **err_ckv) {
+  UPLL_FUNC_TRACE;
+  bool reverse = (args->phase == kUpllUcpDelete);
+  const std::list<unc_key_type_t> *lst = (reverse) ?
+      cktt_.get_reverse_postorder_list() : cktt_.get_preorder_list();
+  TxUpdateDag dag(*lst, cktt_, reverse);
+  for (std::list<unc_key_type_t>::const_iterator it = lst->begin();
+       it != lst->end(); ++it) {
+    bool is_global_kt = false;
+    IS_GLOBAL_KEYTYPE(*it, is_global_kt);
+    if (is_global_kt) {
+      dag.PinToFirstConn(*it);
+    }
+  }
+
+  args->ctrlr_sets.assign(args->conns->size(), std::set<std::string>());
+  upll_rc_t urc = dag.Run(tx_update_taskq_, args->conns->size(),
+                          boost::bind(&UpllConfigMgr::TxUpdateKt, this,
+                                      args, _1, _2, _3),
+                          err_ckv);
+  for (size_t i = 0; i < args->ctrlr_sets.size(); i++) {
+    affected_ctrlr_set_.insert(args->ctrlr_sets[i].begin(),
+                               args->ctrlr_sets[i].end());
+  }
+  return urc;
+}
+
+// Each connection runs one key type at a time, so the controller set of the
+// connection is not shared
+upll_rc_t UpllConfigMgr::TxUpdateKt(TxUpdateKtArgs *args,
+                                    unc_key_type_t kt, uint32_t conn_idx,
+                                    ConfigKeyVal **err_ckv) {
+  std::map<unc_key_type_t, MoManager*>::iterator momgr_it =
+    upll_kt_momgrs_.find(kt);
+  if (momgr_it == upll_kt_momgrs_.end()) {
+    return UPLL_RC_SUCCESS;
+  }
+  UPLL_LOG_DEBUG("KT: %u; conn: %u", kt, conn_idx);
+  MoManager *momgr = momgr_it->second;
+  upll_rc_t urc = momgr->TxUpdateController(
+      kt, args->session_id, args->config_id, args->phase,
+      &args->ctrlr_sets[conn_idx], (*args->conns)[conn_idx], err_ckv,
+      tx_util_, args->config_mode, args->vtn_name);
+  if (urc == UPLL_RC_ERR_DRIVER_NOT_PRESENT) {
+    UPLL_LOG_WARN("Driver not present error for KT: %u", kt);
+    return UPLL_RC_SUCCESS;
+  }
+  if (urc != UPLL_RC_SUCCESS) {
+    UPLL_LOG_WARN("Error = %d, KT: %u", urc, kt);
+    return urc;
+  }
+  if ((urc = ContinueActiveProcess()) != UPLL_RC_SUCCESS) {
+    UPLL_LOG_WARN("Error = %d, KT: %u", urc, kt);
+  }
+  return urc;
+}
+
 upll_rc_t UpllConfigMgr::OnAuditTxStart(const char *ctrlr_id,
                                         uint32_t session_id,
                                         uint32_t config_id,
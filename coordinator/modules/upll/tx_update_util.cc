@@ -7,6 +7,7 @@
  * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
  */
 
+#include <boost/bind.hpp>
 #include "config_mgr.hh"
 #include "upll_util.hh"
 #include "tx_update_util.hh"
@@ -154,14 +155,15 @@ upll_rc_t TxUpdateUtil::EnqueueRequest(uint32_t session_id,
   memset(&ctrlr_dom, 0, sizeof(controller_domain));
   GET_USER_DATA_CTRLR_DOMAIN(ck_main, ctrlr_dom);
 
+  // Requests are enqueued by all the connections of TxUpdateDag
+  pfc::core::ScopedMutex sm(access_mutex_);
+
   pfc_taskq_t taskq_id = GetCtrlrQueue(reinterpret_cast<const char*>
                                        (ctrlr_dom.ctrlr));
   UPLL_LOG_DEBUG("Controller %s assigned to queue %u",
                  reinterpret_cast<const char*>(ctrlr_dom.ctrlr),
                  taskq_id);
 
-  pfc::core::ScopedMutex sm(access_mutex_);
-
   if (!active_) {
     // Drop the request
     UPLL_LOG_DEBUG("Dropping the request as I am inactive");
@@ -370,6 +372,158 @@ void TxUpdateUtil::HandleTxUpdateCompletion() {
   }
 }
 
+TxUpdateDag::TxUpdateDag(const std::list<unc_key_type_t> &order,
+                         const KeyTree &ktree, bool reverse)
+    : running_(0),
+      failed_(false) {
+  std::map<unc_key_type_t, size_t> index;
+  for (std::list<unc_key_type_t>::const_iterator it = order.begin();
+       it != order.end(); ++it) {
+    index[*it] = nodes_.size();
+    nodes_.push_back(KtNode(*it));
+  }
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    const std::set<unc_key_type_t> *deps =
+        ktree.get_dependencies(nodes_[i].kt);
+    if (deps == NULL) {
+      continue;
+    }
+    for (std::set<unc_key_type_t>::const_iterator it = deps->begin();
+         it != deps->end(); ++it) {
+      std::map<unc_key_type_t, size_t>::const_iterator dep = index.find(*it);
+      if (dep == index.end()) {
+        continue;
+      }
+      // In reverse order the dependency waits for the key type
+      size_t before = (reverse) ? i : dep->second;
+      size_t after = (reverse) ? dep->second : i;
+      nodes_[before].dependents.push_back(after);
+      nodes_[after].pending++;
+    }
+  }
+}
+
+void TxUpdateDag::PinToFirstConn(unc_key_type_t kt) {
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    if (nodes_[i].kt == kt) {
+      nodes_[i].pinned = true;
+    }
+  }
+}
+
+size_t TxUpdateDag::NextReadyKt(bool with_pinned) const {
+  if (failed_) {
+    return kNoKt;
+  }
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    const KtNode &node = nodes_[i];
+    if (!node.started && node.pending == 0 && (with_pinned || !node.pinned)) {
+      return i;
+    }
+  }
+  return kNoKt;
+}
+
+void TxUpdateDag::RunKt(size_t idx, uint32_t conn_idx) {
+  while (idx != kNoKt) {
+    ConfigKeyVal *err_ckv = NULL;
+    upll_rc_t urc = handler_(nodes_[idx].kt, conn_idx, &err_ckv);
+
+    pfc::core::ScopedMutex lock(mutex_);
+    KtNode &node = nodes_[idx];
+    node.urc = urc;
+    node.err_ckv = err_ckv;
+    if (urc != UPLL_RC_SUCCESS) {
+      failed_ = true;
+    } else {
+      for (std::vector<size_t>::const_iterator it = node.dependents.begin();
+           it != node.dependents.end(); ++it) {
+        nodes_[*it].pending--;
+      }
+    }
+    // Connection 0 belongs to Run(), which picks its next key type itself
+    idx = (conn_idx == 0) ? kNoKt : NextReadyKt(false);
+    if (idx != kNoKt) {
+      nodes_[idx].started = true;
+    } else {
+      conn_busy_[conn_idx] = false;
+      running_--;
+    }
+    cond_.signal();
+  }
+}
+
+upll_rc_t TxUpdateDag::Run(pfc::core::TaskQueue *taskq, uint32_t nconns,
+                           const KtHandler &handler,
+                           ConfigKeyVal **err_ckv) {
+  UPLL_FUNC_TRACE;
+  handler_ = handler;
+  conn_busy_.assign((nconns > 0) ? nconns : 1, false);
+  if (taskq == NULL) {
+    conn_busy_.resize(1);
+  }
+
+  mutex_.lock();
+  for (;;) {
+    // Hand the ready key types to the idle connections
+    size_t idx;
+    uint32_t conn_idx = 1;
+    while ((idx = NextReadyKt(false)) != kNoKt) {
+      while (conn_idx < conn_busy_.size() && conn_busy_[conn_idx]) {
+        conn_idx++;
+      }
+      if (conn_idx >= conn_busy_.size()) {
+        break;
+      }
+      nodes_[idx].started = true;
+      conn_busy_[conn_idx] = true;
+      running_++;
+      mutex_.unlock();
+      int err = taskq->dispatch(
+          boost::bind(&TxUpdateDag::RunKt, this, idx, conn_idx));
+      mutex_.lock();
+      if (err != 0) {
+        // The connection is left busy and not used any more
+        UPLL_LOG_WARN("Failed to dispatch KT %u to connection %u. err=%d",
+                      nodes_[idx].kt, conn_idx, err);
+        nodes_[idx].started = false;
+        running_--;
+      }
+    }
+
+    // The caller runs the pinned ones, and the others when all the
+    // connections are busy
+    if ((idx = NextReadyKt(true)) != kNoKt) {
+      nodes_[idx].started = true;
+      conn_busy_[0] = true;
+      running_++;
+      mutex_.unlock();
+      RunKt(idx, 0);
+      mutex_.lock();
+      continue;
+    }
+    if (running_ == 0) {
+      break;
+    }
+    cond_.wait(mutex_);
+  }
+  mutex_.unlock();
+
+  upll_rc_t urc = UPLL_RC_SUCCESS;
+  for (size_t i = 0; i < nodes_.size(); i++) {
+    KtNode &node = nodes_[i];
+    if (urc == UPLL_RC_SUCCESS && node.urc != UPLL_RC_SUCCESS) {
+      urc = node.urc;
+      if (err_ckv != NULL) {
+        *err_ckv = node.err_ckv;
+        node.err_ckv = NULL;
+      }
+    }
+    DELETE_IF_NOT_NULL(node.err_ckv);
+  }
+  return urc;
+}
+
 }  // namespace tx_update_util
 }  // namespace upll
 }  // namespace unc
@@ -12,15 +12,19 @@
 
 #include <string>
 #include <algorithm>
+#include <list>
 #include <map>
 #include <vector>
 
+#include <boost/function.hpp>
+
 #include "cxx/pfcxx/synch.hh"
 #include "pfcxx/task_queue.hh"
 #include "dal/dal_odbc_mgr.hh"
 #include "ipc_util.hh"
 #include "upll_util.hh"
 #include "kt_util.hh"
+#include "key_tree.hh"
 #include "uncxx/upll_log.hh"
 
 namespace unc {
@@ -31,6 +35,7 @@ using unc::upll::ipc_util::IpcRequest;
 using unc::upll::ipc_util::ConfigKeyVal;
 using unc::upll::ipc_util::controller_domain_t;
 using unc::upll::dal::DalDmlIntf;
+using unc::upll::keytree::KeyTree;
 
 // forward declaration
 class TxUpdateUtil;
@@ -171,6 +176,64 @@ class TxUpdateUtil {
   mutable pfc::core::Condition sync_cond_;
   std::vector<pfc_taskq_t> valid_taskq_ids_;
 };
+/*
+ * Runs TxUpdateController of the key types of a commit phase on several DB
+ * connections. A key type is started only after all the key types it
+ * depends on in the KeyTree completed, so their requests are queued to the
+ * controllers before its own ones. Key types which do not depend on each
+ * other run concurrently.
+ */
+class TxUpdateDag {
+ public:
+  // Runs TxUpdateController of kt on the connection conn_idx
+  typedef boost::function<upll_rc_t (unc_key_type_t kt, uint32_t conn_idx,
+                                     ConfigKeyVal **err_ckv)> KtHandler;
+
+  // order is the serial order of the key types in the phase. If reverse is
+  // true, a key type is started after the key types depending on it, as
+  // done by the delete phase.
+  TxUpdateDag(const std::list<unc_key_type_t> &order, const KeyTree &ktree,
+              bool reverse);
+  ~TxUpdateDag() {}
+
+  // The key type is run only on connection 0, the one of the caller
+  void PinToFirstConn(unc_key_type_t kt);
+
+  // Runs all the key types. Connection 0 is used by the calling thread,
+  // connections 1 to nconns-1 by the tasks dispatched to taskq. No more key
+  // types are started after a failure; the result and err_ckv of the failed
+  // key type which comes first in the order are returned.
+  upll_rc_t Run(pfc::core::TaskQueue *taskq, uint32_t nconns,
+                const KtHandler &handler, ConfigKeyVal **err_ckv);
+
+ private:
+  struct KtNode {
+    explicit KtNode(unc_key_type_t key_type) : kt(key_type), pending(0),
+        pinned(false), started(false), urc(UPLL_RC_SUCCESS), err_ckv(NULL) {}
+    unc_key_type_t kt;
+    uint32_t pending;                // dependencies not completed yet
+    std::vector<size_t> dependents;  // indexes of the key types waiting
+    bool pinned;
+    bool started;
+    upll_rc_t urc;
+    ConfigKeyVal *err_ckv;
+  };
+  static const size_t kNoKt = static_cast<size_t>(-1);
+
+  // Index of the first key type which can be started, kNoKt if none
+  size_t NextReadyKt(bool with_pinned) const;
+  // Task of connection conn_idx, runs key types until none is ready
+  void RunKt(size_t idx, uint32_t conn_idx);
+
+  std::vector<KtNode> nodes_;
+  KtHandler handler_;
+  std::vector<bool> conn_busy_;
+  uint32_t running_;  // connections running a key type
+  bool failed_;
+  pfc::core::Mutex mutex_;
+  pfc::core::Condition cond_;
+};
+
 }  // namespace tx_update_util
 }  // namespace upll
 }  // namespace unc
@@ -921,19 +921,13 @@ upll_rc_t VbrPortMapMoMgr::PopulateGvtnId(ConfigKeyVal *ckv_spd,
                     reinterpret_cast<val_gvtnid_label*>(GetVal(ckv_gvtn));
         gvtnid_label->label_id = default_bucket_span[i-1];
 
-        DbSubOp dbop_update = { kOpNotRead, kOpMatchNone, kOpInOutNone };
-        result_code = UpdateConfigDB(ckv_gvtn, UPLL_DT_CANDIDATE, UNC_OP_CREATE,
-                      dmi, &dbop_update, config_mode, vtn_name, GVTNIDTBL);
-        if (result_code != UPLL_RC_SUCCESS) {
-          UPLL_LOG_ERROR("Error in UpdateConfigDB: %d", result_code);
-          return result_code;
-        }
         ConfigKeyVal *prev_ckv = tmp_ckv;
         tmp_ckv = NULL;
         result_code = DupConfigKeyVal(tmp_ckv, ckv_gvtn, GVTNIDTBL);
         if (result_code != UPLL_RC_SUCCESS) {
           UPLL_LOG_DEBUG("Error in DupConfigKeyVal: %d", result_code);
           DELETE_IF_NOT_NULL(ckv_new);
+          return result_code;
         }
         if (!ckv_new) {
           ckv_new = tmp_ckv;
@@ -941,6 +935,16 @@ upll_rc_t VbrPortMapMoMgr::PopulateGvtnId(ConfigKeyVal *ckv_spd,
           prev_ckv->AppendCfgKeyVal(tmp_ckv);
         }
       }
+      // All the label rows are created with a single bulk DAL call
+      DbSubOp dbop_update = { kOpNotRead, kOpMatchNone, kOpInOutNone };
+      result_code = UpdateConfigDBBulk(ckv_new, UPLL_DT_CANDIDATE,
+                                       UNC_OP_CREATE, dmi, &dbop_update,
+                                       config_mode, vtn_name, GVTNIDTBL);
+      if (result_code != UPLL_RC_SUCCESS) {
+        UPLL_LOG_ERROR("Error in UpdateConfigDB: %d", result_code);
+        DELETE_IF_NOT_NULL(ckv_new);
+        return result_code;
+      }
       ckv_gvtn->ResetWith(ckv_new);
       DELETE_IF_NOT_NULL(ckv_new);
     }
@@ -1295,8 +1295,9 @@ VtnDataflowMoMgr::TraversePFCController(ConfigKeyVal *ckv_df,
       df_segm->sessReadDataflow(*cl_sess, arg);
       pfc_flows.push_back(df_segm);
     }
-    df_util->upll_pfc_flows.insert(std::pair<key_vtn_ctrlr_dataflow,
-                     vector<DataflowDetail *> > (vtn_ctrlr_df_key, pfc_flows));
+    iter = df_util->upll_pfc_flows.insert(std::pair<key_vtn_ctrlr_dataflow,
+                     vector<DataflowDetail *> > (vtn_ctrlr_df_key,
+                                                 pfc_flows)).first;
     UPLL_LOG_DEBUG(
         "Got upll_pfc_flows from driver. flows.size=%" PFC_PFMT_SIZE_T
         "", pfc_flows.size());
@@ -1306,22 +1307,33 @@ VtnDataflowMoMgr::TraversePFCController(ConfigKeyVal *ckv_df,
     UPLL_LOG_DEBUG("Got pfc_flows from map. flows.size=%" PFC_PFMT_SIZE_T "",
                  pfc_flows.size());
   }
-  for (uint32_t i = 0; i < pfc_flows.size(); i++) {
+  // Flows which may match the output matches of the previous flow are
+  // looked up from the index of the flows, in the order of the flows
+  vector<uint32_t> flow_positions;
+  DataflowMatch prev_matches;
+  DataflowFlowIndex *flow_index = NULL;
+  if (!is_first_ctrlr) {
+    prev_matches = DataflowMatch(lastPfcNode->output_matches);
+    flow_index = df_util->get_flow_index(iter->second);
+    flow_index->Lookup(prev_matches, &flow_positions);
+  } else {
+    for (uint32_t i = 0; i < pfc_flows.size(); i++)
+      flow_positions.push_back(i);
+  }
+  for (uint32_t pos = 0; pos < flow_positions.size(); pos++) {
+    uint32_t i = flow_positions[pos];
     DataflowDetail *df_segm = pfc_flows[i];
     bool is_vnode_match = false;
-    DataflowCmn *df_cmn = new DataflowCmn(is_first_ctrlr, df_segm);
     if (!is_first_ctrlr) {
-      bool match_result = df_cmn->check_match_condition
-                                      (lastPfcNode->output_matches);
-      if (!match_result) {
+      if (!flow_index->Matches(i, prev_matches)) {
           UPLL_LOG_DEBUG("2nd flow (id=%" PFC_PFMT_u64
             ") is not matching with 1st flow (id=%" PFC_PFMT_u64
-            ") so ignoring", df_cmn->df_segment->vtn_df_common->flow_id,
+            ") so ignoring", df_segm->vtn_df_common->flow_id,
             currentnode->df_segment->vtn_df_common->flow_id);
-        delete df_cmn;
         continue;
       }
     }
+    DataflowCmn *df_cmn = new DataflowCmn(is_first_ctrlr, df_segm);
     // Store pfc_vtn_name in df_cmn object.
     uuu::upll_strncpy(df_cmn->pfc_vtn_name, pfc_vtn_name,
                      (kMaxLenVtnName+1));
@@ -26,6 +26,8 @@ using unc::dataflow::kidx_val_vtn_dataflow_cmn;
 using unc::dataflow::DataflowCmn;
 using unc::dataflow::DataflowDetail;
 using unc::dataflow::DataflowUtil;
+using unc::dataflow::DataflowMatch;
+using unc::dataflow::DataflowFlowIndex;
 using unc::dataflow::key_vtn_ctrlr_dataflow;
 using unc::dataflow::actions_vect_st;
 using unc::dataflow::AddlData;
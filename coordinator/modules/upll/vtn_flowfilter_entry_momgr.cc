@@ -22,6 +22,7 @@ using std::string;
 using std::set;
 using std::map;
 using unc::upll::ipc_util::IpcUtil;
+using unc::upll::ipc_util::ConfigKeyValChain;
 #define GET_VALID_MAINCTRL(tbl, l_val_ctrl_ff, l_val_ff, en) \
   (tbl == MAINTBL) ? &(l_val_ff->valid[en]) : &(l_val_ctrl_ff->valid[en])
 namespace unc {
@@ -1117,78 +1118,77 @@ upll_rc_t VtnFlowFilterEntryMoMgr::MergeImportToCandidate(
           continue;
         }
 
-        ConfigKeyVal *tmp_ffe_imkey = ffe_imkey;
-        while (ffe_imkey != NULL) {
-        /* Create the record in flow-filter entry main tbl */
-        result_code = UpdateConfigDB(ffe_imkey, UPLL_DT_CANDIDATE,
-                                     UNC_OP_CREATE, dmi, TC_CONFIG_GLOBAL,
-                                     vtn_id, MAINTBL);
-       if (result_code != UPLL_RC_SUCCESS) {
-         UPLL_LOG_INFO("create in CandidateDB failed (%d) ", result_code);
-         DELETE_IF_NOT_NULL(tmp_ffe_imkey);
-         DELETE_IF_NOT_NULL(tmp_ckval);
-         return result_code;
-       }
-
-       std::list<controller_domain_t>::iterator it= list_ctrlr_dom.begin();
-       while (it != list_ctrlr_dom.end()) {
-       /* Create the record in flow-filter entry ctrlr table with ctrlr
-        * and domain */
-         ConfigKeyVal *ctrlckv = NULL;
-         GET_USER_DATA_FLAGS(ffe_imkey, flag);
-         UPLL_LOG_DEBUG("flag (%d)", flag);
-
-         key_vtn_flowfilter_entry_t *vtn_ffe_key =
-           reinterpret_cast<key_vtn_flowfilter_entry_t*>
-           (ConfigKeyVal::Malloc(sizeof(key_vtn_flowfilter_entry_t)));
-         memcpy(vtn_ffe_key, reinterpret_cast<key_vtn_flowfilter_entry_t*>
-            (ffe_imkey->get_key()), sizeof(key_vtn_flowfilter_entry_t));
-
-         val_vtn_flowfilter_entry_t *vtn_ffe_val = reinterpret_cast
-            <val_vtn_flowfilter_entry_t *>(GetVal(ffe_imkey));
-
-         val_vtn_flowfilter_entry_ctrlr_t *ctrlr_val = reinterpret_cast
-            <val_vtn_flowfilter_entry_ctrlr_t *>(ConfigKeyVal::Malloc(sizeof
-            (val_vtn_flowfilter_entry_ctrlr_t)));
-         /* Get the VALID from main table record and update into ctrl tbl*/
-         for (unsigned int loop = 0;
-            loop < (sizeof(ctrlr_val->valid)/sizeof(ctrlr_val->valid[0]));
-            loop++) {
-           if (UNC_VF_NOT_SUPPORTED == vtn_ffe_val->valid[loop]) {
-             ctrlr_val->valid[loop] = UNC_VF_INVALID;
-           } else {
-             ctrlr_val->valid[loop] = vtn_ffe_val->valid[loop];
-           }
+        /* Create the records in flow-filter entry main tbl */
+        result_code = UpdateConfigDBBulk(ffe_imkey, UPLL_DT_CANDIDATE,
+                                         UNC_OP_CREATE, dmi, NULL,
+                                         TC_CONFIG_GLOBAL, vtn_id, MAINTBL);
+        if (result_code != UPLL_RC_SUCCESS) {
+          UPLL_LOG_INFO("create in CandidateDB failed (%d) ", result_code);
+          FREE_LIST_CTRLR(list_ctrlr_dom);
+          DELETE_IF_NOT_NULL(ffe_imkey);
+          DELETE_IF_NOT_NULL(tmp_ckval);
+          return result_code;
         }
 
-        ctrlcv = new ConfigVal(IpctSt::kIpcInvalidStNum, ctrlr_val);
-        ctrlckv = new ConfigKeyVal(UNC_KT_VTN_FLOWFILTER_ENTRY,
-                               IpctSt::kIpcStKeyVtnFlowfilterEntry,
-                               vtn_ffe_key, ctrlcv);
+        /* Create the records in flow-filter entry ctrlr tbl with each ctrlr
+         * and domain */
+        ConfigKeyValChain ctrlr_ckvs;
+        for (ConfigKeyVal *tkey = ffe_imkey; tkey != NULL;
+             tkey = tkey->get_next_cfg_key_val()) {
+          GET_USER_DATA_FLAGS(tkey, flag);
+          UPLL_LOG_DEBUG("flag (%d)", flag);
+          val_vtn_flowfilter_entry_t *vtn_ffe_val = reinterpret_cast
+              <val_vtn_flowfilter_entry_t *>(GetVal(tkey));
+          std::list<controller_domain_t>::iterator it= list_ctrlr_dom.begin();
+          for (; it != list_ctrlr_dom.end(); ++it) {
+            key_vtn_flowfilter_entry_t *vtn_ffe_key =
+                reinterpret_cast<key_vtn_flowfilter_entry_t*>
+                (ConfigKeyVal::Malloc(sizeof(key_vtn_flowfilter_entry_t)));
+            memcpy(vtn_ffe_key, tkey->get_key(),
+                   sizeof(key_vtn_flowfilter_entry_t));
+
+            val_vtn_flowfilter_entry_ctrlr_t *ctrlr_val = reinterpret_cast
+                <val_vtn_flowfilter_entry_ctrlr_t *>(ConfigKeyVal::Malloc(
+                sizeof(val_vtn_flowfilter_entry_ctrlr_t)));
+            /* Get the VALID from main table record and update into ctrl
+             * tbl */
+            for (unsigned int loop = 0;
+                 loop < (sizeof(ctrlr_val->valid)/sizeof(ctrlr_val->valid[0]));
+                 loop++) {
+              if (UNC_VF_NOT_SUPPORTED == vtn_ffe_val->valid[loop]) {
+                ctrlr_val->valid[loop] = UNC_VF_INVALID;
+              } else {
+                ctrlr_val->valid[loop] = vtn_ffe_val->valid[loop];
+              }
+            }
 
-         SET_USER_DATA_CTRLR_DOMAIN(ctrlckv, *it);
-         SET_USER_DATA_FLAGS(ctrlckv, flag);
-         UPLL_LOG_DEBUG("flag (%d)", flag);
+            ctrlcv = new ConfigVal(IpctSt::kIpcInvalidStNum, ctrlr_val);
+            ConfigKeyVal *ctrlckv = new ConfigKeyVal(
+                UNC_KT_VTN_FLOWFILTER_ENTRY,
+                IpctSt::kIpcStKeyVtnFlowfilterEntry, vtn_ffe_key, ctrlcv);
+            SET_USER_DATA_CTRLR_DOMAIN(ctrlckv, *it);
+            SET_USER_DATA_FLAGS(ctrlckv, flag);
+            ctrlr_ckvs.Append(ctrlckv);
+          }
+        }
+        DELETE_IF_NOT_NULL(ffe_imkey);
+        FREE_LIST_CTRLR(list_ctrlr_dom);
 
-         // Create a record in ctrlr tbl in candidate db
-         result_code = UpdateConfigDB(ctrlckv, UPLL_DT_CANDIDATE,
-                                      UNC_OP_CREATE, dmi, TC_CONFIG_GLOBAL,
-                                      vtn_id, CTRLRTBL);
-         if (result_code != UPLL_RC_SUCCESS) {
-           UPLL_LOG_INFO("Err during insert of the record in ctrlr table (%d)",
-                         result_code);
-           DELETE_IF_NOT_NULL(ctrlckv);
-           DELETE_IF_NOT_NULL(tmp_ffe_imkey);
-           DELETE_IF_NOT_NULL(tmp_ckval);
-           return result_code;
-         }
-         DELETE_IF_NOT_NULL(ctrlckv);
-         ++it;
-       }
-       ffe_imkey = ffe_imkey->get_next_cfg_key_val();
-     }
-     DELETE_IF_NOT_NULL(ffe_imkey);
-     FREE_LIST_CTRLR(list_ctrlr_dom);
+        if (!ctrlr_ckvs.empty()) {
+          // Create the records in ctrlr tbl in candidate db
+          result_code = UpdateConfigDBBulk(ctrlr_ckvs.head(),
+                                           UPLL_DT_CANDIDATE,
+                                           UNC_OP_CREATE, dmi, NULL,
+                                           TC_CONFIG_GLOBAL, vtn_id,
+                                           CTRLRTBL);
+          ctrlr_ckvs.Clear();
+          if (result_code != UPLL_RC_SUCCESS) {
+            UPLL_LOG_INFO("Err during insert of the records in ctrlr table "
+                          "(%d)", result_code);
+            DELETE_IF_NOT_NULL(tmp_ckval);
+            return result_code;
+          }
+        }
      }
   } else if (imp_instance_count < cand_instance_count) {
       /* If vtn exists in both db, then check the flow-filter entry existence
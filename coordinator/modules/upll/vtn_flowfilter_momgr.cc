@@ -19,6 +19,7 @@
 #include "ctrlr_capa_defines.hh"
 #include "vtn_momgr.hh"
 
+using unc::upll::ipc_util::ConfigKeyValChain;
 
 namespace unc {
 namespace upll {
@@ -299,56 +300,56 @@ upll_rc_t VtnFlowFilterMoMgr::MergeImportToCandidate(unc_key_type_t keytype,
            continue;
         }
 
-        ConfigKeyVal *tmp_ff_imkey = ff_imkey;
-        while (ff_imkey != NULL) {
-        // Create the flow-filter in main tbl
-        result_code = UpdateConfigDB(ff_imkey, UPLL_DT_CANDIDATE, UNC_OP_CREATE,
-                               dmi, TC_CONFIG_GLOBAL, vtn_id, MAINTBL);
+        // Create the flow-filters in main tbl
+        result_code = UpdateConfigDBBulk(ff_imkey, UPLL_DT_CANDIDATE,
+                                         UNC_OP_CREATE, dmi, NULL,
+                                         TC_CONFIG_GLOBAL, vtn_id, MAINTBL);
         if (result_code != UPLL_RC_SUCCESS) {
           UPLL_LOG_DEBUG("create in CandidateDB failed (%d) ", result_code);
-          DELETE_IF_NOT_NULL(tmp_ff_imkey);
+          FREE_LIST_CTRLR(list_ctrlr_dom);
+          DELETE_IF_NOT_NULL(ff_imkey);
           DELETE_IF_NOT_NULL(tmp_ckval);
           return result_code;
         }
 
-        std::list<controller_domain_t>::iterator it= list_ctrlr_dom.begin();
-        while (it != list_ctrlr_dom.end()) {
-         // Create the entry in ctrlr table with as per the ctrlr and domain
-         ConfigKeyVal *ctrlckv = NULL;
-         GET_USER_DATA_FLAGS(ff_imkey, flag);
-         UPLL_LOG_DEBUG("flag (%d)", flag);
-
-         key_vtn_flowfilter_t *vtn_ff_key = reinterpret_cast
-           <key_vtn_flowfilter_t*>(ConfigKeyVal::Malloc
-           (sizeof(key_vtn_flowfilter_t)));
-         memcpy(vtn_ff_key, reinterpret_cast<key_vtn_flowfilter_t*>
-           (ff_imkey->get_key()), sizeof(key_vtn_flowfilter_t));
-
-         ctrlckv = new ConfigKeyVal(UNC_KT_VTN_FLOWFILTER,
-                       IpctSt::kIpcInvalidStNum, vtn_ff_key, NULL);
-         SET_USER_DATA_CTRLR_DOMAIN(ctrlckv, *it);
-         SET_USER_DATA_FLAGS(ctrlckv, flag);
-         UPLL_LOG_DEBUG("flag (%d)", flag);
-
-         // Create a record in ctrlr tbl in candidate db
-         result_code = UpdateConfigDB(ctrlckv, UPLL_DT_CANDIDATE,
-                       UNC_OP_CREATE, dmi, TC_CONFIG_GLOBAL, vtn_id,
-                       CTRLRTBL);
-         if (result_code != UPLL_RC_SUCCESS) {
-           UPLL_LOG_DEBUG("Err while inserting in ctrlr table (%d)",
-                         result_code);
-           DELETE_IF_NOT_NULL(ctrlckv);
-           DELETE_IF_NOT_NULL(tmp_ff_imkey);
-           DELETE_IF_NOT_NULL(tmp_ckval);
-           return result_code;
-         }
-         DELETE_IF_NOT_NULL(ctrlckv);
-         ++it;
-       }
-       ff_imkey = ff_imkey->get_next_cfg_key_val();
-     }
-     FREE_LIST_CTRLR(list_ctrlr_dom);
-     DELETE_IF_NOT_NULL(ff_imkey);
+        // Create the entries in ctrlr table as per the ctrlr and domain
+        ConfigKeyValChain ctrlr_ckvs;
+        for (ConfigKeyVal *tkey = ff_imkey; tkey != NULL;
+             tkey = tkey->get_next_cfg_key_val()) {
+          GET_USER_DATA_FLAGS(tkey, flag);
+          UPLL_LOG_DEBUG("flag (%d)", flag);
+          std::list<controller_domain_t>::iterator it= list_ctrlr_dom.begin();
+          for (; it != list_ctrlr_dom.end(); ++it) {
+            key_vtn_flowfilter_t *vtn_ff_key = reinterpret_cast
+                <key_vtn_flowfilter_t*>(ConfigKeyVal::Malloc
+                (sizeof(key_vtn_flowfilter_t)));
+            memcpy(vtn_ff_key, tkey->get_key(), sizeof(key_vtn_flowfilter_t));
+
+            ConfigKeyVal *ctrlckv = new ConfigKeyVal(UNC_KT_VTN_FLOWFILTER,
+                IpctSt::kIpcInvalidStNum, vtn_ff_key, NULL);
+            SET_USER_DATA_CTRLR_DOMAIN(ctrlckv, *it);
+            SET_USER_DATA_FLAGS(ctrlckv, flag);
+            ctrlr_ckvs.Append(ctrlckv);
+          }
+        }
+        FREE_LIST_CTRLR(list_ctrlr_dom);
+        DELETE_IF_NOT_NULL(ff_imkey);
+
+        if (!ctrlr_ckvs.empty()) {
+          // Create the records in ctrlr tbl in candidate db
+          result_code = UpdateConfigDBBulk(ctrlr_ckvs.head(),
+                                           UPLL_DT_CANDIDATE,
+                                           UNC_OP_CREATE, dmi, NULL,
+                                           TC_CONFIG_GLOBAL, vtn_id,
+                                           CTRLRTBL);
+          ctrlr_ckvs.Clear();
+          if (result_code != UPLL_RC_SUCCESS) {
+            UPLL_LOG_DEBUG("Err while inserting in ctrlr table (%d)",
+                           result_code);
+            DELETE_IF_NOT_NULL(tmp_ckval);
+            return result_code;
+          }
+        }
      }
   } else if (imp_instance_count < cand_instance_count) {
       // If vtn exists in both db, then check the flow-filter existence
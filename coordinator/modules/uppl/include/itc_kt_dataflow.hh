@@ -32,6 +32,8 @@ using std::map;
 using std::multimap;
 using unc::uppl::ODBCMOperator;
 using unc::dataflow::DataflowUtil;
+using unc::dataflow::DataflowMatch;
+using unc::dataflow::DataflowFlowIndex;
 using unc::dataflow::DataflowCmn;
 using unc::dataflow::DataflowDetail;
 using unc::dataflow::kidx_val_df_data_flow_cmn;
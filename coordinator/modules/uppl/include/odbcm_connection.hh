@@ -40,7 +40,9 @@ class OdbcmConnectionHandler {
                                     conn_type_(conn_type),
                                     conn_handle_(NULL),
                                     odbc_manager_(odbc_manager),
-                                    using_session_id_(0) {
+                                    using_session_id_(0),
+                                    batch_transaction_(false),
+                                    stmt_cache_enabled_(false) {
       conn_status = UNC_RC_SUCCESS;
       ODBCM_RC_STATUS db_ret = odbc_manager_->OpenDBConnection(this);
       if (db_ret != ODBCM_RC_SUCCESS) {
@@ -81,11 +83,47 @@ class OdbcmConnectionHandler {
       return conn_handle_;
     }
 
+    /*
+    * Edit operations on a connection in batch transaction are not
+    * committed until ODBCManager::EndBatchTransaction() is called
+    */
+    void set_batch_transaction(bool batch) {
+      batch_transaction_ = batch;
+    }
+
+    bool is_batch_transaction() {
+      return batch_transaction_;
+    }
+
+    /*
+    * Prepared statements are cached only if the driver of this connection
+    * keeps them prepared across commit and rollback
+    */
+    void set_stmt_cache_enabled(bool enabled) {
+      stmt_cache_enabled_ = enabled;
+    }
+
+    bool is_stmt_cache_enabled() {
+      return stmt_cache_enabled_;
+    }
+
+    /*
+    * Prepared statements kept for reuse on this connection, keyed by
+    * the query string. Accessed only by ODBCManager with
+    * PhysicalLayer::stmt_cache_mutex_ held
+    */
+    std::map<std::string, HSTMT>& get_stmt_cache() {
+      return stmt_cache_;
+    }
+
   private:
     OdbcmConnType conn_type_;
     SQLHDBC conn_handle_;  // Connection handler to create ODBC Connection
     ODBCManager *odbc_manager_;
     uint64_t using_session_id_;
+    bool batch_transaction_;
+    bool stmt_cache_enabled_;
+    std::map<std::string, HSTMT> stmt_cache_;
 };
 
 class ScopedDBConnection {
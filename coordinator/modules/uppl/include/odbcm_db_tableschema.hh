@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2014 NEC Corporation
+ * Copyright (c) 2012-2015 NEC Corporation
  * All rights reserved.
  * 
  * This program and the accompanying materials are made available under the
@@ -21,6 +21,15 @@
 #include <vector>
 #include "odbcm_common.hh"
 
+/*
+ * Size of a block in the column value arena of DBTableSchema
+ */
+#define ODBCM_VALUE_ARENA_BLOCK_SIZE   (64 * 1024)
+/*
+ * Alignment of a column value allocated from the arena
+ */
+#define ODBCM_VALUE_ARENA_ALIGN        sizeof(uint64_t)
+
 namespace unc {
 namespace uppl {
 
@@ -76,7 +85,8 @@ class DBTableSchema {
     /*
      * To push the attribute vector to the row_list_
      */
-    void PushBackToRowList(std::vector <TableAttrSchema> attributes_vector);
+    void PushBackToRowList(const std::vector <TableAttrSchema>
+                           &attributes_vector);
     /*
      * To set the primary keys
      */
@@ -84,7 +94,7 @@ class DBTableSchema {
     /*
      * To set the row list 
      */
-    void set_row_list(std::list <std::vector<TableAttrSchema> >);
+    void set_row_list(const std::list <std::vector<TableAttrSchema> >&);
     /*
      * To free the memory in DBTableSchema
      */
@@ -97,8 +107,47 @@ class DBTableSchema {
      * Method to print the database schema information
      */
     void PrintDBTableSchema();
+    /*
+     * To allocate a column value which lives until the rows are freed.
+     * Values are carved out of the arena owned by this schema, so that
+     * the fetched rows do not need one heap allocation per column.
+     */
+    void* AllocateAttributeValue(size_t size);
+    /*
+     * To free a column value of this schema, either allocated from the
+     * arena or with operator new by the caller
+     */
+    void FreeAttributeValue(void* value);
+    /*
+     * To get the size of a column value allocated from the arena,
+     * 0 is returned for other values
+     */
+    size_t GetAttributeValueSize(const void* value) const;
 
   private:
+    DBTableSchema(const DBTableSchema&);
+    DBTableSchema& operator=(const DBTableSchema&);
+    /*
+     * To check whether the value is carved out of the arena
+     */
+    bool IsArenaValue(const void* value) const;
+    /*
+     * To release all the arena blocks
+     */
+    void FreeValueArena();
+    /*
+     * Blocks of the column value arena, sorted by address so that
+     * IsArenaValue() finds the block of a value by binary search
+     */
+    std::vector <uint8_t*> arena_blocks_;
+    /*
+     * Arena block being filled
+     */
+    uint8_t* arena_current_;
+    /*
+     * Number of bytes used in the arena block being filled
+     */
+    size_t arena_used_;
     /*
     * To print the char buffer values in DBTableSchema
     */ 
@@ -19,6 +19,7 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <new>
 #include <vector>
 #include "odbcm_common.hh"
 #include "odbcm_db_tableschema.hh"
@@ -51,6 +52,10 @@ namespace uppl {
 #define ODBCM_SIZE_256          256
 #define ODBCM_SIZE_257          257
 #define ODBCM_SIZE_320          320
+/*
+ * Number of binary data buffer length indicators in DBVarbind
+ */
+#define ODBCM_BIND_LEN_COUNT    11
 /* 
  * uppl memcpy macro
  */
@@ -64,11 +69,13 @@ namespace uppl {
   memset((dst), (val), (size));
 /* 
  * Allocate memory for ColumnAttrValue template, 
- * this will be called up in the fetch functions
+ * this will be called up in the fetch functions.
+ * The value is zero filled by AllocateColumnAttrValue
  */
 #define ODBCM_ALLOCATE_COLUMN_ATTRVALUE_T(dt, T_name)          \
-  ColumnAttrValue <dt> *(T_name) = new ColumnAttrValue <dt>; \
-  ODBCM_MEMSET((T_name), '\0', sizeof(dt));
+  ColumnAttrValue <dt> *(T_name) = new                          \
+  (AllocateColumnAttrValue(sizeof(ColumnAttrValue <dt>)))       \
+  ColumnAttrValue <dt>;
 
 /* 
  * To bind the input datatypes
@@ -483,6 +490,11 @@ class DBVarbind {
      * Clear the allocated memory after usage of structure is over
      */
     void FreeingBindedStructure(const uint32_t);
+    /*
+     * Set the DBTableSchema whose arena holds the fetched column values.
+     * If not set, each column value is allocated with operator new
+     */
+    void set_value_arena(DBTableSchema *db_table_schema);
     /* 
      * Pointer to db table structures
      */
@@ -499,7 +511,7 @@ class DBVarbind {
       */
     is_row_exists_t             *p_isrowexists;
     /** 
-      * Binary data buffer length pointers
+      * Binary data buffer length pointers, point into bind_len_
       */
     SQLLEN *p_switch_id1_len;
     SQLLEN *p_switch_id2_len;
@@ -514,6 +526,19 @@ class DBVarbind {
     SQLLEN *p_connected_switch_id_len;
 
   private:
+    /** 
+      * Length indicators are kept in the object itself, so that
+      * no heap allocation is required for each DB operation
+      */
+    SQLLEN bind_len_[ODBCM_BIND_LEN_COUNT];
+    /**
+      * DBTableSchema which owns the fetched column values, or NULL
+      */
+    DBTableSchema *p_value_arena_;
+
+    /** To allocate a zero filled column value in the fetch functions */
+    void* AllocateColumnAttrValue(size_t size);
+
     /** Binding methods for controller_table*/
     ODBCM_RC_STATUS bind_controller_table_input(
         std::vector<TableAttrSchema>&/*DBTableSchema->rowlist_ entry*/,
@@ -22,6 +22,7 @@
 #include <list>
 #include "odbcm_common.hh"
 #include "odbcm_db_tableschema.hh"
+#include "odbcm_read_cache.hh"
 namespace unc {
 namespace uppl {
 
@@ -46,6 +47,32 @@ namespace uppl {
       (status) = ODBCM_RC_TRANSACTION_ERROR; \
   }
 
+/**savepoint kept at the last successful edit in batch transaction*/
+#define ODBCM_BATCH_SAVEPOINT "uppl_batch_row"
+
+/**macro for ending an edit operation, which is deferred to the end of
+ * the batch transaction if the connection is in batch transaction*/
+#define ODBCM_END_EDIT_TRANSACTION(conn_obj, trans, status) \
+  { \
+    ODBCM_RC_STATUS end_rc = EndEditTransaction((conn_obj), (trans)); \
+    if (end_rc != ODBCM_RC_SUCCESS) \
+      (status) = end_rc; \
+  }
+
+/**macro for ending a read operation. In batch transaction, the edit
+ * operations done so far are kept and only a failed read is rolled back*/
+#define ODBCM_END_READ_TRANSACTION(conn_obj, conn, status) \
+  { \
+    if ((conn_obj)->is_batch_transaction() == false) { \
+      ODBCM_ROLLBACK_TRANSACTION(conn); \
+    } else if ((status) != ODBCM_RC_SUCCESS && \
+               (status) != ODBCM_RC_RECORD_NOT_FOUND && \
+               (status) != ODBCM_RC_ROW_EXISTS && \
+               (status) != ODBCM_RC_ROW_NOT_EXISTS) { \
+      EndEditTransaction((conn_obj), SQL_ROLLBACK); \
+    } \
+  }
+
 /**macro to allocate memory for SQL statement handler*/
 #define ODBCM_STATEMENT_CREATE(conn_handle, stmt, odbc_rc) \
   if (NULL != (conn_handle)) { \
@@ -53,6 +80,9 @@ namespace uppl {
     ODBCM_STMT_HANDLE_CHECK((stmt), (conn_handle), (odbc_rc)); \
 }
 
+/**maximum number of prepared statements cached on a connection*/
+#define ODBCM_STMT_CACHE_MAX 64
+
 /**macro to free the memory allocated object*/
 #define ODBCM_FREE_MEMORY(object) \
   if (NULL != (object)) \
@@ -134,6 +164,13 @@ class ODBCManager {
     ODBCM_RC_STATUS FreeingConnections(bool IsAllOrUnused);
     // Closes the Read Write connections
     ODBCM_RC_STATUS CloseRwConnection();
+    /**start a batch transaction on the given read write connection.
+     * Edit operations are not committed until EndBatchTransaction() is
+     * called, and the SQL execution lock is held until then*/
+    ODBCM_RC_STATUS BeginBatchTransaction(OdbcmConnectionHandler *conn_obj);
+    /**commit or rollback the batch transaction*/
+    ODBCM_RC_STATUS EndBatchTransaction(OdbcmConnectionHandler *conn_obj,
+                                        bool commit);
 
     /** getter method for db_table_list_map_ private member*/
     std::map<int, std::vector<std::string> >& get_db_table_list_map_();
@@ -167,6 +204,28 @@ class ODBCManager {
                                  * column names with data type*/,
                                  OdbcmConnectionHandler *conn_obj,
                                  bool IsInternal);
+    /**
+     * This method creates all rows in the DBTableSchema row list with one
+     * prepared statement, and commits them as one transaction. All rows
+     * must have the same columns. UNC_DT_CANDIDATE is not supported since
+     * cs_row_status of existing rows is not checked.
+     * */
+    ODBCM_RC_STATUS CreateRows(unc_keytype_datatype_t/**Database type*/,
+                               DBTableSchema&
+                               /**object which carries the table
+                               ,pkeys,column names with data type*/,
+                               OdbcmConnectionHandler *conn_obj);
+    /**
+     * This method updates all rows in the DBTableSchema row list with one
+     * prepared statement, and commits them as one transaction. All rows
+     * must have the same columns with primary keys first.
+     * UNC_DT_CANDIDATE is not supported.
+     * */
+    ODBCM_RC_STATUS UpdateRows(unc_keytype_datatype_t/**Database type*/,
+                               DBTableSchema&
+                               /**object which carries the table,pkeys,
+                               * column names with data type*/,
+                               OdbcmConnectionHandler *conn_obj);
     /**
      * This method deletes the attributes of single key tree
      * instance in a row, the row entry will not be actually deleted in the case
@@ -310,6 +369,36 @@ class ODBCManager {
     /**initialize the map with database and corresponding tables on
      * each database. */
     ODBCM_RC_STATUS initialize_db_table_list_map_(void);
+    /**commit or rollback the last edit or read statement*/
+    ODBCM_RC_STATUS EndEditTransaction(OdbcmConnectionHandler *conn_obj,
+                                       SQLSMALLINT trans);
+    /**execute the given transaction control statement*/
+    ODBCM_RC_STATUS ExecuteBatchStatement(SQLHDBC conn_handle,
+                                          const char *query);
+    /**create or update all rows in the DBTableSchema with one statement*/
+    ODBCM_RC_STATUS ExecuteEditRows(UpplDbOperationType operation,
+                                    unc_keytype_datatype_t db_name,
+                                    DBTableSchema &db_table_schema,
+                                    OdbcmConnectionHandler *conn_obj);
+    /**get the prepared statement for the query from the statement cache
+     * of the connection, or prepare a new one*/
+    ODBCM_RC_STATUS AcquireQueryStatement(OdbcmConnectionHandler *conn_obj,
+                                          const std::string &query,
+                                          HSTMT &stmt);
+    /**return the statement to the statement cache of the connection,
+     * or free it if it can not be reused*/
+    void ReleaseQueryStatement(OdbcmConnectionHandler *conn_obj,
+                               const std::string &query,
+                               HSTMT &stmt, ODBCM_RC_STATUS status);
+    /**free all cached statements of the connection*/
+    void FreeStatementCache(OdbcmConnectionHandler *conn_obj);
+    /**return the connection object which keeps the statement cache*/
+    OdbcmConnectionHandler *get_stmt_cache_owner_(
+        OdbcmConnectionHandler *conn_obj);
+    /**return true if the read may be served from or stored into the
+     * topology read cache*/
+    bool IsReadCached(DBTableSchema &db_table_schema,
+                      OdbcmConnectionHandler *conn_obj);
     /**allocate connection handler for rw_conn_handle_*/
     inline ODBCM_RC_STATUS set_rw_connection_handle_(SQLHDBC&);
     /**allocate connection handler for ro_conn_handle_*/
@@ -328,6 +417,8 @@ class ODBCManager {
     std::map<uint64_t, OdbcmConnectionHandler*> conpool_inuse_map_;
     std::list<OdbcmConnectionHandler*> conpool_free_list_;
     uint32_t conn_max_limit_;
+    // cached reads of the physical topology tables
+    OdbcmReadCache read_cache_;
 };
 }  // namespace uppl
 }  // namespace unc
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2012-2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * @brief   ODBC Manager
+ * @file    odbcm_read_cache.hh
+ */
+
+#ifndef _ODBCM_READ_CACHE_HH_
+#define _ODBCM_READ_CACHE_HH_
+
+#include <pfcxx/synch.hh>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "odbcm_common.hh"
+#include "odbcm_db_tableschema.hh"
+
+/*
+ * Maximum number of reads cached for a table
+ */
+#define ODBCM_READ_CACHE_MAX_ENTRIES   256
+
+namespace unc {
+namespace uppl {
+
+/*
+ * In-memory cache of the physical topology reads.
+ *
+ * Results of GetOneRow and GetBulkRows on the switch, port, link and
+ * logical port tables are kept by the query and its input values.
+ * UPPL is the only writer of these tables, and all reads and writes are
+ * serialized by the SQL execution lock. Each edit operation drops the
+ * cached reads of its table while it holds the lock, and a read stores
+ * its result before the lock is released. So a cached read is always
+ * the committed content of the table.
+ */
+class OdbcmReadCache {
+  public:
+    OdbcmReadCache();
+    ~OdbcmReadCache();
+    /*
+     * To check whether reads of the table are cached
+     */
+    static bool IsCachedTable(ODBCMTable table_id);
+    /*
+     * To build the key of a read from the query and the input row
+     */
+    static std::string BuildKey(const std::string &query,
+                                DBTableSchema &db_table_schema);
+    /*
+     * To fill the cached rows of the read into db_table_schema.
+     * The first row is filled in place, and the others are appended.
+     */
+    bool Lookup(ODBCMTable table_id, const std::string &key,
+                DBTableSchema &db_table_schema, ODBCM_RC_STATUS &status);
+    /*
+     * To store the rows of db_table_schema fetched by the read
+     */
+    void Store(ODBCMTable table_id, const std::string &key,
+               DBTableSchema &db_table_schema, ODBCM_RC_STATUS status);
+    /*
+     * To drop the cached reads of the table, UNKNOWN_TABLE drops all
+     */
+    void Invalidate(ODBCMTable table_id);
+
+  private:
+    /*
+     * Cached result of a read. Column values are kept in row major
+     * order, columns values per row.
+     */
+    struct Entry {
+      ODBCM_RC_STATUS status;
+      uint32_t columns;
+      std::vector<std::string> values;
+    };
+    /*
+     * Cached reads of a table, and their keys in insertion order
+     */
+    struct TableCache {
+      std::map<std::string, Entry> entries;
+      std::list<std::string> order;
+    };
+    /*
+     * To get the number of bytes of an input value used in the key
+     */
+    static size_t GetKeyValueSize(const TableAttrSchema &attr,
+                                  DBTableSchema &db_table_schema);
+
+    pfc::core::Mutex mutex_;
+    std::map<ODBCMTable, TableCache> tables_;
+};
+
+}  // namespace uppl
+}  // namespace unc
+
+#endif  // _ODBCM_READ_CACHE_HH_
@@ -15,7 +15,10 @@
 #include <unc/keytype.h>
 #include <pfcxx/module.hh>
 #include <pfcxx/synch.hh>
+#include <pfc/atomic.h>
 #include <map>
+#include <deque>
+#include <vector>
 #include <string>
 #include <functional>
 #include "physical_common_def.hh"
@@ -24,9 +27,19 @@ using std::string;
 using std::map;
 using pfc::core::TaskQueue;
 using pfc::core::ReadWriteLock;
+using pfc::core::Mutex;
 namespace unc {
 namespace uppl {
 
+/* Maximum number of events taken by one drain task */
+#define UPPL_EVENT_BATCH_MAX  256
+
+/*
+ * Maximum number of events applied in one batch transaction. The SQL
+ * execution lock is held until the batch transaction ends.
+ */
+#define UPPL_EVENT_TXN_MAX  32
+
 typedef enum {
   TQ_EVENT = 0,
   TQ_ALARM
@@ -159,10 +172,36 @@ struct EventAlarmDetail {
   string controller_name;
 };
 
+class NotificationEventParams;
+
+/*
+ * Events waiting for a controller's task queue. Only one drain task is
+ * dispatched at a time, and it processes the pending events in batches.
+ */
+struct PhyEventBatchQueue {
+  PhyEventBatchQueue():scheduled(false) {
+  }
+  Mutex mutex;
+  std::deque<NotificationEventParams*> pending;
+  bool scheduled;
+};
+
 class PhyEventTaskqUtil {
   private:
   uint32_t concurrency_;
   map<string, TaskQueue*> taskq_map_;
+  map<string, PhyEventBatchQueue*> batchq_map_;
+  static uint64_t events_received_;
+  static uint64_t events_coalesced_;
+  static uint64_t events_committed_;
+  static uint64_t batches_committed_;
+  static uint64_t batches_replayed_;
+
+  void clear_batch_queue(PhyEventBatchQueue *batchq);
+  static uint32_t CoalesceEvents(std::vector<NotificationEventParams*>& events);
+  static void InvokeEventBatch(
+         std::vector<NotificationEventParams*>& events,
+         size_t begin, size_t end);
 
   public:
   explicit PhyEventTaskqUtil(uint32_t concurrency);
@@ -174,10 +213,46 @@ class PhyEventTaskqUtil {
 
   int DispatchNotificationEvent(
          EventAlarmDetail& event_detail, string ctr_name);
+  void ProcessEventBatch(PhyEventBatchQueue *batchq, TaskQueue *event_taskq);
   static ReadWriteLock taskqmap_mutex_;
   static ReadWriteLock* get_taskqmap_mutex_() {
     return &taskqmap_mutex_;
   }
+  static uint64_t get_events_received() {
+    return events_received_;
+  }
+  static uint64_t get_events_coalesced() {
+    return events_coalesced_;
+  }
+  static uint64_t get_events_committed() {
+    return events_committed_;
+  }
+  static uint64_t get_batches_committed() {
+    return batches_committed_;
+  }
+  static uint64_t get_batches_replayed() {
+    return batches_replayed_;
+  }
+};
+
+/*
+ * Task function which drains the pending events of a controller.
+ */
+class NotificationBatchParams: public std::unary_function < void, void > {
+  public:
+  NotificationBatchParams(PhyEventTaskqUtil *taskq_util,
+                          PhyEventBatchQueue *batchq,
+                          TaskQueue *event_taskq)
+      : taskq_util_(taskq_util), batchq_(batchq), event_taskq_(event_taskq) {
+  }
+  void operator() ()  {
+    taskq_util_->ProcessEventBatch(batchq_, event_taskq_);
+  }
+
+  private:
+  PhyEventTaskqUtil *taskq_util_;
+  PhyEventBatchQueue *batchq_;
+  TaskQueue *event_taskq_;
 };
 
 class NotificationEventParams: public std::unary_function < void, void > {
@@ -189,7 +264,10 @@ class NotificationEventParams: public std::unary_function < void, void > {
     InvokeNotificationEventProcess();
   }
   void InvokeNotificationEventProcess(void);
-  void InvokeProcessEvent(OdbcmConnectionHandler& db_conn);
+  void InvokeProcessEvent(OdbcmConnectionHandler& db_conn,
+                          bool check_ctr_status = true);
+  bool IsBatchable(void);
+  bool CanCoalesce(const NotificationEventParams& next);
   void InvokeProcessAlarm(OdbcmConnectionHandler& db_conn);
 };
 }
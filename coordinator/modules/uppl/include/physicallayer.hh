@@ -92,9 +92,11 @@ struct CtrOprnStatus {
   ScopedReadWriteLock timerLock(PhysicalLayer::get_timer_lock_(), \
         PFC_TRUE);
 
+/* The lock is not taken again by the thread owning a batch transaction */
 #define PHY_SQLEXEC_LOCK() \
-  ScopedReadWriteLock sqlexecLock(PhysicalLayer::get_phy_sqlexec_lock_(), \
-        PFC_TRUE);
+  ScopedReadWriteLock sqlexecLock( \
+        ((PhysicalLayer::phy_sqlexec_owner_ == PFC_TRUE) ? NULL : \
+         PhysicalLayer::get_phy_sqlexec_lock_()), PFC_TRUE);
 
 #define PHY_OPERSTATUS_LOCK(controller_name, ret_code, plock, lock_flag) \
 {  \
@@ -222,6 +224,7 @@ class PhysicalLayer : public pfc::core::Module {
   static Mutex ODBCManager_mutex_;
   static Mutex phyitc_mutex_;
   static Mutex db_conpool_mutex_;
+  static Mutex stmt_cache_mutex_;
   static Mutex ctr_oprn_mutex_;
   static Mutex fatal_mutex_;
   static ReadWriteLock phy_fini_db_lock_;
@@ -231,6 +234,8 @@ class PhysicalLayer : public pfc::core::Module {
   static ReadWriteLock events_done_lock_;
   static ReadWriteLock timer_lock_;
   static ReadWriteLock phy_sqlexec_lock_;
+  static __thread pfc_bool_t phy_sqlexec_owner_;
+  static __thread pfc_bool_t phy_event_replay_;
   static uint8_t phyFiniFlag;
   static bool is_fatal_done;
   static std::map<string, CtrOprnStatus> ctr_oprn_status_;
@@ -246,6 +251,10 @@ class ScopedReadWriteLock {
  public:
   ScopedReadWriteLock(ReadWriteLock* coreRwLock, pfc_bool_t isWriteLock)
   : rwLock(coreRwLock), isWrLock(isWriteLock) {
+    if (rwLock == NULL) {
+      // Lock is already held by the caller
+      return;
+    }
     if (isWrLock == PFC_TRUE) {
       pfc_log_debug("ScopedReadWriteLock write lock");
       rwLock->wrlock();
@@ -256,6 +265,9 @@ class ScopedReadWriteLock {
   }
 
   ~ScopedReadWriteLock() {
+    if (rwLock == NULL) {
+      return;
+    }
     if (isWrLock == PFC_TRUE) {
       pfc_log_debug("ScopedReadWriteLock write unlock");
     } else {
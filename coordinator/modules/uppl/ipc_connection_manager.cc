@@ -169,6 +169,11 @@ string IPCConnectionManager::get_uppl_service_name() {
 uint32_t IPCConnectionManager::SendEvent(ServerEvent *evt,
                                  std::string controller_name,
                                  pfc_ipcevtype_t event_type) {
+  if (PhysicalLayer::phy_event_replay_ == PFC_TRUE) {
+    // The event was already posted when the failed batch was applied
+    pfc_log_debug("Event of replayed batch is not posted again");
+    return 0;
+  }
   uint32_t ret = ipc_server_handler_->SendEvent(evt);
   //  IPC service name, and `type' is an IPC event type
   PhysicalLayer *physical_layer = PhysicalLayer::get_instance();
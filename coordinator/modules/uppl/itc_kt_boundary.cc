@@ -1244,7 +1244,7 @@ void Kt_Boundary::FillBoundaryValueStructure(
   // populate IPC value structure based on the response received from DB
   for (; res_boundary_iter != res_boundary_row_list.end();
       ++res_boundary_iter) {
-    vector<TableAttrSchema> res_boundary_table_attr_schema =
+    vector<TableAttrSchema> &res_boundary_table_attr_schema =
         (*res_boundary_iter);
     vector<TableAttrSchema> :: iterator vect_boundary_iter =
         res_boundary_table_attr_schema.begin();
@@ -2412,7 +2412,7 @@ void Kt_Controller::FillControllerCommitVerStructure(
 
   // populate IPC value structure based on the response received from DB
   for (; res_ctr_iter != res_ctr_row_list.end(); ++res_ctr_iter) {
-    vector<TableAttrSchema> res_ctr_table_attr_schema = (*res_ctr_iter);
+    vector<TableAttrSchema> &res_ctr_table_attr_schema = (*res_ctr_iter);
     vector<TableAttrSchema> :: iterator vect_ctr_iter =
         res_ctr_table_attr_schema.begin();
     val_ctr_commit_ver_t obj_val_ctr_cv;
@@ -2495,7 +2495,7 @@ void Kt_Controller::FillControllerValueStructure(
   pfc_log_debug("res_ctr_row_list.size: %d", max_rep_ct);
   // populate IPC value structure based on the response received from DB
   for (; res_ctr_iter != res_ctr_row_list.end(); ++res_ctr_iter) {
-    vector<TableAttrSchema> res_ctr_table_attr_schema = (*res_ctr_iter);
+    vector<TableAttrSchema> &res_ctr_table_attr_schema = (*res_ctr_iter);
     vector<TableAttrSchema> :: iterator vect_ctr_iter =
         res_ctr_table_attr_schema.begin();
     val_ctr_st_t obj_val_ctr_st;
@@ -1394,7 +1394,7 @@ UncRespCode Kt_Ctr_Domain::GetOperStatus(OdbcmConnectionHandler *db_conn,
       res_domain_row_list.begin();
   // populate IPC value structure based on the response received from DB
   for (; res_domain_iter!= res_domain_row_list.end(); ++res_domain_iter) {
-    vector<TableAttrSchema> res_ctr_domain_table_attr_schema =
+    vector<TableAttrSchema> &res_ctr_domain_table_attr_schema =
         (*res_domain_iter);
     vector<TableAttrSchema> :: iterator vect_domain_iter =
         res_ctr_domain_table_attr_schema.begin();
@@ -2110,7 +2110,7 @@ void Kt_Ctr_Domain::FillDomainValueStructure(
 
   // populate IPC value structure based on the response received from DB
   for (; res_domain_iter != res_domain_row_list.end(); ++res_domain_iter) {
-    vector<TableAttrSchema> res_ctr_domain_table_attr_schema =
+    vector<TableAttrSchema> &res_ctr_domain_table_attr_schema =
         (*res_domain_iter);
     vector<TableAttrSchema> :: iterator vect_domain_iter =
         res_ctr_domain_table_attr_schema.begin();
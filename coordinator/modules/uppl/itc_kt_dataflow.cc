@@ -715,9 +715,9 @@ reinterpret_cast<val_df_flow_match_dl_addr_t *>((*output_matches_iter).second);
       pfc_flows.push_back(df_segm);
     }
     pfc_log_info("Read %d flows from driver ", total_flow_count);
-    df_util_.pfc_flows.insert(
+    iter = df_util_.pfc_flows.insert(
                     std::pair<key_dataflow_t, vector<DataflowDetail *> >
-                    (*obj_key_dataflow, pfc_flows));
+                    (*obj_key_dataflow, pfc_flows)).first;
     pfc_log_info("Got pfc_flows from driver. flows.size=%" PFC_PFMT_SIZE_T
                "for key %s", pfc_flows.size(),
                DataflowCmn::get_string(*obj_key_dataflow).c_str());
@@ -737,8 +737,22 @@ reinterpret_cast<val_df_flow_match_dl_addr_t *>((*output_matches_iter).second);
     pfc_log_debug("Controller-Domain count Map is not filled:%d", ret_code);
     return ret_code;
   }
+  //  Flows which may match the output matches of the previous flow are
+  //  looked up from the index of the flows, in the order of the flows
+  vector<uint32_t> flow_positions;
+  DataflowMatch prev_matches;
+  DataflowFlowIndex *flow_index = NULL;
+  if (!is_head_node) {
+    prev_matches = DataflowMatch(lastPfcNode->output_matches);
+    flow_index = df_util_.get_flow_index(iter->second);
+    flow_index->Lookup(prev_matches, &flow_positions);
+  } else {
+    for (uint32_t i = 0; i < pfc_flows.size(); i++)
+      flow_positions.push_back(i);
+  }
   //  pfc flows stored in the vector pfc_flows are iterated here
-  for (uint32_t i = 0; i < pfc_flows.size(); i++) {
+  for (uint32_t pos = 0; pos < flow_positions.size(); pos++) {
+    uint32_t i = flow_positions[pos];
     DataflowDetail *df_segm = pfc_flows[i];
     DataflowCmn *df_cmn = NULL;
     if (is_head_node) {
@@ -756,33 +770,28 @@ reinterpret_cast<val_df_flow_match_dl_addr_t *>((*output_matches_iter).second);
         return UNC_UPPL_RC_FAILURE;
       }
     } else {
-      df_cmn = new DataflowCmn(is_head_node, df_segm);
-      bool match_result = df_cmn->check_match_condition
-                                      (lastPfcNode->output_matches);
+      bool match_result = flow_index->Matches(i, prev_matches);
       pfc_log_debug("match_result:%d", match_result);
-      if (match_result) {
-        pfc_log_debug("2nd flow (id=%" PFC_PFMT_u64
-                      ") is matching with 1st flow (id=%" PFC_PFMT_u64  ")",
-                      df_cmn->df_segment->df_common->flow_id,
-                      parentnode->df_segment->df_common->flow_id);
-        df_cmn->apply_action();
-        df_cmn->parent_node = parentnode;
-        UncDataflowReason ret =
-               parentnode->
-                appendFlow(df_cmn, *(df_util_.get_ctrlr_dom_count_map()));
-        if (ret == UNC_DF_RES_EXCEEDS_HOP_LIMIT) {
-          delete df_cmn;
-          df_cmn = NULL;
-        }
-      } else {
+      if (!match_result) {
         pfc_log_debug("2nd flow (id=%" PFC_PFMT_u64
                       ") is not matching with 1st flow (id=%" PFC_PFMT_u64
-                      ") so ignoring", df_cmn->df_segment->df_common->flow_id,
+                      ") so ignoring", df_segm->df_common->flow_id,
                       parentnode->df_segment->df_common->flow_id);
-        if (df_cmn != NULL) {
-          delete df_cmn;
-          df_cmn = NULL;
-        }
+        continue;
+      }
+      df_cmn = new DataflowCmn(is_head_node, df_segm);
+      pfc_log_debug("2nd flow (id=%" PFC_PFMT_u64
+                    ") is matching with 1st flow (id=%" PFC_PFMT_u64  ")",
+                    df_cmn->df_segment->df_common->flow_id,
+                    parentnode->df_segment->df_common->flow_id);
+      df_cmn->apply_action();
+      df_cmn->parent_node = parentnode;
+      UncDataflowReason ret =
+             parentnode->
+              appendFlow(df_cmn, *(df_util_.get_ctrlr_dom_count_map()));
+      if (ret == UNC_DF_RES_EXCEEDS_HOP_LIMIT) {
+        delete df_cmn;
+        df_cmn = NULL;
       }
     }
   }
@@ -1029,7 +1029,7 @@ void Kt_Link::FillLinkValueStructure(
 
   // populate IPC value structure based on the response received from DB
   for (; res_link_iter != res_link_row_list.end(); ++res_link_iter) {
-    vector<TableAttrSchema> res_link_table_attr_schema =
+    vector<TableAttrSchema> &res_link_table_attr_schema =
         (*res_link_iter);
     vector<TableAttrSchema> :: iterator vect_link_iter =
         res_link_table_attr_schema.begin();
@@ -787,7 +787,7 @@ void Kt_LogicalMemberPort::FillLogicalMemberPortValueStructure(
 
   for (; res_logical_member_port_iter != res_logical_member_port_row_list.end();
       ++res_logical_member_port_iter)  {
-    vector<TableAttrSchema> res_logical_member_port_table_attr_schema =
+    vector<TableAttrSchema> &res_logical_member_port_table_attr_schema =
         (*res_logical_member_port_iter);
     vector<TableAttrSchema> :: iterator vect_logical_member_port_iter =
         res_logical_member_port_table_attr_schema.begin();
@@ -1459,7 +1459,7 @@ UncRespCode Kt_LogicalPort::GetOperDownCriteria(
   // populate IPC value structure based on the response received from DB
   for (; res_logicalport_iter!= res_logicalport_row_list.end();
       ++res_logicalport_iter) {
-    vector<TableAttrSchema> res_logicalport_table_attr_schema =
+    vector<TableAttrSchema> &res_logicalport_table_attr_schema =
         (*res_logicalport_iter);
     vector<TableAttrSchema>:: iterator vect_logicalport_iter =
         res_logicalport_table_attr_schema.begin();
@@ -1718,7 +1718,7 @@ UncRespCode Kt_LogicalPort::GetOperStatus(OdbcmConnectionHandler *db_conn,
   // populate IPC value structure based on the response received from DB
   for (; res_logicalport_iter!= res_logicalport_row_list.end();
       ++res_logicalport_iter) {
-    vector<TableAttrSchema> res_logicalport_table_attr_schema =
+    vector<TableAttrSchema> &res_logicalport_table_attr_schema =
         (*res_logicalport_iter);
     vector<TableAttrSchema>:: iterator vect_logicalport_iter =
         res_logicalport_table_attr_schema.begin();
@@ -2225,7 +2225,7 @@ void Kt_LogicalPort::FillLogicalPortValueStructure(
 
   for (; res_logical_port_iter != res_logical_port_row_list.end();
       ++res_logical_port_iter) {
-    vector<TableAttrSchema> res_logical_port_table_attr_schema =
+    vector<TableAttrSchema> &res_logical_port_table_attr_schema =
         (*res_logical_port_iter);
     vector<TableAttrSchema> :: iterator vect_logical_port_iter =
         res_logical_port_table_attr_schema.begin();
@@ -3023,7 +3023,7 @@ void Kt_LogicalPort::GetAllPortId(OdbcmConnectionHandler *db_conn,
   pfc_log_debug("res_logical_port_row_list.size: %d", row_ct);
   for (; res_logical_port_iter != row_list.end();
       ++res_logical_port_iter) {
-    vector<TableAttrSchema> res_logical_port_table_attr_schema =
+    vector<TableAttrSchema> &res_logical_port_table_attr_schema =
         (*res_logical_port_iter);
     vector<TableAttrSchema> :: iterator vect_logical_port_iter =
         res_logical_port_table_attr_schema.begin();
@@ -3204,7 +3204,7 @@ UncRespCode Kt_LogicalPort::GetValidFlag(
       res_logicalport_row_list.begin();
   for (; res_logicalport_iter!= res_logicalport_row_list.end();
       ++res_logicalport_iter) {
-    vector<TableAttrSchema> res_logicalport_table_attr_schema =
+    vector<TableAttrSchema> &res_logicalport_table_attr_schema =
         (*res_logicalport_iter);
     vector<TableAttrSchema>:: iterator vect_logicalport_iter =
         res_logicalport_table_attr_schema.begin();
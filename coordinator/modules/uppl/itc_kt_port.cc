@@ -1229,7 +1229,7 @@ UncRespCode Kt_Port::GetOperStatus(OdbcmConnectionHandler *db_conn,
       res_port_row_list.begin();
   // populate IPC value structure based on the response received from DB
   for (; res_port_iter!= res_port_row_list.end(); ++res_port_iter) {
-    vector<TableAttrSchema> res_port_table_attr_schema = (*res_port_iter);
+    vector<TableAttrSchema> &res_port_table_attr_schema = (*res_port_iter);
     vector<TableAttrSchema>:: iterator vect_port_iter =
         res_port_table_attr_schema.begin();
     for (; vect_port_iter != res_port_table_attr_schema.end();
@@ -1321,7 +1321,7 @@ UncRespCode Kt_Port::GetAlarmStatus(OdbcmConnectionHandler *db_conn,
 
   // populate IPC value structure based on the response received from DB
   for (; res_port_iter!= res_port_row_list.end(); ++res_port_iter) {
-    vector<TableAttrSchema> res_port_table_attr_schema = (*res_port_iter);
+    vector<TableAttrSchema> &res_port_table_attr_schema = (*res_port_iter);
     vector<TableAttrSchema>:: iterator vect_port_iter =
         res_port_table_attr_schema.begin();
     for (; vect_port_iter != res_port_table_attr_schema.end();
@@ -1589,7 +1589,7 @@ void Kt_Port::FillPortValueStructure(
 
   // populate IPC value structure based on the response received from DB
   for (; res_port_iter != res_port_row_list.end(); ++res_port_iter) {
-    vector<TableAttrSchema> res_port_table_attr_schema =
+    vector<TableAttrSchema> &res_port_table_attr_schema =
         (*res_port_iter);
     vector<TableAttrSchema> :: iterator vect_port_iter =
         res_port_table_attr_schema.begin();
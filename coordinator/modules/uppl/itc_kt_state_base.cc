@@ -509,18 +509,22 @@ UncRespCode Kt_State_Base::HandleDriverEvents(
          ((oper_type == UNC_OP_UPDATE ||
            oper_type == UNC_OP_DELETE) &&
            status != UNC_UPPL_RC_ERR_NO_SUCH_INSTANCE)) {
-      PhysicalLayer::ctr_oprn_mutex_.lock();
-      map<string, CtrOprnStatus> :: iterator it;
-      it = PhysicalLayer::ctr_oprn_status_.find(controller_name);
-      if (it != PhysicalLayer::ctr_oprn_status_.end()) {
-        if (it->second.EventsStartReceived == false ||
-                       it->second.IsIPChanged == true) {
-          pfc_log_debug("Alarm ignored,due to EventsStart/IPchanged flag");
-          PhysicalLayer::ctr_oprn_mutex_.unlock();
-          return UNC_UPPL_RC_ERR_OPERATION_NOT_ALLOWED;
+      // The flags are checked before an event batch is started, and
+      // ctr_oprn_mutex_ must not be taken while SQL execution lock is held
+      if (PhysicalLayer::phy_sqlexec_owner_ == PFC_FALSE) {
+        PhysicalLayer::ctr_oprn_mutex_.lock();
+        map<string, CtrOprnStatus> :: iterator it;
+        it = PhysicalLayer::ctr_oprn_status_.find(controller_name);
+        if (it != PhysicalLayer::ctr_oprn_status_.end()) {
+          if (it->second.EventsStartReceived == false ||
+                         it->second.IsIPChanged == true) {
+            pfc_log_debug("Alarm ignored,due to EventsStart/IPchanged flag");
+            PhysicalLayer::ctr_oprn_mutex_.unlock();
+            return UNC_UPPL_RC_ERR_OPERATION_NOT_ALLOWED;
+          }
         }
+        PhysicalLayer::ctr_oprn_mutex_.unlock();
       }
-      PhysicalLayer::ctr_oprn_mutex_.unlock();
       pfc_log_info(
         "HandleDriverEvents validation failed with %d "
         "for operation %d with data type %d", status, oper_type, data_type);
@@ -1106,7 +1106,7 @@ void Kt_Switch::FillSwitchValueStructure(
 
   // populate IPC value structure based on the response received from DB
   for (; res_switch_iter != res_switch_row_list.end(); ++res_switch_iter)  {
-    vector<TableAttrSchema> res_switch_table_attr_schema = (*res_switch_iter);
+    vector<TableAttrSchema> &res_switch_table_attr_schema = (*res_switch_iter);
     vector<TableAttrSchema> :: iterator vect_switch_iter =
         res_switch_table_attr_schema.begin();
 
@@ -1985,7 +1985,7 @@ UncRespCode Kt_Switch::GetOperStatus(OdbcmConnectionHandler *db_conn,
 
   // populate IPC value structure based on the response received from DB
   for (; res_switch_iter!= res_switch_row_list.end(); ++res_switch_iter) {
-    vector<TableAttrSchema> res_switch_table_attr_schema = (*res_switch_iter);
+    vector<TableAttrSchema> &res_switch_table_attr_schema = (*res_switch_iter);
     vector<TableAttrSchema>:: iterator vect_switch_iter =
         res_switch_table_attr_schema.begin();
     for (; vect_switch_iter != res_switch_table_attr_schema.end();
@@ -2165,7 +2165,7 @@ UncRespCode Kt_Switch::GetAlarmStatus(OdbcmConnectionHandler *db_conn,
 
   // populate IPC value structure based on the response received from DB
   for (; res_switch_iter!= res_switch_row_list.end(); ++res_switch_iter) {
-    vector<TableAttrSchema> res_switch_table_attr_schema = (*res_switch_iter);
+    vector<TableAttrSchema> &res_switch_table_attr_schema = (*res_switch_iter);
     vector<TableAttrSchema>:: iterator vect_switch_iter =
         res_switch_table_attr_schema.begin();
     for (; vect_switch_iter != res_switch_table_attr_schema.end();
@@ -519,6 +519,19 @@ ODBCM_RC_STATUS ODBCManager::OpenDBConnection(
     return ODBCM_RC_CONNECTION_ERROR;
   }
 
+  /** Prepared statements are cached only if the driver keeps them
+   *  prepared across commit and rollback */
+  SQLUSMALLINT commit_behavior = SQL_CB_DELETE;
+  SQLUSMALLINT rollback_behavior = SQL_CB_DELETE;
+  SQLGetInfo(conn_handle, SQL_CURSOR_COMMIT_BEHAVIOR, &commit_behavior,
+             sizeof(commit_behavior), NULL);
+  SQLGetInfo(conn_handle, SQL_CURSOR_ROLLBACK_BEHAVIOR, &rollback_behavior,
+             sizeof(rollback_behavior), NULL);
+  conn_obj->set_stmt_cache_enabled(commit_behavior != SQL_CB_DELETE &&
+                                   rollback_behavior != SQL_CB_DELETE);
+  pfc_log_debug("ODBCM::ODBCManager::OpenDBConnection: "
+      "statement cache enabled: %d", conn_obj->is_stmt_cache_enabled());
+
   /**to set the created connection handle into OdbcmConnectionHanlder 
    * object reference*/
   conn_obj->set_conn_handle(conn_handle);
@@ -870,6 +883,7 @@ ODBCM_RC_STATUS ODBCManager::CloseDBConnection(
   /*  to disconnect */
   if (NULL != conn_handle) {
     SQLRETURN odbc_rc = 0;
+    FreeStatementCache(conn_obj);
     ODBCM_ROLLBACK_TRANSACTION(conn_handle);
     odbc_rc = SQLDisconnect(conn_handle);
     odbc_rc = SQLFreeHandle(SQL_HANDLE_DBC, conn_handle);
@@ -897,11 +911,15 @@ ODBCM_RC_STATUS ODBCManager::CloseDBConnection(
  **/
 ODBCM_RC_STATUS ODBCManager::CloseRwConnection() {
   ODBCM_RC_STATUS ret_status = ODBCM_RC_SUCCESS;
+  /** Cached reads may be out of date after the connections are reset,
+    * e.g. on switch over */
+  read_cache_.Invalidate(UNKNOWN_TABLE);
   if (rw_nb_conn_obj_ != NULL) {
     SQLHDBC conn_handle = rw_nb_conn_obj_->get_conn_handle();
     /*  disconnect nb conn handle*/
     if (NULL != conn_handle) {
       SQLRETURN odbc_rc = 0;
+      FreeStatementCache(rw_nb_conn_obj_);
       odbc_rc = SQLDisconnect(conn_handle);
       odbc_rc = SQLFreeHandle(SQL_HANDLE_DBC, conn_handle);
       conn_handle = NULL;
@@ -920,6 +938,7 @@ ODBCM_RC_STATUS ODBCManager::CloseRwConnection() {
     /*  disconnect sb conn handle*/
     if (NULL != conn_handle) {
       SQLRETURN odbc_rc = 0;
+      FreeStatementCache(rw_sb_conn_obj_);
       odbc_rc = SQLDisconnect(conn_handle);
       odbc_rc = SQLFreeHandle(SQL_HANDLE_DBC, conn_handle);
       conn_handle = NULL;
@@ -1005,6 +1024,159 @@ void ODBCManager::ODBCMFreeingMemory(HSTMT stmt,
   return;
 }
 
+/**
+ * @Description : Return the connection object which keeps the prepared
+ *                statements of the given connection. Read write
+ *                connection objects are created for each request and
+ *                share the persistent connection, so its statement cache
+ *                is used.
+ * @param[in]   : conn_obj - connection object used for the operation
+ * @return      : OdbcmConnectionHandler* - NULL if statements of the
+ *                connection are not cached
+ **/
+OdbcmConnectionHandler *ODBCManager::get_stmt_cache_owner_(
+    OdbcmConnectionHandler *conn_obj) {
+  OdbcmConnectionHandler *cache_obj = NULL;
+  if (conn_obj == NULL) {
+    return NULL;
+  }
+  switch (conn_obj->get_conn_type()) {
+    case kOdbcmConnReadWriteNb:
+      cache_obj = rw_nb_conn_obj_;
+      break;
+    case kOdbcmConnReadWriteSb:
+      cache_obj = rw_sb_conn_obj_;
+      break;
+    case kOdbcmConnReadOnly:
+      cache_obj = conn_obj;
+      break;
+    default:
+      break;
+  }
+  if (cache_obj == NULL || cache_obj->is_stmt_cache_enabled() == false ||
+      cache_obj->get_conn_handle() == NULL ||
+      cache_obj->get_conn_handle() != conn_obj->get_conn_handle()) {
+    return NULL;
+  }
+  return cache_obj;
+}
+
+/**
+ * @Description : Get the prepared statement for the query. The statement
+ *                is taken out of the statement cache of the connection,
+ *                so that it is used by one operation at a time. If not
+ *                cached, a new statement is allocated and prepared.
+ * @param[in]   : conn_obj - connection object used for the operation
+ *                query    - SQL query string
+ * @param[out]  : stmt     - prepared statement handler
+ * @return      : ODBCM_RC_SUCCESS is returned when the statement is ready
+ *                otherwise DB related error code will be returned
+ **/
+ODBCM_RC_STATUS ODBCManager::AcquireQueryStatement(
+    OdbcmConnectionHandler *conn_obj, const std::string &query,
+    HSTMT &stmt) {
+  SQLRETURN       odbc_rc = ODBCM_RC_SUCCESS;
+  ODBCM_RC_STATUS status  = ODBCM_RC_SUCCESS;
+  OdbcmConnectionHandler *cache_obj = get_stmt_cache_owner_(conn_obj);
+  stmt = NULL;
+  if (cache_obj != NULL) {
+    PhysicalLayer::stmt_cache_mutex_.lock();
+    std::map<std::string, HSTMT> &stmt_cache = cache_obj->get_stmt_cache();
+    std::map<std::string, HSTMT>::iterator iter = stmt_cache.find(query);
+    if (iter != stmt_cache.end()) {
+      stmt = iter->second;
+      stmt_cache.erase(iter);
+    }
+    PhysicalLayer::stmt_cache_mutex_.unlock();
+    if (stmt != NULL) {
+      return ODBCM_RC_SUCCESS;
+    }
+  }
+  SQLHDBC conn_handle = conn_obj->get_conn_handle();
+  ODBCM_STATEMENT_CREATE(conn_handle, stmt, odbc_rc);
+  if (stmt == NULL) {
+    pfc_log_error("ODBCM::ODBCManager::AcquireQueryStatement: "
+        "Error in allocating statement");
+    return ODBCM_RC_STMT_ERROR;
+  }
+  QueryProcessor query_processor;
+  status = query_processor.PrepareQueryStatement(query, stmt);
+  if (status != ODBCM_RC_SUCCESS) {
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    stmt = NULL;
+  }
+  return status;
+}
+
+/**
+ * @Description : Return the statement got by AcquireQueryStatement().
+ *                The statement is reset and kept in the statement cache
+ *                of the connection if the operation succeeded, otherwise
+ *                it is freed.
+ * @param[in]   : conn_obj - connection object used for the operation
+ *                query    - SQL query string of the statement
+ *                stmt     - statement handler, set to NULL on return
+ *                status   - result of the operation
+ * @return      : void
+ **/
+void ODBCManager::ReleaseQueryStatement(OdbcmConnectionHandler *conn_obj,
+                                        const std::string &query,
+                                        HSTMT &stmt,
+                                        ODBCM_RC_STATUS status) {
+  if (stmt == NULL) {
+    return;
+  }
+  OdbcmConnectionHandler *cache_obj = get_stmt_cache_owner_(conn_obj);
+  bool cached = false;
+  if (cache_obj != NULL &&
+      (status == ODBCM_RC_SUCCESS || status == ODBCM_RC_RECORD_NOT_FOUND)) {
+    /** Close the cursor and drop the bindings to the DBVarbind
+      * structures which are freed after this call */
+    SQLRETURN close_rc = SQLFreeStmt(stmt, SQL_CLOSE);
+    SQLRETURN unbind_rc = SQLFreeStmt(stmt, SQL_UNBIND);
+    SQLRETURN reset_rc = SQLFreeStmt(stmt, SQL_RESET_PARAMS);
+    if (close_rc == ODBCM_RC_SUCCESS && unbind_rc == ODBCM_RC_SUCCESS &&
+        reset_rc == ODBCM_RC_SUCCESS) {
+      PhysicalLayer::stmt_cache_mutex_.lock();
+      std::map<std::string, HSTMT> &stmt_cache = cache_obj->get_stmt_cache();
+      if (stmt_cache.size() < ODBCM_STMT_CACHE_MAX &&
+          stmt_cache.find(query) == stmt_cache.end()) {
+        stmt_cache[query] = stmt;
+        cached = true;
+      }
+      PhysicalLayer::stmt_cache_mutex_.unlock();
+    }
+  }
+  if (cached == false) {
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+  }
+  stmt = NULL;
+}
+
+/**
+ * @Description : Free all prepared statements cached on the connection.
+ *                Called before the connection is disconnected.
+ * @param[in]   : conn_obj - connection object which keeps the cache
+ * @return      : void
+ **/
+void ODBCManager::FreeStatementCache(OdbcmConnectionHandler *conn_obj) {
+  std::map<std::string, HSTMT> stmt_cache;
+  if (conn_obj == NULL) {
+    return;
+  }
+  PhysicalLayer::stmt_cache_mutex_.lock();
+  stmt_cache.swap(conn_obj->get_stmt_cache());
+  PhysicalLayer::stmt_cache_mutex_.unlock();
+  std::map<std::string, HSTMT>::iterator iter = stmt_cache.begin();
+  for (; iter != stmt_cache.end(); ++iter) {
+    SQLFreeHandle(SQL_HANDLE_STMT, iter->second);
+  }
+  if (!stmt_cache.empty()) {
+    pfc_log_debug("ODBCM::ODBCManager::FreeStatementCache: "
+        "%" PFC_PFMT_SIZE_T " statements are freed", stmt_cache.size());
+  }
+}
+
 /**
  * @Description : To get the column name using column id (enum)
  * @param[in]   : col_id - specifies the column id enum value
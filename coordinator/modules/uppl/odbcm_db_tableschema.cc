@@ -13,6 +13,8 @@
  *
  */
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include "odbcm_db_tableschema.hh"
@@ -31,7 +33,9 @@ namespace uppl {
 DBTableSchema::DBTableSchema()
 :
       /** Initialize all the members */
-      db_return_status_(ROW_VALID) {
+      db_return_status_(ROW_VALID),
+      arena_current_(NULL),
+      arena_used_(0) {
       table_name_ = UNKNOWN_TABLE;
       frame_explicit_order_ = "";
 }
@@ -90,8 +94,8 @@ std::list < std::vector <TableAttrSchema> >& DBTableSchema::get_row_list() {
  * @return      : void
  **/
 void DBTableSchema::PushBackToRowList(
-  std::vector <TableAttrSchema>
-  attributes_vector) {
+  const std::vector <TableAttrSchema>
+  &attributes_vector) {
   row_list_.push_back(attributes_vector);
 }
 
@@ -123,8 +127,10 @@ void DBTableSchema::set_primary_keys(
  * @return      : void
  **/
 void DBTableSchema::set_row_list(
-  std::list <std::vector<TableAttrSchema> > row_list) {
-  row_list_ = row_list;
+  const std::list <std::vector<TableAttrSchema> > &row_list) {
+  if (&row_list != &row_list_) {
+    row_list_ = row_list;
+  }
 }
 
 /**
@@ -133,30 +139,24 @@ void DBTableSchema::set_row_list(
 *@return      : void
 **/
 void DBTableSchema::FreeDBTableSchema() {
-  uint32_t                                              row_count = 0;
-  std::vector<TableAttrSchema>                          attr_vector;
   std::vector< TableAttrSchema >::iterator              iter_vector;
   std::list <std::vector<TableAttrSchema> >::iterator   iter_list;
 
   /** Traverse the list to get the attribute vector */
-  for (row_count = 1, iter_list = row_list_.begin();
-      iter_list != row_list_.end(); ++iter_list, row_count++) {
-    attr_vector = *iter_list;
+  for (iter_list = row_list_.begin();
+      iter_list != row_list_.end(); ++iter_list) {
     /** Traverse the vector to get attribute information */
-    for (iter_vector = attr_vector.begin();
-        iter_vector != attr_vector.end(); ++iter_vector) {
+    for (iter_vector = (*iter_list).begin();
+        iter_vector != (*iter_list).end(); ++iter_vector) {
       /** Free the memory inside the vector */
-      if ((*iter_vector).p_table_attribute_value != NULL) {
-        ::operator delete((*iter_vector).p_table_attribute_value);
-        //  free((*iter_vector).p_table_attribute_value);
-        (*iter_vector).p_table_attribute_value = NULL;
-      }
-      /** Clear the vector */
-    }  // for list
-    attr_vector.clear();
-  }  // for vector
+      FreeAttributeValue((*iter_vector).p_table_attribute_value);
+      (*iter_vector).p_table_attribute_value = NULL;
+    }  // for vector
+  }  // for list
   /** Clear the list after the traversal */
   row_list_.clear();
+  /** Values of all the rows are released with the arena */
+  FreeValueArena();
 }
 
 /**
@@ -168,20 +168,113 @@ void DBTableSchema::DeleteRowListFrontElement() {
   std::list <std::vector<TableAttrSchema> >::iterator iter_list =
                                       row_list_.begin();
   std::vector< TableAttrSchema >::iterator iter_vector;
-  std::vector<TableAttrSchema> attr_vector = *iter_list;
   /** Traverse the vector to get attribute information */
-  for (iter_vector = attr_vector.begin();
-      iter_vector != attr_vector.end(); ++iter_vector) {
+  for (iter_vector = (*iter_list).begin();
+      iter_vector != (*iter_list).end(); ++iter_vector) {
     /** Free the memory inside the vector */
-    if ((*iter_vector).p_table_attribute_value != NULL) {
-      ::operator delete((*iter_vector).p_table_attribute_value);
-      (*iter_vector).p_table_attribute_value = NULL;
-    }
+    FreeAttributeValue((*iter_vector).p_table_attribute_value);
+    (*iter_vector).p_table_attribute_value = NULL;
   }
-  attr_vector.clear();
   row_list_.pop_front();
 }
 
+/**
+*@Description : To allocate a column value for the rows in DBTableSchema.
+*               The value is carved out of the current arena block, and
+*               a new block is added when the current one is exhausted.
+*               The size of the value is kept in front of it.
+*               The value is released in FreeDBTableSchema()
+*@param[in]   : size - size of the column value
+*@return      : void* - zero filled column value
+**/
+void* DBTableSchema::AllocateAttributeValue(size_t size) {
+  void *value = NULL;
+  size_t aligned = ODBCM_VALUE_ARENA_ALIGN +
+      ((size + ODBCM_VALUE_ARENA_ALIGN - 1) & ~(ODBCM_VALUE_ARENA_ALIGN - 1));
+  if (aligned > ODBCM_VALUE_ARENA_BLOCK_SIZE) {
+    /** Too large for the arena, freed by FreeAttributeValue */
+    value = ::operator new(size);
+    memset(value, 0, size);
+    return value;
+  }
+  if (arena_current_ == NULL ||
+      arena_used_ + aligned > ODBCM_VALUE_ARENA_BLOCK_SIZE) {
+    arena_current_ =
+        static_cast<uint8_t*>(::operator new(ODBCM_VALUE_ARENA_BLOCK_SIZE));
+    arena_blocks_.insert(std::upper_bound(arena_blocks_.begin(),
+                                          arena_blocks_.end(),
+                                          arena_current_),
+                         arena_current_);
+    arena_used_ = 0;
+  }
+  uint8_t *header = arena_current_ + arena_used_;
+  *reinterpret_cast<size_t*>(header) = size;
+  value = header + ODBCM_VALUE_ARENA_ALIGN;
+  arena_used_ += aligned;
+  memset(value, 0, size);
+  return value;
+}
+
+/**
+*@Description : To get the size of a column value allocated from the arena
+*@param[in]   : value - column value
+*@return      : size_t - size given to AllocateAttributeValue, or 0 if
+*               the value is not in the arena
+**/
+size_t DBTableSchema::GetAttributeValueSize(const void* value) const {
+  if (value == NULL || !IsArenaValue(value)) {
+    return 0;
+  }
+  return *reinterpret_cast<const size_t*>(
+      static_cast<const uint8_t*>(value) - ODBCM_VALUE_ARENA_ALIGN);
+}
+
+/**
+*@Description : To free a column value of the rows in DBTableSchema.
+*               Values in the arena are released with the arena itself
+*@param[in]   : value - column value to be freed
+*@return      : void
+**/
+void DBTableSchema::FreeAttributeValue(void* value) {
+  if (value == NULL || IsArenaValue(value)) {
+    return;
+  }
+  ::operator delete(value);
+}
+
+/**
+*@Description : To check whether the column value is in the arena.
+*               The only block which may contain the value is the last
+*               one starting at or below it
+*@param[in]   : value - column value
+*@return      : true if the value is carved out of the arena
+**/
+bool DBTableSchema::IsArenaValue(const void* value) const {
+  uint8_t *ptr = static_cast<uint8_t*>(const_cast<void*>(value));
+  std::vector <uint8_t*>::const_iterator iter =
+      std::upper_bound(arena_blocks_.begin(), arena_blocks_.end(), ptr);
+  if (iter == arena_blocks_.begin()) {
+    return false;
+  }
+  --iter;
+  return (ptr < *iter + ODBCM_VALUE_ARENA_BLOCK_SIZE);
+}
+
+/**
+*@Description : To release all the blocks of the column value arena
+*@param[in]   : none
+*@return      : void
+**/
+void DBTableSchema::FreeValueArena() {
+  std::vector <uint8_t*>::iterator iter = arena_blocks_.begin();
+  for (; iter != arena_blocks_.end(); ++iter) {
+    ::operator delete(*iter);
+  }
+  arena_blocks_.clear();
+  arena_current_ = NULL;
+  arena_used_ = 0;
+}
+
 /**
  * *@Description : To print the char buffer values in DBTableSchema
  * *@param[in]   : buffer - to print the column attribute values, 
@@ -40,62 +40,22 @@ DBVarbind::DBVarbind()
   p_port_table(NULL),
   p_link_table(NULL),
   p_boundary_table(NULL),
-  p_isrowexists(NULL) {
-  /** SQL Binary buffer length ptr to use in 
+  p_isrowexists(NULL),
+  /** SQL Binary buffer length ptr to use in
     * database binding apis */
-  p_switch_id1_len = new SQLLEN;
-  if (p_switch_id1_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_switch_id1_len");
-  *p_switch_id1_len = 0;
-
-  p_switch_id2_len = new SQLLEN;
-  if (p_switch_id2_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_switch_id2_len");
-  *p_switch_id2_len = 0;
-
-  p_connected_switch_id_len = new SQLLEN;
-  if (p_connected_switch_id_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: "
-                    "p_connected_switch_id_len");
-  *p_connected_switch_id_len = 0;
-
-  p_logicalport_id1_len = new SQLLEN;
-  if (p_logicalport_id1_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_logicalport_id1_len");
-  *p_logicalport_id1_len = 0;
-
-  p_logicalport_id2_len = new SQLLEN;
-  if (p_logicalport_id2_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_logicalport_id2_len");
-  *p_logicalport_id2_len = 0;
-
-  p_ipv6_len = new SQLLEN;
-  if (p_ipv6_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_ipv6_len");
-  *p_ipv6_len = 0;
-
-  p_alarms_status_len = new SQLLEN;
-  if (p_alarms_status_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_alarms_status_len");
-  *p_alarms_status_len = 0;
-
-  p_mac_len = new SQLLEN;
-  if (p_mac_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_mac_len");
-  *p_mac_len = 0;
-
-  p_speed_len = new SQLLEN;
-  if (p_speed_len == NULL )
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_speed_len");
-  *p_speed_len = 0;
-  p_commit_number_len = new SQLLEN;
-  if (p_commit_number_len == NULL)
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_commit_number_len");
-  *p_commit_number_len = 0;
-  p_commit_date_len = new SQLLEN;
-  if (p_commit_date_len == NULL)
-    UPPL_LOG_FATAL("ODBCM::DBVarbind:: Error in new: p_commit_date_len");
-  *p_commit_date_len = 0;
+  p_switch_id1_len(&bind_len_[0]),
+  p_switch_id2_len(&bind_len_[1]),
+  p_logicalport_id1_len(&bind_len_[2]),
+  p_logicalport_id2_len(&bind_len_[3]),
+  p_ipv6_len(&bind_len_[4]),
+  p_alarms_status_len(&bind_len_[5]),
+  p_mac_len(&bind_len_[6]),
+  p_speed_len(&bind_len_[7]),
+  p_commit_number_len(&bind_len_[8]),
+  p_commit_date_len(&bind_len_[9]),
+  p_connected_switch_id_len(&bind_len_[10]),
+  p_value_arena_(NULL) {
+  ODBCM_MEMSET(bind_len_, 0, sizeof(bind_len_));
 }
 
 /**
@@ -104,51 +64,31 @@ DBVarbind::DBVarbind()
  * @return      : None
  **/
 DBVarbind::~DBVarbind() {
-  //  binary buffer length ptr
-  if (NULL != p_switch_id1_len) {
-    delete p_switch_id1_len;
-    p_switch_id1_len = NULL;
-  }
-  if (NULL != p_connected_switch_id_len) {
-    delete p_connected_switch_id_len;
-    p_connected_switch_id_len = NULL;
-  }
-  if (NULL != p_switch_id2_len) {
-    delete p_switch_id2_len;
-    p_switch_id2_len = NULL;
-  }
-  if (NULL != p_logicalport_id1_len) {
-    delete p_logicalport_id1_len;
-    p_logicalport_id1_len = NULL;
-  }
-  if (NULL != p_logicalport_id2_len) {
-    delete p_logicalport_id2_len;
-    p_logicalport_id2_len = NULL;
-  }
-  if (NULL != p_ipv6_len) {
-    delete p_ipv6_len;
-    p_ipv6_len = NULL;
-  }
-  if (NULL != p_alarms_status_len) {
-    delete p_alarms_status_len;
-    p_alarms_status_len = NULL;
-  }
-  if (NULL != p_mac_len) {
-    delete p_mac_len;
-    p_mac_len = NULL;
-  }
-  if (NULL != p_speed_len) {
-    delete p_speed_len;
-    p_speed_len = NULL;
-  }
-  if (NULL != p_commit_number_len) {
-    delete p_commit_number_len;
-    p_commit_number_len = NULL;
-  }
-  if (NULL != p_commit_date_len) {
-    delete p_commit_date_len;
-    p_commit_date_len = NULL;
+}
+
+/**
+ * @Description : To set the DBTableSchema which owns the column values
+ *                allocated in the fetch functions
+ * @param[in]   : db_table_schema - DBTableSchema to fetch rows into,
+ *                NULL to allocate each value with operator new
+ * @return      : void
+ **/
+void DBVarbind::set_value_arena(DBTableSchema *db_table_schema) {
+  p_value_arena_ = db_table_schema;
+}
+
+/**
+ * @Description : To allocate a zero filled column value
+ * @param[in]   : size - size of the ColumnAttrValue
+ * @return      : void* - allocated column value
+ **/
+void* DBVarbind::AllocateColumnAttrValue(size_t size) {
+  if (p_value_arena_ != NULL) {
+    return p_value_arena_->AllocateAttributeValue(size);
   }
+  void *value = ::operator new(size);
+  ODBCM_MEMSET(value, 0, size);
+  return value;
 }
 
 /**
@@ -12,6 +12,7 @@
  * @file    odbcm_mgr.cc
  *
  */
+#include <algorithm>
 #include "odbcm_mgr.hh"
 #include "odbcm_db_tableschema.hh"
 #include "odbcm_utils.hh"
@@ -114,7 +115,6 @@ ODBCM_RC_STATUS ODBCManager::CreateOneRow(unc_keytype_datatype_t db_name,
   PHY_FINI_READ_LOCK();
   /** Initialize all local variables */
   string            insert_query = ""; /* To store the db query */
-  SQLRETURN         odbc_rc           = ODBCM_RC_SUCCESS; /* SQL API rc */
   ODBCM_RC_STATUS   status            = ODBCM_RC_SUCCESS; /* other method rc */
   ODBCMTable        table_id          = UNKNOWN_TABLE;
   std::list < std::vector <TableAttrSchema> >::iterator iter_list;
@@ -132,8 +132,6 @@ ODBCM_RC_STATUS ODBCManager::CreateOneRow(unc_keytype_datatype_t db_name,
   /** Allocate memory for statement, queryfactory, 
     * query processor and db_varbind objects */
   HSTMT             create_stmt       = NULL;
-  SQLHDBC rw_conn_handle = conn_obj->get_conn_handle();
-  ODBCM_STATEMENT_CREATE(rw_conn_handle, create_stmt, odbc_rc);
   QueryFactory      *query_factory    = NULL;
   ODBCM_CREATE_OBJECT(query_factory, QueryFactory);
   QueryProcessor    *query_processor  = NULL;
@@ -225,9 +223,8 @@ ODBCM_RC_STATUS ODBCManager::CreateOneRow(unc_keytype_datatype_t db_name,
                        query_processor);
     return status;
   }
-  /** Prepare the query statement */
-  status = query_processor->PrepareQueryStatement(
-            insert_query, create_stmt);
+  /** Get the prepared query statement */
+  status = AcquireQueryStatement(conn_obj, insert_query, create_stmt);
   if (status != ODBCM_RC_SUCCESS) {
     pfc_log_error("ODBCM::ODBCManager::CreateOneRow:"
         "error in prepare statement   %s",
@@ -256,6 +253,7 @@ ODBCM_RC_STATUS ODBCManager::CreateOneRow(unc_keytype_datatype_t db_name,
           "Error in filling i/p: %s",
           ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
+      ReleaseQueryStatement(conn_obj, insert_query, create_stmt, status);
       ODBCMFreeingMemory(create_stmt, table_id, db_varbind, query_factory,
                          query_processor);
       return status;
@@ -269,25 +267,28 @@ ODBCM_RC_STATUS ODBCManager::CreateOneRow(unc_keytype_datatype_t db_name,
         "Error in binding i/p: %s",
         ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
+      ReleaseQueryStatement(conn_obj, insert_query, create_stmt, status);
       ODBCMFreeingMemory(create_stmt, table_id, db_varbind, query_factory,
                          query_processor);
       return status;
     }
     PHY_SQLEXEC_LOCK();
+    read_cache_.Invalidate(table_id);
     status = query_processor->ExecuteEditDBQuery(
               CREATEONEROW, create_stmt);
     if (status == ODBCM_RC_SUCCESS) {
       /** Commit all active transactions on this connection */
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_COMMIT, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_COMMIT, status);
       pfc_log_debug("ODBCM::ODBCManager::CreateOneRow:row is created");
     } else {
       /** Rollback all active transactions on this connection */
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_ROLLBACK, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_ROLLBACK, status);
       pfc_log_debug("ODBCM::ODBCManager::CreateOneRow:row is not created");
     }
   } else {
     pfc_log_info("ODBCM::ODBCManager::CreateOneRow: No Data Received !");
   }
+  ReleaseQueryStatement(conn_obj, insert_query, create_stmt, status);
   ODBCMFreeingMemory(create_stmt, table_id, db_varbind, query_factory,
                      query_processor);
   return status;
@@ -448,6 +449,7 @@ ODBCM_RC_STATUS ODBCManager::DeleteOneRow(unc_keytype_datatype_t db_name,
       return status;
     }
     PHY_SQLEXEC_LOCK();
+    read_cache_.Invalidate(table_id);
     /** Execute the prepared statement to done the delete one row */
     status = query_processor->ExecuteEditDBQuery(
               DELETEONEROW, delete_stmt);
@@ -455,6 +457,10 @@ ODBCM_RC_STATUS ODBCManager::DeleteOneRow(unc_keytype_datatype_t db_name,
       pfc_log_debug("ODBCM::ODBCManager::DeleteOneRow: "
           "ExecuteEditDBQuery status %s",
           ODBCMUtils::get_RC_Details(status).c_str());
+      if (conn_obj->is_batch_transaction()) {
+        /** Discard the failed statement only */
+        EndEditTransaction(conn_obj, SQL_ROLLBACK);
+      }
       /* Freeing all allocated memory */
       ODBCMFreeingMemory(delete_stmt, table_id, db_varbind, query_factory,
                              query_processor);
@@ -462,11 +468,11 @@ ODBCM_RC_STATUS ODBCManager::DeleteOneRow(unc_keytype_datatype_t db_name,
     }
     if (status == ODBCM_RC_SUCCESS) {
       /** Commit all active transactions on this connection*/
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_COMMIT, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_COMMIT, status);
       pfc_log_debug("ODBCM::ODBCManager::DeleteOneRow:row is deleted");
     } else {
       /** Rollback all active transactions on this connection*/
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_ROLLBACK, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_ROLLBACK, status);
       pfc_log_debug("ODBCM::ODBCManager::DeleteOneRow:row is not deleted");
     }
   } else {
@@ -499,7 +505,6 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
   PHY_FINI_READ_LOCK();
   /** Initialize all local variables */
   string            update_query = "";  // to store the query
-  SQLRETURN         odbc_rc  = ODBCM_RC_SUCCESS;  // SQL API rc
   ODBCM_RC_STATUS   status   = ODBCM_RC_SUCCESS;  // other methods rc
   ODBCMTable        table_id = UNKNOWN_TABLE;
   std::list < std::vector <TableAttrSchema> >::iterator iter;
@@ -516,8 +521,6 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
   }
   /** Allocation for sql stmt */
   HSTMT           update_stmt = NULL;
-  SQLHDBC rw_conn_handle = conn_obj->get_conn_handle();
-  ODBCM_STATEMENT_CREATE(rw_conn_handle, update_stmt, odbc_rc);
   /** Create query_factory, query processor, dbvarbind obj */
   QueryFactory    *query_factory = NULL;
   ODBCM_CREATE_OBJECT(query_factory, QueryFactory);
@@ -583,9 +586,8 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
     * method will be called out */
   db_varbind->SetBinding(table_id, BIND_IN);
   db_varbind->SetValueStruct(table_id, BIND_IN);
-  /** Prepare the sql statment */
-  status = query_processor->PrepareQueryStatement(
-            update_query, update_stmt);
+  /** Get the prepared sql statment */
+  status = AcquireQueryStatement(conn_obj, update_query, update_stmt);
   if (status != ODBCM_RC_SUCCESS) {
     pfc_log_error("ODBCM::ODBCManager::UpdateOneRow: "
         "Error in preparing query statement");
@@ -622,6 +624,7 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
                    "may not be in attributes_vector");
       status = ODBCM_RC_ERROR_IN_FRAMEQUERY;
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, update_query, update_stmt, status);
       ODBCMFreeingMemory(update_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
@@ -629,18 +632,12 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
       pfc_log_debug("ODBCM::ODBCManager::UpdateOneRow: "
         "Vector size with pkeys %" PFC_PFMT_SIZE_T, (*iter).size());
       if ((*iter).size() >= pkey_size) {
-        uint32_t index = 0;
-        for (iter_vector = (*iter).begin();
-            (iter_vector != (*iter).end()) && (index < pkey_size);
-            ++index) {
-          if ((*iter_vector).p_table_attribute_value != NULL) {
-            ::operator delete((*iter_vector).p_table_attribute_value);
-            (*iter_vector).p_table_attribute_value = NULL;
-          }
-          iter_vector = (*iter).erase(iter_vector);
-        }
+        /** Primary keys are bound to the WHERE clause, which follows
+          * the updated columns */
+        std::rotate((*iter).begin(), (*iter).begin() + pkey_size,
+                    (*iter).end());
         pfc_log_debug("ODBCM::ODBCManager::UpdateOneRow: primary keys"
-            " value are removed from attributes_vector to skip from update."
+            " value are moved to the end of attributes_vector."
             " vector size = %" PFC_PFMT_SIZE_T, (*iter).size());
       }
     }
@@ -659,6 +656,7 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
          ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, update_query, update_stmt, status);
       ODBCMFreeingMemory(update_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
@@ -672,25 +670,40 @@ ODBCM_RC_STATUS ODBCManager::UpdateOneRow(unc_keytype_datatype_t db_name,
         ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, update_query, update_stmt, status);
       ODBCMFreeingMemory(update_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
     }
+    /** Removing the primarykey values from vector, since they are
+      * already filled into binded structure */
+    uint32_t pkey_size = db_table_schema.get_primary_keys().size();
+    for (uint32_t index = 0; index < pkey_size && !(*iter).empty();
+         ++index) {
+      if ((*iter).back().p_table_attribute_value != NULL) {
+        db_table_schema.FreeAttributeValue(
+            (*iter).back().p_table_attribute_value);
+        (*iter).back().p_table_attribute_value = NULL;
+      }
+      (*iter).pop_back();
+    }
     PHY_SQLEXEC_LOCK();
+    read_cache_.Invalidate(table_id);
     status = query_processor->ExecuteEditDBQuery(
               UPDATEONEROW, update_stmt);
     if (status == ODBCM_RC_SUCCESS) {
       /** Commit all active transactions on this connection*/
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_COMMIT, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_COMMIT, status);
     } else {
       /** Rollback all active transactions on this connection*/
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_ROLLBACK, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_ROLLBACK, status);
       pfc_log_info("ODBCM::ODBCManager::UpdateOneRow:row is not updated");
     }
   } else {
         pfc_log_debug("ODBCM::ODBCManager::UpdateOneRow: No Data Received !");
   }
   /* Freeing all allocated memory */
+  ReleaseQueryStatement(conn_obj, update_query, update_stmt, status);
   ODBCMFreeingMemory(update_stmt, table_id, db_varbind, query_factory,
                          query_processor);
   return status;
@@ -724,7 +737,6 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
 
   HSTMT read_stmt = NULL;  /* statement for getonerow */
   SQLHDBC ro_conn_handle = conn_obj->get_conn_handle();
-  ODBCM_STATEMENT_CREATE(ro_conn_handle, read_stmt, odbc_rc);
 
   /** DBTableSchema row_list - get from parameter */
   std::list < std::vector <TableAttrSchema> >& rlist =
@@ -747,6 +759,9 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
   ODBCM_CREATE_OBJECT(query_processor, QueryProcessor);
   DBVarbind       *db_varbind       = NULL;
   ODBCM_CREATE_OBJECT(db_varbind, DBVarbind);
+  /** Fetched column values are allocated from the arena of
+   * db_table_schema and released together with its rows */
+  db_varbind->set_value_arena(&db_table_schema);
 
   /** Set the operation for GETONEROW */
   query_factory->SetOperation(GETONEROW);
@@ -763,9 +778,22 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
                            query_processor);
     return status;
   }
-  /* prepare the sql statement using constructed sql string */
-  status = query_processor->PrepareQueryStatement(
-            getone_query, read_stmt);
+  /** Serve the topology read from the read cache */
+  std::string cache_key = "";
+  bool read_cached = IsReadCached(db_table_schema, conn_obj);
+  if (read_cached == true) {
+    cache_key = OdbcmReadCache::BuildKey(getone_query, db_table_schema);
+    if (read_cache_.Lookup(db_table_schema.get_table_name(), cache_key,
+                           db_table_schema, status) == true) {
+      pfc_log_debug("ODBCM::ODBCManager::GetOneRow: "
+                    "served from read cache, status %d", status);
+      ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
+                         query_processor);
+      return status;
+    }
+  }
+  /* get the prepared sql statement for constructed sql string */
+  status = AcquireQueryStatement(conn_obj, getone_query, read_stmt);
   if (status == ODBCM_RC_CONNECTION_ERROR) {
     err_connx_list_.push_back(conn_obj->get_using_session_id());
   }
@@ -788,6 +816,7 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
       db_table_schema.get_table_name());
     status = ODBCM_RC_TABLE_NOT_FOUND;
     /* Freeing all allocated memory */
+    ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
     ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                            query_processor);
     return status;
@@ -811,6 +840,7 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
         ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
       ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
@@ -826,6 +856,7 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
         ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
       ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
@@ -838,6 +869,7 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
         ODBCMUtils::get_RC_Details(status).c_str());
       status = ODBCM_RC_PARAM_BIND_ERROR;
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
       ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
@@ -845,7 +877,7 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
     PHY_SQLEXEC_LOCK();
     /** Execute the ReadDBQuery with the above statement */
     status = query_processor->ExecuteReadDBQuery(GETONEROW, read_stmt);
-    ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+    ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
     if (status == ODBCM_RC_CONNECTION_ERROR) {
       err_connx_list_.push_back(conn_obj->get_using_session_id());
     }
@@ -854,7 +886,11 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
       pfc_log_debug("ODBCM::ODBCManager::GetOneRow: "
           "ExecuteReadDBQuery status %s",
           ODBCMUtils::get_RC_Details(status).c_str());
+      if (read_cached == true) {
+        read_cache_.Store(table_id, cache_key, db_table_schema, status);
+      }
       /* Freeing all allocated memory */
+      ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
       ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                              query_processor);
       return status;
@@ -871,7 +907,8 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
           tmp_iter != (*iter_list).end();
           tmp_iter++) {
         if ((*tmp_iter).p_table_attribute_value)
-          ::operator delete((*tmp_iter).p_table_attribute_value);
+          db_table_schema.FreeAttributeValue(
+              (*tmp_iter).p_table_attribute_value);
       }
       odbc_rc = SQLFetch(read_stmt);
       status = (db_varbind->*db_varbind->FetchOUTPUTValues)((*iter_list));
@@ -880,10 +917,14 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
           ODBCMUtils::get_RC_Details(status).c_str());
         status = ODBCM_RC_ERROR_FETCHING_ROW;
         /* Freeing all allocated memory */
+        ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
         ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                                query_processor);
         return status;
       }
+      if (read_cached == true) {
+        read_cache_.Store(table_id, cache_key, db_table_schema, status);
+      }
     }  // if
   } else {
     pfc_log_error("ODBCM::ODBCManager::GetOneRow:No input data Received!");
@@ -891,6 +932,7 @@ ODBCM_RC_STATUS ODBCManager::GetOneRow(
   db_table_schema.set_row_list(rlist);
   // db_table_schema.PrintDBTableSchema();
   /* Freeing all allocated memory */
+  ReleaseQueryStatement(conn_obj, getone_query, read_stmt, status);
   ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                          query_processor);
   return status;
@@ -1008,15 +1050,16 @@ ODBCM_RC_STATUS ODBCManager::ClearOneRow(unc_keytype_datatype_t db_name,
       return status;
     }
     PHY_SQLEXEC_LOCK();
+    read_cache_.Invalidate(table_id);
     status = query_processor->ExecuteEditDBQuery(
             CLEARONEROW, clearone_stmt);
     if (status == ODBCM_RC_SUCCESS) {
       /** Commit all active transactions on this connection*/
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_COMMIT, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_COMMIT, status);
       pfc_log_debug("ODBCM::ODBCManager::ClearOneRow:row is cleared");
     } else {
       /** Rollback all active transactions on this connection*/
-      ODBCM_END_TRANSACTION(rw_conn_handle, SQL_ROLLBACK, status);
+      ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_ROLLBACK, status);
       pfc_log_info("ODBCM::ODBCManager::ClearOneRow:row is not cleared");
     }
   } else {
@@ -1185,7 +1228,7 @@ ODBCM_RC_STATUS ODBCManager::IsRowExists(
    * string from queryfactory */
   status  = query_processor->ExecuteGroupOperationQuery(ISROWEXISTS,
                                                         rowexists_stmt);
-  ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+  ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
   if (status == ODBCM_RC_CONNECTION_ERROR) {
     err_connx_list_.push_back(conn_obj->get_using_session_id());
   }
@@ -1230,6 +1273,23 @@ ODBCM_RC_STATUS ODBCManager::IsRowExists(
   return status;
 }
 
+/**
+ * @Description : To check whether the read may be served from or stored
+ *                into the topology read cache. Reads done in a batch
+ *                transaction are not cached, since they may see the
+ *                rows which are not committed yet.
+ * @param[in]   : db_table_schema - object holds the input row
+ *                conn_obj - connection of the read
+ * @return      : true if the read is cached
+ **/
+bool ODBCManager::IsReadCached(DBTableSchema &db_table_schema,
+                               OdbcmConnectionHandler *conn_obj) {
+  return (OdbcmReadCache::IsCachedTable(db_table_schema.get_table_name()) &&
+          db_table_schema.get_row_list().size() == 1 &&
+          conn_obj->is_batch_transaction() == false &&
+          PhysicalLayer::phy_sqlexec_owner_ == PFC_FALSE);
+}
+
 /**
  * @Description : This method will fetch the one or more number of 
  *                rows in the db table based upon the given 
@@ -1278,6 +1338,9 @@ ODBCM_RC_STATUS ODBCManager::GetBulkRows(
   ODBCM_CREATE_OBJECT(query_processor, QueryProcessor);
   DBVarbind       *db_varbind       = NULL;
   ODBCM_CREATE_OBJECT(db_varbind, DBVarbind);
+  /** Fetched column values are allocated from the arena of
+   * db_table_schema and released together with its rows */
+  db_varbind->set_value_arena(&db_table_schema);
 
   /** Set the operation for GETBULKROWS */
   query_factory->SetOperation(GETBULKROWS);
@@ -1307,6 +1370,20 @@ ODBCM_RC_STATUS ODBCManager::GetBulkRows(
                            query_processor);
     return status;
   }
+  /** Serve the topology read from the read cache */
+  std::string cache_key = "";
+  bool read_cached = IsReadCached(db_table_schema, conn_obj);
+  if (read_cached == true) {
+    cache_key = OdbcmReadCache::BuildKey(getbulk_query, db_table_schema);
+    if (read_cache_.Lookup(db_table_schema.get_table_name(), cache_key,
+                           db_table_schema, status) == true) {
+      pfc_log_debug("ODBCM::ODBCManager::GetBulkRows: "
+                    "served from read cache, status %d", status);
+      ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
+                         query_processor);
+      return status;
+    }
+  }
   /* prepare sql statment with constructed query string  */
   status = query_processor->PrepareQueryStatement(
             getbulk_query, read_stmt);
@@ -1385,7 +1462,7 @@ ODBCM_RC_STATUS ODBCManager::GetBulkRows(
   PHY_SQLEXEC_LOCK();
   /** Execute the ReadDBQuery with the above statement */
   status = query_processor->ExecuteReadDBQuery(GETBULKROWS, read_stmt);
-  ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+  ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
   if (status == ODBCM_RC_CONNECTION_ERROR) {
     err_connx_list_.push_back(conn_obj->get_using_session_id());
   }
@@ -1394,6 +1471,9 @@ ODBCM_RC_STATUS ODBCManager::GetBulkRows(
     pfc_log_debug("ODBCM::ODBCManager::GetBulkRows: "
                   "ExecuteReadDBQuery status %s",
                   ODBCMUtils::get_RC_Details(status).c_str());
+    if (read_cached == true) {
+      read_cache_.Store(table_id, cache_key, db_table_schema, status);
+    }
     /* Freeing all allocated memory */
     ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
                        query_processor);
@@ -1452,7 +1532,8 @@ ODBCM_RC_STATUS ODBCManager::GetBulkRows(
       tmp_iter != (*it_vect).end();
       tmp_iter++) {
     if ((*tmp_iter).p_table_attribute_value)
-      ::operator delete((*tmp_iter).p_table_attribute_value);
+      db_table_schema.FreeAttributeValue(
+          (*tmp_iter).p_table_attribute_value);
   }
 
   status = (db_varbind->*db_varbind->FetchOUTPUTValues)
@@ -1493,10 +1574,14 @@ ODBCM_RC_STATUS ODBCManager::GetBulkRows(
       rlist.push_back(new_col_attr);
     }
   }
-  db_table_schema.set_row_list(rlist);
   pfc_log_debug("ODBCM::ODBCManager::GetBulkRows:dbtableschema list size: %"
                PFC_PFMT_SIZE_T, db_table_schema.row_list_.size());
   status = ODBCM_RC_SUCCESS;
+  if (read_cached == true) {
+    /** The SQL execution lock is still held, no edit is done since
+      * the rows are read */
+    read_cache_.Store(table_id, cache_key, db_table_schema, status);
+  }
   // db_table_schema.PrintDBTableSchema();
   /* Freeing all allocated memory */
   ODBCMFreeingMemory(read_stmt, table_id, db_varbind, query_factory,
@@ -1635,7 +1720,7 @@ ODBCM_RC_STATUS ODBCManager::GetSiblingCount(
     PHY_SQLEXEC_LOCK();
     status = query_processor->ExecuteReadDBQuery(
               GETSIBLINGCOUNT, stmt);
-    ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+    ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
     if (status != ODBCM_RC_SUCCESS) {
       pfc_log_debug("ODBCM::ODBCManager::GetSiblingCount: "
         "ExecuteReadDBQuery: status %s",
@@ -1736,7 +1821,7 @@ ODBCM_RC_STATUS ODBCManager::GetRowCount(
   /** Execute the query */
   status = query_processor->ExecuteQueryDirect(
             GETROWCOUNT, query, stmt);
-  ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+  ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
   if (status != ODBCM_RC_SUCCESS) {
     pfc_log_debug("ODBCM::ODBCManager::GetRowCount: "
       "ExecuteQueryDirect: status %s",
@@ -1892,7 +1977,7 @@ ODBCM_RC_STATUS ODBCManager::GetModifiedRows(
   PHY_SQLEXEC_LOCK();
   status = query_processor->ExecuteReadDBQuery(
                                                GETMODIFIEDROWS, get_stmt);
-  ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+  ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
   if (status != ODBCM_RC_SUCCESS) {
     if (status != ODBCM_RC_RECORD_NOT_FOUND)
       pfc_log_error("ODBCM::ODBCManager::GetModifiedRows: "
@@ -1956,7 +2041,8 @@ ODBCM_RC_STATUS ODBCManager::GetModifiedRows(
       tmp_iter != (*i_list).end();
       tmp_iter++) {
     if ((*tmp_iter).p_table_attribute_value)
-      ::operator delete((*tmp_iter).p_table_attribute_value);
+      db_table_schema.FreeAttributeValue(
+          (*tmp_iter).p_table_attribute_value);
   }
 
   status = (db_varbind->*db_varbind->FetchOUTPUTValues)
@@ -2144,7 +2230,7 @@ ODBCM_RC_STATUS ODBCManager::GetSiblingCount(
     PHY_SQLEXEC_LOCK();
     status = query_processor->ExecuteReadDBQuery(
               GETSIBLINGCOUNT_FILTER, stmt);
-    ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+    ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
     if (status == ODBCM_RC_CONNECTION_ERROR) {
       err_connx_list_.push_back(conn_obj->get_using_session_id());
     }
@@ -2247,6 +2333,9 @@ ODBCM_RC_STATUS ODBCManager::GetSiblingRows(
 
   DBVarbind *db_varbind = NULL;
   ODBCM_CREATE_OBJECT(db_varbind, DBVarbind);
+  /** Fetched column values are allocated from the arena of
+   * db_table_schema and released together with its rows */
+  db_varbind->set_value_arena(&db_table_schema);
 
   query_factory->SetOperation(GETSIBLINGROWS);
   if (db_name == UNC_DT_STARTUP) {
@@ -2361,7 +2450,7 @@ ODBCM_RC_STATUS ODBCManager::GetSiblingRows(
   /** Execute the ReadDBQuery with the above statement */
   status = query_processor->ExecuteReadDBQuery(
                                                GETSIBLINGROWS, get_stmt);
-  ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+  ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
   if (status == ODBCM_RC_CONNECTION_ERROR) {
     err_connx_list_.push_back(conn_obj->get_using_session_id());
   }
@@ -2428,7 +2517,8 @@ ODBCM_RC_STATUS ODBCManager::GetSiblingRows(
       tmp_iter != (*it_vect).end();
       tmp_iter++) {
     if ((*tmp_iter).p_table_attribute_value)
-      ::operator delete((*tmp_iter).p_table_attribute_value);
+      db_table_schema.FreeAttributeValue(
+          (*tmp_iter).p_table_attribute_value);
   }
   status = (db_varbind->*db_varbind->FetchOUTPUTValues)((*it_vect));
   if (iRow_count > 1) {
@@ -2466,7 +2556,6 @@ ODBCM_RC_STATUS ODBCManager::GetSiblingRows(
     }
   }
 
-  db_table_schema.set_row_list(rlist);
   pfc_log_debug("ODBCM::ODBCManager::GetSiblingRows: "
       "dbtableschema list size:%" PFC_PFMT_SIZE_T,
       db_table_schema.row_list_.size());
@@ -13,6 +13,7 @@
  *
  */
 
+#include <algorithm>
 #include "odbcm_mgr.hh"
 #include "odbcm_query_factory.hh"
 #include "odbcm_query_processor.hh"
@@ -89,6 +90,7 @@ ODBCM_RC_STATUS ODBCManager::ClearDatabase(unc_keytype_datatype_t db_name,
     return status;
   }
   PHY_SQLEXEC_LOCK();
+  read_cache_.Invalidate(UNKNOWN_TABLE);
   status = query_processor->ExecuteTransaction(
               CLEARDATABASE, cleardb_query, clear_stmt);
   if (status == ODBCM_RC_SUCCESS) {
@@ -160,6 +162,7 @@ ODBCM_RC_STATUS ODBCManager::CopyDatabase(
     return status;
   }
   PHY_SQLEXEC_LOCK();
+  read_cache_.Invalidate(UNKNOWN_TABLE);
   status = query_processor->ExecuteTransaction(
     COPYDATABASE, p_copydb_query, copy_stmt);
   if (status == ODBCM_RC_SUCCESS) {
@@ -228,7 +231,7 @@ ODBCM_RC_STATUS ODBCManager::IsCandidateDirty(
   if (status == ODBCM_RC_CONNECTION_ERROR) {
     err_connx_list_.push_back(conn_obj->get_using_session_id());
   }
-  ODBCM_ROLLBACK_TRANSACTION(ro_conn_handle);
+  ODBCM_END_READ_TRANSACTION(conn_obj, ro_conn_handle, status);
   if ((status == ODBCM_RC_STMT_ERROR) ||
       (status == ODBCM_RC_DATA_ERROR)) {
     pfc_log_error("ODBCM::ODBCManager::IsCandidateDirty: "
@@ -293,6 +296,7 @@ ODBCM_RC_STATUS ODBCManager::CommitAllConfiguration(
   ODBCM_CREATE_OBJECT(query_factory, QueryFactory);
   ODBCM_CREATE_OBJECT(query_processor, QueryProcessor);
   PHY_SQLEXEC_LOCK();
+  read_cache_.Invalidate(UNKNOWN_TABLE);
   /** Fptr for queryfactory to construct COMMITALLCONFIG query */
   for (query_type = 0; query_type < COMMIT_END; query_type++) {
     if (query_type != COPY_CANDIDATE_TO_RUNNING) {
@@ -403,14 +407,15 @@ ODBCM_RC_STATUS ODBCManager::ClearOneInstance(
   }
 
   PHY_SQLEXEC_LOCK();
+  read_cache_.Invalidate(UNKNOWN_TABLE);
   status = query_processor->ExecuteTransaction(
       CLEARONEINSTANCE, QUERY, stmt);
   if (status == ODBCM_RC_SUCCESS) {
-    ODBCM_END_TRANSACTION(rw_conn_handle, SQL_COMMIT, status);
+    ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_COMMIT, status);
     pfc_log_info("ODBCM::ODBCManager::ClearOneInstance: "
       "given one instance is cleared");
   } else {
-    ODBCM_END_TRANSACTION(rw_conn_handle, SQL_ROLLBACK, status);
+    ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_ROLLBACK, status);
     pfc_log_info("ODBCM::ODBCManager::ClearOneInstance: "
       "given one instance is not cleared");
   }
@@ -427,4 +432,295 @@ ODBCM_RC_STATUS ODBCManager::ClearOneInstance(
   }
   return status;
 }
+
+/**
+ * @Description : This method creates all rows in the DBTableSchema row list
+ *                with one prepared statement, and commits them as one
+ *                transaction.
+ * @param[in]   : db_name - specifies the configuration
+ *                i.e.running/startup/import/state
+ *                db_table_schema - object holds the rows to be created
+ *                conn_obj - read write connection
+ * @return      : ODBCM_RC_SUCCESS is returned when all rows are created
+ *                ODBCM_RC_* is returned when no row is created
+ **/
+ODBCM_RC_STATUS ODBCManager::CreateRows(unc_keytype_datatype_t db_name,
+                                        DBTableSchema &db_table_schema,
+                                        OdbcmConnectionHandler *conn_obj) {
+  return ExecuteEditRows(CREATEONEROW, db_name, db_table_schema, conn_obj);
+}
+
+/**
+ * @Description : This method updates all rows in the DBTableSchema row list
+ *                with one prepared statement, and commits them as one
+ *                transaction. Primary keys are kept in the row list.
+ * @param[in]   : db_name - specifies the configuration
+ *                i.e.running/startup/import/state
+ *                db_table_schema - object holds the rows to be updated
+ *                conn_obj - read write connection
+ * @return      : ODBCM_RC_SUCCESS is returned when all rows are updated
+ *                ODBCM_RC_* is returned when no row is updated
+ **/
+ODBCM_RC_STATUS ODBCManager::UpdateRows(unc_keytype_datatype_t db_name,
+                                        DBTableSchema &db_table_schema,
+                                        OdbcmConnectionHandler *conn_obj) {
+  return ExecuteEditRows(UPDATEONEROW, db_name, db_table_schema, conn_obj);
+}
+
+/**
+ * @Description : Execute the create or update statement for each row in
+ *                the DBTableSchema row list. The statement is prepared
+ *                once, and the values of each row are filled and bound
+ *                to it before execution.
+ * @param[in]   : operation - CREATEONEROW or UPDATEONEROW
+ *                db_name - specifies the configuration
+ *                db_table_schema - object holds the rows
+ *                conn_obj - read write connection
+ * @return      : ODBCM_RC_SUCCESS is returned when all rows are done
+ *                ODBCM_RC_* is returned when the transaction is rolled back
+ **/
+ODBCM_RC_STATUS ODBCManager::ExecuteEditRows(
+    UpplDbOperationType operation, unc_keytype_datatype_t db_name,
+    DBTableSchema &db_table_schema, OdbcmConnectionHandler *conn_obj) {
+  PHY_FINI_READ_LOCK();
+  string            edit_query = "";
+  ODBCM_RC_STATUS   status     = ODBCM_RC_SUCCESS;
+  ODBCMTable        table_id   = db_table_schema.get_table_name();
+  HSTMT             edit_stmt  = NULL;
+  uint32_t          pkey_size  = 0;
+  uint32_t          row_count  = 0;
+  std::list < std::vector <TableAttrSchema> >& rlist =
+      db_table_schema.get_row_list();
+  std::list < std::vector <TableAttrSchema> >::iterator iter_list;
+
+  /** cs_row_status of candidate rows is handled by CreateOneRow and
+    * UpdateOneRow only */
+  if (db_name == UNC_DT_CANDIDATE || table_id == UNKNOWN_TABLE) {
+    pfc_log_error("ODBCM::ODBCManager::ExecuteEditRows: "
+        "Invalid db %d or table %d", db_name, table_id);
+    return ODBCM_RC_INVALID_DB_OPERATION;
+  }
+  if (rlist.empty()) {
+    pfc_log_info("ODBCM::ODBCManager::ExecuteEditRows: No Data Received !");
+    return ODBCM_RC_SUCCESS;
+  }
+  if (operation == UPDATEONEROW) {
+    pkey_size = db_table_schema.get_primary_keys().size();
+  }
+  /** All rows are executed by one statement, so that they must have
+    * the same columns as the first row */
+  for (iter_list = rlist.begin(); iter_list != rlist.end(); ++iter_list) {
+    bool same_columns = ((*iter_list).size() == rlist.front().size() &&
+                         (*iter_list).size() > pkey_size);
+    for (uint32_t index = 0;
+         same_columns == true && index < (*iter_list).size(); ++index) {
+      same_columns = ((*iter_list)[index].table_attribute_name ==
+                      rlist.front()[index].table_attribute_name);
+    }
+    if (same_columns == false) {
+      pfc_log_error("ODBCM::ODBCManager::ExecuteEditRows: "
+          "Rows have different columns");
+      return ODBCM_RC_ERROR_IN_FRAMEQUERY;
+    }
+  }
+
+  QueryFactory    *query_factory   = NULL;
+  ODBCM_CREATE_OBJECT(query_factory, QueryFactory);
+  QueryProcessor  *query_processor = NULL;
+  ODBCM_CREATE_OBJECT(query_processor, QueryProcessor);
+  DBVarbind       *db_varbind      = NULL;
+  ODBCM_CREATE_OBJECT(db_varbind, DBVarbind);
+
+  /** Frame the query from the first row only */
+  std::list < std::vector <TableAttrSchema> > rest_rows;
+  rest_rows.splice(rest_rows.begin(), rlist, ++rlist.begin(), rlist.end());
+  query_factory->SetOperation(operation);
+  if (operation == CREATEONEROW) {
+    edit_query = (query_factory->*query_factory->GetQuery)
+                 (db_name, db_table_schema);
+  } else {
+    edit_query = (query_factory->*query_factory->GetQueryWithBool)
+                 (db_name, db_table_schema, true);
+  }
+  rlist.splice(rlist.end(), rest_rows);
+  if (edit_query.empty()) {
+    pfc_log_error("ODBCM::ODBCManager::ExecuteEditRows: "
+        "Error in framing query");
+    ODBCMFreeingMemory(edit_stmt, table_id, db_varbind, query_factory,
+                       query_processor);
+    return ODBCM_RC_ERROR_IN_FRAMEQUERY;
+  }
+  db_varbind->SetBinding(table_id, BIND_IN);
+  db_varbind->SetValueStruct(table_id, BIND_IN);
+  status = AcquireQueryStatement(conn_obj, edit_query, edit_stmt);
+  if (status != ODBCM_RC_SUCCESS) {
+    pfc_log_error("ODBCM::ODBCManager::ExecuteEditRows: "
+        "Error in preparing query statement: %s",
+        ODBCMUtils::get_RC_Details(status).c_str());
+    ODBCMFreeingMemory(edit_stmt, table_id, db_varbind, query_factory,
+                       query_processor);
+    return ODBCM_RC_STMT_ERROR;
+  }
+  /** The lock is held for all rows, so that no other operation on the
+    * connection commits a part of them */
+  PHY_SQLEXEC_LOCK();
+  read_cache_.Invalidate(table_id);
+  for (iter_list = rlist.begin();
+       iter_list != rlist.end() && status == ODBCM_RC_SUCCESS;
+       ++iter_list) {
+    std::vector<TableAttrSchema> &row = *iter_list;
+    /** Primary keys are bound to the WHERE clause of update, which
+      * follows the updated columns */
+    std::rotate(row.begin(), row.begin() + pkey_size, row.end());
+    status = (db_varbind->*db_varbind->FillINPUTValues)(row);
+    if (status == ODBCM_RC_SUCCESS) {
+      status = (db_varbind->*db_varbind->BindINParameter)(row, edit_stmt);
+    }
+    std::rotate(row.begin(), row.end() - pkey_size, row.end());
+    if (status != ODBCM_RC_SUCCESS) {
+      pfc_log_error("ODBCM::ODBCManager::ExecuteEditRows: "
+          "Error in binding i/p: %s",
+          ODBCMUtils::get_RC_Details(status).c_str());
+      status = ODBCM_RC_PARAM_BIND_ERROR;
+      break;
+    }
+    status = query_processor->ExecuteEditDBQuery(operation, edit_stmt);
+    row_count++;
+  }
+  if (status == ODBCM_RC_SUCCESS) {
+    ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_COMMIT, status);
+    pfc_log_debug("ODBCM::ODBCManager::ExecuteEditRows: "
+        "%d rows are done", row_count);
+  } else {
+    ODBCM_END_EDIT_TRANSACTION(conn_obj, SQL_ROLLBACK, status);
+    pfc_log_info("ODBCM::ODBCManager::ExecuteEditRows: "
+        "rows are rolled back at row %d", row_count);
+  }
+  ReleaseQueryStatement(conn_obj, edit_query, edit_stmt, status);
+  ODBCMFreeingMemory(edit_stmt, table_id, db_varbind, query_factory,
+                     query_processor);
+  return status;
+}
+
+/**
+ * @Description : To start a batch transaction on the read write connection.
+ *                Edit operations on the connection are not committed until
+ *                EndBatchTransaction is called. The SQL execution lock is
+ *                held by the calling thread until then.
+ * @param[in]   : conn_obj - read write connection
+ * @return      : ODBCM_RC_SUCCESS - if the batch transaction is started
+ *                ODBCM_RC_*       - if the batch transaction is not started
+ **/
+ODBCM_RC_STATUS ODBCManager::BeginBatchTransaction(
+    OdbcmConnectionHandler *conn_obj) {
+  if (conn_obj->get_conn_handle() == NULL ||
+      conn_obj->get_conn_type() != kOdbcmConnReadWriteSb ||
+      conn_obj->is_batch_transaction() == true) {
+    pfc_log_error("ODBCM::ODBCManager::BeginBatchTransaction: "
+        "Invalid connection");
+    return ODBCM_RC_INVALID_DB_OPERATION;
+  }
+  PhysicalLayer::get_phy_sqlexec_lock_()->wrlock();
+  ODBCM_RC_STATUS status = ExecuteBatchStatement(
+      conn_obj->get_conn_handle(), "SAVEPOINT " ODBCM_BATCH_SAVEPOINT);
+  if (status != ODBCM_RC_SUCCESS) {
+    ODBCM_ROLLBACK_TRANSACTION(conn_obj->get_conn_handle());
+    PhysicalLayer::get_phy_sqlexec_lock_()->unlock();
+    return status;
+  }
+  PhysicalLayer::phy_sqlexec_owner_ = PFC_TRUE;
+  conn_obj->set_batch_transaction(true);
+  return ODBCM_RC_SUCCESS;
+}
+
+/**
+ * @Description : To commit or rollback the batch transaction, and release
+ *                the SQL execution lock
+ * @param[in]   : conn_obj - read write connection in batch transaction
+ *                commit   - true to commit, false to rollback
+ * @return      : ODBCM_RC_SUCCESS - if the batch transaction is ended
+ *                ODBCM_RC_*       - if the batch transaction is failed
+ **/
+ODBCM_RC_STATUS ODBCManager::EndBatchTransaction(
+    OdbcmConnectionHandler *conn_obj, bool commit) {
+  ODBCM_RC_STATUS status = ODBCM_RC_SUCCESS;
+  if (conn_obj->is_batch_transaction() == false) {
+    return ODBCM_RC_INVALID_DB_OPERATION;
+  }
+  SQLHDBC rw_conn_handle = conn_obj->get_conn_handle();
+  if (commit == true) {
+    ODBCM_END_TRANSACTION(rw_conn_handle, SQL_COMMIT, status);
+  }
+  if (commit == false || status != ODBCM_RC_SUCCESS) {
+    ODBCM_ROLLBACK_TRANSACTION(rw_conn_handle);
+    pfc_log_info("ODBCM::ODBCManager::EndBatchTransaction: "
+        "batch transaction is rolled back");
+  }
+  conn_obj->set_batch_transaction(false);
+  PhysicalLayer::phy_sqlexec_owner_ = PFC_FALSE;
+  PhysicalLayer::get_phy_sqlexec_lock_()->unlock();
+  return status;
+}
+
+/**
+ * @Description : To commit or rollback the last edit statement. In batch
+ *                transaction, the savepoint is moved forward on commit so
+ *                that the statement is committed at the end of the batch,
+ *                and only the last statement is undone on rollback.
+ * @param[in]   : conn_obj - read write connection
+ *                trans    - SQL_COMMIT or SQL_ROLLBACK
+ * @return      : ODBCM_RC_SUCCESS - if the transaction is ended
+ *                ODBCM_RC_*       - if the transaction is failed
+ **/
+ODBCM_RC_STATUS ODBCManager::EndEditTransaction(
+    OdbcmConnectionHandler *conn_obj, SQLSMALLINT trans) {
+  ODBCM_RC_STATUS status = ODBCM_RC_SUCCESS;
+  SQLHDBC rw_conn_handle = conn_obj->get_conn_handle();
+  if (conn_obj->is_batch_transaction() == false) {
+    ODBCM_END_TRANSACTION(rw_conn_handle, trans, status);
+    return status;
+  }
+  if (trans != SQL_COMMIT) {
+    return ExecuteBatchStatement(rw_conn_handle,
+        "ROLLBACK TO SAVEPOINT " ODBCM_BATCH_SAVEPOINT);
+  }
+  status = ExecuteBatchStatement(rw_conn_handle,
+      "RELEASE SAVEPOINT " ODBCM_BATCH_SAVEPOINT);
+  if (status == ODBCM_RC_SUCCESS) {
+    status = ExecuteBatchStatement(rw_conn_handle,
+        "SAVEPOINT " ODBCM_BATCH_SAVEPOINT);
+  }
+  return status;
+}
+
+/**
+ * @Description : To execute a transaction control statement on the
+ *                connection
+ * @param[in]   : rw_conn_handle - read write connection handle
+ *                query          - statement to be executed
+ * @return      : ODBCM_RC_SUCCESS - if the statement is executed
+ *                ODBCM_RC_*       - if the statement is failed
+ **/
+ODBCM_RC_STATUS ODBCManager::ExecuteBatchStatement(
+    SQLHDBC rw_conn_handle, const char *query) {
+  SQLRETURN odbc_rc = SQL_SUCCESS;
+  HSTMT stmt = NULL;
+  ODBCM_STATEMENT_CREATE(rw_conn_handle, stmt, odbc_rc);
+  if (stmt == NULL) {
+    return ODBCM_RC_TRANSACTION_ERROR;
+  }
+  odbc_rc = SQLExecDirect(stmt,
+      reinterpret_cast<SQLCHAR*>(const_cast<char*>(query)), SQL_NTS);
+  if (odbc_rc != SQL_SUCCESS) {
+    ODBCMUtils::OdbcmHandleInfoPrint(SQL_HANDLE_STMT, stmt, odbc_rc,
+                                     __LINE__, __FILE__);
+  }
+  SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+  if (odbc_rc != SQL_SUCCESS && odbc_rc != SQL_SUCCESS_WITH_INFO) {
+    pfc_log_error("ODBCM::ODBCManager::ExecuteBatchStatement: "
+        "%s is failed", query);
+    return ODBCM_RC_TRANSACTION_ERROR;
+  }
+  return ODBCM_RC_SUCCESS;
+}
 /**EOF*/
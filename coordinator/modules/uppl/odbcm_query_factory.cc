@@ -195,81 +195,33 @@ SQLQUERY QueryFactory::operation_updateonerow(
   }
   /** Get the primary keys. Needed since its not required to SET the pk */
   std::vector <std::string> primarykeys = db_table_schema.get_primary_keys();
-  /** Now, we use the actual values of primary key instead of '?' 
-    while framing update query */
-  /** Framing the WHERE part of the query using primary keys */
+  /** Framing the WHERE part of the query using primary keys. The values
+    are bound as parameters after the updated columns, so that the same
+    statement can be reused for every row with the same column set */
   for (loop1 = 0, iter_list = db_table_schema.row_list_.begin();
         iter_list != db_table_schema.row_list_.end(); iter_list++, loop1++) {
     /** This vector contains all attributes of a row in a table */
     std::vector<TableAttrSchema>attributes_vector = *iter_list;
-    /** Get the column names  and values */
+    /** Get the column names */
     for (loop2 = 0, iter_vector = attributes_vector.begin();
         iter_vector != attributes_vector.end(); iter_vector++, loop2++) {
       for (loop3 = 0, iter_keys = primarykeys.begin();
           iter_keys != primarykeys.end(); iter_keys++, loop3++) {
-        if (((*iter_keys).compare(ODBCManager::get_ODBCManager()->GetColumnName(
-              (*iter_vector).table_attribute_name)) == 0) &&
-            ((*iter_vector).request_attribute_type ==
-                DATATYPE_UINT8_ARRAY_32)) {
-            ColumnAttrValue <uint8_t[ODBCM_SIZE_32]> column_value;
-            column_value = *((ColumnAttrValue <uint8_t[ODBCM_SIZE_32]>*)
-                ((*iter_vector).p_table_attribute_value));
-            uint8_t temp[ODBCM_SIZE_32+1];
-            ODBCM_MEMSET(&temp, '\0', ODBCM_SIZE_32+1);
-            ODBCM_MEMCPY(&temp, &column_value.value, ODBCM_SIZE_32);
-            uint16_t len = strlen((const char*)temp);
-            temp[len+1] = '\0';
-            pfc_log_debug("ODBCM::QueryFactory::UpdateQuery():"
-                " (*iter_vector).length %d value = %s\n",
-                (*iter_vector).table_attribute_length,
-                temp);
-            where_query << (*iter_keys).c_str() << " = '" <<
-                temp << "'";
-        } else if (((*iter_keys).compare(ODBCManager::get_ODBCManager()->
-              GetColumnName((*iter_vector).table_attribute_name)) == 0) &&
-            ((*iter_vector).request_attribute_type ==
-                      DATATYPE_UINT8_ARRAY_320)) {
-            ColumnAttrValue <uint8_t[ODBCM_SIZE_320]> column_value;
-            column_value = *((ColumnAttrValue <uint8_t[ODBCM_SIZE_320]>*)
-                ((*iter_vector).p_table_attribute_value));
-            uint8_t btemp[ODBCM_SIZE_320+1];
-            ODBCM_MEMSET(&btemp, '\0', ODBCM_SIZE_320+1);
-            ODBCM_MEMCPY(&btemp, &column_value.value, ODBCM_SIZE_320);
-            uint16_t len = strlen((const char*)btemp);
-            btemp[len+1] = '\0';
-            pfc_log_debug("ODBCM::QueryFactory::UpdateQuery():"
-                " (*iter_vector).length %d value = %s\n",
-                (*iter_vector).table_attribute_length,
-                btemp);
-            where_query << (*iter_keys).c_str() << " = '" <<
-                btemp << "'";
-        } else if ((
-            (*iter_keys).compare(ODBCManager::get_ODBCManager()->GetColumnName(
-               (*iter_vector).table_attribute_name)) ==0) &&
-            ((*iter_vector).request_attribute_type ==
-                DATATYPE_UINT8_ARRAY_256)) {
-            ColumnAttrValue <uint8_t[ODBCM_SIZE_256]> column_value;
-            column_value = *((ColumnAttrValue <uint8_t[ODBCM_SIZE_256]>*)
-                ((*iter_vector).p_table_attribute_value));
-
-            uint8_t stemp[ODBCM_SIZE_256+1];
-            ODBCM_MEMSET(&stemp, '\0', ODBCM_SIZE_256+1);
-            ODBCM_MEMCPY(&stemp, &column_value.value, ODBCM_SIZE_256);
-            uint16_t len = strlen((const char*)stemp);
-            stemp[len+1] = '\0';
-            pfc_log_debug("ODBCM::QueryFactory::UpdateQuery():"
-                "(*iter_vector).length %d value = %s\n",
-                (*iter_vector).table_attribute_length,
-                column_value.value);
-            where_query << (*iter_keys).c_str() << " = '" <<
-                stemp << "'";
-          }
-
-          if (((*iter_keys).compare(ODBCManager::get_ODBCManager()->\
-                GetColumnName((*iter_vector).table_attribute_name)) == 0)
-              && loop3 != primarykeys.size()-1) {
-            where_query << " AND ";
-          }
+        if ((*iter_keys).compare(ODBCManager::get_ODBCManager()->
+              GetColumnName((*iter_vector).table_attribute_name)) != 0) {
+          continue;
+        }
+        if ((*iter_vector).request_attribute_type ==
+                DATATYPE_UINT8_ARRAY_32 ||
+            (*iter_vector).request_attribute_type ==
+                DATATYPE_UINT8_ARRAY_256 ||
+            (*iter_vector).request_attribute_type ==
+                DATATYPE_UINT8_ARRAY_320) {
+          where_query << (*iter_keys).c_str() << " = ?";
+        }
+        if (loop3 != primarykeys.size()-1) {
+          where_query << " AND ";
+        }
       }  // primary_key loop
     }  // list vector loop
   }  // list loop
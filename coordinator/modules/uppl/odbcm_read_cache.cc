@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2012-2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/**
+ * @brief   ODBC Manager
+ * @file    odbcm_read_cache.cc
+ *
+ */
+
+#include <cstring>
+#include "odbcm_read_cache.hh"
+
+using pfc::core::ScopedMutex;
+
+namespace unc {
+namespace uppl {
+
+/**
+ * @Description : Constructor of OdbcmReadCache
+ * @param[in]   : None
+ * @return      : None
+ **/
+OdbcmReadCache::OdbcmReadCache() {
+}
+
+/**
+ * @Description : Destructor of OdbcmReadCache
+ * @param[in]   : None
+ * @return      : None
+ **/
+OdbcmReadCache::~OdbcmReadCache() {
+  tables_.clear();
+}
+
+/**
+ * @Description : To check whether reads of the table are cached. Only the
+ *                physical topology tables are cached.
+ * @param[in]   : table_id - enum of the tables
+ * @return      : true if reads of the table are cached
+ **/
+bool OdbcmReadCache::IsCachedTable(ODBCMTable table_id) {
+  switch (table_id) {
+    case SWITCH_TABLE:
+    case PORT_TABLE:
+    case LINK_TABLE:
+    case LOGICALPORT_TABLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @Description : To get the number of bytes of an input value used in the
+ *                key. Values fetched from the database carry their size,
+ *                and the values filled by ITC are sized by their type.
+ * @param[in]   : attr - input column attribute
+ *                db_table_schema - schema which holds the value
+ * @return      : size_t - number of bytes of the value
+ **/
+size_t OdbcmReadCache::GetKeyValueSize(const TableAttrSchema &attr,
+                                       DBTableSchema &db_table_schema) {
+  size_t size = db_table_schema.GetAttributeValueSize(
+      attr.p_table_attribute_value);
+  if (size != 0) {
+    return size;
+  }
+  switch (attr.request_attribute_type) {
+    case DATATYPE_UINT16:
+      return sizeof(uint16_t);
+    case DATATYPE_UINT64:
+      return sizeof(uint64_t);
+    case DATATYPE_UINT32:
+    case DATATYPE_IPV4:
+      return sizeof(uint32_t);
+    case DATATYPE_IPV6:
+    case DATATYPE_UINT8_ARRAY_16:
+      return 16 + 1;
+    case DATATYPE_UINT8_ARRAY_1:
+      return 1 + 1;
+    case DATATYPE_UINT8_ARRAY_2:
+      return 2 + 1;
+    case DATATYPE_UINT8_ARRAY_3:
+      return 3 + 1;
+    case DATATYPE_UINT8_ARRAY_6:
+      return 6 + 1;
+    case DATATYPE_UINT8_ARRAY_8:
+      return 8 + 1;
+    case DATATYPE_UINT8_ARRAY_10:
+      return 10 + 1;
+    case DATATYPE_UINT8_ARRAY_11:
+      return 11 + 1;
+    case DATATYPE_UINT8_ARRAY_32:
+      return 32 + 1;
+    case DATATYPE_UINT8_ARRAY_128:
+      return 128 + 1;
+    case DATATYPE_UINT8_ARRAY_256:
+      return 256 + 1;
+    case DATATYPE_UINT8_ARRAY_257:
+      return 257 + 1;
+    case DATATYPE_UINT8_ARRAY_320:
+      return 320 + 1;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @Description : To build the key of a read. The query carries the
+ *                database, table, columns, condition and limit, and the
+ *                first row carries the bound input values.
+ * @param[in]   : query - framed query of the read
+ *                db_table_schema - input of the read
+ * @return      : std::string - key of the read
+ **/
+std::string OdbcmReadCache::BuildKey(const std::string &query,
+                                     DBTableSchema &db_table_schema) {
+  std::string key(query);
+  const std::vector<TableAttrSchema> &row =
+      db_table_schema.get_row_list().front();
+  std::vector<TableAttrSchema>::const_iterator iter = row.begin();
+  for (; iter != row.end(); ++iter) {
+    uint32_t header[2] = {
+      static_cast<uint32_t>((*iter).table_attribute_name),
+      static_cast<uint32_t>((*iter).request_attribute_type) };
+    key.append(reinterpret_cast<const char*>(header), sizeof(header));
+    if ((*iter).p_table_attribute_value == NULL) {
+      key.push_back('\0');
+      continue;
+    }
+    key.push_back('\1');
+    key.append(static_cast<const char*>((*iter).p_table_attribute_value),
+               GetKeyValueSize(*iter, db_table_schema));
+  }
+  return key;
+}
+
+/**
+ * @Description : To fill the cached result of a read into db_table_schema.
+ *                The first row is filled in place, the others are
+ *                appended as GetBulkRows does. Column values are
+ *                allocated from the arena of db_table_schema.
+ * @param[in]   : table_id - enum of the tables
+ *                key - key of the read
+ * @param[out]  : db_table_schema - schema to be filled
+ *                status - status of the cached read
+ * @return      : true if the read is found in the cache
+ **/
+bool OdbcmReadCache::Lookup(ODBCMTable table_id, const std::string &key,
+                            DBTableSchema &db_table_schema,
+                            ODBCM_RC_STATUS &status) {
+  ScopedMutex lock(mutex_);
+  std::map<ODBCMTable, TableCache>::iterator table = tables_.find(table_id);
+  if (table == tables_.end()) {
+    return false;
+  }
+  std::map<std::string, Entry>::iterator entry =
+      table->second.entries.find(key);
+  if (entry == table->second.entries.end()) {
+    return false;
+  }
+  std::list<std::vector<TableAttrSchema> > &rlist =
+      db_table_schema.get_row_list();
+  std::list<std::vector<TableAttrSchema> >::iterator first = rlist.begin();
+  const Entry &cached = entry->second;
+  if (cached.status != ODBCM_RC_SUCCESS) {
+    status = cached.status;
+    return true;
+  }
+  if (first == rlist.end() || (*first).size() != cached.columns) {
+    return false;
+  }
+  size_t index = 0;
+  while (index < cached.values.size()) {
+    std::vector<TableAttrSchema> *row = &(*first);
+    if (index == 0) {
+      /** Input values are replaced by the fetched ones */
+      std::vector<TableAttrSchema>::iterator iter = row->begin();
+      for (; iter != row->end(); ++iter) {
+        db_table_schema.FreeAttributeValue((*iter).p_table_attribute_value);
+        (*iter).p_table_attribute_value = NULL;
+      }
+    } else {
+      rlist.push_back(*first);
+      row = &rlist.back();
+    }
+    for (uint32_t col = 0; col < cached.columns; ++col, ++index) {
+      const std::string &value = cached.values[index];
+      void *cell = db_table_schema.AllocateAttributeValue(value.size());
+      memcpy(cell, value.data(), value.size());
+      (*row)[col].p_table_attribute_value = cell;
+    }
+  }
+  status = ODBCM_RC_SUCCESS;
+  return true;
+}
+
+/**
+ * @Description : To store the result of a read. A successful read is
+ *                stored only if all of its column values are fetched
+ *                into the arena of db_table_schema.
+ * @param[in]   : table_id - enum of the tables
+ *                key - key of the read
+ *                db_table_schema - schema filled by the read
+ *                status - status of the read, ODBCM_RC_SUCCESS or
+ *                ODBCM_RC_RECORD_NOT_FOUND
+ * @return      : void
+ **/
+void OdbcmReadCache::Store(ODBCMTable table_id, const std::string &key,
+                           DBTableSchema &db_table_schema,
+                           ODBCM_RC_STATUS status) {
+  Entry cached;
+  cached.status = status;
+  cached.columns = 0;
+  if (status == ODBCM_RC_SUCCESS) {
+    std::list<std::vector<TableAttrSchema> > &rlist =
+        db_table_schema.get_row_list();
+    std::list<std::vector<TableAttrSchema> >::iterator iter_list;
+    if (rlist.empty()) {
+      return;
+    }
+    cached.columns = rlist.front().size();
+    for (iter_list = rlist.begin(); iter_list != rlist.end(); ++iter_list) {
+      if ((*iter_list).size() != cached.columns) {
+        return;
+      }
+      std::vector<TableAttrSchema>::iterator iter = (*iter_list).begin();
+      for (; iter != (*iter_list).end(); ++iter) {
+        size_t size = db_table_schema.GetAttributeValueSize(
+            (*iter).p_table_attribute_value);
+        if (size == 0) {
+          return;
+        }
+        cached.values.push_back(std::string(
+            static_cast<const char*>((*iter).p_table_attribute_value),
+            size));
+      }
+    }
+  } else if (status != ODBCM_RC_RECORD_NOT_FOUND) {
+    return;
+  }
+
+  ScopedMutex lock(mutex_);
+  TableCache &table = tables_[table_id];
+  std::map<std::string, Entry>::iterator entry = table.entries.find(key);
+  if (entry != table.entries.end()) {
+    entry->second.values.swap(cached.values);
+    entry->second.columns = cached.columns;
+    entry->second.status = cached.status;
+    return;
+  }
+  if (table.order.size() >= ODBCM_READ_CACHE_MAX_ENTRIES) {
+    table.entries.erase(table.order.front());
+    table.order.pop_front();
+  }
+  table.entries[key].values.swap(cached.values);
+  table.entries[key].columns = cached.columns;
+  table.entries[key].status = cached.status;
+  table.order.push_back(key);
+}
+
+/**
+ * @Description : To drop the cached reads of a table. It is called by the
+ *                edit operations while the SQL execution lock is held.
+ * @param[in]   : table_id - enum of the tables, UNKNOWN_TABLE to drop
+ *                the cached reads of all the tables
+ * @return      : void
+ **/
+void OdbcmReadCache::Invalidate(ODBCMTable table_id) {
+  ScopedMutex lock(mutex_);
+  if (table_id == UNKNOWN_TABLE) {
+    tables_.clear();
+  } else {
+    tables_.erase(table_id);
+  }
+}
+
+}  // namespace uppl
+}  // namespace unc
+/**EOF*/
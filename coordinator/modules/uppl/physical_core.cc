@@ -1746,6 +1746,10 @@ UncRespCode PhysicalCore::SendControllerAuditFailureAlarm(
  * * * @return    : UNC_RC_SUCCESS or UNC_UPPL_RC_FAILURE
  * */
 UncRespCode PhysicalCore::RaiseEventHandlingAlarm(string controller_name) {
+  if (PhysicalLayer::phy_event_replay_ == PFC_TRUE) {
+    pfc_log_debug("Alarm is not raised by replayed batch");
+    return UNC_UPPL_RC_FAILURE;
+  }
   if (find(event_handling_controller_alarm_.begin(),
            event_handling_controller_alarm_.end(),
            controller_name) != event_handling_controller_alarm_.end()) {
@@ -1764,6 +1768,10 @@ UncRespCode PhysicalCore::RaiseEventHandlingAlarm(string controller_name) {
  * * * @return    : UNC_RC_SUCCESS or UNC_UPPL_RC_FAILURE
  * */
 UncRespCode PhysicalCore::ClearEventHandlingAlarm(string controller_name) {
+  if (PhysicalLayer::phy_event_replay_ == PFC_TRUE) {
+    pfc_log_debug("Alarm is not cleared by replayed batch");
+    return UNC_UPPL_RC_FAILURE;
+  }
   vector<string>::iterator alarm_raised_iter =
       find(event_handling_controller_alarm_.begin(),
            event_handling_controller_alarm_.end(),
@@ -8,6 +8,7 @@
  */
 
 #include <pfcxx/task_queue.hh>
+#include <algorithm>
 #include "physical_taskq.hh"
 #include "physicallayer.hh"
 #include "physical_common_def.hh"
@@ -23,11 +24,83 @@
 
 using pfc::core::TaskQueue;
 using unc::uppl::PhyEventTaskqUtil;
+using unc::uppl::PhyEventBatchQueue;
 using unc::uppl::NotificationEventParams;
+using unc::uppl::NotificationBatchParams;
 using unc::uppl::NotificationRequest;
 using unc::uppl::EventAlarmDetail;
+using unc::uppl::PhysicalLayer;
 
 ReadWriteLock PhyEventTaskqUtil::taskqmap_mutex_;
+uint64_t PhyEventTaskqUtil::events_received_ = 0;
+uint64_t PhyEventTaskqUtil::events_coalesced_ = 0;
+uint64_t PhyEventTaskqUtil::events_committed_ = 0;
+uint64_t PhyEventTaskqUtil::batches_committed_ = 0;
+uint64_t PhyEventTaskqUtil::batches_replayed_ = 0;
+
+/**
+ *@brief    IsCtrEventsAllowed - return false if the events of the
+ *          controller must be ignored due to EventsStart/IPchanged flag.
+ *@param[in] string controller_name
+ */
+static bool IsCtrEventsAllowed(const string &ctr_name) {
+  bool allowed = true;
+  PhysicalLayer::ctr_oprn_mutex_.lock();
+  map<string, CtrOprnStatus> :: iterator it =
+      PhysicalLayer::ctr_oprn_status_.find(ctr_name);
+  if (it != PhysicalLayer::ctr_oprn_status_.end()) {
+    pfc_log_debug(
+        "Controller %s IsIpChanged %d EvtStRecvd %d",
+        ctr_name.c_str(), it->second.IsIPChanged,
+        it->second.EventsStartReceived);
+    if (it->second.IsIPChanged == true ||
+        it->second.EventsStartReceived == false) {
+      allowed = false;
+    }
+  }
+  PhysicalLayer::ctr_oprn_mutex_.unlock();
+  return allowed;
+}
+
+/**
+ *@brief    IsCoalescableEvent - return true if the event is an update of
+ *          port, switch or link, which can be merged with a later update
+ *          of the same instance.
+ *@param[in] EventAlarmDetail
+ */
+static bool IsCoalescableEvent(const EventAlarmDetail &event_detail) {
+  if (event_detail.alarm_flag != unc::uppl::TQ_EVENT ||
+      event_detail.operation != UNC_OP_UPDATE ||
+      event_detail.key_struct == NULL ||
+      event_detail.new_val_struct == NULL) {
+    return false;
+  }
+  switch (event_detail.key_type) {
+    case UNC_KT_PORT:
+      return (event_detail.val_size == sizeof(val_port_st_t));
+    case UNC_KT_SWITCH:
+      return (event_detail.val_size == sizeof(val_switch_st_t));
+    case UNC_KT_LINK:
+      return (event_detail.val_size == sizeof(val_link_st_t));
+    default:
+      return false;
+  }
+}
+
+/**
+ *@brief    IsValidCovered - return true if every attribute which is valid
+ *          in prev_valid is also valid in next_valid.
+ */
+static bool IsValidCovered(const uint8_t *prev_valid,
+                           const uint8_t *next_valid, size_t count) {
+  for (size_t index = 0; index < count; index++) {
+    if (prev_valid[index] != UNC_VF_INVALID &&
+        next_valid[index] == UNC_VF_INVALID) {
+      return false;
+    }
+  }
+  return true;
+}
 /**
  *@brief    PhyEventTaskqUtil constructor,create a new task queue.
  *@param[in]  concurrency  Number of simultanious tasks.
@@ -77,6 +150,14 @@ void PhyEventTaskqUtil::del_task_queue(string ctr_name) {
     delete phy_event_taskq_;
     taskq_map_.erase(tq_map_iter);
     phy_event_taskq_ = NULL;
+    // Pending events are deleted after the drain task is finished
+    std::map<string, PhyEventBatchQueue*>::iterator bq_map_iter =
+        batchq_map_.find(ctr_name);
+    if (bq_map_iter != batchq_map_.end()) {
+      clear_batch_queue(bq_map_iter->second);
+      delete bq_map_iter->second;
+      batchq_map_.erase(bq_map_iter);
+    }
   } else {
     pfc_log_info("taskq not found for controller %s", ctr_name.c_str());
   }
@@ -98,10 +179,31 @@ void PhyEventTaskqUtil::clear_task_queue(string ctr_name) {
     int ret = phy_event_taskq_->clear(NULL);
     if (ret != 0)
       pfc_log_info("Error in clearing taskq ctr_name = %s", ctr_name.c_str());
+    std::map<string, PhyEventBatchQueue*>::iterator bq_map_iter =
+        batchq_map_.find(ctr_name);
+    if (bq_map_iter != batchq_map_.end()) {
+      clear_batch_queue(bq_map_iter->second);
+    }
   } else {
     pfc_log_debug("taskq not found for controller %s", ctr_name.c_str());
   }
 }
+
+/**
+ *@brief    clear_batch_queue - delete the pending events of a controller
+ *@param[in]  PhyEventBatchQueue
+ */
+void PhyEventTaskqUtil::clear_batch_queue(PhyEventBatchQueue *batchq) {
+  batchq->mutex.lock();
+  std::deque<NotificationEventParams*>::iterator ev_iter =
+      batchq->pending.begin();
+  for (; ev_iter != batchq->pending.end(); ev_iter++) {
+    delete *ev_iter;
+  }
+  batchq->pending.clear();
+  batchq->scheduled = false;
+  batchq->mutex.unlock();
+}
 /**
  *@brief    create_task_queue - return status of creation.
  *          it creates a new task queue.
@@ -125,6 +227,8 @@ UncRespCode PhyEventTaskqUtil::create_task_queue(string ctr_name) {
   } else {
     taskq_map_.insert(std::pair<string, pfc::core::TaskQueue *>
                                         (ctr_name, phy_event_taskq_));
+    batchq_map_.insert(std::pair<string, PhyEventBatchQueue *>
+                                        (ctr_name, new PhyEventBatchQueue()));
     pfc_log_debug("taskqueue is created for controller %s", ctr_name.c_str());
   }
   }
@@ -154,8 +258,10 @@ pfc::core::TaskQueue* PhyEventTaskqUtil::get_task_queue(string ctr_name) {
 }
 
 /**
- *@brief    DispatchNotificationEvent - event processing function shall be
-            dispatched to the task queue for further process as separate task.
+ *@brief    DispatchNotificationEvent - event shall be queued to the
+            controller's pending events. A drain task is dispatched to the
+            task queue if it is not dispatched yet, and it processes the
+            pending events in batches.
  *@param[in] EventDetail - consist the necessary information to process event further. 
              string ctr_name
  */
@@ -163,28 +269,231 @@ int PhyEventTaskqUtil::DispatchNotificationEvent(
                    EventAlarmDetail& event_detail,
                    string ctr_name) {
   int ret = 0;
-  pfc::core::TaskQueue *event_taskq = get_task_queue(ctr_name);
-  if (event_taskq == NULL) {
-    pfc_log_info("TaskQueue is NULL, controller is not available");
-    return -1;
-  }
   pfc_timespec_t msectm;
   pfc_clock_gettime(&msectm);
   event_detail.eventid = pfc_clock_time2msec(&msectm);
   event_detail.controller_name = ctr_name;
-  NotificationEventParams func_obj(event_detail);
-  pfc::core::taskq_func_t  task_func(func_obj);
-  ret = event_taskq->dispatch(task_func);
-  if (ret != 0) {
-    pfc_log_info("failed to dispatch() for invoke event process");
-  } else {
+  // Map lock is held until the event is queued, since the queues are
+  // deleted with the map write lock.
+  ScopedReadWriteLock taskqmaplock(
+        PhyEventTaskqUtil::get_taskqmap_mutex_(), PFC_FALSE);  // read lock
+  std::map<string, pfc::core::TaskQueue*>::iterator tq_map_iter =
+      taskq_map_.find(ctr_name);
+  std::map<string, PhyEventBatchQueue*>::iterator bq_map_iter =
+      batchq_map_.find(ctr_name);
+  if (tq_map_iter == taskq_map_.end() || bq_map_iter == batchq_map_.end()) {
+    pfc_log_info("TaskQueue is NULL, controller is not available");
+    return -1;
+  }
+  pfc::core::TaskQueue *event_taskq = tq_map_iter->second;
+  PhyEventBatchQueue *batchq = bq_map_iter->second;
+  bool dispatch_needed = false;
+  batchq->mutex.lock();
+  batchq->pending.push_back(new NotificationEventParams(event_detail));
+  if (batchq->scheduled == false) {
+    batchq->scheduled = true;
+    dispatch_needed = true;
+  }
+  batchq->mutex.unlock();
+  pfc_atomic_inc_uint64(&events_received_);
+  if (dispatch_needed == true) {
+    NotificationBatchParams func_obj(this, batchq, event_taskq);
+    pfc::core::taskq_func_t  task_func(func_obj);
+    ret = event_taskq->dispatch(task_func);
+    if (ret != 0) {
+      pfc_log_info("failed to dispatch() for invoke event process");
+      clear_batch_queue(batchq);
+      return ret;
+    }
+  }
   pfc_log_info("TASKQ ADD cname:%s kt:%d evid:%" PFC_PFMT_u64,
       event_detail.controller_name.c_str(), event_detail.key_type,
       event_detail.eventid);
-  }
   return ret;
 }
 
+/**
+ *@brief    ProcessEventBatch - drain task of a controller. Up to
+ *          UPPL_EVENT_BATCH_MAX pending events are taken, redundant
+ *          updates are coalesced, and consecutive port, switch, link,
+ *          domain and logical port events are applied in transactions of
+ *          up to UPPL_EVENT_TXN_MAX events. Controller events and alarms
+ *          are processed one by one.
+ *@param[in] PhyEventBatchQueue, TaskQueue of the controller
+ */
+void PhyEventTaskqUtil::ProcessEventBatch(PhyEventBatchQueue *batchq,
+                                          TaskQueue *event_taskq) {
+  std::vector<NotificationEventParams*> events;
+  batchq->mutex.lock();
+  while (!batchq->pending.empty() && events.size() < UPPL_EVENT_BATCH_MAX) {
+    events.push_back(batchq->pending.front());
+    batchq->pending.pop_front();
+  }
+  batchq->mutex.unlock();
+
+  uint32_t ncoalesced = CoalesceEvents(events);
+  size_t begin = 0;
+  while (begin < events.size()) {
+    size_t end = begin + 1;
+    if (events[begin]->IsBatchable() == true) {
+      while (end < events.size() && end - begin < UPPL_EVENT_TXN_MAX &&
+             events[end]->IsBatchable() == true) {
+        end++;
+      }
+      InvokeEventBatch(events, begin, end);
+    } else {
+      events[begin]->InvokeNotificationEventProcess();
+      pfc_atomic_inc_uint64(&events_committed_);
+    }
+    begin = end;
+  }
+  pfc_log_debug("TASKQ BATCH events:%" PFC_PFMT_SIZE_T " coalesced:%u "
+                "received:%" PFC_PFMT_u64 " committed:%" PFC_PFMT_u64,
+                events.size(), ncoalesced, events_received_,
+                events_committed_);
+  std::vector<NotificationEventParams*>::iterator ev_iter = events.begin();
+  for (; ev_iter != events.end(); ev_iter++) {
+    delete *ev_iter;
+  }
+
+  bool pending = false;
+  batchq->mutex.lock();
+  if (batchq->pending.empty()) {
+    batchq->scheduled = false;
+  } else {
+    pending = true;
+  }
+  batchq->mutex.unlock();
+  if (pending == true) {
+    // Continue with the next batch as a new task
+    NotificationBatchParams func_obj(this, batchq, event_taskq);
+    pfc::core::taskq_func_t  task_func(func_obj);
+    if (event_taskq->dispatch(task_func) != 0) {
+      pfc_log_info("failed to dispatch() for invoke event process");
+      clear_batch_queue(batchq);
+    }
+  }
+}
+
+/**
+ *@brief    CoalesceEvents - merge an update of port, switch or link into
+ *          the previous update of the same instance, if no other kind of
+ *          event is received between them and the later value covers the
+ *          valid attributes of the previous one. The previous old value is
+ *          kept and the later new value is applied.
+ *@param[in] events - events in received order
+ *@return    number of merged events
+ */
+uint32_t PhyEventTaskqUtil::CoalesceEvents(
+    std::vector<NotificationEventParams*>& events) {
+  uint32_t ncoalesced = 0;
+  std::vector<NotificationEventParams*> merged;
+  std::map<string, size_t> last_update;
+  uint32_t last_key_type = 0;
+  merged.reserve(events.size());
+  std::vector<NotificationEventParams*>::iterator ev_iter = events.begin();
+  for (; ev_iter != events.end(); ev_iter++) {
+    EventAlarmDetail &event_detail = (*ev_iter)->event_detail_;
+    if (IsCoalescableEvent(event_detail) == false ||
+        event_detail.key_type != last_key_type) {
+      last_update.clear();
+    }
+    if (IsCoalescableEvent(event_detail) == false) {
+      merged.push_back(*ev_iter);
+      continue;
+    }
+    last_key_type = event_detail.key_type;
+    string key(reinterpret_cast<const char*>(event_detail.key_struct),
+               event_detail.key_size);
+    key.append(reinterpret_cast<const char*>(&event_detail.data_type),
+               sizeof(event_detail.data_type));
+    std::map<string, size_t>::iterator key_iter = last_update.find(key);
+    if (key_iter != last_update.end() &&
+        merged[key_iter->second]->CanCoalesce(**ev_iter) == true) {
+      EventAlarmDetail &prev_detail =
+          merged[key_iter->second]->event_detail_;
+      std::swap(prev_detail.new_val_struct, event_detail.new_val_struct);
+      prev_detail.eventid = event_detail.eventid;
+      delete *ev_iter;
+      ncoalesced++;
+      continue;
+    }
+    last_update[key] = merged.size();
+    merged.push_back(*ev_iter);
+  }
+  events.swap(merged);
+  if (ncoalesced != 0) {
+    pfc_atomic_add_uint64(&events_coalesced_, ncoalesced);
+  }
+  return ncoalesced;
+}
+
+/**
+ *@brief    InvokeEventBatch - apply the batchable events in one batch
+ *          transaction on the southbound read write connection. If the
+ *          batch transaction fails to commit, it is rolled back and the
+ *          events are applied again one by one without issuing their
+ *          northbound notifications and event handling alarms again.
+ *@param[in] events, range of the events to be applied
+ */
+void PhyEventTaskqUtil::InvokeEventBatch(
+    std::vector<NotificationEventParams*>& events,
+    size_t begin, size_t end) {
+  PHY_FINI_EVENT_LOCK();
+  UncRespCode db_ret = UNC_RC_SUCCESS;
+  PHY_DB_SB_CXN_LOCK();
+  OPEN_DB_CONNECTION(unc::uppl::kOdbcmConnReadWriteSb, db_ret);
+  if (db_ret != UNC_RC_SUCCESS) {
+    pfc_log_error("Error in opening DB connection");
+    return;
+  }
+  // Controller flags are checked before the SQL execution lock is held
+  // by the batch transaction.
+  string ctr_name = events[begin]->event_detail_.controller_name;
+  if (IsCtrEventsAllowed(ctr_name) == false) {
+    return;
+  }
+  ODBCManager *odbc_mgr = PhysicalLayer::get_instance()->get_odbc_manager();
+  bool batched =
+      (odbc_mgr->BeginBatchTransaction(&db_conn) == ODBCM_RC_SUCCESS);
+  if (batched == false) {
+    pfc_log_info("Batch transaction is not started, events are "
+                 "committed one by one");
+  }
+  for (size_t index = begin; index < end; index++) {
+    EventAlarmDetail &event_detail = events[index]->event_detail_;
+    pfc_log_info("TASKQ PRC cname:%s kt:%d evid:%"
+        PFC_PFMT_u64" almflag:%d op:%d dt:%d at:%d",
+        event_detail.controller_name.c_str(), event_detail.key_type,
+        event_detail.eventid, event_detail.alarm_flag,
+        event_detail.operation, event_detail.data_type,
+        event_detail.alarm_type);
+    events[index]->InvokeProcessEvent(db_conn, !batched);
+  }
+  if (batched == true) {
+    ODBCM_RC_STATUS commit_ret = odbc_mgr->EndBatchTransaction(&db_conn,
+                                                               true);
+    if (commit_ret != ODBCM_RC_SUCCESS) {
+      // The batch is rolled back by EndBatchTransaction, so no event of
+      // the batch is lost if it is applied again without the batch
+      pfc_log_error("Failed to commit batch of %" PFC_PFMT_SIZE_T
+                    " events for controller %s, events are applied"
+                    " one by one", end - begin, ctr_name.c_str());
+      // Notifications and alarms were already issued while the batch
+      // was applied, so they are not issued again by the replay
+      pfc_atomic_inc_uint64(&batches_replayed_);
+      PhysicalLayer::phy_event_replay_ = PFC_TRUE;
+      for (size_t index = begin; index < end; index++) {
+        events[index]->InvokeProcessEvent(db_conn);
+      }
+      PhysicalLayer::phy_event_replay_ = PFC_FALSE;
+    } else {
+      pfc_atomic_inc_uint64(&batches_committed_);
+    }
+  }
+  pfc_atomic_add_uint64(&events_committed_, end - begin);
+}
+
 /**
  *@brief   NotificationEventParams - constructor, it receives
  *         EventAlarmDetail object from its caller
@@ -236,7 +545,7 @@ void NotificationEventParams::InvokeNotificationEventProcess(void) {
  *@param[in] None
  */
 void NotificationEventParams::InvokeProcessEvent(
-    OdbcmConnectionHandler& db_conn) {
+    OdbcmConnectionHandler& db_conn, bool check_ctr_status) {
   UncRespCode status = UNC_RC_SUCCESS;
   NotificationRequest notifyrequest;
   notifyrequest.GetNotificationDT(&db_conn, event_detail_.controller_name,
@@ -250,21 +559,10 @@ void NotificationEventParams::InvokeProcessEvent(
     case UNC_KT_CTR_DOMAIN:
     case UNC_KT_LOGICAL_PORT:
     {
-       PhysicalLayer::ctr_oprn_mutex_.lock();
-       map<string, CtrOprnStatus> :: iterator it =
-            PhysicalLayer::ctr_oprn_status_.find(event_detail_.controller_name);
-       if (it != PhysicalLayer::ctr_oprn_status_.end()) {
-         pfc_log_debug(
-            "Controller %s IsIpChanged %d EvtStRecvd %d",
-             event_detail_.controller_name.c_str(), it->second.IsIPChanged
-             , it->second.EventsStartReceived);
-         if (it->second.IsIPChanged == true ||
-                  it->second.EventsStartReceived == false) {
-           PhysicalLayer::ctr_oprn_mutex_.unlock();
-           return;
-         }
+       if (check_ctr_status == true &&
+           IsCtrEventsAllowed(event_detail_.controller_name) == false) {
+         return;
        }
-       PhysicalLayer::ctr_oprn_mutex_.unlock();
        status = notifyrequest.InvokeKtDriverEvent(&db_conn,
                 event_detail_.operation,
                 event_detail_.data_type,
@@ -386,17 +684,10 @@ void NotificationEventParams::InvokeProcessEvent(
     }
     case UNC_KT_LOGICAL_MEMBER_PORT:
     {
-       PhysicalLayer::ctr_oprn_mutex_.lock();
-       map<string, CtrOprnStatus> :: iterator it =
-            PhysicalLayer::ctr_oprn_status_.find(event_detail_.controller_name);
-       if (it != PhysicalLayer::ctr_oprn_status_.end()) {
-         if (it->second.IsIPChanged == true ||
-                         it->second.EventsStartReceived == false) {
-           PhysicalLayer::ctr_oprn_mutex_.unlock();
-           return;
-         }
+       if (check_ctr_status == true &&
+           IsCtrEventsAllowed(event_detail_.controller_name) == false) {
+         return;
        }
-       PhysicalLayer::ctr_oprn_mutex_.unlock();
       Kt_LogicalMemberPort NotifyLogicalMemberPort;
       status = NotifyLogicalMemberPort.HandleDriverEvents(
                &db_conn, event_detail_.key_struct,
@@ -413,6 +704,89 @@ void NotificationEventParams::InvokeProcessEvent(
   pfc_log_debug("Return from InvokeProcessEvent: %d", status);
 }
 
+/**
+ *@brief  IsBatchable - return true if the event can be applied in a
+ *        batch transaction. Controller events release the southbound
+ *        connection lock while processing, so they are not batched.
+ *@param[in] None
+ */
+bool NotificationEventParams::IsBatchable(void) {
+  if (event_detail_.alarm_flag != TQ_EVENT) {
+    return false;
+  }
+  switch (event_detail_.key_type) {
+    case UNC_KT_PORT:
+    case UNC_KT_PORT_NEIGHBOR:
+    case UNC_KT_SWITCH:
+    case UNC_KT_LINK:
+    case UNC_KT_CTR_DOMAIN:
+    case UNC_KT_LOGICAL_PORT:
+    case UNC_KT_LOGICAL_MEMBER_PORT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ *@brief  CanCoalesce - return true if the next update of the same
+ *        instance can be merged into this update.
+ *@param[in] next - later event
+ */
+bool NotificationEventParams::CanCoalesce(
+    const NotificationEventParams& next) {
+  const EventAlarmDetail &next_detail = next.event_detail_;
+  if (IsCoalescableEvent(event_detail_) == false ||
+      IsCoalescableEvent(next_detail) == false ||
+      event_detail_.key_type != next_detail.key_type ||
+      event_detail_.data_type != next_detail.data_type ||
+      event_detail_.key_size != next_detail.key_size ||
+      memcmp(event_detail_.key_struct, next_detail.key_struct,
+             event_detail_.key_size) != 0) {
+    return false;
+  }
+  switch (event_detail_.key_type) {
+    case UNC_KT_PORT:
+    {
+      const val_port_st_t *prev_val = reinterpret_cast<const val_port_st_t*>
+          (event_detail_.new_val_struct);
+      const val_port_st_t *next_val = reinterpret_cast<const val_port_st_t*>
+          (next_detail.new_val_struct);
+      return (IsValidCovered(prev_val->port.valid, next_val->port.valid,
+                             sizeof(prev_val->port.valid)) &&
+              IsValidCovered(prev_val->valid, next_val->valid,
+                             sizeof(prev_val->valid)));
+    }
+    case UNC_KT_SWITCH:
+    {
+      const val_switch_st_t *prev_val =
+          reinterpret_cast<const val_switch_st_t*>
+          (event_detail_.new_val_struct);
+      const val_switch_st_t *next_val =
+          reinterpret_cast<const val_switch_st_t*>
+          (next_detail.new_val_struct);
+      return (IsValidCovered(prev_val->switch_val.valid,
+                             next_val->switch_val.valid,
+                             sizeof(prev_val->switch_val.valid)) &&
+              IsValidCovered(prev_val->valid, next_val->valid,
+                             sizeof(prev_val->valid)));
+    }
+    case UNC_KT_LINK:
+    {
+      const val_link_st_t *prev_val = reinterpret_cast<const val_link_st_t*>
+          (event_detail_.new_val_struct);
+      const val_link_st_t *next_val = reinterpret_cast<const val_link_st_t*>
+          (next_detail.new_val_struct);
+      return (IsValidCovered(prev_val->link.valid, next_val->link.valid,
+                             sizeof(prev_val->link.valid)) &&
+              IsValidCovered(prev_val->valid, next_val->valid,
+                             sizeof(prev_val->valid)));
+    }
+    default:
+      return false;
+  }
+}
+
 /**
  *@brief  InvokeProcessAlarm - processing alarms
  *@param[in] None
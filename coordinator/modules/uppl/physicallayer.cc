@@ -50,6 +50,7 @@ Mutex PhysicalLayer::phyitc_mutex_;
 
 // Static variable for mutex obj use in ODBC connection pool access
 Mutex PhysicalLayer::db_conpool_mutex_;
+Mutex PhysicalLayer::stmt_cache_mutex_;
 
 // Static variable for mutex obj use to protect the ctr_oprn_status_ map object
 Mutex PhysicalLayer::ctr_oprn_mutex_;
@@ -64,6 +65,8 @@ ReadWriteLock PhysicalLayer::phy_dbsbcxn_lock_;
 ReadWriteLock PhysicalLayer::events_done_lock_;
 ReadWriteLock PhysicalLayer::timer_lock_;
 ReadWriteLock PhysicalLayer::phy_sqlexec_lock_;
+__thread pfc_bool_t PhysicalLayer::phy_sqlexec_owner_ = PFC_FALSE;
+__thread pfc_bool_t PhysicalLayer::phy_event_replay_ = PFC_FALSE;
 uint8_t PhysicalLayer::phyFiniFlag = 0;
 bool PhysicalLayer::is_fatal_done = false;
 std::map<string, CtrOprnStatus> PhysicalLayer::ctr_oprn_status_;
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+#ifndef _KEY_INDEX_HH_
+#define _KEY_INDEX_HH_
+
+#include <pfc/base.h>
+#include <pfc/debug.h>
+#include <string>
+#include <vector>
+
+namespace unc {
+namespace vtndrvcache {
+
+class ConfigNode;
+
+/* Initial number of slots of a KeyIndex, must be a power of 2 */
+const uint32_t KEY_INDEX_MIN_CAPACITY = 16;
+
+/* A KeyIndex grows when more than LOAD_NUM / LOAD_DEN of its slots are used */
+const uint32_t KEY_INDEX_LOAD_NUM = 3;
+const uint32_t KEY_INDEX_LOAD_DEN = 4;
+
+/**
+ * @brief : Search index of the nodes of one key type. The search keys are
+ *          interned in the index together with their hash, so a lookup is
+ *          one hash of the probe key and a linear probe which compares the
+ *          stored hashes before any string; it does not allocate. Erased
+ *          slots are refilled by shifting the following entries back, so
+ *          the index never accumulates tombstones.
+ */
+class KeyIndex {
+ public:
+  /**
+   * @brief : Constructor, no slots are allocated until the first insert
+   */
+  KeyIndex();
+
+  /**
+   * @brief      : Computes the hash of a search key (32-bit FNV-1a)
+   * @param [in] : key
+   * @retval     : uint32_t
+   */
+  static uint32_t hash_key(const std::string &key);
+
+  /**
+   * @brief      : Searches the node of the key
+   * @param [in] : key, hash(hash_key() of key)
+   * @retval     : ConfigNode* / NULL if not present
+   */
+  ConfigNode* find(const std::string &key, uint32_t hash) const;
+
+  ConfigNode* find(const std::string &key) const {
+    return find(key, hash_key(key));
+  }
+
+  /**
+   * @brief      : Inserts the node for the key, an existing entry is kept
+   * @param [in] : key, hash(hash_key() of key), node
+   * @retval     : PFC_TRUE if inserted / PFC_FALSE if the key is present
+   */
+  pfc_bool_t insert(const std::string &key, uint32_t hash, ConfigNode *node);
+
+  pfc_bool_t insert(const std::string &key, ConfigNode *node) {
+    return insert(key, hash_key(key), node);
+  }
+
+  /**
+   * @brief      : Removes the entry of the key
+   * @param [in] : key
+   * @retval     : PFC_TRUE if removed / PFC_FALSE if not present
+   */
+  pfc_bool_t erase(const std::string &key);
+
+  /**
+   * @brief      : Makes room for count entries without growing again
+   * @param [in] : count
+   */
+  void reserve(uint32_t count);
+
+  /**
+   * @brief : Removes all the entries and releases the slots
+   */
+  void clear();
+
+  /**
+   * @brief  : Returns the number of entries
+   * @retval : uint32_t
+   */
+  uint32_t size() const {
+    return count_;
+  }
+
+  /**
+   * @brief  : Returns the number of slots
+   * @retval : uint32_t
+   */
+  uint32_t capacity() const {
+    return static_cast<uint32_t>(slots_.size());
+  }
+
+ private:
+  struct Slot {
+    Slot(): hash(0), node(NULL) {}
+    uint32_t hash;
+    ConfigNode *node;  /* NULL for a free slot */
+    std::string key;
+  };
+
+  /**
+   * @brief      : Returns the slot of the key, or the free slot ending
+   *               its probe sequence
+   */
+  uint32_t probe(const std::string &key, uint32_t hash) const;
+
+  /**
+   * @brief      : Moves all the entries into new_capacity slots
+   */
+  void rehash(uint32_t new_capacity);
+
+  std::vector<Slot> slots_;
+  uint32_t count_;
+};
+}  // end of namespace vtndrvcache
+}  // end of namespace unc
+#endif
@@ -14,6 +14,7 @@
 #include <map>
 #include <string>
 #include "confignode.hh"
+#include "key_index.hh"
 #include "vtn_conf_data_element_op.hh"
 
 namespace unc {
@@ -28,9 +29,9 @@ struct key_tree {
 /* forward declaration for CommonIterator class */
 class CommonIterator;
 
-/* ConfigNodeHash map storing entry of each node constructing in tree */
+/* ConfigNodeHash index storing entry of each node constructing in tree */
 
-typedef std::map<std::string, ConfigNode* > ConfigNodeHash;
+typedef KeyIndex ConfigNodeHash;
 
 class KeyTree {
  public:
@@ -141,7 +142,7 @@ class KeyTree {
     return cfgnode_count_;
   }
 
-  /* Initialization of ConfigNodeHash map */
+  /* Search index of the nodes, one per key type */
 
   ConfigNodeHash ConfigHashArr[CACHEMGR_CONFIGARR_SIZE];
 
@@ -198,13 +199,23 @@ class KeyTree {
    */
   UncRespCode add_node_to_tree(ConfigNode* child_ptr);
 
+  /**
+   * @brief      : Method to add individual Config node to the cache when its
+   *               search key is already generated
+   * @param [in] : child_ptr, key(search key of child_ptr), key_hash
+   * @retval     : UncRespCode(UNC_RC_SUCCESS/
+   *               UNC_DRV_RC_ERR_GENERIC)
+   */
+  UncRespCode add_node_to_tree(ConfigNode* child_ptr, const std::string &key,
+                               uint32_t key_hash);
+
   /**
    * @brief      : Method to search and retrieve the node from the search map
    * @param [in] : key
    * @param [in] : key_type
    * @retval     : ConfigNode*
    */
-  ConfigNode* get_node_from_hash(std::string key,
+  ConfigNode* get_node_from_hash(const std::string &key,
     unc_key_type_t key_type);
   /**
    * @brief      : Method to insert node to the search map
@@ -213,6 +224,22 @@ class KeyTree {
    */
   UncRespCode add_child_to_hash(ConfigNode* child_ptr);
 
+  /**
+   * @brief      : Method to insert node to the search map under the given
+   *               search key
+   * @param [in] : child_ptr, key, key_hash
+   * @retval     : UncRespCode(UNC_RC_SUCCESS)
+   */
+  UncRespCode add_child_to_hash(ConfigNode* child_ptr, const std::string &key,
+                                uint32_t key_hash);
+
+  /**
+   * @brief      : Method to size the search maps for the nodes of a list
+   *               before they are added one by one
+   * @param [in] : value_list
+   */
+  void reserve_hash(const std::vector<ConfigNode*>&value_list);
+
 
   /**
    * @brief : Method to clear the elements of commit/audit cache
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include "key_index.hh"
+
+namespace unc {
+namespace vtndrvcache {
+
+static const uint32_t FNV_OFFSET_BASIS = 2166136261U;
+static const uint32_t FNV_PRIME = 16777619U;
+
+/**
+ * @brief : KeyIndex constructor
+ */
+KeyIndex::KeyIndex(): count_(0) {
+}
+
+/**
+ * @brief      : Computes the hash of a search key
+ * @param [in] : key
+ * @retval     : uint32_t
+ */
+uint32_t KeyIndex::hash_key(const std::string &key) {
+  uint32_t hash = FNV_OFFSET_BASIS;
+  const char *ptr = key.data();
+  const char *end = ptr + key.size();
+  for (; ptr != end; ++ptr) {
+    hash ^= static_cast<uint8_t>(*ptr);
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+/**
+ * @brief      : Returns the slot holding the key, or the free slot where the
+ *               probe for it ends. The caller ensures slots_ is not empty.
+ */
+uint32_t KeyIndex::probe(const std::string &key, uint32_t hash) const {
+  uint32_t mask = capacity() - 1;
+  uint32_t index = hash & mask;
+  while (slots_[index].node != NULL) {
+    if ((slots_[index].hash == hash) && (slots_[index].key == key)) {
+      break;
+    }
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+
+/**
+ * @brief      : Searches the node of the key
+ * @param [in] : key, hash
+ * @retval     : ConfigNode* / NULL
+ */
+ConfigNode* KeyIndex::find(const std::string &key, uint32_t hash) const {
+  if (count_ == 0) {
+    return NULL;
+  }
+  return slots_[probe(key, hash)].node;
+}
+
+/**
+ * @brief      : Inserts the node for the key
+ * @param [in] : key, hash, node
+ * @retval     : PFC_TRUE / PFC_FALSE if the key is present
+ */
+pfc_bool_t KeyIndex::insert(const std::string &key, uint32_t hash,
+                            ConfigNode *node) {
+  PFC_ASSERT(node != NULL);
+  if (((count_ + 1) * KEY_INDEX_LOAD_DEN) > (capacity() * KEY_INDEX_LOAD_NUM)) {
+    rehash(slots_.empty() ? KEY_INDEX_MIN_CAPACITY : capacity() * 2);
+  }
+  Slot &slot = slots_[probe(key, hash)];
+  if (slot.node != NULL) {
+    return PFC_FALSE;
+  }
+  slot.hash = hash;
+  slot.node = node;
+  slot.key = key;
+  count_++;
+  return PFC_TRUE;
+}
+
+/**
+ * @brief      : Removes the entry of the key. The entries following it in the
+ *               same run are shifted back unless they would move before
+ *               their home slot, which keeps every probe sequence unbroken.
+ * @param [in] : key
+ * @retval     : PFC_TRUE / PFC_FALSE if not present
+ */
+pfc_bool_t KeyIndex::erase(const std::string &key) {
+  if (count_ == 0) {
+    return PFC_FALSE;
+  }
+  uint32_t mask = capacity() - 1;
+  uint32_t hole = probe(key, hash_key(key));
+  if (slots_[hole].node == NULL) {
+    return PFC_FALSE;
+  }
+  uint32_t next = hole;
+  for (;;) {
+    next = (next + 1) & mask;
+    if (slots_[next].node == NULL) {
+      break;
+    }
+    uint32_t home = slots_[next].hash & mask;
+    // The entry may fill the hole only if its home is not in (hole, next]
+    pfc_bool_t stays = (hole <= next) ? ((hole < home) && (home <= next))
+                                      : ((hole < home) || (home <= next));
+    if (stays) {
+      continue;
+    }
+    slots_[hole].hash = slots_[next].hash;
+    slots_[hole].node = slots_[next].node;
+    slots_[hole].key.swap(slots_[next].key);
+    hole = next;
+  }
+  slots_[hole].node = NULL;
+  slots_[hole].key.clear();
+  count_--;
+  return PFC_TRUE;
+}
+
+/**
+ * @brief      : Makes room for count entries
+ * @param [in] : count
+ */
+void KeyIndex::reserve(uint32_t count) {
+  uint32_t new_capacity = slots_.empty() ? KEY_INDEX_MIN_CAPACITY : capacity();
+  while ((count * KEY_INDEX_LOAD_DEN) > (new_capacity * KEY_INDEX_LOAD_NUM)) {
+    new_capacity *= 2;
+  }
+  if (new_capacity != capacity()) {
+    rehash(new_capacity);
+  }
+}
+
+/**
+ * @brief : Removes all the entries
+ */
+void KeyIndex::clear() {
+  std::vector<Slot>().swap(slots_);
+  count_ = 0;
+}
+
+/**
+ * @brief      : Moves all the entries into new_capacity slots. The interned
+ *               key strings are swapped, not copied.
+ * @param [in] : new_capacity(power of 2)
+ */
+void KeyIndex::rehash(uint32_t new_capacity) {
+  std::vector<Slot> old_slots(new_capacity);
+  old_slots.swap(slots_);
+  uint32_t mask = new_capacity - 1;
+  std::vector<Slot>::iterator itr = old_slots.begin();
+  for (; itr != old_slots.end(); ++itr) {
+    if (itr->node == NULL) {
+      continue;
+    }
+    uint32_t index = itr->hash & mask;
+    while (slots_[index].node != NULL) {
+      index = (index + 1) & mask;
+    }
+    slots_[index].hash = itr->hash;
+    slots_[index].node = itr->node;
+    slots_[index].key.swap(itr->key);
+  }
+}
+}  // end of namespace vtndrvcache
+}  // end of namespace unc
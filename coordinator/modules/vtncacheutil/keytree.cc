@@ -36,8 +36,7 @@ CommonIterator* KeyTree::create_iterator() {
  */
 KeyTree::KeyTree():cfgnode_count_(0) {
   ODC_FUNC_TRACE;
-  ConfigHashArr[0].insert(std::pair <std::string, ConfigNode*>
-                          ("ROOT", &node_tree_));
+  ConfigHashArr[0].insert("ROOT", &node_tree_);
 }
 
 /**
@@ -162,6 +161,7 @@ UncRespCode KeyTree::append_physical_attribute_configuration_list(
   ODC_FUNC_TRACE;
   UncRespCode err = UNC_DRV_RC_ERR_GENERIC;
   ConfigNode*  tmp_cfgnode_ptr = NULL;
+  reserve_hash(value_list);
   std::vector<ConfigNode*>::const_iterator it = value_list.begin();
   std::vector<ConfigNode*>::const_iterator itr_end = value_list.end();
   // Iterate the vector of config nodes
@@ -353,6 +353,7 @@ UncRespCode KeyTree::append_audit_configuration_list(
   UncRespCode err = UNC_DRV_RC_ERR_GENERIC;
 
   ConfigNode*  tmp_cfgnode_ptr = NULL;
+  reserve_hash(value_list);
   std::vector<ConfigNode*>::const_iterator it = value_list.begin();
   std::vector<ConfigNode*>::const_iterator itr_end = value_list.end();
 
@@ -395,14 +396,14 @@ UncRespCode KeyTree::append_audit_node(
 
   tmp_cfgnode_ptr = value_node;
   unc_key_type_t key_Type = tmp_cfgnode_ptr->get_type_name();
+  // The search key is generated and hashed once for the lookup and the insert
   std::string key = tmp_cfgnode_ptr->get_key_generate();
-  real_cfgnode_ptr = get_node_from_hash(key, key_Type);
+  uint32_t key_hash = KeyIndex::hash_key(key);
+  real_cfgnode_ptr = ConfigHashArr[key_Type].find(key, key_hash);
   if (NULL == real_cfgnode_ptr) {
     pfc_log_debug("%s: Node Not Present in Tree..for:%s keytype %d",
                  PFC_FUNCNAME, key.c_str(), key_Type);
-    pfc_log_debug("%s: Parent Type Check %s ", PFC_FUNCNAME,
-                 tmp_cfgnode_ptr->get_parent_key_name().c_str());
-    err = add_node_to_tree(tmp_cfgnode_ptr);
+    err = add_node_to_tree(tmp_cfgnode_ptr, key, key_hash);
     if (UNC_RC_SUCCESS != err) {
       pfc_log_error("%s: AddChildToTree faild err=%d", PFC_FUNCNAME, err);
       tmp_cfgnode_ptr = NULL;
@@ -429,6 +430,20 @@ UncRespCode KeyTree::add_node_to_tree(ConfigNode* child_ptr) {
     pfc_log_error("add_node_to_tree:Child Node is NULL!!!!!!");
     return UNC_DRV_RC_ERR_GENERIC;
   }
+  std::string key = child_ptr->get_key_generate();
+  return add_node_to_tree(child_ptr, key, KeyIndex::hash_key(key));
+}
+
+/**
+ * @brief       : Method to add node to the cache and search map under the
+ *                already generated search key
+ * @param [in]  : child_ptr, key, key_hash
+ * @retval      : UNC_RC_SUCCESSS/UNC_DRV_RC_ERR_GENERIC
+ */
+UncRespCode KeyTree::add_node_to_tree(ConfigNode* child_ptr,
+                                      const std::string &key,
+                                      uint32_t key_hash) {
+  ODC_FUNC_TRACE;
   std::string  parent_key = child_ptr->get_parent_key_name();
   unc_key_type_t parent_type = get_parenttype(child_ptr->get_type_name());
 
@@ -436,22 +451,22 @@ UncRespCode KeyTree::add_node_to_tree(ConfigNode* child_ptr) {
   ConfigNode* parent_ptr = get_node_from_hash(parent_key, parent_type);
   if (NULL == parent_ptr) {
     pfc_log_error("Parent:%s  Not Present for:%s", parent_key.c_str(),
-                 child_ptr->get_key_generate().c_str());
+                 key.c_str());
     return UNC_DRV_RC_ERR_GENERIC;
   }
   // Add the new node to child list of the parentnode using parent_ptr
   UncRespCode err = parent_ptr->add_child_to_list(child_ptr);
   if ( UNC_RC_SUCCESS != err ) {
     pfc_log_error("add_node_to_tree:add_child_to_list Faild for:%s!!!!",
-                 child_ptr->get_key_generate().c_str());
+                 key.c_str());
     return UNC_DRV_RC_ERR_GENERIC;
   }
   // Add the new node to the search map
-  err = add_child_to_hash(child_ptr);
+  err = add_child_to_hash(child_ptr, key, key_hash);
 
   if ( UNC_RC_SUCCESS == err ) {
     pfc_log_debug("add_node_to_tree:add_child_to_hash Succed for: %s!!!!",
-                 child_ptr->get_key_generate().c_str());
+                 key.c_str());
     cfgnode_count_++;
   }
   return UNC_RC_SUCCESS;
@@ -464,16 +479,15 @@ UncRespCode KeyTree::add_node_to_tree(ConfigNode* child_ptr) {
  * @retval     : ConfigNode*
  */
 ConfigNode* KeyTree::get_node_from_hash(
-    std::string key, unc_key_type_t key_type) {
+    const std::string &key, unc_key_type_t key_type) {
   ODC_FUNC_TRACE;
-  ConfigNodeHash::iterator itr;
-  itr = ConfigHashArr[key_type].find(key);
-  if ( itr == ConfigHashArr[key_type].end() ) {
+  ConfigNode* node_ptr = ConfigHashArr[key_type].find(key);
+  if (NULL == node_ptr) {
     pfc_log_debug("Node Not Present for:%s", key.c_str());
     return NULL;
   }
   pfc_log_debug("Node Present for:%s", key.c_str());
-  return itr->second;
+  return node_ptr;
 }
 
 /**
@@ -483,12 +497,50 @@ ConfigNode* KeyTree::get_node_from_hash(
  */
 UncRespCode KeyTree::add_child_to_hash(ConfigNode* child_ptr) {
   ODC_FUNC_TRACE;
-  unc_key_type_t key_type = child_ptr->get_type_name();
   std::string key = child_ptr->get_key_generate();
-  ConfigHashArr[key_type].insert(std::pair <std::string,
-                                 ConfigNode*>(key, child_ptr));
+  return add_child_to_hash(child_ptr, key, KeyIndex::hash_key(key));
+}
+
+/**
+ * @brief       : Method to insert node to the search map under the given key
+ * @param [in]  : child_ptr, key, key_hash
+ * @retval      : UNC_RC_SUCCESSS
+ */
+UncRespCode KeyTree::add_child_to_hash(ConfigNode* child_ptr,
+                                       const std::string &key,
+                                       uint32_t key_hash) {
+  ODC_FUNC_TRACE;
+  unc_key_type_t key_type = child_ptr->get_type_name();
+  ConfigHashArr[key_type].insert(key, key_hash, child_ptr);
   return UNC_RC_SUCCESS;
 }
 
+/**
+ * @brief       : Method to size the search maps for the nodes of a list, so
+ *                that a full audit or reconnect does not rehash them
+ *                repeatedly while growing
+ * @param [in]  : value_list
+ */
+void KeyTree::reserve_hash(const std::vector<ConfigNode*>&value_list) {
+  ODC_FUNC_TRACE;
+  std::vector<uint32_t> type_count(CACHEMGR_CONFIGARR_SIZE, 0);
+  std::vector<ConfigNode*>::const_iterator it = value_list.begin();
+  for (; it != value_list.end(); ++it) {
+    if (*it == NULL) {
+      continue;
+    }
+    uint32_t key_type = (*it)->get_type_name();
+    if (key_type < CACHEMGR_CONFIGARR_SIZE) {
+      type_count[key_type]++;
+    }
+  }
+  for (uint32_t key_type = 0; key_type < CACHEMGR_CONFIGARR_SIZE; key_type++) {
+    if (type_count[key_type] != 0) {
+      ConfigHashArr[key_type].reserve(ConfigHashArr[key_type].size() +
+                                      type_count[key_type]);
+    }
+  }
+}
+
 }  // namespace vtndrvcache
 }  // namespace unc
@@ -130,6 +130,15 @@ class driver {
 
   virtual pfc_bool_t  get_physical_port_details(unc::driver::controller*) = 0;
 
+  /**
+   * @brief    - Method to retrive the number of config nodes of a commit
+   *             which may be sent to the controller at the same time
+   * @retval   - uint32_t - commit concurrency, 1 sends the nodes one by one
+   */
+  virtual uint32_t get_commit_concurrency() {
+    return 1;
+  }
+
   /**
    * @brief    - Virtual destructort
    */
@@ -89,6 +89,7 @@ class VtnDrvIntf :public pfc::core::Module {
   //  structure to store configuration file parsed values
   typedef struct {
     uint32_t time_interval;
+    uint32_t commit_controller_concurrency;
   }conf_info;
 
   /**
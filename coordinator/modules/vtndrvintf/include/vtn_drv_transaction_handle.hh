@@ -14,9 +14,11 @@
 #include <tclib_module.hh>
 #include <kt_handler.hh>
 #include <controller_utils.hh>
+#include <pfcxx/synch.hh>
 #include <list>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace unc {
 namespace driver {
@@ -27,9 +29,11 @@ class DriverTxnInterface : public unc::tclib::TcLibInterface {
   typedef std::map <unc_key_type_t, KtHandler*> kt_handler_map;
   /**
    * @brief  - DriverTxnInterface constructor
+   * @param[in] - number of controllers voted or committed at the same time
    */
   DriverTxnInterface(ControllerFramework *,
-                     kt_handler_map &);
+                     kt_handler_map &,
+                     uint32_t ctr_concurrency = 1);
   /**
    * @brief  - DriverTxnInterface destructor
    */
@@ -437,8 +441,132 @@ class DriverTxnInterface : public unc::tclib::TcLibInterface {
                                             driver* drv);
 
  private:
+  /*
+   * Config node of the controller cache which failed to be sent
+   */
+  typedef struct {
+    pfc_bool_t failed;
+    uint32_t retc;
+    unc_key_type_t keytype;
+    KtHandler* hnd_ptr;
+    unc::vtndrvcache::ConfigNode* cfgnode;
+  } CommitFailure_t;
+
+  /*
+   * Vote or global commit of a controller. A controller which is not sent
+   * anything carries the response code written for it to Tclib.
+   */
+  typedef struct {
+    std::string ctr_name;
+    controller_operation* util_obj;
+    pfc_bool_t send;
+    pfc_bool_t two_phase;
+    uint32_t write_code;
+    unc::tclib::TcCommonRet ret_code;
+    CommitFailure_t failure;
+  } ControllerTxn_t;
+
+  /*
+   * Number of controllers being sent by RunControllerTxns
+   */
+  typedef struct {
+    pfc::core::Mutex mutex;
+    pfc::core::Condition cond;
+    uint32_t in_flight;
+  } ControllerTxnState_t;
+
+  /**
+   * @brief       - Method to send the controller cache
+   * @param[in]   - controller name
+   * @param[in]   - controller*
+   * @param[in]   - driver*
+   * @param[out]  - config node which failed to be sent
+   * @retval      - TcCommonRet enum value
+   */
+  unc::tclib::TcCommonRet SendCommitCache(std::string ctr_name,
+                                          controller* ctr,
+                                          driver* drv,
+                                          CommitFailure_t *failure);
+
+  /**
+   * @brief       - Method to write the config node which failed to be sent
+   *                to Tclib
+   * @param[in]   - controller name
+   * @param[in]   - config node which failed to be sent
+   * @retval      - None
+   */
+  void WriteCommitFailure(std::string ctr_name,
+                          const CommitFailure_t &failure);
+
+  /**
+   * @brief       - Method to check the controllers of a vote or global
+   *                commit in list order, up to a controller which does not
+   *                exist
+   * @param[in]   - config id
+   * @param[in]   - Tc controllers list
+   * @param[in]   - PFC_TRUE for vote, PFC_FALSE for global commit
+   * @param[out]  - controllers to be sent
+   * @retval      - None
+   */
+  void PrepareControllerTxns(uint32_t config_id,
+                             unc::tclib::TcControllerList &controllers,
+                             pfc_bool_t vote,
+                             std::vector<ControllerTxn_t> *txns);
+
+  /**
+   * @brief       - Method to send the vote or global commit to up to
+   *                ctr_concurrency_ controllers with two phase commit
+   *                support at the same time, and to the other controllers
+   *                one by one
+   * @param[in]   - controllers to be sent
+   * @param[in]   - PFC_TRUE for vote, PFC_FALSE for global commit
+   * @retval      - None
+   */
+  void RunControllerTxns(std::vector<ControllerTxn_t> &txns, pfc_bool_t vote);
+  void RunControllerTxn(ControllerTxn_t *txn, pfc_bool_t vote);
+  void RunControllerTxnTask(ControllerTxn_t *txn, pfc_bool_t vote,
+                            ControllerTxnState_t *state);
+
+  /**
+   * @brief       - Method to release the controllers of a vote or global
+   *                commit
+   * @param[in]   - controllers
+   * @retval      - None
+   */
+  void ReleaseControllerTxns(std::vector<ControllerTxn_t> &txns);
+
+  /**
+   * @brief       - Method to send the controller cache with more than one
+   *                config node in flight, keeping the order of the nodes
+   *                which depend on each other
+   * @param[in]   - controller name
+   * @param[in]   - controller*
+   * @param[in]   - driver*
+   * @param[in]   - number of config nodes sent at the same time
+   * @param[out]  - TcCommonRet enum value
+   * @param[out]  - config node which failed to be sent
+   * @retval      - PFC_FALSE if the task queue could not be created
+   */
+  pfc_bool_t HandleCommitCacheParallel(std::string ctr_name,
+                                       controller* ctr,
+                                       driver* drv,
+                                       uint32_t concurrency,
+                                       unc::tclib::TcCommonRet *ret_code,
+                                       CommitFailure_t *failure);
+
+  /**
+   * @brief       - Checks if two config nodes must be sent in commit order
+   * @param[in]   - keytype and key of both nodes
+   * @retval      - PFC_TRUE if the nodes depend on each other
+   */
+  static pfc_bool_t IsCommitOrderNeeded(unc_key_type_t keytype1,
+                                        const std::string &key1,
+                                        unc_key_type_t keytype2,
+                                        const std::string &key2);
+
   ControllerFramework* crtl_inst_;
   kt_handler_map kt_handler_map_;
+  uint32_t ctr_concurrency_;
 };
 }  // namespace driver
 }  // namespace unc
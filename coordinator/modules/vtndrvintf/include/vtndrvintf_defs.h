@@ -24,6 +24,8 @@ namespace driver {
 //    collecting physical data from controller
 const std::string timeinterval_conf_blk = "vtn_driver_paramaters";
 const uint32_t default_time_interval = 70;
+// Number of controllers voted or committed at the same time
+const uint32_t default_commit_controller_concurrency = 8;
 const std::string DEFAULT_DOMAIN_ID = "(DEFAULT)";
 
 typedef enum {
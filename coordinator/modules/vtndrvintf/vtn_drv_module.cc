@@ -94,8 +94,8 @@ pfc_bool_t VtnDrvIntf::init(void) {
     return PFC_FALSE;
   }
 
-  tclib_obj->TcLibRegisterHandler(new DriverTxnInterface(ctrl_inst_,
-                                                          map_kt_));
+  tclib_obj->TcLibRegisterHandler(new DriverTxnInterface(
+      ctrl_inst_, map_kt_, conf_parser_.commit_controller_concurrency));
 
   return PFC_TRUE;
 }
@@ -363,10 +363,15 @@ void VtnDrvIntf::read_conf_file() {
     conf_parser_.time_interval =
            drv_block.getUint32("physical_attributes_read_interval",
                                         default_time_interval);
+    conf_parser_.commit_controller_concurrency =
+           drv_block.getUint32("commit_controller_concurrency",
+                               default_commit_controller_concurrency);
     pfc_log_debug("%s: Block Handle is Valid, Time interval %d", PFC_FUNCNAME,
                   conf_parser_.time_interval);
   } else {
     conf_parser_.time_interval = default_time_interval;
+    conf_parser_.commit_controller_concurrency =
+        default_commit_controller_concurrency;
     pfc_log_debug("%s: Block Handle is Invalid, set default Value %d",
                   PFC_FUNCNAME, conf_parser_.time_interval);
   }
@@ -9,6 +9,9 @@
 
 #include <vtn_drv_transaction_handle.hh>
 #include <vtn_drv_module.hh>
+#include <pfcxx/synch.hh>
+#include <pfcxx/task_queue.hh>
+#include <boost/bind.hpp>
 #include <list>
 #include <vector>
 #include <memory>
@@ -16,12 +19,105 @@
 namespace unc {
 namespace driver {
 
+/*
+ * State of a commit shared between HandleCommitCacheParallel and the
+ * tasks sending the config nodes to the controller.
+ */
+typedef struct {
+  pfc::core::Mutex mutex;
+  pfc::core::Condition cond;
+  uint32_t in_flight;
+  pfc_bool_t failed;
+  std::vector<UncRespCode> result;
+  std::vector<pfc_bool_t> done;
+} CommitState_t;
+
+/*
+ * Task which sends one config node to the controller
+ */
+class CommitNodeTask {
+ public:
+  CommitNodeTask(CommitState_t *state, uint32_t index, KtHandler *hnd_ptr,
+                 unc::vtndrvcache::ConfigNode *cfgnode, controller *ctr,
+                 driver *drv)
+      : state_(state), index_(index), hnd_ptr_(hnd_ptr), cfgnode_(cfgnode),
+        ctr_(ctr), drv_(drv) {}
+
+  void operator()() {
+    UncRespCode retc = hnd_ptr_->execute_cmd(cfgnode_, ctr_, drv_);
+    pfc::core::ScopedMutex m(state_->mutex);
+    state_->result[index_] = retc;
+    state_->done[index_] = PFC_TRUE;
+    if (retc != UNC_RC_SUCCESS) {
+      state_->failed = PFC_TRUE;
+    }
+    state_->in_flight--;
+    state_->cond.broadcast();
+  }
+
+ private:
+  CommitState_t *state_;
+  uint32_t index_;
+  KtHandler *hnd_ptr_;
+  unc::vtndrvcache::ConfigNode *cfgnode_;
+  controller *ctr_;
+  driver *drv_;
+};
+
+/**
+ * @brief       - Checks if the keytype belongs to the VTN tree, where the
+ *                key of a node starts with the key of its parent
+ * @param[in]   - keytype
+ * @retval      - PFC_TRUE/PFC_FALSE
+ */
+static pfc_bool_t is_vtn_tree_keytype(unc_key_type_t keytype) {
+  switch (keytype) {
+    case UNC_KT_VTN:
+    case UNC_KT_VBRIDGE:
+    case UNC_KT_VBR_IF:
+    case UNC_KT_VBR_VLANMAP:
+    case UNC_KT_VTN_FLOWFILTER:
+    case UNC_KT_VTN_FLOWFILTER_ENTRY:
+    case UNC_KT_VBR_FLOWFILTER:
+    case UNC_KT_VBR_FLOWFILTER_ENTRY:
+    case UNC_KT_VBRIF_FLOWFILTER:
+    case UNC_KT_VBRIF_FLOWFILTER_ENTRY:
+    case UNC_KT_VTERMINAL:
+    case UNC_KT_VTERM_IF:
+    case UNC_KT_VTERMIF_FLOWFILTER:
+    case UNC_KT_VTERMIF_FLOWFILTER_ENTRY:
+      return PFC_TRUE;
+    default:
+      return PFC_FALSE;
+  }
+}
+
+/**
+ * @brief       - Checks if the keytype is a flowfilter entry, which may
+ *                redirect to an interface of another vbridge or vterminal
+ * @param[in]   - keytype
+ * @retval      - PFC_TRUE/PFC_FALSE
+ */
+static pfc_bool_t is_flowfilter_entry_keytype(unc_key_type_t keytype) {
+  switch (keytype) {
+    case UNC_KT_VTN_FLOWFILTER_ENTRY:
+    case UNC_KT_VBR_FLOWFILTER_ENTRY:
+    case UNC_KT_VBRIF_FLOWFILTER_ENTRY:
+    case UNC_KT_VTERMIF_FLOWFILTER_ENTRY:
+      return PFC_TRUE;
+    default:
+      return PFC_FALSE;
+  }
+}
+
 /**
 * @brief : constructor
 */
 DriverTxnInterface::DriverTxnInterface(ControllerFramework* ctrl_frame,
-                            kt_handler_map &map_kt)
-    : crtl_inst_(ctrl_frame), kt_handler_map_(map_kt) {}
+                            kt_handler_map &map_kt,
+                            uint32_t ctr_concurrency)
+    : crtl_inst_(ctrl_frame), kt_handler_map_(map_kt),
+      ctr_concurrency_(ctr_concurrency) {}
 
 
 /**
@@ -45,71 +141,36 @@ unc::tclib::TcCommonRet DriverTxnInterface::HandleCommitGlobalCommit(
     unc::tclib::TcControllerList
     controllers) {
   ODC_FUNC_TRACE;
-  std::string ctr_name;
-  driver* drv = NULL;
-  controller* ctr = NULL;
   unc::tclib::TcCommonRet ret_code = unc::tclib::TC_SUCCESS;
-  ctr_iter iter;
+  std::vector<ControllerTxn_t> txns;
+  std::vector<ControllerTxn_t>::iterator txn;
   pfc_bool_t Abort = PFC_FALSE;
   unc::tclib::TcLibModule* tclib_ptr =
       static_cast<unc::tclib::TcLibModule*>
       (unc::tclib::TcLibModule::getInstance("tclib"));
   PFC_ASSERT(tclib_ptr != NULL);
 
-  for (iter = controllers.begin(); iter != controllers.end(); iter++) {
-    pfc_bool_t commit = PFC_FALSE;
-    ctr_name = *iter;
-    controller_operation util_obj(crtl_inst_, WRITE_TO_CONTROLLER, ctr_name);
-    if (util_obj.get_controller_status() == PFC_FALSE) {
-      pfc_log_debug("%s Controller not exist, send disconnected", \
-                                               PFC_FUNCNAME);
-      tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                          (uint32_t)UNC_RC_CTR_DISCONNECTED, 0);
-      return unc::tclib::TC_SUCCESS;
-    }
-    ctr = util_obj.get_controller_handle();
-    drv = util_obj.get_driver_handle();
-    PFC_ASSERT(ctr != NULL);
-    PFC_ASSERT(drv != NULL);
-    if (ctr != NULL) {
-      pfc_log_error("gettin conn status..ctr nt NULL");
-      if (ctr->get_connection_status() == CONNECTION_DOWN) {
-        //  check controller connection status, if down send disconnected
-        pfc_log_debug("%s Controller status is down, send disconnected", \
-                      PFC_FUNCNAME);
-        tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                      (uint32_t)UNC_RC_CTR_DISCONNECTED, 0);
-        continue;
-      }
-    // Not Audit
-    // Reject Commits if audit is not successful for the controller
-     if ( config_id != 0 ) {
-       if ( ctr->get_audit_result() != PFC_TRUE ) {
-         tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                       (uint32_t)UNC_RC_CTR_DISCONNECTED, 0);
-         ret_code = unc::tclib::TC_SUCCESS;
-         continue;
-       }
-     }
-    }
-    commit =  drv->is_2ph_commit_support_needed();
-    if (commit == PFC_TRUE) {
-      ret_code = drv->HandleCommit(ctr);
+  PrepareControllerTxns(config_id, controllers, PFC_FALSE, &txns);
+  RunControllerTxns(txns, PFC_FALSE);
 
-      if (ret_code != unc::tclib::TC_SUCCESS) {
-        Abort = PFC_TRUE;
-        break;
-      } else {
-        pfc_log_debug("HandleCommitGlobalCommit success for controller:%s",
-                      ctr_name.c_str());
-      }
-    } else {
+  // Results are written in the order of the controllers list
+  for (txn = txns.begin(); txn != txns.end(); txn++) {
+    if (txn->send == PFC_FALSE) {
       pfc_log_debug("TcLibWriteControllerInfo for controller:%s",
-                    ctr_name.c_str());
-      tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                                    (uint32_t)UNC_RC_SUCCESS, 0);
+                    txn->ctr_name.c_str());
+      tclib_ptr->TcLibWriteControllerInfo(txn->ctr_name,
+                                          txn->write_code, 0);
+      continue;
+    }
+    ret_code = txn->ret_code;
+    if (ret_code != unc::tclib::TC_SUCCESS) {
+      Abort = PFC_TRUE;
+      break;
     }
+    pfc_log_debug("HandleCommitGlobalCommit success for controller:%s",
+                  txn->ctr_name.c_str());
   }
+  ReleaseControllerTxns(txns);
   if (Abort == PFC_TRUE)
     AbortControllers(controllers);
   return ret_code;
@@ -183,10 +244,16 @@ void DriverTxnInterface::AbortControllers(unc::tclib::TcControllerList
     pfc_bool_t Abort = PFC_FALSE;
     ctr_name = *iter;
     controller_operation util_obj(crtl_inst_, WRITE_TO_CONTROLLER, ctr_name);
+    if (util_obj.get_controller_status() == PFC_FALSE) {
+      pfc_log_debug("abort controller :%s not exist", ctr_name.c_str());
+      continue;
+    }
     ctr = util_obj.get_controller_handle();
     drv = util_obj.get_driver_handle();
-    PFC_ASSERT(ctr != NULL);
-    PFC_ASSERT(drv != NULL);
+    if ((ctr == NULL) || (drv == NULL)) {
+      pfc_log_debug("abort controller :%s is deleted", ctr_name.c_str());
+      continue;
+    }
     Abort =  drv->is_2ph_commit_support_needed();
     if (Abort == PFC_TRUE) {
       ret_code = drv->HandleAbort(ctr);
@@ -225,65 +292,39 @@ unc::tclib::TcCommonRet DriverTxnInterface::HandleCommitVoteRequest(
                                         controllers) {
   ODC_FUNC_TRACE;
   pfc_bool_t Abort = PFC_FALSE;
-  std::string ctr_name;
-  driver* drv = NULL;
-  controller* ctr = NULL;
   uint32_t retc = UNC_DRV_RC_ERR_GENERIC;
-  ctr_iter  iter;
+  std::vector<ControllerTxn_t> txns;
+  std::vector<ControllerTxn_t>::iterator txn;
   unc::tclib::TcCommonRet ret_code = unc::tclib::TC_SUCCESS;
   unc::tclib::TcLibModule* tclib_ptr =
             static_cast<unc::tclib::TcLibModule*>
            (unc::tclib::TcLibModule::getInstance("tclib"));
   PFC_ASSERT(tclib_ptr != NULL);
 
-  for (iter = controllers.begin(); iter != controllers.end(); iter++) {
-    pfc_bool_t vote = PFC_FALSE;
-    ctr_name = *iter;
-    controller_operation util_obj(crtl_inst_, WRITE_TO_CONTROLLER, ctr_name);
-    if (util_obj.get_controller_status() == PFC_FALSE) {
-      pfc_log_debug("%s Controller not exist, send disconnected", \
-                                               PFC_FUNCNAME);
-      tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                          (uint32_t)UNC_RC_CTR_DISCONNECTED, 0);
-      return unc::tclib::TC_SUCCESS;
-    }
+  PrepareControllerTxns(config_id, controllers, PFC_TRUE, &txns);
+  RunControllerTxns(txns, PFC_TRUE);
 
-    ctr = util_obj.get_controller_handle();
-    drv = util_obj.get_driver_handle();
-    PFC_ASSERT(ctr != NULL);
-    PFC_ASSERT(drv != NULL);
-    if (ctr->get_connection_status() == CONNECTION_DOWN) {
-      pfc_log_debug("%s Controller status is down, send disconnected", \
-                    PFC_FUNCNAME);
-      tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                    (uint32_t)UNC_RC_CTR_DISCONNECTED, 0);
-      ret_code = unc::tclib::TC_SUCCESS;
+  // Results are written in the order of the controllers list
+  for (txn = txns.begin(); txn != txns.end(); txn++) {
+    if (txn->send == PFC_FALSE) {
+      tclib_ptr->TcLibWriteControllerInfo(txn->ctr_name,
+                                          txn->write_code, 0);
       continue;
     }
-    // Not Audit
-    // Reject Commits if audit is not successful for the controller
-    if ( config_id != 0 ) {
-      if ( ctr->get_audit_result() != PFC_TRUE ) {
-        pfc_log_debug("Audit is not successful for the controller");
-        tclib_ptr->TcLibWriteControllerInfo(ctr_name,
-                      (uint32_t)UNC_RC_CTR_DISCONNECTED, 0);
-        ret_code = unc::tclib::TC_SUCCESS;
-        continue;
-      }
-    }
-    vote =  drv->is_2ph_commit_support_needed();
-    if (vote == PFC_TRUE) {
-      ret_code = drv->HandleVote(ctr);
+    controller* ctr = txn->util_obj->get_controller_handle();
+    ret_code = txn->ret_code;
+    if (txn->two_phase == PFC_TRUE) {
       if (ret_code != unc::tclib::TC_SUCCESS) {
         Abort = PFC_TRUE;
         pfc_log_error("VOTE Failure in driver");
         break;
       }
     } else {
-      ret_code = HandleCommitCache(ctr_name, ctr, drv);
       if (ret_code !=unc::tclib::TC_SUCCESS) {
         pfc_log_error("VOTE Failure in driver, ret %u", ret_code);
-        ctr->set_audit_result(PFC_FALSE);
+        if (txn->failure.failed == PFC_TRUE) {
+          WriteCommitFailure(txn->ctr_name, txn->failure);
+        }
         pfc_log_debug("Exiting HandleCommitVoteRequest");
         Abort=PFC_TRUE;
         break;
@@ -291,20 +332,232 @@ unc::tclib::TcCommonRet DriverTxnInterface::HandleCommitVoteRequest(
         retc = UNC_RC_SUCCESS;
       }
     }
-    if (ret_code == unc::tclib::TC_SUCCESS) {
-      tclib_ptr->TcLibWriteControllerInfo(ctr_name, retc, 0);
-    }
+    tclib_ptr->TcLibWriteControllerInfo(txn->ctr_name, retc, 0);
     if (ctr->controller_cache != NULL) {
-      pfc_log_debug("delete controller_cache for:%s", ctr_name.c_str());
+      pfc_log_debug("delete controller_cache for:%s",
+                    txn->ctr_name.c_str());
       delete ctr->controller_cache;
       ctr->controller_cache = NULL;
     }
-  }  // for loop
+  }
+  ReleaseControllerTxns(txns);
   if (Abort == PFC_TRUE)
     AbortControllers(controllers);
   return ret_code;
 }
 
+/**
+ * @brief       - Method to check the controllers of a vote or global commit
+ *                in list order. A controller which is down, or not audited
+ *                for a commit, is written as disconnected and a controller
+ *                without two phase commit support is written as success at
+ *                global commit. A controller which does not exist is
+ *                written as disconnected and ends the vote or global commit
+ *                successfully, so the controllers after it are not checked.
+ * @param[in]   - config id, Tc controllers list,
+ *                PFC_TRUE for vote/PFC_FALSE for global commit
+ * @param[out]  - controllers to be sent
+ * @retval      - None
+ */
+void DriverTxnInterface::PrepareControllerTxns(
+    uint32_t config_id,
+    unc::tclib::TcControllerList &controllers,
+    pfc_bool_t vote,
+    std::vector<ControllerTxn_t> *txns) {
+  ODC_FUNC_TRACE;
+  ctr_iter iter;
+  for (iter = controllers.begin(); iter != controllers.end(); iter++) {
+    ControllerTxn_t txn;
+    txn.ctr_name = *iter;
+    txn.util_obj = NULL;
+    txn.send = PFC_FALSE;
+    txn.two_phase = PFC_FALSE;
+    txn.write_code = (uint32_t)UNC_RC_CTR_DISCONNECTED;
+    txn.ret_code = unc::tclib::TC_SUCCESS;
+    txn.failure.failed = PFC_FALSE;
+
+    // The controller list is locked till a missing controller is released
+    controller_operation *util_obj =
+        new controller_operation(crtl_inst_, WRITE_TO_CONTROLLER,
+                                 txn.ctr_name);
+    if (util_obj->get_controller_status() == PFC_FALSE) {
+      pfc_log_debug("%s Controller not exist, send disconnected", \
+                                               PFC_FUNCNAME);
+      delete util_obj;
+      txns->push_back(txn);
+      return;
+    }
+    controller* ctr = util_obj->get_controller_handle();
+    driver* drv = util_obj->get_driver_handle();
+    if ((ctr == NULL) || (drv == NULL)) {
+      // Controller marked for delete keeps the controller list locked
+      pfc_log_debug("%s Controller is deleted, send disconnected", \
+                    PFC_FUNCNAME);
+      delete util_obj;
+      txns->push_back(txn);
+      continue;
+    }
+    if (ctr->get_connection_status() == CONNECTION_DOWN) {
+      pfc_log_debug("%s Controller status is down, send disconnected", \
+                    PFC_FUNCNAME);
+      delete util_obj;
+      txns->push_back(txn);
+      continue;
+    }
+    // Not Audit
+    // Reject Commits if audit is not successful for the controller
+    if ( config_id != 0 ) {
+      if ( ctr->get_audit_result() != PFC_TRUE ) {
+        pfc_log_debug("Audit is not successful for the controller");
+        delete util_obj;
+        txns->push_back(txn);
+        continue;
+      }
+    }
+    txn.two_phase = drv->is_2ph_commit_support_needed();
+    if ((vote == PFC_FALSE) && (txn.two_phase == PFC_FALSE)) {
+      delete util_obj;
+      txn.write_code = (uint32_t)UNC_RC_SUCCESS;
+      txns->push_back(txn);
+      continue;
+    }
+    txn.util_obj = util_obj;
+    txn.send = PFC_TRUE;
+    txns->push_back(txn);
+  }
+}
+
+/**
+ * @brief       - Method to send the vote or global commit of a controller
+ * @param[in]   - controller, PFC_TRUE for vote/PFC_FALSE for global commit
+ * @retval      - None
+ */
+void DriverTxnInterface::RunControllerTxn(ControllerTxn_t *txn,
+                                          pfc_bool_t vote) {
+  controller* ctr = txn->util_obj->get_controller_handle();
+  driver* drv = txn->util_obj->get_driver_handle();
+  if (txn->two_phase == PFC_TRUE) {
+    txn->ret_code = (vote == PFC_TRUE) ? drv->HandleVote(ctr) :
+        drv->HandleCommit(ctr);
+    return;
+  }
+  txn->ret_code = SendCommitCache(txn->ctr_name, ctr, drv, &txn->failure);
+  if (txn->ret_code != unc::tclib::TC_SUCCESS) {
+    ctr->set_audit_result(PFC_FALSE);
+  }
+}
+
+/**
+ * @brief       - Task which sends the vote or global commit of a controller
+ * @param[in]   - controller, PFC_TRUE for vote/PFC_FALSE for global commit,
+ *                state of RunControllerTxns
+ * @retval      - None
+ */
+void DriverTxnInterface::RunControllerTxnTask(ControllerTxn_t *txn,
+                                              pfc_bool_t vote,
+                                              ControllerTxnState_t *state) {
+  RunControllerTxn(txn, vote);
+  pfc::core::ScopedMutex m(state->mutex);
+  state->in_flight--;
+  state->cond.broadcast();
+}
+
+/**
+ * @brief       - Method to send the vote or global commit to the controllers.
+ *                Each controller with two phase commit support is sent by its
+ *                own task with its own request timeouts, so a slow controller
+ *                does not delay the others. Up to ctr_concurrency_ of them are
+ *                sent at the same time. A controller without two phase commit
+ *                support is programmed by the vote and cannot be aborted, so
+ *                these controllers are sent one by one in list order after
+ *                the others have completed. No controller is sent after the
+ *                first failure in list order.
+ * @param[in]   - controllers, PFC_TRUE for vote/PFC_FALSE for global commit
+ * @retval      - None
+ */
+void DriverTxnInterface::RunControllerTxns(std::vector<ControllerTxn_t> &txns,
+                                           pfc_bool_t vote) {
+  ODC_FUNC_TRACE;
+  std::vector<ControllerTxn_t>::iterator txn;
+  uint32_t count = 0;
+  for (txn = txns.begin(); txn != txns.end(); txn++) {
+    if ((txn->send == PFC_TRUE) && (txn->two_phase == PFC_TRUE)) {
+      count++;
+    }
+  }
+  uint32_t concurrency = (ctr_concurrency_ < count) ? ctr_concurrency_ : count;
+  pfc::core::TaskQueue *taskq = NULL;
+  if (concurrency > 1) {
+    taskq = pfc::core::TaskQueue::create(concurrency);
+    if (taskq == NULL) {
+      pfc_log_warn("Failed to create controller commit task queue");
+    }
+  }
+  pfc_bool_t concurrent = (taskq != NULL) ? PFC_TRUE : PFC_FALSE;
+  if (concurrent == PFC_TRUE) {
+    ControllerTxnState_t state;
+    state.in_flight = 0;
+    for (txn = txns.begin(); txn != txns.end(); txn++) {
+      if ((txn->send == PFC_FALSE) || (txn->two_phase == PFC_FALSE)) {
+        continue;
+      }
+      {
+        pfc::core::ScopedMutex m(state.mutex);
+        state.in_flight++;
+      }
+      if (taskq->dispatch(boost::bind(
+              &DriverTxnInterface::RunControllerTxnTask,
+              this, &(*txn), vote, &state)) != 0) {
+        pfc_log_warn("Failed to dispatch controller %s, send inline",
+                     txn->ctr_name.c_str());
+        {
+          pfc::core::ScopedMutex m(state.mutex);
+          state.in_flight--;
+        }
+        RunControllerTxn(&(*txn), vote);
+      }
+    }
+    {
+      pfc::core::ScopedMutex m(state.mutex);
+      while (state.in_flight > 0) {
+        state.cond.wait(state.mutex);
+      }
+    }
+    delete taskq;
+    pfc_log_debug("%u controllers sent, concurrency %u", count, concurrency);
+  }
+
+  for (txn = txns.begin(); txn != txns.end(); txn++) {
+    if (txn->send == PFC_FALSE) {
+      continue;
+    }
+    if ((concurrent == PFC_FALSE) || (txn->two_phase == PFC_FALSE)) {
+      RunControllerTxn(&(*txn), vote);
+    }
+    if (txn->ret_code != unc::tclib::TC_SUCCESS) {
+      break;
+    }
+  }
+}
+
+/**
+ * @brief       - Method to release the controllers of a vote or global
+ *                commit. It must be called before the controllers are
+ *                aborted, as they are locked again for write.
+ * @param[in]   - controllers
+ * @retval      - None
+ */
+void DriverTxnInterface::ReleaseControllerTxns(
+    std::vector<ControllerTxn_t> &txns) {
+  std::vector<ControllerTxn_t>::iterator txn;
+  for (txn = txns.begin(); txn != txns.end(); txn++) {
+    if (txn->util_obj != NULL) {
+      delete txn->util_obj;
+      txn->util_obj = NULL;
+    }
+  }
+}
+
 /**
  * @brief       - Method to Handle the controller cache
  * @param[in]   - controller name,controller*,
@@ -316,19 +569,47 @@ unc::tclib::TcCommonRet DriverTxnInterface::HandleCommitCache
                                              controller* ctr,
                                              driver* drv) {
   ODC_FUNC_TRACE;
+  CommitFailure_t failure;
+  failure.failed = PFC_FALSE;
+  unc::tclib::TcCommonRet ret_code = SendCommitCache(ctr_name, ctr, drv,
+                                                     &failure);
+  if (failure.failed == PFC_TRUE) {
+    WriteCommitFailure(ctr_name, failure);
+  }
+  return ret_code;
+}
+
+/**
+ * @brief       - Method to send the controller cache. The config node
+ *                which failed to be sent is returned to be written to
+ *                Tclib by the caller.
+ * @param[in]   - controller name,controller*,
+ *                driver*
+ * @param[out]  - config node which failed to be sent
+ * @retval      - TcCommonRet enum value
+ */
+unc::tclib::TcCommonRet DriverTxnInterface::SendCommitCache(
+    std::string ctr_name,
+    controller* ctr,
+    driver* drv,
+    CommitFailure_t *failure) {
+  ODC_FUNC_TRACE;
   PFC_ASSERT(ctr != NULL);
 
   unc::tclib::TcCommonRet ret_code = unc::tclib::TC_FAILURE;
-  unc::tclib::TcLibModule* tclib_ptr =
-      static_cast<unc::tclib::TcLibModule*>
-      (unc::tclib::TcLibModule::getInstance("tclib"));
-  PFC_ASSERT(tclib_ptr != NULL);
+  failure->failed = PFC_FALSE;
   if (ctr->controller_cache != NULL) {
     std::auto_ptr<unc::vtndrvcache::CommonIterator>
         itr_ptr(ctr->controller_cache->create_iterator());
     uint32_t size = ctr->controller_cache->cfg_list_count();
     pfc_log_debug("config node size is %d for controller %s",
                   size, ctr_name.c_str());
+    uint32_t concurrency = (drv != NULL) ? drv->get_commit_concurrency() : 1;
+    if ((concurrency > 1) && (size > 1) &&
+        (HandleCommitCacheParallel(ctr_name, ctr, drv, concurrency,
+                                   &ret_code, failure) == PFC_TRUE)) {
+      return ret_code;
+    }
     unc::vtndrvcache::ConfigNode *cfgnode = NULL;
     //  get the controoler configuration from config node and execute
     for (cfgnode = itr_ptr->FirstItem(); itr_ptr->IsDone() == false;
@@ -351,14 +632,11 @@ unc::tclib::TcCommonRet DriverTxnInterface::HandleCommitCache
       // any command execution failed for controller write the error to Tclib
       if (ret_code != unc::tclib::TC_SUCCESS) {
         pfc_log_debug("%u,execute_cmd not success", keytype);
-        tclib_ptr->TcLibWriteControllerInfo(ctr_name, retc, 1);
-        void* key = hnd_ptr->get_key_struct(cfgnode);
-        void* val = hnd_ptr->get_val_struct(cfgnode);
-        pfc_ipcstdef_t* key_sdf = VtnDrvIntf::key_map.find(keytype)->second;
-        pfc_ipcstdef_t* val_sdf = VtnDrvIntf::val_map.find(keytype)->second;
-        tclib_ptr->TcLibWriteKeyValueDataInfo(ctr_name, (uint32_t)keytype,
-                                              *key_sdf, *val_sdf,
-                                              key, val);
+        failure->failed = PFC_TRUE;
+        failure->retc = retc;
+        failure->keytype = keytype;
+        failure->hnd_ptr = hnd_ptr;
+        failure->cfgnode = cfgnode;
         break;
       }
     }
@@ -369,6 +647,184 @@ unc::tclib::TcCommonRet DriverTxnInterface::HandleCommitCache
   return ret_code;
 }
 
+/**
+ * @brief       - Method to write the config node which failed to be sent
+ *                to Tclib
+ * @param[in]   - controller name,config node which failed to be sent
+ * @retval      - None
+ */
+void DriverTxnInterface::WriteCommitFailure(std::string ctr_name,
+                                            const CommitFailure_t &failure) {
+  unc::tclib::TcLibModule* tclib_ptr =
+      static_cast<unc::tclib::TcLibModule*>
+      (unc::tclib::TcLibModule::getInstance("tclib"));
+  PFC_ASSERT(tclib_ptr != NULL);
+  unc_key_type_t keytype = failure.keytype;
+  tclib_ptr->TcLibWriteControllerInfo(ctr_name, failure.retc, 1);
+  void* key = failure.hnd_ptr->get_key_struct(failure.cfgnode);
+  void* val = failure.hnd_ptr->get_val_struct(failure.cfgnode);
+  pfc_ipcstdef_t* key_sdf = VtnDrvIntf::key_map.find(keytype)->second;
+  pfc_ipcstdef_t* val_sdf = VtnDrvIntf::val_map.find(keytype)->second;
+  tclib_ptr->TcLibWriteKeyValueDataInfo(ctr_name, (uint32_t)keytype,
+                                        *key_sdf, *val_sdf,
+                                        key, val);
+}
+
+/**
+ * @brief       - Checks if two config nodes must be sent in commit order.
+ *                Nodes out of the VTN tree are sent alone, a node and its
+ *                ancestors are sent in order and flowfilter entries are
+ *                ordered against all other nodes. VLAN maps of all the
+ *                vbridges are kept in one list of the controller, so they
+ *                are sent one at a time.
+ * @param[in]   - keytype and key of both nodes
+ * @retval      - PFC_TRUE if the nodes depend on each other
+ */
+pfc_bool_t DriverTxnInterface::IsCommitOrderNeeded(unc_key_type_t keytype1,
+                                                   const std::string &key1,
+                                                   unc_key_type_t keytype2,
+                                                   const std::string &key2) {
+  if ((is_vtn_tree_keytype(keytype1) == PFC_FALSE) ||
+      (is_vtn_tree_keytype(keytype2) == PFC_FALSE)) {
+    return PFC_TRUE;
+  }
+  if (is_flowfilter_entry_keytype(keytype1) !=
+      is_flowfilter_entry_keytype(keytype2)) {
+    return PFC_TRUE;
+  }
+  if ((keytype1 == UNC_KT_VBR_VLANMAP) && (keytype2 == UNC_KT_VBR_VLANMAP)) {
+    return PFC_TRUE;
+  }
+  if ((key1.compare(0, key2.length(), key2) == 0) ||
+      (key2.compare(0, key1.length(), key1) == 0)) {
+    return PFC_TRUE;
+  }
+  return PFC_FALSE;
+}
+
+/**
+ * @brief       - Method to send the controller cache with up to concurrency
+ *                config nodes in flight. A node is not sent before all
+ *                earlier nodes it depends on have completed, and no node is
+ *                sent after a failure. The first failed node in commit order
+ *                is returned as done for the sequential commit.
+ * @param[in]   - controller name,controller*,
+ *                driver*,concurrency
+ * @param[out]  - TcCommonRet enum value, config node which failed
+ * @retval      - PFC_FALSE if the task queue could not be created
+ */
+pfc_bool_t DriverTxnInterface::HandleCommitCacheParallel(
+    std::string ctr_name,
+    controller* ctr,
+    driver* drv,
+    uint32_t concurrency,
+    unc::tclib::TcCommonRet *ret_code,
+    CommitFailure_t *failure) {
+  ODC_FUNC_TRACE;
+  std::vector<unc::vtndrvcache::ConfigNode*> nodes;
+  std::vector<unc_key_type_t> keytypes;
+  std::vector<std::string> keys;
+  std::vector<KtHandler*> handlers;
+  std::auto_ptr<unc::vtndrvcache::CommonIterator>
+      itr_ptr(ctr->controller_cache->create_iterator());
+  unc::vtndrvcache::ConfigNode *cfgnode = NULL;
+  for (cfgnode = itr_ptr->FirstItem(); itr_ptr->IsDone() == false;
+       cfgnode = itr_ptr->NextItem() ) {
+    unc_key_type_t keytype = cfgnode->get_type_name();
+    std::map <unc_key_type_t, KtHandler*>::iterator
+        iter = kt_handler_map_.find(keytype);
+    KtHandler* hnd_ptr = NULL;
+    if (iter != kt_handler_map_.end()) {
+      hnd_ptr = iter->second;
+    }
+    PFC_ASSERT(hnd_ptr != NULL);
+    nodes.push_back(cfgnode);
+    keytypes.push_back(keytype);
+    keys.push_back(cfgnode->get_key_generate());
+    handlers.push_back(hnd_ptr);
+  }
+
+  pfc::core::TaskQueue *taskq = pfc::core::TaskQueue::create(concurrency);
+  if (taskq == NULL) {
+    pfc_log_warn("Failed to create commit task queue for %s",
+                 ctr_name.c_str());
+    return PFC_FALSE;
+  }
+
+  uint32_t count = nodes.size();
+  CommitState_t state;
+  state.in_flight = 0;
+  state.failed = PFC_FALSE;
+  state.result.assign(count, UNC_DRV_RC_ERR_GENERIC);
+  state.done.assign(count, PFC_FALSE);
+  uint32_t sent = 0;
+  {
+    pfc::core::ScopedMutex m(state.mutex);
+    // Oldest node which has not completed yet
+    uint32_t oldest = 0;
+    for (; (sent < count) && (state.failed == PFC_FALSE); sent++) {
+      for (;;) {
+        while ((oldest < sent) && (state.done[oldest] == PFC_TRUE)) {
+          oldest++;
+        }
+        pfc_bool_t blocked = (state.in_flight >= concurrency) ?
+            PFC_TRUE : PFC_FALSE;
+        for (uint32_t i = oldest; (i < sent) && (blocked == PFC_FALSE);
+             i++) {
+          if ((state.done[i] == PFC_FALSE) &&
+              (IsCommitOrderNeeded(keytypes[i], keys[i], keytypes[sent],
+                                   keys[sent]) == PFC_TRUE)) {
+            blocked = PFC_TRUE;
+          }
+        }
+        if ((blocked == PFC_FALSE) || (state.failed == PFC_TRUE)) {
+          break;
+        }
+        state.cond.wait(state.mutex);
+      }
+      if (state.failed == PFC_TRUE) {
+        break;
+      }
+      pfc_log_debug("%u,keytype sending node %u", keytypes[sent], sent);
+      CommitNodeTask task(&state, sent, handlers[sent], nodes[sent],
+                          ctr, drv);
+      pfc::core::taskq_func_t task_func(task);
+      state.in_flight++;
+      if (taskq->dispatch(task_func) != 0) {
+        pfc_log_error("Failed to dispatch commit of node %u", sent);
+        state.in_flight--;
+        state.done[sent] = PFC_TRUE;
+        state.failed = PFC_TRUE;
+        sent++;
+        break;
+      }
+    }
+    while (state.in_flight > 0) {
+      state.cond.wait(state.mutex);
+    }
+  }
+  delete taskq;
+
+  *ret_code = unc::tclib::TC_SUCCESS;
+  for (uint32_t i = 0; i < sent; i++) {
+    if (state.result[i] == UNC_RC_SUCCESS) {
+      continue;
+    }
+    // any command execution failed for controller write the error to Tclib
+    *ret_code = unc::tclib::TC_FAILURE;
+    pfc_log_debug("%u,execute_cmd not success", keytypes[i]);
+    failure->failed = PFC_TRUE;
+    failure->retc = state.result[i];
+    failure->keytype = keytypes[i];
+    failure->hnd_ptr = handlers[i];
+    failure->cfgnode = nodes[i];
+    break;
+  }
+  pfc_log_debug("%u of %u config nodes sent to %s", sent, count,
+                ctr_name.c_str());
+  return PFC_TRUE;
+}
+
   /**
    * @brief       - Handles Audit end
    * @param[in]   - session id
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "dal_error_handler.hh"
+#include "dal_odbc_mgr.hh"
+#include "odbc_stub.hh"
+
+using unc::upll::dal::DalBindInfo;
+using unc::upll::dal::DalErrorHandler;
+using unc::upll::dal::DalOdbcMgr;
+using unc::upll::dal::DalResultCode;
+using unc::upll::dal::kDalRcSuccess;
+using unc::upll::dal::kDalRcRecordAlreadyExists;
+using unc::upll::dal::kDalRcRecordNotFound;
+using unc::upll::dal::ut::OdbcStub;
+namespace schema = unc::upll::dal::schema;
+namespace vtn = unc::upll::dal::schema::table::vtn;
+
+static const size_t kNumRows = 3;
+
+class DalBulkTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+      OdbcStub::Reset();
+      DalErrorHandler::FillErrorMap();
+      dom_ = new DalOdbcMgr();
+      dom_->dal_conn_handle_ = OdbcStub::NewHandle();
+      dom_->conn_state_ = unc::upll::dal::kDalDbConnected;
+      memset(vtn_name_, 0, sizeof(vtn_name_));
+      for (size_t row = 0; row < kNumRows; row++) {
+        snprintf(reinterpret_cast<char *>(vtn_name_[row]),
+                 sizeof(vtn_name_[row]), "vtn%" PFC_PFMT_SIZE_T, row);
+        down_count_[row] = row;
+      }
+    }
+
+    virtual void TearDown() {
+      for (size_t row = 0; row < bind_infos_.size(); row++) {
+        delete bind_infos_[row];
+      }
+      bind_infos_.clear();
+      delete dom_;
+    }
+
+    // Binds vtn_name and down_count of each row as inputs
+    void BindCreate() {
+      for (size_t row = 0; row < kNumRows; row++) {
+        DalBindInfo *bind_info = new DalBindInfo(schema::table::kDbiVtnTbl);
+        bind_info->BindInput(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                             sizeof(vtn_name_[row]), vtn_name_[row]);
+        bind_info->BindInput(vtn::kDbiDownCount, unc::upll::dal::kDalUint64,
+                             1, &down_count_[row]);
+        bind_infos_.push_back(bind_info);
+      }
+    }
+
+    // Updates down_count of each row matching on vtn_name
+    void BindUpdate() {
+      for (size_t row = 0; row < kNumRows; row++) {
+        DalBindInfo *bind_info = new DalBindInfo(schema::table::kDbiVtnTbl);
+        bind_info->BindInput(vtn::kDbiDownCount, unc::upll::dal::kDalUint64,
+                             1, &down_count_[row]);
+        bind_info->BindMatch(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                             sizeof(vtn_name_[row]), vtn_name_[row]);
+        bind_infos_.push_back(bind_info);
+      }
+    }
+
+    std::vector<const DalBindInfo *> Rows() const {
+      return std::vector<const DalBindInfo *>(bind_infos_.begin(),
+                                              bind_infos_.end());
+    }
+
+    DalOdbcMgr *dom_;
+    uint8_t vtn_name_[kNumRows][32];
+    uint64_t down_count_[kNumRows];
+    std::vector<DalBindInfo *> bind_infos_;
+};
+
+TEST_F(DalBulkTest, create_records_single_execution) {
+  std::vector<DalResultCode> results;
+  BindCreate();
+
+  EXPECT_EQ(kDalRcSuccess,
+            dom_->CreateRecords(UPLL_DT_RUNNING, schema::table::kDbiVtnTbl,
+                                Rows(), &results, TC_CONFIG_GLOBAL, NULL));
+  ASSERT_EQ(1U, OdbcStub::executions.size());
+  EXPECT_EQ(kNumRows, OdbcStub::executions[0]);
+  ASSERT_EQ(kNumRows, results.size());
+  for (size_t row = 0; row < kNumRows; row++) {
+    EXPECT_EQ(kDalRcSuccess, results[row]);
+  }
+  EXPECT_EQ(kNumRows, dom_->get_write_count());
+}
+
+TEST_F(DalBulkTest, create_records_failed_row_redoes_chunk) {
+  std::vector<DalResultCode> results;
+  BindCreate();
+  OdbcStub::fail_value = "vtn1";
+
+  // The other rows of the chunk may be rolled back with the failed one,
+  // so every row is created again alone
+  EXPECT_EQ(kDalRcRecordAlreadyExists,
+            dom_->CreateRecords(UPLL_DT_RUNNING, schema::table::kDbiVtnTbl,
+                                Rows(), &results, TC_CONFIG_GLOBAL, NULL));
+  ASSERT_EQ(1U + kNumRows, OdbcStub::executions.size());
+  EXPECT_EQ(kNumRows, OdbcStub::executions[0]);
+  for (size_t i = 1; i < OdbcStub::executions.size(); i++) {
+    EXPECT_EQ(1U, OdbcStub::executions[i]);
+  }
+  ASSERT_EQ(kNumRows, results.size());
+  EXPECT_EQ(kDalRcSuccess, results[0]);
+  EXPECT_EQ(kDalRcRecordAlreadyExists, results[1]);
+  EXPECT_EQ(kDalRcSuccess, results[2]);
+  EXPECT_EQ(2U, dom_->get_write_count());
+}
+
+TEST_F(DalBulkTest, create_records_one_row) {
+  std::vector<const DalBindInfo *> rows;
+  std::vector<DalResultCode> results;
+  BindCreate();
+  rows.push_back(bind_infos_[0]);
+
+  EXPECT_EQ(kDalRcSuccess,
+            dom_->CreateRecords(UPLL_DT_RUNNING, schema::table::kDbiVtnTbl,
+                                rows, &results, TC_CONFIG_GLOBAL, NULL));
+  ASSERT_EQ(1U, OdbcStub::executions.size());
+  EXPECT_EQ(1U, OdbcStub::executions[0]);
+  ASSERT_EQ(1U, results.size());
+  EXPECT_EQ(kDalRcSuccess, results[0]);
+}
+
+TEST_F(DalBulkTest, update_records_single_execution) {
+  std::vector<DalResultCode> results;
+  BindUpdate();
+
+  EXPECT_EQ(kDalRcSuccess,
+            dom_->UpdateRecords(UPLL_DT_RUNNING, schema::table::kDbiVtnTbl,
+                                Rows(), &results, TC_CONFIG_GLOBAL, NULL));
+  ASSERT_EQ(1U, OdbcStub::executions.size());
+  EXPECT_EQ(kNumRows, OdbcStub::executions[0]);
+  ASSERT_EQ(kNumRows, results.size());
+  for (size_t row = 0; row < kNumRows; row++) {
+    EXPECT_EQ(kDalRcSuccess, results[row]);
+  }
+  EXPECT_EQ(kNumRows, dom_->get_write_count());
+}
+
+TEST_F(DalBulkTest, update_records_no_match_retried) {
+  std::vector<DalResultCode> results;
+  BindUpdate();
+  OdbcStub::nomatch_value = "vtn2";
+
+  // Affected row count is short, so every row is updated again alone
+  EXPECT_EQ(kDalRcRecordNotFound,
+            dom_->UpdateRecords(UPLL_DT_RUNNING, schema::table::kDbiVtnTbl,
+                                Rows(), &results, TC_CONFIG_GLOBAL, NULL));
+  ASSERT_EQ(1U + kNumRows, OdbcStub::executions.size());
+  EXPECT_EQ(kNumRows, OdbcStub::executions[0]);
+  for (size_t i = 1; i < OdbcStub::executions.size(); i++) {
+    EXPECT_EQ(1U, OdbcStub::executions[i]);
+  }
+  ASSERT_EQ(kNumRows, results.size());
+  EXPECT_EQ(kDalRcSuccess, results[0]);
+  EXPECT_EQ(kDalRcSuccess, results[1]);
+  EXPECT_EQ(kDalRcRecordNotFound, results[2]);
+}
+
+TEST_F(DalBulkTest, update_records_failed_row_redoes_chunk) {
+  std::vector<DalResultCode> results;
+  BindUpdate();
+  OdbcStub::fail_value = "vtn1";
+
+  // The other updates of the chunk may be rolled back with the failed one,
+  // so every row is updated again alone
+  EXPECT_EQ(kDalRcRecordAlreadyExists,
+            dom_->UpdateRecords(UPLL_DT_RUNNING, schema::table::kDbiVtnTbl,
+                                Rows(), &results, TC_CONFIG_GLOBAL, NULL));
+  ASSERT_EQ(1U + kNumRows, OdbcStub::executions.size());
+  EXPECT_EQ(kNumRows, OdbcStub::executions[0]);
+  for (size_t i = 1; i < OdbcStub::executions.size(); i++) {
+    EXPECT_EQ(1U, OdbcStub::executions[i]);
+  }
+  ASSERT_EQ(kNumRows, results.size());
+  EXPECT_EQ(kDalRcSuccess, results[0]);
+  EXPECT_EQ(kDalRcRecordAlreadyExists, results[1]);
+  EXPECT_EQ(kDalRcSuccess, results[2]);
+  EXPECT_EQ(2U, dom_->get_write_count());
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "dal_cursor.hh"
+#include "dal_error_handler.hh"
+#include "dal_odbc_mgr.hh"
+#include "odbc_stub.hh"
+
+using unc::upll::dal::DalBindInfo;
+using unc::upll::dal::DalCursor;
+using unc::upll::dal::DalErrorHandler;
+using unc::upll::dal::DalOdbcMgr;
+using unc::upll::dal::kDalRcSuccess;
+using unc::upll::dal::kDalRcGeneralError;
+using unc::upll::dal::kDalRcRecordNotFound;
+using unc::upll::dal::kDalRcRecordNoMore;
+using unc::upll::dal::kDalChangeDeleted;
+using unc::upll::dal::kDalChangeCreated;
+using unc::upll::dal::kDalChangeUpdated;
+using unc::upll::dal::kDalChangeUpdatedOld;
+using unc::upll::dal::ut::OdbcStub;
+using unc::upll::dal::ut::OdbcStubStmt;
+namespace schema = unc::upll::dal::schema;
+namespace vtn = unc::upll::dal::schema::table::vtn;
+
+class DalChangedRecordsTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+      OdbcStub::Reset();
+      DalErrorHandler::FillErrorMap();
+      dom_ = new DalOdbcMgr();
+      dom_->dal_conn_handle_ = OdbcStub::NewHandle();
+      dom_->conn_state_ = unc::upll::dal::kDalDbConnected;
+      memset(vtn_name_, 0, sizeof(vtn_name_));
+      down_count_ = 0;
+      change_ = 0;
+      cursor_ = NULL;
+      bind_info_ = new DalBindInfo(schema::table::kDbiVtnTbl);
+    }
+
+    virtual void TearDown() {
+      if (cursor_ != NULL) {
+        cursor_->CloseCursor(false);
+        delete cursor_;
+      }
+      delete bind_info_;
+      delete dom_;
+    }
+
+    void BindVtn() {
+      bind_info_->BindOutput(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                             sizeof(vtn_name_), vtn_name_);
+      bind_info_->BindOutput(vtn::kDbiDownCount, unc::upll::dal::kDalUint64,
+                             1, &down_count_);
+    }
+
+    void SetDirty(bool deleted, bool created, bool updated) {
+      if (deleted)
+        dom_->delete_dirty.insert(schema::table::kDbiVtnTbl);
+      if (created)
+        dom_->create_dirty.insert(schema::table::kDbiVtnTbl);
+      if (updated)
+        dom_->update_dirty.insert(schema::table::kDbiVtnTbl);
+    }
+
+    unc::upll::dal::DalResultCode GetChangedRecords() {
+      return dom_->GetChangedRecords(UPLL_DT_CANDIDATE, UPLL_DT_RUNNING,
+                                     schema::table::kDbiVtnTbl, 0,
+                                     bind_info_, &change_, &cursor_,
+                                     TC_CONFIG_GLOBAL, NULL);
+    }
+
+    // Row of the query: output columns, dal_change_grp and dal_change
+    void AddRow(const std::string &name, const uint64_t down_count,
+                const int16_t grp, const int16_t change) {
+      std::vector<std::string> row;
+      row.push_back(name);
+      row.push_back(std::string(reinterpret_cast<const char *>(&down_count),
+                                sizeof(down_count)));
+      row.push_back(std::string(reinterpret_cast<const char *>(&grp),
+                                sizeof(grp)));
+      row.push_back(std::string(reinterpret_cast<const char *>(&change),
+                                sizeof(change)));
+      OdbcStub::AddRow(cursor_->stmt_handle_1_, row);
+    }
+
+    static size_t CountOf(const std::string &str, const std::string &sub) {
+      size_t count = 0;
+      for (size_t pos = str.find(sub); pos != std::string::npos;
+           pos = str.find(sub, pos + sub.size())) {
+        count++;
+      }
+      return count;
+    }
+
+    DalOdbcMgr *dom_;
+    DalBindInfo *bind_info_;
+    DalCursor *cursor_;
+    uint8_t vtn_name_[32];
+    uint64_t down_count_;
+    int16_t change_;
+};
+
+/*
+ * All the changes of a dirty table are read by one query, ordered by the
+ * change and the primary key.
+ */
+TEST_F(DalChangedRecordsTest, all_changes_one_query) {
+  BindVtn();
+  SetDirty(true, true, true);
+
+  ASSERT_EQ(kDalRcSuccess, GetChangedRecords());
+  ASSERT_TRUE(cursor_ != NULL);
+  EXPECT_EQ(1U, OdbcStub::executions.size());
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(cursor_->stmt_handle_1_);
+  ASSERT_TRUE(stmt != NULL);
+  const std::string &query = stmt->query;
+  EXPECT_EQ(3U, CountOf(query, " UNION ALL "));
+  EXPECT_EQ(1U, CountOf(query, "FROM ca_del_vtn_tbl"));
+  EXPECT_EQ(1U, CountOf(query, "FROM ca_vtn_tbl WHERE c_flag = 1"));
+  // The updated rows of CAND and the ones of RUNN existing in them
+  EXPECT_EQ(2U, CountOf(query, "FROM ca_vtn_tbl WHERE u_flag = 1"));
+  EXPECT_EQ(1U, CountOf(query, "FROM ru_vtn_tbl"));
+  EXPECT_NE(std::string::npos,
+            query.find(" ORDER BY dal_change_grp, vtn_name, dal_change"));
+  // dal_change follows the two output columns and dal_change_grp
+  ASSERT_EQ(1U, stmt->columns.count(4));
+  EXPECT_EQ(SQL_C_SHORT, stmt->columns[4].target_type);
+
+  AddRow("vtn1", 1, 1, kDalChangeDeleted);
+  AddRow("vtn2", 2, 2, kDalChangeCreated);
+  AddRow("vtn3", 3, 3, kDalChangeUpdated);
+  AddRow("vtn3", 4, 3, kDalChangeUpdatedOld);
+  const char *names[] = { "vtn1", "vtn2", "vtn3", "vtn3" };
+  const int16_t changes[] = { kDalChangeDeleted, kDalChangeCreated,
+                              kDalChangeUpdated, kDalChangeUpdatedOld };
+  for (size_t i = 0; i < 4; i++) {
+    ASSERT_EQ(kDalRcSuccess, dom_->GetNextRecord(cursor_));
+    EXPECT_STREQ(names[i], reinterpret_cast<char *>(vtn_name_));
+    EXPECT_EQ(i + 1, down_count_);
+    EXPECT_EQ(changes[i], change_);
+  }
+  EXPECT_EQ(kDalRcRecordNoMore, dom_->GetNextRecord(cursor_));
+}
+
+/*
+ * Only the changes of the dirty operations are read.
+ */
+TEST_F(DalChangedRecordsTest, dirty_parts_only) {
+  BindVtn();
+  SetDirty(false, true, false);
+
+  ASSERT_EQ(kDalRcSuccess, GetChangedRecords());
+  const std::string &query = OdbcStub::GetStmt(cursor_->stmt_handle_1_)->query;
+  EXPECT_EQ(0U, CountOf(query, " UNION ALL "));
+  EXPECT_EQ(1U, CountOf(query, "WHERE c_flag = 1"));
+  EXPECT_EQ(0U, CountOf(query, "u_flag"));
+  EXPECT_EQ(0U, CountOf(query, "ca_del_vtn_tbl"));
+}
+
+/*
+ * Nothing is read from a table which is not dirty.
+ */
+TEST_F(DalChangedRecordsTest, not_dirty) {
+  BindVtn();
+
+  EXPECT_EQ(kDalRcRecordNotFound, GetChangedRecords());
+  EXPECT_TRUE(cursor_ == NULL);
+  EXPECT_EQ(0U, OdbcStub::executions.size());
+}
+
+/*
+ * The primary key is needed in the output for the order, and the parts
+ * cannot match vtn_name in the vtn mode.
+ */
+TEST_F(DalChangedRecordsTest, invalid_input) {
+  SetDirty(true, true, true);
+  bind_info_->BindOutput(vtn::kDbiDownCount, unc::upll::dal::kDalUint64,
+                         1, &down_count_);
+  EXPECT_EQ(kDalRcGeneralError, GetChangedRecords());
+
+  bind_info_->BindOutput(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                         sizeof(vtn_name_), vtn_name_);
+  const uint8_t vtn_name[] = "vtn1";
+  EXPECT_EQ(kDalRcGeneralError,
+            dom_->GetChangedRecords(UPLL_DT_CANDIDATE, UPLL_DT_RUNNING,
+                                    schema::table::kDbiVtnTbl, 0,
+                                    bind_info_, &change_, &cursor_,
+                                    TC_CONFIG_VTN, vtn_name));
+  EXPECT_EQ(kDalRcGeneralError,
+            dom_->GetChangedRecords(UPLL_DT_RUNNING, UPLL_DT_CANDIDATE,
+                                    schema::table::kDbiVtnTbl, 0,
+                                    bind_info_, &change_, &cursor_,
+                                    TC_CONFIG_GLOBAL, NULL));
+  EXPECT_TRUE(cursor_ == NULL);
+  EXPECT_EQ(0U, OdbcStub::executions.size());
+}
+
+/*
+ * The write generation changes on writes, commit and rollback, and is not
+ * reset like the write count.
+ */
+TEST_F(DalChangedRecordsTest, write_generation) {
+  uint64_t gen = dom_->get_write_generation();
+  BindVtn();
+  SetDirty(true, true, true);
+
+  ASSERT_EQ(kDalRcSuccess, GetChangedRecords());
+  EXPECT_EQ(gen, dom_->get_write_generation());
+
+  DalBindInfo bind_info(schema::table::kDbiVtnTbl);
+  bind_info.BindInput(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                      sizeof(vtn_name_), vtn_name_);
+  EXPECT_EQ(kDalRcSuccess,
+            dom_->CreateRecord(UPLL_DT_CANDIDATE, schema::table::kDbiVtnTbl,
+                               &bind_info, TC_CONFIG_GLOBAL, NULL));
+  EXPECT_LT(gen, dom_->get_write_generation());
+  gen = dom_->get_write_generation();
+
+  EXPECT_EQ(kDalRcSuccess, dom_->CommitTransaction());
+  EXPECT_EQ(0U, dom_->get_write_count());
+  EXPECT_LT(gen, dom_->get_write_generation());
+  gen = dom_->get_write_generation();
+
+  EXPECT_EQ(kDalRcSuccess, dom_->RollbackTransaction());
+  EXPECT_LT(gen, dom_->get_write_generation());
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "dal_cursor.hh"
+#include "dal_error_handler.hh"
+#include "odbc_stub.hh"
+
+using unc::upll::dal::DalBindInfo;
+using unc::upll::dal::DalCursor;
+using unc::upll::dal::DalErrorHandler;
+using unc::upll::dal::kDalRcSuccess;
+using unc::upll::dal::kDalRcRecordNoMore;
+using unc::upll::dal::ut::OdbcStub;
+using unc::upll::dal::ut::OdbcStubStmt;
+namespace schema = unc::upll::dal::schema;
+namespace vtn = unc::upll::dal::schema::table::vtn;
+
+class DalCursorTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+      OdbcStub::Reset();
+      DalErrorHandler::FillErrorMap();
+      stmt_handle_ = OdbcStub::NewHandle();
+      memset(vtn_name_, 0, sizeof(vtn_name_));
+      down_count_ = 0;
+      bind_info_ = new DalBindInfo(schema::table::kDbiVtnTbl);
+    }
+
+    virtual void TearDown() {
+      delete bind_info_;
+    }
+
+    void BindVtn() {
+      bind_info_->BindOutput(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                             sizeof(vtn_name_), vtn_name_);
+      bind_info_->BindOutput(vtn::kDbiDownCount, unc::upll::dal::kDalUint64,
+                             1, &down_count_);
+    }
+
+    // Adds rows vtn<first> .. vtn<first + count - 1> to the result set
+    void AddVtnRows(const uint64_t first, const uint64_t count) {
+      for (uint64_t i = first; i < first + count; i++) {
+        AddVtnRow(VtnName(i), i);
+      }
+    }
+
+    static std::string VtnName(const uint64_t i) {
+      char name[32];
+      snprintf(name, sizeof(name), "vtn%" PFC_PFMT_u64, i);
+      return name;
+    }
+
+    void AddVtnRow(const std::string &name, const uint64_t down_count) {
+      std::vector<std::string> row;
+      row.push_back(name);
+      row.push_back(std::string(reinterpret_cast<const char *>(&down_count),
+                                sizeof(down_count)));
+      OdbcStub::AddRow(stmt_handle_, row);
+    }
+
+    SQLHANDLE stmt_handle_;
+    DalBindInfo *bind_info_;
+    uint8_t vtn_name_[32];
+    uint64_t down_count_;
+};
+
+TEST_F(DalCursorTest, block_fetch_boundaries) {
+  BindVtn();
+  AddVtnRows(0, 4);
+  DalCursor *cursor = new DalCursor(stmt_handle_, bind_info_, 2);
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(stmt_handle_);
+
+  for (uint64_t i = 0; i < 4; i++) {
+    ASSERT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+    EXPECT_STREQ(VtnName(i).c_str(), reinterpret_cast<char *>(vtn_name_));
+    EXPECT_EQ(i, down_count_);
+    // A new block is fetched only after all rows of the last one are read
+    EXPECT_EQ(i / 2 + 1, stmt->fetch_count);
+  }
+  EXPECT_EQ(2U, stmt->row_array_size);
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  EXPECT_EQ(3U, stmt->fetch_count);
+  delete cursor;
+}
+
+TEST_F(DalCursorTest, block_fetch_partial_last_block) {
+  BindVtn();
+  AddVtnRows(0, 5);
+  DalCursor *cursor = new DalCursor(stmt_handle_, bind_info_, 3);
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(stmt_handle_);
+
+  for (uint64_t i = 0; i < 5; i++) {
+    ASSERT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+    EXPECT_STREQ(VtnName(i).c_str(), reinterpret_cast<char *>(vtn_name_));
+    EXPECT_EQ(i, down_count_);
+  }
+  EXPECT_EQ(2U, stmt->fetch_count);
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  delete cursor;
+}
+
+TEST_F(DalCursorTest, block_fetch_empty_result) {
+  BindVtn();
+  DalCursor *cursor = new DalCursor(stmt_handle_, bind_info_, 4);
+
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  EXPECT_EQ(1U, OdbcStub::GetStmt(stmt_handle_)->fetch_count);
+  delete cursor;
+}
+
+TEST_F(DalCursorTest, block_fetch_short_binding) {
+  // DAL buffer of the binding is shorter than the block element, only its
+  // size is copied out of the block
+  const size_t name_size = 8;
+  memset(vtn_name_, 0xa5, sizeof(vtn_name_));
+  BindVtn();
+  unc::upll::dal::DalBindList bind_list = bind_info_->get_bind_list();
+  for (size_t i = 0; i < bind_list.size(); i++) {
+    if (bind_list[i]->get_column_index() == vtn::kDbiVtnName)
+      bind_list[i]->app_array_size_ = name_size;
+  }
+  AddVtnRow("vtn_name_longer_than_app_buffer", 7);
+  AddVtnRow("vtn1", 8);
+  DalCursor *cursor = new DalCursor(stmt_handle_, bind_info_, 2);
+
+  ASSERT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+  EXPECT_EQ(0, memcmp(vtn_name_, "vtn_name", name_size));
+  for (size_t i = name_size; i < sizeof(vtn_name_); i++) {
+    EXPECT_EQ(0xa5, vtn_name_[i]);
+  }
+  EXPECT_EQ(7U, down_count_);
+
+  ASSERT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+  EXPECT_EQ(0, memcmp(vtn_name_, "vtn1\0", 5));
+  EXPECT_EQ(8U, down_count_);
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  delete cursor;
+}
+
+TEST_F(DalCursorTest, block_setup_failure_fetches_row_by_row) {
+  BindVtn();
+  AddVtnRows(0, 3);
+  OdbcStub::fail_stmt_attr = SQL_ATTR_ROW_ARRAY_SIZE;
+  DalCursor *cursor = new DalCursor(stmt_handle_, bind_info_, 4);
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(stmt_handle_);
+
+  for (uint64_t i = 0; i < 3; i++) {
+    ASSERT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+    EXPECT_STREQ(VtnName(i).c_str(), reinterpret_cast<char *>(vtn_name_));
+    EXPECT_EQ(i, down_count_);
+  }
+  EXPECT_EQ(1U, cursor->row_array_size_);
+  EXPECT_TRUE(cursor->block_1_ == NULL);
+  EXPECT_EQ(3U, stmt->fetch_count);
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  delete cursor;
+}
+
+TEST_F(DalCursorTest, row_fetch_without_block) {
+  BindVtn();
+  AddVtnRows(0, 2);
+  DalCursor *cursor = new DalCursor(stmt_handle_, bind_info_);
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(stmt_handle_);
+
+  // Row by row cursor does not bind its own buffers
+  ASSERT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+  EXPECT_TRUE(cursor->block_1_ == NULL);
+  EXPECT_TRUE(stmt->columns.empty());
+  EXPECT_EQ(kDalRcSuccess, cursor->GetNextRecord());
+  EXPECT_EQ(kDalRcRecordNoMore, cursor->GetNextRecord());
+  EXPECT_EQ(3U, stmt->fetch_count);
+  delete cursor;
+}
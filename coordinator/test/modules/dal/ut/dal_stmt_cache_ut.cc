@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dal_odbc_mgr.hh"
+#include "dal_stmt_cache.hh"
+#include "odbc_stub.hh"
+
+using unc::upll::dal::DalBindInfo;
+using unc::upll::dal::DalOdbcMgr;
+using unc::upll::dal::DalStmtCache;
+using unc::upll::dal::DalStmtCacheKey;
+using unc::upll::dal::ut::OdbcStub;
+using unc::upll::dal::ut::OdbcStubStmt;
+namespace schema = unc::upll::dal::schema;
+namespace vtn = unc::upll::dal::schema::table::vtn;
+
+static SQLHANDLE
+StmtHandle(const uintptr_t value) {
+  return reinterpret_cast<SQLHANDLE>(value);
+}
+
+static void
+MakeVtnKey(const unc::upll::dal::DalApiNum api_num, DalStmtCacheKey *key) {
+  DalStmtCache::MakeKey(api_num, schema::table::kDbiVtnTbl,
+                        UPLL_DT_CANDIDATE, NULL, key);
+}
+
+TEST(DalStmtCache, disabled) {
+  DalStmtCache cache;
+  DalStmtCacheKey key;
+  SQLHANDLE evicted = StmtHandle(1);
+  MakeVtnKey(unc::upll::dal::kDalGetSingleRecQT, &key);
+
+  EXPECT_FALSE(cache.is_enabled());
+  EXPECT_FALSE(cache.Insert(key, "SELECT 1", StmtHandle(0x10), &evicted));
+  EXPECT_EQ(SQL_NULL_HANDLE, evicted);
+  EXPECT_EQ(0U, cache.get_size());
+  EXPECT_FALSE(cache.Release(StmtHandle(0x10)));
+}
+
+TEST(DalStmtCache, hit_and_miss) {
+  DalStmtCache cache(4);
+  DalStmtCacheKey key;
+  SQLHANDLE evicted = SQL_NULL_HANDLE;
+  std::string query("SELECT vtn_name FROM ca_vtn_tbl");
+  MakeVtnKey(unc::upll::dal::kDalGetSingleRecQT, &key);
+
+  EXPECT_EQ(SQL_NULL_HANDLE, cache.Acquire(key, query));
+  EXPECT_EQ(1U, cache.get_misses());
+  EXPECT_TRUE(cache.Insert(key, query, StmtHandle(0x10), &evicted));
+  EXPECT_EQ(SQL_NULL_HANDLE, evicted);
+
+  // Handle is still used by the DAL call that prepared it
+  EXPECT_EQ(SQL_NULL_HANDLE, cache.Acquire(key, query));
+  EXPECT_EQ(2U, cache.get_misses());
+
+  EXPECT_TRUE(cache.Release(StmtHandle(0x10)));
+  EXPECT_EQ(StmtHandle(0x10), cache.Acquire(key, query));
+  EXPECT_EQ(1U, cache.get_hits());
+
+  // Same key with another query text is not served from the cache
+  EXPECT_TRUE(cache.Release(StmtHandle(0x10)));
+  EXPECT_EQ(SQL_NULL_HANDLE, cache.Acquire(key, query + " WHERE 1"));
+  EXPECT_EQ(3U, cache.get_misses());
+  EXPECT_EQ(1U, cache.get_hits());
+  EXPECT_EQ(1U, cache.get_size());
+}
+
+TEST(DalStmtCache, make_key_bind_shape) {
+  DalStmtCacheKey key_1, key_2, key_3;
+  uint8_t vtn_name[32] = "vtn1";
+  uint64_t down_count = 0;
+
+  DalBindInfo match_1(schema::table::kDbiVtnTbl);
+  match_1.BindMatch(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                    sizeof(vtn_name), vtn_name);
+  DalBindInfo match_2(schema::table::kDbiVtnTbl);
+  match_2.BindMatch(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                    sizeof(vtn_name), vtn_name);
+  DalBindInfo output(schema::table::kDbiVtnTbl);
+  output.BindMatch(vtn::kDbiVtnName, unc::upll::dal::kDalChar,
+                   sizeof(vtn_name), vtn_name);
+  output.BindOutput(vtn::kDbiDownCount, unc::upll::dal::kDalUint64,
+                    1, &down_count);
+
+  DalStmtCache::MakeKey(unc::upll::dal::kDalGetSingleRecQT,
+                        schema::table::kDbiVtnTbl, UPLL_DT_CANDIDATE,
+                        &match_1, &key_1);
+  DalStmtCache::MakeKey(unc::upll::dal::kDalGetSingleRecQT,
+                        schema::table::kDbiVtnTbl, UPLL_DT_CANDIDATE,
+                        &match_2, &key_2);
+  DalStmtCache::MakeKey(unc::upll::dal::kDalGetSingleRecQT,
+                        schema::table::kDbiVtnTbl, UPLL_DT_CANDIDATE,
+                        &output, &key_3);
+
+  // Bound values do not matter, only the bound columns
+  EXPECT_FALSE(key_1 < key_2);
+  EXPECT_FALSE(key_2 < key_1);
+  EXPECT_TRUE((key_1 < key_3) || (key_3 < key_1));
+  EXPECT_EQ(1U, key_1.bind_shape.size());
+  EXPECT_EQ(2U, key_3.bind_shape.size());
+
+  // Config type is part of the key
+  DalStmtCache::MakeKey(unc::upll::dal::kDalGetSingleRecQT,
+                        schema::table::kDbiVtnTbl, UPLL_DT_RUNNING,
+                        &match_2, &key_2);
+  EXPECT_TRUE((key_1 < key_2) || (key_2 < key_1));
+}
+
+TEST(DalStmtCache, evict_least_recently_used) {
+  DalStmtCache cache(2);
+  DalStmtCacheKey key_a, key_b, key_c;
+  SQLHANDLE evicted = SQL_NULL_HANDLE;
+  MakeVtnKey(unc::upll::dal::kDalGetSingleRecQT, &key_a);
+  MakeVtnKey(unc::upll::dal::kDalGetMultiRecQT, &key_b);
+  MakeVtnKey(unc::upll::dal::kDalRecExistsQT, &key_c);
+
+  EXPECT_TRUE(cache.Insert(key_a, "A", StmtHandle(0xa0), &evicted));
+  EXPECT_TRUE(cache.Insert(key_b, "B", StmtHandle(0xb0), &evicted));
+  EXPECT_TRUE(cache.Release(StmtHandle(0xa0)));
+  EXPECT_TRUE(cache.Release(StmtHandle(0xb0)));
+
+  // A becomes the most recently used, B is evicted for C
+  EXPECT_EQ(StmtHandle(0xa0), cache.Acquire(key_a, "A"));
+  EXPECT_TRUE(cache.Release(StmtHandle(0xa0)));
+  EXPECT_TRUE(cache.Insert(key_c, "C", StmtHandle(0xc0), &evicted));
+  EXPECT_EQ(StmtHandle(0xb0), evicted);
+  EXPECT_EQ(1U, cache.get_evictions());
+  EXPECT_EQ(2U, cache.get_size());
+  EXPECT_EQ(SQL_NULL_HANDLE, cache.Acquire(key_b, "B"));
+  EXPECT_FALSE(cache.Release(StmtHandle(0xb0)));
+}
+
+TEST(DalStmtCache, evict_skips_in_use) {
+  DalStmtCache cache(2);
+  DalStmtCacheKey key_a, key_b, key_c;
+  SQLHANDLE evicted = SQL_NULL_HANDLE;
+  MakeVtnKey(unc::upll::dal::kDalGetSingleRecQT, &key_a);
+  MakeVtnKey(unc::upll::dal::kDalGetMultiRecQT, &key_b);
+  MakeVtnKey(unc::upll::dal::kDalRecExistsQT, &key_c);
+
+  EXPECT_TRUE(cache.Insert(key_a, "A", StmtHandle(0xa0), &evicted));
+  EXPECT_TRUE(cache.Insert(key_b, "B", StmtHandle(0xb0), &evicted));
+
+  // Both handles are in use, C is left to the caller
+  EXPECT_FALSE(cache.Insert(key_c, "C", StmtHandle(0xc0), &evicted));
+  EXPECT_EQ(SQL_NULL_HANDLE, evicted);
+  EXPECT_EQ(0U, cache.get_evictions());
+
+  // Least recently used A is still in use, so B is evicted
+  EXPECT_TRUE(cache.Release(StmtHandle(0xb0)));
+  EXPECT_TRUE(cache.Insert(key_c, "C", StmtHandle(0xc0), &evicted));
+  EXPECT_EQ(StmtHandle(0xb0), evicted);
+  EXPECT_TRUE(cache.Release(StmtHandle(0xa0)));
+}
+
+TEST(DalStmtCache, replace_same_key) {
+  DalStmtCache cache(2);
+  DalStmtCacheKey key;
+  SQLHANDLE evicted = SQL_NULL_HANDLE;
+  MakeVtnKey(unc::upll::dal::kDalGetSingleRecQT, &key);
+
+  EXPECT_TRUE(cache.Insert(key, "A", StmtHandle(0xa0), &evicted));
+  // Handle used by the outer DAL call is kept
+  EXPECT_FALSE(cache.Insert(key, "A2", StmtHandle(0xa1), &evicted));
+  EXPECT_EQ(SQL_NULL_HANDLE, evicted);
+
+  EXPECT_TRUE(cache.Release(StmtHandle(0xa0)));
+  EXPECT_TRUE(cache.Insert(key, "A2", StmtHandle(0xa1), &evicted));
+  EXPECT_EQ(StmtHandle(0xa0), evicted);
+  EXPECT_EQ(1U, cache.get_size());
+  EXPECT_EQ(0U, cache.get_evictions());
+}
+
+TEST(DalStmtCache, erase_and_clear) {
+  DalStmtCache cache(4);
+  DalStmtCacheKey key_a, key_b;
+  SQLHANDLE evicted = SQL_NULL_HANDLE;
+  std::vector<SQLHANDLE> handles;
+  MakeVtnKey(unc::upll::dal::kDalGetSingleRecQT, &key_a);
+  MakeVtnKey(unc::upll::dal::kDalGetMultiRecQT, &key_b);
+
+  EXPECT_TRUE(cache.Insert(key_a, "A", StmtHandle(0xa0), &evicted));
+  EXPECT_TRUE(cache.Insert(key_b, "B", StmtHandle(0xb0), &evicted));
+  EXPECT_TRUE(cache.Erase(StmtHandle(0xa0)));
+  EXPECT_FALSE(cache.Erase(StmtHandle(0xa0)));
+  EXPECT_EQ(1U, cache.get_size());
+
+  cache.Clear(&handles);
+  ASSERT_EQ(1U, handles.size());
+  EXPECT_EQ(StmtHandle(0xb0), handles[0]);
+  EXPECT_EQ(0U, cache.get_size());
+  EXPECT_EQ(SQL_NULL_HANDLE, cache.Acquire(key_b, "B"));
+}
+
+TEST(DalStmtCache, odbc_mgr_reuse_prepared_stmt) {
+  OdbcStub::Reset();
+  DalOdbcMgr *dom = new DalOdbcMgr();
+  dom->dal_conn_handle_ = OdbcStub::NewHandle();
+  dom->stmt_cache_.set_capacity(4);
+  std::string query("SELECT vtn_name FROM ca_vtn_tbl");
+  SQLHANDLE first = SQL_NULL_HANDLE;
+  SQLHANDLE second = SQL_NULL_HANDLE;
+
+  EXPECT_EQ(unc::upll::dal::kDalRcSuccess,
+            dom->ExecuteCachedQuery(unc::upll::dal::kDalGetMultiRecQT,
+                                    UPLL_DT_CANDIDATE,
+                                    schema::table::kDbiVtnTbl,
+                                    &first, &query));
+  dom->ReleaseCachedStmt(first, true);
+  EXPECT_FALSE(OdbcStub::IsFreed(first));
+
+  EXPECT_EQ(unc::upll::dal::kDalRcSuccess,
+            dom->ExecuteCachedQuery(unc::upll::dal::kDalGetMultiRecQT,
+                                    UPLL_DT_CANDIDATE,
+                                    schema::table::kDbiVtnTbl,
+                                    &second, &query));
+  EXPECT_EQ(first, second);
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(second);
+  ASSERT_TRUE(stmt != NULL);
+  EXPECT_EQ(1U, stmt->prepare_count);
+  EXPECT_EQ(2U, stmt->execute_count);
+  EXPECT_EQ(1U, dom->get_stmt_cache_hits());
+
+  // Handle in an unknown state is dropped from the cache
+  dom->ReleaseCachedStmt(second, false);
+  EXPECT_TRUE(OdbcStub::IsFreed(second));
+  EXPECT_EQ(0U, dom->stmt_cache_.get_size());
+  delete dom;
+}
+
+TEST(DalStmtCache, odbc_mgr_disconnect_clears_cache) {
+  OdbcStub::Reset();
+  DalOdbcMgr *dom = new DalOdbcMgr();
+  dom->dal_conn_handle_ = OdbcStub::NewHandle();
+  dom->stmt_cache_.set_capacity(4);
+  std::string query_1("SELECT vtn_name FROM ca_vtn_tbl");
+  std::string query_2("SELECT vtn_name FROM ru_vtn_tbl");
+  SQLHANDLE handle_1 = SQL_NULL_HANDLE;
+  SQLHANDLE handle_2 = SQL_NULL_HANDLE;
+
+  EXPECT_EQ(unc::upll::dal::kDalRcSuccess,
+            dom->ExecuteCachedQuery(unc::upll::dal::kDalGetMultiRecQT,
+                                    UPLL_DT_CANDIDATE,
+                                    schema::table::kDbiVtnTbl,
+                                    &handle_1, &query_1));
+  EXPECT_EQ(unc::upll::dal::kDalRcSuccess,
+            dom->ExecuteCachedQuery(unc::upll::dal::kDalGetMultiRecQT,
+                                    UPLL_DT_RUNNING,
+                                    schema::table::kDbiVtnTbl,
+                                    &handle_2, &query_2));
+  dom->ReleaseCachedStmt(handle_1, true);
+  dom->ReleaseCachedStmt(handle_2, true);
+  EXPECT_EQ(2U, dom->stmt_cache_.get_size());
+
+  // Statements prepared on the closed connection are freed
+  EXPECT_EQ(unc::upll::dal::kDalRcSuccess, dom->DisconnectFromDb());
+  EXPECT_EQ(0U, dom->stmt_cache_.get_size());
+  EXPECT_TRUE(OdbcStub::IsFreed(handle_1));
+  EXPECT_TRUE(OdbcStub::IsFreed(handle_2));
+
+  // Next call on the connection prepares the statement again
+  SQLHANDLE handle_3 = SQL_NULL_HANDLE;
+  uint32_t alloc_count = OdbcStub::alloc_count;
+  EXPECT_EQ(unc::upll::dal::kDalRcSuccess,
+            dom->ExecuteCachedQuery(unc::upll::dal::kDalGetMultiRecQT,
+                                    UPLL_DT_CANDIDATE,
+                                    schema::table::kDbiVtnTbl,
+                                    &handle_3, &query_1));
+  EXPECT_EQ(alloc_count + 1, OdbcStub::alloc_count);
+  EXPECT_EQ(1U, OdbcStub::GetStmt(handle_3)->prepare_count);
+  dom->ReleaseCachedStmt(handle_3, true);
+  delete dom;
+}
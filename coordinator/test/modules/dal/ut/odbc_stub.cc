@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <string.h>
+#include <algorithm>
+#include "odbc_stub.hh"
+
+using unc::upll::dal::ut::OdbcStub;
+using unc::upll::dal::ut::OdbcStubColumn;
+using unc::upll::dal::ut::OdbcStubParam;
+using unc::upll::dal::ut::OdbcStubStmt;
+
+namespace unc {
+namespace upll {
+namespace dal {
+namespace ut {
+
+std::map<SQLHANDLE, OdbcStubStmt> OdbcStub::stmts;
+std::vector<SQLHANDLE> OdbcStub::freed;
+uint32_t OdbcStub::alloc_count = 0;
+SQLINTEGER OdbcStub::fail_stmt_attr = 0;
+std::string OdbcStub::fail_value;
+std::string OdbcStub::nomatch_value;
+std::vector<SQLULEN> OdbcStub::executions;
+uintptr_t OdbcStub::next_handle = 0x1000;
+
+void
+OdbcStub::Reset() {
+  stmts.clear();
+  freed.clear();
+  alloc_count = 0;
+  fail_stmt_attr = 0;
+  fail_value.clear();
+  nomatch_value.clear();
+  executions.clear();
+}
+
+OdbcStubStmt *
+OdbcStub::GetStmt(const SQLHANDLE stmt_handle) {
+  std::map<SQLHANDLE, OdbcStubStmt>::iterator it = stmts.find(stmt_handle);
+  return (it == stmts.end()) ? NULL : &(it->second);
+}
+
+void
+OdbcStub::AddRow(const SQLHANDLE stmt_handle,
+                 const std::vector<std::string> &row) {
+  OdbcStubStmt *stmt = GetStmt(stmt_handle);
+  if (stmt != NULL)
+    stmt->rows.push_back(row);
+}
+
+bool
+OdbcStub::IsFreed(const SQLHANDLE handle) {
+  return (std::find(freed.begin(), freed.end(), handle) != freed.end());
+}
+
+SQLHANDLE
+OdbcStub::NewHandle() {
+  next_handle += 0x10;
+  SQLHANDLE handle = reinterpret_cast<SQLHANDLE>(next_handle);
+  OdbcStubStmt &stmt = stmts[handle];
+  stmt.row_array_size = 1;
+  stmt.row_status = NULL;
+  stmt.rows_fetched = NULL;
+  stmt.next_row = 0;
+  stmt.fetch_count = 0;
+  stmt.prepare_count = 0;
+  stmt.execute_count = 0;
+  stmt.paramset_size = 1;
+  stmt.param_status = NULL;
+  stmt.row_count = 0;
+  alloc_count++;
+  return handle;
+}
+
+// true, if a character parameter of the parameter set starts with prefix
+static bool
+ParamSetHasPrefix(const OdbcStubStmt *stmt, const SQLULEN row,
+                  const std::string &prefix) {
+  if (prefix.empty())
+    return false;
+  for (std::map<SQLUSMALLINT, OdbcStubParam>::const_iterator it =
+       stmt->params.begin(); it != stmt->params.end(); ++it) {
+    const OdbcStubParam &param = it->second;
+    if (param.c_type != SQL_C_CHAR)
+      continue;
+    const char *value = static_cast<const char *>(param.value) +
+                        row * param.buffer_len;
+    if (strncmp(value, prefix.c_str(), prefix.size()) == 0)
+      return true;
+  }
+  return false;
+}
+
+// Executes every parameter set and fills the parameter status array
+SQLRETURN
+OdbcStub::Execute(OdbcStubStmt *stmt) {
+  SQLULEN paramset_size = (stmt->paramset_size > 0) ? stmt->paramset_size : 1;
+  bool failed = false;
+
+  stmt->execute_count++;
+  stmt->next_row = 0;
+  stmt->row_count = 0;
+  stmt->diag_state.clear();
+  executions.push_back(paramset_size);
+  for (SQLULEN row = 0; row < paramset_size; row++) {
+    SQLUSMALLINT status = SQL_PARAM_SUCCESS;
+    if (stmt->query.compare(0, 6, "SELECT") != 0 &&
+        ParamSetHasPrefix(stmt, row, fail_value)) {
+      status = SQL_PARAM_ERROR;
+      failed = true;
+    } else if (!ParamSetHasPrefix(stmt, row, nomatch_value)) {
+      stmt->row_count++;
+    }
+    if (stmt->param_status != NULL)
+      stmt->param_status[row] = status;
+  }
+  if (failed) {
+    // Unique violation
+    stmt->diag_state = "23505";
+    return (paramset_size > 1) ? SQL_SUCCESS_WITH_INFO : SQL_ERROR;
+  }
+  if (paramset_size == 1 && stmt->row_count == 0 && !stmt->params.empty())
+    return SQL_NO_DATA;
+  return SQL_SUCCESS;
+}
+
+}  // namespace ut
+}  // namespace dal
+}  // namespace upll
+}  // namespace unc
+
+extern "C" {
+
+SQLRETURN SQLAllocHandle(SQLSMALLINT HandleType, SQLHANDLE InputHandle,
+                         SQLHANDLE *OutputHandle) {
+  *OutputHandle = OdbcStub::NewHandle();
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) {
+  OdbcStub::freed.push_back(Handle);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  if (Option == SQL_UNBIND)
+    stmt->columns.clear();
+  else if (Option == SQL_RESET_PARAMS)
+    stmt->params.clear();
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetEnvAttr(SQLHENV EnvironmentHandle, SQLINTEGER Attribute,
+                        SQLPOINTER Value, SQLINTEGER StringLength) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute,
+                            SQLPOINTER Value, SQLINTEGER StringLength) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd,
+                           SQLCHAR *szConnStrIn, SQLSMALLINT cbConnStrIn,
+                           SQLCHAR *szConnStrOut, SQLSMALLINT cbConnStrOutMax,
+                           SQLSMALLINT *pcbConnStrOut,
+                           SQLUSMALLINT fDriverCompletion) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLDisconnect(SQLHDBC ConnectionHandle) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle,
+                     SQLSMALLINT CompletionType) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetStmtAttr(SQLHSTMT StatementHandle, SQLINTEGER Attribute,
+                         SQLPOINTER Value, SQLINTEGER StringLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  if (Attribute == OdbcStub::fail_stmt_attr)
+    return SQL_ERROR;
+  switch (Attribute) {
+    case SQL_ATTR_ROW_ARRAY_SIZE:
+      stmt->row_array_size = reinterpret_cast<SQLULEN>(Value);
+      break;
+    case SQL_ATTR_ROW_STATUS_PTR:
+      stmt->row_status = reinterpret_cast<SQLUSMALLINT *>(Value);
+      break;
+    case SQL_ATTR_ROWS_FETCHED_PTR:
+      stmt->rows_fetched = reinterpret_cast<SQLULEN *>(Value);
+      break;
+    case SQL_ATTR_PARAMSET_SIZE:
+      stmt->paramset_size = reinterpret_cast<SQLULEN>(Value);
+      break;
+    case SQL_ATTR_PARAM_STATUS_PTR:
+      stmt->param_status = reinterpret_cast<SQLUSMALLINT *>(Value);
+      break;
+    default:
+      break;
+  }
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber,
+                     SQLSMALLINT TargetType, SQLPOINTER TargetValue,
+                     SQLLEN BufferLength, SQLLEN *StrLen_or_Ind) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  OdbcStubColumn &col = stmt->columns[ColumnNumber];
+  col.target_type = TargetType;
+  col.target = TargetValue;
+  col.buffer_len = BufferLength;
+  col.len_ind = StrLen_or_Ind;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLBindParameter(SQLHSTMT hstmt, SQLUSMALLINT ipar,
+                           SQLSMALLINT fParamType, SQLSMALLINT fCType,
+                           SQLSMALLINT fSqlType, SQLULEN cbColDef,
+                           SQLSMALLINT ibScale, SQLPOINTER rgbValue,
+                           SQLLEN cbValueMax, SQLLEN *pcbValue) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(hstmt);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  OdbcStubParam &param = stmt->params[ipar];
+  param.c_type = fCType;
+  param.value = rgbValue;
+  param.buffer_len = cbValueMax;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLPrepare(SQLHSTMT StatementHandle, SQLCHAR *StatementText,
+                     SQLINTEGER TextLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  stmt->query = reinterpret_cast<char *>(StatementText);
+  stmt->prepare_count++;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLExecute(SQLHSTMT StatementHandle) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  return OdbcStub::Execute(stmt);
+}
+
+SQLRETURN SQLExecDirect(SQLHSTMT StatementHandle, SQLCHAR *StatementText,
+                        SQLINTEGER TextLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  stmt->query = reinterpret_cast<char *>(StatementText);
+  return OdbcStub::Execute(stmt);
+}
+
+// Fills up to row_array_size rows into the column-wise bound buffers
+SQLRETURN SQLFetch(SQLHSTMT StatementHandle) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  stmt->fetch_count++;
+
+  SQLULEN array_size = (stmt->row_array_size > 0) ? stmt->row_array_size : 1;
+  SQLULEN count = 0;
+  while (count < array_size && stmt->next_row < stmt->rows.size()) {
+    const std::vector<std::string> &row = stmt->rows[stmt->next_row++];
+    for (std::map<SQLUSMALLINT, OdbcStubColumn>::iterator it =
+         stmt->columns.begin(); it != stmt->columns.end(); ++it) {
+      if (it->first == 0 || it->first > row.size())
+        continue;
+      const std::string &value = row[it->first - 1];
+      OdbcStubColumn &col = it->second;
+      // Buffer length bounds only the variable length types
+      size_t copy_size = value.size();
+      if (col.target_type == SQL_C_CHAR || col.target_type == SQL_C_BINARY)
+        copy_size = std::min(copy_size, static_cast<size_t>(col.buffer_len));
+      memcpy(static_cast<uint8_t *>(col.target) + count * col.buffer_len,
+             value.data(), copy_size);
+      if (col.len_ind != NULL)
+        col.len_ind[count] = static_cast<SQLLEN>(value.size());
+    }
+    if (stmt->row_status != NULL)
+      stmt->row_status[count] = SQL_ROW_SUCCESS;
+    count++;
+  }
+  if (stmt->rows_fetched != NULL)
+    *(stmt->rows_fetched) = count;
+  return (count == 0) ? SQL_NO_DATA : SQL_SUCCESS;
+}
+
+SQLRETURN SQLCloseCursor(SQLHSTMT StatementHandle) {
+  return (OdbcStub::GetStmt(StatementHandle) == NULL) ? SQL_INVALID_HANDLE :
+                                                        SQL_SUCCESS;
+}
+
+SQLRETURN SQLRowCount(SQLHSTMT StatementHandle, SQLLEN *RowCount) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  *RowCount = stmt->row_count;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetDiagRec(SQLSMALLINT HandleType, SQLHANDLE Handle,
+                        SQLSMALLINT RecNumber, SQLCHAR *Sqlstate,
+                        SQLINTEGER *NativeError, SQLCHAR *MessageText,
+                        SQLSMALLINT BufferLength, SQLSMALLINT *TextLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(Handle);
+  if (stmt == NULL || RecNumber != 1 || stmt->diag_state.empty())
+    return SQL_NO_DATA;
+  memcpy(Sqlstate, stmt->diag_state.c_str(), stmt->diag_state.size() + 1);
+  if (NativeError != NULL)
+    *NativeError = 0;
+  if (MessageText != NULL && BufferLength > 0)
+    MessageText[0] = '\0';
+  if (TextLength != NULL)
+    *TextLength = 0;
+  return SQL_SUCCESS;
+}
+
+}  // extern "C"
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * odbc_stub.hh
+ *   ODBC API stub used by the DAL unit tests. Statement handles keep the
+ *   column bindings and attributes set by DAL, and SQLFetch serves a
+ *   result set given by the test into the bound buffers. Executions scan
+ *   the bound parameter arrays row by row to report per-row status.
+ */
+
+#ifndef __DAL_UT_ODBC_STUB_HH__
+#define __DAL_UT_ODBC_STUB_HH__
+
+#include <sql.h>
+#include <sqlext.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace unc {
+namespace upll {
+namespace dal {
+namespace ut {
+
+struct OdbcStubColumn {
+  SQLSMALLINT target_type;
+  SQLPOINTER target;
+  SQLLEN buffer_len;
+  SQLLEN *len_ind;
+};
+
+struct OdbcStubParam {
+  SQLSMALLINT c_type;
+  SQLPOINTER value;
+  SQLLEN buffer_len;
+};
+
+struct OdbcStubStmt {
+  std::string query;
+  std::map<SQLUSMALLINT, OdbcStubColumn> columns;
+  SQLULEN row_array_size;
+  SQLUSMALLINT *row_status;
+  SQLULEN *rows_fetched;
+  std::map<SQLUSMALLINT, OdbcStubParam> params;
+  SQLULEN paramset_size;
+  SQLUSMALLINT *param_status;
+  // Rows affected by the last execution and its SQLSTATE, if failed
+  SQLLEN row_count;
+  std::string diag_state;
+  // Result set served by SQLFetch, one raw value per bound column
+  std::vector<std::vector<std::string> > rows;
+  size_t next_row;
+  uint32_t fetch_count;
+  uint32_t prepare_count;
+  uint32_t execute_count;
+};
+
+class OdbcStub {
+  public:
+    // Forgets all the handles and results
+    static void Reset();
+
+    // Statement state of a handle allocated by SQLAllocHandle
+    static OdbcStubStmt *GetStmt(const SQLHANDLE stmt_handle);
+
+    // Appends a row to the result set of the statement
+    static void AddRow(const SQLHANDLE stmt_handle,
+                       const std::vector<std::string> &row);
+
+    // true, if SQLFreeHandle was called for the handle
+    static bool IsFreed(const SQLHANDLE handle);
+
+    static SQLHANDLE NewHandle();
+
+    // Runs the statement for each bound parameter set
+    static SQLRETURN Execute(OdbcStubStmt *stmt);
+
+    static std::map<SQLHANDLE, OdbcStubStmt> stmts;
+    static std::vector<SQLHANDLE> freed;
+    static uint32_t alloc_count;
+    // SQLSetStmtAttr fails for this attribute, 0 if none
+    static SQLINTEGER fail_stmt_attr;
+    // Writes of parameter sets having a character parameter with this
+    // prefix fail with unique violation, or match no record for
+    // nomatch_value
+    static std::string fail_value;
+    static std::string nomatch_value;
+    // Parameter set size of each execution, in order
+    static std::vector<SQLULEN> executions;
+    static uintptr_t next_handle;
+};
+
+}  // namespace ut
+}  // namespace dal
+}  // namespace upll
+}  // namespace unc
+#endif  // __DAL_UT_ODBC_STUB_HH__
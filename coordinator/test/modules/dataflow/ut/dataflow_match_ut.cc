@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <stdlib.h>
+#include <string.h>
+#include <set>
+#include <vector>
+#include "uncxx/dataflow.hh"
+
+using namespace unc::dataflow;
+
+typedef map<UncDataflowFlowMatchType, void *> MatchMap;
+
+static const uint32_t kNumFlows = 200;
+static const uint32_t kNumPrevs = 500;
+static const uint32_t kNumPairs = 20000;
+
+/*
+ * Comparison of one field as DataflowCmn::check_match_condition did it
+ * before DataflowMatch, for the fields which have a mask.
+ */
+static bool OldDlAddr(val_df_flow_match_dl_addr_t *curr,
+                      val_df_flow_match_dl_addr_t *prev) {
+  if (curr->v_mask == UNC_MATCH_MASK_VALID) {
+    if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+      return DataflowUtil::checkMacAddress(curr->dl_addr, curr->dl_addr_mask,
+                                           prev->dl_addr, prev->dl_addr_mask);
+    }
+    return DataflowUtil::checkMacAddress(curr->dl_addr, curr->dl_addr_mask,
+                                         prev->dl_addr);
+  }
+  if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+    return DataflowUtil::checkMacAddress(prev->dl_addr, prev->dl_addr_mask,
+                                         curr->dl_addr);
+  }
+  return memcmp(curr->dl_addr, prev->dl_addr, sizeof(prev->dl_addr)) == 0;
+}
+
+static bool OldIpv4(val_df_flow_match_ipv4_addr_t *curr,
+                    val_df_flow_match_ipv4_addr_t *prev) {
+  if (curr->v_mask == UNC_MATCH_MASK_VALID) {
+    if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+      return DataflowUtil::checkIPv4Address(curr->ipv4_addr,
+                                            curr->ipv4_addr_mask,
+                                            prev->ipv4_addr,
+                                            prev->ipv4_addr_mask);
+    }
+    return DataflowUtil::checkIPv4Address(curr->ipv4_addr,
+                                          curr->ipv4_addr_mask,
+                                          prev->ipv4_addr);
+  }
+  if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+    return DataflowUtil::checkIPv4Address(prev->ipv4_addr,
+                                          prev->ipv4_addr_mask,
+                                          curr->ipv4_addr);
+  }
+  return curr->ipv4_addr.s_addr == prev->ipv4_addr.s_addr;
+}
+
+static bool OldIpv6(val_df_flow_match_ipv6_addr_t *curr,
+                    val_df_flow_match_ipv6_addr_t *prev) {
+  if (curr->v_mask == UNC_MATCH_MASK_VALID) {
+    if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+      return DataflowUtil::checkIPv6Address(curr->ipv6_addr,
+                                            curr->ipv6_addr_mask,
+                                            prev->ipv6_addr,
+                                            prev->ipv6_addr_mask);
+    }
+    return DataflowUtil::checkIPv6Address(curr->ipv6_addr,
+                                          curr->ipv6_addr_mask,
+                                          prev->ipv6_addr);
+  }
+  if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+    return DataflowUtil::checkIPv6Address(prev->ipv6_addr,
+                                          prev->ipv6_addr_mask,
+                                          curr->ipv6_addr);
+  }
+  return memcmp(curr->ipv6_addr.s6_addr, prev->ipv6_addr.s6_addr,
+                sizeof(prev->ipv6_addr.s6_addr)) == 0;
+}
+
+static bool OldTpPort(val_df_flow_match_tp_port_t *curr,
+                      val_df_flow_match_tp_port_t *prev) {
+  if (curr->v_mask == UNC_MATCH_MASK_VALID) {
+    if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+      return DataflowUtil::checkIPv4Address(curr->tp_port, curr->tp_port_mask,
+                                            prev->tp_port, prev->tp_port_mask);
+    }
+    return DataflowUtil::checkIPv4Address(curr->tp_port, curr->tp_port_mask,
+                                          prev->tp_port);
+  }
+  if (prev->v_mask == UNC_MATCH_MASK_VALID) {
+    return DataflowUtil::checkIPv4Address(prev->tp_port, prev->tp_port_mask,
+                                          curr->tp_port);
+  }
+  return curr->tp_port == prev->tp_port;
+}
+
+/*
+ * The old check_match_condition: the fields of 'prev' absent from 'curr',
+ * or without a value in 'prev', match. The old code dereferenced a field
+ * of 'curr' without a value; DataflowMatch takes it as ANY, and so does
+ * this reference.
+ */
+static bool OldMatches(const MatchMap &curr, const MatchMap &prev) {
+  MatchMap::const_iterator iter;
+  for (iter = prev.begin(); iter != prev.end(); iter++) {
+    MatchMap::const_iterator found = curr.find(iter->first);
+    if (found == curr.end() || found->second == NULL || iter->second == NULL)
+      continue;
+    void *c = found->second;
+    void *p = iter->second;
+    bool ret = true;
+    switch (iter->first) {
+      case UNC_MATCH_DL_DST:
+        ret = OldDlAddr(reinterpret_cast<val_df_flow_match_dl_addr_t *>(c),
+                        reinterpret_cast<val_df_flow_match_dl_addr_t *>(p));
+        break;
+      case UNC_MATCH_DL_TYPE:
+        ret = reinterpret_cast<val_df_flow_match_dl_type_t *>(c)->dl_type ==
+            reinterpret_cast<val_df_flow_match_dl_type_t *>(p)->dl_type;
+        break;
+      case UNC_MATCH_VLAN_PCP:
+        ret = reinterpret_cast<val_df_flow_match_vlan_pcp_t *>(c)->vlan_pcp ==
+            reinterpret_cast<val_df_flow_match_vlan_pcp_t *>(p)->vlan_pcp;
+        break;
+      case UNC_MATCH_IP_TOS:
+        ret = reinterpret_cast<val_df_flow_match_ip_tos_t *>(c)->ip_tos ==
+            reinterpret_cast<val_df_flow_match_ip_tos_t *>(p)->ip_tos;
+        break;
+      case UNC_MATCH_IP_PROTO:
+        ret = reinterpret_cast<val_df_flow_match_ip_proto_t *>(c)->ip_proto ==
+            reinterpret_cast<val_df_flow_match_ip_proto_t *>(p)->ip_proto;
+        break;
+      case UNC_MATCH_IPV4_SRC:
+      case UNC_MATCH_IPV4_DST:
+        ret = OldIpv4(reinterpret_cast<val_df_flow_match_ipv4_addr_t *>(c),
+                      reinterpret_cast<val_df_flow_match_ipv4_addr_t *>(p));
+        break;
+      case UNC_MATCH_IPV6_SRC:
+      case UNC_MATCH_IPV6_DST:
+        ret = OldIpv6(reinterpret_cast<val_df_flow_match_ipv6_addr_t *>(c),
+                      reinterpret_cast<val_df_flow_match_ipv6_addr_t *>(p));
+        break;
+      case UNC_MATCH_TP_SRC:
+      case UNC_MATCH_TP_DST:
+        ret = OldTpPort(reinterpret_cast<val_df_flow_match_tp_port_t *>(c),
+                        reinterpret_cast<val_df_flow_match_tp_port_t *>(p));
+        break;
+      default:
+        // UNC_MATCH_IN_PORT, UNC_MATCH_DL_SRC and UNC_MATCH_VLAN_ID
+        break;
+    }
+    if (!ret)
+      return false;
+  }
+  return true;
+}
+
+// Zeroed value freed by ::operator delete, as the values read from IPC.
+template <typename T>
+static T *NewField() {
+  T *st = reinterpret_cast<T *>(::operator new(sizeof(T)));
+  memset(st, 0, sizeof(T));
+  return st;
+}
+
+static void FreeMatches(MatchMap *matches) {
+  MatchMap::iterator iter;
+  for (iter = matches->begin(); iter != matches->end(); iter++) {
+    ::operator delete(iter->second);
+  }
+  matches->clear();
+}
+
+static val_df_flow_match_ipv4_addr_t *NewIpv4(uint32_t addr, uint32_t mask,
+                                              bool masked) {
+  val_df_flow_match_ipv4_addr_t *st = NewField<val_df_flow_match_ipv4_addr_t>();
+  st->ipv4_addr.s_addr = htonl(addr);
+  st->ipv4_addr_mask.s_addr = htonl(mask);
+  st->v_mask = masked ? UNC_MATCH_MASK_VALID : 0;
+  return st;
+}
+
+static val_df_flow_match_dl_addr_t *NewDlAddr(uint8_t last, uint8_t mask_last,
+                                              bool masked) {
+  val_df_flow_match_dl_addr_t *st = NewField<val_df_flow_match_dl_addr_t>();
+  st->dl_addr[5] = last;
+  memset(st->dl_addr_mask, 0xFF, sizeof(st->dl_addr_mask));
+  st->dl_addr_mask[5] = mask_last;
+  st->v_mask = masked ? UNC_MATCH_MASK_VALID : 0;
+  return st;
+}
+
+static val_df_flow_match_ipv6_addr_t *NewIpv6(uint8_t first, uint8_t last,
+                                              uint32_t prefix, bool masked) {
+  val_df_flow_match_ipv6_addr_t *st = NewField<val_df_flow_match_ipv6_addr_t>();
+  st->ipv6_addr.s6_addr[0] = first;
+  st->ipv6_addr.s6_addr[15] = last;
+  for (uint32_t bit = 0; bit < prefix; bit++) {
+    st->ipv6_addr_mask.s6_addr[bit / 8] |= (0x80 >> (bit % 8));
+  }
+  st->v_mask = masked ? UNC_MATCH_MASK_VALID : 0;
+  return st;
+}
+
+/*
+ * Value and mask of 'len' bytes from a small domain, so that random
+ * matches often agree: the first and the last bytes vary, and the mask
+ * may clear them.
+ */
+static void FillBytes(unsigned int *seed, uint8_t *value, uint8_t *mask,
+                      size_t len) {
+  static const uint8_t kMaskLast[] = {0xFF, 0xFE, 0xFC, 0x00};
+  memset(value, 0, len);
+  value[0] = rand_r(seed) % 2;
+  value[len - 1] = rand_r(seed) % 4;
+  memset(mask, 0xFF, len);
+  mask[0] = (rand_r(seed) % 4 == 0) ? 0x00 : 0xFF;
+  mask[len - 1] = kMaskLast[rand_r(seed) % PFC_ARRAY_CAPACITY(kMaskLast)];
+}
+
+/*
+ * Add a random field of 'type' to 'matches': absent, without a value,
+ * strict or masked. A strict field keeps a random mask, which must be
+ * ignored.
+ */
+static void AddRandomField(unsigned int *seed, UncDataflowFlowMatchType type,
+                           MatchMap *matches) {
+  uint32_t kind = rand_r(seed) % 10;
+  if (kind < 4)
+    return;
+  if (kind == 4) {
+    (*matches)[type] = NULL;
+    return;
+  }
+  uint8_t v_mask = (kind >= 8) ? UNC_MATCH_MASK_VALID : 0;
+  void *value = NULL;
+  switch (type) {
+    case UNC_MATCH_IN_PORT:
+    {
+      val_df_flow_match_in_port_t *st =
+          NewField<val_df_flow_match_in_port_t>();
+      st->in_port = rand_r(seed) % 3;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_DL_SRC:
+    case UNC_MATCH_DL_DST:
+    {
+      val_df_flow_match_dl_addr_t *st =
+          NewField<val_df_flow_match_dl_addr_t>();
+      FillBytes(seed, st->dl_addr, st->dl_addr_mask, sizeof(st->dl_addr));
+      st->v_mask = v_mask;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_DL_TYPE:
+    {
+      val_df_flow_match_dl_type_t *st =
+          NewField<val_df_flow_match_dl_type_t>();
+      st->dl_type = 0x0800 + rand_r(seed) % 3;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_VLAN_ID:
+    {
+      val_df_flow_match_vlan_id_t *st =
+          NewField<val_df_flow_match_vlan_id_t>();
+      st->vlan_id = rand_r(seed) % 3;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_VLAN_PCP:
+    {
+      val_df_flow_match_vlan_pcp_t *st =
+          NewField<val_df_flow_match_vlan_pcp_t>();
+      st->vlan_pcp = rand_r(seed) % 3;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_IP_TOS:
+    {
+      val_df_flow_match_ip_tos_t *st = NewField<val_df_flow_match_ip_tos_t>();
+      st->ip_tos = rand_r(seed) % 3;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_IP_PROTO:
+    {
+      val_df_flow_match_ip_proto_t *st =
+          NewField<val_df_flow_match_ip_proto_t>();
+      st->ip_proto = rand_r(seed) % 3;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_IPV4_SRC:
+    case UNC_MATCH_IPV4_DST:
+    {
+      val_df_flow_match_ipv4_addr_t *st =
+          NewField<val_df_flow_match_ipv4_addr_t>();
+      FillBytes(seed, reinterpret_cast<uint8_t *>(&st->ipv4_addr),
+                reinterpret_cast<uint8_t *>(&st->ipv4_addr_mask),
+                sizeof(st->ipv4_addr));
+      st->v_mask = v_mask;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_IPV6_SRC:
+    case UNC_MATCH_IPV6_DST:
+    {
+      val_df_flow_match_ipv6_addr_t *st =
+          NewField<val_df_flow_match_ipv6_addr_t>();
+      FillBytes(seed, st->ipv6_addr.s6_addr, st->ipv6_addr_mask.s6_addr,
+                sizeof(st->ipv6_addr.s6_addr));
+      st->v_mask = v_mask;
+      value = st;
+      break;
+    }
+    case UNC_MATCH_TP_SRC:
+    case UNC_MATCH_TP_DST:
+    {
+      val_df_flow_match_tp_port_t *st =
+          NewField<val_df_flow_match_tp_port_t>();
+      FillBytes(seed, reinterpret_cast<uint8_t *>(&st->tp_port),
+                reinterpret_cast<uint8_t *>(&st->tp_port_mask),
+                sizeof(st->tp_port));
+      st->v_mask = v_mask;
+      value = st;
+      break;
+    }
+    default:
+      return;
+  }
+  (*matches)[type] = value;
+}
+
+// Fill 'matches' with random fields, 'fields' of them at most.
+static void RandomMatches(unsigned int *seed, uint32_t fields,
+                          MatchMap *matches) {
+  for (uint32_t i = 0; i < fields; i++) {
+    UncDataflowFlowMatchType type = static_cast<UncDataflowFlowMatchType>(
+        rand_r(seed) % (UNC_MATCH_TP_DST + 1));
+    if (matches->find(type) == matches->end())
+      AddRandomField(seed, type, matches);
+  }
+}
+
+class DataflowMatchTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+      seed_ = 20150701;
+    }
+
+    virtual void TearDown() {
+      FreeMatches(&curr_);
+      FreeMatches(&prev_);
+      for (uint32_t i = 0; i < flows_.size(); i++) {
+        delete flows_[i];
+      }
+      flows_.clear();
+      for (uint32_t i = 0; i < prevs_.size(); i++) {
+        FreeMatches(&prevs_[i]);
+      }
+      prevs_.clear();
+    }
+
+    bool NewMatches() {
+      return DataflowMatch(curr_).Matches(DataflowMatch(prev_));
+    }
+
+    void AddRandomFlows() {
+      for (uint32_t i = 0; i < kNumFlows; i++) {
+        DataflowDetail *flow = new DataflowDetail(kidx_val_df_data_flow_cmn);
+        RandomMatches(&seed_, 6, &flow->matches);
+        flows_.push_back(flow);
+      }
+      prevs_.resize(kNumPrevs);
+      for (uint32_t i = 0; i < kNumPrevs; i++) {
+        RandomMatches(&seed_, 6, &prevs_[i]);
+      }
+    }
+
+    /*
+     * Check that the candidates of Lookup are in ascending order, and that
+     * the candidates which match are the flows the old logic matches.
+     * Returns the number of matches found.
+     */
+    uint32_t CheckLookup(const DataflowFlowIndex &index) {
+      uint32_t found = 0;
+      for (uint32_t i = 0; i < prevs_.size(); i++) {
+        DataflowMatch prev(prevs_[i]);
+        vector<uint32_t> positions;
+        index.Lookup(prev, &positions);
+        vector<uint32_t> matched;
+        for (uint32_t j = 0; j < positions.size(); j++) {
+          if (j > 0) {
+            EXPECT_LT(positions[j - 1], positions[j]);
+          }
+          if (index.Matches(positions[j], prev))
+            matched.push_back(positions[j]);
+        }
+        vector<uint32_t> expected;
+        for (uint32_t pos = 0; pos < flows_.size(); pos++) {
+          if (OldMatches(flows_[pos]->matches, prevs_[i]))
+            expected.push_back(pos);
+        }
+        EXPECT_EQ(expected, matched) << "prev " << i;
+        found += matched.size();
+      }
+      return found;
+    }
+
+    unsigned int seed_;
+    MatchMap curr_;
+    MatchMap prev_;
+    vector<DataflowDetail *> flows_;
+    vector<MatchMap> prevs_;
+};
+
+TEST_F(DataflowMatchTest, StrictVsMasked) {
+  // 10.0.0.5 in 10.0.0.4/30
+  curr_[UNC_MATCH_IPV4_DST] = NewIpv4(0x0A000005, 0, false);
+  prev_[UNC_MATCH_IPV4_DST] = NewIpv4(0x0A000004, 0xFFFFFFFC, true);
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+
+  // 10.0.0.8 not in 10.0.0.4/30
+  FreeMatches(&curr_);
+  curr_[UNC_MATCH_IPV4_DST] = NewIpv4(0x0A000008, 0, false);
+  EXPECT_FALSE(OldMatches(curr_, prev_));
+  EXPECT_FALSE(NewMatches());
+
+  // Masked current flow, strict previous flow
+  FreeMatches(&curr_);
+  FreeMatches(&prev_);
+  curr_[UNC_MATCH_DL_DST] = NewDlAddr(0x04, 0xFE, true);
+  prev_[UNC_MATCH_DL_DST] = NewDlAddr(0x05, 0x00, false);
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+
+  FreeMatches(&prev_);
+  prev_[UNC_MATCH_DL_DST] = NewDlAddr(0x06, 0x00, false);
+  EXPECT_FALSE(OldMatches(curr_, prev_));
+  EXPECT_FALSE(NewMatches());
+}
+
+TEST_F(DataflowMatchTest, StrictIgnoresMask) {
+  // The mask of a value without v_mask is not used.
+  curr_[UNC_MATCH_DL_DST] = NewDlAddr(0x04, 0x00, false);
+  prev_[UNC_MATCH_DL_DST] = NewDlAddr(0x05, 0x00, false);
+  EXPECT_FALSE(OldMatches(curr_, prev_));
+  EXPECT_FALSE(NewMatches());
+}
+
+TEST_F(DataflowMatchTest, MaskedVsMasked) {
+  // 2001::/16 and 2001:0:0:0:0:0:0:1/128 overlap with the shorter mask
+  curr_[UNC_MATCH_IPV6_SRC] = NewIpv6(0x20, 0x00, 16, true);
+  prev_[UNC_MATCH_IPV6_SRC] = NewIpv6(0x20, 0x01, 128, true);
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+
+  // 3001::/16 does not
+  FreeMatches(&curr_);
+  curr_[UNC_MATCH_IPV6_SRC] = NewIpv6(0x30, 0x00, 16, true);
+  EXPECT_FALSE(OldMatches(curr_, prev_));
+  EXPECT_FALSE(NewMatches());
+
+  // Masks without a common bit match anything
+  FreeMatches(&curr_);
+  FreeMatches(&prev_);
+  curr_[UNC_MATCH_IPV4_SRC] = NewIpv4(0x0A000000, 0xFF000000, true);
+  prev_[UNC_MATCH_IPV4_SRC] = NewIpv4(0x0B000001, 0x000000FF, true);
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+}
+
+TEST_F(DataflowMatchTest, AbsentAndNull) {
+  prev_[UNC_MATCH_IPV4_DST] = NewIpv4(0x0A000004, 0, false);
+  // Absent from the current flow
+  curr_[UNC_MATCH_IPV4_SRC] = NewIpv4(0x0A000008, 0, false);
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+
+  // Without a value in the current flow
+  curr_[UNC_MATCH_IPV4_DST] = NULL;
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+
+  // Without a value in the previous flow
+  FreeMatches(&curr_);
+  FreeMatches(&prev_);
+  curr_[UNC_MATCH_IPV4_DST] = NewIpv4(0x0A000008, 0, false);
+  prev_[UNC_MATCH_IPV4_DST] = NULL;
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+}
+
+TEST_F(DataflowMatchTest, IgnoredFields) {
+  val_df_flow_match_in_port_t *in_port =
+      NewField<val_df_flow_match_in_port_t>();
+  in_port->in_port = 1;
+  curr_[UNC_MATCH_IN_PORT] = in_port;
+  curr_[UNC_MATCH_DL_SRC] = NewDlAddr(0x01, 0xFF, false);
+  val_df_flow_match_vlan_id_t *vlan_id =
+      NewField<val_df_flow_match_vlan_id_t>();
+  vlan_id->vlan_id = 10;
+  curr_[UNC_MATCH_VLAN_ID] = vlan_id;
+
+  in_port = NewField<val_df_flow_match_in_port_t>();
+  in_port->in_port = 2;
+  prev_[UNC_MATCH_IN_PORT] = in_port;
+  prev_[UNC_MATCH_DL_SRC] = NewDlAddr(0x02, 0xFF, false);
+  vlan_id = NewField<val_df_flow_match_vlan_id_t>();
+  vlan_id->vlan_id = 20;
+  prev_[UNC_MATCH_VLAN_ID] = vlan_id;
+
+  EXPECT_TRUE(OldMatches(curr_, prev_));
+  EXPECT_TRUE(NewMatches());
+}
+
+TEST_F(DataflowMatchTest, Matches_SameAsOld) {
+  uint32_t matched = 0;
+  for (uint32_t i = 0; i < kNumPairs; i++) {
+    RandomMatches(&seed_, 6, &curr_);
+    RandomMatches(&seed_, 6, &prev_);
+    bool old_ret = OldMatches(curr_, prev_);
+    ASSERT_EQ(old_ret, NewMatches()) << "pair " << i;
+    if (old_ret)
+      matched++;
+    FreeMatches(&curr_);
+    FreeMatches(&prev_);
+  }
+  // Both results must be covered.
+  EXPECT_LT(0U, matched);
+  EXPECT_GT(kNumPairs, matched);
+}
+
+TEST_F(DataflowMatchTest, Lookup_SameAsOld) {
+  AddRandomFlows();
+  DataflowFlowIndex index(flows_);
+  uint32_t found = CheckLookup(index);
+  EXPECT_LT(0U, found);
+}
+
+TEST_F(DataflowMatchTest, Lookup_BucketCollisions) {
+  AddRandomFlows();
+  DataflowFlowIndex index(flows_);
+  // Make every strict value of a field collide with all the others: each
+  // bucket holds the flows of all the buckets of the field.
+  map<UncDataflowFlowMatchType, DataflowFlowIndex::FieldIndex>::iterator
+      field;
+  for (field = index.fields_.begin(); field != index.fields_.end();
+       field++) {
+    map<uint64_t, vector<uint32_t> > &buckets = field->second.buckets;
+    map<uint64_t, vector<uint32_t> >::iterator bucket;
+    std::set<uint32_t> all;
+    for (bucket = buckets.begin(); bucket != buckets.end(); bucket++) {
+      all.insert(bucket->second.begin(), bucket->second.end());
+    }
+    for (bucket = buckets.begin(); bucket != buckets.end(); bucket++) {
+      bucket->second.assign(all.begin(), all.end());
+    }
+  }
+  uint32_t found = CheckLookup(index);
+  EXPECT_LT(0U, found);
+}
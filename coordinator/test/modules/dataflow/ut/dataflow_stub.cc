@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * Minimal DataflowDetail for the unit tests of dataflow_match.cc.
+ * Only 'matches' is used, and its values are freed as dataflow.cc does.
+ */
+
+#include "uncxx/dataflow.hh"
+
+using namespace unc::dataflow;
+
+DataflowDetail::DataflowDetail(IpctStructNum df_type,
+                               unc_keytype_ctrtype_t ctr_type)
+    : df_common(NULL), vtn_df_common(NULL), ckv_egress(NULL),
+      flow_traversed(0), is_flow_redirect(false), is_flow_drop(false),
+      st_num_(df_type) {
+}
+
+DataflowDetail::~DataflowDetail() {
+  map<UncDataflowFlowMatchType, void *>::iterator iter;
+  for (iter = matches.begin(); iter != matches.end(); iter++) {
+    ::operator delete(iter->second);
+  }
+  matches.clear();
+}
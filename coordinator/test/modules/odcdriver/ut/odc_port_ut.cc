@@ -1282,3 +1282,78 @@ TEST(odcdriver_port, test_port_resp_parent_sw_NULL) {
   unc::driver::VtnDrvIntf::stub_unloadVtnDrvModule();
 }
 
+
+TEST(odcdriver_port, test_port_fingerprint) {
+  key_ctr_t key_ctr;
+  val_ctr_t val_ctr;
+  unc::restjson::ConfFileValues_t conf_values;
+  memset(&key_ctr, 0, sizeof(key_ctr_t));
+  memset(&val_ctr,  0, sizeof(val_ctr_t));
+
+  unc::driver::VtnDrvIntf::stub_loadVtnDrvModule();
+  key_switch_t key_switch;
+  memset(&key_switch, 0, sizeof(key_switch_t));
+  std::string switch_id = "openflow:2";
+  strncpy(reinterpret_cast<char*> (key_switch.switch_id), switch_id.c_str(),
+          strlen(switch_id.c_str()));
+  std::string SWITCH_RESP  = "172.16.0.20";
+  std::string PORT_RESP  = "172.16.0.23";
+  std::string PORT_RESP_UPDATE  = "172.16.0.24";
+  inet_aton(SWITCH_RESP.c_str(),  &val_ctr.ip_address);
+  unc::restjson::ConfFileValues_t conf_file;
+  unc::odcdriver::OdcController *odc_ctr =
+      new unc::odcdriver::OdcController(key_ctr,  val_ctr, conf_values);
+  unc::driver::controller *ctr = odc_ctr;
+  ctr->physical_port_cache = unc::vtndrvcache::KeyTree::create_cache();
+
+  pfc_bool_t cache_empty = PFC_TRUE;
+  unc::odcdriver::OdcSwitch obj_sw(conf_file);
+  EXPECT_EQ(UNC_RC_SUCCESS, obj_sw.fetch_config(ctr, cache_empty));
+
+  // First poll adds the ports and stores the fingerprint of the switch
+  inet_aton(PORT_RESP.c_str(),  &val_ctr.ip_address);
+  ctr->update_ctr(key_ctr, val_ctr);
+  unc::odcdriver::OdcPort obj(conf_file);
+  EXPECT_EQ(UNC_RC_SUCCESS,
+            obj.fetch_config(ctr, &key_switch, cache_empty));
+  uint64_t fingerprint = 0;
+  EXPECT_EQ(PFC_TRUE, odc_ctr->get_port_fingerprint(switch_id, &fingerprint));
+  std::auto_ptr<unc::vtndrvcache::CommonIterator>
+      itr_ptr(ctr->physical_port_cache->create_iterator());
+  itr_ptr->PhysicalNodeFirstItem();
+  EXPECT_EQ(4U, ctr->physical_port_cache->cfg_list_count());
+
+  // Same ports again are skipped, the link map is still filled
+  inet_aton(SWITCH_RESP.c_str(),  &val_ctr.ip_address);
+  ctr->update_ctr(key_ctr, val_ctr);
+  EXPECT_EQ(UNC_RC_SUCCESS, obj_sw.fetch_config(ctr, cache_empty));
+  EXPECT_EQ(PFC_FALSE, cache_empty);
+  inet_aton(PORT_RESP.c_str(),  &val_ctr.ip_address);
+  ctr->update_ctr(key_ctr, val_ctr);
+  unc::odcdriver::OdcPort obj_same(conf_file);
+  EXPECT_EQ(UNC_RC_SUCCESS,
+            obj_same.fetch_config(ctr, &key_switch, cache_empty));
+  uint64_t fingerprint_same = 0;
+  EXPECT_EQ(PFC_TRUE,
+            odc_ctr->get_port_fingerprint(switch_id, &fingerprint_same));
+  EXPECT_EQ(fingerprint, fingerprint_same);
+  EXPECT_EQ(obj.get_linkmap().size(), obj_same.get_linkmap().size());
+
+  // Changed ports are compared and the new fingerprint is stored
+  inet_aton(PORT_RESP_UPDATE.c_str(),  &val_ctr.ip_address);
+  ctr->update_ctr(key_ctr, val_ctr);
+  EXPECT_EQ(UNC_RC_SUCCESS,
+            obj.fetch_config(ctr, &key_switch, cache_empty));
+  uint64_t fingerprint_update = 0;
+  EXPECT_EQ(PFC_TRUE,
+            odc_ctr->get_port_fingerprint(switch_id, &fingerprint_update));
+  EXPECT_NE(fingerprint, fingerprint_update);
+
+  odc_ctr->clear_port_fingerprints();
+  EXPECT_EQ(PFC_FALSE, odc_ctr->get_port_fingerprint(switch_id, &fingerprint));
+
+  unc::driver::VtnDrvIntf::stub_unloadVtnDrvModule();
+  delete ctr->physical_port_cache;
+  delete ctr;
+  ctr= NULL;
+}
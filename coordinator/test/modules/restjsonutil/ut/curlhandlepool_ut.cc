@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <curl_handle_pool.hh>
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(CurlHandlePool, make_key) {
+  std::string key = unc::restjson::CurlHandlePool::make_key("10.0.0.1", 8181);
+  EXPECT_EQ(std::string("10.0.0.1:8181"), key);
+}
+
+TEST(CurlHandlePool, get_release_reuse) {
+  unc::restjson::CurlHandlePool *pool =
+      unc::restjson::CurlHandlePool::get_instance();
+  std::string key = unc::restjson::CurlHandlePool::make_key("10.0.0.2", 8181);
+  unc::restjson::CurlHandlePoolStats_t stats;
+  EXPECT_EQ(PFC_FALSE, pool->get_stats(key, &stats));
+
+  CURL *first = pool->get_handle(key);
+  CURL *second = pool->get_handle(key);
+  EXPECT_TRUE(first != NULL);
+  EXPECT_TRUE(second != NULL);
+
+  // Only one idle handle is kept, the other one is cleaned up
+  pool->release_handle(key, first, 1, PFC_TRUE);
+  pool->release_handle(key, second, 1, PFC_TRUE);
+  EXPECT_EQ(PFC_TRUE, pool->get_stats(key, &stats));
+  EXPECT_EQ(2U, stats.created);
+  EXPECT_EQ(1U, stats.released);
+  EXPECT_EQ(1U, stats.discarded);
+  EXPECT_EQ(1U, stats.idle);
+
+  // Idle handle is given back
+  CURL *reused = pool->get_handle(key);
+  EXPECT_EQ(first, reused);
+  EXPECT_EQ(PFC_TRUE, pool->get_stats(key, &stats));
+  EXPECT_EQ(1U, stats.reused);
+  EXPECT_EQ(0U, stats.idle);
+
+  // Handle of a failed transfer is not pooled
+  pool->release_handle(key, reused, 1, PFC_FALSE);
+  EXPECT_EQ(PFC_TRUE, pool->get_stats(key, &stats));
+  EXPECT_EQ(2U, stats.discarded);
+  EXPECT_EQ(0U, stats.idle);
+}
+
+TEST(CurlHandlePool, flush_host) {
+  unc::restjson::CurlHandlePool *pool =
+      unc::restjson::CurlHandlePool::get_instance();
+  std::string key = unc::restjson::CurlHandlePool::make_key("10.0.0.3", 8181);
+  std::string other_key =
+      unc::restjson::CurlHandlePool::make_key("10.0.0.30", 8181);
+  pool->release_handle(key, pool->get_handle(key), 4, PFC_TRUE);
+  pool->release_handle(other_key, pool->get_handle(other_key), 4, PFC_TRUE);
+
+  pool->flush("10.0.0.3");
+  unc::restjson::CurlHandlePoolStats_t stats;
+  EXPECT_EQ(PFC_TRUE, pool->get_stats(key, &stats));
+  EXPECT_EQ(0U, stats.idle);
+  EXPECT_EQ(PFC_TRUE, pool->get_stats(other_key, &stats));
+  EXPECT_EQ(1U, stats.idle);
+  pool->clear();
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <json_stream_parser.hh>
+#include <json_build_parse.hh>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using unc::restjson::JsonStreamParser;
+using unc::restjson::JsonStreamRecordHandler;
+using unc::restjson::JsonStreamRecord_t;
+using unc::restjson::REST_OP_SUCCESS;
+using unc::restjson::REST_OP_FAILURE;
+
+/*
+ * Size of the vtn-nodes response built by the benchmark.
+ */
+#define BENCH_SWITCHES          2000U
+#define BENCH_PORTS_PER_SWITCH  48U
+
+// Collects the records reported by the parser
+class RecordCollector : public JsonStreamRecordHandler {
+ public:
+  RecordCollector(const char *first, const char *second)
+      : JsonStreamRecordHandler(make_path(first, second)),
+        fail_at_(0) {}
+
+  unc::restjson::rest_resp_code_t record(const JsonStreamRecord_t &record) {
+    records_.push_back(record);
+    if (records_.size() == fail_at_) {
+      return REST_OP_FAILURE;
+    }
+    return REST_OP_SUCCESS;
+  }
+
+  static std::vector<std::string> make_path(const char *first,
+                                            const char *second) {
+    std::vector<std::string> path;
+    path.push_back(first);
+    if (second != NULL) {
+      path.push_back(second);
+    }
+    return path;
+  }
+
+  std::vector<JsonStreamRecord_t> records_;
+  size_t fail_at_;
+};
+
+// Counts the records without keeping them, like the driver does
+class RecordCounter : public JsonStreamRecordHandler {
+ public:
+  RecordCounter(const char *first, const char *second)
+      : JsonStreamRecordHandler(RecordCollector::make_path(first, second)),
+        id_bytes_(0) {}
+
+  unc::restjson::rest_resp_code_t record(const JsonStreamRecord_t &record) {
+    JsonStreamRecord_t::const_iterator it = record.find("id");
+    if (it != record.end()) {
+      id_bytes_ += it->second.size();
+    }
+    return REST_OP_SUCCESS;
+  }
+
+  size_t id_bytes_;
+};
+
+static uint64_t GetTimeUsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) +
+      (ts.tv_nsec / 1000);
+}
+
+static unc::restjson::rest_resp_code_t FeedInChunks(JsonStreamParser *parser,
+                                                    const std::string &doc,
+                                                    size_t chunk) {
+  for (size_t off = 0; off < doc.size(); off += chunk) {
+    size_t len = ((doc.size() - off) < chunk) ? (doc.size() - off) : chunk;
+    if (parser->feed(doc.data() + off, len) != REST_OP_SUCCESS) {
+      return REST_OP_FAILURE;
+    }
+  }
+  return parser->finish();
+}
+
+// Builds a vtn-nodes response in the format recorded from the controller
+static std::string BuildVtnNodes(uint32_t switches, uint32_t ports) {
+  std::ostringstream doc;
+  doc << "{\"vtn-nodes\":{\"vtn-node\":[";
+  for (uint32_t sw = 1; sw <= switches; sw++) {
+    if (sw > 1) {
+      doc << ",";
+    }
+    doc << "{\"id\":\"openflow:" << sw << "\",\"openflow-version\":\"OF13\","
+        << "\"vtn-port\":[";
+    for (uint32_t port = 1; port <= ports; port++) {
+      if (port > 1) {
+        doc << ",";
+      }
+      doc << "{\"id\":\"openflow:" << sw << ":" << port << "\","
+          << "\"enabled\":true,\"cost\":1000,"
+          << "\"port-link\":[{\"link-id\":\"openflow:" << sw << ":" << port
+          << "\",\"peer\":\"openflow:" << (sw % switches) + 1 << ":" << port
+          << "\"}],\"name\":\"s" << sw << "-eth" << port << "\"}";
+    }
+    doc << "]}";
+  }
+  doc << "]}}";
+  return doc.str();
+}
+
+TEST(JsonStreamParser, switch_records) {
+  std::string doc("{\"vtn-nodes\":{\"vtn-node\":[{\"id\":\"openflow:1\","
+                  "\"openflow-version\":\"OF10\",\"vtn-port\":[{\"id\":"
+                  "\"openflow:1:2\",\"enabled\":true,\"cost\":1000}]},"
+                  "{\"id\":\"openflow:2\",\"openflow-version\":null}]}}");
+  // Every chunk size must give the same result
+  for (size_t chunk = 1; chunk <= doc.size(); chunk++) {
+    RecordCollector handler("vtn-nodes", "vtn-node");
+    JsonStreamParser parser(&handler);
+    ASSERT_EQ(REST_OP_SUCCESS, FeedInChunks(&parser, doc, chunk));
+    ASSERT_EQ(2U, handler.records_.size());
+    EXPECT_EQ(PFC_TRUE, handler.is_path_found());
+    EXPECT_EQ(2U, handler.get_matched_keys());
+    EXPECT_EQ(2U, handler.get_record_count());
+    EXPECT_EQ("openflow:1", handler.records_[0]["id"]);
+    EXPECT_EQ("OF10", handler.records_[0]["openflow-version"]);
+    // Nested arrays are not members of the record
+    EXPECT_EQ(0U, handler.records_[0].count("vtn-port"));
+    EXPECT_EQ(0U, handler.records_[0].count("cost"));
+    EXPECT_EQ("openflow:2", handler.records_[1]["id"]);
+    EXPECT_EQ(0U, handler.records_[1].count("openflow-version"));
+    EXPECT_EQ(doc.size(), parser.get_bytes_parsed());
+  }
+}
+
+TEST(JsonStreamParser, port_records) {
+  std::string doc("{\"vtn-node\":[{\"id\":\"openflow:3\",\"vtn-port\":["
+                  "{\"cost\":1000,\"enabled\":true,\"id\":\"openflow:3:2\","
+                  "\"name\":\"s3-eth2\"},{\"cost\":1000,\"enabled\":false,"
+                  "\"id\":\"openflow:3:1\",\"name\":\"s3-eth1\"}]}]}");
+  RecordCollector handler("vtn-node", "vtn-port");
+  JsonStreamParser parser(&handler);
+  ASSERT_EQ(REST_OP_SUCCESS, FeedInChunks(&parser, doc, 7));
+  ASSERT_EQ(2U, handler.records_.size());
+  EXPECT_EQ(1U, handler.get_path_element_count());
+  EXPECT_EQ("1000", handler.records_[0]["cost"]);
+  EXPECT_EQ("true", handler.records_[0]["enabled"]);
+  EXPECT_EQ("s3-eth2", handler.records_[0]["name"]);
+  EXPECT_EQ("false", handler.records_[1]["enabled"]);
+  EXPECT_EQ("openflow:3:1", handler.records_[1]["id"]);
+}
+
+TEST(JsonStreamParser, path_not_found) {
+  RecordCollector empty("vtn-node", "vtn-port");
+  JsonStreamParser empty_parser(&empty);
+  ASSERT_EQ(REST_OP_SUCCESS, FeedInChunks(&empty_parser,
+                                          "{\"vtn-node\":[]}", 3));
+  EXPECT_EQ(1U, empty.get_matched_keys());
+  EXPECT_EQ(0U, empty.get_path_element_count());
+  EXPECT_EQ(PFC_FALSE, empty.is_path_found());
+
+  RecordCollector other("vtn-topology", "vtn-link");
+  JsonStreamParser other_parser(&other);
+  ASSERT_EQ(REST_OP_SUCCESS, FeedInChunks(
+      &other_parser, "{\"vtn-topolo\":{\"vtn-link\":[{\"source\":\"a\"}]}}",
+      5));
+  EXPECT_EQ(0U, other.get_matched_keys());
+  EXPECT_EQ(0U, other.records_.size());
+}
+
+TEST(JsonStreamParser, escapes) {
+  std::string doc("{\"a\":[{\"k\\\"ey\":\"tab\\there\\u0041\\u00e9"
+                  "\\ud83d\\ude00\\/\"}]}");
+  RecordCollector handler("a", NULL);
+  JsonStreamParser parser(&handler);
+  ASSERT_EQ(REST_OP_SUCCESS, FeedInChunks(&parser, doc, 1));
+  ASSERT_EQ(1U, handler.records_.size());
+  EXPECT_EQ("tab\there" "A" "\xc3\xa9" "\xf0\x9f\x98\x80" "/",
+            handler.records_[0]["k\"ey"]);
+}
+
+TEST(JsonStreamParser, syntax_errors) {
+  const char *bad[] = {
+    "{\"a\":[1,]}",
+    "{\"a\":tru}",
+    "{\"a\":01x}",
+    "{\"a\" 1}",
+    "{\"a\":[1}",
+    "{\"a\":\"\\ud83d\"}",
+    "{\"a\":\"\\q\"}",
+    "{} {}",
+    "{\"a\":[{\"id\":\"openflow:1\"}",
+  };
+  for (size_t i = 0; i < PFC_ARRAY_CAPACITY(bad); i++) {
+    RecordCollector handler("a", NULL);
+    JsonStreamParser parser(&handler);
+    EXPECT_EQ(REST_OP_FAILURE, FeedInChunks(&parser, bad[i], 2)) << bad[i];
+    // A failed parser rejects further input until it is reset
+    EXPECT_EQ(REST_OP_FAILURE, parser.feed("{}", 2));
+    parser.reset();
+    EXPECT_EQ(REST_OP_SUCCESS, FeedInChunks(&parser, "{}", 1));
+  }
+}
+
+TEST(JsonStreamParser, depth_limit) {
+  std::string deep(unc::restjson::JSON_STREAM_MAX_DEPTH + 1, '[');
+  deep.append(unc::restjson::JSON_STREAM_MAX_DEPTH + 1, ']');
+  RecordCollector handler("a", NULL);
+  JsonStreamParser parser(&handler);
+  EXPECT_EQ(REST_OP_FAILURE, FeedInChunks(&parser, deep, 16));
+}
+
+TEST(JsonStreamParser, handler_stops_parse) {
+  RecordCollector handler("a", NULL);
+  handler.fail_at_ = 2;
+  JsonStreamParser parser(&handler);
+  EXPECT_EQ(REST_OP_FAILURE, FeedInChunks(
+      &parser, "{\"a\":[{\"x\":1},{\"x\":2},{\"x\":3}]}", 4));
+  EXPECT_EQ(2U, handler.records_.size());
+}
+
+// Benchmark: parse a large vtn-nodes response with json-c into an object
+// tree and walk it, versus feeding it to the stream parser in the chunk
+// size curl uses
+TEST(JsonStreamParser, BenchLargeTopology) {
+  std::string doc(BuildVtnNodes(BENCH_SWITCHES, BENCH_PORTS_PER_SWITCH));
+  const size_t curl_chunk = 16384;
+
+  uint64_t start = GetTimeUsec();
+  char *data = strdup(doc.c_str());
+  ASSERT_TRUE(data != NULL);
+  json_object *jobj = unc::restjson::JsonBuildParse::get_json_object(data);
+  ASSERT_TRUE(jobj != NULL);
+  json_object *jnodes = NULL;
+  json_object *jnode = NULL;
+  ASSERT_TRUE(json_object_object_get_ex(jobj, "vtn-nodes", &jnodes));
+  ASSERT_TRUE(json_object_object_get_ex(jnodes, "vtn-node", &jnode));
+  uint32_t dom_count = json_object_array_length(jnode);
+  size_t dom_id_bytes = 0;
+  for (uint32_t i = 0; i < dom_count; i++) {
+    std::string id;
+    unc::restjson::JsonBuildParse::parse(jnode, "id", i, id);
+    dom_id_bytes += id.size();
+  }
+  json_object_put(jobj);
+  free(data);
+  uint64_t dom_usec = GetTimeUsec() - start;
+
+  start = GetTimeUsec();
+  RecordCounter handler("vtn-nodes", "vtn-node");
+  JsonStreamParser parser(&handler);
+  ASSERT_EQ(REST_OP_SUCCESS, FeedInChunks(&parser, doc, curl_chunk));
+  uint64_t stream_usec = GetTimeUsec() - start;
+
+  EXPECT_EQ(BENCH_SWITCHES, dom_count);
+  EXPECT_EQ(BENCH_SWITCHES, handler.get_record_count());
+  EXPECT_EQ(dom_id_bytes, handler.id_bytes_);
+  printf("%zu bytes, %u switches x %u ports: json-c tree %llu us, "
+         "stream %llu us\n", doc.size(), BENCH_SWITCHES,
+         BENCH_PORTS_PER_SWITCH,
+         static_cast<unsigned long long>(dom_usec),
+         static_cast<unsigned long long>(stream_usec));
+}
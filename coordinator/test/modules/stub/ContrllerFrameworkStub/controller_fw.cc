@@ -16,7 +16,13 @@ controller* controller :: controller_ptr = NULL;
 driver* driver::driver_ptr = NULL;
 uint32_t driver::set_ctrl = 0;
 uint32_t driver::set_result = 0;
+uint32_t driver::commit_concurrency = 1;
+uint32_t driver::vote_count = 0;
+uint32_t driver::commit_count = 0;
+uint32_t driver::abort_count = 0;
+uint32_t driver::fail_vote_at = 0;
 uint32_t ControllerFramework::res_code = 0;
+std::set<std::string> ControllerFramework::missing_controllers;
 uint32_t root_driver_command::set_root_child = 0;
 uint32_t controller::set_status = 0;
 controller* controller :: create_controll() {
@@ -51,5 +57,16 @@ void driver::set_ret_code(uint32_t ret_code) {
   set_result  = ret_code;
 }
 
+void driver::set_commit_concurrency(uint32_t concurrency) {
+  commit_concurrency = concurrency;
+}
+
+void driver::clear_txn_counts() {
+  vote_count = 0;
+  commit_count = 0;
+  abort_count = 0;
+  fail_vote_at = 0;
+}
+
 }  // namespace driver
 }  // namespace unc
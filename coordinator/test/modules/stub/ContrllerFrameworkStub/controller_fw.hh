@@ -12,6 +12,7 @@
 
 #include <driver/driver_interface.hh>
 #include <driver/controller_interface.hh>
+#include <set>
 #include <string>
 
 namespace unc {
@@ -27,7 +28,7 @@ class ControllerFramework  {
   UncRespCode GetDriverByControllerName(std::string& controller_name,
                                             controller** ctl, driver** drv) {
     pfc_log_info("%s: res_code:%u ", PFC_FUNCNAME, res_code);
-    if (res_code)
+    if (res_code || missing_controllers.count(controller_name))
       return UNC_DRV_RC_ERR_GENERIC;
     *ctl = controller::create_controll();
     *drv = driver::create_driver();
@@ -77,6 +78,7 @@ class ControllerFramework  {
   static void set_result(uint32_t resp);
   static void set_root_result(uint32_t resp);
   static uint32_t res_code;
+  static std::set<std::string> missing_controllers;
 };
 }  // namespace driver
 }  // namespace unc
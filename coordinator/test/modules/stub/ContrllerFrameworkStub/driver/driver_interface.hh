@@ -101,14 +101,17 @@ class driver {
     }
   }
 
+  // Controllers may be voted and committed concurrently
   unc::tclib::TcCommonRet HandleVote(unc::driver::controller*) {
-    if (set_result == 0) {
+    uint32_t count = __sync_add_and_fetch(&vote_count, 1);
+    if (set_result == 0 && count != fail_vote_at) {
       return unc::tclib::TC_SUCCESS;
     }
     return unc::tclib::TC_FAILURE;
   }
 
   unc::tclib::TcCommonRet HandleCommit(unc::driver::controller*) {
+    __sync_add_and_fetch(&commit_count, 1);
     if (set_result == 0) {
       return unc::tclib::TC_SUCCESS;
     }
@@ -116,12 +119,17 @@ class driver {
   }
 
   unc::tclib::TcCommonRet HandleAbort(unc::driver::controller*) {
+    __sync_add_and_fetch(&abort_count, 1);
     if (set_result == 0) {
       return unc::tclib::TC_SUCCESS;
     }
     return unc::tclib::TC_FAILURE;
   }
 
+  uint32_t get_commit_concurrency() {
+    return commit_concurrency;
+  }
+
   pfc_bool_t  get_physical_port_details(unc::driver::controller*) {
   return PFC_TRUE;
    }
@@ -130,8 +138,16 @@ class driver {
   static driver* driver_ptr;
   static void set_ctrl_instance(uint32_t ctrl_inst);
   static void set_ret_code(uint32_t ret_code);
+  static void set_commit_concurrency(uint32_t concurrency);
+  static void clear_txn_counts();
   static uint32_t set_ctrl;
   static uint32_t set_result;
+  static uint32_t commit_concurrency;
+  // Calls of HandleVote/HandleCommit/HandleAbort, and the vote which fails
+  static uint32_t vote_count;
+  static uint32_t commit_count;
+  static uint32_t abort_count;
+  static uint32_t fail_vote_at;
 };
 }  // namespace driver
 }  // namespace unc
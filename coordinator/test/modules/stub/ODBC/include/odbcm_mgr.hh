@@ -50,7 +50,9 @@ class ODBCManager {
     GETMODIFIEDROWS,
     COMMITALLCONFIG,
     CLEARONEINSTANCE,
-    CLEARALLROWS
+    CLEARALLROWS,
+    BEGINBATCHTRANSACTION,
+    ENDBATCHTRANSACTION
   };
   /**Destructor of ODBCManager class
    * InputParam: None*/
@@ -109,6 +111,20 @@ class ODBCManager {
                                 * column names with data type*/,
                                OdbcmConnectionHandler *conn_obj,
                                bool IsInternal = false);
+  /**
+   * These methods create or update all rows in the DBTableSchema row list
+   * with one prepared statement, and commit them as one transaction.
+   * */
+  ODBCM_RC_STATUS CreateRows(unc_keytype_datatype_t/**Database type*/,
+                             DBTableSchema&
+                             /**object which carries the table
+                               ,pkeys,column names with data type*/,
+                             OdbcmConnectionHandler *conn_obj);
+  ODBCM_RC_STATUS UpdateRows(unc_keytype_datatype_t/**Database type*/,
+                             DBTableSchema&
+                             /**object which carries the table,pkeys,
+                              * column names with data type*/,
+                             OdbcmConnectionHandler *conn_obj);
   /**
    * This method deletes the attributes of single key tree
    * instance in a row, the row entry will not be actually deleted in the case
@@ -229,6 +245,9 @@ class ODBCManager {
                           QueryProcessor*);
   std::string GetColumnName(ODBCMTableColumns);
   ODBCM_RC_STATUS CloseRwConnection();
+  ODBCM_RC_STATUS BeginBatchTransaction(OdbcmConnectionHandler *conn_obj);
+  ODBCM_RC_STATUS EndBatchTransaction(OdbcmConnectionHandler *conn_obj,
+                                      bool commit);
 
   static void stub_setResultcode(ODBCManager::Method methodType,
                                           ODBCM_RC_STATUS res_code) {
@@ -243,10 +262,20 @@ class ODBCManager {
     sibling_count = count;
   }
 
+  static uint32_t stub_getBatchBeginCount() {
+    return batch_begin_count;
+  }
+
+  static uint32_t stub_getBatchEndCount() {
+    return batch_end_count;
+  }
+
   static void clearStubData() {
     method_resultcode_map.clear();
     exists_ = false;
     sibling_count = 0;
+    batch_begin_count = 0;
+    batch_end_count = 0;
   }
 
  private:
@@ -289,6 +318,8 @@ class ODBCManager {
   static std::map<ODBCManager::Method, ODBCM_RC_STATUS> method_resultcode_map;
   static  bool exists_;
   static uint32_t sibling_count;
+  static uint32_t batch_begin_count;
+  static uint32_t batch_end_count;
 };
 }  // namespace uppl
 }  // namespace unc
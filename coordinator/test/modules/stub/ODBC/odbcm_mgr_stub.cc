@@ -18,6 +18,8 @@ std::map<ODBCManager::Method, ODBCM_RC_STATUS>
                                  ODBCManager::method_resultcode_map;
 bool  ODBCManager::exists_= false;
 uint32_t  ODBCManager::sibling_count = 0;
+uint32_t  ODBCManager::batch_begin_count = 0;
+uint32_t  ODBCManager::batch_end_count = 0;
 
 ODBCManager::ODBCManager(void) {
 }
@@ -43,6 +45,26 @@ ODBCManager::CloseRwConnection() {
   return ODBCM_RC_SUCCESS;
 }
 
+ODBCM_RC_STATUS
+ODBCManager::BeginBatchTransaction(OdbcmConnectionHandler *conn_obj) {
+  // Batch transaction is started unless a result code is set
+  batch_begin_count++;
+  if (0 != method_resultcode_map.count(ODBCManager::BEGINBATCHTRANSACTION)) {
+    return method_resultcode_map[ODBCManager::BEGINBATCHTRANSACTION];
+  }
+  return ODBCM_RC_SUCCESS;
+}
+
+ODBCM_RC_STATUS
+ODBCManager::EndBatchTransaction(OdbcmConnectionHandler *conn_obj,
+                                 bool commit) {
+  batch_end_count++;
+  if (0 != method_resultcode_map.count(ODBCManager::ENDBATCHTRANSACTION)) {
+    return method_resultcode_map[ODBCManager::ENDBATCHTRANSACTION];
+  }
+  return ODBCM_RC_SUCCESS;
+}
+
 ODBCManager *
 ODBCManager::get_ODBCManager() {
   /*Allocate the memory for ODBCManager only if its NULL*/
@@ -134,6 +156,18 @@ ODBCManager::UpdateOneRow(unc_keytype_datatype_t, DBTableSchema&,
   return stub_getMappedResultCode(ODBCManager::UPDATEONEROW);
 }
 
+ODBCM_RC_STATUS
+ODBCManager::CreateRows(unc_keytype_datatype_t, DBTableSchema&,
+                        OdbcmConnectionHandler *conn_obj) {
+  return stub_getMappedResultCode(ODBCManager::CREATEONEROW);
+}
+
+ODBCM_RC_STATUS
+ODBCManager::UpdateRows(unc_keytype_datatype_t, DBTableSchema&,
+                        OdbcmConnectionHandler *conn_obj) {
+  return stub_getMappedResultCode(ODBCManager::UPDATEONEROW);
+}
+
 ODBCM_RC_STATUS
 ODBCManager::DeleteOneRow(unc_keytype_datatype_t, DBTableSchema&,
                           OdbcmConnectionHandler *conn_obj) {
@@ -100,6 +100,10 @@ curl_easy_cleanup(CURL * handle) {
   }
 }
 
+inline void
+curl_easy_reset(CURL * handle) {
+}
+
 template < typename T > T * curl_slist_append(T * list, const char *string1) {
 return list;
 }
@@ -19,6 +19,7 @@
 #define __DAL_DML_INTF_HH__
 
 #include <stdint.h>
+#include <vector>
 #include "include/dal_defines.hh"
 #include "dal_bind_info.hh"
 #include "include/dal_schema.hh"
@@ -442,6 +443,32 @@ class DalDmlIntf {
                         const TcConfigMode cfg_mode,
                         const uint8_t* vtn_name = NULL) = 0;
 
+    /**
+     * CreateRecords
+     *   Creates the records in table with the given input data for
+     *   the given cfg_type using arrays of parameters
+     */
+    virtual DalResultCode CreateRecords(
+                    const UpllCfgType cfg_type,
+                    const DalTableIndex table_index,
+                    const std::vector<const DalBindInfo *> &input_attr_infos,
+                    std::vector<DalResultCode> *results,
+                    const TcConfigMode cfg_mode,
+                    const uint8_t* vtn_name = NULL) = 0;
+
+    /**
+     * UpdateRecords
+     *   Updates the records of table with the given input data for
+     *   the given cfg_type using arrays of parameters
+     */
+    virtual DalResultCode UpdateRecords(
+        const UpllCfgType cfg_type,
+        const DalTableIndex table_index,
+        const std::vector<const DalBindInfo *> &input_and_matching_attr_infos,
+        std::vector<DalResultCode> *results,
+        const TcConfigMode cfg_mode,
+        const uint8_t* vtn_name = NULL) = 0;
+
     /**
      * UpdateRecords
      *   Updates the records of table with the given input data for 
@@ -635,6 +662,23 @@ class DalDmlIntf {
                     const TcConfigMode cfg_mode,
                     const uint8_t* vtn_name = NULL) = 0;
 
+    /**
+     * GetChangedRecords
+     *   Fetches the records deleted, created and updated in cfg_type_1 as
+     *   compared to cfg_type_2 with one query. *change is set to the
+     *   DalChangeType of each fetched record.
+     */
+    virtual DalResultCode GetChangedRecords(
+                    const UpllCfgType cfg_type_1,
+                    const UpllCfgType cfg_type_2,
+                    const DalTableIndex table_index,
+                    const size_t max_record_count,
+                    const DalBindInfo *output_attr_info,
+                    int16_t *change,
+                    DalCursor **cursor,
+                    const TcConfigMode cfg_mode,
+                    const uint8_t* vtn_name) = 0;
+
     /**
      * CopyEntireRecords
      *   Copies the entire records of table from source configuration to
@@ -15,9 +15,13 @@ namespace dal {
 
 std::map<DalOdbcMgr::Method,DalResultCode> DalOdbcMgr::method_resultcode_map;
 bool  DalOdbcMgr::exists_=false;
+DalConnState DalOdbcMgr::stub_conn_state_ = kDalDbDisconnected;
+std::vector<int16_t> DalOdbcMgr::stub_changes_;
 
 DalOdbcMgr::DalOdbcMgr(void) {
-
+  conn_state_ = stub_conn_state_;
+  stub_change_ = NULL;
+  write_generation_ = 0;
 }
 DalOdbcMgr::~DalOdbcMgr(void) {
 }
@@ -64,6 +68,15 @@ DalResultCode DalOdbcMgr::GetMultipleRecords(
 }
 
 DalResultCode DalOdbcMgr::GetNextRecord(const DalCursor *cursor) {
+  if (stub_change_ != NULL) {
+    if (stub_changes_.empty()) {
+      stub_change_ = NULL;
+      return kDalRcRecordNoMore;
+    }
+    *stub_change_ = stub_changes_.front();
+    stub_changes_.erase(stub_changes_.begin());
+    return kDalRcSuccess;
+  }
 	return stub_getMappedResultCode(DalOdbcMgr::NEXT);
 }
 
@@ -147,6 +160,30 @@ DalResultCode DalOdbcMgr::UpdateRecords(
 	return stub_getMappedResultCode(DalOdbcMgr::UPDATE_RECORD);
 }
 
+DalResultCode DalOdbcMgr::CreateRecords(
+                    const UpllCfgType cfg_type,
+                    const DalTableIndex table_index,
+                    const std::vector<const DalBindInfo *> &input_attr_infos,
+                    std::vector<DalResultCode> *results,
+                    const TcConfigMode cfg_mode,
+                    const uint8_t* vtn_name) {
+	DalResultCode result = stub_getMappedResultCode(DalOdbcMgr::CREATE_RECORD);
+	results->assign(input_attr_infos.size(), result);
+	return result;
+}
+
+DalResultCode DalOdbcMgr::UpdateRecords(
+        const UpllCfgType cfg_type,
+        const DalTableIndex table_index,
+        const std::vector<const DalBindInfo *> &input_and_matching_attr_infos,
+        std::vector<DalResultCode> *results,
+        const TcConfigMode cfg_mode,
+        const uint8_t* vtn_name) {
+	DalResultCode result = stub_getMappedResultCode(DalOdbcMgr::UPDATE_RECORD);
+	results->assign(input_and_matching_attr_infos.size(), result);
+	return result;
+}
+
 
 DalResultCode DalOdbcMgr::GetDeletedRecords(const UpllCfgType cfg_type_1,
                                     const UpllCfgType cfg_type_2,
@@ -184,6 +221,21 @@ DalResultCode DalOdbcMgr::GetUpdatedRecords(
 	return stub_getMappedResultCode(DalOdbcMgr::GET_UPDATED_RECORDS);
 }
 
+DalResultCode DalOdbcMgr::GetChangedRecords(
+                    const UpllCfgType cfg_type_1,
+                    const UpllCfgType cfg_type_2,
+                    const DalTableIndex table_index,
+                    const size_t max_record_count,
+                    const DalBindInfo *output_attr_info,
+                    int16_t *change,
+                    DalCursor **cursor,
+                    const TcConfigMode cfg_mode,
+                    const uint8_t* vtn_name) {
+  DalResultCode rc = stub_getMappedResultCode(DalOdbcMgr::GET_CHANGED_RECORDS);
+  stub_change_ = (rc == kDalRcSuccess) ? change : NULL;
+  return rc;
+}
+
 DalResultCode DalOdbcMgr::CopyEntireRecords(const UpllCfgType dest_cfg_type,
                                     const UpllCfgType src_cfg_type,
                                     const DalTableIndex table_index,
@@ -18,6 +18,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "include/dal_defines.hh"
 #include "include/dal_conn_intf.hh"
@@ -61,6 +62,7 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
     GET_DELETED_RECORDS,
     GET_CREATED_RECORDS,
     GET_UPDATED_RECORDS,
+    GET_CHANGED_RECORDS,
     COPY_ENTIRE,
     COPY_MODIFY,
     COPY_MODIFY_INSERT,
@@ -84,9 +86,13 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
     DalResultCode RollbackTransaction();
 
     DalConnType get_conn_type();
-    inline DalConnState get_conn_state() { return kDalDbDisconnected; }
+    inline DalConnState get_conn_state() { return conn_state_; }
     inline uint32_t get_write_count() { return write_count_; }
     inline void reset_write_count() { write_count_ = 0; }
+    inline uint64_t get_write_generation() const { return write_generation_; }
+    inline void stub_setWriteGeneration(uint64_t generation) {
+      write_generation_ = generation;
+    }
 
 
     DalResultCode GetSingleRecord(
@@ -162,6 +168,22 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
                         const TcConfigMode cfg_mode,
                         const uint8_t* vtn_name = NULL);
 
+    DalResultCode CreateRecords(
+                    const UpllCfgType cfg_type,
+                    const DalTableIndex table_index,
+                    const std::vector<const DalBindInfo *> &input_attr_infos,
+                    std::vector<DalResultCode> *results,
+                    const TcConfigMode cfg_mode,
+                    const uint8_t* vtn_name = NULL);
+
+    DalResultCode UpdateRecords(
+        const UpllCfgType cfg_type,
+        const DalTableIndex table_index,
+        const std::vector<const DalBindInfo *> &input_and_matching_attr_infos,
+        std::vector<DalResultCode> *results,
+        const TcConfigMode cfg_mode,
+        const uint8_t* vtn_name = NULL);
+
 
     DalResultCode GetDeletedRecords(const UpllCfgType cfg_type_1,
                                     const UpllCfgType cfg_type_2,
@@ -191,6 +213,16 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
                     DalCursor **cursor,
                     const TcConfigMode cfg_mode,
                     const uint8_t* vtn_name = NULL);
+    DalResultCode GetChangedRecords(
+                    const UpllCfgType cfg_type_1,
+                    const UpllCfgType cfg_type_2,
+                    const DalTableIndex table_index,
+                    const size_t max_record_count,
+                    const DalBindInfo *output_attr_info,
+                    int16_t *change,
+                    DalCursor **cursor,
+                    const TcConfigMode cfg_mode,
+                    const uint8_t* vtn_name);
     DalResultCode ClearCreateUpdateFlags(const DalTableIndex table_index,
                                     const UpllCfgType cfg_type,
                                     const TcConfigMode cfg_mode,
@@ -296,9 +328,19 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
       method_resultcode_map.insert(std::make_pair(methodType, res_code));
     }
 
+    // Changes of the records fetched after GetChangedRecords()
+    static void stub_setChangedRecords(const std::vector<int16_t> &changes) {
+      stub_changes_ = changes;
+    }
+
     static void stub_setSingleRecordExists(bool exists) {
         exists_= exists;
     }
+
+    // State reported by the connections created after this call
+    static void stub_setConnState(DalConnState conn_state) {
+        stub_conn_state_ = conn_state;
+    }
     inline void ClearDirtyTblCache(const TcConfigMode cfg_mode,
                                    const uint8_t* vtn_name) const {
       delete_dirty.clear();
@@ -335,6 +377,8 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
 
     static void clearStubData() {
       method_resultcode_map.clear();
+      stub_conn_state_ = kDalDbDisconnected;
+      stub_changes_.clear();
     }
     DalResultCode  ExecuteAppQueryModifyRecord(
         const UpllCfgType cfg_type,
@@ -373,11 +417,17 @@ class DalOdbcMgr :public DalConnIntf, public DalDmlIntf {
     DalResultCode stub_getMappedResultCode(Method);
     static std::map<DalOdbcMgr::Method, DalResultCode> method_resultcode_map;
     static  bool exists_;
+    static DalConnState stub_conn_state_;
+    static std::vector<int16_t> stub_changes_;
+    // Set by GetChangedRecords() till its records are fetched
+    int16_t *stub_change_;
     mutable DalConnType conn_type_;
+    DalConnState conn_state_;
     mutable set<uint32_t> create_dirty;
     mutable set<uint32_t> delete_dirty;
     mutable set<uint32_t> update_dirty;
     mutable uint32_t write_count_;
+    uint64_t write_generation_;
     pfc::core::Mutex wr_exclusion_runn_mutex_;
     bool wr_exclusion_on_runn_;
     mutable bool wr_exclusion_runn_mutex_acqd_;
@@ -585,6 +585,21 @@ class DalDmlIntf {
                     const DalBindInfo *cfg_2_output_and_match_attr_info,
                     DalCursor **cursor) const = 0;
 
+    /**
+     * GetChangedRecords
+     *   Fetches the records deleted, created and updated in cfg_type_1 as
+     *   compared to cfg_type_2 with one query. *change is set to the
+     *   DalChangeType of each fetched record.
+     */
+    virtual DalResultCode GetChangedRecords(
+                    const UpllCfgType cfg_type_1,
+                    const UpllCfgType cfg_type_2,
+                    const DalTableIndex table_index,
+                    const size_t max_record_count,
+                    const DalBindInfo *output_attr_info,
+                    int16_t *change,
+                    DalCursor **cursor) const = 0;
+
     /**
      * CopyEntireRecords
      *   Copies the entire records of table from source configuration to
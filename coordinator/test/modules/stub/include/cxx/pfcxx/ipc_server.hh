@@ -229,6 +229,7 @@ class ServerEvent
 
   inline int
       post(void) {
+        postCount_++;
         return postResult_;
       }
 
@@ -240,9 +241,11 @@ class ServerEvent
   static void clearStubData();
   static void stub_setserverEventErr(int err);
   static void stub_setPostResult(int result);
+  static uint32_t stub_getPostCount();
  private:
   static int serverEventErr_;
   static int postResult_;
+  static uint32_t postCount_;
 };
 
 class ServerCallback {
@@ -25,10 +25,28 @@
 namespace pfc {
 namespace core {
 
+typedef boost::function<void (void)> taskq_func_t;
 
 class TaskQueue {
  public:
+  static inline TaskQueue *create(uint32_t concurrency,
+                                  const std::string &owner = "") {
+    return new TaskQueue(1);
+  }
   ~TaskQueue(void) {}
+  /*
+   * Runs the task in the calling thread
+   */
+  int dispatch(const taskq_func_t &func) {
+    func();
+    return 0;
+  }
+  /*
+   * Dispatched tasks are already done
+   */
+  int clear(const pfc_timespec_t *ts = NULL) {
+    return 0;
+  }
   inline pfc_taskq_t getId() {
     return 1;
   }
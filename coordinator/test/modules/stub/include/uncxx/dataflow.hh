@@ -88,6 +88,14 @@ class DataflowDummy : public pfc::core::Module {
   static DataflowDummy* dataflow_dummy_;
 };
 
+class DataflowMatch {
+ public:
+  DataflowMatch() {}
+  explicit DataflowMatch(const map<UncDataflowFlowMatchType, void *> &matches) {
+  }
+  bool Matches(const DataflowMatch &prev) const { return true; }
+};
+
 class DataflowCmn;
 
 class DataflowDetail {
@@ -201,6 +209,25 @@ class DataflowCmn {
 
 };
 
+class DataflowFlowIndex {
+ public:
+  explicit DataflowFlowIndex(const vector<DataflowDetail *> &flows)
+      : count_(flows.size()) {
+  }
+  void Lookup(const DataflowMatch &prev, vector<uint32_t> *positions) const {
+    positions->clear();
+    for (uint32_t i = 0; i < count_; i++) {
+      positions->push_back(i);
+    }
+  }
+  bool Matches(uint32_t position, const DataflowMatch &prev) const {
+    return true;
+  }
+
+ private:
+  uint32_t count_;
+};
+
 struct KeyDataflowCmp {
   bool operator()(const key_dataflow_t& lhs, const key_dataflow_t& rhs) {
     return false;
@@ -217,7 +244,13 @@ struct KeyVtnDataflowCmp {
 
 class DataflowUtil {
  public:
-  ~DataflowUtil() { }
+  ~DataflowUtil() {
+    std::map<const vector<DataflowDetail *> *, DataflowFlowIndex *>::iterator
+        it = flow_indexes_.begin();
+    for (; it != flow_indexes_.end(); ++it) {
+      delete it->second;
+    }
+  }
   // Write the DataflowCmn details into NB session as mentioned in FD API doc
   int sessOutDataflows(ServerSession& sess) { return 1; }
 
@@ -264,6 +297,13 @@ class DataflowUtil {
   std::map<std::string, uint32_t>* get_ctrlr_dom_count_map() {
     return &ctrlr_dom_count_map;
   };
+  DataflowFlowIndex* get_flow_index(const vector<DataflowDetail *> &flows) {
+    DataflowFlowIndex *&index = flow_indexes_[&flows];
+    if (index == NULL) {
+      index = new DataflowFlowIndex(flows);
+    }
+    return index;
+  }
   std::map<key_dataflow_t, vector<DataflowDetail *>, KeyDataflowCmp > pfc_flows;
   std::map<key_vtn_ctrlr_dataflow, vector<DataflowDetail *>, KeyVtnDataflowCmp  > upll_pfc_flows;
   std::map<std::string, uint32_t> ctrlr_dom_count_map;
@@ -273,6 +313,7 @@ class DataflowUtil {
 
  private:
   vector<DataflowCmn* > firstCtrlrFlows;
+  std::map<const vector<DataflowDetail *> *, DataflowFlowIndex *> flow_indexes_;
 };
 
 }  // namespace dataflow
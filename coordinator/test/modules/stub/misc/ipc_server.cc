@@ -863,6 +863,7 @@ ServerSession::clearStubData(void) {
 
 int ServerEvent::serverEventErr_= 0;
 int ServerEvent::postResult_= UNC_UPPL_RC_FAILURE;
+uint32_t ServerEvent::postCount_= 0;
 
 void ServerEvent::stub_setserverEventErr(int err) {
   serverEventErr_ = err;
@@ -870,11 +871,16 @@ void ServerEvent::stub_setserverEventErr(int err) {
 
 void ServerEvent::clearStubData() {
   ServerSession::clearStubData();
+  postCount_= 0;
 }
 
 void ServerEvent::stub_setPostResult(int result) {
   postResult_= result;
 }
+
+uint32_t ServerEvent::stub_getPostCount() {
+  return postCount_;
+}
 }  //  namespace ipc
 }  //  namespace core
 }  //  namespace pfc
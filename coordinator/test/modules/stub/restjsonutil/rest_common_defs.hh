@@ -51,6 +51,7 @@ typedef struct {
   uint32_t odc_port;
   uint32_t request_time_out;
   uint32_t connection_time_out;
+  uint32_t max_pooled_connections;
   std::string user_name;
   std::string password;
 } ConfFileValues_t;
@@ -11,7 +11,9 @@
 #define RESTJSON_REST_CLIENT_H_
 
 #include <stdio.h>
+#include <string.h>
 #include <rest_common_defs.hh>
+#include <json_stream_parser.hh>
 
 #include <string>
 
@@ -27,6 +29,8 @@ class RestUtil {
         response_ = new HttpResponse_t;
         response_->code = 0;
         response_->write_data = new HttpContent_t;
+        response_->write_data->memory = NULL;
+        response_->write_data->size = 0;
       }
 
   ~RestUtil() {
@@ -498,6 +502,38 @@ class RestUtil {
     return NULL;
   }
 
+  // Feeds the canned response to the stream parser in small chunks, the
+  // way curl hands over a response read from the network
+  HttpResponse_t* send_http_request(const std::string &url,
+                                    const unc::restjson::HttpMethod method,
+                                    const char* request,
+                                    const ConfFileValues_t &conf_file_values_,
+                                    JsonStreamParser *stream_parser) {
+    HttpResponse_t* response = send_http_request(url, method, request,
+                                                 conf_file_values_);
+    if ((NULL == stream_parser) || (NULL == response) ||
+        (200 != response->code) || (NULL == response->write_data) ||
+        (NULL == response->write_data->memory)) {
+      return response;
+    }
+    const size_t chunk_size = 16;
+    const char *data = response->write_data->memory;
+    size_t len = strlen(data);
+    for (size_t off = 0; off < len; off += chunk_size) {
+      size_t size = ((len - off) < chunk_size) ? (len - off) : chunk_size;
+      if (REST_OP_SUCCESS != stream_parser->feed(data + off, size)) {
+        return NULL;
+      }
+    }
+    if (REST_OP_SUCCESS != stream_parser->finish()) {
+      return NULL;
+    }
+    return response;
+  }
+
+  static void flush_connections(const std::string &ipaddress) {
+  }
+
   void clear_http_response() {
     if (response_ != NULL) {
       if (response_->write_data != NULL) {
@@ -18,6 +18,7 @@ std::map<TcLibModule::TCApiCommonRet,TcApiCommonRet> TcLibModule::method_tcapi_m
 unc_keytype_ctrtype_t TcLibModule::driverId;
 unc_keytype_ctrtype_t TcLibModule::controllerType;
 uint32_t TcLibModule::keyIndex;
+std::vector<std::string> TcLibModule::controller_info_written;
 TcLibInterface* TcLibModule::pTcLibInterface_= 0;
 
 //static TcLibModule  theInstance(NULL);
@@ -74,6 +75,7 @@ TcApiCommonRet TcLibModule::TcLibReadKeyValueDataInfo(std::string controller_id,
 TcApiCommonRet TcLibModule::TcLibWriteControllerInfo(std::string controller_id,
                                                      uint32_t response_code,
                                                      uint32_t num_of_errors) {
+  controller_info_written.push_back(controller_id);
   return stub_getMappedResultCode(TcLibModule::WRITE_CONTROLLER);
 }
 
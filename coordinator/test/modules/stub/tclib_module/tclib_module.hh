@@ -16,6 +16,7 @@
 #include <uncxx/tclib/tclib_interface.hh>
 #include <tclib_struct_defs.hh>
 #include <string>
+#include <vector>
 
 namespace unc {
 namespace tclib {
@@ -526,7 +527,7 @@ class TcLibModule : public pfc::core::Module {
   static void stub_clearTcLibStubData() {
     method_tccommon_map.clear();
     method_tcapi_map.clear();
-
+    controller_info_written.clear();
   }
 
   static inline void Stub_setDriverId(unc_keytype_ctrtype_t driverid ) {
@@ -629,6 +630,11 @@ class TcLibModule : public pfc::core::Module {
   static TcApiCommonRet stub_getMappedResultCode(TcLibModule::TCApiCommonRet);
   static TcCommonRet stub_getMappedResultCode(TcLibModule::TCCommonRet);
 
+ public:
+  /*controller ids written by TcLibWriteControllerInfo in order*/
+  static std::vector<std::string> controller_info_written;
+
+ private:
 
   static TcLibInterface *pTcLibInterface_;
 
@@ -7,8 +7,13 @@
  * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
  */
 
+#include <algorithm>
+#include <vector>
 #include "test_tcmsg_commit.hh"
 
+extern int stub_session_invoke;
+extern int stub_response;
+
 TEST(TwoPhaseCommit, TestHandleDriver) {
   uint32_t sess_id =  SET;
   TcMsgOperType opertype =  MSG_AUDIT_START;
@@ -96,3 +101,113 @@ TEST(TwoPhaseCommit, SendRequestToDriver_DriverNotPresent) {
   EXPECT_EQ(TCOPER_RET_SUCCESS,  retval);
 }
 #endif
+
+/*Frames a driver request on the session of the overlay driver channel*/
+static TwoPhaseCommit::DriverRequest
+GetDriverRequest_commit(TcDaemonName tc_driverid, int SetSession) {
+  TwoPhaseCommit::DriverRequest request;
+  request.driver_type = UNC_CT_UNKNOWN;
+  request.tc_driverid = tc_driverid;
+  request.channel_name = "drvoverlay";
+  request.sess = NULL;
+  request.conn = 0;
+  request.resp = 0;
+  request.util_resp = TCUTIL_RET_SUCCESS;
+  if (SetSession) {
+    request.sess = TcClientSessionUtils::create_tc_client_session(
+        request.channel_name, unc::tclib::TCLIB_COMMIT_TRANSACTION,
+        request.conn);
+  }
+  return request;
+}
+
+/*All the drivers are invoked and the ones that voted are aborted once*/
+TEST(TwoPhaseCommit, InvokeDriverSessions_MultiDriver_Success) {
+  Test2phaseCommit C2phase(SET,  MSG_COMMIT_VOTE);
+  std::vector<TwoPhaseCommit::DriverRequest> requests;
+  requests.push_back(GetDriverRequest_commit(TC_DRV_OPENFLOW, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_OVERLAY, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_POLC, CLEAR));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_ODC, SET));
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    requests[i].util_resp = TCUTIL_RET_FAILURE;
+    requests[i].resp = TC_FAILURE;
+  }
+  stub_session_invoke = CLEAR;
+  stub_response = CLEAR;
+
+  C2phase.InvokeDriverSessions(requests);
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    if (requests[i].sess == NULL) {
+      /*absent driver is not invoked*/
+      EXPECT_EQ(TCUTIL_RET_FAILURE, requests[i].util_resp);
+      continue;
+    }
+    EXPECT_EQ(TCUTIL_RET_SUCCESS, requests[i].util_resp);
+    EXPECT_EQ(static_cast<pfc_ipcresp_t>(TC_SUCCESS), requests[i].resp);
+  }
+
+  C2phase.abort_on_fail_.push_back(TC_UPLL);
+  C2phase.AddVotedDriversToAbort(requests);
+  C2phase.AddVotedDriversToAbort(requests);
+  uint32_t voted = 0;
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    if (requests[i].sess != NULL) {
+      voted++;
+    }
+  }
+  EXPECT_EQ(voted + 1, C2phase.abort_on_fail_.size());
+  EXPECT_EQ(TC_UPLL, C2phase.abort_on_fail_[0]);
+  TwoPhaseCommit::CloseDriverSessions(requests);
+}
+
+/*The drivers after a failed one have voted too and are aborted*/
+TEST(TwoPhaseCommit, AddVotedDriversToAbort_PartialFailure) {
+  Test2phaseCommit C2phase(SET,  MSG_COMMIT_VOTE);
+  std::vector<TwoPhaseCommit::DriverRequest> requests;
+  requests.push_back(GetDriverRequest_commit(TC_DRV_OPENFLOW, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_OVERLAY, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_POLC, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_ODC, SET));
+  stub_session_invoke = CLEAR;
+  stub_response = CLEAR;
+  C2phase.InvokeDriverSessions(requests);
+  /*second driver not reached, third driver voted NG*/
+  requests[1].util_resp = TCUTIL_RET_FATAL;
+  requests[2].resp = TC_FAILURE;
+
+  C2phase.AddVotedDriversToAbort(requests);
+  uint32_t voted = 0;
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    if (requests[i].sess != NULL && (i == 0 || i == 3)) {
+      voted++;
+      EXPECT_TRUE(std::find(C2phase.abort_on_fail_.begin(),
+                            C2phase.abort_on_fail_.end(),
+                            requests[i].tc_driverid) !=
+                  C2phase.abort_on_fail_.end());
+    }
+  }
+  EXPECT_EQ(voted, C2phase.abort_on_fail_.size());
+  TwoPhaseCommit::CloseDriverSessions(requests);
+}
+
+/*No driver is aborted when none of them is reached*/
+TEST(TwoPhaseCommit, InvokeDriverSessions_MultiDriver_InvokeFailure) {
+  Test2phaseCommit C2phase(SET,  MSG_COMMIT_VOTE);
+  std::vector<TwoPhaseCommit::DriverRequest> requests;
+  requests.push_back(GetDriverRequest_commit(TC_DRV_OPENFLOW, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_OVERLAY, SET));
+  requests.push_back(GetDriverRequest_commit(TC_DRV_ODC, SET));
+  stub_session_invoke = SET;
+
+  C2phase.InvokeDriverSessions(requests);
+  stub_session_invoke = CLEAR;
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    if (requests[i].sess != NULL) {
+      EXPECT_EQ(TCUTIL_RET_FATAL, requests[i].util_resp);
+    }
+  }
+  C2phase.AddVotedDriversToAbort(requests);
+  EXPECT_TRUE(C2phase.abort_on_fail_.empty());
+  TwoPhaseCommit::CloseDriverSessions(requests);
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <set>
+#include <vector>
+#include <dal/dal_odbc_mgr.hh>
+#include <dbconn_mgr.hh>
+
+using unc::upll::dal::DalOdbcMgr;
+using unc::upll::config_momgr::UpllDbConnMgr;
+namespace uudal = unc::upll::dal;
+
+class DbConnMgrRoTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+      DalOdbcMgr::clearStubData();
+      DalOdbcMgr::stub_setResultcode(DalOdbcMgr::INIT, uudal::kDalRcSuccess);
+      DalOdbcMgr::stub_setResultcode(DalOdbcMgr::CONNECT,
+                                     uudal::kDalRcSuccess);
+      DalOdbcMgr::stub_setResultcode(DalOdbcMgr::DISCONNECT,
+                                     uudal::kDalRcSuccess);
+      DalOdbcMgr::stub_setConnState(uudal::kDalDbConnected);
+    }
+
+    virtual void TearDown() {
+      DalOdbcMgr::clearStubData();
+    }
+
+    // Returns the slot holding dom, or the number of slots
+    static uint32_t SlotOf(const UpllDbConnMgr &mgr, const DalOdbcMgr *dom) {
+      for (uint32_t i = 0; i < mgr.ro_slots_.size(); i++) {
+        if (mgr.ro_slots_[i].conn != NULL &&
+            &mgr.ro_slots_[i].conn->dom == dom) {
+          return i;
+        }
+      }
+      return mgr.ro_slots_.size();
+    }
+
+    static uint32_t FreeSlots(const UpllDbConnMgr &mgr) {
+      uint32_t nfree = 0;
+      for (uint32_t i = 0; i < mgr.ro_slots_.size(); i++) {
+        if (mgr.ro_slots_[i].state == UpllDbConnMgr::kRoSlotFree) {
+          nfree++;
+        }
+      }
+      return nfree;
+    }
+};
+
+TEST_F(DbConnMgrRoTest, NoSlot) {
+  UpllDbConnMgr mgr(0);
+  DalOdbcMgr *dom = NULL;
+
+  EXPECT_EQ(UPLL_RC_ERR_GENERIC, mgr.AcquireRoConn(&dom));
+  EXPECT_TRUE(dom == NULL);
+}
+
+TEST_F(DbConnMgrRoTest, ClaimAllSlots) {
+  UpllDbConnMgr mgr(4);
+  std::set<uint32_t> claimed;
+  uint32_t idx;
+
+  // The scan starts at home and wraps around to hand out every slot once
+  for (uint32_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(mgr.ClaimRoSlot(2, &idx));
+    EXPECT_EQ((2 + i) % 4, idx);
+    claimed.insert(idx);
+  }
+  EXPECT_EQ(4U, claimed.size());
+  EXPECT_FALSE(mgr.ClaimRoSlot(2, &idx));
+
+  mgr.ReleaseRoSlot(1);
+  ASSERT_TRUE(mgr.ClaimRoSlot(2, &idx));
+  EXPECT_EQ(1U, idx);
+  for (uint32_t i = 0; i < 4; i++) {
+    mgr.ReleaseRoSlot(i);
+  }
+  EXPECT_EQ(4U, FreeSlots(mgr));
+}
+
+TEST_F(DbConnMgrRoTest, SlotReuse) {
+  UpllDbConnMgr mgr(3);
+  UpllDbConnMgr::RoConnStats stats;
+  DalOdbcMgr *dom1 = NULL, *dom2 = NULL;
+
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom1));
+  uint32_t home = mgr.GetRoHomeSlot();
+  EXPECT_EQ(home, SlotOf(mgr, dom1));
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom1));
+
+  // Healthy connection stays open in the home slot and is handed out again
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom2));
+  EXPECT_EQ(dom1, dom2);
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom2));
+
+  mgr.GetRoConnStats(&stats);
+  EXPECT_EQ(2U, stats.acquired);
+  EXPECT_EQ(2U, stats.home_hits);
+  EXPECT_EQ(1U, stats.reconnects);
+  EXPECT_EQ(2U, stats.wait_hist[0]);
+  EXPECT_EQ(1U, mgr.active_ro_conns_cnt_);
+  EXPECT_EQ(3U, FreeSlots(mgr));
+}
+
+TEST_F(DbConnMgrRoTest, SlotReuseAfterReset) {
+  UpllDbConnMgr mgr(2);
+  UpllDbConnMgr::RoConnStats stats;
+  DalOdbcMgr *dom = NULL, *held = NULL;
+
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom));
+  uint32_t idx = SlotOf(mgr, dom);
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom));
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&held));
+
+  // Idle connections are closed at once, busy ones on their release
+  mgr.TerminateAllRoConns_NoLock();
+  EXPECT_EQ(1U, mgr.active_ro_conns_cnt_);
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(held));
+  EXPECT_EQ(0U, mgr.active_ro_conns_cnt_);
+  EXPECT_TRUE(mgr.ro_slots_[idx].conn == NULL);
+
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom));
+  EXPECT_EQ(idx, SlotOf(mgr, dom));
+  EXPECT_EQ(mgr.ro_conn_gen_, mgr.ro_slots_[idx].conn_gen);
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom));
+
+  mgr.GetRoConnStats(&stats);
+  EXPECT_EQ(2U, stats.reconnects);
+  EXPECT_EQ(2U, FreeSlots(mgr));
+}
+
+TEST_F(DbConnMgrRoTest, ConnErrorClosesIdleConns) {
+  UpllDbConnMgr mgr(3);
+  UpllDbConnMgr::RoConnStats stats;
+  DalOdbcMgr *dom[3];
+
+  for (uint32_t i = 0; i < 3; i++) {
+    ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom[i]));
+  }
+  EXPECT_EQ(3U, mgr.active_ro_conns_cnt_);
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom[1]));
+
+  dom[0]->conn_state_ = uudal::kDalDbDisconnected;
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom[0]));
+  // Only the connection still in use survives until its release
+  EXPECT_EQ(1U, mgr.active_ro_conns_cnt_);
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom[2]));
+  EXPECT_EQ(0U, mgr.active_ro_conns_cnt_);
+
+  mgr.GetRoConnStats(&stats);
+  EXPECT_EQ(3U, stats.reconnects);
+  EXPECT_EQ(3U, FreeSlots(mgr));
+}
+
+TEST_F(DbConnMgrRoTest, OpenFailureFreesSlot) {
+  UpllDbConnMgr mgr(2);
+  DalOdbcMgr *dom = NULL;
+
+  DalOdbcMgr::clearStubData();
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::INIT, uudal::kDalRcSuccess);
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::CONNECT,
+                                 uudal::kDalRcConnNotAvailable);
+  EXPECT_EQ(UPLL_RC_ERR_RESOURCE_DISCONNECTED, mgr.AcquireRoConn(&dom));
+  EXPECT_TRUE(dom == NULL);
+  EXPECT_EQ(0U, mgr.active_ro_conns_cnt_);
+  EXPECT_EQ(2U, FreeSlots(mgr));
+}
+
+TEST_F(DbConnMgrRoTest, ReleaseUnknownConn) {
+  UpllDbConnMgr mgr(2);
+  DalOdbcMgr other;
+
+  EXPECT_EQ(UPLL_RC_ERR_GENERIC, mgr.ReleaseRoConn(&other));
+}
+
+struct RoWaiterArg {
+  UpllDbConnMgr *mgr;
+  DalOdbcMgr *dom;
+  upll_rc_t urc;
+  uint32_t done;
+};
+
+static void *RoWaiter(void *arg) {
+  RoWaiterArg *wa = reinterpret_cast<RoWaiterArg *>(arg);
+  wa->urc = wa->mgr->AcquireRoConn(&wa->dom);
+  pfc_atomic_swap_uint32(&wa->done, 1);
+  return NULL;
+}
+
+TEST_F(DbConnMgrRoTest, ExhaustionWaitsForRelease) {
+  UpllDbConnMgr mgr(2);
+  UpllDbConnMgr::RoConnStats stats;
+  DalOdbcMgr *dom[2];
+  RoWaiterArg wa = { &mgr, NULL, UPLL_RC_ERR_GENERIC, 0 };
+  pthread_t thread;
+
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom[0]));
+  ASSERT_EQ(UPLL_RC_SUCCESS, mgr.AcquireRoConn(&dom[1]));
+  ASSERT_EQ(0, pthread_create(&thread, NULL, RoWaiter, &wa));
+
+  // The waiter sleeps on the condition until a slot is given back
+  for (int i = 0; i < 1000 && mgr.ro_waiters_ == 0; i++) {
+    usleep(1000);
+  }
+  EXPECT_EQ(1U, mgr.ro_waiters_);
+  usleep(10000);
+  EXPECT_EQ(0U, wa.done);
+
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom[1]));
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  EXPECT_EQ(UPLL_RC_SUCCESS, wa.urc);
+  EXPECT_EQ(dom[1], wa.dom);
+  EXPECT_EQ(0U, mgr.ro_waiters_);
+
+  mgr.GetRoConnStats(&stats);
+  EXPECT_EQ(3U, stats.acquired);
+  EXPECT_EQ(2U, stats.wait_hist[0]);
+  uint64_t waited = 0;
+  for (uint32_t i = 1; i < unc::upll::config_momgr::kRoWaitHistBuckets; i++) {
+    waited += stats.wait_hist[i];
+  }
+  EXPECT_EQ(1U, waited);
+
+  // The waiter's acquisition is released from the main thread
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(wa.dom));
+  EXPECT_EQ(UPLL_RC_SUCCESS, mgr.ReleaseRoConn(dom[0]));
+  EXPECT_EQ(2U, FreeSlots(mgr));
+}
+
+static const uint32_t kRoSlots = 3;
+static const uint32_t kRoThreads = 8;
+static const uint32_t kRoLoops = 200;
+
+struct RoWorkerArg {
+  UpllDbConnMgr *mgr;
+  uint32_t *owners;  // threads holding each slot
+  uint32_t errors;
+};
+
+static void *RoWorker(void *arg) {
+  RoWorkerArg *wa = reinterpret_cast<RoWorkerArg *>(arg);
+  for (uint32_t i = 0; i < kRoLoops; i++) {
+    DalOdbcMgr *dom = NULL;
+    if (wa->mgr->AcquireRoConn(&dom) != UPLL_RC_SUCCESS) {
+      pfc_atomic_inc_uint32(&wa->errors);
+      continue;
+    }
+    uint32_t idx = wa->mgr->FindRoSlot(dom);
+    if (idx >= kRoSlots ||
+        pfc_atomic_inc_uint32_old(&wa->owners[idx]) != 0) {
+      pfc_atomic_inc_uint32(&wa->errors);
+    }
+    if ((i % 7) == 0) {
+      usleep(100);
+    }
+    if (idx < kRoSlots) {
+      pfc_atomic_dec_uint32(&wa->owners[idx]);
+    }
+    if (wa->mgr->ReleaseRoConn(dom) != UPLL_RC_SUCCESS) {
+      pfc_atomic_inc_uint32(&wa->errors);
+    }
+  }
+  return NULL;
+}
+
+TEST_F(DbConnMgrRoTest, ConcurrentAcquireRelease) {
+  UpllDbConnMgr mgr(kRoSlots);
+  UpllDbConnMgr::RoConnStats stats;
+  uint32_t owners[kRoSlots] = { 0 };
+  RoWorkerArg wa = { &mgr, owners, 0 };
+  std::vector<pthread_t> threads(kRoThreads);
+
+  // More workers than slots, so the slots are both contended and reused
+  for (uint32_t i = 0; i < kRoThreads; i++) {
+    ASSERT_EQ(0, pthread_create(&threads[i], NULL, RoWorker, &wa));
+  }
+  for (uint32_t i = 0; i < kRoThreads; i++) {
+    ASSERT_EQ(0, pthread_join(threads[i], NULL));
+  }
+
+  EXPECT_EQ(0U, wa.errors);
+  EXPECT_EQ(0U, mgr.ro_waiters_);
+  EXPECT_EQ(kRoSlots, FreeSlots(mgr));
+  EXPECT_LE(mgr.active_ro_conns_cnt_, kRoSlots);
+
+  mgr.GetRoConnStats(&stats);
+  EXPECT_EQ(static_cast<uint64_t>(kRoThreads) * kRoLoops, stats.acquired);
+  EXPECT_LE(stats.reconnects, static_cast<uint64_t>(kRoSlots));
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < unc::upll::config_momgr::kRoWaitHistBuckets; i++) {
+    total += stats.wait_hist[i];
+  }
+  EXPECT_EQ(stats.acquired, total);
+}
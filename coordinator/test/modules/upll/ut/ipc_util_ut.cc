@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <gtest/gtest.h>
+#include <pfc/ipc_struct.h>
+#include <unc/keytype.h>
+#include <ipc_util.hh>
+#include "../ut_util.hh"
+
+using namespace unc::upll::ipc_util;
+using namespace unc::upll::test;
+
+/*
+ * Number of ConfigKeyVals in the chains built by the microbenchmark.
+ */
+#define CKV_BENCH_CHAIN_LEN  100000U
+
+class IpcUtilTest
+: public UpllTestEnv {
+};
+
+static uint64_t GetTimeUsec() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (static_cast<uint64_t>(ts.tv_sec) * 1000000ULL) +
+      (ts.tv_nsec / 1000);
+}
+
+static ConfigKeyVal *NewVtnCkv(uint32_t index) {
+  key_vtn_t *key = ConfigKeyVal::Malloc<key_vtn_t>();
+  snprintf(reinterpret_cast<char *>(key->vtn_name), sizeof(key->vtn_name),
+           "VTN_%u", index);
+  val_vtn_t *val = ConfigKeyVal::Malloc<val_vtn_t>();
+  val->valid[UPLL_IDX_DESC_VTN] = UNC_VF_VALID;
+  return new ConfigKeyVal(UNC_KT_VTN, IpctSt::kIpcStKeyVtn, key,
+                          new ConfigVal(IpctSt::kIpcStValVtn, val));
+}
+
+static void CheckVtnChain(ConfigKeyVal *head, uint32_t len) {
+  uint32_t index = 0;
+  char name[32];
+  for (ConfigKeyVal *ckv = head; ckv; ckv = ckv->get_next_cfg_key_val()) {
+    snprintf(name, sizeof(name), "VTN_%u", index % 1000);
+    key_vtn_t *key = reinterpret_cast<key_vtn_t *>(ckv->get_key());
+    ASSERT_TRUE(key != NULL);
+    ASSERT_STREQ(name, reinterpret_cast<char *>(key->vtn_name));
+    ASSERT_TRUE(ckv->get_cfg_val() != NULL);
+    index++;
+  }
+  ASSERT_EQ(len, index);
+}
+
+TEST_F(IpcUtilTest, ChainAppend) {
+  ConfigKeyValChain chain;
+  EXPECT_TRUE(chain.empty());
+  chain.Append(NULL);
+  EXPECT_TRUE(chain.empty());
+
+  ConfigKeyVal *first = NewVtnCkv(0);
+  chain.Append(first);
+  EXPECT_EQ(first, chain.head());
+  EXPECT_EQ(first, chain.tail());
+  EXPECT_EQ(1U, chain.size());
+
+  // Appending a chain moves tail to its last element
+  ConfigKeyVal *sub = NewVtnCkv(1);
+  ConfigKeyVal *sub_tail = NewVtnCkv(2);
+  sub->AppendCfgKeyVal(sub_tail);
+  chain.Append(sub);
+  EXPECT_EQ(first, chain.head());
+  EXPECT_EQ(sub_tail, chain.tail());
+  EXPECT_EQ(3U, chain.size());
+  CheckVtnChain(chain.head(), 3);
+
+  ConfigKeyVal *head = chain.Release();
+  EXPECT_TRUE(chain.empty());
+  EXPECT_EQ(0U, chain.size());
+  EXPECT_EQ(first, head);
+  delete head;
+}
+
+TEST_F(IpcUtilTest, ArenaDupKeyVal) {
+  ConfigKeyVal *orig = NewVtnCkv(7);
+  ConfigKeyValArena arena;
+
+  ConfigKeyVal *dup = orig->DupKeyVal(&arena);
+  ASSERT_TRUE(dup != NULL);
+  EXPECT_NE(orig->get_key(), dup->get_key());
+  EXPECT_EQ(0, memcmp(orig->get_key(), dup->get_key(), sizeof(key_vtn_t)));
+  ASSERT_TRUE(dup->get_cfg_val() != NULL);
+  EXPECT_EQ(0, memcmp(orig->get_cfg_val()->get_val(),
+                      dup->get_cfg_val()->get_val(), sizeof(val_vtn_t)));
+  EXPECT_EQ(1U, arena.get_num_blocks());
+  EXPECT_LE(sizeof(key_vtn_t) + sizeof(val_vtn_t),
+            arena.get_allocated_bytes());
+
+  // Unlinked val is owned by the caller, so it must not be arena memory
+  void *val = dup->get_cfg_val()->GetValAndUnlink();
+  ASSERT_TRUE(val != NULL);
+  EXPECT_EQ(0, memcmp(orig->get_cfg_val()->get_val(), val,
+                      sizeof(val_vtn_t)));
+  free(val);
+
+  // SetKey replaces the arena key by a Malloc'ed key
+  dup->SetKey(IpctSt::kIpcStKeyVtn, ConfigKeyVal::Malloc<key_vtn_t>());
+  delete dup;
+  delete orig;
+}
+
+// Appending one by one and chain by chain keeps tail on the last element
+// and the elements in append order
+TEST_F(IpcUtilTest, ChainAppendOrder) {
+  const uint32_t len = 1000;
+  ConfigKeyValChain chain;
+  uint32_t index = 0;
+  while (index < len) {
+    ConfigKeyVal *ckv = NewVtnCkv(index++);
+    ConfigKeyVal *last = ckv;
+    // Every third append is a sub chain of two
+    if ((index % 3) == 0 && index < len) {
+      last = NewVtnCkv(index++);
+      ckv->AppendCfgKeyVal(last);
+    }
+    chain.Append(ckv);
+    ASSERT_EQ(last, chain.tail());
+    ASSERT_TRUE(chain.tail()->get_next_cfg_key_val() == NULL);
+    ASSERT_EQ(index, chain.size());
+  }
+  CheckVtnChain(chain.head(), len);
+
+  // Same order as appending each element on the head
+  ConfigKeyVal *head = NULL;
+  for (uint32_t i = 0; i < len; i++) {
+    ConfigKeyVal *ckv = NewVtnCkv(i);
+    if (head == NULL) {
+      head = ckv;
+    } else {
+      head->AppendCfgKeyVal(ckv);
+    }
+  }
+  ConfigKeyVal *ckv1 = chain.head();
+  ConfigKeyVal *ckv2 = head;
+  while (ckv1 != NULL && ckv2 != NULL) {
+    EXPECT_EQ(0, memcmp(ckv1->get_key(), ckv2->get_key(), sizeof(key_vtn_t)));
+    ckv1 = ckv1->get_next_cfg_key_val();
+    ckv2 = ckv2->get_next_cfg_key_val();
+  }
+  EXPECT_TRUE(ckv1 == NULL);
+  EXPECT_TRUE(ckv2 == NULL);
+  delete head;
+  chain.Clear();
+  EXPECT_TRUE(chain.empty());
+  EXPECT_TRUE(chain.tail() == NULL);
+}
+
+// Microbenchmark: dup a long chain with Malloc'ed key/val structures
+// versus structures allocated from a ConfigKeyValArena
+TEST_F(IpcUtilTest, BenchArenaDup) {
+  ConfigKeyValChain src;
+  for (uint32_t i = 0; i < CKV_BENCH_CHAIN_LEN; i++) {
+    src.Append(NewVtnCkv(i % 1000));
+  }
+
+  uint64_t start = GetTimeUsec();
+  ConfigKeyValChain malloc_chain;
+  for (ConfigKeyVal *ckv = src.head(); ckv;
+       ckv = ckv->get_next_cfg_key_val()) {
+    malloc_chain.Append(ckv->DupKeyVal());
+  }
+  uint64_t built = GetTimeUsec();
+  CheckVtnChain(malloc_chain.head(), CKV_BENCH_CHAIN_LEN);
+  malloc_chain.Clear();
+  uint64_t malloc_build = built - start;
+  uint64_t malloc_free = GetTimeUsec() - built;
+
+  start = GetTimeUsec();
+  ConfigKeyValArena *arena = new ConfigKeyValArena();
+  ConfigKeyValChain arena_chain;
+  for (ConfigKeyVal *ckv = src.head(); ckv;
+       ckv = ckv->get_next_cfg_key_val()) {
+    arena_chain.Append(ckv->DupKeyVal(arena));
+  }
+  built = GetTimeUsec();
+  CheckVtnChain(arena_chain.head(), CKV_BENCH_CHAIN_LEN);
+  size_t arena_bytes = arena->get_allocated_bytes();
+  size_t arena_blocks = arena->get_num_blocks();
+  // ckvs must go before the arena that holds their structures
+  arena_chain.Clear();
+  delete arena;
+  uint64_t arena_build = built - start;
+  uint64_t arena_free = GetTimeUsec() - built;
+
+  EXPECT_LE(CKV_BENCH_CHAIN_LEN * (sizeof(key_vtn_t) + sizeof(val_vtn_t)),
+            arena_bytes);
+  printf("%u ckvs: Malloc dup %llu us free %llu us, "
+         "arena dup %llu us free %llu us (%zu bytes in %zu blocks)\n",
+         CKV_BENCH_CHAIN_LEN,
+         static_cast<unsigned long long>(malloc_build),
+         static_cast<unsigned long long>(malloc_free),
+         static_cast<unsigned long long>(arena_build),
+         static_cast<unsigned long long>(arena_free),
+         arena_bytes, arena_blocks);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <vbr_momgr.hh>
+#include <config_mgr.hh>
+#include <dal_odbc_mgr.hh>
+#include <dal_dml_intf.hh>
+#include "ut_util.hh"
+
+using namespace unc::upll;
+using namespace unc::upll::dal;
+using namespace unc::upll::kt_momgr;
+using namespace unc::upll::test;
+
+class TxChangeLogTest : public UpllTestEnv {
+  protected:
+    virtual void SetUp() {
+      UpllTestEnv::SetUp();
+      DalOdbcMgr::stub_setResultcode(DalOdbcMgr::CLOSE_CURSOR, kDalRcSuccess);
+    }
+
+    virtual void TearDown() {
+      MoMgrImpl::StopTxChangeLog();
+      MoMgrImpl::StopRenameCache();
+      UpllTestEnv::TearDown();
+    }
+
+    // Changes read by GetTxChangeLog() of UNC_KT_VBRIDGE
+    MoMgrImpl::TxChangeLog *ReadLog(DalResultCode rc,
+                                    const int16_t *changes, size_t n) {
+      DalOdbcMgr::stub_setResultcode(DalOdbcMgr::GET_CHANGED_RECORDS, rc);
+      DalOdbcMgr::stub_setChangedRecords(
+          std::vector<int16_t>(changes, changes + n));
+      return vbrmomgr_.GetTxChangeLog(UNC_KT_VBRIDGE, getDalDmlIntf());
+    }
+
+    static ConfigKeyVal *NewVbrKey() {
+      key_vbr *key(ZALLOC_TYPE(key_vbr));
+      strncpy(reinterpret_cast<char *>(key->vtn_key.vtn_name), "VTN_1",
+              sizeof(key->vtn_key.vtn_name));
+      strncpy(reinterpret_cast<char *>(key->vbridge_name), "VBR_1",
+              sizeof(key->vbridge_name));
+      return new ConfigKeyVal(UNC_KT_VBRIDGE, IpctSt::kIpcStKeyVbr, key);
+    }
+
+    VbrMoMgr vbrmomgr_;
+};
+
+/*
+ * The changes are read once and kept by operation, each updated row with
+ * the running row it replaces.
+ */
+TEST_F(TxChangeLogTest, ReadOnce_ByOperation) {
+  MoMgrImpl::StartTxChangeLog();
+  const int16_t changes[] = { kDalChangeDeleted, kDalChangeCreated,
+                              kDalChangeCreated, kDalChangeUpdated,
+                              kDalChangeUpdatedOld };
+  MoMgrImpl::TxChangeLog *log = ReadLog(kDalRcSuccess, changes, 5);
+  ASSERT_TRUE(log != NULL);
+  EXPECT_EQ(1U, log->changes[MoMgrImpl::TxChangeLogIndex(UNC_OP_DELETE)]
+            .size());
+  EXPECT_EQ(2U, log->changes[MoMgrImpl::TxChangeLogIndex(UNC_OP_CREATE)]
+            .size());
+  EXPECT_EQ(1U, log->changes[MoMgrImpl::TxChangeLogIndex(UNC_OP_UPDATE)]
+            .size());
+
+  // The next phases use the same log without reading again
+  EXPECT_EQ(log, ReadLog(kDalRcSuccess, changes, 5));
+
+  ConfigKeyVal *req = NULL, *nreq = NULL;
+  EXPECT_EQ(UPLL_RC_SUCCESS,
+            MoMgrImpl::NextTxChange(log, UNC_OP_UPDATE, req, nreq));
+  EXPECT_TRUE(req != NULL);
+  EXPECT_TRUE(nreq != NULL);
+  EXPECT_EQ(UPLL_RC_ERR_NO_SUCH_INSTANCE,
+            MoMgrImpl::NextTxChange(log, UNC_OP_UPDATE, req, nreq));
+  EXPECT_TRUE(req == NULL);
+  EXPECT_TRUE(nreq == NULL);
+
+  EXPECT_EQ(UPLL_RC_SUCCESS,
+            MoMgrImpl::NextTxChange(log, UNC_OP_CREATE, req, nreq));
+  EXPECT_TRUE(req != NULL);
+  EXPECT_TRUE(nreq == NULL);
+  DELETE_IF_NOT_NULL(req);
+}
+
+/*
+ * A table which is not dirty has an empty log.
+ */
+TEST_F(TxChangeLogTest, NotChanged_EmptyLog) {
+  MoMgrImpl::StartTxChangeLog();
+  MoMgrImpl::TxChangeLog *log = ReadLog(kDalRcRecordNotFound, NULL, 0);
+  ASSERT_TRUE(log != NULL);
+  ConfigKeyVal *req = NULL, *nreq = NULL;
+  EXPECT_EQ(UPLL_RC_ERR_NO_SUCH_INSTANCE,
+            MoMgrImpl::NextTxChange(log, UNC_OP_DELETE, req, nreq));
+  EXPECT_EQ(UPLL_RC_ERR_NO_SUCH_INSTANCE,
+            MoMgrImpl::NextTxChange(log, UNC_OP_CREATE, req, nreq));
+  EXPECT_EQ(UPLL_RC_ERR_NO_SUCH_INSTANCE,
+            MoMgrImpl::NextTxChange(log, UNC_OP_UPDATE, req, nreq));
+}
+
+/*
+ * If the changes cannot be read in one query, DiffConfigDB() reads them
+ * for all the phases.
+ */
+TEST_F(TxChangeLogTest, ReadFailure_UsesDiff) {
+  MoMgrImpl::StartTxChangeLog();
+  EXPECT_TRUE(ReadLog(kDalRcGeneralError, NULL, 0) == NULL);
+
+  DalOdbcMgr::clearStubData();
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::CLOSE_CURSOR, kDalRcSuccess);
+  const int16_t changes[] = { kDalChangeCreated };
+  EXPECT_TRUE(ReadLog(kDalRcSuccess, changes, 1) == NULL);
+}
+
+/*
+ * Updated and running rows not coming in pairs are not used.
+ */
+TEST_F(TxChangeLogTest, UnpairedRows_UsesDiff) {
+  MoMgrImpl::StartTxChangeLog();
+  const int16_t old_only[] = { kDalChangeUpdatedOld };
+  EXPECT_TRUE(ReadLog(kDalRcSuccess, old_only, 1) == NULL);
+
+  MoMgrImpl::StopTxChangeLog();
+  MoMgrImpl::StartTxChangeLog();
+  const int16_t new_only[] = { kDalChangeUpdated, kDalChangeUpdated,
+                               kDalChangeUpdatedOld };
+  EXPECT_TRUE(ReadLog(kDalRcSuccess, new_only, 3) == NULL);
+}
+
+/*
+ * Outside of StartTxChangeLog() and StopTxChangeLog() nothing is kept.
+ */
+TEST_F(TxChangeLogTest, NotStarted_NoLog) {
+  const int16_t changes[] = { kDalChangeDeleted };
+  EXPECT_TRUE(ReadLog(kDalRcSuccess, changes, 1) == NULL);
+
+  MoMgrImpl::StartTxChangeLog();
+  MoMgrImpl::StopTxChangeLog();
+  EXPECT_TRUE(ReadLog(kDalRcSuccess, changes, 1) == NULL);
+}
+
+/*
+ * Results read on any connection of the commit are shared while no
+ * connection writes, commits or rolls back, i.e. while their write
+ * generations do not change. Results read before a change are not stored.
+ */
+TEST_F(TxChangeLogTest, RenameCache_WriteGeneration) {
+  DalOdbcMgr rw, ro;
+  rw.write_count_ = 0;
+  std::vector<DalOdbcMgr *> conns;
+  conns.push_back(&rw);
+  conns.push_back(&ro);
+  MoMgrImpl::StartRenameCache(conns);
+
+  ConfigKeyVal *ikey = NewVbrKey();
+  ConfigKeyVal *okey = NewVbrKey();
+  SET_USER_DATA_FLAGS(okey, 0x01);
+  std::string rw_id, ro_id;
+  ASSERT_TRUE(vbrmomgr_.GetRenameCacheId(ikey, UPLL_DT_CANDIDATE, &rw,
+                                         &rw_id));
+  ASSERT_TRUE(vbrmomgr_.GetRenameCacheId(ikey, UPLL_DT_CANDIDATE, &ro,
+                                         &ro_id));
+  EXPECT_EQ(rw_id, ro_id);
+
+  uint8_t rename = 0;
+  uint64_t epoch = 0;
+  EXPECT_FALSE(MoMgrImpl::LookupRenameCache(ro_id, ikey, rename, &epoch));
+  MoMgrImpl::StoreRenameCache(ro_id, okey, epoch);
+  EXPECT_TRUE(MoMgrImpl::LookupRenameCache(rw_id, ikey, rename, &epoch));
+
+  // A write on any connection drops the results
+  ro.stub_setWriteGeneration(1);
+  EXPECT_FALSE(MoMgrImpl::LookupRenameCache(rw_id, ikey, rename, &epoch));
+
+  // The result of a read overlapping a write is not stored
+  rw.stub_setWriteGeneration(1);
+  MoMgrImpl::StoreRenameCache(rw_id, okey, epoch);
+  EXPECT_FALSE(MoMgrImpl::LookupRenameCache(rw_id, ikey, rename, &epoch));
+  MoMgrImpl::StoreRenameCache(rw_id, okey, epoch);
+  EXPECT_TRUE(MoMgrImpl::LookupRenameCache(rw_id, ikey, rename, &epoch));
+
+  MoMgrImpl::StopRenameCache();
+  EXPECT_FALSE(vbrmomgr_.GetRenameCacheId(ikey, UPLL_DT_CANDIDATE, &rw,
+                                          &rw_id));
+  delete ikey;
+  delete okey;
+}
+
+/*
+ * The RO connections do not share the results of the RW connection having
+ * uncommitted writes, and other connections are not cached.
+ */
+TEST_F(TxChangeLogTest, RenameCache_PendingWrites) {
+  DalOdbcMgr rw, ro, other;
+  rw.write_count_ = 1;
+  std::vector<DalOdbcMgr *> conns;
+  conns.push_back(&rw);
+  conns.push_back(&ro);
+  MoMgrImpl::StartRenameCache(conns);
+
+  ConfigKeyVal *ikey = NewVbrKey();
+  std::string rw_id, ro_id, other_id;
+  ASSERT_TRUE(vbrmomgr_.GetRenameCacheId(ikey, UPLL_DT_CANDIDATE, &rw,
+                                         &rw_id));
+  ASSERT_TRUE(vbrmomgr_.GetRenameCacheId(ikey, UPLL_DT_CANDIDATE, &ro,
+                                         &ro_id));
+  EXPECT_NE(rw_id, ro_id);
+  EXPECT_FALSE(vbrmomgr_.GetRenameCacheId(ikey, UPLL_DT_CANDIDATE, &other,
+                                          &other_id));
+  delete ikey;
+}
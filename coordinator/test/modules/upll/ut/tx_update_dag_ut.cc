@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <boost/bind.hpp>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include <key_tree.hh>
+#include <tx_update_util.hh>
+
+using unc::upll::keytree::KeyTree;
+using unc::upll::ipc_util::ConfigKeyVal;
+using unc::upll::tx_update_util::TxUpdateDag;
+
+// Records the key types run by TxUpdateDag
+class TxUpdateDagTest : public ::testing::Test {
+  protected:
+    TxUpdateDagTest() : ktree_(UNC_KT_ROOT) {}
+
+    virtual void SetUp() {
+      // ROOT -+- FLOWLIST - FLOWLIST_ENTRY
+      //       +- POLICING_PROFILE - POLICING_PROFILE_ENTRY
+      //       +- VTN -+- VBRIDGE - VBR_IF
+      //               +- VROUTER - VRT_IF
+      //               +- VLINK
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_ROOT, UNC_KT_FLOWLIST));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_FLOWLIST, UNC_KT_FLOWLIST_ENTRY));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_ROOT, UNC_KT_POLICING_PROFILE));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_POLICING_PROFILE,
+                                    UNC_KT_POLICING_PROFILE_ENTRY));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_ROOT, UNC_KT_VTN));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_VTN, UNC_KT_VBRIDGE));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_VBRIDGE, UNC_KT_VBR_IF));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_VTN, UNC_KT_VROUTER));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_VROUTER, UNC_KT_VRT_IF));
+      ASSERT_TRUE(ktree_.AddKeyType(UNC_KT_VTN, UNC_KT_VLINK));
+      ktree_.PrepareOrderedList();
+      ASSERT_TRUE(ktree_.AddDependency(UNC_KT_POLICING_PROFILE_ENTRY,
+                                       UNC_KT_FLOWLIST_ENTRY));
+      ASSERT_TRUE(ktree_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VBRIDGE));
+      ASSERT_TRUE(ktree_.AddSubtreeDependency(UNC_KT_VLINK, UNC_KT_VROUTER));
+    }
+
+    virtual void TearDown() {
+      fail_kts_.clear();
+      runs_.clear();
+    }
+
+    upll_rc_t Handler(unc_key_type_t kt, uint32_t conn_idx,
+                      ConfigKeyVal **err_ckv) {
+      runs_.push_back(std::make_pair(kt, conn_idx));
+      std::map<unc_key_type_t, upll_rc_t>::iterator it = fail_kts_.find(kt);
+      if (it == fail_kts_.end()) {
+        return UPLL_RC_SUCCESS;
+      }
+      *err_ckv = new ConfigKeyVal(kt);
+      return it->second;
+    }
+
+    upll_rc_t Run(TxUpdateDag *dag, uint32_t nconns, ConfigKeyVal **err_ckv) {
+      pfc::core::TaskQueue *taskq = pfc::core::TaskQueue::create(nconns);
+      upll_rc_t urc = dag->Run(taskq, nconns,
+                               boost::bind(&TxUpdateDagTest::Handler, this,
+                                           _1, _2, _3),
+                               err_ckv);
+      delete taskq;
+      return urc;
+    }
+
+    // Position of kt in runs_, or the number of runs if not run
+    size_t RunIndex(unc_key_type_t kt) {
+      for (size_t i = 0; i < runs_.size(); i++) {
+        if (runs_[i].first == kt) {
+          return i;
+        }
+      }
+      return runs_.size();
+    }
+
+    KeyTree ktree_;
+    std::map<unc_key_type_t, upll_rc_t> fail_kts_;
+    std::vector<std::pair<unc_key_type_t, uint32_t> > runs_;
+};
+
+/*
+ * With one connection the key types run in the serial order.
+ */
+TEST_F(TxUpdateDagTest, OneConn_SerialOrder) {
+  const std::list<unc_key_type_t> *lst = ktree_.get_preorder_list();
+  TxUpdateDag dag(*lst, ktree_, false);
+  ConfigKeyVal *err_ckv = NULL;
+
+  EXPECT_EQ(UPLL_RC_SUCCESS, Run(&dag, 1, &err_ckv));
+  EXPECT_TRUE(err_ckv == NULL);
+  ASSERT_EQ(lst->size(), runs_.size());
+  std::list<unc_key_type_t>::const_iterator it = lst->begin();
+  for (size_t i = 0; i < runs_.size(); i++, ++it) {
+    EXPECT_EQ(*it, runs_[i].first);
+    EXPECT_EQ(0U, runs_[i].second);
+  }
+}
+
+/*
+ * In reverse mode the key types run in the reverse serial order.
+ */
+TEST_F(TxUpdateDagTest, OneConn_ReverseOrder) {
+  const std::list<unc_key_type_t> *lst = ktree_.get_reverse_postorder_list();
+  TxUpdateDag dag(*lst, ktree_, true);
+
+  EXPECT_EQ(UPLL_RC_SUCCESS, Run(&dag, 1, NULL));
+  ASSERT_EQ(lst->size(), runs_.size());
+  std::list<unc_key_type_t>::const_iterator it = lst->begin();
+  for (size_t i = 0; i < runs_.size(); i++, ++it) {
+    EXPECT_EQ(*it, runs_[i].first);
+  }
+}
+
+/*
+ * The key types are run on the dispatched connections, and every
+ * key type runs after the key types it depends on, in the reverse mode
+ * before them.
+ */
+TEST_F(TxUpdateDagTest, MultiConn_Dependencies) {
+  for (int reverse = 0; reverse < 2; reverse++) {
+    const std::list<unc_key_type_t> *lst = (reverse) ?
+        ktree_.get_reverse_postorder_list() : ktree_.get_preorder_list();
+    TxUpdateDag dag(*lst, ktree_, reverse);
+    runs_.clear();
+
+    EXPECT_EQ(UPLL_RC_SUCCESS, Run(&dag, 3, NULL));
+    ASSERT_EQ(lst->size(), runs_.size());
+    std::set<uint32_t> conns;
+    for (size_t i = 0; i < runs_.size(); i++) {
+      unc_key_type_t kt = runs_[i].first;
+      EXPECT_GT(3U, runs_[i].second);
+      conns.insert(runs_[i].second);
+      EXPECT_EQ(i, RunIndex(kt));
+      const std::set<unc_key_type_t> *deps = ktree_.get_dependencies(kt);
+      ASSERT_TRUE(deps != NULL);
+      for (std::set<unc_key_type_t>::const_iterator it = deps->begin();
+           it != deps->end(); ++it) {
+        if (reverse) {
+          EXPECT_GT(RunIndex(*it), i);
+        } else {
+          EXPECT_LT(RunIndex(*it), i);
+        }
+      }
+    }
+    // The key types are dispatched to the other connections
+    EXPECT_LT(conns.count(0), conns.size());
+  }
+}
+
+/*
+ * Pinned key types run only on connection 0.
+ */
+TEST_F(TxUpdateDagTest, MultiConn_Pinned) {
+  const std::list<unc_key_type_t> *lst = ktree_.get_preorder_list();
+  TxUpdateDag dag(*lst, ktree_, false);
+  dag.PinToFirstConn(UNC_KT_FLOWLIST);
+  dag.PinToFirstConn(UNC_KT_FLOWLIST_ENTRY);
+  dag.PinToFirstConn(UNC_KT_VTN);
+
+  EXPECT_EQ(UPLL_RC_SUCCESS, Run(&dag, 3, NULL));
+  ASSERT_EQ(lst->size(), runs_.size());
+  for (size_t i = 0; i < runs_.size(); i++) {
+    if (runs_[i].first == UNC_KT_FLOWLIST ||
+        runs_[i].first == UNC_KT_FLOWLIST_ENTRY ||
+        runs_[i].first == UNC_KT_VTN) {
+      EXPECT_EQ(0U, runs_[i].second);
+    }
+  }
+  EXPECT_LT(RunIndex(UNC_KT_FLOWLIST_ENTRY),
+            RunIndex(UNC_KT_POLICING_PROFILE_ENTRY));
+}
+
+/*
+ * No key type is started after a failure, and the result of the failed key
+ * type coming first in the order is returned with its err_ckv.
+ */
+TEST_F(TxUpdateDagTest, MultiConn_Failure) {
+  const std::list<unc_key_type_t> *lst = ktree_.get_preorder_list();
+  TxUpdateDag dag(*lst, ktree_, false);
+  fail_kts_[UNC_KT_FLOWLIST_ENTRY] = UPLL_RC_ERR_CFG_SEMANTIC;
+  fail_kts_[UNC_KT_VBRIDGE] = UPLL_RC_ERR_GENERIC;
+  ConfigKeyVal *err_ckv = NULL;
+
+  upll_rc_t urc = Run(&dag, 3, &err_ckv);
+  size_t nruns = runs_.size();
+  ASSERT_LT(0U, nruns);
+  EXPECT_LT(nruns, lst->size());
+  EXPECT_NE(UPLL_RC_SUCCESS, urc);
+  ASSERT_TRUE(err_ckv != NULL);
+  EXPECT_EQ(UPLL_RC_ERR_CFG_SEMANTIC == urc, UNC_KT_FLOWLIST_ENTRY ==
+            err_ckv->get_key_type());
+
+  // Neither the dependents nor the key types after the failure run
+  EXPECT_EQ(nruns, RunIndex(UNC_KT_POLICING_PROFILE_ENTRY));
+  EXPECT_EQ(nruns, RunIndex(UNC_KT_VLINK));
+  if (RunIndex(UNC_KT_FLOWLIST_ENTRY) < nruns) {
+    EXPECT_EQ(UPLL_RC_ERR_CFG_SEMANTIC, urc);
+  }
+  delete err_ckv;
+
+  // Without err_ckv the results are released by the DAG
+  runs_.clear();
+  TxUpdateDag dag2(*lst, ktree_, false);
+  EXPECT_EQ(UPLL_RC_ERR_CFG_SEMANTIC, Run(&dag2, 1, NULL));
+  EXPECT_EQ(RunIndex(UNC_KT_FLOWLIST_ENTRY) + 1, runs_.size());
+}
+
+/*
+ * Dependencies are only on the key types which come before in the order.
+ */
+TEST_F(TxUpdateDagTest, KeyTree_AddDependency) {
+  EXPECT_FALSE(ktree_.AddDependency(UNC_KT_FLOWLIST_ENTRY,
+                                    UNC_KT_POLICING_PROFILE_ENTRY));
+  EXPECT_FALSE(ktree_.AddDependency(UNC_KT_VBR_IF, UNC_KT_VBR_IF));
+  EXPECT_FALSE(ktree_.AddDependency(UNC_KT_VBR_IF, UNC_KT_VTUNNEL));
+  EXPECT_FALSE(ktree_.AddSubtreeDependency(UNC_KT_VBR_IF, UNC_KT_VTN));
+  EXPECT_TRUE(ktree_.AddDependency(UNC_KT_VRT_IF, UNC_KT_VBR_IF));
+
+  const std::set<unc_key_type_t> *deps =
+      ktree_.get_dependencies(UNC_KT_VRT_IF);
+  ASSERT_TRUE(deps != NULL);
+  EXPECT_EQ(2U, deps->size());
+  EXPECT_EQ(1U, deps->count(UNC_KT_VROUTER));
+  EXPECT_EQ(1U, deps->count(UNC_KT_VBR_IF));
+  deps = ktree_.get_dependencies(UNC_KT_VTN);
+  ASSERT_TRUE(deps != NULL);
+  EXPECT_TRUE(deps->empty());
+  EXPECT_TRUE(ktree_.get_dependencies(UNC_KT_VTUNNEL) == NULL);
+}
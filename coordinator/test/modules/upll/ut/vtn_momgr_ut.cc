@@ -843,6 +843,102 @@ TEST_F(VtnMoMgrTest, ValidateVtnRename_emptyVal) {
   EXPECT_EQ(UPLL_RC_ERR_CFG_SYNTAX, vtn.ValidateVtnRenameValue(valVtnRename));
 }
 
+static ConfigKeyVal *GetVtnKeyList(const char *name1, const char *name2) {
+  key_vtn *kst1 = ZALLOC_TYPE(key_vtn);
+  strncpy(reinterpret_cast<char *>(kst1->vtn_name), name1, strlen(name1)+1);
+  ConfigKeyVal *ikey = new ConfigKeyVal(UNC_KT_VTN, IpctSt::kIpcStKeyVtn,
+                         kst1, new ConfigVal(IpctSt::kIpcStValVtn,
+                                             ZALLOC_TYPE(val_vtn)));
+  key_vtn *kst2 = ZALLOC_TYPE(key_vtn);
+  strncpy(reinterpret_cast<char *>(kst2->vtn_name), name2, strlen(name2)+1);
+  ikey->AppendCfgKeyVal(UNC_KT_VTN, IpctSt::kIpcStKeyVtn, kst2,
+                        new ConfigVal(IpctSt::kIpcStValVtn,
+                                      ZALLOC_TYPE(val_vtn)));
+  return ikey;
+}
+
+/* UpdateConfigDBBulk() */
+TEST_F(VtnMoMgrTest, UpdateConfigDBBulk_Create) {
+  VtnMoMgr vtn;
+  DalDmlIntf *dmi(getDalDmlIntf());
+  ConfigKeyVal *ikey = GetVtnKeyList("VTN_1", "VTN_2");
+  DbSubOp dbop = { kOpNotRead, kOpMatchNone, kOpInOutNone };
+
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::CREATE_RECORD, kDalRcSuccess);
+  EXPECT_EQ(UPLL_RC_SUCCESS, vtn.UpdateConfigDBBulk(ikey, UPLL_DT_CANDIDATE,
+            UNC_OP_CREATE, dmi, &dbop, TC_CONFIG_GLOBAL, "", MAINTBL));
+
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::CREATE_RECORD,
+                                 kDalRcRecordAlreadyExists);
+  EXPECT_EQ(UPLL_RC_ERR_INSTANCE_EXISTS, vtn.UpdateConfigDBBulk(ikey,
+            UPLL_DT_CANDIDATE, UNC_OP_CREATE, dmi, &dbop, TC_CONFIG_GLOBAL,
+            "", MAINTBL));
+  DalOdbcMgr::clearStubData();
+  delete ikey;
+}
+
+TEST_F(VtnMoMgrTest, UpdateConfigDBBulk_UpdateDefaultDbop) {
+  VtnMoMgr vtn;
+  DalDmlIntf *dmi(getDalDmlIntf());
+  ConfigKeyVal *ikey = GetVtnKeyList("VTN_1", "VTN_2");
+
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::UPDATE_RECORD, kDalRcSuccess);
+  EXPECT_EQ(UPLL_RC_SUCCESS, vtn.UpdateConfigDBBulk(ikey, UPLL_DT_RUNNING,
+            UNC_OP_UPDATE, dmi, NULL, TC_CONFIG_GLOBAL, "", MAINTBL));
+
+  DalOdbcMgr::stub_setResultcode(DalOdbcMgr::UPDATE_RECORD,
+                                 kDalRcRecordNotFound);
+  EXPECT_EQ(UPLL_RC_ERR_NO_SUCH_INSTANCE, vtn.UpdateConfigDBBulk(ikey,
+            UPLL_DT_RUNNING, UNC_OP_UPDATE, dmi, NULL, TC_CONFIG_GLOBAL,
+            "", MAINTBL));
+  DalOdbcMgr::clearStubData();
+  delete ikey;
+}
+
+TEST_F(VtnMoMgrTest, UpdateConfigDBBulk_InvalidOp) {
+  VtnMoMgr vtn;
+  DalDmlIntf *dmi(getDalDmlIntf());
+  ConfigKeyVal *ikey = GetVtnKeyList("VTN_1", "VTN_2");
+
+  EXPECT_EQ(UPLL_RC_ERR_GENERIC, vtn.UpdateConfigDBBulk(ikey,
+            UPLL_DT_CANDIDATE, UNC_OP_DELETE, dmi, NULL, TC_CONFIG_GLOBAL,
+            "", MAINTBL));
+  EXPECT_EQ(UPLL_RC_ERR_GENERIC, vtn.UpdateConfigDBBulk(NULL,
+            UPLL_DT_CANDIDATE, UNC_OP_CREATE, dmi, NULL, TC_CONFIG_GLOBAL,
+            "", MAINTBL));
+  delete ikey;
+}
+
+/* GetDefaultUpdateDbop() */
+TEST_F(VtnMoMgrTest, GetDefaultUpdateDbop) {
+  DbSubOp dbop;
+
+  MoMgrImpl::GetDefaultUpdateDbop(UNC_OP_CREATE, UPLL_DT_CANDIDATE, MAINTBL,
+                                  &dbop);
+  EXPECT_EQ(kOpReadExist, dbop.readop);
+  EXPECT_EQ(kOpMatchNone, dbop.matchop);
+  EXPECT_EQ(kOpInOutFlag | kOpInOutCtrlr | kOpInOutDomain, dbop.inoutop);
+
+  MoMgrImpl::GetDefaultUpdateDbop(UNC_OP_CREATE, UPLL_DT_RUNNING, MAINTBL,
+                                  &dbop);
+  EXPECT_EQ(kOpInOutFlag | kOpInOutCtrlr | kOpInOutDomain | kOpInOutCs,
+            dbop.inoutop);
+
+  MoMgrImpl::GetDefaultUpdateDbop(UNC_OP_UPDATE, UPLL_DT_CANDIDATE, MAINTBL,
+                                  &dbop);
+  EXPECT_EQ(kOpMatchNone, dbop.matchop);
+  EXPECT_EQ(kOpInOutCs, dbop.inoutop);
+
+  MoMgrImpl::GetDefaultUpdateDbop(UNC_OP_UPDATE, UPLL_DT_RUNNING, CTRLRTBL,
+                                  &dbop);
+  EXPECT_EQ(kOpMatchCtrlr | kOpMatchDomain, dbop.matchop);
+  EXPECT_EQ(kOpInOutFlag | kOpInOutCs, dbop.inoutop);
+
+  MoMgrImpl::GetDefaultUpdateDbop(UNC_OP_DELETE, UPLL_DT_CANDIDATE, MAINTBL,
+                                  &dbop);
+  EXPECT_EQ(kOpInOutNone, dbop.inoutop);
+}
+
 #if 0
 // Testing the controller name with minimum value and proper vtn name
 TEST_F(VtnMoMgrTest, ctrlNameMin) {
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <sstream>
+#include "odbc_stub.hh"
+
+using unc::uppl::ut::OdbcStub;
+using unc::uppl::ut::OdbcStubExecution;
+using unc::uppl::ut::OdbcStubParam;
+using unc::uppl::ut::OdbcStubStmt;
+
+namespace unc {
+namespace uppl {
+namespace ut {
+
+std::map<SQLHANDLE, OdbcStubStmt> OdbcStub::stmts;
+std::vector<SQLHANDLE> OdbcStub::freed;
+std::vector<OdbcStubExecution> OdbcStub::executions;
+std::vector<SQLSMALLINT> OdbcStub::end_trans;
+SQLUSMALLINT OdbcStub::cursor_behavior = SQL_CB_PRESERVE;
+std::string OdbcStub::fail_value;
+uintptr_t OdbcStub::next_handle = 0x1000;
+
+void
+OdbcStub::Reset() {
+  stmts.clear();
+  freed.clear();
+  executions.clear();
+  end_trans.clear();
+  cursor_behavior = SQL_CB_PRESERVE;
+  fail_value.clear();
+}
+
+OdbcStubStmt *
+OdbcStub::GetStmt(const SQLHANDLE stmt_handle) {
+  std::map<SQLHANDLE, OdbcStubStmt>::iterator it = stmts.find(stmt_handle);
+  return (it == stmts.end()) ? NULL : &(it->second);
+}
+
+bool
+OdbcStub::IsFreed(const SQLHANDLE handle) {
+  return (std::find(freed.begin(), freed.end(), handle) != freed.end());
+}
+
+uint32_t
+OdbcStub::PrepareCount(const std::string &query) {
+  uint32_t count = 0;
+  for (std::map<SQLHANDLE, OdbcStubStmt>::iterator it = stmts.begin();
+       it != stmts.end(); ++it) {
+    if (it->second.query == query)
+      count += it->second.prepare_count;
+  }
+  return count;
+}
+
+SQLHANDLE
+OdbcStub::NewHandle(const SQLHANDLE input_handle) {
+  next_handle += 0x10;
+  SQLHANDLE handle = reinterpret_cast<SQLHANDLE>(next_handle);
+  OdbcStubStmt &stmt = stmts[handle];
+  stmt.conn = input_handle;
+  stmt.prepare_count = 0;
+  stmt.execute_count = 0;
+  return handle;
+}
+
+// Value of a bound parameter as a string
+static std::string
+ParamValue(const OdbcStubParam &param) {
+  std::ostringstream value;
+  switch (param.sql_type) {
+    case SQL_SMALLINT:
+      value << *static_cast<SQLSMALLINT *>(param.value);
+      break;
+    case SQL_INTEGER:
+      value << *static_cast<SQLINTEGER *>(param.value);
+      break;
+    case SQL_BIGINT:
+      value << *static_cast<SQLUBIGINT *>(param.value);
+      break;
+    default: {
+      const char *str = static_cast<const char *>(param.value);
+      value << std::string(str, strnlen(str, param.buffer_len));
+      break;
+    }
+  }
+  return value.str();
+}
+
+SQLRETURN
+OdbcStub::Execute(const SQLHANDLE stmt_handle) {
+  OdbcStubStmt *stmt = GetStmt(stmt_handle);
+  OdbcStubExecution execution;
+  bool failed = false;
+
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  stmt->execute_count++;
+  stmt->diag_state.clear();
+  execution.stmt = stmt_handle;
+  execution.query = stmt->query;
+  for (std::map<SQLUSMALLINT, OdbcStubParam>::const_iterator it =
+       stmt->params.begin(); it != stmt->params.end(); ++it) {
+    std::string value = ParamValue(it->second);
+    if (!fail_value.empty() &&
+        value.compare(0, fail_value.size(), fail_value) == 0)
+      failed = true;
+    execution.values.push_back(value);
+  }
+  executions.push_back(execution);
+  if (failed) {
+    // Unique violation
+    stmt->diag_state = "23505";
+    return SQL_ERROR;
+  }
+  return SQL_SUCCESS;
+}
+
+}  // namespace ut
+}  // namespace uppl
+}  // namespace unc
+
+extern "C" {
+
+SQLRETURN SQLAllocHandle(SQLSMALLINT HandleType, SQLHANDLE InputHandle,
+                         SQLHANDLE *OutputHandle) {
+  *OutputHandle = OdbcStub::NewHandle(InputHandle);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLFreeHandle(SQLSMALLINT HandleType, SQLHANDLE Handle) {
+  OdbcStub::freed.push_back(Handle);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLFreeStmt(SQLHSTMT StatementHandle, SQLUSMALLINT Option) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  if (Option == SQL_RESET_PARAMS)
+    stmt->params.clear();
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetEnvAttr(SQLHENV EnvironmentHandle, SQLINTEGER Attribute,
+                        SQLPOINTER Value, SQLINTEGER StringLength) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLSetConnectAttr(SQLHDBC ConnectionHandle, SQLINTEGER Attribute,
+                            SQLPOINTER Value, SQLINTEGER StringLength) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLDriverConnect(SQLHDBC hdbc, SQLHWND hwnd,
+                           SQLCHAR *szConnStrIn, SQLSMALLINT cbConnStrIn,
+                           SQLCHAR *szConnStrOut, SQLSMALLINT cbConnStrOutMax,
+                           SQLSMALLINT *pcbConnStrOut,
+                           SQLUSMALLINT fDriverCompletion) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLDisconnect(SQLHDBC ConnectionHandle) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLEndTran(SQLSMALLINT HandleType, SQLHANDLE Handle,
+                     SQLSMALLINT CompletionType) {
+  OdbcStub::end_trans.push_back(CompletionType);
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetInfo(SQLHDBC ConnectionHandle, SQLUSMALLINT InfoType,
+                     SQLPOINTER InfoValue, SQLSMALLINT BufferLength,
+                     SQLSMALLINT *StringLength) {
+  if (InfoType != SQL_CURSOR_COMMIT_BEHAVIOR &&
+      InfoType != SQL_CURSOR_ROLLBACK_BEHAVIOR)
+    return SQL_ERROR;
+  *static_cast<SQLUSMALLINT *>(InfoValue) = OdbcStub::cursor_behavior;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLBindParameter(SQLHSTMT hstmt, SQLUSMALLINT ipar,
+                           SQLSMALLINT fParamType, SQLSMALLINT fCType,
+                           SQLSMALLINT fSqlType, SQLULEN cbColDef,
+                           SQLSMALLINT ibScale, SQLPOINTER rgbValue,
+                           SQLLEN cbValueMax, SQLLEN *pcbValue) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(hstmt);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  OdbcStubParam &param = stmt->params[ipar];
+  param.sql_type = fSqlType;
+  param.value = rgbValue;
+  param.buffer_len = cbValueMax;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLBindCol(SQLHSTMT StatementHandle, SQLUSMALLINT ColumnNumber,
+                     SQLSMALLINT TargetType, SQLPOINTER TargetValue,
+                     SQLLEN BufferLength, SQLLEN *StrLen_or_Ind) {
+  return (OdbcStub::GetStmt(StatementHandle) == NULL) ? SQL_INVALID_HANDLE :
+                                                        SQL_SUCCESS;
+}
+
+SQLRETURN SQLPrepare(SQLHSTMT StatementHandle, SQLCHAR *StatementText,
+                     SQLINTEGER TextLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  stmt->query = reinterpret_cast<char *>(StatementText);
+  stmt->prepare_count++;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLExecute(SQLHSTMT StatementHandle) {
+  return OdbcStub::Execute(StatementHandle);
+}
+
+SQLRETURN SQLExecDirect(SQLHSTMT StatementHandle, SQLCHAR *StatementText,
+                        SQLINTEGER TextLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(StatementHandle);
+  if (stmt == NULL)
+    return SQL_INVALID_HANDLE;
+  stmt->query = reinterpret_cast<char *>(StatementText);
+  return OdbcStub::Execute(StatementHandle);
+}
+
+SQLRETURN SQLFetch(SQLHSTMT StatementHandle) {
+  return (OdbcStub::GetStmt(StatementHandle) == NULL) ? SQL_INVALID_HANDLE :
+                                                        SQL_NO_DATA;
+}
+
+SQLRETURN SQLCloseCursor(SQLHSTMT StatementHandle) {
+  return (OdbcStub::GetStmt(StatementHandle) == NULL) ? SQL_INVALID_HANDLE :
+                                                        SQL_SUCCESS;
+}
+
+SQLRETURN SQLCancel(SQLHSTMT StatementHandle) {
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLRowCount(SQLHSTMT StatementHandle, SQLLEN *RowCount) {
+  if (OdbcStub::GetStmt(StatementHandle) == NULL)
+    return SQL_INVALID_HANDLE;
+  *RowCount = 1;
+  return SQL_SUCCESS;
+}
+
+SQLRETURN SQLGetDiagRec(SQLSMALLINT HandleType, SQLHANDLE Handle,
+                        SQLSMALLINT RecNumber, SQLCHAR *Sqlstate,
+                        SQLINTEGER *NativeError, SQLCHAR *MessageText,
+                        SQLSMALLINT BufferLength, SQLSMALLINT *TextLength) {
+  OdbcStubStmt *stmt = OdbcStub::GetStmt(Handle);
+  if (stmt == NULL || RecNumber != 1 || stmt->diag_state.empty())
+    return SQL_NO_DATA;
+  memcpy(Sqlstate, stmt->diag_state.c_str(), stmt->diag_state.size() + 1);
+  if (NativeError != NULL)
+    *NativeError = 0;
+  if (MessageText != NULL && BufferLength > 0)
+    MessageText[0] = '\0';
+  if (TextLength != NULL)
+    *TextLength = 0;
+  return SQL_SUCCESS;
+}
+
+}  // extern "C"
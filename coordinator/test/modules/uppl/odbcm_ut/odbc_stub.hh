@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * odbc_stub.hh
+ *   ODBC API stub used by the ODBCManager unit tests. Statement handles
+ *   keep the query and the parameters bound by DBVarbind, and each
+ *   execution records the values found in the bound buffers at that time.
+ */
+
+#ifndef __UPPL_ODBCM_UT_ODBC_STUB_HH__
+#define __UPPL_ODBCM_UT_ODBC_STUB_HH__
+
+#include <sql.h>
+#include <sqlext.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace unc {
+namespace uppl {
+namespace ut {
+
+struct OdbcStubParam {
+  SQLSMALLINT sql_type;
+  SQLPOINTER value;
+  SQLLEN buffer_len;
+};
+
+struct OdbcStubStmt {
+  SQLHANDLE conn;
+  std::string query;
+  std::map<SQLUSMALLINT, OdbcStubParam> params;
+  std::string diag_state;
+  uint32_t prepare_count;
+  uint32_t execute_count;
+};
+
+// Values of the bound parameters at an execution, in parameter order
+struct OdbcStubExecution {
+  SQLHANDLE stmt;
+  std::string query;
+  std::vector<std::string> values;
+};
+
+class OdbcStub {
+  public:
+    // Forgets all the handles and results
+    static void Reset();
+
+    // Statement state of a handle allocated by SQLAllocHandle
+    static OdbcStubStmt *GetStmt(const SQLHANDLE stmt_handle);
+
+    // true, if SQLFreeHandle was called for the handle
+    static bool IsFreed(const SQLHANDLE handle);
+
+    // Number of SQLPrepare calls for the query on all statements
+    static uint32_t PrepareCount(const std::string &query);
+
+    static SQLHANDLE NewHandle(const SQLHANDLE input_handle);
+
+    // Records the bound values, and fails if one starts with fail_value
+    static SQLRETURN Execute(const SQLHANDLE stmt_handle);
+
+    static std::map<SQLHANDLE, OdbcStubStmt> stmts;
+    static std::vector<SQLHANDLE> freed;
+    static std::vector<OdbcStubExecution> executions;
+    // Completion types given to SQLEndTran, in order
+    static std::vector<SQLSMALLINT> end_trans;
+    // Cursor commit and rollback behavior reported by SQLGetInfo
+    static SQLUSMALLINT cursor_behavior;
+    static std::string fail_value;
+    static uintptr_t next_handle;
+};
+
+}  // namespace ut
+}  // namespace uppl
+}  // namespace unc
+#endif  // __UPPL_ODBCM_UT_ODBC_STUB_HH__
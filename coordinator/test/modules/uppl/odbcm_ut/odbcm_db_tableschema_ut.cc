@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+#include "odbcm_db_tableschema.hh"
+
+using namespace unc::uppl;
+
+// Column values which fill several arena blocks
+#define VALUE_SIZE   1000U
+#define VALUE_COUNT  (4 * ODBCM_VALUE_ARENA_BLOCK_SIZE / VALUE_SIZE)
+
+typedef ColumnAttrValue<uint8_t[VALUE_SIZE]> LargeValue;
+
+static void
+FillAttr(ODBCMTableColumns name, void *value,
+         std::vector<TableAttrSchema> &row) {
+  TableAttrSchema attr;
+  ODBCM_FILL_ATTRIBUTE_INFOS(attr, name, value, VALUE_SIZE,
+                             DATATYPE_UINT8_ARRAY_256, row);
+}
+
+/*
+ * Values in any of the arena blocks are found, and values allocated by
+ * the caller are not.
+ */
+TEST(DBTableSchema, IsArenaValue_MixedValues) {
+  DBTableSchema schema;
+  std::vector<void *> arena_values;
+  std::vector<LargeValue *> heap_values;
+
+  for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+    void *value = schema.AllocateAttributeValue(sizeof(LargeValue));
+    ASSERT_TRUE(value != NULL);
+    memset(value, i & 0xff, sizeof(LargeValue));
+    arena_values.push_back(value);
+    heap_values.push_back(new LargeValue);
+  }
+  ASSERT_LT(3U, schema.arena_blocks_.size());
+  for (size_t i = 1; i < schema.arena_blocks_.size(); i++) {
+    ASSERT_LT(schema.arena_blocks_[i - 1], schema.arena_blocks_[i]);
+  }
+
+  for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+    EXPECT_TRUE(schema.IsArenaValue(arena_values[i]));
+    EXPECT_EQ(sizeof(LargeValue),
+              schema.GetAttributeValueSize(arena_values[i]));
+    EXPECT_FALSE(schema.IsArenaValue(heap_values[i]));
+    EXPECT_EQ(0U, schema.GetAttributeValueSize(heap_values[i]));
+    // Values are not overwritten by the later ones
+    uint8_t *last = static_cast<uint8_t *>(arena_values[i]) +
+                    sizeof(LargeValue) - 1;
+    EXPECT_EQ(static_cast<uint8_t>(i & 0xff), *last);
+  }
+  for (size_t i = 0; i < schema.arena_blocks_.size(); i++) {
+    uint8_t *block = schema.arena_blocks_[i];
+    EXPECT_TRUE(schema.IsArenaValue(block));
+    EXPECT_TRUE(schema.IsArenaValue(
+        block + ODBCM_VALUE_ARENA_BLOCK_SIZE - 1));
+  }
+  for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+    delete heap_values[i];
+  }
+}
+
+/*
+ * Values too large for the arena are allocated out of it, and freed
+ * one by one.
+ */
+TEST(DBTableSchema, AllocateAttributeValue_Large) {
+  DBTableSchema schema;
+  void *small = schema.AllocateAttributeValue(sizeof(uint64_t));
+  void *large = schema.AllocateAttributeValue(ODBCM_VALUE_ARENA_BLOCK_SIZE);
+
+  EXPECT_TRUE(schema.IsArenaValue(small));
+  EXPECT_FALSE(schema.IsArenaValue(large));
+  EXPECT_EQ(1U, schema.arena_blocks_.size());
+  uint8_t *last = static_cast<uint8_t *>(large) +
+                  ODBCM_VALUE_ARENA_BLOCK_SIZE - 1;
+  EXPECT_EQ(0, *last);
+  schema.FreeAttributeValue(large);
+  schema.FreeAttributeValue(small);
+  EXPECT_EQ(1U, schema.arena_blocks_.size());
+}
+
+/*
+ * Rows having both arena and heap values are released by
+ * DeleteRowListFrontElement and FreeDBTableSchema.
+ */
+TEST(DBTableSchema, FreeRows_MixedValues) {
+  DBTableSchema schema;
+  std::vector<void *> arena_values;
+
+  for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+    std::vector<TableAttrSchema> row;
+    void *value = schema.AllocateAttributeValue(sizeof(LargeValue));
+    memset(value, 'a' + (i % 26), sizeof(LargeValue));
+    arena_values.push_back(value);
+    FillAttr(DOMAIN_DESCRIPTION, value, row);
+    FillAttr(CTR_NAME, new LargeValue, row);
+    schema.PushBackToRowList(row);
+  }
+
+  // The arena is kept until all the rows are freed
+  for (uint32_t i = 0; i < VALUE_COUNT / 2; i++) {
+    schema.DeleteRowListFrontElement();
+  }
+  ASSERT_EQ(VALUE_COUNT - VALUE_COUNT / 2, schema.get_row_list().size());
+  TableAttrSchema &front = schema.get_row_list().front()[0];
+  EXPECT_EQ(arena_values[VALUE_COUNT / 2], front.p_table_attribute_value);
+  EXPECT_EQ('a' + (VALUE_COUNT / 2) % 26,
+            static_cast<uint8_t *>(front.p_table_attribute_value)[0]);
+
+  schema.FreeDBTableSchema();
+  EXPECT_TRUE(schema.get_row_list().empty());
+  EXPECT_TRUE(schema.arena_blocks_.empty());
+
+  // The arena is usable again after it is released
+  void *value = schema.AllocateAttributeValue(sizeof(uint32_t));
+  EXPECT_TRUE(schema.IsArenaValue(value));
+  EXPECT_EQ(1U, schema.arena_blocks_.size());
+}
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "odbcm_mgr.hh"
+#include "odbcm_connection.hh"
+#include "odbcm_db_tableschema.hh"
+#include "odbcm_db_varbind.hh"
+#include "odbcm_utils.hh"
+#include "odbc_stub.hh"
+
+using namespace unc::uppl;
+using unc::uppl::ut::OdbcStub;
+using unc::uppl::ut::OdbcStubExecution;
+
+static const char *kCreateDomainQuery =
+    "INSERT INTO r_ctr_domain_table "
+    "(controller_name,domain_name,type,description) VALUES (?,?,?,?);";
+
+class OdbcmMgrTest : public testing::Test {
+  protected:
+    void SetUp() {
+      OdbcStub::Reset();
+      odbc_manager_ = ODBCManager::get_ODBCManager();
+      if (odbc_manager_->IsODBCManager_initialized == 0) {
+        ASSERT_EQ(ODBCM_RC_SUCCESS,
+                  ODBCMUtils::Initialize_OdbcmSQLStateMap());
+        ASSERT_EQ(ODBCM_RC_SUCCESS,
+                  odbc_manager_->initialize_db_table_list_map_());
+        ASSERT_EQ(ODBCM_RC_SUCCESS,
+                  odbc_manager_->initialize_odbcm_tables_column_map_());
+        ASSERT_EQ(ODBCM_RC_SUCCESS, odbc_manager_->InitializeConnectionEnv());
+        odbc_manager_->IsODBCManager_initialized = 1;
+      }
+    }
+
+    void TearDown() {
+      odbc_manager_->CloseRwConnection();
+      OdbcStub::Reset();
+    }
+
+    // Appends a ctr_domain_table row. Controller and domain names are the
+    // primary keys, and come first in the row.
+    void AddDomainRow(DBTableSchema &schema, const char *ctr_name,
+                      const char *domain_name, uint16_t type,
+                      const char *description) {
+      std::vector<TableAttrSchema> row;
+      TableAttrSchema attr;
+
+      ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *ctr =
+          static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *>(
+              schema.AllocateAttributeValue(sizeof(*ctr)));
+      strncpy(reinterpret_cast<char *>(ctr->value), ctr_name,
+              ODBCM_SIZE_32 - 1);
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, CTR_NAME, ctr, strlen(ctr_name),
+                                 DATATYPE_UINT8_ARRAY_32, row);
+
+      ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *domain =
+          static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *>(
+              schema.AllocateAttributeValue(sizeof(*domain)));
+      strncpy(reinterpret_cast<char *>(domain->value), domain_name,
+              ODBCM_SIZE_32 - 1);
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, DOMAIN_NAME, domain,
+                                 strlen(domain_name),
+                                 DATATYPE_UINT8_ARRAY_32, row);
+
+      ColumnAttrValue<uint16_t> *type_value =
+          static_cast<ColumnAttrValue<uint16_t> *>(
+              schema.AllocateAttributeValue(sizeof(*type_value)));
+      type_value->value = type;
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, DOMAIN_TYPE, type_value,
+                                 sizeof(uint16_t), DATATYPE_UINT16, row);
+
+      if (description != NULL) {
+        ColumnAttrValue<uint8_t[ODBCM_SIZE_128]> *desc =
+            static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_128]> *>(
+                schema.AllocateAttributeValue(sizeof(*desc)));
+        strncpy(reinterpret_cast<char *>(desc->value), description,
+                ODBCM_SIZE_128 - 1);
+        ODBCM_FILL_ATTRIBUTE_INFOS(attr, DOMAIN_DESCRIPTION, desc,
+                                   strlen(description),
+                                   DATATYPE_UINT8_ARRAY_128, row);
+      }
+      schema.PushBackToRowList(row);
+    }
+
+    void SetDomainSchema(DBTableSchema &schema) {
+      schema.set_table_name(CTR_DOMAIN_TABLE);
+      schema.PushBackToPrimaryKeysVector(CTR_NAME_STR);
+      schema.PushBackToPrimaryKeysVector(DOMAIN_NAME_STR);
+    }
+
+    std::vector<std::string> Values(const char *v1, const char *v2,
+                                    const char *v3, const char *v4) {
+      std::vector<std::string> values;
+      values.push_back(v1);
+      values.push_back(v2);
+      values.push_back(v3);
+      values.push_back(v4);
+      return values;
+    }
+
+    ODBCManager *odbc_manager_;
+};
+
+/*
+ * All rows are inserted by one prepared statement, and committed at once.
+ */
+TEST_F(OdbcmMgrTest, CreateRows_OneStatement) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  DBTableSchema schema;
+  SetDomainSchema(schema);
+  AddDomainRow(schema, "ctr1", "dom1", 1, "first");
+  AddDomainRow(schema, "ctr1", "dom2", 2, "second");
+  AddDomainRow(schema, "ctr2", "dom3", 1, "third");
+  OdbcStub::end_trans.clear();
+
+  ASSERT_EQ(ODBCM_RC_SUCCESS,
+            odbc_manager_->CreateRows(UNC_DT_RUNNING, schema, &conn));
+
+  ASSERT_EQ(1U, OdbcStub::PrepareCount(kCreateDomainQuery));
+  const std::vector<OdbcStubExecution> &execs = OdbcStub::executions;
+  ASSERT_EQ(3U, execs.size());
+  for (size_t i = 0; i < execs.size(); i++) {
+    EXPECT_EQ(kCreateDomainQuery, execs[i].query);
+    EXPECT_EQ(execs[0].stmt, execs[i].stmt);
+  }
+  EXPECT_EQ(Values("ctr1", "dom1", "1", "first"), execs[0].values);
+  EXPECT_EQ(Values("ctr1", "dom2", "2", "second"), execs[1].values);
+  EXPECT_EQ(Values("ctr2", "dom3", "1", "third"), execs[2].values);
+
+  ASSERT_EQ(1U, OdbcStub::end_trans.size());
+  EXPECT_EQ(SQL_COMMIT, OdbcStub::end_trans[0]);
+  EXPECT_EQ(3U, schema.get_row_list().size());
+}
+
+/*
+ * A failure of a row rolls back the rows executed before it, and the
+ * rest of the rows are not executed.
+ */
+TEST_F(OdbcmMgrTest, CreateRows_RollbackOnFailure) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  DBTableSchema schema;
+  SetDomainSchema(schema);
+  AddDomainRow(schema, "ctr1", "dom1", 1, "first");
+  AddDomainRow(schema, "ctr1", "dom_fail", 2, "second");
+  AddDomainRow(schema, "ctr1", "dom3", 1, "third");
+  OdbcStub::fail_value = "dom_fail";
+  OdbcStub::end_trans.clear();
+
+  EXPECT_NE(ODBCM_RC_SUCCESS,
+            odbc_manager_->CreateRows(UNC_DT_RUNNING, schema, &conn));
+
+  ASSERT_EQ(2U, OdbcStub::executions.size());
+  ASSERT_EQ(1U, OdbcStub::end_trans.size());
+  EXPECT_EQ(SQL_ROLLBACK, OdbcStub::end_trans[0]);
+  // The statement of a failed operation is not cached
+  EXPECT_TRUE(OdbcStub::IsFreed(OdbcStub::executions[0].stmt));
+}
+
+/*
+ * Candidate rows need cs_row_status handling, which is done by
+ * CreateOneRow only.
+ */
+TEST_F(OdbcmMgrTest, CreateRows_Candidate) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  DBTableSchema schema;
+  SetDomainSchema(schema);
+  AddDomainRow(schema, "ctr1", "dom1", 1, "first");
+
+  EXPECT_EQ(ODBCM_RC_INVALID_DB_OPERATION,
+            odbc_manager_->CreateRows(UNC_DT_CANDIDATE, schema, &conn));
+  EXPECT_TRUE(OdbcStub::executions.empty());
+}
+
+/*
+ * Primary keys are bound to the WHERE clause after the updated columns,
+ * and the columns of the rows are kept in the original order.
+ */
+TEST_F(OdbcmMgrTest, UpdateRows_PrimaryKeysInWhere) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  DBTableSchema schema;
+  SetDomainSchema(schema);
+  AddDomainRow(schema, "ctr1", "dom1", 3, "updated1");
+  AddDomainRow(schema, "ctr2", "dom2", 4, "updated2");
+  OdbcStub::end_trans.clear();
+
+  ASSERT_EQ(ODBCM_RC_SUCCESS,
+            odbc_manager_->UpdateRows(UNC_DT_RUNNING, schema, &conn));
+
+  const std::vector<OdbcStubExecution> &execs = OdbcStub::executions;
+  ASSERT_EQ(2U, execs.size());
+  const std::string &query = execs[0].query;
+  EXPECT_EQ(0U, query.find("UPDATE r_ctr_domain_table"));
+  size_t set_pos = query.find("type= ?,description= ?");
+  size_t where_pos = query.find(
+      " WHERE controller_name = ? AND domain_name = ?;");
+  ASSERT_NE(std::string::npos, set_pos);
+  ASSERT_NE(std::string::npos, where_pos);
+  EXPECT_LT(set_pos, where_pos);
+  EXPECT_EQ(query, execs[1].query);
+  EXPECT_EQ(execs[0].stmt, execs[1].stmt);
+  EXPECT_EQ(1U, OdbcStub::PrepareCount(query));
+
+  EXPECT_EQ(Values("3", "updated1", "ctr1", "dom1"), execs[0].values);
+  EXPECT_EQ(Values("4", "updated2", "ctr2", "dom2"), execs[1].values);
+  ASSERT_EQ(1U, OdbcStub::end_trans.size());
+  EXPECT_EQ(SQL_COMMIT, OdbcStub::end_trans[0]);
+
+  std::list<std::vector<TableAttrSchema> > &rows = schema.get_row_list();
+  ASSERT_EQ(2U, rows.size());
+  std::list<std::vector<TableAttrSchema> >::iterator it = rows.begin();
+  for (; it != rows.end(); ++it) {
+    ASSERT_EQ(4U, it->size());
+    EXPECT_EQ(CTR_NAME, (*it)[0].table_attribute_name);
+    EXPECT_EQ(DOMAIN_NAME, (*it)[1].table_attribute_name);
+    EXPECT_EQ(DOMAIN_TYPE, (*it)[2].table_attribute_name);
+    EXPECT_EQ(DOMAIN_DESCRIPTION, (*it)[3].table_attribute_name);
+  }
+}
+
+/*
+ * Rows are executed by one statement, so that a row with other columns
+ * than the first row is rejected before execution.
+ */
+TEST_F(OdbcmMgrTest, UpdateRows_DifferentColumns) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  DBTableSchema schema;
+  SetDomainSchema(schema);
+  AddDomainRow(schema, "ctr1", "dom1", 3, "updated1");
+  AddDomainRow(schema, "ctr1", "dom2", 4, NULL);
+
+  EXPECT_EQ(ODBCM_RC_ERROR_IN_FRAMEQUERY,
+            odbc_manager_->UpdateRows(UNC_DT_RUNNING, schema, &conn));
+  EXPECT_TRUE(OdbcStub::executions.empty());
+}
+
+/*
+ * A row which has the primary keys only has nothing to update.
+ */
+TEST_F(OdbcmMgrTest, UpdateRows_PrimaryKeysOnly) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  DBTableSchema schema;
+  schema.set_table_name(CTR_DOMAIN_TABLE);
+  schema.PushBackToPrimaryKeysVector(CTR_NAME_STR);
+  schema.PushBackToPrimaryKeysVector(DOMAIN_NAME_STR);
+  schema.PushBackToPrimaryKeysVector(DOMAIN_TYPE_STR);
+  schema.PushBackToPrimaryKeysVector(DOMAIN_DESCRIPTION_STR);
+  AddDomainRow(schema, "ctr1", "dom1", 3, "updated1");
+
+  EXPECT_EQ(ODBCM_RC_ERROR_IN_FRAMEQUERY,
+            odbc_manager_->UpdateRows(UNC_DT_RUNNING, schema, &conn));
+  EXPECT_TRUE(OdbcStub::executions.empty());
+}
+
+/*
+ * Whether prepared statements are cached is decided for each connection
+ * by the cursor behavior of its driver.
+ */
+TEST_F(OdbcmMgrTest, StmtCache_PerConnection) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcStub::cursor_behavior = SQL_CB_PRESERVE;
+  OdbcmConnectionHandler sb_conn(kOdbcmConnReadWriteSb, conn_status,
+                                 odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+
+  // Opening a connection which can not keep statements must not disable
+  // the cache of the others
+  OdbcStub::cursor_behavior = SQL_CB_DELETE;
+  OdbcmConnectionHandler nb_conn(kOdbcmConnReadWriteNb, conn_status,
+                                 odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+  EXPECT_TRUE(sb_conn.is_stmt_cache_enabled());
+  EXPECT_FALSE(nb_conn.is_stmt_cache_enabled());
+  ASSERT_TRUE(odbc_manager_->rw_sb_conn_obj_ != NULL);
+  EXPECT_TRUE(odbc_manager_->rw_sb_conn_obj_->is_stmt_cache_enabled());
+  ASSERT_TRUE(odbc_manager_->rw_nb_conn_obj_ != NULL);
+  EXPECT_FALSE(odbc_manager_->rw_nb_conn_obj_->is_stmt_cache_enabled());
+
+  for (int i = 0; i < 2; i++) {
+    DBTableSchema schema;
+    SetDomainSchema(schema);
+    AddDomainRow(schema, "ctr1", "dom1", 1, "first");
+    ASSERT_EQ(ODBCM_RC_SUCCESS,
+              odbc_manager_->CreateRows(UNC_DT_RUNNING, schema, &sb_conn));
+  }
+  EXPECT_EQ(1U, OdbcStub::PrepareCount(kCreateDomainQuery));
+
+  for (int i = 0; i < 2; i++) {
+    DBTableSchema schema;
+    SetDomainSchema(schema);
+    AddDomainRow(schema, "ctr1", "dom1", 1, "first");
+    ASSERT_EQ(ODBCM_RC_SUCCESS,
+              odbc_manager_->CreateRows(UNC_DT_RUNNING, schema, &nb_conn));
+  }
+  EXPECT_EQ(3U, OdbcStub::PrepareCount(kCreateDomainQuery));
+}
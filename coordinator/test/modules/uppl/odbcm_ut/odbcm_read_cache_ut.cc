@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "odbcm_mgr.hh"
+#include "odbcm_connection.hh"
+#include "odbcm_db_tableschema.hh"
+#include "odbcm_db_varbind.hh"
+#include "odbcm_read_cache.hh"
+#include "odbcm_utils.hh"
+#include "odbc_stub.hh"
+
+using namespace unc::uppl;
+using unc::uppl::ut::OdbcStub;
+
+static const char *kGetPortQuery =
+    "SELECT controller_name,switch_id,port_id,oper_status "
+    "FROM s_port_table WHERE controller_name=? AND switch_id=? "
+    "AND port_id=?;";
+static const char *kGetSwitchQuery =
+    "SELECT controller_name,switch_id,port_id,oper_status "
+    "FROM s_switch_table WHERE controller_name=? AND switch_id=? "
+    "AND port_id=?;";
+
+class OdbcmReadCacheTest : public testing::Test {
+  protected:
+    void SetUp() {
+      OdbcStub::Reset();
+      odbc_manager_ = ODBCManager::get_ODBCManager();
+      if (odbc_manager_->IsODBCManager_initialized == 0) {
+        ASSERT_EQ(ODBCM_RC_SUCCESS,
+                  ODBCMUtils::Initialize_OdbcmSQLStateMap());
+        ASSERT_EQ(ODBCM_RC_SUCCESS,
+                  odbc_manager_->initialize_db_table_list_map_());
+        ASSERT_EQ(ODBCM_RC_SUCCESS,
+                  odbc_manager_->initialize_odbcm_tables_column_map_());
+        ASSERT_EQ(ODBCM_RC_SUCCESS, odbc_manager_->InitializeConnectionEnv());
+        odbc_manager_->IsODBCManager_initialized = 1;
+      }
+      odbc_manager_->read_cache_.Invalidate(UNKNOWN_TABLE);
+    }
+
+    void TearDown() {
+      odbc_manager_->read_cache_.Invalidate(UNKNOWN_TABLE);
+      odbc_manager_->CloseRwConnection();
+      OdbcStub::Reset();
+    }
+
+    // Appends a port row of a controller name, switch id, port id and
+    // oper status. Values are allocated from the arena of the schema, as
+    // the fetched values are.
+    void AddPortRow(DBTableSchema &schema, const char *ctr_name,
+                    const char *switch_id, const char *port_id,
+                    uint16_t oper_status) {
+      std::vector<TableAttrSchema> row;
+      TableAttrSchema attr;
+
+      ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *ctr =
+          static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *>(
+              schema.AllocateAttributeValue(sizeof(*ctr)));
+      memset(ctr, 0, sizeof(*ctr));
+      strncpy(reinterpret_cast<char *>(ctr->value), ctr_name,
+              ODBCM_SIZE_32 - 1);
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, CTR_NAME, ctr, strlen(ctr_name),
+                                 DATATYPE_UINT8_ARRAY_32, row);
+
+      ColumnAttrValue<uint8_t[ODBCM_SIZE_256]> *sw =
+          static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_256]> *>(
+              schema.AllocateAttributeValue(sizeof(*sw)));
+      memset(sw, 0, sizeof(*sw));
+      strncpy(reinterpret_cast<char *>(sw->value), switch_id,
+              ODBCM_SIZE_256 - 1);
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, SWITCH_ID, sw, strlen(switch_id),
+                                 DATATYPE_UINT8_ARRAY_256, row);
+
+      ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *port =
+          static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *>(
+              schema.AllocateAttributeValue(sizeof(*port)));
+      memset(port, 0, sizeof(*port));
+      strncpy(reinterpret_cast<char *>(port->value), port_id,
+              ODBCM_SIZE_32 - 1);
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, PORT_ID, port, strlen(port_id),
+                                 DATATYPE_UINT8_ARRAY_32, row);
+
+      ColumnAttrValue<uint16_t> *status =
+          static_cast<ColumnAttrValue<uint16_t> *>(
+              schema.AllocateAttributeValue(sizeof(*status)));
+      status->value = oper_status;
+      ODBCM_FILL_ATTRIBUTE_INFOS(attr, PORT_OPER_STATUS, status,
+                                 sizeof(uint16_t), DATATYPE_UINT16, row);
+      schema.PushBackToRowList(row);
+    }
+
+    // Looks up the key with a fresh one row input
+    bool IsCached(OdbcmReadCache &cache, ODBCMTable table_id,
+                  const std::string &key) {
+      DBTableSchema schema;
+      ODBCM_RC_STATUS status = ODBCM_RC_FAILED;
+      AddPortRow(schema, "ctr", "sw", "port", 0);
+      return cache.Lookup(table_id, key, schema, status);
+    }
+
+    // Stores a one row read of the port under the key
+    void StorePort(OdbcmReadCache &cache, ODBCMTable table_id,
+                   const std::string &key, const char *port_id) {
+      DBTableSchema schema;
+      AddPortRow(schema, "ctr1", "sw1", port_id, 1);
+      cache.Store(table_id, key, schema, ODBCM_RC_SUCCESS);
+    }
+
+    std::string GetString(const TableAttrSchema &attr) {
+      return std::string(
+          static_cast<const char *>(attr.p_table_attribute_value));
+    }
+
+    uint16_t GetUint16(const TableAttrSchema &attr) {
+      return static_cast<ColumnAttrValue<uint16_t> *>(
+          attr.p_table_attribute_value)->value;
+    }
+
+    ODBCManager *odbc_manager_;
+};
+
+/*
+ * A stored read is found by its table and key only, and fills the rows
+ * fetched by the read in place of the input.
+ */
+TEST_F(OdbcmReadCacheTest, StoreLookup_HitAndMiss) {
+  OdbcmReadCache cache;
+  DBTableSchema fetched;
+  AddPortRow(fetched, "ctr1", "sw1", "port1", 1);
+  std::string key = OdbcmReadCache::BuildKey(kGetPortQuery, fetched);
+  std::string other_key = OdbcmReadCache::BuildKey(kGetSwitchQuery, fetched);
+
+  EXPECT_FALSE(IsCached(cache, PORT_TABLE, key));
+  AddPortRow(fetched, "ctr1", "sw1", "port2", 2);
+  cache.Store(PORT_TABLE, key, fetched, ODBCM_RC_SUCCESS);
+
+  EXPECT_FALSE(IsCached(cache, PORT_TABLE, other_key));
+  EXPECT_FALSE(IsCached(cache, SWITCH_TABLE, key));
+
+  DBTableSchema input;
+  AddPortRow(input, "ctr1", "sw1", "port1", 0);
+  ODBCM_RC_STATUS status = ODBCM_RC_FAILED;
+  ASSERT_TRUE(cache.Lookup(PORT_TABLE, key, input, status));
+  EXPECT_EQ(ODBCM_RC_SUCCESS, status);
+  std::list<std::vector<TableAttrSchema> > &rows = input.get_row_list();
+  ASSERT_EQ(2U, rows.size());
+  std::list<std::vector<TableAttrSchema> >::iterator it = rows.begin();
+  ASSERT_EQ(4U, it->size());
+  EXPECT_EQ("ctr1", GetString((*it)[0]));
+  EXPECT_EQ("port1", GetString((*it)[2]));
+  EXPECT_EQ(1, GetUint16((*it)[3]));
+  ++it;
+  ASSERT_EQ(4U, it->size());
+  EXPECT_EQ(PORT_ID, (*it)[2].table_attribute_name);
+  EXPECT_EQ("port2", GetString((*it)[2]));
+  EXPECT_EQ(2, GetUint16((*it)[3]));
+
+  // A read which found no record is cached as well
+  DBTableSchema not_found;
+  AddPortRow(not_found, "ctr1", "sw1", "port3", 0);
+  std::string not_found_key = OdbcmReadCache::BuildKey(kGetPortQuery,
+                                                       not_found);
+  cache.Store(PORT_TABLE, not_found_key, not_found,
+              ODBCM_RC_RECORD_NOT_FOUND);
+  status = ODBCM_RC_FAILED;
+  ASSERT_TRUE(cache.Lookup(PORT_TABLE, not_found_key, not_found, status));
+  EXPECT_EQ(ODBCM_RC_RECORD_NOT_FOUND, status);
+
+  // Other failures are not cached
+  cache.Store(PORT_TABLE, "failed", not_found, ODBCM_RC_FAILED);
+  EXPECT_FALSE(IsCached(cache, PORT_TABLE, "failed"));
+}
+
+/*
+ * Keys differ whenever the query, a column, its datatype or its value
+ * differs.
+ */
+TEST_F(OdbcmReadCacheTest, BuildKey_Unique) {
+  DBTableSchema schema1;
+  AddPortRow(schema1, "ctr1", "sw1", "port1", 1);
+  DBTableSchema schema2;
+  AddPortRow(schema2, "ctr1", "sw1", "port1", 1);
+  std::string key = OdbcmReadCache::BuildKey(kGetPortQuery, schema1);
+  EXPECT_EQ(key, OdbcmReadCache::BuildKey(kGetPortQuery, schema2));
+
+  // Table
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetSwitchQuery, schema1));
+
+  // Value, also across the boundary of the key columns
+  DBTableSchema value;
+  AddPortRow(value, "ctr1", "sw1", "port2", 1);
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetPortQuery, value));
+  DBTableSchema boundary1;
+  AddPortRow(boundary1, "ctr1s", "w1", "port1", 1);
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetPortQuery, boundary1));
+  DBTableSchema boundary2;
+  AddPortRow(boundary2, "ctr", "1sw1", "port1", 1);
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetPortQuery, boundary2));
+
+  // Datatype of the same bytes
+  DBTableSchema datatype;
+  AddPortRow(datatype, "ctr1", "sw1", "port1", 1);
+  datatype.get_row_list().front()[2].request_attribute_type =
+      DATATYPE_UINT8_ARRAY_16;
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetPortQuery, datatype));
+
+  // Column of the same value
+  DBTableSchema column;
+  AddPortRow(column, "ctr1", "sw1", "port1", 1);
+  column.get_row_list().front()[2].table_attribute_name = LP_PORT_ID;
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetPortQuery, column));
+
+  // No value
+  DBTableSchema null_value;
+  AddPortRow(null_value, "ctr1", "sw1", "port1", 1);
+  std::vector<TableAttrSchema> &row = null_value.get_row_list().front();
+  null_value.FreeAttributeValue(row[3].p_table_attribute_value);
+  row[3].p_table_attribute_value = NULL;
+  EXPECT_NE(key, OdbcmReadCache::BuildKey(kGetPortQuery, null_value));
+}
+
+/*
+ * Invalidate drops the cached reads of the table only, or of all the
+ * tables with UNKNOWN_TABLE.
+ */
+TEST_F(OdbcmReadCacheTest, Invalidate_Table) {
+  OdbcmReadCache cache;
+  StorePort(cache, PORT_TABLE, "key", "port1");
+  StorePort(cache, SWITCH_TABLE, "key", "port1");
+  ASSERT_TRUE(IsCached(cache, PORT_TABLE, "key"));
+  ASSERT_TRUE(IsCached(cache, SWITCH_TABLE, "key"));
+
+  cache.Invalidate(PORT_TABLE);
+  EXPECT_FALSE(IsCached(cache, PORT_TABLE, "key"));
+  EXPECT_TRUE(IsCached(cache, SWITCH_TABLE, "key"));
+
+  StorePort(cache, PORT_TABLE, "key", "port1");
+  cache.Invalidate(UNKNOWN_TABLE);
+  EXPECT_FALSE(IsCached(cache, PORT_TABLE, "key"));
+  EXPECT_FALSE(IsCached(cache, SWITCH_TABLE, "key"));
+}
+
+/*
+ * A write to a table drops the cached reads of the table before it is
+ * executed, and keeps the ones of the other tables.
+ */
+TEST_F(OdbcmReadCacheTest, Invalidate_AfterWrite) {
+  UncRespCode conn_status = UNC_RC_SUCCESS;
+  OdbcmConnectionHandler conn(kOdbcmConnReadWriteSb, conn_status,
+                              odbc_manager_);
+  ASSERT_EQ(UNC_RC_SUCCESS, conn_status);
+  OdbcmReadCache &cache = odbc_manager_->read_cache_;
+  StorePort(cache, CTR_DOMAIN_TABLE, "key", "port1");
+  StorePort(cache, PORT_TABLE, "key", "port1");
+
+  DBTableSchema schema;
+  schema.set_table_name(CTR_DOMAIN_TABLE);
+  schema.PushBackToPrimaryKeysVector(CTR_NAME_STR);
+  schema.PushBackToPrimaryKeysVector(DOMAIN_NAME_STR);
+  std::vector<TableAttrSchema> row;
+  TableAttrSchema attr;
+  ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *ctr =
+      static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *>(
+          schema.AllocateAttributeValue(sizeof(*ctr)));
+  memset(ctr, 0, sizeof(*ctr));
+  strncpy(reinterpret_cast<char *>(ctr->value), "ctr1", ODBCM_SIZE_32 - 1);
+  ODBCM_FILL_ATTRIBUTE_INFOS(attr, CTR_NAME, ctr, 4,
+                             DATATYPE_UINT8_ARRAY_32, row);
+  ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *domain =
+      static_cast<ColumnAttrValue<uint8_t[ODBCM_SIZE_32]> *>(
+          schema.AllocateAttributeValue(sizeof(*domain)));
+  memset(domain, 0, sizeof(*domain));
+  strncpy(reinterpret_cast<char *>(domain->value), "dom1",
+          ODBCM_SIZE_32 - 1);
+  ODBCM_FILL_ATTRIBUTE_INFOS(attr, DOMAIN_NAME, domain, 4,
+                             DATATYPE_UINT8_ARRAY_32, row);
+  ColumnAttrValue<uint16_t> *type =
+      static_cast<ColumnAttrValue<uint16_t> *>(
+          schema.AllocateAttributeValue(sizeof(*type)));
+  type->value = 1;
+  ODBCM_FILL_ATTRIBUTE_INFOS(attr, DOMAIN_TYPE, type, sizeof(uint16_t),
+                             DATATYPE_UINT16, row);
+  schema.PushBackToRowList(row);
+
+  ASSERT_EQ(ODBCM_RC_SUCCESS,
+            odbc_manager_->CreateRows(UNC_DT_RUNNING, schema, &conn));
+  EXPECT_FALSE(IsCached(cache, CTR_DOMAIN_TABLE, "key"));
+  EXPECT_TRUE(IsCached(cache, PORT_TABLE, "key"));
+}
+
+/*
+ * A table keeps ODBCM_READ_CACHE_MAX_ENTRIES reads, and the oldest one is
+ * evicted by a new one. Storing a cached key again does not evict.
+ */
+TEST_F(OdbcmReadCacheTest, Store_EvictsOldest) {
+  OdbcmReadCache cache;
+  char key[32];
+  for (uint32_t i = 0; i < ODBCM_READ_CACHE_MAX_ENTRIES; i++) {
+    snprintf(key, sizeof(key), "key%u", i);
+    StorePort(cache, PORT_TABLE, key, "port1");
+  }
+  EXPECT_EQ(static_cast<size_t>(ODBCM_READ_CACHE_MAX_ENTRIES),
+            cache.tables_[PORT_TABLE].entries.size());
+  EXPECT_TRUE(IsCached(cache, PORT_TABLE, "key0"));
+
+  StorePort(cache, PORT_TABLE, "key1", "port2");
+  EXPECT_EQ(static_cast<size_t>(ODBCM_READ_CACHE_MAX_ENTRIES),
+            cache.tables_[PORT_TABLE].entries.size());
+  EXPECT_TRUE(IsCached(cache, PORT_TABLE, "key0"));
+
+  snprintf(key, sizeof(key), "key%u", ODBCM_READ_CACHE_MAX_ENTRIES);
+  StorePort(cache, PORT_TABLE, key, "port1");
+  EXPECT_EQ(static_cast<size_t>(ODBCM_READ_CACHE_MAX_ENTRIES),
+            cache.tables_[PORT_TABLE].entries.size());
+  EXPECT_FALSE(IsCached(cache, PORT_TABLE, "key0"));
+  EXPECT_TRUE(IsCached(cache, PORT_TABLE, "key1"));
+  EXPECT_TRUE(IsCached(cache, PORT_TABLE, key));
+
+  // Other tables have their own entries
+  StorePort(cache, SWITCH_TABLE, "key0", "port1");
+  EXPECT_TRUE(IsCached(cache, SWITCH_TABLE, "key0"));
+  EXPECT_TRUE(IsCached(cache, PORT_TABLE, "key1"));
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+/*
+ * physicallayer_stub.cc
+ *   Minimum PhysicalLayer used by ODBCManager, so that the ODBC manager
+ *   is tested without the other UPPL sub modules.
+ */
+
+#include "physicallayer.hh"
+#include "physical_core.hh"
+
+namespace unc {
+namespace uppl {
+
+Mutex PhysicalLayer::ODBCManager_mutex_;
+Mutex PhysicalLayer::db_conpool_mutex_;
+Mutex PhysicalLayer::stmt_cache_mutex_;
+Mutex PhysicalLayer::fatal_mutex_;
+ReadWriteLock PhysicalLayer::phy_fini_db_lock_;
+ReadWriteLock PhysicalLayer::phy_sqlexec_lock_;
+__thread pfc_bool_t PhysicalLayer::phy_sqlexec_owner_ = PFC_FALSE;
+uint8_t PhysicalLayer::phyFiniFlag = 0;
+bool PhysicalLayer::is_fatal_done = false;
+
+pfc_bool_t PhysicalLayer::init(void) {
+  return PFC_TRUE;
+}
+
+pfc_bool_t PhysicalLayer::fini(void) {
+  return PFC_TRUE;
+}
+
+pfc_ipcresp_t PhysicalLayer::ipcService(ServerSession &session,
+                                        pfc_ipcid_t service_id) {
+  return PFC_IPCRESP_FATAL;
+}
+
+PhysicalLayer* PhysicalLayer::get_instance() {
+  static PhysicalLayer physical_layer(NULL);
+  return &physical_layer;
+}
+
+PhysicalCore* PhysicalLayer::get_physical_core() {
+  return NULL;
+}
+
+ODBCManager* PhysicalLayer::get_odbc_manager() {
+  return ODBCManager::get_ODBCManager();
+}
+
+uint16_t PhysicalCore::getStartupValidStatus() {
+  return PFC_TRUE;
+}
+
+}  // namespace uppl
+}  // namespace unc
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#ifndef _TEST_UPPL_ODBCM_UT_STUB_H
+#define _TEST_UPPL_ODBCM_UT_STUB_H
+
+/*
+ * Include stub header files.
+ */
+
+#include "stub/clstat/clstat_api.h"
+
+#ifdef __cplusplus
+#include "stub/include/cxx/pfcxx/ipc_server.hh"
+#include "stub/include/cxx/pfcxx/ipc_client.hh"
+#include "stub/include/cxx/pfcxx/module.hh"
+#include "stub/tclib_module/tclib_module.hh"
+#include "stub/capa_module/capa_intf.hh"
+#endif /* __cplusplus */
+
+#endif /* !_TEST_UPPL_ODBCM_UT_STUB_H */
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <odbcm_mgr.hh>
+#include <physical_common_def.hh>
+#include <unc/uppl_common.h>
+#include <unc/keytype.h>
+#include <physicallayer.hh>
+#include <physical_taskq.hh>
+#include <pfcxx/ipc_server.hh>
+#include "PhysicalLayerStub.hh"
+#include "ut_util.hh"
+
+using namespace pfc::core::ipc;
+using namespace std;
+using namespace unc::uppl;
+using namespace unc::uppl::test;
+
+class PhysicalTaskqTest
+  : public UpplTestEnv {
+ protected:
+  virtual void SetUp() {
+    UpplTestEnv::SetUp();
+    coalesced_ = PhyEventTaskqUtil::get_events_coalesced();
+    committed_ = PhyEventTaskqUtil::get_events_committed();
+    batches_ = PhyEventTaskqUtil::get_batches_committed();
+    replayed_ = PhyEventTaskqUtil::get_batches_replayed();
+  }
+
+  virtual void TearDown() {
+    vector<NotificationEventParams*>::iterator it = events_.begin();
+    for (; it != events_.end(); it++) {
+      delete *it;
+    }
+    events_.clear();
+    UpplTestEnv::TearDown();
+  }
+
+  // Port event whose value has the given valid flags
+  void AddPortEvent(const char *port_id, uint32_t operation,
+                    uint32_t data_type, uint8_t port_valid,
+                    uint8_t oper_status) {
+    EventAlarmDetail event_detail(TQ_EVENT);
+    key_port_t *key = reinterpret_cast<key_port_t*>(
+        calloc(1, sizeof(key_port_t)));
+    strncpy(reinterpret_cast<char*>(key->sw_key.ctr_key.controller_name),
+            "ctr1", sizeof(key->sw_key.ctr_key.controller_name));
+    strncpy(reinterpret_cast<char*>(key->sw_key.switch_id), "sw1",
+            sizeof(key->sw_key.switch_id));
+    strncpy(reinterpret_cast<char*>(key->port_id), port_id,
+            sizeof(key->port_id));
+    val_port_st_t *old_val = reinterpret_cast<val_port_st_t*>(
+        calloc(1, sizeof(val_port_st_t)));
+    val_port_st_t *new_val = reinterpret_cast<val_port_st_t*>(
+        calloc(1, sizeof(val_port_st_t)));
+    old_val->oper_status = static_cast<uint8_t>(events_.size());
+    new_val->oper_status = oper_status;
+    memset(new_val->port.valid, port_valid, sizeof(new_val->port.valid));
+    new_val->valid[kIdxPortOperStatus] = UNC_VF_VALID;
+    event_detail.operation = operation;
+    event_detail.data_type = data_type;
+    event_detail.key_type = UNC_KT_PORT;
+    event_detail.key_struct = key;
+    event_detail.key_size = sizeof(key_port_t);
+    event_detail.old_val_struct = old_val;
+    event_detail.new_val_struct = new_val;
+    event_detail.val_size = sizeof(val_port_st_t);
+    event_detail.controller_name = "ctr1";
+    event_detail.eventid = events_.size();
+    events_.push_back(new NotificationEventParams(event_detail));
+  }
+
+  // Switch update which separates port updates
+  void AddSwitchEvent() {
+    EventAlarmDetail event_detail(TQ_EVENT);
+    key_switch_t *key = reinterpret_cast<key_switch_t*>(
+        calloc(1, sizeof(key_switch_t)));
+    val_switch_st_t *new_val = reinterpret_cast<val_switch_st_t*>(
+        calloc(1, sizeof(val_switch_st_t)));
+    event_detail.operation = UNC_OP_UPDATE;
+    event_detail.data_type = UNC_DT_STATE;
+    event_detail.key_type = UNC_KT_SWITCH;
+    event_detail.key_struct = key;
+    event_detail.key_size = sizeof(key_switch_t);
+    event_detail.new_val_struct = new_val;
+    event_detail.val_size = sizeof(val_switch_st_t);
+    event_detail.controller_name = "ctr1";
+    events_.push_back(new NotificationEventParams(event_detail));
+  }
+
+  // Alarm which is not batched
+  void AddAlarm() {
+    EventAlarmDetail event_detail(TQ_ALARM);
+    event_detail.key_type = UNC_KT_LINK;
+    event_detail.controller_name = "ctr1";
+    events_.push_back(new NotificationEventParams(event_detail));
+  }
+
+  // Batchable events which do not update the database
+  void AddBatchableEvents(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+      AddPortEvent("port", UNC_OP_READ, UNC_DT_STATE, UNC_VF_VALID, 0);
+    }
+  }
+
+  // Moves the events to the batch queue and drains it. Stub task queue
+  // runs the next drain task in the calling thread.
+  void ProcessEvents() {
+    PhyEventBatchQueue batchq;
+    batchq.scheduled = true;
+    vector<NotificationEventParams*>::iterator it = events_.begin();
+    for (; it != events_.end(); it++) {
+      batchq.pending.push_back(*it);
+    }
+    events_.clear();
+    PhyEventTaskqUtil taskq_util(1);
+    pfc::core::TaskQueue event_taskq(1);
+    taskq_util.ProcessEventBatch(&batchq, &event_taskq);
+    EXPECT_TRUE(batchq.pending.empty());
+    EXPECT_FALSE(batchq.scheduled);
+  }
+
+  const val_port_st_t *NewPortVal(size_t index) {
+    return reinterpret_cast<const val_port_st_t*>(
+        events_[index]->event_detail_.new_val_struct);
+  }
+
+  const val_port_st_t *OldPortVal(size_t index) {
+    return reinterpret_cast<const val_port_st_t*>(
+        events_[index]->event_detail_.old_val_struct);
+  }
+
+  vector<NotificationEventParams*> events_;
+  uint64_t coalesced_;
+  uint64_t committed_;
+  uint64_t batches_;
+  uint64_t replayed_;
+};
+
+/* Later update of the same port is merged into the earlier one */
+TEST_F(PhysicalTaskqTest, Coalesce_SameKey) {
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 1);
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 2);
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 3);
+
+  EXPECT_EQ(2U, PhyEventTaskqUtil::CoalesceEvents(events_));
+  ASSERT_EQ(1U, events_.size());
+  // Old value of the first event and new value of the last event are kept
+  EXPECT_EQ(0, OldPortVal(0)->oper_status);
+  EXPECT_EQ(3, NewPortVal(0)->oper_status);
+  EXPECT_EQ(2U, events_[0]->event_detail_.eventid);
+  EXPECT_EQ(coalesced_ + 2, PhyEventTaskqUtil::get_events_coalesced());
+}
+
+/* Updates of different ports are not merged */
+TEST_F(PhysicalTaskqTest, Coalesce_DifferentKey) {
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 1);
+  AddPortEvent("port2", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 2);
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 3);
+
+  EXPECT_EQ(1U, PhyEventTaskqUtil::CoalesceEvents(events_));
+  ASSERT_EQ(2U, events_.size());
+  EXPECT_EQ(3, NewPortVal(0)->oper_status);
+  EXPECT_EQ(2, NewPortVal(1)->oper_status);
+}
+
+/* Update which does not cover the earlier valid flags is not merged */
+TEST_F(PhysicalTaskqTest, Coalesce_ValidNotCovered) {
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 1);
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_INVALID, 2);
+
+  EXPECT_EQ(0U, PhyEventTaskqUtil::CoalesceEvents(events_));
+  ASSERT_EQ(2U, events_.size());
+  EXPECT_EQ(coalesced_, PhyEventTaskqUtil::get_events_coalesced());
+}
+
+/* Updates of another data type or separated by another kind of event
+ * are not merged */
+TEST_F(PhysicalTaskqTest, Coalesce_Separated) {
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 1);
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_IMPORT, UNC_VF_VALID, 2);
+  AddSwitchEvent();
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 3);
+  AddPortEvent("port1", UNC_OP_CREATE, UNC_DT_STATE, UNC_VF_VALID, 4);
+  AddPortEvent("port1", UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_VALID, 5);
+
+  EXPECT_EQ(0U, PhyEventTaskqUtil::CoalesceEvents(events_));
+  EXPECT_EQ(6U, events_.size());
+}
+
+/* Batchable events are applied in transactions of UPPL_EVENT_TXN_MAX
+ * events at most */
+TEST_F(PhysicalTaskqTest, Batch_TransactionSize) {
+  const uint32_t count = UPPL_EVENT_TXN_MAX * 3 + 1;
+  AddBatchableEvents(count);
+  ProcessEvents();
+
+  EXPECT_EQ(4U, ODBCManager::stub_getBatchBeginCount());
+  EXPECT_EQ(4U, ODBCManager::stub_getBatchEndCount());
+  EXPECT_EQ(batches_ + 4, PhyEventTaskqUtil::get_batches_committed());
+  EXPECT_EQ(committed_ + count, PhyEventTaskqUtil::get_events_committed());
+  EXPECT_EQ(replayed_, PhyEventTaskqUtil::get_batches_replayed());
+}
+
+/* Alarms split batches and are processed one by one */
+TEST_F(PhysicalTaskqTest, Batch_SplitByAlarm) {
+  AddBatchableEvents(3);
+  AddAlarm();
+  AddBatchableEvents(2);
+  ProcessEvents();
+
+  EXPECT_EQ(2U, ODBCManager::stub_getBatchBeginCount());
+  EXPECT_EQ(batches_ + 2, PhyEventTaskqUtil::get_batches_committed());
+  EXPECT_EQ(committed_ + 6, PhyEventTaskqUtil::get_events_committed());
+}
+
+/* Events are applied one by one if the batch can not be started */
+TEST_F(PhysicalTaskqTest, Batch_BeginFailure) {
+  ODBCManager::stub_setResultcode(ODBCManager::BEGINBATCHTRANSACTION,
+                                  ODBCM_RC_FAILED);
+  AddBatchableEvents(5);
+  ProcessEvents();
+
+  EXPECT_EQ(1U, ODBCManager::stub_getBatchBeginCount());
+  EXPECT_EQ(0U, ODBCManager::stub_getBatchEndCount());
+  EXPECT_EQ(batches_, PhyEventTaskqUtil::get_batches_committed());
+  EXPECT_EQ(committed_ + 5, PhyEventTaskqUtil::get_events_committed());
+}
+
+/* Events of a batch which failed to commit are applied again one by one */
+TEST_F(PhysicalTaskqTest, Batch_CommitFailureReplays) {
+  ODBCManager::stub_setResultcode(ODBCManager::ENDBATCHTRANSACTION,
+                                  ODBCM_RC_FAILED);
+  const uint32_t count = UPPL_EVENT_TXN_MAX + 1;
+  AddBatchableEvents(count);
+  ProcessEvents();
+
+  EXPECT_EQ(2U, ODBCManager::stub_getBatchEndCount());
+  EXPECT_EQ(batches_, PhyEventTaskqUtil::get_batches_committed());
+  EXPECT_EQ(replayed_ + 2, PhyEventTaskqUtil::get_batches_replayed());
+  EXPECT_EQ(committed_ + count, PhyEventTaskqUtil::get_events_committed());
+}
+
+/* Replay of a batch which failed to commit does not post the northbound
+ * notifications of its events again */
+TEST_F(PhysicalTaskqTest, Batch_CommitFailureNotifiesOnce) {
+  const uint32_t count = 4;
+  ServerEvent::clearStubData();
+  ServerEvent::stub_setPostResult(0);
+  ODBCManager::stub_setResultcode(ODBCManager::ISROWEXISTS,
+                                  ODBCM_RC_ROW_EXISTS);
+  ODBCManager::stub_setResultcode(ODBCManager::UPDATEONEROW,
+                                  ODBCM_RC_SUCCESS);
+  for (uint32_t i = 0; i < count; i++) {
+    char port_id[8];
+    snprintf(port_id, sizeof(port_id), "port%u", i);
+    AddPortEvent(port_id, UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_INVALID, 1);
+  }
+  ProcessEvents();
+  uint32_t committed_posts = ServerEvent::stub_getPostCount();
+  EXPECT_LE(count, committed_posts);
+
+  ServerEvent::clearStubData();
+  ODBCManager::stub_setResultcode(ODBCManager::ENDBATCHTRANSACTION,
+                                  ODBCM_RC_FAILED);
+  for (uint32_t i = 0; i < count; i++) {
+    char port_id[8];
+    snprintf(port_id, sizeof(port_id), "port%u", i);
+    AddPortEvent(port_id, UNC_OP_UPDATE, UNC_DT_STATE, UNC_VF_INVALID, 1);
+  }
+  ProcessEvents();
+
+  EXPECT_EQ(replayed_ + 1, PhyEventTaskqUtil::get_batches_replayed());
+  EXPECT_EQ(committed_posts, ServerEvent::stub_getPostCount());
+  EXPECT_EQ(PFC_FALSE, PhysicalLayer::phy_event_replay_);
+  ServerEvent::stub_setPostResult(UNC_UPPL_RC_FAILURE);
+  ServerEvent::clearStubData();
+}
+
+/* Drain task takes UPPL_EVENT_BATCH_MAX events at most, and the rest is
+ * processed by the next drain task */
+TEST_F(PhysicalTaskqTest, Batch_MaxEvents) {
+  const uint32_t count = UPPL_EVENT_BATCH_MAX + 1;
+  AddBatchableEvents(count);
+  ProcessEvents();
+
+  const uint32_t nbatches = UPPL_EVENT_BATCH_MAX / UPPL_EVENT_TXN_MAX + 1;
+  EXPECT_EQ(nbatches, ODBCManager::stub_getBatchBeginCount());
+  EXPECT_EQ(batches_ + nbatches, PhyEventTaskqUtil::get_batches_committed());
+  EXPECT_EQ(committed_ + count, PhyEventTaskqUtil::get_events_committed());
+}
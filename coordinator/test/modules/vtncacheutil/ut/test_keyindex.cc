@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2015 NEC Corporation
+ * All rights reserved.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License v1.0 which accompanies this
+ * distribution, and is available at http://www.eclipse.org/legal/epl-v10.html
+ */
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <key_index.hh>
+#include <confignode.hh>
+#include <string>
+#include <vector>
+
+namespace unc {
+namespace vtndrvcache {
+
+static std::string port_key(uint32_t index) {
+  char buff[64];
+  snprintf(buff, sizeof(buff), "openflow:%u:s%u-eth%u", index / 48,
+           index / 48, index % 48);
+  return std::string(buff);
+}
+
+TEST(KeyIndex, insert_find) {
+  KeyIndex index;
+  ConfigNode node1;
+  ConfigNode node2;
+  EXPECT_EQ(0U, index.capacity());
+  EXPECT_EQ(NULL, index.find("vtn1"));
+
+  EXPECT_EQ(PFC_TRUE, index.insert("vtn1", &node1));
+  EXPECT_EQ(PFC_TRUE, index.insert("vtn2", &node2));
+  EXPECT_EQ(2U, index.size());
+  EXPECT_EQ(KEY_INDEX_MIN_CAPACITY, index.capacity());
+  EXPECT_EQ(&node1, index.find("vtn1"));
+  EXPECT_EQ(&node2, index.find("vtn2", KeyIndex::hash_key("vtn2")));
+  EXPECT_EQ(NULL, index.find("vtn3"));
+}
+
+TEST(KeyIndex, duplicate_kept) {
+  KeyIndex index;
+  ConfigNode node1;
+  ConfigNode node2;
+  EXPECT_EQ(PFC_TRUE, index.insert("vtn1", &node1));
+  EXPECT_EQ(PFC_FALSE, index.insert("vtn1", &node2));
+  EXPECT_EQ(1U, index.size());
+  EXPECT_EQ(&node1, index.find("vtn1"));
+}
+
+TEST(KeyIndex, grow_and_erase) {
+  const uint32_t count = 10000;
+  KeyIndex index;
+  std::vector<ConfigNode> nodes(count);
+  for (uint32_t i = 0; i < count; i++) {
+    ASSERT_EQ(PFC_TRUE, index.insert(port_key(i), &nodes[i]));
+  }
+  EXPECT_EQ(count, index.size());
+  EXPECT_GE(index.capacity() * KEY_INDEX_LOAD_NUM,
+            count * KEY_INDEX_LOAD_DEN);
+
+  // Erasing shifts entries back, every remaining key must stay reachable
+  for (uint32_t i = 0; i < count; i += 3) {
+    ASSERT_EQ(PFC_TRUE, index.erase(port_key(i)));
+  }
+  EXPECT_EQ(PFC_FALSE, index.erase(port_key(0)));
+  for (uint32_t i = 0; i < count; i++) {
+    if ((i % 3) == 0) {
+      EXPECT_EQ(NULL, index.find(port_key(i)));
+    } else {
+      EXPECT_EQ(&nodes[i], index.find(port_key(i)));
+    }
+  }
+  EXPECT_EQ(count - ((count + 2) / 3), index.size());
+
+  // Erased slots are reused
+  for (uint32_t i = 0; i < count; i += 3) {
+    ASSERT_EQ(PFC_TRUE, index.insert(port_key(i), &nodes[i]));
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    EXPECT_EQ(&nodes[i], index.find(port_key(i)));
+  }
+}
+
+TEST(KeyIndex, reserve_clear) {
+  KeyIndex index;
+  ConfigNode node;
+  index.reserve(1000);
+  uint32_t capacity = index.capacity();
+  EXPECT_GE(capacity * KEY_INDEX_LOAD_NUM, 1000 * KEY_INDEX_LOAD_DEN);
+  for (uint32_t i = 0; i < 1000; i++) {
+    index.insert(port_key(i), &node);
+  }
+  EXPECT_EQ(capacity, index.capacity());
+
+  index.clear();
+  EXPECT_EQ(0U, index.size());
+  EXPECT_EQ(0U, index.capacity());
+  EXPECT_EQ(NULL, index.find(port_key(1)));
+  EXPECT_EQ(PFC_FALSE, index.erase(port_key(1)));
+}
+}  // namespace vtndrvcache
+}  // namespace unc
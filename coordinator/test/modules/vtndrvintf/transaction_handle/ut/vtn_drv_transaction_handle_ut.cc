@@ -14,7 +14,10 @@
 #include <controller_utils.hh>
 #include <vtn_cache_mod.hh>
 #include <stdio.h>
+#include <algorithm>
 #include <map>
+#include <string>
+#include <vector>
 #include <unc/upll_ipc_enum.h>
 #include "../../../stub/tclib_module/tclib_interface.hh"
 #include "../../../stub/tclib_module/tclib_module.hh"
@@ -557,5 +560,318 @@ TEST_F(DriverTxnInterfaceTest, HandleAuditEND_ControllerNameNotExist) {
   CtrObj = NULL;
   TxnObj = NULL;
 }
+
+/*
+ * Handler which records the order of the config nodes sent and fails the
+ * node at fail_index
+ */
+class RecordingKtHandler : public KtHandler {
+ public:
+  explicit RecordingKtHandler(uint32_t fail_index)
+      : fail_index_(fail_index) {}
+
+  UncRespCode handle_request(pfc::core::ipc::ServerSession &sess,
+                             odl_drv_request_header_t &request_header,
+                             ControllerFramework* crtl_fw) {
+    return UNC_RC_SUCCESS;
+  }
+
+  UncRespCode execute_cmd(unc::vtndrvcache::ConfigNode *cfgptr,
+                          unc::driver::controller* ctl_ptr,
+                          unc::driver::driver* drv_ptr) {
+    uint32_t index = sent_.size();
+    sent_.push_back(cfgptr);
+    return (index == fail_index_) ? UNC_DRV_RC_ERR_GENERIC : UNC_RC_SUCCESS;
+  }
+
+  void* get_key_struct(unc::vtndrvcache::ConfigNode *cfgptr) {
+    return NULL;
+  }
+
+  void* get_val_struct(unc::vtndrvcache::ConfigNode *cfgptr) {
+    return NULL;
+  }
+
+  uint32_t fail_index_;
+  std::vector<unc::vtndrvcache::ConfigNode*> sent_;
+};
+
+static void AppendVtnNodes(controller *ctrl_ptr, uint32_t count,
+                           std::vector<unc::vtndrvcache::ConfigNode*> *nodes) {
+  for (uint32_t i = 0; i < count; i++) {
+    key_vtn key_obj;
+    memset(&key_obj, 0, sizeof(key_obj));
+    snprintf(reinterpret_cast<char *>(key_obj.vtn_name),
+             sizeof(key_obj.vtn_name), "vtn%u", i);
+    val_vtn val_obj;
+    memset(&val_obj, 0, sizeof(val_obj));
+    unc::vtndrvcache::ConfigNode *cfgptr =
+        new unc::vtndrvcache::CacheElementUtil<key_vtn, val_vtn, val_vtn,
+              uint32_t>(&key_obj, &val_obj, &val_obj, UNC_OP_CREATE);
+    EXPECT_EQ(UNC_RC_SUCCESS,
+              ctrl_ptr->controller_cache->append_commit_node(cfgptr));
+    nodes->push_back(cfgptr);
+  }
+}
+
+TEST_F(DriverTxnInterfaceTest, IsCommitOrderNeeded) {
+  // Interfaces of different vbridges are independent
+  EXPECT_EQ(PFC_FALSE, DriverTxnInterface::IsCommitOrderNeeded(
+      UNC_KT_VBR_IF, "vtn1vbr1if1", UNC_KT_VBR_IF, "vtn1vbr2if1"));
+  // A node is sent after its parent
+  EXPECT_EQ(PFC_TRUE, DriverTxnInterface::IsCommitOrderNeeded(
+      UNC_KT_VBRIDGE, "vtn1vbr1", UNC_KT_VBR_IF, "vtn1vbr1if1"));
+  // VLAN maps of all the vbridges share one list of the controller
+  EXPECT_EQ(PFC_TRUE, DriverTxnInterface::IsCommitOrderNeeded(
+      UNC_KT_VBR_VLANMAP, "vtn1vbr1lpid1", UNC_KT_VBR_VLANMAP,
+      "vtn2vbr2lpid2"));
+  EXPECT_EQ(PFC_FALSE, DriverTxnInterface::IsCommitOrderNeeded(
+      UNC_KT_VBR_VLANMAP, "vtn1vbr1lpid1", UNC_KT_VBR_IF, "vtn2vbr2if1"));
+  // Flowfilter entries may redirect to any interface
+  EXPECT_EQ(PFC_TRUE, DriverTxnInterface::IsCommitOrderNeeded(
+      UNC_KT_VBR_FLOWFILTER_ENTRY, "vtn1vbr1in1", UNC_KT_VBR_IF,
+      "vtn2vbr2if1"));
+  // Nodes out of the VTN tree are sent alone
+  EXPECT_EQ(PFC_TRUE, DriverTxnInterface::IsCommitOrderNeeded(
+      UNC_KT_FLOWLIST, "flowlist1", UNC_KT_VTN, "vtn1"));
+}
+
+TEST_F(DriverTxnInterfaceTest, HandleCommitCacheParallelOrder) {
+  std::string ctr_name = "ctr_name";
+  controller *ctrl_ptr = NULL;
+  driver *drv = NULL;
+  unc::driver::ControllerFramework* CtrObj =
+      new unc::driver::ControllerFramework;
+  ControllerFramework::res_code = 0;
+  CtrObj->GetDriverByControllerName(ctr_name, &ctrl_ptr, &drv);
+  ctrl_ptr->controller_cache = unc::vtndrvcache::KeyTree::create_cache();
+  std::vector<unc::vtndrvcache::ConfigNode*> nodes;
+  AppendVtnNodes(ctrl_ptr, 4, &nodes);
+
+  typedef std::map <unc_key_type_t, unc::driver::KtHandler*> kt_handler_map;
+  kt_handler_map map_kt_;
+  RecordingKtHandler *vtn_req = new RecordingKtHandler(UINT32_MAX);
+  map_kt_[UNC_KT_VTN] = vtn_req;
+  unc::driver::driver::set_commit_concurrency(4);
+  DriverTxnInterface *TxnObj = new DriverTxnInterface(CtrObj, map_kt_);
+  DriverTxnInterface::CommitFailure_t failure;
+  EXPECT_EQ(unc::tclib::TC_SUCCESS,
+            TxnObj->SendCommitCache(ctr_name, ctrl_ptr, drv, &failure));
+  EXPECT_EQ(PFC_FALSE, failure.failed);
+  // Every node is sent once in commit order
+  EXPECT_TRUE(nodes == vtn_req->sent_);
+
+  unc::driver::driver::set_commit_concurrency(1);
+  delete TxnObj;
+  delete vtn_req;
+  delete ctrl_ptr->controller_cache;
+  ctrl_ptr->controller_cache = NULL;
+  delete CtrObj;
+}
+
+TEST_F(DriverTxnInterfaceTest, HandleCommitCacheParallelFailure) {
+  std::string ctr_name = "ctr_name";
+  controller *ctrl_ptr = NULL;
+  driver *drv = NULL;
+  unc::driver::ControllerFramework* CtrObj =
+      new unc::driver::ControllerFramework;
+  ControllerFramework::res_code = 0;
+  CtrObj->GetDriverByControllerName(ctr_name, &ctrl_ptr, &drv);
+  ctrl_ptr->controller_cache = unc::vtndrvcache::KeyTree::create_cache();
+  std::vector<unc::vtndrvcache::ConfigNode*> nodes;
+  AppendVtnNodes(ctrl_ptr, 4, &nodes);
+
+  typedef std::map <unc_key_type_t, unc::driver::KtHandler*> kt_handler_map;
+  kt_handler_map map_kt_;
+  RecordingKtHandler *vtn_req = new RecordingKtHandler(1);
+  map_kt_[UNC_KT_VTN] = vtn_req;
+  unc::driver::driver::set_commit_concurrency(4);
+  DriverTxnInterface *TxnObj = new DriverTxnInterface(CtrObj, map_kt_);
+  DriverTxnInterface::CommitFailure_t failure;
+  EXPECT_EQ(unc::tclib::TC_FAILURE,
+            TxnObj->SendCommitCache(ctr_name, ctrl_ptr, drv, &failure));
+  // No node is sent after the failed one, which is reported
+  ASSERT_EQ(2U, vtn_req->sent_.size());
+  EXPECT_EQ(nodes[0], vtn_req->sent_[0]);
+  EXPECT_EQ(nodes[1], vtn_req->sent_[1]);
+  EXPECT_EQ(PFC_TRUE, failure.failed);
+  EXPECT_EQ(static_cast<uint32_t>(UNC_DRV_RC_ERR_GENERIC), failure.retc);
+  EXPECT_EQ(UNC_KT_VTN, failure.keytype);
+  EXPECT_EQ(nodes[1], failure.cfgnode);
+  EXPECT_EQ(vtn_req, failure.hnd_ptr);
+
+  unc::driver::driver::set_commit_concurrency(1);
+  delete TxnObj;
+  delete vtn_req;
+  delete ctrl_ptr->controller_cache;
+  ctrl_ptr->controller_cache = NULL;
+  delete CtrObj;
+}
+
+/*
+ * Controllers ctr1..ctrN which are up, audited and support two phase commit
+ */
+static unc::tclib::TcControllerList ControllerTxnList(uint32_t count) {
+  ControllerFramework::res_code = 0;
+  ControllerFramework::missing_controllers.clear();
+  controller::set_controller_status(0);
+  controller::create_controll()->set_audit_result(PFC_TRUE);
+  driver::set_ctrl_instance(0);
+  driver::set_ret_code(0);
+  driver::clear_txn_counts();
+  unc::tclib::TcLibModule::stub_clearTcLibStubData();
+  unc::tclib::TcControllerList controllers;
+  for (uint32_t i = 1; i <= count; i++) {
+    char name[16];
+    snprintf(name, sizeof(name), "ctr%u", i);
+    controllers.push_back(name);
+  }
+  return controllers;
+}
+
+TEST_F(DriverTxnInterfaceTest, HandleCommitControllersConcurrent) {
+  unc::tclib::TcLibModule::stub_loadtcLibModule();
+  unc::driver::ControllerFramework* CtrObj =
+      new unc::driver::ControllerFramework;
+  typedef std::map <unc_key_type_t, KtHandler*> kt_handler_map;
+  kt_handler_map map_kt_;
+  unc::tclib::TcControllerList controllers = ControllerTxnList(3);
+  DriverTxnInterface *TxnObj = new DriverTxnInterface(CtrObj, map_kt_, 3);
+
+  EXPECT_EQ(unc::tclib::TC_SUCCESS,
+            TxnObj->HandleCommitVoteRequest(1, 1, controllers));
+  EXPECT_EQ(3U, driver::vote_count);
+  // Results are written in the order of the controllers list
+  std::vector<std::string> expected(controllers.begin(), controllers.end());
+  EXPECT_TRUE(expected ==
+              unc::tclib::TcLibModule::controller_info_written);
+
+  EXPECT_EQ(unc::tclib::TC_SUCCESS,
+            TxnObj->HandleCommitGlobalCommit(1, 1, controllers));
+  EXPECT_EQ(3U, driver::commit_count);
+  EXPECT_EQ(0U, driver::abort_count);
+
+  unc::tclib::TcLibModule::stub_unloadtcLibModule();
+  delete TxnObj;
+  delete CtrObj;
+}
+
+TEST_F(DriverTxnInterfaceTest, HandleCommitVoteControllerFailure) {
+  unc::tclib::TcLibModule::stub_loadtcLibModule();
+  unc::driver::ControllerFramework* CtrObj =
+      new unc::driver::ControllerFramework;
+  typedef std::map <unc_key_type_t, KtHandler*> kt_handler_map;
+  kt_handler_map map_kt_;
+  unc::tclib::TcControllerList controllers = ControllerTxnList(3);
+  std::vector<std::string> expected(controllers.begin(), controllers.end());
+  DriverTxnInterface *TxnObj = new DriverTxnInterface(CtrObj, map_kt_, 3);
+
+  // All the controllers are voted at once, and all are aborted
+  driver::fail_vote_at = 2;
+  EXPECT_EQ(unc::tclib::TC_FAILURE,
+            TxnObj->HandleCommitVoteRequest(1, 1, controllers));
+  EXPECT_EQ(3U, driver::vote_count);
+  EXPECT_EQ(3U, driver::abort_count);
+  // Results are written up to the failed controller
+  std::vector<std::string> &written =
+      unc::tclib::TcLibModule::controller_info_written;
+  ASSERT_GT(3U, written.size());
+  EXPECT_TRUE(std::equal(written.begin(), written.end(), expected.begin()));
+  delete TxnObj;
+
+  // One by one, no controller is voted after the failed one
+  controllers = ControllerTxnList(3);
+  TxnObj = new DriverTxnInterface(CtrObj, map_kt_, 1);
+  driver::fail_vote_at = 2;
+  EXPECT_EQ(unc::tclib::TC_FAILURE,
+            TxnObj->HandleCommitVoteRequest(1, 1, controllers));
+  EXPECT_EQ(2U, driver::vote_count);
+  EXPECT_EQ(3U, driver::abort_count);
+  ASSERT_EQ(1U, written.size());
+  EXPECT_EQ("ctr1", written[0]);
+
+  driver::clear_txn_counts();
+  unc::tclib::TcLibModule::stub_unloadtcLibModule();
+  delete TxnObj;
+  delete CtrObj;
+}
+
+TEST_F(DriverTxnInterfaceTest, HandleCommitVoteCacheControllerFailure) {
+  const pfc_modattr_t* attr = NULL;
+  VtnDrvIntf obj(attr);
+  obj.init();
+  unc::tclib::TcLibModule::stub_loadtcLibModule();
+  unc::driver::ControllerFramework* CtrObj =
+      new unc::driver::ControllerFramework;
+  typedef std::map <unc_key_type_t, KtHandler*> kt_handler_map;
+  kt_handler_map map_kt_;
+  RecordingKtHandler *vtn_req = new RecordingKtHandler(1);
+  map_kt_[UNC_KT_VTN] = vtn_req;
+  unc::tclib::TcControllerList controllers = ControllerTxnList(3);
+  driver::set_ctrl_instance(1);
+  // The stub controllers share one controller and its cache
+  controller *ctrl_ptr = controller::create_controll();
+  ctrl_ptr->controller_cache = unc::vtndrvcache::KeyTree::create_cache();
+  std::vector<unc::vtndrvcache::ConfigNode*> nodes;
+  AppendVtnNodes(ctrl_ptr, 1, &nodes);
+  DriverTxnInterface *TxnObj = new DriverTxnInterface(CtrObj, map_kt_, 3);
+
+  // Controllers without two phase commit support are programmed one by
+  // one, and none is programmed after the failed one
+  EXPECT_EQ(unc::tclib::TC_FAILURE,
+            TxnObj->HandleCommitVoteRequest(1, 1, controllers));
+  EXPECT_EQ(2U, vtn_req->sent_.size());
+  std::vector<std::string> &written =
+      unc::tclib::TcLibModule::controller_info_written;
+  ASSERT_EQ(2U, written.size());
+  EXPECT_EQ("ctr1", written[0]);
+  EXPECT_EQ("ctr2", written[1]);
+  EXPECT_EQ(PFC_FALSE, ctrl_ptr->get_audit_result());
+  EXPECT_TRUE(ctrl_ptr->controller_cache == NULL);
+
+  driver::set_ctrl_instance(0);
+  unc::tclib::TcLibModule::stub_unloadtcLibModule();
+  delete TxnObj;
+  delete vtn_req;
+  delete CtrObj;
+}
+
+TEST_F(DriverTxnInterfaceTest, HandleCommitControllerNotExist) {
+  unc::tclib::TcLibModule::stub_loadtcLibModule();
+  unc::driver::ControllerFramework* CtrObj =
+      new unc::driver::ControllerFramework;
+  typedef std::map <unc_key_type_t, KtHandler*> kt_handler_map;
+  kt_handler_map map_kt_;
+  DriverTxnInterface *TxnObj = new DriverTxnInterface(CtrObj, map_kt_, 3);
+  std::vector<std::string> &written =
+      unc::tclib::TcLibModule::controller_info_written;
+
+  // The missing controller is written as disconnected and ends the vote
+  // successfully, the controllers after it are not sent
+  unc::tclib::TcControllerList controllers = ControllerTxnList(3);
+  ControllerFramework::missing_controllers.insert("ctr2");
+  EXPECT_EQ(unc::tclib::TC_SUCCESS,
+            TxnObj->HandleCommitVoteRequest(1, 1, controllers));
+  EXPECT_EQ(1U, driver::vote_count);
+  EXPECT_EQ(0U, driver::abort_count);
+  ASSERT_EQ(2U, written.size());
+  EXPECT_EQ("ctr1", written[0]);
+  EXPECT_EQ("ctr2", written[1]);
+
+  controllers = ControllerTxnList(3);
+  ControllerFramework::missing_controllers.insert("ctr2");
+  EXPECT_EQ(unc::tclib::TC_SUCCESS,
+            TxnObj->HandleCommitGlobalCommit(1, 1, controllers));
+  EXPECT_EQ(1U, driver::commit_count);
+  EXPECT_EQ(0U, driver::abort_count);
+  ASSERT_EQ(1U, written.size());
+  EXPECT_EQ("ctr2", written[0]);
+
+  ControllerFramework::missing_controllers.clear();
+  driver::clear_txn_counts();
+  unc::tclib::TcLibModule::stub_unloadtcLibModule();
+  delete TxnObj;
+  delete CtrObj;
+}
 }  // namespace driver
 }  // namespace unc